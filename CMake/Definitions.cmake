@@ -14,6 +14,8 @@ foreach(
   GPERF
   GPERF_HEAP_MAIN
   GPERF_HEAP_FIRST_GAME_ITERATION
+  DEVILUTIONX_TICK_TIMING
+  DEVILUTIONX_TRACING
   PACKET_ENCRYPTION
   DEVILUTIONX_RESAMPLER_SPEEX
   DEVILUTIONX_RESAMPLER_SDL
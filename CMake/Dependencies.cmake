@@ -7,7 +7,9 @@ if(EMSCRIPTEN)
   emscripten_system_library("zlib" ZLIB::ZLIB USE_ZLIB=1)
 else()
   dependency_options("zlib" DEVILUTIONX_SYSTEM_ZLIB ON DEVILUTIONX_STATIC_ZLIB)
-  if(NOT DEVILUTIONX_SYSTEM_ZLIB)
+  if(DEVILUTIONX_SYSTEM_ZLIB)
+    find_package(ZLIB REQUIRED)
+  else()
     add_subdirectory(3rdParty/zlib)
   endif()
 endif()
@@ -51,7 +53,7 @@ add_subdirectory(3rdParty/sol2)
 if(SCREEN_READER_INTEGRATION)
   if(WIN32)
     add_subdirectory(3rdParty/tolk)
-  else()
+  elseif(NOT APPLE)
     find_package(Speechd REQUIRED)
   endif()
 endif()
@@ -13,6 +13,7 @@ target_link_dependencies(test_main PUBLIC libdevilutionx_so GTest::gtest GTest::
 set(tests
   animationinfo_test
   appfat_test
+  assets_test
   automap_test
   cursor_test
   dead_test
@@ -28,6 +29,7 @@ set(tests
   math_test
   missiles_test
   multi_logging_test
+  multi_test
   pack_test
   player_test
   quests_test
@@ -40,29 +42,51 @@ set(tests
   vendor_test
 )
 set(standalone_tests
+  block_read_ahead_test
   codec_test
   crawl_test
   data_file_test
   file_util_test
   format_int_test
+  frame_pacer_test
+  frame_recorder_test
   ini_test
+  level_arena_test
+  navigation_field_test
   palette_blending_test
   parse_int_test
   path_test
+  perfect_hash_test
+  pixel_doubling_test
   vision_test
   random_test
   rectangle_test
+  screen_hit_list_test
+  sector_graph_test
+  slot_pool_test
+  spatial_index_test
+  speech_backend_test
+  spsc_queue_test
+  startup_timing_test
   static_vector_test
   str_cat_test
+  time_histogram_test
+  tour_planner_test
+  turn_delay_test
   utf8_test
+  walk_path_test
 )
 if(NOT USE_SDL1)
   list(APPEND standalone_tests text_render_integration_test)
 endif()
 set(benchmarks
+  accessibility_benchmark
   clx_render_benchmark
+  codec_benchmark
   crawl_benchmark
+  data_file_benchmark
   dun_render_benchmark
+  frame_queue_benchmark
   light_render_benchmark
   palette_blending_benchmark
   path_benchmark
@@ -96,13 +120,34 @@ foreach(target ${benchmarks})
   target_include_directories(${target} PRIVATE "${PROJECT_SOURCE_DIR}/Source")
 endforeach()
 
+if(DEVILUTIONX_PERF_REGRESSION_TESTS)
+  find_package(Python3 COMPONENTS Interpreter REQUIRED)
+  # Timings depend on the machine, so the baseline lives in the build directory.
+  # Create it with `tools/run_perf_regression.py --update-baseline` on a known good commit.
+  set(DEVILUTIONX_PERF_BASELINE "${CMAKE_BINARY_DIR}/perf_baseline.json" CACHE FILEPATH "Results the perf_regression test compares against")
+  set(DEVILUTIONX_PERF_TOLERANCE 10 CACHE STRING "Percentage by which a hot path may get slower before perf_regression fails")
+  add_test(NAME perf_regression
+    COMMAND "${Python3_EXECUTABLE}" "${PROJECT_SOURCE_DIR}/tools/run_perf_regression.py"
+      --build "${CMAKE_BINARY_DIR}"
+      --binary "$<TARGET_FILE:${BIN_TARGET}>"
+      --baseline "${DEVILUTIONX_PERF_BASELINE}"
+      --tolerance "${DEVILUTIONX_PERF_TOLERANCE}"
+      --output "${CMAKE_BINARY_DIR}/perf_results.json"
+      --benchmarks ${benchmarks}
+  )
+  set_tests_properties(perf_regression PROPERTIES LABELS perf RUN_SERIAL ON SKIP_RETURN_CODE 77 TIMEOUT 3600)
+endif()
+
 add_library(app_fatal_for_testing OBJECT test/app_fatal_for_testing.cpp)
 target_sources(app_fatal_for_testing INTERFACE $<TARGET_OBJECTS:app_fatal_for_testing>)
 
 add_library(language_for_testing OBJECT test/language_for_testing.cpp)
 target_sources(language_for_testing INTERFACE $<TARGET_OBJECTS:language_for_testing>)
 
+target_link_dependencies(accessibility_benchmark PRIVATE libdevilutionx_so)
+target_link_dependencies(block_read_ahead_test PRIVATE libdevilutionx_sdl_thread app_fatal_for_testing)
 target_link_dependencies(codec_test PRIVATE libdevilutionx_codec app_fatal_for_testing)
+target_link_dependencies(codec_benchmark PRIVATE libdevilutionx_codec app_fatal_for_testing)
 target_link_dependencies(clx_render_benchmark
   PRIVATE
   DevilutionX::SDL
@@ -117,10 +162,15 @@ target_link_dependencies(clx_render_benchmark
 target_link_dependencies(crawl_test PRIVATE libdevilutionx_crawl)
 target_link_dependencies(crawl_benchmark PRIVATE libdevilutionx_crawl)
 target_link_dependencies(data_file_test PRIVATE libdevilutionx_txtdata app_fatal_for_testing language_for_testing)
+target_link_dependencies(data_file_benchmark PRIVATE libdevilutionx_txtdata app_fatal_for_testing language_for_testing)
 target_link_dependencies(dun_render_benchmark PRIVATE libdevilutionx_so)
+target_link_dependencies(frame_queue_benchmark PRIVATE libdevilutionx_so)
 target_link_dependencies(file_util_test PRIVATE libdevilutionx_file_util app_fatal_for_testing)
 target_link_dependencies(format_int_test PRIVATE libdevilutionx_format_int language_for_testing)
+target_link_dependencies(frame_pacer_test PRIVATE libdevilutionx_frame_pacer)
+target_link_dependencies(frame_recorder_test PRIVATE libdevilutionx_frame_recorder)
 target_link_dependencies(ini_test PRIVATE libdevilutionx_ini app_fatal_for_testing)
+target_link_dependencies(level_arena_test PRIVATE libdevilutionx_level_arena)
 target_link_dependencies(light_render_benchmark PRIVATE libdevilutionx_light_render DevilutionX::SDL libdevilutionx_surface libdevilutionx_paths app_fatal_for_testing)
 target_link_dependencies(palette_blending_test PRIVATE libdevilutionx_palette_blending DevilutionX::SDL libdevilutionx_strings GTest::gmock app_fatal_for_testing)
 target_link_dependencies(palette_blending_benchmark
@@ -130,13 +180,21 @@ target_link_dependencies(palette_blending_benchmark
   libdevilutionx_palette_kd_tree
   app_fatal_for_testing
 )
+target_link_dependencies(navigation_field_test PRIVATE libdevilutionx_pathfinding app_fatal_for_testing)
 target_link_dependencies(parse_int_test PRIVATE libdevilutionx_parse_int)
 target_link_dependencies(path_test PRIVATE libdevilutionx_pathfinding libdevilutionx_direction app_fatal_for_testing)
 target_link_dependencies(vision_test PRIVATE libdevilutionx_vision)
 target_link_dependencies(path_benchmark PRIVATE libdevilutionx_pathfinding app_fatal_for_testing)
 target_link_dependencies(random_test PRIVATE libdevilutionx_random)
+target_link_dependencies(screen_hit_list_test PRIVATE libdevilutionx_screen_hit_list)
+target_link_dependencies(sector_graph_test PRIVATE libdevilutionx_pathfinding app_fatal_for_testing)
+target_link_dependencies(spatial_index_test PRIVATE libdevilutionx_spatial_index)
+target_link_dependencies(speech_backend_test PRIVATE libdevilutionx_speech_backend)
+target_link_dependencies(startup_timing_test PRIVATE libdevilutionx_startup_timing)
 target_link_dependencies(static_vector_test PRIVATE libdevilutionx_random app_fatal_for_testing)
 target_link_dependencies(str_cat_test PRIVATE libdevilutionx_strings)
+target_link_dependencies(tour_planner_test PRIVATE libdevilutionx_pathfinding app_fatal_for_testing)
+target_link_dependencies(turn_delay_test PRIVATE libdevilutionx_turn_delay)
 if(DEVILUTIONX_SCREENSHOT_FORMAT STREQUAL DEVILUTIONX_SCREENSHOT_FORMAT_PNG AND NOT USE_SDL1)
   target_link_dependencies(text_render_integration_test
     PRIVATE
@@ -197,5 +255,6 @@ if(DEVILUTIONX_SCREENSHOT_FORMAT STREQUAL DEVILUTIONX_SCREENSHOT_FORMAT_PNG AND
   add_dependencies(text_render_integration_test text_render_integration_test_resources)
 endif()
 target_link_dependencies(utf8_test PRIVATE libdevilutionx_utf8)
+target_link_dependencies(walk_path_test PRIVATE app_fatal_for_testing)
 
 target_include_directories(writehero_test PRIVATE 3rdParty/PicoSHA2)
@@ -8,6 +8,7 @@
 #include <optional>
 #include <string>
 #include <string_view>
+#include <utility>
 #include <vector>
 
 #ifdef USE_SDL3
@@ -62,6 +63,7 @@
 #include "utils/screen_reader.hpp"
 #include "utils/sdl_compat.h"
 #include "utils/sdl_geometry.h"
+#include "utils/sdl_thread.h"
 #include "utils/str_cat.hpp"
 #include "utils/ui_fwd.h"
 #include "utils/utf8.hpp"
@@ -87,7 +89,7 @@ OptionalOwnedClxSpriteList DifficultyIndicator;
 std::array<OptionalOwnedClxSpriteList, 3> ArtFocus;
 
 OptionalOwnedClxSpriteList ArtBackgroundWidescreen;
-OptionalOwnedClxSpriteList ArtBackground;
+OptionalClxSpriteList ArtBackground;
 OptionalOwnedClxSpriteList ArtCursor;
 
 std::size_t SelectedItem = 0;
@@ -98,6 +100,25 @@ OptionalOwnedClxSpriteList ArtHero;
 std::vector<uint8_t> ArtHeroPortraitOrder;
 std::vector<OptionalOwnedClxSpriteList> ArtHeroOverrides;
 
+/** A background as LoadBackgroundArt() shows it, kept so that going back to a screen doesn't convert it again. */
+struct CachedBackgroundArt {
+	std::string path;
+	int frames;
+	OwnedClxSpriteList sprites;
+	std::array<SDL_Color, 256> palette;
+};
+
+/** Enough for the screens between the main menu and a game, most recently shown first. */
+constexpr size_t MaxCachedBackgrounds = 4;
+std::vector<CachedBackgroundArt> CachedBackgrounds;
+
+// Set by the game thread before the preload thread starts, filled by that thread and only
+// touched by the game thread again once it was joined.
+std::string PreloadPath;
+int PreloadFrames;
+std::optional<CachedBackgroundArt> PreloadedBackground;
+SdlThread PreloadThread;
+
 std::size_t SelectedItemMax;
 std::size_t ListViewportSize = 1;
 std::size_t listOffset = 0;
@@ -160,14 +181,14 @@ void SpeakListItem(std::size_t index, bool force = false)
 	if (gUiList == nullptr || index > SelectedItemMax)
 		return;
 
-	const UiListItem *pItem = gUiList->GetItem(index);
+	const UiListItem *pItem = gUiList->GetPreparedItem(index);
 	if (pItem == nullptr)
 		return;
 
 	std::string text = FormatSpokenText(pItem->m_text, pItem->args);
 
 	if (HasAnyOf(pItem->uiFlags, UiFlags::NeedsNextElement) && index < SelectedItemMax) {
-		const UiListItem *pNextItem = gUiList->GetItem(index + 1);
+		const UiListItem *pNextItem = gUiList->GetPreparedItem(index + 1);
 		if (pNextItem != nullptr && pNextItem->m_value == pItem->m_value) {
 			const std::string nextText = FormatSpokenText(pNextItem->m_text, pNextItem->args);
 			if (!nextText.empty()) {
@@ -727,6 +748,11 @@ ClxSprite UiGetHeroDialogSprite(size_t heroClassIndex)
 
 void UnloadUiGFX()
 {
+	// The language or game may have changed, which changes the backgrounds too.
+	PreloadThread.join();
+	PreloadedBackground = std::nullopt;
+	ArtBackground = std::nullopt;
+	CachedBackgrounds.clear();
 	ArtHero = std::nullopt;
 	for (OptionalOwnedClxSpriteList &override : ArtHeroOverrides)
 		override = std::nullopt;
@@ -817,17 +843,84 @@ bool UiLoadBlackBackground()
 	return true;
 }
 
+namespace {
+
+void AddCachedBackground(CachedBackgroundArt &&art)
+{
+	CachedBackgrounds.insert(CachedBackgrounds.begin(), std::move(art));
+	if (CachedBackgrounds.size() <= MaxCachedBackgrounds)
+		return;
+	// A preloaded background may come in while the least recent one is still on screen.
+	auto evicted = std::prev(CachedBackgrounds.end());
+	if (ArtBackground && ArtBackground->data() == ClxSpriteList { evicted->sprites }.data())
+		--evicted;
+	CachedBackgrounds.erase(evicted);
+}
+
+void TakePreloadedBackground()
+{
+	PreloadThread.join();
+	if (!PreloadedBackground)
+		return;
+	AddCachedBackground(*std::move(PreloadedBackground));
+	PreloadedBackground = std::nullopt;
+}
+
+void PreloadBackground()
+{
+	std::array<SDL_Color, 256> palette;
+	OptionalOwnedClxSpriteList sprites = LoadPcxSpriteList(PreloadPath.c_str(), static_cast<uint16_t>(PreloadFrames), /*transparentColor=*/std::nullopt, palette.data(), /*logError=*/false, /*threadsafe=*/true);
+	if (sprites)
+		PreloadedBackground = CachedBackgroundArt { PreloadPath, PreloadFrames, std::move(*sprites), palette };
+}
+
+/** @brief The cached background, loading it if it isn't cached yet. */
+const CachedBackgroundArt *GetBackgroundArt(std::string_view path, int frames)
+{
+	TakePreloadedBackground();
+	const auto it = c_find_if(CachedBackgrounds, [&](const CachedBackgroundArt &art) { return art.path == path && art.frames == frames; });
+	if (it != CachedBackgrounds.end()) {
+		std::rotate(CachedBackgrounds.begin(), it, std::next(it));
+		return &CachedBackgrounds.front();
+	}
+
+	std::array<SDL_Color, 256> palette;
+	OptionalOwnedClxSpriteList sprites = LoadPcxSpriteList(std::string(path).c_str(), static_cast<uint16_t>(frames), /*transparentColor=*/std::nullopt, palette.data());
+	if (!sprites)
+		return nullptr;
+	AddCachedBackground(CachedBackgroundArt { std::string(path), frames, std::move(*sprites), palette });
+	return &CachedBackgrounds.front();
+}
+
+} // namespace
+
 void LoadBackgroundArt(const char *pszFile, int frames)
 {
 	ArtBackground = std::nullopt;
-	ArtBackground = LoadPcxSpriteList(pszFile, static_cast<uint16_t>(frames), /*transparentColor=*/std::nullopt, logical_palette.data());
-	if (!ArtBackground)
+	const CachedBackgroundArt *art = GetBackgroundArt(pszFile, frames);
+	if (art == nullptr)
 		return;
 
+	ArtBackground = ClxSpriteList { art->sprites };
+	logical_palette = art->palette;
 	UpdateSystemPalette(logical_palette);
 	UiOnBackgroundChange();
 }
 
+void PreloadBackgroundArt(const char *pszFile, int frames)
+{
+#ifndef __DJGPP__
+	if (HeadlessMode)
+		return;
+	TakePreloadedBackground();
+	if (c_any_of(CachedBackgrounds, [&](const CachedBackgroundArt &art) { return art.path == pszFile && art.frames == frames; }))
+		return;
+	PreloadPath = pszFile;
+	PreloadFrames = frames;
+	PreloadThread = SdlThread { PreloadBackground };
+#endif
+}
+
 void UiAddBackground(std::vector<std::unique_ptr<UiItemBase>> *vecDialog)
 {
 	const SDL_Rect rect = MakeSdlRect(0, GetUIRectangle().position.y, 0, 0);
@@ -970,7 +1063,7 @@ void Render(const UiList &uiList)
 
 	for (std::size_t i = listOffset; i < uiList.m_vecItems.size() && (i - listOffset) < ListViewportSize; ++i) {
 		const SDL_Rect rect = uiList.itemRect(static_cast<int>(i - listOffset));
-		const UiListItem &item = *uiList.GetItem(i);
+		const UiListItem &item = *uiList.GetPreparedItem(i);
 		if (i == SelectedItem)
 			DrawSelector(rect);
 
@@ -75,7 +75,8 @@ extern OptionalOwnedClxSpriteList ArtLogo;
 extern OptionalOwnedClxSpriteList DifficultyIndicator;
 extern std::array<OptionalOwnedClxSpriteList, 3> ArtFocus;
 extern OptionalOwnedClxSpriteList ArtBackgroundWidescreen;
-extern OptionalOwnedClxSpriteList ArtBackground;
+/** The background of the current screen, owned by the cache of LoadBackgroundArt(). */
+extern OptionalClxSpriteList ArtBackground;
 extern OptionalOwnedClxSpriteList ArtCursor;
 
 extern bool (*gfnHeroInfo)(bool (*fninfofunc)(_uiheroinfo *));
@@ -106,7 +107,10 @@ Sint16 GetCenterOffset(Sint16 w, Sint16 bw = 0);
 void DrawMouse();
 void UiLoadDefaultPalette();
 bool UiLoadBlackBackground();
+/** @brief Shows a background and its palette, which are kept in memory until UnloadUiGFX(). */
 void LoadBackgroundArt(const char *pszFile, int frames = 1);
+/** @brief Starts loading the background of the screen most likely to come next on a background thread. */
+void PreloadBackgroundArt(const char *pszFile, int frames = 1);
 void UiAddBackground(std::vector<std::unique_ptr<UiItemBase>> *vecDialog);
 void UiAddLogo(std::vector<std::unique_ptr<UiItemBase>> *vecDialog, int y = GetUIRectangle().position.y);
 void UiFocusNavigationSelect();
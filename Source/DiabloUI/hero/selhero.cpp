@@ -283,6 +283,8 @@ void RemoveSelHeroBackground()
 void AddSelHeroBackground()
 {
 	LoadBackgroundArt("ui_art\\selhero");
+	// Single player games pick the difficulty and multi player games the game next.
+	PreloadBackgroundArt("ui_art\\selgame");
 	vecSelHeroDialog.insert(vecSelHeroDialog.begin(),
 	    std::make_unique<UiImageClx>((*ArtBackground)[0], MakeSdlRect(0, GetUIRectangle().position.y, 0, 0), UiFlags::AlignCenter));
 }
@@ -17,6 +17,7 @@
 #include "engine/assets.hpp"
 #include "engine/load_clx.hpp"
 #include "engine/point.hpp"
+#include "engine/startup_timing.hpp"
 #include "game_mode.hpp"
 #include "utils/language.h"
 #include "utils/ui_fwd.h"
@@ -65,6 +66,7 @@ void MainmenuLoad(const char *name)
 	} else {
 		LoadBackgroundArt("ui_art\\swmmenu");
 	}
+	PreloadBackgroundArt("ui_art\\selhero");
 
 	UiAddBackground(&vecMainMenuDialog);
 	UiAddLogo(&vecMainMenuDialog);
@@ -110,13 +112,21 @@ bool UiMainMenuDialog(const char *name, _mainmenu_selections *pdwResult, int att
 	MainMenuResult = MAINMENU_NONE;
 	while (MainMenuResult == MAINMENU_NONE) {
 		mainmenu_attract_time_out = attractTimeOut;
-		MainmenuLoad(name);
+		{
+			const ScopedStartupPhase phase("MainmenuLoad");
+			MainmenuLoad(name);
+		}
 
 		mainmenu_restart_repintro(); // for automatic starts
 
 		while (MainMenuResult == MAINMENU_NONE) {
 			UiClearScreen();
 			UiPollAndRender();
+			FinishStartupTiming();
+			if (IsStartupBenchmark()) {
+				MainMenuResult = MAINMENU_EXIT_DIABLO;
+				break;
+			}
 			if (SDL_GetTicks() >= dwAttractTicks && (HaveIntro() || gbIsHellfire)) {
 				MainMenuResult = MAINMENU_ATTRACT_MODE;
 			}
@@ -53,6 +53,7 @@ void SelconnSelect(size_t value);
 void SelconnLoad()
 {
 	LoadBackgroundArt("ui_art\\selconn");
+	PreloadBackgroundArt("ui_art\\selhero");
 
 #ifndef NONET
 #ifndef DISABLE_ZERO_TIER
@@ -107,6 +107,34 @@ bool NeedsTwoLinesToDisplayOption(std::vector<DrawStringFormatArg> &formatArgs)
 	return GetLineWidth("{}: {}", formatArgs.data(), formatArgs.size(), 0, GameFontTables::GameFont24, 1) >= (rectList.size.width - 90);
 }
 
+/**
+ * @brief Fills in a key or button binding row once it is shown.
+ *
+ * The keymapper and padmapper have hundreds of actions, so their rows only get their option when
+ * the menu opens. They always take a single line, a name that doesn't fit next to its binding is
+ * shortened.
+ */
+void PrepareBindingItem(UiListItem &item)
+{
+	if (!item.args.empty() || item.m_value < 0 || static_cast<size_t>(item.m_value) >= vecOptions.size())
+		return;
+
+	OptionEntryBase *pEntry = vecOptions[item.m_value];
+	std::vector<DrawStringFormatArg> args = CreateDrawStringFormatArgForEntry(pEntry);
+	if (NeedsTwoLinesToDisplayOption(args)) {
+		std::string_view name = pEntry->GetName();
+		std::string shortened;
+		do {
+			name = name.substr(0, FindLastUtf8Symbols(name));
+			shortened = StrCat(name, "...");
+			args[0] = { shortened, UiFlags::ColorUiGold };
+		} while (!name.empty() && NeedsTwoLinesToDisplayOption(args));
+		item.m_text = StrCat(shortened, ": {}");
+		args.erase(args.begin());
+	}
+	item.args = std::move(args);
+}
+
 void CleanUpSettingsUI()
 {
 	UiInitList_clear();
@@ -424,15 +452,19 @@ void UiSettingsMenu()
 					continue;
 				if (selectedOption == pEntry)
 					itemToSelect = vecDialogItems.size();
-				auto formatArgs = CreateDrawStringFormatArgForEntry(pEntry);
 				const int optionId = static_cast<int>(vecOptions.size());
+				vecOptions.push_back(pEntry);
+				if (IsAnyOf(pEntry->GetType(), OptionEntryType::Key, OptionEntryType::PadButton)) {
+					vecDialogItems.push_back(std::make_unique<UiListItem>(std::string_view("{}: {}"), optionId, UiFlags::ColorUiGold));
+					continue;
+				}
+				auto formatArgs = CreateDrawStringFormatArgForEntry(pEntry);
 				if (NeedsTwoLinesToDisplayOption(formatArgs)) {
 					vecDialogItems.push_back(std::make_unique<UiListItem>(std::string_view("{}:"), formatArgs, optionId, UiFlags::ColorUiGold | UiFlags::NeedsNextElement));
 					vecDialogItems.push_back(std::make_unique<UiListItem>(std::string(pEntry->GetValueDescription()), optionId, UiFlags::ColorUiSilver | UiFlags::ElementDisabled));
 				} else {
 					vecDialogItems.push_back(std::make_unique<UiListItem>(std::string_view("{}: {}"), formatArgs, optionId, UiFlags::ColorUiGold));
 				}
-				vecOptions.push_back(pEntry);
 			}
 		} break;
 		case ShownMenuType::ListOption: {
@@ -563,8 +595,11 @@ void UiSettingsMenu()
 		    *ArtScrollBarArrow, MakeSdlRect(rectList.position.x + rectList.size.width + 5, rectList.position.y, 25, rectList.size.height)));
 		vecDialog.push_back(std::make_unique<UiArtText>(optionDescription, MakeSdlRect(rectDescription),
 		    UiFlags::FontSize12 | UiFlags::ColorUiSilverDark | UiFlags::AlignCenter, 1, descriptionLineHeight));
-		vecDialog.push_back(std::make_unique<UiList>(vecDialogItems, rectList.size.height / ListItemHeight,
-		    rectList.position.x, rectList.position.y, rectList.size.width, ListItemHeight, UiFlags::FontSize24 | UiFlags::AlignCenter));
+		auto uiList = std::make_unique<UiList>(vecDialogItems, rectList.size.height / ListItemHeight,
+		    rectList.position.x, rectList.position.y, rectList.size.width, ListItemHeight, UiFlags::FontSize24 | UiFlags::AlignCenter);
+		if (shownMenu == ShownMenuType::Settings)
+			uiList->prepareItem = PrepareBindingItem;
+		vecDialog.push_back(std::move(uiList));
 
 		UiInitList(ItemFocused, ItemSelected, EscPressed, vecDialog, true, FullscreenChanged, nullptr, itemToSelect);
 
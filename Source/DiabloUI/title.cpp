@@ -20,6 +20,7 @@
 #include "engine/load_clx.hpp"
 #include "engine/load_pcx.hpp"
 #include "engine/point.hpp"
+#include "game_mode.hpp"
 #include "utils/algorithm/container.hpp"
 #include "utils/language.h"
 #include "utils/sdl_compat.h"
@@ -42,6 +43,7 @@ void TitleLoad()
 		LoadBackgroundArt("ui_art\\title");
 		DiabloTitleLogo = LoadPcxSpriteList("ui_art\\logo", /*numFrames=*/15, /*transparentColor=*/250);
 	}
+	PreloadBackgroundArt(!gbIsSpawn || gbIsHellfire ? "ui_art\\mainmenu" : "ui_art\\swmmenu");
 }
 
 void TitleFree()
@@ -406,6 +406,15 @@ public:
 		return m_vecItems[i];
 	}
 
+	/** @brief The item, filled in first if it was built lazily. */
+	[[nodiscard]] UiListItem *GetPreparedItem(std::size_t i) const
+	{
+		UiListItem *item = m_vecItems[i];
+		if (prepareItem != nullptr)
+			prepareItem(*item);
+		return item;
+	}
+
 	[[nodiscard]] int GetSpacing() const
 	{
 		return spacing_;
@@ -431,6 +440,11 @@ public:
 	Sint16 m_x, m_y;
 	Uint16 m_width, m_height;
 	std::vector<UiListItem *> m_vecItems;
+	/**
+	 * Fills in the items of long lists that were only given their value, once they are drawn or
+	 * spoken. Has to leave items it already filled in alone.
+	 */
+	void (*prepareItem)(UiListItem &item) = nullptr;
 
 private:
 	struct PrivateConstructor final {
@@ -0,0 +1,35 @@
+/**
+ * @file accessibility_queries.hpp
+ *
+ * The lookups the accessibility announcers and hotkeys run every tick or key press, exposed for
+ * test/accessibility_benchmark.cpp.
+ */
+#pragma once
+
+#include <cstddef>
+#include <optional>
+
+#include "engine/point.hpp"
+#include "engine/walk_path.hpp"
+
+namespace devilution {
+
+struct Player;
+
+namespace accessibility_queries {
+
+/** @brief The path the walk and tracker announcements describe. */
+[[nodiscard]] std::optional<WalkPath> FindKeyboardWalkPathForSpeech(const Player &player, Point startPosition, Point destinationPosition);
+
+/** @brief The target of the "walk to nearest unexplored" hotkey. */
+[[nodiscard]] std::optional<Point> FindNearestUnexploredTile(const Player &player, Point startPosition);
+
+/** @brief Collects the candidates of every tracker category around the position, returns how many there were. */
+size_t CollectNearbyTrackerCandidates(Point playerPosition, int maxDistance);
+
+/** @brief Whether the interact cue has a target next to the player. Always false without sound. */
+[[nodiscard]] bool HasInteractTargetInRange(const Player &player, Point playerPosition);
+
+} // namespace accessibility_queries
+
+} // namespace devilution
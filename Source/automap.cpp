@@ -7,6 +7,8 @@
 
 #include <algorithm>
 #include <cstdint>
+#include <cstring>
+#include <optional>
 
 #include <fmt/format.h>
 
@@ -19,10 +21,12 @@
 #include "levels/setmaps.h"
 #include "options.h"
 #include "player.h"
+#include "quests.h"
 #include "utils/attributes.h"
 #include "utils/enum_traits.h"
 #include "utils/is_of.hpp"
 #include "utils/language.h"
+#include "utils/palette_blending.hpp"
 #include "utils/ui_fwd.h"
 #include "utils/utf8.hpp"
 
@@ -1270,6 +1274,230 @@ Displacement GetAutomapScreen()
 	return screen;
 }
 
+/** First and last map coordinate the cached layer covers, including the border tiles drawn outside the map. */
+constexpr int LayerFirstTile = -2;
+constexpr int LayerLastTile = DMAXX + 1;
+static_assert(DMAXX == DMAXY, "The cached automap layer assumes a square map");
+/** Layer pixels no tile drew; the automap never draws with this color. */
+constexpr uint8_t LayerTransparentColor = 255;
+/** Larger layers (zoomed far in) are not worth the memory, the tiles are drawn directly then. */
+constexpr int MaxLayerPixels = 8 * 1024 * 1024;
+/** How far a changed map cell can change how the tiles around it are drawn. */
+constexpr int LayerDirtyRadius = 2;
+
+/** Where tiles go in the cached layer at the current scale and how far they can draw from their center. */
+struct AutomapLayerGeometry {
+	int fullTileRight;
+	int fullTileDown;
+	/** Map tile (0, 0)'s center in the layer. */
+	Point origin;
+	Size size;
+	/** Pixels a tile can draw to the left, right, above and below its center. */
+	int left;
+	int right;
+	int up;
+	int down;
+
+	[[nodiscard]] Point TileCenter(Point map) const
+	{
+		return origin + Displacement { (map.x - map.y) * fullTileRight, (map.x + map.y) * fullTileDown };
+	}
+
+	[[nodiscard]] Rectangle TileFootprint(Point map) const
+	{
+		const Point center = TileCenter(map);
+		return { { center.x - left, center.y - up }, Size { left + right + 1, up + down + 1 } };
+	}
+};
+
+/**
+ * @brief The geometry of the layer, if the current scale keeps the tile grid on whole pixels.
+ */
+std::optional<AutomapLayerGeometry> GetAutomapLayerGeometry()
+{
+	const int fullTileRight = AmOffset(AmWidthOffset::FullTileRight, AmHeightOffset::None).deltaX;
+	const int fullTileDown = AmOffset(AmWidthOffset::None, AmHeightOffset::FullTileDown).deltaY;
+	const int doubleTileRight = AmOffset(AmWidthOffset::DoubleTileRight, AmHeightOffset::None).deltaX;
+	const int doubleTileDown = AmOffset(AmWidthOffset::None, AmHeightOffset::DoubleTileDown).deltaY;
+	if (fullTileRight <= 0 || fullTileDown <= 0 || doubleTileRight != 2 * fullTileRight || doubleTileDown != 2 * fullTileDown)
+		return std::nullopt;
+
+	AutomapLayerGeometry geometry;
+	geometry.fullTileRight = fullTileRight;
+	geometry.fullTileDown = fullTileDown;
+	// Pentagrams reach furthest, their ellipse is drawn from one radius left of the tile.
+	geometry.left = 2 * doubleTileRight + 2;
+	geometry.right = doubleTileRight + 2;
+	geometry.up = doubleTileDown + 2;
+	geometry.down = doubleTileDown + 2;
+
+	const int tiles = LayerLastTile - LayerFirstTile;
+	geometry.origin = {
+		tiles * fullTileRight + geometry.left,
+		-2 * LayerFirstTile * fullTileDown + geometry.up,
+	};
+	geometry.size = {
+		2 * tiles * fullTileRight + geometry.left + geometry.right + 1,
+		2 * tiles * fullTileDown + geometry.up + geometry.down + 1,
+	};
+	if (geometry.size.width * geometry.size.height > MaxLayerPixels)
+		return std::nullopt;
+	return geometry;
+}
+
+/**
+ * @brief The explored tiles drawn once at the current scale, so that a frame only has to copy them.
+ *
+ * Tiles are drawn again when the map cells or the exploration around them change.
+ */
+struct AutomapLayer {
+	std::optional<OwnedSurface> surface;
+	bool stale = true;
+	int scale = 0;
+	quest_state poisonedWater = QUEST_NOTAVAIL;
+	/** What the drawn tiles show. */
+	uint8_t tiles[DMAXX][DMAXY];
+	uint8_t view[DMAXX][DMAXY];
+};
+
+AutomapLayer CachedAutomapLayer;
+
+void DrawAutomapLayerTiles(const AutomapLayerGeometry &geometry, Rectangle area)
+{
+	const Surface &layer = *CachedAutomapLayer.surface;
+	const Surface target = layer.subregion(area.position.x, area.position.y, area.size.width, area.size.height);
+	for (int y = 0; y < area.size.height; y++)
+		std::memset(target.at(0, y), LayerTransparentColor, area.size.width);
+
+	SetMapPixelsToLayer(true);
+	for (int mapX = LayerFirstTile; mapX <= LayerLastTile; mapX++) {
+		for (int mapY = LayerFirstTile; mapY <= LayerLastTile; mapY++) {
+			const Point map { mapX, mapY };
+			const Rectangle footprint = geometry.TileFootprint(map);
+			if (footprint.position.x >= area.position.x + area.size.width || footprint.position.x + footprint.size.width <= area.position.x
+			    || footprint.position.y >= area.position.y + area.size.height || footprint.position.y + footprint.size.height <= area.position.y)
+				continue;
+			DrawAutomapTile(target, geometry.TileCenter(map) - Displacement { area.position.x, area.position.y }, map);
+		}
+	}
+	SetMapPixelsToLayer(false);
+}
+
+/**
+ * @brief Brings the layer up to date with the map, drawing only the tiles that changed.
+ */
+void UpdateAutomapLayer(const AutomapLayerGeometry &geometry, int scale)
+{
+	AutomapLayer &cache = CachedAutomapLayer;
+	const quest_state poisonedWater = Quests[Q_PWATER]._qactive;
+	const bool rebuild = cache.stale || cache.scale != scale || cache.poisonedWater != poisonedWater
+	    || !cache.surface || cache.surface->w() != geometry.size.width || cache.surface->h() != geometry.size.height;
+
+	if (rebuild) {
+		if (!cache.surface || cache.surface->w() != geometry.size.width || cache.surface->h() != geometry.size.height)
+			cache.surface.emplace(geometry.size);
+		DrawAutomapLayerTiles(geometry, { { 0, 0 }, geometry.size });
+	} else if (memcmp(cache.tiles, dungeon, sizeof(cache.tiles)) != 0 || memcmp(cache.view, AutomapView, sizeof(cache.view)) != 0) {
+		int left = geometry.size.width;
+		int top = geometry.size.height;
+		int right = 0;
+		int bottom = 0;
+		for (int x = 0; x < DMAXX; x++) {
+			for (int y = 0; y < DMAXY; y++) {
+				if (cache.tiles[x][y] == dungeon[x][y] && cache.view[x][y] == AutomapView[x][y])
+					continue;
+				const Rectangle first = geometry.TileFootprint({ x - LayerDirtyRadius, y - LayerDirtyRadius });
+				const Rectangle last = geometry.TileFootprint({ x + LayerDirtyRadius, y + LayerDirtyRadius });
+				const Rectangle leftmost = geometry.TileFootprint({ x - LayerDirtyRadius, y + LayerDirtyRadius });
+				const Rectangle rightmost = geometry.TileFootprint({ x + LayerDirtyRadius, y - LayerDirtyRadius });
+				left = std::min(left, leftmost.position.x);
+				right = std::max(right, rightmost.position.x + rightmost.size.width);
+				top = std::min(top, first.position.y);
+				bottom = std::max(bottom, last.position.y + last.size.height);
+			}
+		}
+		left = std::max(left, 0);
+		top = std::max(top, 0);
+		right = std::min(right, geometry.size.width);
+		bottom = std::min(bottom, geometry.size.height);
+		if (left < right && top < bottom)
+			DrawAutomapLayerTiles(geometry, { { left, top }, Size { right - left, bottom - top } });
+	} else {
+		return;
+	}
+
+	memcpy(cache.tiles, dungeon, sizeof(cache.tiles));
+	memcpy(cache.view, AutomapView, sizeof(cache.view));
+	cache.stale = false;
+	cache.scale = scale;
+	cache.poisonedWater = poisonedWater;
+}
+
+/**
+ * @brief Copies the drawn pixels of a layer row, blending them for the transparent automap.
+ */
+void BlitAutomapLayerRow(const uint8_t *src, uint8_t *dst, int width, bool transparent)
+{
+	constexpr uint64_t TransparentWord = ~uint64_t { 0 };
+	int x = 0;
+	while (x < width) {
+		// Most of the layer is empty, skip it a word at a time.
+		if (x + 8 <= width) {
+			uint64_t word;
+			memcpy(&word, src + x, sizeof(word));
+			if (word == TransparentWord) {
+				x += 8;
+				continue;
+			}
+		}
+		const int end = std::min(x + 8, width);
+		for (; x < end; x++) {
+			const uint8_t color = src[x];
+			if (color == LayerTransparentColor)
+				continue;
+			dst[x] = transparent ? paletteTransparencyLookup[color][dst[x]] : color;
+		}
+	}
+}
+
+/**
+ * @brief Draws the explored tiles from the cached layer.
+ * @param out Target buffer
+ * @param screen Where the center of tile `firstTile` goes in `out`
+ * @param firstTile The map coordinate of the first tile the view shows
+ * @param scale The zoom the tiles are drawn at
+ * @return false if the layer can't be used and the tiles have to be drawn directly
+ */
+bool DrawAutomapLayer(const Surface &out, Point screen, Point firstTile, int scale)
+{
+#ifdef _DEBUG
+	if (DebugVision)
+		return false;
+#endif
+	const std::optional<AutomapLayerGeometry> geometry = GetAutomapLayerGeometry();
+	if (!geometry)
+		return false;
+	UpdateAutomapLayer(*geometry, scale);
+
+	const Surface &layer = *CachedAutomapLayer.surface;
+	const Displacement offset = screen - geometry->TileCenter(firstTile);
+
+	Rectangle clip { { 0, 0 }, Size { out.w(), out.h() } };
+	if (GetAutomapType() == AutomapType::Minimap)
+		clip = MinimapRect;
+	const int left = std::max({ clip.position.x, offset.deltaX, 0 });
+	const int top = std::max({ clip.position.y, offset.deltaY, 0 });
+	const int right = std::min({ clip.position.x + clip.size.width, offset.deltaX + layer.w(), out.w() });
+	const int bottom = std::min({ clip.position.y + clip.size.height, offset.deltaY + layer.h(), out.h() });
+	if (left >= right || top >= bottom)
+		return true;
+
+	const bool transparent = GetAutomapType() == AutomapType::Transparent;
+	for (int y = top; y < bottom; y++)
+		BlitAutomapLayerRow(layer.at(left - offset.deltaX, y - offset.deltaY), out.at(left, y), right - left, transparent);
+	return true;
+}
+
 void SearchAutomapItem(const Surface &out, const Displacement &myPlayerOffset, int searchRadius, tl::function_ref<bool(Point position)> highlightTile)
 {
 	const Player &player = *MyPlayer;
@@ -1676,6 +1904,7 @@ void InitAutomap()
 	}
 
 	memset(AutomapView, 0, sizeof(AutomapView));
+	CachedAutomapLayer.stale = true;
 
 	for (auto &column : dFlags)
 		for (auto &dFlag : column)
@@ -1824,21 +2053,23 @@ void DrawAutomap(const Surface &out)
 
 	Point map = { Automap.x - cells, Automap.y - 1 };
 
-	for (int i = 0; i <= cells + 1; i++) {
-		Point tile1 = screen;
-		for (int j = 0; j < cells; j++) {
-			DrawAutomapTile(out, tile1, { map.x + j, map.y - j });
-			tile1.x += AmOffset(AmWidthOffset::DoubleTileRight, AmHeightOffset::None).deltaX;
-		}
-		map.y++;
+	if (!DrawAutomapLayer(out, screen, map, scale)) {
+		for (int i = 0; i <= cells + 1; i++) {
+			Point tile1 = screen;
+			for (int j = 0; j < cells; j++) {
+				DrawAutomapTile(out, tile1, { map.x + j, map.y - j });
+				tile1.x += AmOffset(AmWidthOffset::DoubleTileRight, AmHeightOffset::None).deltaX;
+			}
+			map.y++;
 
-		Point tile2 = screen + AmOffset(AmWidthOffset::FullTileLeft, AmHeightOffset::FullTileDown);
-		for (int j = 0; j <= cells; j++) {
-			DrawAutomapTile(out, tile2, { map.x + j, map.y - j });
-			tile2.x += AmOffset(AmWidthOffset::DoubleTileRight, AmHeightOffset::None).deltaX;
+			Point tile2 = screen + AmOffset(AmWidthOffset::FullTileLeft, AmHeightOffset::FullTileDown);
+			for (int j = 0; j <= cells; j++) {
+				DrawAutomapTile(out, tile2, { map.x + j, map.y - j });
+				tile2.x += AmOffset(AmWidthOffset::DoubleTileRight, AmHeightOffset::None).deltaX;
+			}
+			map.x++;
+			screen.y += AmOffset(AmWidthOffset::None, AmHeightOffset::DoubleTileDown).deltaY;
 		}
-		map.x++;
-		screen.y += AmOffset(AmWidthOffset::None, AmHeightOffset::DoubleTileDown).deltaY;
 	}
 
 	for (const Player &player : Players) {
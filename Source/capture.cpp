@@ -1,13 +1,22 @@
 /**
  * @file capture.cpp
  *
- * Implementation of the screenshot function.
+ * Implementation of the screenshot and frame capture functions.
  */
+#include "capture.h"
+
+#include <algorithm>
+#include <atomic>
 #include <cerrno>
+#include <chrono>
 #include <cstdint>
 #include <cstdio>
 #include <cstring>
 #include <ctime>
+#include <limits>
+#include <optional>
+#include <string>
+#include <utility>
 
 #ifdef USE_SDL3
 #include <SDL3/SDL_error.h>
@@ -15,8 +24,6 @@
 #include <SDL3/SDL_timer.h>
 #else
 #include <SDL.h>
-
-#include "utils/sdl_compat.h"
 #endif
 
 #include <expected.hpp>
@@ -31,33 +38,105 @@
 #include "utils/surface_to_png.hpp"
 #endif
 
+#include "appfat.h"
 #include "engine/backbuffer_state.hpp"
 #include "engine/dx.h"
+#include "engine/frame_recorder.hpp"
+#include "engine/frame_stats.hpp"
 #include "engine/palette.h"
 #include "engine/render/scrollrt.h"
+#include "engine/surface.hpp"
+#include "options.h"
 #include "utils/file_util.h"
 #include "utils/log.hpp"
 #include "utils/paths.h"
+#include "utils/sdl_compat.h"
+#include "utils/sdl_geometry.h"
+#include "utils/sdl_thread.h"
+#include "utils/sdl_wrap.h"
 #include "utils/str_cat.hpp"
 
 namespace devilution {
 namespace {
 
-SDL_IOStream *CaptureFile(std::string *dstPath)
+constexpr const char *ScreenshotExtension =
+#if DEVILUTIONX_SCREENSHOT_FORMAT == DEVILUTIONX_SCREENSHOT_FORMAT_PCX
+    ".pcx";
+#elif DEVILUTIONX_SCREENSHOT_FORMAT == DEVILUTIONX_SCREENSHOT_FORMAT_PNG
+    ".png";
+#endif
+
+/** Memory the frames kept for a frame capture may take, the oldest are dropped before the time is up beyond it. */
+constexpr size_t FrameCaptureBudget = 128 * 1024 * 1024;
+/** Frames that take longer write the frame capture by themselves. */
+constexpr uint32_t SlowFrameMicroseconds = 250000;
+/** Longer gaps between frames are loading screens and pauses rather than stutters. */
+constexpr uint32_t FrameGapMicroseconds = 2000000;
+
+tl::expected<void, std::string> WriteScreenshotFile(const Surface &buf, SDL_IOStream *outStream)
 {
-	const char *ext =
 #if DEVILUTIONX_SCREENSHOT_FORMAT == DEVILUTIONX_SCREENSHOT_FORMAT_PCX
-	    ".pcx";
+	return WriteSurfaceToFilePcx(buf, outStream);
 #elif DEVILUTIONX_SCREENSHOT_FORMAT == DEVILUTIONX_SCREENSHOT_FORMAT_PNG
-	    ".png";
+	return WriteSurfaceToFilePng(buf, outStream);
 #endif
+}
+
+/** A copy of the screen and its palette, written to the file by the encode thread. */
+struct PendingScreenshot {
+	std::string fileName;
+	SDL_IOStream *outStream;
+	std::optional<OwnedSurface> surface;
+	SDLPaletteUniquePtr palette;
+};
+
+PendingScreenshot Screenshot;
+SdlThread EncodeThread;
+
+void EncodeScreenshot()
+{
+	const tl::expected<void, std::string> result = WriteScreenshotFile(*Screenshot.surface, Screenshot.outStream);
+	if (!result.has_value()) {
+		LogError("Failed to save screenshot at {}: ", Screenshot.fileName, result.error());
+		RemoveFile(Screenshot.fileName.c_str());
+	} else {
+		Log("Screenshot saved at {}", Screenshot.fileName);
+	}
+	Screenshot.surface = std::nullopt;
+	Screenshot.palette = nullptr;
+}
+
+/**
+ * @brief Copies the back buffer with the current palette, so the game can draw on while it is encoded.
+ */
+void SnapshotScreen()
+{
+	const Surface &backBuffer = GlobalBackBuffer();
+	Screenshot.surface.emplace(backBuffer.w(), backBuffer.h());
+	Screenshot.surface->BlitFrom(backBuffer, MakeSdlRect(0, 0, backBuffer.w(), backBuffer.h()), { 0, 0 });
+	Screenshot.palette = SDLWrap::AllocPalette();
+	if (!SDLC_SetSurfaceAndPaletteColors(Screenshot.surface->surface, Screenshot.palette.get(), system_palette.data(), 0, 256))
+		ErrSdl();
+}
+
+/**
+ * @brief The name followed by the local date and time.
+ */
+std::string TimestampedName(std::string_view name)
+{
 	const std::time_t tt = std::time(nullptr);
 	const std::tm *tm = std::localtime(&tt);
-	const std::string filename = tm != nullptr
-	    ? StrCat("Screenshot from ",
-	          LeftPad(tm->tm_year + 1900, 4, '0'), "-", LeftPad(tm->tm_mon + 1, 2, '0'), "-", LeftPad(tm->tm_mday, 2, '0'), "-",
-	          LeftPad(tm->tm_hour, 2, '0'), "-", LeftPad(tm->tm_min, 2, '0'), "-", LeftPad(tm->tm_sec, 2, '0'))
-	    : "Screenshot";
+	if (tm == nullptr)
+		return std::string(name);
+	return StrCat(name, " from ",
+	    LeftPad(tm->tm_year + 1900, 4, '0'), "-", LeftPad(tm->tm_mon + 1, 2, '0'), "-", LeftPad(tm->tm_mday, 2, '0'), "-",
+	    LeftPad(tm->tm_hour, 2, '0'), "-", LeftPad(tm->tm_min, 2, '0'), "-", LeftPad(tm->tm_sec, 2, '0'));
+}
+
+SDL_IOStream *CaptureFile(std::string *dstPath)
+{
+	const char *ext = ScreenshotExtension;
+	const std::string filename = TimestampedName("Screenshot");
 	*dstPath = StrCat(paths::PrefPath(), filename, ext);
 	int i = 0;
 	while (FileExists(dstPath->c_str())) {
@@ -81,10 +160,109 @@ void RedPalette()
 	RenderPresent();
 }
 
+// Only touched by the game thread.
+std::optional<FrameRecorder> RecordedFrames;
+uint64_t LastRecordedFrameMicroseconds = 0;
+uint64_t LastSlowFrameCaptureMicroseconds = 0;
+
+// Handed to the frame capture thread, untouched by the game thread while WritingFrames is set.
+std::optional<FrameRecorder> FramesToWrite;
+std::string FrameCaptureDir;
+std::string FrameStatsReport;
+std::atomic<bool> WritingFrames { false };
+SdlThread FrameCaptureThread;
+
+[[nodiscard]] uint64_t NowMicroseconds()
+{
+	return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+bool WriteTextFile(const std::string &path, std::string_view text)
+{
+	FILE *file = OpenFile(path.c_str(), "wb");
+	if (file == nullptr)
+		return false;
+	const bool written = text.empty() || std::fwrite(text.data(), text.size(), 1, file) == 1;
+	return std::fclose(file) == 0 && written;
+}
+
+/**
+ * @brief Sets the colors of a surface that is not on screen, which can be done from any thread.
+ */
+bool SetOffscreenSurfaceColors(SDL_Surface *surface, SDL_Palette *palette, SDL_Color *colors)
+{
+#ifdef USE_SDL1
+	// SDLC_SetSurfaceAndPaletteColors would also set the colors of an 8-bit video surface.
+	return SDL_SetPalette(surface, SDL_LOGPAL, colors, 0, 256) != 0;
+#else
+	return SDLC_SetSurfaceAndPaletteColors(surface, palette, colors, 0, 256);
+#endif
+}
+
+bool WriteFrame(const RecordedFrame &frame, const std::string &path, SDL_Palette *palette)
+{
+	const OwnedSurface surface { frame.width, frame.height };
+	for (int y = 0; y < frame.height; y++)
+		std::memcpy(&surface[{ 0, y }], frame.pixels + static_cast<size_t>(y) * frame.pitch, frame.width);
+	std::array<SDL_Color, 256> colors;
+	for (size_t i = 0; i < colors.size(); i++)
+		colors[i] = SDL_Color { frame.palette[i * 3], frame.palette[i * 3 + 1], frame.palette[i * 3 + 2], SDL_ALPHA_OPAQUE };
+	if (!SetOffscreenSurfaceColors(surface.surface, palette, colors.data()))
+		return false;
+
+	SDL_IOStream *outStream = SDL_IOFromFile(path.c_str(), "wb");
+	if (outStream == nullptr)
+		return false;
+	if (!WriteScreenshotFile(surface, outStream).has_value()) {
+		RemoveFile(path.c_str());
+		return false;
+	}
+	return true;
+}
+
+/**
+ * @brief Writes each frame as an image, their timings as CSV and the frame stats, if collected, to FrameCaptureDir.
+ */
+void WriteFrameCapture()
+{
+	RecursivelyCreateDir(FrameCaptureDir.c_str());
+	SDLPaletteUniquePtr palette = SDLWrap::AllocPalette();
+
+	std::string timings = "frame,time_ms,frame_ms\n";
+	size_t index = 0;
+	size_t failed = 0;
+	uint64_t firstTimestamp = 0;
+	FramesToWrite->ForEach([&](const RecordedFrame &frame) {
+		if (index == 0)
+			firstTimestamp = frame.timestampMicroseconds;
+		const std::string path = StrCat(FrameCaptureDir, "frame-", LeftPad(index, 5, '0'), ScreenshotExtension);
+		if (!WriteFrame(frame, path, palette.get()))
+			failed++;
+		StrAppend(timings, index, ",", (frame.timestampMicroseconds - firstTimestamp) / 1000, ",", frame.frameMicroseconds / 1000, ".", LeftPad(frame.frameMicroseconds % 1000, 3, '0'), "\n");
+		index++;
+	});
+	if (!WriteTextFile(StrCat(FrameCaptureDir, "frames.csv"), timings))
+		failed++;
+	if (!FrameStatsReport.empty() && !WriteTextFile(StrCat(FrameCaptureDir, "frame_stats.txt"), FrameStatsReport))
+		failed++;
+
+	if (failed != 0) {
+		LogError("Failed to write {} of the files of the frame capture at {}: {}", failed, FrameCaptureDir, SDL_GetError());
+		SDL_ClearError();
+	} else {
+		Log("Frame capture of {} frames saved at {}", index, FrameCaptureDir);
+	}
+	FramesToWrite = std::nullopt;
+	WritingFrames.store(false, std::memory_order_release);
+}
+
 } // namespace
 
 void CaptureScreen()
 {
+	// Only one screenshot is encoded at a time.
+	EncodeThread.join();
+
 	std::string fileName;
 	const uint32_t startTime = SDL_GetTicks();
 
@@ -95,6 +273,10 @@ void CaptureScreen()
 		return;
 	}
 	DrawAndBlit();
+	Screenshot.fileName = std::move(fileName);
+	Screenshot.outStream = outStream;
+	SnapshotScreen();
+	EncodeThread = SdlThread { EncodeScreenshot };
 
 	const std::array<SDL_Color, 256> origSystemPalette = system_palette;
 	RedPalette();
@@ -102,19 +284,6 @@ void CaptureScreen()
 	system_palette = origSystemPalette;
 	SystemPaletteUpdated();
 
-	const tl::expected<void, std::string> result =
-#if DEVILUTIONX_SCREENSHOT_FORMAT == DEVILUTIONX_SCREENSHOT_FORMAT_PCX
-	    WriteSurfaceToFilePcx(GlobalBackBuffer(), outStream);
-#elif DEVILUTIONX_SCREENSHOT_FORMAT == DEVILUTIONX_SCREENSHOT_FORMAT_PNG
-	    WriteSurfaceToFilePng(GlobalBackBuffer(), outStream);
-#endif
-
-	if (!result.has_value()) {
-		LogError("Failed to save screenshot at {}: ", fileName, result.error());
-		RemoveFile(fileName.c_str());
-	} else {
-		Log("Screenshot saved at {}", fileName);
-	}
 	const uint32_t timePassed = SDL_GetTicks() - startTime;
 	if (timePassed < 300) {
 		SDL_Delay(300 - timePassed);
@@ -122,4 +291,76 @@ void CaptureScreen()
 	RedrawEverything();
 }
 
+void RecordFrame()
+{
+	const int seconds = *GetOptions().Graphics.frameCaptureSeconds;
+	if (seconds <= 0) {
+		RecordedFrames = std::nullopt;
+		return;
+	}
+	if (!RecordedFrames) {
+		RecordedFrames.emplace(FrameCaptureBudget);
+		LastRecordedFrameMicroseconds = 0;
+	}
+
+	const uint64_t now = NowMicroseconds();
+	const uint32_t frameMicroseconds = LastRecordedFrameMicroseconds == 0
+	    ? 0
+	    : static_cast<uint32_t>(std::min<uint64_t>(now - LastRecordedFrameMicroseconds, std::numeric_limits<uint32_t>::max()));
+	LastRecordedFrameMicroseconds = now;
+
+	const Surface &out = GlobalBackBuffer();
+	RecordedFrame frame {
+		.width = static_cast<uint16_t>(out.w()),
+		.height = static_cast<uint16_t>(out.h()),
+		.pitch = out.pitch(),
+		.pixels = out.begin(),
+		.frameMicroseconds = frameMicroseconds,
+		.timestampMicroseconds = now,
+	};
+	for (size_t i = 0; i < system_palette.size(); i++) {
+		frame.palette[i * 3] = system_palette[i].r;
+		frame.palette[i * 3 + 1] = system_palette[i].g;
+		frame.palette[i * 3 + 2] = system_palette[i].b;
+	}
+	const uint64_t keptMicroseconds = static_cast<uint64_t>(seconds) * 1000000;
+	RecordedFrames->Add(frame);
+	if (now > keptMicroseconds)
+		RecordedFrames->DropBefore(now - keptMicroseconds);
+
+	// Capture each stutter once, the second one within the kept time is already part of the first capture.
+	if (frameMicroseconds > SlowFrameMicroseconds && frameMicroseconds < FrameGapMicroseconds
+	    && now - LastSlowFrameCaptureMicroseconds > keptMicroseconds) {
+		LastSlowFrameCaptureMicroseconds = now;
+		Log("A frame took {} ms, writing the frame capture", frameMicroseconds / 1000);
+		CaptureFrames();
+	}
+}
+
+void CaptureFrames()
+{
+	if (!RecordedFrames || RecordedFrames->frameCount() == 0) {
+		Log("No frames to capture, set the Frame Capture option to keep them");
+		return;
+	}
+	if (WritingFrames.load(std::memory_order_acquire)) {
+		Log("The last frame capture is still being written");
+		return;
+	}
+	FrameCaptureThread.join();
+
+	FramesToWrite.emplace(std::move(*RecordedFrames));
+	RecordedFrames->Clear();
+	FrameCaptureDir = StrCat(paths::PrefPath(), TimestampedName("Frame capture"), DIRECTORY_SEPARATOR_STR);
+	FrameStatsReport = IsFrameStatsEnabled() ? FormatFrameStats() : "";
+	WritingFrames.store(true, std::memory_order_release);
+	FrameCaptureThread = SdlThread { WriteFrameCapture };
+}
+
+void FinishCaptureScreen()
+{
+	EncodeThread.join();
+	FrameCaptureThread.join();
+}
+
 } // namespace devilution
@@ -1,7 +1,7 @@
 /**
  * @file capture.h
  *
- * Interface of the screenshot function.
+ * Interface of the screenshot and frame capture functions.
  */
 #pragma once
 
@@ -12,4 +12,21 @@ namespace devilution {
  */
 void CaptureScreen();
 
+/**
+ * @brief Keeps the frame that was just drawn for a frame capture, while the Frame Capture option is on.
+ *
+ * Writes the frame capture by itself when the frame came late enough to be a stutter.
+ */
+void RecordFrame();
+
+/**
+ * @brief Writes the kept frames and their timings to a new folder, in the background.
+ */
+void CaptureFrames();
+
+/**
+ * @brief Waits until the last screenshot and frame capture have been written.
+ */
+void FinishCaptureScreen();
+
 } // namespace devilution
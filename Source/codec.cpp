@@ -83,8 +83,12 @@ void ByteSwapBlock(uint32_t *data)
 
 void XorBlock(const uint32_t *shaResult, uint32_t *out)
 {
+	// The digest repeated over the whole block, so that the XOR has no modulo and can be vectorized.
+	uint32_t key[BlockSize];
 	for (unsigned i = 0; i < BlockSize; ++i)
-		out[i] ^= shaResult[i % SHA1HashSize];
+		key[i] = shaResult[i % SHA1HashSize];
+	for (unsigned i = 0; i < BlockSize; ++i)
+		out[i] ^= key[i];
 }
 
 } // namespace
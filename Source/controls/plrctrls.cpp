@@ -1,6 +1,7 @@
 #include "controls/plrctrls.h"
 
 #include <algorithm>
+#include <array>
 #include <cmath>
 #include <cstdint>
 #include <list>
@@ -53,6 +54,7 @@
 #include "stores.h"
 #include "towners.h"
 #include "track.h"
+#include "utils/announcement.hpp"
 #include "utils/format_int.hpp"
 #include "utils/is_of.hpp"
 #include "utils/language.h"
@@ -169,7 +171,7 @@ int GetDistance(Point destination, int maxDistance)
 
 	int8_t walkpath[MaxPathLengthPlayer];
 	Player &myPlayer = *MyPlayer;
-	const int steps = FindPath(CanStep, [&myPlayer](Point position) { return PosOkPlayer(myPlayer, position); }, myPlayer.position.future, destination, walkpath, std::min<size_t>(maxDistance, MaxPathLengthPlayer));
+	const int steps = FindPath([](Point from, Point to) { return CanStep(from, to); }, [&myPlayer](Point position) { return PosOkPlayer(myPlayer, position); }, myPlayer.position.future, destination, walkpath, std::min<size_t>(maxDistance, MaxPathLengthPlayer));
 	if (steps > maxDistance)
 		return 0;
 
@@ -756,6 +758,71 @@ int GetSlotColumn(int slot)
 	return (slot - SLOTXY_INV_FIRST) % INV_ROW_SLOT_SIZE;
 }
 
+/** What an item's spoken name depends on, so it is only built again when one of these changes. */
+struct ItemSpeechKey {
+	uint32_t seed;
+	uint16_t createInfo;
+	_item_indexes idx;
+	bool identified;
+	int value;
+	uint32_t dwBuff;
+	uint32_t languageGeneration;
+
+	bool operator==(const ItemSpeechKey &) const = default;
+};
+
+struct CachedItemSpeech {
+	const Item *item = nullptr;
+	ItemSpeechKey key {};
+	std::string text;
+};
+
+/** Spoken names of the items the cursor moved over lately, indexed by where the item is stored. */
+std::array<CachedItemSpeech, 128> ItemSpeechCache;
+
+/** @brief The spoken name of an item, only valid until the next call. */
+std::string_view GetItemSpeech(const Item &item)
+{
+	const ItemSpeechKey key {
+		.seed = item._iSeed,
+		.createInfo = item._iCreateInfo,
+		.idx = item.IDidx,
+		.identified = item._iIdentified,
+		.value = item._ivalue,
+		.dwBuff = item.dwBuff,
+		.languageGeneration = GetAnnouncementLanguageGeneration(),
+	};
+	// Items next to each other in the inventory, belt or stash never share an entry.
+	CachedItemSpeech &cached = ItemSpeechCache[(reinterpret_cast<uintptr_t>(&item) / sizeof(Item)) % ItemSpeechCache.size()];
+	if (cached.item == &item && cached.key == key)
+		return cached.text;
+
+	cached.item = &item;
+	cached.key = key;
+	if (item._itype == ItemType::Gold) {
+		const int nGold = item._ivalue;
+		cached.text = fmt::format(fmt::runtime(ngettext("{:s} gold piece", "{:s} gold pieces", nGold)), FormatInteger(nGold));
+	} else {
+		cached.text = item.getName().str();
+	}
+	return cached.text;
+}
+
+/** @brief Speaks the item or "empty", after the slot's position if there is one. */
+void SpeakSlotForAccessibility(const Item *item, std::string_view positionInfo, std::string_view slotName)
+{
+	// Reused so moving the cursor doesn't allocate.
+	static std::string Text;
+	Text.clear();
+	if (item != nullptr && !item->isEmpty())
+		StrAppend(Text, positionInfo, GetItemSpeech(*item));
+	else if (!positionInfo.empty())
+		StrAppend(Text, positionInfo, _("empty"));
+	else
+		StrAppend(Text, slotName, ": ", _("empty"));
+	SpeakText(Text, /*force=*/true);
+}
+
 void SpeakInventorySlotForAccessibility()
 {
 	if (MyPlayer == nullptr)
@@ -808,28 +875,20 @@ void SpeakInventorySlotForAccessibility()
 		}
 	}
 
-	if (item != nullptr && !item->isEmpty()) {
-		std::string itemName;
-		if (item->_itype == ItemType::Gold) {
-			const int nGold = item->_ivalue;
-			itemName = fmt::format(fmt::runtime(ngettext("{:s} gold piece", "{:s} gold pieces", nGold)), FormatInteger(nGold));
-		} else {
-			itemName = std::string(item->getName());
-		}
-
-		if (!positionInfo.empty()) {
-			SpeakText(StrCat(positionInfo, itemName), /*force=*/true);
-		} else {
-			SpeakText(itemName, /*force=*/true);
-		}
+	if (item == nullptr || item->isEmpty()) {
+		const StringOrView slotName = GetInventorySlotNameForSpeech(Slot);
+		SpeakSlotForAccessibility(item, positionInfo, slotName.str());
 		return;
 	}
+	SpeakSlotForAccessibility(item, positionInfo, {});
+}
 
-	if (!positionInfo.empty()) {
-		SpeakText(StrCat(positionInfo, _("empty")), /*force=*/true);
-	} else {
-		SpeakText(StrCat(GetInventorySlotNameForSpeech(Slot), ": ", _("empty")), /*force=*/true);
-	}
+void SpeakStashSlotForAccessibility(Point stashSlot)
+{
+	const StashStruct::StashCell itemId = Stash.GetItemIdAtPosition(stashSlot);
+	const Item *item = itemId != StashStruct::EmptyCell ? &Stash.stashList[itemId] : nullptr;
+	const std::string positionInfo = fmt::format("Row {}, Column {}: ", stashSlot.y + 1, stashSlot.x + 1);
+	SpeakSlotForAccessibility(item, positionInfo, {});
 }
 
 /**
@@ -1677,7 +1736,7 @@ void StashMove(AxisDirection dir)
 		if (holdItem.isEmpty()) {
 			const StashStruct::StashCell itemIdAtActiveStashSlot = Stash.GetItemIdAtPosition(ActiveStashSlot);
 			if (itemIdAtActiveStashSlot != StashStruct::EmptyCell) {
-				const Item stashItem = Stash.stashList[itemIdAtActiveStashSlot];
+				const Item &stashItem = Stash.stashList[itemIdAtActiveStashSlot];
 				const Point firstSlotOnItem = FindFirstStashSlotOnItem(itemIdAtActiveStashSlot);
 				itemSize = GetInventorySize(stashItem);
 				mousePos = GetStashSlotCoord(firstSlotOnItem);
@@ -1686,6 +1745,7 @@ void StashMove(AxisDirection dir)
 
 		mousePos += Displacement { itemSize.width * INV_SLOT_HALF_SIZE_PX, itemSize.height * INV_SLOT_HALF_SIZE_PX };
 		SetCursorPos(mousePos);
+		SpeakStashSlotForAccessibility(ActiveStashSlot);
 		return;
 	}
 
@@ -1,6 +1,8 @@
 #include "crawl.hpp"
 
-#include <type_traits>
+#include <array>
+#include <cstddef>
+#include <span>
 
 #include <function_ref.hpp>
 
@@ -8,6 +10,55 @@
 
 namespace devilution {
 
+namespace {
+
+constexpr size_t CrawlRingSize(unsigned radius)
+{
+	return radius == 0 ? 1 : (radius == 1 ? 4 : 8 * radius);
+}
+
+constexpr size_t CrawlTableSize(unsigned maxRadius)
+{
+	size_t size = 0;
+	for (unsigned r = 0; r <= maxRadius; ++r)
+		size += CrawlRingSize(r);
+	return size;
+}
+
+struct CrawlTableData {
+	std::array<Displacement, CrawlTableSize(MaxCrawlTableRadius)> displacements {};
+	/** Index of the first displacement of each ring, plus the end of the table. */
+	std::array<size_t, MaxCrawlTableRadius + 2> ringStarts {};
+};
+
+constexpr CrawlTableData GenerateCrawlTable()
+{
+	CrawlTableData table;
+	size_t size = 0;
+	for (unsigned r = 0; r <= MaxCrawlTableRadius; ++r) {
+		table.ringStarts[r] = size;
+		CrawlRing(static_cast<int>(r), [&](Displacement displacement) {
+			table.displacements[size++] = displacement;
+			return true;
+		});
+	}
+	table.ringStarts[MaxCrawlTableRadius + 1] = size;
+	return table;
+}
+
+constexpr CrawlTableData CrawlTable = GenerateCrawlTable();
+
+static_assert(CrawlTable.ringStarts[MaxCrawlTableRadius + 1] == CrawlTable.displacements.size());
+static_assert(CrawlTable.displacements[1] == Displacement { 0, 1 });
+
+} // namespace
+
+std::span<const Displacement> CrawlTableRing(unsigned radius)
+{
+	const size_t start = CrawlTable.ringStarts[radius];
+	return { CrawlTable.displacements.data() + start, CrawlTable.ringStarts[radius + 1] - start };
+}
+
 bool DoCrawl(unsigned radius, tl::function_ref<bool(Displacement)> function)
 {
 	return DoCrawl(radius, radius, function);
@@ -15,33 +66,7 @@ bool DoCrawl(unsigned radius, tl::function_ref<bool(Displacement)> function)
 
 bool DoCrawl(unsigned minRadius, unsigned maxRadius, tl::function_ref<bool(Displacement)> function)
 {
-	for (int r = static_cast<int>(minRadius); r <= static_cast<int>(maxRadius); ++r) {
-		if (!function(Displacement { 0, r })) return false;
-		if (r == 0) continue;
-		if (!function(Displacement { 0, -r })) return false;
-		for (int x = 1; x < r; ++x) {
-			if (!function(Displacement { -x, r })) return false;
-			if (!function(Displacement { x, r })) return false;
-			if (!function(Displacement { -x, -r })) return false;
-			if (!function(Displacement { x, -r })) return false;
-		}
-		if (r > 1) {
-			const int d = r - 1;
-			if (!function(Displacement { -d, d })) return false;
-			if (!function(Displacement { d, d })) return false;
-			if (!function(Displacement { -d, -d })) return false;
-			if (!function(Displacement { d, -d })) return false;
-		}
-		if (!function(Displacement { -r, 0 })) return false;
-		if (!function(Displacement { r, 0 })) return false;
-		for (int y = 1; y < r; ++y) {
-			if (!function(Displacement { -r, y })) return false;
-			if (!function(Displacement { r, y })) return false;
-			if (!function(Displacement { -r, -y })) return false;
-			if (!function(Displacement { r, -y })) return false;
-		}
-	}
-	return true;
+	return ForEachCrawlDisplacement(minRadius, maxRadius, function);
 }
 
 } // namespace devilution
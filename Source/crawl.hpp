@@ -1,4 +1,8 @@
+#pragma once
+
+#include <span>
 #include <type_traits>
+#include <utility>
 
 #include <function_ref.hpp>
 
@@ -30,14 +34,73 @@ namespace devilution {
  *    +-------> x
  */
 
+/**
+ * @brief Visits the displacements at `radius` in crawl order.
+ * @return False if `function` returned false and stopped the crawl.
+ */
+template <typename F>
+constexpr bool CrawlRing(int r, F &&function)
+{
+	if (!function(Displacement { 0, r })) return false;
+	if (r == 0) return true;
+	if (!function(Displacement { 0, -r })) return false;
+	for (int x = 1; x < r; ++x) {
+		if (!function(Displacement { -x, r })) return false;
+		if (!function(Displacement { x, r })) return false;
+		if (!function(Displacement { -x, -r })) return false;
+		if (!function(Displacement { x, -r })) return false;
+	}
+	if (r > 1) {
+		const int d = r - 1;
+		if (!function(Displacement { -d, d })) return false;
+		if (!function(Displacement { d, d })) return false;
+		if (!function(Displacement { -d, -d })) return false;
+		if (!function(Displacement { d, -d })) return false;
+	}
+	if (!function(Displacement { -r, 0 })) return false;
+	if (!function(Displacement { r, 0 })) return false;
+	for (int y = 1; y < r; ++y) {
+		if (!function(Displacement { -r, y })) return false;
+		if (!function(Displacement { r, y })) return false;
+		if (!function(Displacement { -r, -y })) return false;
+		if (!function(Displacement { r, -y })) return false;
+	}
+	return true;
+}
+
+/** Rings up to this radius are precomputed, larger ones are generated while crawling. */
+constexpr unsigned MaxCrawlTableRadius = 19;
+
+/** @brief The displacements at `radius` in crawl order, `radius` must not exceed MaxCrawlTableRadius. */
+[[nodiscard]] std::span<const Displacement> CrawlTableRing(unsigned radius);
+
+/**
+ * @brief Visits the displacements from `minRadius` to `maxRadius` in crawl order, with `function` inlined.
+ * @return False if `function` returned false and stopped the crawl.
+ */
+template <typename F>
+bool ForEachCrawlDisplacement(unsigned minRadius, unsigned maxRadius, F &&function)
+{
+	for (unsigned r = minRadius; r <= maxRadius; ++r) {
+		if (r > MaxCrawlTableRadius) {
+			if (!CrawlRing(static_cast<int>(r), function)) return false;
+			continue;
+		}
+		for (const Displacement displacement : CrawlTableRing(r)) {
+			if (!function(displacement)) return false;
+		}
+	}
+	return true;
+}
+
 bool DoCrawl(unsigned radius, tl::function_ref<bool(Displacement)> function);
 bool DoCrawl(unsigned minRadius, unsigned maxRadius, tl::function_ref<bool(Displacement)> function);
 
 template <typename F>
-auto Crawl(unsigned radius, F function) -> std::invoke_result_t<decltype(function), Displacement>
+auto Crawl(unsigned minRadius, unsigned maxRadius, F function) -> std::invoke_result_t<decltype(function), Displacement>
 {
 	std::invoke_result_t<decltype(function), Displacement> result;
-	DoCrawl(radius, [&result, &function](Displacement displacement) -> bool {
+	ForEachCrawlDisplacement(minRadius, maxRadius, [&result, &function](Displacement displacement) -> bool {
 		result = function(displacement);
 		return !result;
 	});
@@ -45,14 +108,9 @@ auto Crawl(unsigned radius, F function) -> std::invoke_result_t<decltype(functio
 }
 
 template <typename F>
-auto Crawl(unsigned minRadius, unsigned maxRadius, F function) -> std::invoke_result_t<decltype(function), Displacement>
+auto Crawl(unsigned radius, F function) -> std::invoke_result_t<decltype(function), Displacement>
 {
-	std::invoke_result_t<decltype(function), Displacement> result;
-	DoCrawl(minRadius, maxRadius, [&result, &function](Displacement displacement) -> bool {
-		result = function(displacement);
-		return !result;
-	});
-	return result;
+	return Crawl(radius, radius, std::move(function));
 }
 
 } // namespace devilution
@@ -8,6 +8,7 @@
 #include <cmath>
 #include <cstdint>
 #include <limits>
+#include <memory>
 #include <string_view>
 #include <vector>
 
@@ -28,9 +29,9 @@
 #include "engine/backbuffer_state.hpp"
 #include "engine/demomode.h"
 #include "engine/point.hpp"
-#include "engine/points_in_rectangle_range.hpp"
 #include "engine/render/clx_render.hpp"
 #include "engine/render/primitive_render.hpp"
+#include "engine/render/scrollrt.h"
 #include "engine/trn.hpp"
 #include "headless_mode.hpp"
 #include "hwcursor.hpp"
@@ -64,8 +65,45 @@ namespace {
 OptionalOwnedClxSpriteList pCursCels;
 OptionalOwnedClxSpriteList pCursCels2;
 
-OptionalOwnedClxSpriteList *HalfSizeItemSprites;
-OptionalOwnedClxSpriteList *HalfSizeItemSpritesRed;
+/** Half-size sprites of the items shown in the stores, each made the first time it is drawn. */
+struct HalfSizeItemSpriteCache {
+	static constexpr int MaxWidth = 28 * 3;
+	static constexpr int MaxHeight = 28 * 3;
+
+	std::vector<OptionalOwnedClxSpriteList> sprites;
+	std::vector<OptionalOwnedClxSpriteList> spritesRed;
+	OwnedSurface itemSurface { MaxWidth, MaxHeight };
+	OwnedSurface halfSurface { MaxWidth / 2, MaxHeight / 2 };
+};
+
+std::unique_ptr<HalfSizeItemSpriteCache> HalfSizeItemSprites;
+
+ClxSprite GetOrCreateHalfSizeItemSprite(int cursId, bool red)
+{
+	if (HalfSizeItemSprites == nullptr)
+		CreateHalfSizeItemSprites();
+	HalfSizeItemSpriteCache &cache = *HalfSizeItemSprites;
+	OptionalOwnedClxSpriteList &sprite = (red ? cache.spritesRed : cache.sprites)[cursId];
+	if (sprite.has_value())
+		return (*sprite)[0];
+
+	const ClxSprite itemSprite = GetInvItemSprite(static_cast<int>(CURSOR_FIRSTITEM) + cursId);
+	const Surface itemSurface = cache.itemSurface.subregion(0, 0, itemSprite.width(), itemSprite.height());
+	const SDL_Rect itemSurfaceRect = MakeSdlRect(0, 0, itemSurface.w(), itemSurface.h());
+	SDL_SetSurfaceClipRect(itemSurface.surface, &itemSurfaceRect);
+	SDL_FillSurfaceRect(itemSurface.surface, nullptr, 1);
+	if (red)
+		ClxDrawTRN(itemSurface, { 0, itemSurface.h() }, itemSprite, GetInfravisionTRN());
+	else
+		ClxDraw(itemSurface, { 0, itemSurface.h() }, itemSprite);
+
+	const Surface halfSurface = cache.halfSurface.subregion(0, 0, itemSurface.w() / 2, itemSurface.h() / 2);
+	const SDL_Rect halfSurfaceRect = MakeSdlRect(0, 0, halfSurface.w(), halfSurface.h());
+	SDL_SetSurfaceClipRect(halfSurface.surface, &halfSurfaceRect);
+	BilinearDownscaleByHalf8(itemSurface.surface, paletteTransparencyLookup, halfSurface.surface, 1);
+	sprite.emplace(SurfaceToClx(halfSurface, 1, 1));
+	return (*sprite)[0];
+}
 
 bool IsValidMonsterForSelection(const Monster &monster)
 {
@@ -252,7 +290,7 @@ bool TrySelectItem(bool flipflag, Point tile)
 	return pcursitem != -1;
 }
 
-bool TrySelectPixelBased(Point tile)
+bool TrySelectPixelBased()
 {
 	if (demo::IsRunning() || demo::IsRecording() || HeadlessMode) {
 		// Recorded demos can run headless, but headless mode doesn't support loading sprites that are needed for pixel perfect selection
@@ -278,106 +316,83 @@ bool TrySelectPixelBased(Point tile)
 		return IsPointWithinClx(pointInSprite, sprite);
 	};
 
-	auto convertFromRenderingToWorldTile = [](Point renderingPoint) {
-		// Columns
-		Displacement ret = Displacement(Direction::East) * renderingPoint.x;
-		// Rows
-		ret += Displacement(Direction::South) * renderingPoint.y / 2;
-		if ((renderingPoint.y & 1) == 1)
-			ret.deltaY += 1;
-		return ret;
-	};
-
-	// Try to find the selected entity from rendered pixels.
-	// We search the rendered rows/columns backwards, because the last rendered tile overrides previous rendered pixels.
-	auto searchArea = PointsInRectangle(Rectangle { { -1, -1 }, { 3, 8 } });
-	for (auto it = searchArea.rbegin(); it != searchArea.rend(); ++it) {
-		const Point renderingColumnRaw = *it;
-		const Point adjacentTile = tile + convertFromRenderingToWorldTile(renderingColumnRaw);
-		if (!InDungeonBounds(adjacentTile))
-			continue;
+	// Ask the sprites in the order they were last drawn, because the last drawn one covers the others.
+	Point hitPosition = MousePosition;
+	if (*GetOptions().Graphics.zoom)
+		hitPosition /= 2;
+	const auto isHit = [&](const DrawnSprite &drawn) {
+		const Point tile = drawn.tile;
+		if (!InDungeonBounds(tile))
+			return false;
 
-		int monsterId = dMonster[adjacentTile.x][adjacentTile.y];
-		// Never select a monster if a target-player-only spell is selected
-		if (monsterId != 0 && IsNoneOf(pcurs, CURSOR_HEALOTHER, CURSOR_RESURRECT)) {
-			monsterId = std::abs(monsterId) - 1;
-			if (leveltype == DTYPE_TOWN) {
-				const Towner &towner = Towners[monsterId];
-				const ClxSprite sprite = towner.currentSprite();
-				const Displacement renderingOffset = towner.getRenderingOffset();
-				if (checkSprite(adjacentTile, sprite, renderingOffset)) {
-					cursPosition = adjacentTile;
-					pcursmonst = monsterId;
-					return true;
-				}
+		switch (drawn.kind) {
+		case DrawnSprite::Kind::Monster:
+		case DrawnSprite::Kind::Towner: {
+			// Never select a monster if a target-player-only spell is selected
+			if (IsAnyOf(pcurs, CURSOR_HEALOTHER, CURSOR_RESURRECT) || std::abs(dMonster[tile.x][tile.y]) - 1 != drawn.index)
+				return false;
+			if (drawn.kind == DrawnSprite::Kind::Towner) {
+				if (leveltype != DTYPE_TOWN)
+					return false;
+				const Towner &towner = Towners[drawn.index];
+				if (!checkSprite(tile, towner.currentSprite(), towner.getRenderingOffset()))
+					return false;
 			} else {
-				const Monster &monster = Monsters[monsterId];
-				if (IsTileLit(adjacentTile) && IsValidMonsterForSelection(monster)) {
-					const ClxSprite sprite = monster.animInfo.currentSprite();
-					const Displacement renderingOffset = monster.getRenderingOffset(sprite);
-					if (checkSprite(adjacentTile, sprite, renderingOffset)) {
-						cursPosition = adjacentTile;
-						pcursmonst = monsterId;
-						return true;
-					}
-				}
-			}
-		}
-
-		const int8_t dPlayerValue = dPlayer[adjacentTile.x][adjacentTile.y];
-		if (dPlayerValue != 0) {
-			const uint8_t playerId = std::abs(dPlayerValue) - 1;
-			if (playerId != MyPlayerId) {
-				const Player &player = Players[playerId];
-				const ClxSprite sprite = player.currentSprite();
-				const Displacement renderingOffset = player.getRenderingOffset(sprite);
-				if (checkSprite(adjacentTile, sprite, renderingOffset)) {
-					cursPosition = adjacentTile;
-					PlayerUnderCursor = &player;
-					return true;
-				}
+				if (leveltype == DTYPE_TOWN)
+					return false;
+				const Monster &monster = Monsters[drawn.index];
+				if (!IsTileLit(tile) || !IsValidMonsterForSelection(monster))
+					return false;
+				const ClxSprite sprite = monster.animInfo.currentSprite();
+				if (!checkSprite(tile, sprite, monster.getRenderingOffset(sprite)))
+					return false;
 			}
+			cursPosition = tile;
+			pcursmonst = drawn.index;
+			return true;
 		}
-		if (TileContainsDeadPlayer(adjacentTile)) {
-			for (const Player &player : Players) {
-				if (player.position.tile == adjacentTile && &player != MyPlayer) {
-					const ClxSprite sprite = player.currentSprite();
-					const Displacement renderingOffset = player.getRenderingOffset(sprite);
-					if (checkSprite(adjacentTile, sprite, renderingOffset)) {
-						cursPosition = adjacentTile;
-						PlayerUnderCursor = &player;
-						return true;
-					}
-				}
-			}
+		case DrawnSprite::Kind::Player: {
+			if (drawn.index == static_cast<int>(MyPlayerId))
+				return false;
+			const Player &player = Players[drawn.index];
+			const bool standsHere = std::abs(dPlayer[tile.x][tile.y]) - 1 == drawn.index;
+			const bool liesHere = TileContainsDeadPlayer(tile) && player.position.tile == tile;
+			if (!standsHere && !liesHere)
+				return false;
+			const ClxSprite sprite = player.currentSprite();
+			if (!checkSprite(tile, sprite, player.getRenderingOffset(sprite)))
+				return false;
+			cursPosition = tile;
+			PlayerUnderCursor = &player;
+			return true;
 		}
-
-		Object *object = FindObjectAtPosition(adjacentTile);
-		if (object != nullptr && object->canInteractWith()) {
+		case DrawnSprite::Kind::Object: {
+			Object *object = FindObjectAtPosition(tile);
+			if (object == nullptr || static_cast<int>(object->GetId()) != drawn.index || !object->canInteractWith())
+				return false;
 			const ClxSprite sprite = object->currentSprite();
-			const Displacement renderingOffset = object->getRenderingOffset(sprite, adjacentTile);
-			if (checkSprite(adjacentTile, sprite, renderingOffset)) {
-				cursPosition = adjacentTile;
-				ObjectUnderCursor = object;
-				return true;
-			}
+			if (!checkSprite(tile, sprite, object->getRenderingOffset(sprite, tile)))
+				return false;
+			cursPosition = tile;
+			ObjectUnderCursor = object;
+			return true;
 		}
-
-		uint8_t itemId = dItem[adjacentTile.x][adjacentTile.y];
-		if (itemId != 0) {
-			itemId = itemId - 1;
-			const Item &item = Items[itemId];
+		case DrawnSprite::Kind::Item: {
+			if (dItem[tile.x][tile.y] - 1 != drawn.index)
+				return false;
+			const Item &item = Items[drawn.index];
 			const ClxSprite sprite = item.AnimInfo.currentSprite();
-			const Displacement renderingOffset = item.getRenderingOffset(sprite);
-			if (checkSprite(adjacentTile, sprite, renderingOffset)) {
-				cursPosition = adjacentTile;
-				pcursitem = static_cast<int8_t>(itemId);
-				return true;
-			}
+			if (!checkSprite(tile, sprite, item.getRenderingOffset(sprite)))
+				return false;
+			cursPosition = tile;
+			pcursitem = static_cast<int8_t>(drawn.index);
+			return true;
 		}
-	}
+		}
+		return false;
+	};
 
-	return false;
+	return FindDrawnSprite(hitPosition, isHit).has_value();
 }
 
 #ifndef UNPACKED_MPQS
@@ -478,12 +493,12 @@ Size GetInvItemSize(int cursId)
 
 ClxSprite GetHalfSizeItemSprite(int cursId)
 {
-	return (*HalfSizeItemSprites[cursId])[0];
+	return GetOrCreateHalfSizeItemSprite(cursId, /*red=*/false);
 }
 
 ClxSprite GetHalfSizeItemSpriteRed(int cursId)
 {
-	return (*HalfSizeItemSpritesRed[cursId])[0];
+	return GetOrCreateHalfSizeItemSprite(cursId, /*red=*/true);
 }
 
 void CreateHalfSizeItemSprites()
@@ -492,58 +507,14 @@ void CreateHalfSizeItemSprites()
 		return;
 	const uint32_t numInvItems = pCursCels->numSprites() - (static_cast<uint32_t>(CURSOR_FIRSTITEM) - 1)
 	    + (pCursCels2.has_value() ? pCursCels2->numSprites() : 0);
-	HalfSizeItemSprites = new OptionalOwnedClxSpriteList[numInvItems];
-	HalfSizeItemSpritesRed = new OptionalOwnedClxSpriteList[numInvItems];
-	const uint8_t *redTrn = GetInfravisionTRN();
-
-	constexpr int MaxWidth = 28 * 3;
-	constexpr int MaxHeight = 28 * 3;
-	OwnedSurface ownedItemSurface { MaxWidth, MaxHeight };
-	OwnedSurface ownedHalfSurface { MaxWidth / 2, MaxHeight / 2 };
-
-	const auto createHalfSize = [&, redTrn](const ClxSprite itemSprite, size_t outputIndex) {
-		if (itemSprite.width() <= 28 && itemSprite.height() <= 28) {
-			// Skip creating half-size sprites for 1x1 items because we always render them at full size anyway.
-			return;
-		}
-		const Surface itemSurface = ownedItemSurface.subregion(0, 0, itemSprite.width(), itemSprite.height());
-		const SDL_Rect itemSurfaceRect = MakeSdlRect(0, 0, itemSurface.w(), itemSurface.h());
-
-		SDL_SetSurfaceClipRect(itemSurface.surface, &itemSurfaceRect);
-		SDL_FillSurfaceRect(itemSurface.surface, nullptr, 1);
-		ClxDraw(itemSurface, { 0, itemSurface.h() }, itemSprite);
-
-		const Surface halfSurface = ownedHalfSurface.subregion(0, 0, itemSurface.w() / 2, itemSurface.h() / 2);
-		const SDL_Rect halfSurfaceRect = MakeSdlRect(0, 0, halfSurface.w(), halfSurface.h());
-		SDL_SetSurfaceClipRect(halfSurface.surface, &halfSurfaceRect);
-		BilinearDownscaleByHalf8(itemSurface.surface, paletteTransparencyLookup, halfSurface.surface, 1);
-		HalfSizeItemSprites[outputIndex].emplace(SurfaceToClx(halfSurface, 1, 1));
-
-		SDL_FillSurfaceRect(itemSurface.surface, nullptr, 1);
-		ClxDrawTRN(itemSurface, { 0, itemSurface.h() }, itemSprite, redTrn);
-		BilinearDownscaleByHalf8(itemSurface.surface, paletteTransparencyLookup, halfSurface.surface, 1);
-		HalfSizeItemSpritesRed[outputIndex].emplace(SurfaceToClx(halfSurface, 1, 1));
-	};
-
-	size_t outputIndex = 0;
-	for (size_t i = static_cast<int>(CURSOR_FIRSTITEM) - 1, n = pCursCels->numSprites(); i < n; ++i, ++outputIndex) {
-		createHalfSize((*pCursCels)[i], outputIndex);
-	}
-	if (pCursCels2.has_value()) {
-		for (size_t i = 0, n = pCursCels2->numSprites(); i < n; ++i, ++outputIndex) {
-			createHalfSize((*pCursCels2)[i], outputIndex);
-		}
-	}
+	HalfSizeItemSprites = std::make_unique<HalfSizeItemSpriteCache>();
+	HalfSizeItemSprites->sprites.resize(numInvItems);
+	HalfSizeItemSprites->spritesRed.resize(numInvItems);
 }
 
 void FreeHalfSizeItemSprites()
 {
-	if (HalfSizeItemSprites != nullptr) {
-		delete[] HalfSizeItemSprites;
-		HalfSizeItemSprites = nullptr;
-		delete[] HalfSizeItemSpritesRed;
-		HalfSizeItemSpritesRed = nullptr;
-	}
+	HalfSizeItemSprites = nullptr;
 }
 
 void DrawItem(const Item &item, const Surface &out, Point position, ClxSprite clx)
@@ -855,7 +826,7 @@ bool CheckCursorActions(const Point currentTile, bool flipflag)
 		return true;
 	}
 
-	if (TrySelectPixelBased(currentTile))
+	if (TrySelectPixelBased())
 		return true;
 
 	if (leveltype != DTYPE_TOWN) {
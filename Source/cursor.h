@@ -77,8 +77,14 @@ void DrawItem(const Item &item, const Surface &out, Point position, ClxSprite cl
 /** Returns the sprite for the given inventory index. */
 ClxSprite GetInvItemSprite(int cursId);
 
+/**
+ * @brief Returns the half-size sprite of an item for the stores, by index from CURSOR_FIRSTITEM.
+ *
+ * Each sprite is downscaled the first time it is asked for, and kept until FreeHalfSizeItemSprites().
+ */
 ClxSprite GetHalfSizeItemSprite(int cursId);
 ClxSprite GetHalfSizeItemSpriteRed(int cursId);
+/** @brief Makes room for the half-size sprites, which are only made once they are drawn. */
 void CreateHalfSizeItemSprites();
 void FreeHalfSizeItemSprites();
 
@@ -6,6 +6,8 @@
 #include "dead.h"
 
 #include <cstdint>
+#include <limits>
+#include <vector>
 
 #include "diablo.h"
 #include "headless_mode.hpp"
@@ -18,8 +20,24 @@ namespace devilution {
 
 Corpse Corpses[MaxCorpses];
 int8_t stonendx;
+uint32_t CorpseGeneration;
 
 namespace {
+
+std::vector<CorpseEntry> CorpseEntries;
+int NextCorpseEntryId;
+
+void AddCorpseEntry(Point tilePosition)
+{
+	CorpseEntries.push_back({ NextCorpseEntryId, tilePosition });
+	NextCorpseEntryId = NextCorpseEntryId == std::numeric_limits<int>::max() ? 0 : NextCorpseEntryId + 1;
+}
+
+void RemoveCorpseEntry(Point tilePosition)
+{
+	std::erase_if(CorpseEntries, [tilePosition](const CorpseEntry &entry) { return entry.position == tilePosition; });
+}
+
 void InitDeadAnimationFromMonster(Corpse &corpse, const CMonster &mon)
 {
 	const AnimStruct &animData = mon.getAnimData(MonsterGraphic::Death);
@@ -34,12 +52,10 @@ void InitDeadAnimationFromMonster(Corpse &corpse, const CMonster &mon)
 
 void MoveLightToCorpse(Monster &monster)
 {
-	for (int dx = 0; dx < MAXDUNX; dx++) {
-		for (int dy = 0; dy < MAXDUNY; dy++) {
-			if ((dCorpse[dx][dy] & 0x1F) == monster.corpseId) {
-				ChangeLightXY(monster.lightId, { dx, dy });
-				return;
-			}
+	for (const CorpseEntry &entry : CorpseEntries) {
+		if ((dCorpse[entry.position.x][entry.position.y] & 0x1F) == monster.corpseId) {
+			ChangeLightXY(monster.lightId, entry.position);
+			return;
 		}
 	}
 	AddUnLight(monster.lightId);
@@ -92,7 +108,47 @@ void InitCorpses()
 
 void AddCorpse(Point tilePosition, int8_t dv, Direction ddir)
 {
-	dCorpse[tilePosition.x][tilePosition.y] = (dv & 0x1F) + (static_cast<int>(ddir) << 5);
+	int8_t &corpse = dCorpse[tilePosition.x][tilePosition.y];
+	const bool hadCorpse = corpse != 0;
+	corpse = (dv & 0x1F) + (static_cast<int>(ddir) << 5);
+	if (!hadCorpse && corpse != 0)
+		AddCorpseEntry(tilePosition);
+	else if (hadCorpse && corpse == 0)
+		RemoveCorpseEntry(tilePosition);
+	CorpseGeneration++;
+}
+
+void RemoveCorpse(Point tilePosition)
+{
+	dCorpse[tilePosition.x][tilePosition.y] = 0;
+	RemoveCorpseEntry(tilePosition);
+	CorpseGeneration++;
+}
+
+void SyncCorpseEntries()
+{
+	CorpseEntries.clear();
+	for (int y = 0; y < MAXDUNY; y++) {
+		for (int x = 0; x < MAXDUNX; x++) {
+			if (dCorpse[x][y] != 0)
+				AddCorpseEntry({ x, y });
+		}
+	}
+	CorpseGeneration++;
+}
+
+std::span<const CorpseEntry> GetCorpseEntries()
+{
+	return CorpseEntries;
+}
+
+const CorpseEntry *FindCorpseEntry(int id)
+{
+	for (const CorpseEntry &entry : CorpseEntries) {
+		if (entry.id == id)
+			return &entry;
+	}
+	return nullptr;
 }
 
 void MoveLightsToCorpses()
@@ -7,6 +7,7 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <span>
 
 #include "engine/clx_sprite.hpp"
 #include "engine/direction.hpp"
@@ -34,11 +35,28 @@ struct Corpse {
 	}
 };
 
+/** @brief A tile of the current level with a corpse on it. */
+struct CorpseEntry {
+	/** Unique for as long as the game runs, so a corpse put on the same tile later is told apart. */
+	int id;
+	Point position;
+};
+
 extern Corpse Corpses[MaxCorpses];
 extern int8_t stonendx;
+/** @brief Incremented whenever a corpse is added to or removed from dCorpse. */
+extern uint32_t CorpseGeneration;
 
 void InitCorpses();
 void AddCorpse(Point tilePosition, int8_t dv, Direction ddir);
+/** @brief Clears a tile of dCorpse, for corpses that get eaten. */
+void RemoveCorpse(Point tilePosition);
+/** @brief Rebuilds the list of corpses after dCorpse was cleared or loaded as a whole. */
+void SyncCorpseEntries();
+/** @brief The tiles with a corpse, oldest first, so they can be searched without scanning dCorpse. */
+[[nodiscard]] std::span<const CorpseEntry> GetCorpseEntries();
+/** @return The corpse with the given CorpseEntry::id, nullptr if it is gone. */
+[[nodiscard]] const CorpseEntry *FindCorpseEntry(int id);
 void MoveLightsToCorpses();
 
 } // namespace devilution
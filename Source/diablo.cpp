@@ -5,10 +5,13 @@
  */
 #include <algorithm>
 #include <array>
+#include <chrono>
 #include <cstdint>
 #include <cstdlib>
 #include <limits>
+#include <memory>
 #include <queue>
+#include <span>
 #include <string_view>
 #include <vector>
 
@@ -24,11 +27,13 @@
 #endif
 #endif
 
+#include <ankerl/unordered_dense.h>
 #include <fmt/format.h>
 
 #include <config.h>
 
 #include "DiabloUI/selstart.h"
+#include "accessibility_queries.hpp"
 #include "appfat.h"
 #include "automap.h"
 #include "capture.h"
@@ -48,17 +53,30 @@
 #include "discord/discord.h"
 #include "doom.h"
 #include "encrypt.h"
+#include "engine/asset_stats.hpp"
 #include "engine/backbuffer_state.hpp"
 #include "engine/clx_sprite.hpp"
 #include "engine/demomode.h"
 #include "engine/dx.h"
 #include "engine/events.hpp"
+#include "engine/frame_stats.hpp"
+#include "engine/level_arena.hpp"
 #include "engine/load_cel.hpp"
 #include "engine/load_file.hpp"
+#include "engine/navigation_field.hpp"
 #include "engine/path.h"
+#include "engine/path_worker.hpp"
 #include "engine/random.hpp"
 #include "engine/render/clx_render.hpp"
+#include "engine/render/render_workers.hpp"
+#include "engine/sector_graph.hpp"
 #include "engine/sound.h"
+#include "engine/spatial_index.hpp"
+#include "engine/startup_timing.hpp"
+#include "engine/tick_timing.hpp"
+#include "engine/tour_planner.hpp"
+#include "engine/tracing.hpp"
+#include "engine/walk_path.hpp"
 #include "game_mode.hpp"
 #include "gamemenu.h"
 #include "gmenu.h"
@@ -72,6 +90,7 @@
 #include "levels/drlg_l3.h"
 #include "levels/drlg_l4.h"
 #include "levels/gendung.h"
+#include "levels/level_prefetch.hpp"
 #include "levels/setmaps.h"
 #include "levels/themes.h"
 #include "levels/tile_properties.hpp"
@@ -112,9 +131,12 @@
 #include "tables/playerdat.hpp"
 #include "towners.h"
 #include "track.h"
+#include "utils/algorithm/container.hpp"
+#include "utils/announcement.hpp"
 #include "utils/console.h"
 #include "utils/display.h"
 #include "utils/format_int.hpp"
+#include "utils/headless_speech.hpp"
 #include "utils/is_of.hpp"
 #include "utils/language.h"
 #include "utils/parse_int.hpp"
@@ -123,6 +145,10 @@
 #include "utils/screen_reader.hpp"
 #include "utils/sdl_compat.h"
 #include "utils/sdl_thread.h"
+#if defined(SCREEN_READER_INTEGRATION) && !defined(NOSOUND)
+#include "utils/speech_clips.hpp"
+#endif
+#include "utils/static_vector.hpp"
 #include "utils/status_macros.hpp"
 #include "utils/str_cat.hpp"
 #include "utils/utf8.hpp"
@@ -179,17 +205,22 @@ void SelectNextTownNpcKeyPressed();
 void SelectPreviousTownNpcKeyPressed();
 void UpdateAutoWalkTownNpc();
 void UpdateAutoWalkTracker();
+std::optional<PathJobResult> RequestAutoWalkPath(const Player &player, const PathJob &job);
+const NavigationField &GetTownNpcRoute(const Player &player, int townerIdx);
+Point FollowNavigationFieldTowardsRoot(const NavigationField &field, Point start, int steps);
+std::vector<int> PlanItemTour(const Player &player, Point start);
 void AutoWalkToTrackerTargetKeyPressed();
 void SpeakSelectedSpeedbookSpell();
 void SpellBookKeyPressed();
-std::optional<std::vector<int8_t>> FindKeyboardWalkPathForSpeech(const Player &player, Point startPosition, Point destinationPosition, bool allowDestinationNonWalkable = false);
-std::optional<std::vector<int8_t>> FindKeyboardWalkPathForSpeechRespectingDoors(const Player &player, Point startPosition, Point destinationPosition, bool allowDestinationNonWalkable = false);
-std::optional<std::vector<int8_t>> FindKeyboardWalkPathForSpeechIgnoringMonsters(const Player &player, Point startPosition, Point destinationPosition, bool allowDestinationNonWalkable = false);
-std::optional<std::vector<int8_t>> FindKeyboardWalkPathForSpeechRespectingDoorsIgnoringMonsters(const Player &player, Point startPosition, Point destinationPosition, bool allowDestinationNonWalkable = false);
-std::optional<std::vector<int8_t>> FindKeyboardWalkPathForSpeechLenient(const Player &player, Point startPosition, Point destinationPosition, bool allowDestinationNonWalkable = false);
-std::optional<std::vector<int8_t>> FindKeyboardWalkPathToClosestReachableForSpeech(const Player &player, Point startPosition, Point destinationPosition, Point &closestPosition);
-void AppendKeyboardWalkPathForSpeech(std::string &message, const std::vector<int8_t> &path);
+std::optional<WalkPath> FindKeyboardWalkPathForSpeech(const Player &player, Point startPosition, Point destinationPosition, bool allowDestinationNonWalkable = false);
+std::optional<WalkPath> FindKeyboardWalkPathForSpeechAvoidingDoors(const Player &player, Point startPosition, Point destinationPosition, bool allowDestinationNonWalkable = false);
+std::optional<WalkPath> FindKeyboardWalkPathForSpeechIgnoringMonsters(const Player &player, Point startPosition, Point destinationPosition, bool allowDestinationNonWalkable = false);
+std::optional<WalkPath> FindKeyboardWalkPathForSpeechAvoidingDoorsIgnoringMonsters(const Player &player, Point startPosition, Point destinationPosition, bool allowDestinationNonWalkable = false);
+std::optional<WalkPath> FindKeyboardWalkPathForSpeechLenient(const Player &player, Point startPosition, Point destinationPosition, bool allowDestinationNonWalkable = false);
+std::optional<WalkPath> FindKeyboardWalkPathToClosestReachableForSpeech(const Player &player, Point startPosition, Point destinationPosition, Point &closestPosition);
+void AppendKeyboardWalkPathForSpeech(std::string &message, const WalkPath &path);
 void AppendDirectionalFallback(std::string &message, const Displacement &delta);
+void RepeatKeyboardWalk();
 
 bool gbGameLoopStartup;
 bool forceSpawn;
@@ -241,6 +272,9 @@ void FreeGame()
 	FreeDebugGFX();
 #endif
 	FreeGameMem();
+	ClearDungeonCelCache();
+	ClearMonsterSpriteCache();
+	ReleasePrefetchedLevelFiles();
 	stream_stop();
 	music_stop();
 }
@@ -265,6 +299,7 @@ bool ProcessInput()
 		CheckCursMove();
 		plrctrls_after_check_curs_move();
 		RepeatPlayerAction();
+		RepeatKeyboardWalk();
 	}
 
 	return true;
@@ -738,6 +773,8 @@ void PressKey(SDL_Keycode vkey, uint16_t modState)
 	case SDLK_LEFT:
 		if (CharFlag) {
 			CharacterScreenMoveSelection(-1);
+		} else if (ChatLogFlag) {
+			ChatLogPreviousMessage();
 		} else if (SpellSelectFlag) {
 			HotSpellMove({ AxisDirectionX_LEFT, AxisDirectionY_NONE });
 			SpeakSelectedSpeedbookSpell();
@@ -764,6 +801,8 @@ void PressKey(SDL_Keycode vkey, uint16_t modState)
 	case SDLK_RIGHT:
 		if (CharFlag) {
 			CharacterScreenMoveSelection(+1);
+		} else if (ChatLogFlag) {
+			ChatLogNextMessage();
 		} else if (SpellSelectFlag) {
 			HotSpellMove({ AxisDirectionX_RIGHT, AxisDirectionY_NONE });
 			SpeakSelectedSpeedbookSpell();
@@ -986,6 +1025,7 @@ void GameEventHandler(const SDL_Event &event, uint16_t modState)
 
 void RunGameLoop(interface_mode uMsg)
 {
+	DVL_TRACE_ZONE("RunGameLoop");
 	demo::NotifyGameLoopStart();
 
 	nthread_ignore_mutex(true);
@@ -1048,6 +1088,13 @@ void RunGameLoop(interface_mode uMsg)
 			if (processInput)
 				ProcessInput();
 			DvlNet_ProcessNetworkPackets();
+			const bool waitForTick = !demo::IsRunning() && (IsAudioFirstMode() || !drawGame);
+			if (waitForTick) {
+				// Hardly anything is drawn between game ticks in audio-first mode, and a skipped frame leaves
+				// nothing to do until the tick, so sleep instead of spinning on the event queue,
+				// but wake up for input so key presses are not held back by the sleep.
+				WaitForMessage(static_cast<uint32_t>(std::clamp(last_tick - static_cast<int>(SDL_GetTicks()), 1, 10)));
+			}
 			if (!drawGame)
 				continue;
 			RedrawViewport();
@@ -1139,6 +1186,11 @@ extern "C" void SdlLogToFile(void *userdata, int category, SDL_LogPriority prior
 	PrintHelpOption("-n", _(/* TRANSLATORS: Commandline Option */ "Skip startup videos"));
 	PrintHelpOption("-f", _(/* TRANSLATORS: Commandline Option */ "Display frames per second"));
 	PrintHelpOption("--verbose", _(/* TRANSLATORS: Commandline Option */ "Enable verbose logging"));
+	PrintHelpOption("--asset-stats <path>", _(/* TRANSLATORS: Commandline Option */ "Write per-file asset load times to a CSV or .json file on exit"));
+#ifdef DEVILUTIONX_TRACING
+	PrintHelpOption("--trace <path>", _(/* TRANSLATORS: Commandline Option */ "Write a timeline of the main systems to a Chrome trace file on exit"));
+#endif
+	PrintHelpOption("--startup-benchmark", _(/* TRANSLATORS: Commandline Option */ "Skip the intro, print how long each startup phase took and exit at the main menu"));
 #if SDL_VERSION_ATLEAST(2, 0, 0)
 	PrintHelpOption("--log-to-file <path>", _(/* TRANSLATORS: Commandline Option */ "Log to a file instead of stderr"));
 #endif
@@ -1146,6 +1198,8 @@ extern "C" void SdlLogToFile(void *userdata, int category, SDL_LogPriority prior
 	PrintHelpOption("--record <#>", _(/* TRANSLATORS: Commandline Option */ "Record a demo file"));
 	PrintHelpOption("--demo <#>", _(/* TRANSLATORS: Commandline Option */ "Play a demo file"));
 	PrintHelpOption("--timedemo", _(/* TRANSLATORS: Commandline Option */ "Disable all frame limiting during demo playback"));
+	PrintHelpOption("--demo-seek <#>", _(/* TRANSLATORS: Commandline Option */ "Skip ahead to the given game tick of the demo"));
+	PrintHelpOption("--no-render", _(/* TRANSLATORS: Commandline Option */ "Replay the demo without drawing and report game ticks per second"));
 #endif
 	printNewlineInConsole();
 	printInConsole(_(/* TRANSLATORS: Commandline Option */ "Game selection:"));
@@ -1188,7 +1242,9 @@ void DiabloParseFlags(int argc, char **argv)
 #endif
 #ifndef DISABLE_DEMOMODE
 	bool timedemo = false;
+	bool noRender = false;
 	int demoNumber = -1;
+	int demoSeekTick = 0;
 	int recordNumber = -1;
 	bool createDemoReference = false;
 #endif
@@ -1241,6 +1297,19 @@ void DiabloParseFlags(int argc, char **argv)
 			gbShowIntro = false;
 		} else if (arg == "--timedemo") {
 			timedemo = true;
+		} else if (arg == "--no-render") {
+			noRender = true;
+		} else if (arg == "--demo-seek") {
+			if (i + 1 == argc) {
+				PrintFlagRequiresArgument("--demo-seek");
+				diablo_quit(64);
+			}
+			ParseIntResult<int> parsedParam = ParseInt<int>(argv[++i]);
+			if (!parsedParam.has_value()) {
+				PrintFlagMessage("--demo-seek", " must be a number");
+				diablo_quit(64);
+			}
+			demoSeekTick = parsedParam.value();
 		} else if (arg == "--record") {
 			if (i + 1 == argc) {
 				PrintFlagRequiresArgument("--record");
@@ -1255,7 +1324,7 @@ void DiabloParseFlags(int argc, char **argv)
 		} else if (arg == "--create-reference") {
 			createDemoReference = true;
 #else
-		} else if (arg == "--demo" || arg == "--timedemo" || arg == "--record" || arg == "--create-reference") {
+		} else if (arg == "--demo" || arg == "--timedemo" || arg == "--no-render" || arg == "--demo-seek" || arg == "--record" || arg == "--create-reference") {
 			printInConsole("Binary compiled without demo mode support.");
 			printNewlineInConsole();
 			diablo_quit(1);
@@ -1274,6 +1343,23 @@ void DiabloParseFlags(int argc, char **argv)
 			gbVanilla = true;
 		} else if (arg == "--verbose") {
 			SDL_SetLogPriorities(SDL_LOG_PRIORITY_VERBOSE);
+		} else if (arg == "--asset-stats") {
+			if (i + 1 == argc) {
+				PrintFlagRequiresArgument("--asset-stats");
+				diablo_quit(64);
+			}
+			EnableAssetStats(argv[++i]);
+		} else if (arg == "--startup-benchmark") {
+			EnableStartupBenchmark();
+			gbShowIntro = false;
+#ifdef DEVILUTIONX_TRACING
+		} else if (arg == "--trace") {
+			if (i + 1 == argc) {
+				PrintFlagRequiresArgument("--trace");
+				diablo_quit(64);
+			}
+			EnableTracing(argv[++i]);
+#endif
 #if SDL_VERSION_ATLEAST(2, 0, 0)
 		} else if (arg == "--log-to-file") {
 			if (i + 1 == argc) {
@@ -1315,8 +1401,11 @@ void DiabloParseFlags(int argc, char **argv)
 #endif
 
 #ifndef DISABLE_DEMOMODE
-	if (demoNumber != -1)
-		demo::InitPlayBack(demoNumber, timedemo);
+	if (demoNumber != -1) {
+		demo::InitPlayBack(demoNumber, timedemo, noRender);
+		if (demoSeekTick > 0)
+			demo::SeekPlayBack(demoSeekTick);
+	}
 	if (recordNumber != -1)
 		demo::InitRecording(recordNumber, createDemoReference);
 #endif
@@ -1353,16 +1442,31 @@ void CheckArchivesUpToDate()
 	}
 }
 
+/** @brief Runs a step of the startup as a phase of the startup timing report. */
+void RunStartupPhase(const char *name, void (*step)())
+{
+	const ScopedStartupPhase phase(name);
+	step();
+}
+
 void ApplicationInit()
 {
 	if (*GetOptions().Graphics.showFPS)
 		EnableFrameCount();
 
-	init_create_window();
+	RunStartupPhase("init_create_window", init_create_window);
 	was_window_init = true;
 
-	InitializeScreenReader();
-	LanguageInitialize();
+	RunStartupPhase("InitializeScreenReader", [] {
+#if defined(SCREEN_READER_INTEGRATION) && !defined(NOSOUND)
+		if (*GetOptions().Audio.speechClips) {
+			InitializeScreenReader(CreateSpeechClipBackend(CreatePlatformSpeechBackend(), GetSpeechClipDirectory(GetLanguageCode())));
+			return;
+		}
+#endif
+		InitializeScreenReader();
+	});
+	RunStartupPhase("LanguageInitialize", LanguageInitialize);
 
 	SetApplicationVersions();
 
@@ -1399,7 +1503,7 @@ void DiabloInit()
 	InitializeVirtualGamepad();
 #endif
 
-	UiInitialize();
+	RunStartupPhase("UiInitialize", UiInitialize);
 	was_ui_init = true;
 
 	if (wasHellfireDiscovered) {
@@ -1415,12 +1519,12 @@ void DiabloInit()
 
 	DiabloInitScreen();
 
-	snd_init();
+	RunStartupPhase("snd_init", snd_init);
 
-	ui_sound_init();
+	RunStartupPhase("ui_sound_init", ui_sound_init);
 
 	// Item graphics are loaded early, they already get touched during hero selection.
-	InitItemGFX();
+	RunStartupPhase("InitItemGFX", InitItemGFX);
 
 	// Always available.
 	LoadSmallSelectionSpinner();
@@ -1459,6 +1563,13 @@ void DiabloDeinit()
 
 	LuaShutdown();
 	ShutDownScreenReader();
+	ShutdownPathWorker();
+	ShutdownRenderWorkers();
+	FinishCaptureScreen();
+	FlushOptions();
+	ReleasePrefetchedLevelFiles();
+	WriteAssetStatsReport();
+	WriteTrace();
 
 	if (gbSndInited)
 		effects_cleanup_sfx();
@@ -1474,29 +1585,35 @@ void DiabloDeinit()
 		SDL_Quit();
 }
 
+/**
+ * @brief Loads the graphics of the current level type, except for the dungeon CELs if they were kept from an earlier visit.
+ */
 tl::expected<void, std::string> LoadLvlGFX()
 {
-	assert(pDungeonCels == nullptr);
 	constexpr int SpecialCelWidth = 64;
 
 	const auto loadAll = [](const char *cel, const char *til, const char *special) -> tl::expected<void, std::string> {
-		ASSIGN_OR_RETURN(pDungeonCels, LoadFileInMemWithStatus(cel));
-		ASSIGN_OR_RETURN(pMegaTiles, LoadFileInMemWithStatus<MegaTile>(til));
+		if (pDungeonCels == nullptr) {
+			ASSIGN_OR_RETURN(pDungeonCels, LoadLevelFileWithStatus(cel));
+		}
+		ASSIGN_OR_RETURN(pMegaTiles, LoadLevelFileWithStatus<MegaTile>(til));
 		ASSIGN_OR_RETURN(pSpecialCels, LoadCelWithStatus(special, SpecialCelWidth));
 		return {};
 	};
 
 	switch (leveltype) {
 	case DTYPE_TOWN: {
-		auto cel = LoadFileInMemWithStatus("nlevels\\towndata\\town.cel");
-		if (!cel.has_value()) {
-			ASSIGN_OR_RETURN(pDungeonCels, LoadFileInMemWithStatus("levels\\towndata\\town.cel"));
-		} else {
-			pDungeonCels = std::move(*cel);
+		if (pDungeonCels == nullptr) {
+			auto cel = LoadLevelFileWithStatus("nlevels\\towndata\\town.cel");
+			if (!cel.has_value()) {
+				ASSIGN_OR_RETURN(pDungeonCels, LoadLevelFileWithStatus("levels\\towndata\\town.cel"));
+			} else {
+				pDungeonCels = std::move(*cel);
+			}
 		}
-		auto til = LoadFileInMemWithStatus<MegaTile>("nlevels\\towndata\\town.til");
+		auto til = LoadLevelFileWithStatus<MegaTile>("nlevels\\towndata\\town.til");
 		if (!til.has_value()) {
-			ASSIGN_OR_RETURN(pMegaTiles, LoadFileInMemWithStatus<MegaTile>("levels\\towndata\\town.til"));
+			ASSIGN_OR_RETURN(pMegaTiles, LoadLevelFileWithStatus<MegaTile>("levels\\towndata\\town.til"));
 		} else {
 			pMegaTiles = std::move(*til);
 		}
@@ -1644,44 +1761,11 @@ void UpdatePlayerLowHpWarningSound()
 #else
 namespace {
 
-std::unique_ptr<TSnd> PlayerLowHpWarningSound;
-bool TriedLoadingPlayerLowHpWarningSound = false;
-
-TSnd *GetPlayerLowHpWarningSound()
-{
-	if (TriedLoadingPlayerLowHpWarningSound)
-		return PlayerLowHpWarningSound.get();
-	TriedLoadingPlayerLowHpWarningSound = true;
-
-	if (!gbSndInited)
-		return nullptr;
-
-	PlayerLowHpWarningSound = std::make_unique<TSnd>();
-	PlayerLowHpWarningSound->start_tc = SDL_GetTicks() - 80 - 1;
-
-	// Support both the new "playerhaslowhp" name and the older underscore version.
-	if (PlayerLowHpWarningSound->DSB.SetChunkStream("audio\\playerhaslowhp.ogg", /*isMp3=*/false, /*logErrors=*/false) != 0
-	    && PlayerLowHpWarningSound->DSB.SetChunkStream("..\\audio\\playerhaslowhp.ogg", /*isMp3=*/false, /*logErrors=*/false) != 0
-	    && PlayerLowHpWarningSound->DSB.SetChunkStream("audio\\player_has_low_hp.ogg", /*isMp3=*/false, /*logErrors=*/false) != 0
-	    && PlayerLowHpWarningSound->DSB.SetChunkStream("..\\audio\\player_has_low_hp.ogg", /*isMp3=*/false, /*logErrors=*/false) != 0
-	    && PlayerLowHpWarningSound->DSB.SetChunkStream("audio\\playerhaslowhp.mp3", /*isMp3=*/true, /*logErrors=*/false) != 0
-	    && PlayerLowHpWarningSound->DSB.SetChunkStream("..\\audio\\playerhaslowhp.mp3", /*isMp3=*/true, /*logErrors=*/false) != 0
-	    && PlayerLowHpWarningSound->DSB.SetChunkStream("audio\\player_has_low_hp.mp3", /*isMp3=*/true, /*logErrors=*/false) != 0
-	    && PlayerLowHpWarningSound->DSB.SetChunkStream("..\\audio\\player_has_low_hp.mp3", /*isMp3=*/true, /*logErrors=*/false) != 0
-	    && PlayerLowHpWarningSound->DSB.SetChunkStream("audio\\playerhaslowhp.wav", /*isMp3=*/false, /*logErrors=*/false) != 0
-	    && PlayerLowHpWarningSound->DSB.SetChunkStream("..\\audio\\playerhaslowhp.wav", /*isMp3=*/false, /*logErrors=*/false) != 0
-	    && PlayerLowHpWarningSound->DSB.SetChunkStream("audio\\player_has_low_hp.wav", /*isMp3=*/false, /*logErrors=*/false) != 0
-	    && PlayerLowHpWarningSound->DSB.SetChunkStream("..\\audio\\player_has_low_hp.wav", /*isMp3=*/false, /*logErrors=*/false) != 0) {
-		PlayerLowHpWarningSound = nullptr;
-	}
-
-	return PlayerLowHpWarningSound.get();
-}
-
 void StopPlayerLowHpWarningSound()
 {
-	if (PlayerLowHpWarningSound != nullptr)
-		PlayerLowHpWarningSound->DSB.Stop();
+	TSnd *snd = GetPrefetchedCueSound(PrefetchedCue::PlayerLowHpWarning);
+	if (snd != nullptr)
+		snd->DSB.Stop();
 }
 
 [[nodiscard]] uint32_t LowHpIntervalMs(int hpPercent)
@@ -1734,7 +1818,8 @@ void UpdatePlayerLowHpWarningSound()
 		return;
 	}
 
-	TSnd *snd = GetPlayerLowHpWarningSound();
+	// Never blocks, the sound is decoded in the background while the level loads.
+	TSnd *snd = GetPrefetchedCueSound(PrefetchedCue::PlayerLowHpWarning);
 	if (snd == nullptr || !snd->DSB.IsLoaded())
 		return;
 
@@ -1759,20 +1844,83 @@ namespace {
 	return monster.isUnique() || monster.ai == MonsterAIID::Diablo;
 }
 
+/**
+ * @brief What the accessibility announcers need from the active monsters, gathered in a single pass.
+ */
+struct AccessibilityTickState {
+	/** The monster next to the player that the player is facing the most. */
+	std::optional<int> attackableMonsterId;
+};
+
+[[nodiscard]] int RotationsToFace(Direction facing, Point from, Point to)
+{
+	const int d1 = static_cast<int>(facing);
+	const int d2 = static_cast<int>(GetDirection(from, to));
+
+	int rotations = std::abs(d1 - d2);
+	if (rotations > 4)
+		rotations = 4 - (rotations % 4);
+	return rotations;
+}
+
+const SpatialIndex &GetMonsterTrackerIndex();
+bool IsTrackedMonster(const Monster &monster);
+
+/**
+ * The monsters around the player. The index holds the tiles monsters are moving to, which are at most
+ * a step from where they stand, so a radius of 2 covers every monster next to the player.
+ */
+RadiusWatch MeleeRangeWatch(2);
+
+void GatherAccessibilityTickState(AccessibilityTickState &state)
+{
+	if (MyPlayer == nullptr || leveltype == DTYPE_TOWN) {
+		MeleeRangeWatch.Reset();
+		return;
+	}
+
+	const Player &player = *MyPlayer;
+	const Point playerPosition = player.position.tile;
+	int bestRotations = 5;
+
+	MeleeRangeWatch.Update(GetMonsterTrackerIndex(), playerPosition);
+	for (const int monsterId : MeleeRangeWatch.inRange()) {
+		const Monster &monster = Monsters[monsterId];
+		if (!IsTrackedMonster(monster))
+			continue;
+		const Point monsterPosition = monster.position.tile;
+		if (playerPosition.WalkingDistance(monsterPosition) > 1)
+			continue;
+		if (monster.isPlayerMinion() || !monster.isPossibleToHit())
+			continue;
+
+		const int rotations = RotationsToFace(player._pdir, playerPosition, monsterPosition);
+		if (!state.attackableMonsterId || rotations < bestRotations || (rotations == bestRotations && monsterId < *state.attackableMonsterId)) {
+			bestRotations = rotations;
+			state.attackableMonsterId = monsterId;
+		}
+	}
+}
+
 } // namespace
 
 void UpdateLowDurabilityWarnings()
 {
 	static std::array<uint32_t, NUM_INVLOC> WarnedSeeds {};
 	static std::array<bool, NUM_INVLOC> HasWarned {};
+	static std::optional<uint32_t> CheckedGeneration;
 
 	if (MyPlayer == nullptr)
 		return;
 	if (MyPlayerIsDead || MyPlayer->_pmode == PM_DEATH || MyPlayer->hasNoLife())
 		return;
 
+	// The equipment is only looked at again after something wore, repaired or swapped it.
+	if (CheckedGeneration == MyPlayerEquipmentDurabilityGeneration)
+		return;
+	CheckedGeneration = MyPlayerEquipmentDurabilityGeneration;
+
 	std::vector<std::string> newlyLow;
-	newlyLow.reserve(NUM_INVLOC);
 
 	for (int slot = 0; slot < NUM_INVLOC; ++slot) {
 		const Item &item = MyPlayer->InvBody[slot];
@@ -1836,16 +1984,20 @@ void UpdateLowDurabilityWarnings()
 		joined += newlyLow[i];
 	}
 
-	SpeakText(fmt::format(fmt::runtime(_("Low durability: {:s}")), joined), /*force=*/true);
+	SpeakText(FormatAnnouncement(Announcement::LowDurability, joined), /*force=*/true);
 }
 
-void UpdateBossHealthAnnouncements()
+void UpdateBossHealthAnnouncements(const AccessibilityTickState & /*state*/)
 {
 	static dungeon_type LastLevelType = DTYPE_NONE;
 	static int LastCurrLevel = -1;
 	static bool LastSetLevel = false;
 	static _setlevels LastSetLevelNum = SL_NONE;
 	static std::array<int8_t, MaxMonsters> LastAnnouncedBucket {};
+	static std::vector<size_t> ChangedMonsters;
+
+	// Only monsters that took damage or died since the last update can need an announcement.
+	TakeMonstersWithChangedHealth(ChangedMonsters);
 
 	if (MyPlayer == nullptr)
 		return;
@@ -1861,26 +2013,15 @@ void UpdateBossHealthAnnouncements()
 		LastSetLevelNum = setlvlnum;
 	}
 
-	for (size_t monsterId = 0; monsterId < MaxMonsters; ++monsterId) {
-		if (LastAnnouncedBucket[monsterId] < 0)
-			continue;
-
+	for (const size_t monsterId : ChangedMonsters) {
 		const Monster &monster = Monsters[monsterId];
-		if (monster.isInvalid || monster.hitPoints <= 0 || !IsBossMonsterForHpAnnouncement(monster))
+		if (monster.isInvalid || monster.hitPoints <= 0 || !IsBossMonsterForHpAnnouncement(monster)) {
 			LastAnnouncedBucket[monsterId] = -1;
-	}
-
-	for (size_t i = 0; i < ActiveMonsterCount; i++) {
-		const int monsterId = static_cast<int>(ActiveMonsters[i]);
-		const Monster &monster = Monsters[monsterId];
-
-		if (monster.isInvalid)
 			continue;
+		}
 		if ((monster.flags & MFLAG_HIDDEN) != 0)
 			continue;
-		if (!IsBossMonsterForHpAnnouncement(monster))
-			continue;
-		if (monster.hitPoints <= 0 || monster.maxHitPoints <= 0)
+		if (monster.maxHitPoints <= 0)
 			continue;
 
 		const int64_t hp = std::clamp<int64_t>(monster.hitPoints, 0, monster.maxHitPoints);
@@ -1888,21 +2029,20 @@ void UpdateBossHealthAnnouncements()
 		const int hpPercent = static_cast<int>(std::clamp<int64_t>(hp * 100 / maxHp, 0, 100));
 		const int bucket = ((hpPercent + 9) / 10) * 10;
 
+		// A boss that wasn't hurt before is assumed to have been at full health.
 		int8_t &lastBucket = LastAnnouncedBucket[monsterId];
-		if (lastBucket < 0) {
-			lastBucket = static_cast<int8_t>(((hpPercent + 9) / 10) * 10);
-			continue;
-		}
+		if (lastBucket < 0)
+			lastBucket = 100;
 
 		if (bucket >= lastBucket)
 			continue;
 
 		lastBucket = static_cast<int8_t>(bucket);
-		SpeakText(fmt::format(fmt::runtime(_("{:s} health: {:d}%")), monster.name(), bucket), /*force=*/false);
+		SpeakText(FormatAnnouncement(Announcement::BossHealth, monster.name(), bucket), /*force=*/false, SpeechPriority::Queued, SpeechChannel::Combat);
 	}
 }
 
-void UpdateAttackableMonsterAnnouncements()
+void UpdateAttackableMonsterAnnouncements(const AccessibilityTickState &state)
 {
 	static std::optional<int> LastAttackableMonsterId;
 
@@ -1923,44 +2063,7 @@ void UpdateAttackableMonsterAnnouncements()
 		return;
 	}
 
-	const Player &player = *MyPlayer;
-	const Point playerPosition = player.position.tile;
-
-	int bestRotations = 5;
-	std::optional<int> bestId;
-
-	for (size_t i = 0; i < ActiveMonsterCount; i++) {
-		const int monsterId = static_cast<int>(ActiveMonsters[i]);
-		const Monster &monster = Monsters[monsterId];
-
-		if (monster.isInvalid)
-			continue;
-		if ((monster.flags & MFLAG_HIDDEN) != 0)
-			continue;
-		if (monster.hitPoints <= 0)
-			continue;
-		if (monster.isPlayerMinion())
-			continue;
-		if (!monster.isPossibleToHit())
-			continue;
-
-		const Point monsterPosition = monster.position.tile;
-		if (playerPosition.WalkingDistance(monsterPosition) > 1)
-			continue;
-
-		const int d1 = static_cast<int>(player._pdir);
-		const int d2 = static_cast<int>(GetDirection(playerPosition, monsterPosition));
-
-		int rotations = std::abs(d1 - d2);
-		if (rotations > 4)
-			rotations = 4 - (rotations % 4);
-
-		if (!bestId || rotations < bestRotations || (rotations == bestRotations && monsterId < *bestId)) {
-			bestRotations = rotations;
-			bestId = monsterId;
-		}
-	}
-
+	const std::optional<int> bestId = state.attackableMonsterId;
 	if (!bestId) {
 		LastAttackableMonsterId = std::nullopt;
 		return;
@@ -1973,7 +2076,7 @@ void UpdateAttackableMonsterAnnouncements()
 
 	const std::string_view name = Monsters[*bestId].name();
 	if (!name.empty())
-		SpeakText(name, /*force=*/true);
+		SpeakText(name, /*force=*/true, SpeechPriority::Interrupt, SpeechChannel::Combat);
 }
 
 [[nodiscard]] StringOrView DoorLabelForSpeech(const Object &door)
@@ -1995,35 +2098,60 @@ void UpdateAttackableMonsterAnnouncements()
 	return door.name();
 }
 
+struct DoorScanInputs {
+	Point playerPosition;
+	Direction playerDirection;
+	uint32_t doorStateGeneration;
+	uint32_t objectGeneration;
+
+	bool operator==(const DoorScanInputs &) const = default;
+};
+
 void UpdateInteractableDoorAnnouncements()
 {
 	static std::optional<int> LastInteractableDoorId;
 	static std::optional<int> LastInteractableDoorState;
+	static std::optional<DoorScanInputs> LastDoorScanInputs;
 
 	if (MyPlayer == nullptr) {
 		LastInteractableDoorId = std::nullopt;
 		LastInteractableDoorState = std::nullopt;
+		LastDoorScanInputs = std::nullopt;
 		return;
 	}
 	if (leveltype == DTYPE_TOWN) {
 		LastInteractableDoorId = std::nullopt;
 		LastInteractableDoorState = std::nullopt;
+		LastDoorScanInputs = std::nullopt;
 		return;
 	}
 	if (MyPlayerIsDead || MyPlayer->_pmode == PM_DEATH || MyPlayer->hasNoLife()) {
 		LastInteractableDoorId = std::nullopt;
 		LastInteractableDoorState = std::nullopt;
+		LastDoorScanInputs = std::nullopt;
 		return;
 	}
 	if (InGameMenu() || invflag) {
 		LastInteractableDoorId = std::nullopt;
 		LastInteractableDoorState = std::nullopt;
+		LastDoorScanInputs = std::nullopt;
 		return;
 	}
 
 	const Player &player = *MyPlayer;
 	const Point playerPosition = player.position.tile;
 
+	// The doors around the player only need a rescan when the player moved or turned, or a door changed state.
+	const DoorScanInputs inputs {
+		.playerPosition = playerPosition,
+		.playerDirection = player._pdir,
+		.doorStateGeneration = DoorStateGeneration,
+		.objectGeneration = ObjectWalkabilityGeneration,
+	};
+	if (LastDoorScanInputs == inputs)
+		return;
+	LastDoorScanInputs = inputs;
+
 	std::optional<int> bestId;
 	int bestRotations = 5;
 	int bestDistance = 0;
@@ -2049,13 +2177,7 @@ void UpdateInteractableDoorAnnouncements()
 			if (distance > 1)
 				continue;
 
-			const int d1 = static_cast<int>(player._pdir);
-			const int d2 = static_cast<int>(GetDirection(playerPosition, door.position));
-
-			int rotations = std::abs(d1 - d2);
-			if (rotations > 4)
-				rotations = 4 - (rotations % 4);
-
+			const int rotations = RotationsToFace(player._pdir, playerPosition, door.position);
 			if (!bestId || rotations < bestRotations || (rotations == bestRotations && distance < bestDistance)
 			    || (rotations == bestRotations && distance == bestDistance && objectId < *bestId)) {
 				bestRotations = rotations;
@@ -2081,52 +2203,154 @@ void UpdateInteractableDoorAnnouncements()
 
 	const StringOrView label = DoorLabelForSpeech(door);
 	if (!label.empty())
-		SpeakText(label.str(), /*force=*/true);
+		SpeakText(label.str(), /*force=*/true, SpeechPriority::Interrupt, SpeechChannel::Navigation);
+}
+
+namespace {
+
+/** An accessibility announcer and how often it runs. */
+struct AccessibilityAnnouncer {
+	void (*update)(const AccessibilityTickState &state);
+	/** Run every this many game ticks. */
+	uint8_t intervalTicks;
+	/** Only run inside the dungeon. */
+	bool dungeonOnly;
+	/** Only run on ticks where players were processed. */
+	bool needsProcessedPlayers;
+	TickTimer timer;
+};
+
+const AccessibilityAnnouncer AccessibilityAnnouncers[] = {
+	{ [](const AccessibilityTickState &) { UpdateLowDurabilityWarnings(); }, 4, false, true, TickTimer::LowDurabilityWarnings },
+	{ UpdateBossHealthAnnouncements, 4, true, false, TickTimer::BossHealthAnnouncements },
+	{ [](const AccessibilityTickState &) { UpdateProximityAudioCues(); }, 1, false, false, TickTimer::ProximityAudioCues },
+	{ UpdateAttackableMonsterAnnouncements, 1, true, false, TickTimer::AttackableMonsterAnnouncements },
+	{ [](const AccessibilityTickState &) { UpdateInteractableDoorAnnouncements(); }, 1, true, false, TickTimer::InteractableDoorAnnouncements },
+	{ [](const AccessibilityTickState &) { UpdatePlayerLowHpWarningSound(); }, 1, false, false, TickTimer::LowHpWarningSound },
+	{ [](const AccessibilityTickState &) { UpdateCharacterStatChangeAnnouncements(); }, 1, false, true, TickTimer::StatChangeAnnouncements },
+};
+
+uint32_t AccessibilityTick = 0;
+AccessibilityStageTiming AccessibilityTiming;
+
+/**
+ * @brief Runs the accessibility announcers that are due this tick.
+ *
+ * The monsters near the player are looked at once and the results handed to every announcer,
+ * instead of each one rescanning them.
+ */
+void UpdateAccessibilityAnnouncements(bool playersProcessed)
+{
+	const auto start = std::chrono::steady_clock::now();
+
+	AccessibilityTickState state;
+	{
+		DVL_TICK_TIMER(TickTimer::AccessibilityGather);
+		GatherAccessibilityTickState(state);
+	}
+
+	const bool inDungeon = leveltype != DTYPE_TOWN;
+	for (size_t i = 0; i < std::size(AccessibilityAnnouncers); i++) {
+		const AccessibilityAnnouncer &announcer = AccessibilityAnnouncers[i];
+		if (announcer.dungeonOnly && !inDungeon)
+			continue;
+		if (announcer.needsProcessedPlayers && !playersProcessed)
+			continue;
+		// Offset by the index so that announcers sharing an interval don't all land on the same tick.
+		if ((AccessibilityTick + i) % announcer.intervalTicks != 0)
+			continue;
+		DVL_TICK_TIMER(announcer.timer);
+		announcer.update(state);
+	}
+	AccessibilityTick++;
+
+	const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+	AccessibilityTiming.lastTickMicroseconds = static_cast<uint32_t>(elapsed.count());
+	AccessibilityTiming.maxTickMicroseconds = std::max(AccessibilityTiming.maxTickMicroseconds, AccessibilityTiming.lastTickMicroseconds);
+}
+
+/** @brief Moves on to the next step of GameLogic(), which is also what the frame stats blame for slow ticks. */
+void SetGameLogicStep(GameLogicStep step)
+{
+	CountGameLogicStep(step);
+	gGameLogicStep = step;
 }
 
+} // namespace
+
 void GameLogic()
 {
+	DVL_TRACE_ZONE("GameLogic");
 	if (!ProcessInput()) {
 		return;
 	}
+	if (HeadlessMode)
+		CountHeadlessSpeechGameTick();
+	BeginTickTiming();
+	BeginTickStats();
 	if (gbProcessPlayers) {
-		gGameLogicStep = GameLogicStep::ProcessPlayers;
-		ProcessPlayers();
+		SetGameLogicStep(GameLogicStep::ProcessPlayers);
+		{
+			DVL_TICK_TIMER(TickTimer::ProcessPlayers);
+			ProcessPlayers();
+		}
+		DVL_TICK_TIMER(TickTimer::AutoWalk);
 		UpdateAutoWalkTownNpc();
 		UpdateAutoWalkTracker();
-		UpdateLowDurabilityWarnings();
 	}
 	if (leveltype != DTYPE_TOWN) {
-		gGameLogicStep = GameLogicStep::ProcessMonsters;
+		{
+			SetGameLogicStep(GameLogicStep::ProcessMonsters);
+			DVL_TICK_TIMER(TickTimer::ProcessMonsters);
 #ifdef _DEBUG
-		if (!DebugInvisible)
+			if (!DebugInvisible)
 #endif
-			ProcessMonsters();
-		gGameLogicStep = GameLogicStep::ProcessObjects;
-		ProcessObjects();
-		gGameLogicStep = GameLogicStep::ProcessMissiles;
-		ProcessMissiles();
-		gGameLogicStep = GameLogicStep::ProcessItems;
-		ProcessItems();
+				ProcessMonsters();
+		}
+		{
+			SetGameLogicStep(GameLogicStep::ProcessObjects);
+			DVL_TICK_TIMER(TickTimer::ProcessObjects);
+			ProcessObjects();
+		}
+		{
+			SetGameLogicStep(GameLogicStep::ProcessMissiles);
+			DVL_TICK_TIMER(TickTimer::ProcessMissiles);
+			ProcessMissiles();
+		}
+		{
+			SetGameLogicStep(GameLogicStep::ProcessItems);
+			DVL_TICK_TIMER(TickTimer::ProcessItems);
+			ProcessItems();
+		}
+		// Count the rest of the tick as Other, gGameLogicStep keeps its value for the animation distribution.
+		CountGameLogicStep(GameLogicStep::None);
+		DVL_TICK_TIMER(TickTimer::LightAndVision);
 		ProcessLightList();
 		ProcessVisionList();
-		UpdateBossHealthAnnouncements();
-		UpdateProximityAudioCues();
-		UpdateAttackableMonsterAnnouncements();
-		UpdateInteractableDoorAnnouncements();
 	} else {
-		gGameLogicStep = GameLogicStep::ProcessTowners;
-		ProcessTowners();
-		gGameLogicStep = GameLogicStep::ProcessItemsTown;
-		ProcessItems();
-		gGameLogicStep = GameLogicStep::ProcessMissilesTown;
+		{
+			SetGameLogicStep(GameLogicStep::ProcessTowners);
+			DVL_TICK_TIMER(TickTimer::ProcessTowners);
+			ProcessTowners();
+		}
+		{
+			SetGameLogicStep(GameLogicStep::ProcessItemsTown);
+			DVL_TICK_TIMER(TickTimer::ProcessItems);
+			ProcessItems();
+		}
+		SetGameLogicStep(GameLogicStep::ProcessMissilesTown);
+		DVL_TICK_TIMER(TickTimer::ProcessMissiles);
 		ProcessMissiles();
-		UpdateProximityAudioCues();
+		CountGameLogicStep(GameLogicStep::None);
 	}
 
-	UpdatePlayerLowHpWarningSound();
+	{
+		DVL_TICK_TIMER(TickTimer::MonsterHotState);
+		UpdateActiveMonsterHotState();
+	}
+	UpdateAccessibilityAnnouncements(gbProcessPlayers);
 
-	gGameLogicStep = GameLogicStep::None;
+	SetGameLogicStep(GameLogicStep::None);
 
 #ifdef _DEBUG
 	if (DebugScrollViewEnabled && (SDL_GetModState() & SDL_KMOD_SHIFT) != 0) {
@@ -2134,13 +2358,18 @@ void GameLogic()
 	}
 #endif
 
-	sound_update();
+	{
+		DVL_TICK_TIMER(TickTimer::SoundUpdate);
+		sound_update();
+	}
 	CheckTriggers();
 	CheckQuests();
 	RedrawViewport();
 	pfile_update(false);
 
 	plrctrls_after_game_logic();
+	LuaFlushEventBatches();
+	EndTickStats();
 }
 
 void TimeoutCursor(bool bTimeout)
@@ -2236,6 +2465,28 @@ enum class TrackerTargetCategory : uint8_t {
 TrackerTargetCategory SelectedTrackerTargetCategory = TrackerTargetCategory::Items;
 TrackerTargetCategory AutoWalkTrackerTargetCategory = TrackerTargetCategory::Items; ///< Category of the active auto-walk target.
 int AutoWalkTrackerTargetId = -1;                                                   ///< ID of the target being auto-walked to, or -1 if inactive.
+uint32_t AutoWalkTrackerTargetGeneration = 0;                                       ///< TrackerTargetGeneration of the auto-walk target.
+
+struct ItemTourStop {
+	int itemId;
+	/** TrackerTargetGeneration of the item when the tour was planned. */
+	uint32_t generation;
+};
+
+/** Whether an item tour (Shift+M) is going on, it walks to one item after the other. */
+bool ItemTourActive = false;
+/** Items the tour still has to walk to, the next one at the back. */
+std::vector<ItemTourStop> ItemTourStops;
+/** The item the tour brought the player to, the tour goes on once it is picked up. */
+std::optional<ItemTourStop> ItemTourReachedStop;
+
+void ClearItemTour()
+{
+	ItemTourActive = false;
+	ItemTourStops.clear();
+	ItemTourReachedStop = std::nullopt;
+}
+
 
 Point NextPositionForWalkDirection(Point position, int8_t walkDir)
 {
@@ -2261,15 +2512,6 @@ Point NextPositionForWalkDirection(Point position, int8_t walkDir)
 	}
 }
 
-Point PositionAfterWalkPathSteps(Point start, const int8_t *path, int steps)
-{
-	Point position = start;
-	for (int i = 0; i < steps; ++i) {
-		position = NextPositionForWalkDirection(position, path[i]);
-	}
-	return position;
-}
-
 int8_t OppositeWalkDirection(int8_t walkDir)
 {
 	switch (walkDir) {
@@ -2483,12 +2725,9 @@ void UpdateAutoWalkTownNpc()
 		return;
 	}
 
-	constexpr size_t MaxAutoWalkPathLength = 512;
-	std::array<int8_t, MaxAutoWalkPathLength> path;
-	path.fill(WALK_NONE);
-
-	const int steps = FindPath(CanStep, [&myPlayer](Point position) { return PosOkPlayer(myPlayer, position); }, playerPosition, towner.position, path.data(), path.size());
-	if (steps == 0) {
+	const NavigationField &route = GetTownNpcRoute(myPlayer, AutoWalkTownNpcTarget);
+	const NavigationField::DistanceType distance = route.Distance(playerPosition);
+	if (distance == NavigationField::Unreachable) {
 		AutoWalkTownNpcTarget = -1;
 		std::string error;
 		StrAppend(error, _("Can't find a path to: "), towner.name);
@@ -2496,8 +2735,8 @@ void UpdateAutoWalkTownNpc()
 		return;
 	}
 
-	// FindPath returns 0 if the path length is equal to the maximum.
 	// The player walkpath buffer is MaxPathLengthPlayer, so keep segments strictly shorter.
+	const int steps = distance;
 	if (steps < static_cast<int>(MaxPathLengthPlayer)) {
 		const int townerIdx = AutoWalkTownNpcTarget;
 		AutoWalkTownNpcTarget = -1;
@@ -2506,7 +2745,7 @@ void UpdateAutoWalkTownNpc()
 	}
 
 	const int segmentSteps = std::min(steps - 1, static_cast<int>(MaxPathLengthPlayer - 1));
-	const Point waypoint = PositionAfterWalkPathSteps(playerPosition, path.data(), segmentSteps);
+	const Point waypoint = FollowNavigationFieldTowardsRoot(route, playerPosition, segmentSteps);
 	NetSendCmdLoc(MyPlayerId, true, CMD_WALKXY, waypoint);
 }
 
@@ -2525,6 +2764,8 @@ int LockedTrackerObjectId = -1;
 int LockedTrackerBreakableId = -1;
 int LockedTrackerMonsterId = -1;
 int LockedTrackerDeadBodyId = -1;
+/** TrackerTargetGeneration of the locked target of each category. */
+std::array<uint32_t, static_cast<size_t>(TrackerTargetCategory::DeadBodies) + 1> LockedTrackerGenerations {};
 
 struct TrackerLevelKey {
 	dungeon_type levelType;
@@ -2586,6 +2827,37 @@ int &LockedTrackerTargetId(TrackerTargetCategory category)
 	app_fatal("Invalid TrackerTargetCategory");
 }
 
+/**
+ * @brief Tells a target apart from whatever takes over its slot later, so a stale ID is noticed without a search.
+ *
+ * Items and monsters reuse their slots within a level, objects don't and dead body IDs are never reused.
+ */
+[[nodiscard]] uint32_t TrackerTargetGeneration(TrackerTargetCategory category, int id)
+{
+	switch (category) {
+	case TrackerTargetCategory::Items:
+		return id >= 0 && id < MAXITEMS ? Items[id]._iSeed : 0;
+	case TrackerTargetCategory::Monsters:
+		return id >= 0 && id < static_cast<int>(MaxMonsters) ? Monsters[id].aiSeed : 0;
+	default:
+		return 0;
+	}
+}
+
+void LockTrackerTarget(TrackerTargetCategory category, int id)
+{
+	LockedTrackerTargetId(category) = id;
+	LockedTrackerGenerations[static_cast<size_t>(category)] = TrackerTargetGeneration(category, id);
+}
+
+/** @brief Drops the locked target of a category if its slot now holds something else. */
+void ForgetStaleTrackerLock(TrackerTargetCategory category)
+{
+	int &lockedTargetId = LockedTrackerTargetId(category);
+	if (lockedTargetId >= 0 && TrackerTargetGeneration(category, lockedTargetId) != LockedTrackerGenerations[static_cast<size_t>(category)])
+		lockedTargetId = -1;
+}
+
 std::string_view TrackerTargetCategoryLabel(TrackerTargetCategory category)
 {
 	switch (category) {
@@ -2688,146 +2960,250 @@ void CycleTrackerTargetKeyPressed()
 	SpeakTrackerTargetCategory();
 }
 
-std::optional<int> FindNearestGroundItemId(Point playerPosition)
+uint32_t HashAccessCacheValue(uint32_t hash, uint32_t value)
 {
-	std::optional<int> bestId;
-	int bestDistance = 0;
-
-	for (int y = 0; y < MAXDUNY; ++y) {
-		for (int x = 0; x < MAXDUNX; ++x) {
-			const int itemId = std::abs(dItem[x][y]) - 1;
-			if (itemId < 0 || itemId > MAXITEMS)
-				continue;
-
-			const Item &item = Items[itemId];
-			if (item.isEmpty() || item._iClass == ICLASS_NONE)
-				continue;
-
-			const int distance = playerPosition.WalkingDistance(Point { x, y });
-			if (!bestId || distance < bestDistance) {
-				bestId = itemId;
-				bestDistance = distance;
-			}
-		}
+	for (int i = 0; i < 4; ++i) {
+		hash ^= (value >> (i * 8)) & 0xFF;
+		hash *= 16777619U;
 	}
-
-	return bestId;
+	return hash;
 }
 
-[[nodiscard]] constexpr int CorpseTrackerIdForPosition(Point position)
+uint32_t HashAccessCachePosition(uint32_t hash, Point position)
 {
-	return position.x + position.y * MAXDUNX;
+	return HashAccessCacheValue(hash, static_cast<uint32_t>(position.x) | (static_cast<uint32_t>(position.y) << 16));
 }
 
-[[nodiscard]] constexpr Point CorpsePositionForTrackerId(int corpseId)
+/** @brief Starts a cache signature with the identity of the current level. */
+uint32_t HashCurrentLevelForAccessCache()
 {
-	return { corpseId % MAXDUNX, corpseId / MAXDUNX };
+	uint32_t hash = 2166136261U;
+	hash = HashAccessCacheValue(hash, static_cast<uint32_t>(leveltype));
+	hash = HashAccessCacheValue(hash, currlevel);
+	hash = HashAccessCacheValue(hash, setlevel ? 1 : 0);
+	hash = HashAccessCacheValue(hash, static_cast<uint32_t>(setlvlnum));
+	return hash;
 }
 
-std::optional<int> FindNearestCorpseId(Point playerPosition)
+/** @brief Tracker IDs of dead bodies are CorpseEntry::id, callers check IsCorpsePresent first. */
+[[nodiscard]] Point CorpsePositionForTrackerId(int corpseId)
 {
-	std::optional<int> bestId;
-	int bestDistance = 0;
-
-	for (int y = 0; y < MAXDUNY; ++y) {
-		for (int x = 0; x < MAXDUNX; ++x) {
-			if (dCorpse[x][y] == 0)
-				continue;
-
-			const Point position { x, y };
-			const int distance = playerPosition.WalkingDistance(position);
-			if (!bestId || distance < bestDistance) {
-				bestId = CorpseTrackerIdForPosition(position);
-				bestDistance = distance;
-			}
-		}
-	}
-
-	return bestId;
+	const CorpseEntry *entry = FindCorpseEntry(corpseId);
+	return entry != nullptr ? entry->position : Point { -1, -1 };
 }
 
-struct TrackerCandidate {
-	int id;
-	int distance;
-	StringOrView name;
+/**
+ * @brief Spatial index of one kind of tracker target, rebuilt lazily when its signature changes.
+ *
+ * Only positions are indexed; whether an entity is still a valid target is checked at query time.
+ */
+struct TrackerSpatialIndex {
+	SpatialIndex index;
+	uint32_t signature = 0;
+	bool valid = false;
 };
 
-[[nodiscard]] bool IsBetterTrackerCandidate(const TrackerCandidate &a, const TrackerCandidate &b)
-{
-	if (a.distance != b.distance)
-		return a.distance < b.distance;
-	return a.id < b.id;
-}
-
-[[nodiscard]] std::vector<TrackerCandidate> CollectNearbyItemTrackerCandidates(Point playerPosition, int maxDistance)
-{
-	std::vector<TrackerCandidate> result;
-	result.reserve(ActiveItemCount);
+TrackerSpatialIndex ItemTrackerIndex;
+TrackerSpatialIndex ObjectTrackerIndex;
+TrackerSpatialIndex MonsterTrackerIndex;
+TrackerSpatialIndex CorpseTrackerIndex;
 
-	const int minX = std::max(0, playerPosition.x - maxDistance);
-	const int minY = std::max(0, playerPosition.y - maxDistance);
-	const int maxX = std::min(MAXDUNX - 1, playerPosition.x + maxDistance);
-	const int maxY = std::min(MAXDUNY - 1, playerPosition.y + maxDistance);
+std::vector<SpatialIndex::Entry> TrackerIndexEntries;
 
-	std::array<bool, MAXITEMS + 1> seen {};
+template <typename CollectEntries>
+const SpatialIndex &GetTrackerSpatialIndex(TrackerSpatialIndex &trackerIndex, uint32_t signature, CollectEntries &&collectEntries)
+{
+	if (trackerIndex.valid && trackerIndex.signature == signature)
+		return trackerIndex.index;
 
-	for (int y = minY; y <= maxY; ++y) {
-		for (int x = minX; x <= maxX; ++x) {
-			const int itemId = std::abs(dItem[x][y]) - 1;
-			if (itemId < 0 || itemId > MAXITEMS)
-				continue;
-			if (seen[itemId])
-				continue;
-			seen[itemId] = true;
+	TrackerIndexEntries.clear();
+	collectEntries(TrackerIndexEntries);
+	trackerIndex.index.Build(TrackerIndexEntries);
+	trackerIndex.signature = signature;
+	trackerIndex.valid = true;
+	return trackerIndex.index;
+}
 
-			const Item &item = Items[itemId];
-			if (item.isEmpty() || item._iClass == ICLASS_NONE)
-				continue;
+const SpatialIndex &GetItemTrackerIndex()
+{
+	uint32_t signature = HashAccessCacheValue(HashCurrentLevelForAccessCache(), ActiveItemCount);
+	for (uint8_t i = 0; i < ActiveItemCount; ++i) {
+		signature = HashAccessCacheValue(signature, ActiveItems[i]);
+		signature = HashAccessCachePosition(signature, Items[ActiveItems[i]].position);
+	}
 
-			const int distance = playerPosition.WalkingDistance(Point { x, y });
-			if (distance > maxDistance)
-				continue;
+	return GetTrackerSpatialIndex(ItemTrackerIndex, signature, [](std::vector<SpatialIndex::Entry> &entries) {
+		for (uint8_t i = 0; i < ActiveItemCount; ++i) {
+			const int itemId = ActiveItems[i];
+			const Point position = Items[itemId].position;
+			if (InDungeonBounds(position) && std::abs(dItem[position.x][position.y]) - 1 == itemId)
+				entries.push_back({ itemId, position });
+		}
+	});
+}
 
-			result.push_back(TrackerCandidate {
-			    .id = itemId,
-			    .distance = distance,
-			    .name = item.getName(),
-			});
+const SpatialIndex &GetObjectTrackerIndex()
+{
+	const uint32_t signature = HashAccessCacheValue(HashCurrentLevelForAccessCache(), ObjectWalkabilityGeneration);
+	return GetTrackerSpatialIndex(ObjectTrackerIndex, signature, [](std::vector<SpatialIndex::Entry> &entries) {
+		// Large objects occupy several tiles, index every one of them so distances are measured to the closest.
+		for (int y = 0; y < MAXDUNY; ++y) {
+			for (int x = 0; x < MAXDUNX; ++x) {
+				const int objectId = std::abs(dObject[x][y]) - 1;
+				if (objectId < 0 || objectId >= MAXOBJECTS)
+					continue;
+				if (Objects[objectId]._otype == OBJ_NULL)
+					continue;
+				entries.push_back({ objectId, { x, y } });
+			}
 		}
+	});
+}
+
+const SpatialIndex &GetMonsterTrackerIndex()
+{
+	uint32_t signature = HashAccessCacheValue(HashCurrentLevelForAccessCache(), static_cast<uint32_t>(ActiveMonsterCount));
+	for (size_t i = 0; i < ActiveMonsterCount; ++i) {
+		signature = HashAccessCacheValue(signature, ActiveMonsters[i]);
+		signature = HashAccessCachePosition(signature, Monsters[ActiveMonsters[i]].position.future);
 	}
 
-	std::sort(result.begin(), result.end(), [](const TrackerCandidate &a, const TrackerCandidate &b) { return IsBetterTrackerCandidate(a, b); });
-	return result;
+	return GetTrackerSpatialIndex(MonsterTrackerIndex, signature, [](std::vector<SpatialIndex::Entry> &entries) {
+		for (size_t i = 0; i < ActiveMonsterCount; ++i) {
+			const int monsterId = static_cast<int>(ActiveMonsters[i]);
+			entries.push_back({ monsterId, Monsters[monsterId].position.future });
+		}
+	});
 }
 
-[[nodiscard]] std::vector<TrackerCandidate> CollectNearbyCorpseTrackerCandidates(Point playerPosition, int maxDistance)
+const SpatialIndex &GetCorpseTrackerIndex()
 {
-	std::vector<TrackerCandidate> result;
+	uint32_t signature = HashAccessCacheValue(HashCurrentLevelForAccessCache(), ObjectWalkabilityGeneration);
+	signature = HashAccessCacheValue(signature, CorpseGeneration);
+	return GetTrackerSpatialIndex(CorpseTrackerIndex, signature, [](std::vector<SpatialIndex::Entry> &entries) {
+		for (const CorpseEntry &corpse : GetCorpseEntries())
+			entries.push_back({ corpse.id, corpse.position });
+	});
+}
 
-	const int minX = std::max(0, playerPosition.x - maxDistance);
-	const int minY = std::max(0, playerPosition.y - maxDistance);
-	const int maxX = std::min(MAXDUNX - 1, playerPosition.x + maxDistance);
-	const int maxY = std::min(MAXDUNY - 1, playerPosition.y + maxDistance);
+[[nodiscard]] bool IsTrackedGroundItem(int itemId)
+{
+	const Item &item = Items[itemId];
+	return !item.isEmpty() && item._iClass != ICLASS_NONE;
+}
 
-	for (int y = minY; y <= maxY; ++y) {
-		for (int x = minX; x <= maxX; ++x) {
-			if (dCorpse[x][y] == 0)
-				continue;
+[[nodiscard]] bool IsTrackedMonster(const Monster &monster)
+{
+	return !monster.isInvalid
+	    && (monster.flags & MFLAG_HIDDEN) == 0
+	    && monster.hitPoints > 0;
+}
 
-			const Point position { x, y };
-			const int distance = playerPosition.WalkingDistance(position);
-			if (distance > maxDistance)
-				continue;
+/**
+ * @brief Lists the tracked monsters within `maxDistance` (measured with `ApproxDistance`), closest first.
+ */
+[[nodiscard]] std::vector<SpatialIndex::Match> FindTrackedMonstersNear(Point playerPosition, int maxDistance)
+{
+	std::vector<SpatialIndex::Match> result;
+	// ApproxDistance can underestimate the walking distance by up to ~6%, widen the search accordingly.
+	const int searchRadius = maxDistance + maxDistance / 16 + 1;
+	GetMonsterTrackerIndex().ForEachInRadius(playerPosition, searchRadius, [&](const SpatialIndex::Match &match) {
+		const Monster &monster = Monsters[match.id];
+		if (!IsTrackedMonster(monster))
+			return;
+		const int distance = playerPosition.ApproxDistance(Point { monster.position.future });
+		if (distance <= maxDistance)
+			result.push_back({ match.id, distance });
+	});
+	return result;
+}
 
-			result.push_back(TrackerCandidate {
-			    .id = CorpseTrackerIdForPosition(position),
-			    .distance = distance,
-			    .name = _("Dead body"),
-			});
-		}
+std::optional<int> FindNearestGroundItemId(Point playerPosition)
+{
+	const std::optional<SpatialIndex::Match> nearest = GetItemTrackerIndex().FindNearest(playerPosition, IsTrackedGroundItem);
+	if (!nearest)
+		return std::nullopt;
+	return nearest->id;
+}
+
+std::optional<int> FindNearestCorpseId(Point playerPosition)
+{
+	const std::optional<SpatialIndex::Match> nearest = GetCorpseTrackerIndex().FindNearest(playerPosition, [](int) { return true; });
+	if (!nearest)
+		return std::nullopt;
+	return nearest->id;
+}
+
+struct TrackerCandidate {
+	int id;
+	int distance;
+	StringOrView name;
+	/** Position among the candidates with the same name, starting at 1, or 0 if no other candidate has it. */
+	int ordinal = 0;
+};
+
+[[nodiscard]] bool IsBetterTrackerCandidate(const TrackerCandidate &a, const TrackerCandidate &b)
+{
+	if (a.distance != b.distance)
+		return a.distance < b.distance;
+	return a.id < b.id;
+}
+
+/** @brief Sorts the candidates closest first and numbers the ones that share a name, in that order. */
+void SortTrackerCandidates(std::vector<TrackerCandidate> &candidates)
+{
+	std::sort(candidates.begin(), candidates.end(), [](const TrackerCandidate &a, const TrackerCandidate &b) { return IsBetterTrackerCandidate(a, b); });
+
+	struct NameCount {
+		size_t first;
+		int count;
+	};
+	// Reused so cycling through targets doesn't allocate, the names only need to live until the candidates are numbered.
+	static ankerl::unordered_dense::map<std::string_view, NameCount> NameCounts;
+	NameCounts.clear();
+	for (size_t i = 0; i < candidates.size(); ++i) {
+		TrackerCandidate &candidate = candidates[i];
+		const auto [it, inserted] = NameCounts.try_emplace(candidate.name.str(), NameCount { i, 1 });
+		if (inserted)
+			continue;
+		candidates[it->second.first].ordinal = 1;
+		candidate.ordinal = ++it->second.count;
 	}
+	NameCounts.clear();
+}
+
+[[nodiscard]] std::vector<TrackerCandidate> CollectNearbyItemTrackerCandidates(Point playerPosition, int maxDistance)
+{
+	std::vector<TrackerCandidate> result;
+	result.reserve(ActiveItemCount);
 
-	std::sort(result.begin(), result.end(), [](const TrackerCandidate &a, const TrackerCandidate &b) { return IsBetterTrackerCandidate(a, b); });
+	GetItemTrackerIndex().ForEachInRadius(playerPosition, maxDistance, [&](const SpatialIndex::Match &match) {
+		if (!IsTrackedGroundItem(match.id))
+			return;
+		result.push_back(TrackerCandidate {
+		    .id = match.id,
+		    .distance = match.distance,
+		    .name = Items[match.id].getName(),
+		});
+	});
+
+	SortTrackerCandidates(result);
+	return result;
+}
+
+[[nodiscard]] std::vector<TrackerCandidate> CollectNearbyCorpseTrackerCandidates(Point playerPosition, int maxDistance)
+{
+	std::vector<TrackerCandidate> result;
+
+	GetCorpseTrackerIndex().ForEachInRadius(playerPosition, maxDistance, [&](const SpatialIndex::Match &match) {
+		result.push_back(TrackerCandidate {
+		    .id = match.id,
+		    .distance = match.distance,
+		    .name = _("Dead body"),
+		});
+	});
+
+	SortTrackerCandidates(result);
 	return result;
 }
 
@@ -2870,105 +3246,34 @@ struct TrackerCandidate {
 	return true;
 }
 
-[[nodiscard]] bool IsTrackedMonster(const Monster &monster)
-{
-	return !monster.isInvalid
-	    && (monster.flags & MFLAG_HIDDEN) == 0
-	    && monster.hitPoints > 0;
-}
-
 template <typename Predicate>
 [[nodiscard]] std::vector<TrackerCandidate> CollectNearbyObjectTrackerCandidates(Point playerPosition, int maxDistance, Predicate predicate)
 {
 	std::vector<TrackerCandidate> result;
 	result.reserve(ActiveObjectCount);
 
-	const int minX = std::max(0, playerPosition.x - maxDistance);
-	const int minY = std::max(0, playerPosition.y - maxDistance);
-	const int maxX = std::min(MAXDUNX - 1, playerPosition.x + maxDistance);
-	const int maxY = std::min(MAXDUNY - 1, playerPosition.y + maxDistance);
-
-	std::array<int, MAXOBJECTS> bestDistanceById {};
-	bestDistanceById.fill(std::numeric_limits<int>::max());
-
-	for (int y = minY; y <= maxY; ++y) {
-		for (int x = minX; x <= maxX; ++x) {
-			const int objectId = std::abs(dObject[x][y]) - 1;
-			if (objectId < 0 || objectId >= MAXOBJECTS)
-				continue;
-
-			const Object &object = Objects[objectId];
-			if (object._otype == OBJ_NULL)
-				continue;
-			if (!predicate(object))
-				continue;
-
-			const int distance = playerPosition.WalkingDistance(Point { x, y });
-			if (distance > maxDistance)
-				continue;
-
-			int &bestDistance = bestDistanceById[objectId];
-			if (distance < bestDistance)
-				bestDistance = distance;
-		}
-	}
-
-	for (int objectId = 0; objectId < MAXOBJECTS; ++objectId) {
-		const int distance = bestDistanceById[objectId];
-		if (distance == std::numeric_limits<int>::max())
-			continue;
-
-		const Object &object = Objects[objectId];
+	GetObjectTrackerIndex().ForEachInRadius(playerPosition, maxDistance, [&](const SpatialIndex::Match &match) {
+		const Object &object = Objects[match.id];
+		if (!predicate(object))
+			return;
 		result.push_back(TrackerCandidate {
-		    .id = objectId,
-		    .distance = distance,
+		    .id = match.id,
+		    .distance = match.distance,
 		    .name = object.name(),
 		});
-	}
+	});
 
-	std::sort(result.begin(), result.end(), [](const TrackerCandidate &a, const TrackerCandidate &b) { return IsBetterTrackerCandidate(a, b); });
+	SortTrackerCandidates(result);
 	return result;
 }
 
 template <typename Predicate>
 [[nodiscard]] std::optional<int> FindNearestObjectId(Point playerPosition, Predicate predicate)
 {
-	std::array<int, MAXOBJECTS> bestDistanceById {};
-	bestDistanceById.fill(std::numeric_limits<int>::max());
-
-	for (int y = 0; y < MAXDUNY; ++y) {
-		for (int x = 0; x < MAXDUNX; ++x) {
-			const int objectId = std::abs(dObject[x][y]) - 1;
-			if (objectId < 0 || objectId >= MAXOBJECTS)
-				continue;
-
-			const Object &object = Objects[objectId];
-			if (object._otype == OBJ_NULL)
-				continue;
-			if (!predicate(object))
-				continue;
-
-			const int distance = playerPosition.WalkingDistance(Point { x, y });
-			int &bestDistance = bestDistanceById[objectId];
-			if (distance < bestDistance)
-				bestDistance = distance;
-		}
-	}
-
-	std::optional<int> bestId;
-	int bestDistance = 0;
-	for (int objectId = 0; objectId < MAXOBJECTS; ++objectId) {
-		const int distance = bestDistanceById[objectId];
-		if (distance == std::numeric_limits<int>::max())
-			continue;
-
-		if (!bestId || distance < bestDistance) {
-			bestId = objectId;
-			bestDistance = distance;
-		}
-	}
-
-	return bestId;
+	const std::optional<SpatialIndex::Match> nearest = GetObjectTrackerIndex().FindNearest(playerPosition, [&predicate](int objectId) { return predicate(Objects[objectId]); });
+	if (!nearest)
+		return std::nullopt;
+	return nearest->id;
 }
 
 [[nodiscard]] std::vector<TrackerCandidate> CollectNearbyChestTrackerCandidates(Point playerPosition, int maxDistance)
@@ -2999,32 +3304,15 @@ template <typename Predicate>
 [[nodiscard]] std::vector<TrackerCandidate> CollectNearbyMonsterTrackerCandidates(Point playerPosition, int maxDistance)
 {
 	std::vector<TrackerCandidate> result;
-	result.reserve(ActiveMonsterCount);
-
-	for (size_t i = 0; i < ActiveMonsterCount; ++i) {
-		const int monsterId = static_cast<int>(ActiveMonsters[i]);
-		const Monster &monster = Monsters[monsterId];
-
-		if (monster.isInvalid)
-			continue;
-		if ((monster.flags & MFLAG_HIDDEN) != 0)
-			continue;
-		if (monster.hitPoints <= 0)
-			continue;
-
-		const Point monsterDistancePosition { monster.position.future };
-		const int distance = playerPosition.ApproxDistance(monsterDistancePosition);
-		if (distance > maxDistance)
-			continue;
-
+	for (const SpatialIndex::Match &match : FindTrackedMonstersNear(playerPosition, maxDistance)) {
 		result.push_back(TrackerCandidate {
-		    .id = monsterId,
-		    .distance = distance,
-		    .name = monster.name(),
+		    .id = match.id,
+		    .distance = match.distance,
+		    .name = Monsters[match.id].name(),
 		});
 	}
 
-	std::sort(result.begin(), result.end(), [](const TrackerCandidate &a, const TrackerCandidate &b) { return IsBetterTrackerCandidate(a, b); });
+	SortTrackerCandidates(result);
 	return result;
 }
 
@@ -3052,54 +3340,67 @@ void DecorateTrackerTargetNameWithOrdinalIfNeeded(int targetId, StringOrView &ta
 	if (targetName.empty())
 		return;
 
+	// The ordinals were worked out by SortTrackerCandidates, they only apply if the target is spoken by the same name.
 	const std::string_view baseName = targetName.str();
-	int total = 0;
-	for (const TrackerCandidate &c : candidates) {
-		if (c.name.str() == baseName)
-			++total;
-	}
-	if (total <= 1)
+	const auto it = c_find_if(candidates, [targetId](const TrackerCandidate &c) { return c.id == targetId; });
+	if (it == candidates.end() || it->ordinal == 0 || it->name.str() != baseName)
 		return;
 
-	int ordinal = 0;
-	int seen = 0;
-	for (const TrackerCandidate &c : candidates) {
-		if (c.name.str() != baseName)
-			continue;
-		++seen;
-		if (c.id == targetId) {
-			ordinal = seen;
-			break;
-		}
-	}
-	if (ordinal <= 0)
-		return;
-
-	std::string decorated;
-	StrAppend(decorated, baseName, " ", ordinal);
-	targetName = std::move(decorated);
+	targetName = StrCat(baseName, " ", it->ordinal);
 }
 
 [[nodiscard]] bool IsGroundItemPresent(int itemId)
 {
-	if (itemId < 0 || itemId > MAXITEMS)
+	if (itemId < 0 || itemId >= MAXITEMS)
 		return false;
 
-	for (uint8_t i = 0; i < ActiveItemCount; ++i) {
-		if (ActiveItems[i] == itemId)
-			return true;
+	// Every item on the ground is referenced by its tile, so this is the same as looking it up in ActiveItems.
+	const Item &item = Items[itemId];
+	return !item.isEmpty() && InDungeonBounds(item.position) && std::abs(dItem[item.position.x][item.position.y]) - 1 == itemId;
+}
+
+[[nodiscard]] bool IsItemTourStopPresent(const ItemTourStop &stop)
+{
+	return IsGroundItemPresent(stop.itemId) && TrackerTargetGeneration(TrackerTargetCategory::Items, stop.itemId) == stop.generation;
+}
+
+/**
+ * @brief Makes the next item of the tour the auto-walk target.
+ * @return false if the tour is waiting for the reached item to be picked up, or if it is over.
+ */
+bool StartNextItemTourStop()
+{
+	if (!ItemTourActive)
+		return false;
+	if (ItemTourReachedStop) {
+		if (IsItemTourStopPresent(*ItemTourReachedStop))
+			return false;
+		ItemTourReachedStop = std::nullopt;
+	}
+
+	while (!ItemTourStops.empty()) {
+		const ItemTourStop stop = ItemTourStops.back();
+		ItemTourStops.pop_back();
+		if (!IsItemTourStopPresent(stop))
+			continue;
+
+		AutoWalkTrackerTargetCategory = TrackerTargetCategory::Items;
+		AutoWalkTrackerTargetId = stop.itemId;
+		AutoWalkTrackerTargetGeneration = stop.generation;
+		std::string msg;
+		StrAppend(msg, _("Going to: "), Items[stop.itemId].getName());
+		SpeakText(msg, true);
+		return true;
 	}
 
+	ClearItemTour();
+	SpeakText(_("Item tour finished."), true);
 	return false;
 }
 
 [[nodiscard]] bool IsCorpsePresent(int corpseId)
 {
-	if (corpseId < 0 || corpseId >= MAXDUNX * MAXDUNY)
-		return false;
-
-	const Point position = CorpsePositionForTrackerId(corpseId);
-	return InDungeonBounds(position) && dCorpse[position.x][position.y] != 0;
+	return corpseId >= 0 && FindCorpseEntry(corpseId) != nullptr;
 }
 
 std::optional<int> FindNearestUnopenedChestObjectId(Point playerPosition)
@@ -3129,31 +3430,26 @@ std::optional<int> FindNearestMiscInteractableObjectId(Point playerPosition)
 
 std::optional<int> FindNearestMonsterId(Point playerPosition)
 {
+	// The closest monster by walking distance bounds how far the closest one by ApproxDistance can be.
+	const std::optional<SpatialIndex::Match> nearestWalking = GetMonsterTrackerIndex().FindNearest(playerPosition, [](int monsterId) { return IsTrackedMonster(Monsters[monsterId]); });
+	if (!nearestWalking)
+		return std::nullopt;
+
+	const int maxDistance = playerPosition.ApproxDistance(Point { Monsters[nearestWalking->id].position.future });
 	std::optional<int> bestId;
 	int bestDistance = 0;
-
-	for (size_t i = 0; i < ActiveMonsterCount; ++i) {
-		const int monsterId = static_cast<int>(ActiveMonsters[i]);
-		const Monster &monster = Monsters[monsterId];
-
-		if (monster.isInvalid)
-			continue;
-		if ((monster.flags & MFLAG_HIDDEN) != 0)
-			continue;
-		if (monster.hitPoints <= 0)
-			continue;
-
-		const Point monsterDistancePosition { monster.position.future };
-		const int distance = playerPosition.ApproxDistance(monsterDistancePosition);
-		if (!bestId || distance < bestDistance) {
-			bestId = monsterId;
-			bestDistance = distance;
+	for (const SpatialIndex::Match &match : FindTrackedMonstersNear(playerPosition, maxDistance)) {
+		if (!bestId || match.distance < bestDistance || (match.distance == bestDistance && match.id < *bestId)) {
+			bestId = match.id;
+			bestDistance = match.distance;
 		}
 	}
 
-	return bestId;
+	return bestId.value_or(nearestWalking->id);
 }
 
+std::optional<size_t> FindKeyboardWalkPathLengthForSpeech(const Player &player, Point startPosition, Point destinationPosition);
+
 std::optional<Point> FindBestAdjacentApproachTile(const Player &player, Point playerPosition, Point targetPosition)
 {
 	std::optional<Point> best;
@@ -3179,14 +3475,13 @@ std::optional<Point> FindBestAdjacentApproachTile(const Player &player, Point pl
 				bestFallbackDistance = distance;
 			}
 
-			const std::optional<std::vector<int8_t>> path = FindKeyboardWalkPathForSpeech(player, playerPosition, tile);
-			if (!path)
+			const std::optional<size_t> pathLength = FindKeyboardWalkPathLengthForSpeech(player, playerPosition, tile);
+			if (!pathLength)
 				continue;
 
-			const size_t pathLength = path->size();
-			if (!best || pathLength < bestPathLength || (pathLength == bestPathLength && distance < bestDistance)) {
+			if (!best || *pathLength < bestPathLength || (*pathLength == bestPathLength && distance < bestDistance)) {
 				best = tile;
-				bestPathLength = pathLength;
+				bestPathLength = *pathLength;
 				bestDistance = distance;
 			}
 		}
@@ -3281,6 +3576,50 @@ bool PosOkPlayerIgnoreDoorsMonstersAndBreakables(const Player &player, Point pos
 	return true;
 }
 
+/** The tiles around an object it can be used from, as far as the dungeon and the objects are concerned. */
+struct ObjectApproachTiles {
+	uint32_t signature = 0;
+	bool valid = false;
+	StaticVector<Point, 11> tiles;
+};
+
+std::array<ObjectApproachTiles, MAXOBJECTS> ObjectApproachTileCache;
+
+/**
+ * @brief The approach tiles of an object, worked out again only when the level or a door or breakable changes.
+ *
+ * Players and monsters move all the time, so they are left to the caller.
+ */
+const StaticVector<Point, 11> &GetObjectApproachTiles(const Object &object)
+{
+	ObjectApproachTiles &cache = ObjectApproachTileCache[static_cast<size_t>(&object - Objects)];
+	const uint32_t signature = HashAccessCacheValue(HashCurrentLevelForAccessCache(), ObjectWalkabilityGeneration);
+	if (cache.valid && cache.signature == signature)
+		return cache.tiles;
+
+	cache.tiles.clear();
+	const auto addTile = [&cache](Point tile) {
+		if (InDungeonBounds(tile) && IsTileWalkable(tile, /*ignoreDoors=*/true))
+			cache.tiles.push_back(tile);
+	};
+	for (int dy = -1; dy <= 1; ++dy) {
+		for (int dx = -1; dx <= 1; ++dx) {
+			if (dx == 0 && dy == 0)
+				continue;
+			addTile(object.position + Displacement { dx, dy });
+		}
+	}
+	if (FindObjectAtPosition(object.position + Direction::NorthEast) == &object) {
+		// Special case for large objects (e.g. sarcophagi): allow approaching from one tile further to the north.
+		for (int dx = -1; dx <= 1; ++dx) {
+			addTile(object.position + Displacement { dx, -2 });
+		}
+	}
+	cache.signature = signature;
+	cache.valid = true;
+	return cache.tiles;
+}
+
 std::optional<Point> FindBestApproachTileForObject(const Player &player, Point playerPosition, const Object &object)
 {
 	// Some interactable objects are placed on a walkable tile (e.g. floor switches). Prefer stepping on the tile in that case.
@@ -3294,9 +3633,9 @@ std::optional<Point> FindBestApproachTileForObject(const Player &player, Point p
 	std::optional<Point> bestFallback;
 	int bestFallbackDistance = 0;
 
-	const auto considerTile = [&](Point tile) {
+	for (const Point tile : GetObjectApproachTiles(object)) {
 		if (!PosOkPlayerIgnoreDoors(player, tile))
-			return;
+			continue;
 
 		const int distance = playerPosition.WalkingDistance(tile);
 		if (!bestFallback || distance < bestFallbackDistance) {
@@ -3304,31 +3643,16 @@ std::optional<Point> FindBestApproachTileForObject(const Player &player, Point p
 			bestFallbackDistance = distance;
 		}
 
-		const std::optional<std::vector<int8_t>> path = FindKeyboardWalkPathForSpeech(player, playerPosition, tile);
-		if (!path)
-			return;
+		// All tiles are looked up in the same navigation field rooted at the player, no search per tile.
+		const std::optional<size_t> pathLength = FindKeyboardWalkPathLengthForSpeech(player, playerPosition, tile);
+		if (!pathLength)
+			continue;
 
-		const size_t pathLength = path->size();
-		if (!best || pathLength < bestPathLength || (pathLength == bestPathLength && distance < bestDistance)) {
+		if (!best || *pathLength < bestPathLength || (*pathLength == bestPathLength && distance < bestDistance)) {
 			best = tile;
-			bestPathLength = pathLength;
+			bestPathLength = *pathLength;
 			bestDistance = distance;
 		}
-	};
-
-	for (int dy = -1; dy <= 1; ++dy) {
-		for (int dx = -1; dx <= 1; ++dx) {
-			if (dx == 0 && dy == 0)
-				continue;
-			considerTile(object.position + Displacement { dx, dy });
-		}
-	}
-
-	if (FindObjectAtPosition(object.position + Direction::NorthEast) == &object) {
-		// Special case for large objects (e.g. sarcophagi): allow approaching from one tile further to the north.
-		for (int dx = -1; dx <= 1; ++dx) {
-			considerTile(object.position + Displacement { dx, -2 });
-		}
 	}
 
 	if (best)
@@ -3337,26 +3661,6 @@ std::optional<Point> FindBestApproachTileForObject(const Player &player, Point p
 	return bestFallback;
 }
 
-struct DoorBlockInfo {
-	Point beforeDoor;
-	Point doorPosition;
-};
-
-std::optional<DoorBlockInfo> FindFirstClosedDoorOnWalkPath(Point startPosition, const int8_t *path, int steps)
-{
-	Point position = startPosition;
-	for (int i = 0; i < steps; ++i) {
-		const Point next = NextPositionForWalkDirection(position, path[i]);
-		Object *object = FindObjectAtPosition(next);
-		// Only closed doors block the path; blocked doors (DOOR_BLOCKED) are physically passable.
-		if (object != nullptr && object->isDoor() && object->_oVar4 == DOOR_CLOSED) {
-			return DoorBlockInfo { .beforeDoor = position, .doorPosition = object->position };
-		}
-		position = next;
-	}
-	return std::nullopt;
-}
-
 enum class TrackerPathBlockType : uint8_t {
 	Door,
 	Monster,
@@ -3443,6 +3747,7 @@ void NavigateToTrackerTargetKeyPressed()
 	const Point playerPosition = MyPlayer->position.future;
 	AutoWalkTrackerTargetId = -1;
 
+	ForgetStaleTrackerLock(SelectedTrackerTargetCategory);
 	int &lockedTargetId = LockedTrackerTargetId(SelectedTrackerTargetCategory);
 	if (clearTarget) {
 		lockedTargetId = -1;
@@ -3483,7 +3788,7 @@ void NavigateToTrackerTargetKeyPressed()
 			return;
 		}
 
-		lockedTargetId = *targetId;
+		LockTrackerTarget(SelectedTrackerTargetCategory, *targetId);
 		const Item &tracked = Items[*targetId];
 
 		targetName = tracked.getName();
@@ -3522,7 +3827,7 @@ void NavigateToTrackerTargetKeyPressed()
 			}
 		}
 
-		lockedTargetId = *targetId;
+		LockTrackerTarget(SelectedTrackerTargetCategory, *targetId);
 		const Object &tracked = Objects[*targetId];
 
 		targetName = tracked.name();
@@ -3570,7 +3875,7 @@ void NavigateToTrackerTargetKeyPressed()
 			}
 		}
 
-		lockedTargetId = *targetId;
+		LockTrackerTarget(SelectedTrackerTargetCategory, *targetId);
 		const Object &tracked = Objects[*targetId];
 
 		targetName = DoorLabelForSpeech(tracked);
@@ -3613,7 +3918,7 @@ void NavigateToTrackerTargetKeyPressed()
 			}
 		}
 
-		lockedTargetId = *targetId;
+		LockTrackerTarget(SelectedTrackerTargetCategory, *targetId);
 		const Object &tracked = Objects[*targetId];
 
 		targetName = tracked.name();
@@ -3656,7 +3961,7 @@ void NavigateToTrackerTargetKeyPressed()
 			}
 		}
 
-		lockedTargetId = *targetId;
+		LockTrackerTarget(SelectedTrackerTargetCategory, *targetId);
 		const Object &tracked = Objects[*targetId];
 
 		targetName = tracked.name();
@@ -3699,7 +4004,7 @@ void NavigateToTrackerTargetKeyPressed()
 			}
 		}
 
-		lockedTargetId = *targetId;
+		LockTrackerTarget(SelectedTrackerTargetCategory, *targetId);
 		const Object &tracked = Objects[*targetId];
 
 		targetName = tracked.name();
@@ -3742,7 +4047,7 @@ void NavigateToTrackerTargetKeyPressed()
 			}
 		}
 
-		lockedTargetId = *targetId;
+		LockTrackerTarget(SelectedTrackerTargetCategory, *targetId);
 		const Monster &tracked = Monsters[*targetId];
 
 		targetName = tracked.name();
@@ -3779,7 +4084,7 @@ void NavigateToTrackerTargetKeyPressed()
 			return;
 		}
 
-		lockedTargetId = *targetId;
+		LockTrackerTarget(SelectedTrackerTargetCategory, *targetId);
 		targetName = _("Dead body");
 		DecorateTrackerTargetNameWithOrdinalIfNeeded(*targetId, targetName, nearbyCandidates);
 		if (!cycleTarget) {
@@ -3800,25 +4105,20 @@ void NavigateToTrackerTargetKeyPressed()
 	}
 
 	Point chosenTargetPosition = *targetPosition;
+	// Closed doors only make a path longer, the door stops on it are announced below.
 	enum class TrackerPathMode : uint8_t {
-		RespectDoorsAndMonsters,
-		IgnoreDoors,
-		IgnoreMonsters,
-		IgnoreDoorsAndMonsters,
+		AvoidDoors,
+		AvoidDoorsIgnoreMonsters,
 		Lenient,
 	};
 
-	auto findPathToTarget = [&](Point destination, TrackerPathMode mode) -> std::optional<std::vector<int8_t>> {
+	auto findPathToTarget = [&](Point destination, TrackerPathMode mode) -> std::optional<WalkPath> {
 		const bool allowDestinationNonWalkable = !PosOkPlayer(*MyPlayer, destination);
 		switch (mode) {
-		case TrackerPathMode::RespectDoorsAndMonsters:
-			return FindKeyboardWalkPathForSpeechRespectingDoors(*MyPlayer, playerPosition, destination, allowDestinationNonWalkable);
-		case TrackerPathMode::IgnoreDoors:
-			return FindKeyboardWalkPathForSpeech(*MyPlayer, playerPosition, destination, allowDestinationNonWalkable);
-		case TrackerPathMode::IgnoreMonsters:
-			return FindKeyboardWalkPathForSpeechRespectingDoorsIgnoringMonsters(*MyPlayer, playerPosition, destination, allowDestinationNonWalkable);
-		case TrackerPathMode::IgnoreDoorsAndMonsters:
-			return FindKeyboardWalkPathForSpeechIgnoringMonsters(*MyPlayer, playerPosition, destination, allowDestinationNonWalkable);
+		case TrackerPathMode::AvoidDoors:
+			return FindKeyboardWalkPathForSpeechAvoidingDoors(*MyPlayer, playerPosition, destination, allowDestinationNonWalkable);
+		case TrackerPathMode::AvoidDoorsIgnoreMonsters:
+			return FindKeyboardWalkPathForSpeechAvoidingDoorsIgnoringMonsters(*MyPlayer, playerPosition, destination, allowDestinationNonWalkable);
 		case TrackerPathMode::Lenient:
 			return FindKeyboardWalkPathForSpeechLenient(*MyPlayer, playerPosition, destination, allowDestinationNonWalkable);
 		default:
@@ -3826,45 +4126,33 @@ void NavigateToTrackerTargetKeyPressed()
 		}
 	};
 
-	std::optional<std::vector<int8_t>> spokenPath;
+	std::optional<WalkPath> spokenPath;
 	bool pathIgnoresDoors = false;
 	bool pathIgnoresMonsters = false;
 	bool pathIgnoresBreakables = false;
 
 	const auto considerDestination = [&](Point destination, TrackerPathMode mode) {
-		const std::optional<std::vector<int8_t>> candidate = findPathToTarget(destination, mode);
+		const std::optional<WalkPath> candidate = findPathToTarget(destination, mode);
 		if (!candidate)
 			return;
 		if (!spokenPath || candidate->size() < spokenPath->size()) {
 			spokenPath = *candidate;
 			chosenTargetPosition = destination;
 
-			pathIgnoresDoors = mode == TrackerPathMode::IgnoreDoors || mode == TrackerPathMode::IgnoreDoorsAndMonsters || mode == TrackerPathMode::Lenient;
-			pathIgnoresMonsters = mode == TrackerPathMode::IgnoreMonsters || mode == TrackerPathMode::IgnoreDoorsAndMonsters || mode == TrackerPathMode::Lenient;
+			pathIgnoresDoors = true;
+			pathIgnoresMonsters = mode != TrackerPathMode::AvoidDoors;
 			pathIgnoresBreakables = mode == TrackerPathMode::Lenient;
 		}
 	};
 
-	considerDestination(*targetPosition, TrackerPathMode::RespectDoorsAndMonsters);
+	considerDestination(*targetPosition, TrackerPathMode::AvoidDoors);
 	if (alternateTargetPosition)
-		considerDestination(*alternateTargetPosition, TrackerPathMode::RespectDoorsAndMonsters);
-
-	if (!spokenPath) {
-		considerDestination(*targetPosition, TrackerPathMode::IgnoreDoors);
-		if (alternateTargetPosition)
-			considerDestination(*alternateTargetPosition, TrackerPathMode::IgnoreDoors);
-	}
+		considerDestination(*alternateTargetPosition, TrackerPathMode::AvoidDoors);
 
 	if (!spokenPath) {
-		considerDestination(*targetPosition, TrackerPathMode::IgnoreMonsters);
+		considerDestination(*targetPosition, TrackerPathMode::AvoidDoorsIgnoreMonsters);
 		if (alternateTargetPosition)
-			considerDestination(*alternateTargetPosition, TrackerPathMode::IgnoreMonsters);
-	}
-
-	if (!spokenPath) {
-		considerDestination(*targetPosition, TrackerPathMode::IgnoreDoorsAndMonsters);
-		if (alternateTargetPosition)
-			considerDestination(*alternateTargetPosition, TrackerPathMode::IgnoreDoorsAndMonsters);
+			considerDestination(*alternateTargetPosition, TrackerPathMode::AvoidDoorsIgnoreMonsters);
 	}
 
 	if (!spokenPath) {
@@ -3905,7 +4193,7 @@ void NavigateToTrackerTargetKeyPressed()
 				}
 			}
 
-			spokenPath = std::vector<int8_t>(spokenPath->begin(), spokenPath->begin() + block->stepIndex);
+			spokenPath->erase(spokenPath->begin() + block->stepIndex, spokenPath->end());
 		}
 	}
 
@@ -3960,7 +4248,7 @@ bool ValidateAutoWalkObjectTarget(
 		SpeakText(_(inRangeMessage), true);
 		return false;
 	}
-	destination = FindBestAdjacentApproachTile(myPlayer, playerPosition, object.position);
+	destination = FindBestApproachTileForObject(myPlayer, playerPosition, object);
 	return true;
 }
 
@@ -4007,19 +4295,77 @@ std::optional<int> ResolveObjectTrackerTarget(
 	return targetId;
 }
 
+/** How far the target may move away from where a route was planned to before the route is searched again. */
+constexpr int AutoWalkRouteTargetTolerance = 2;
+
+/** The path of the current tracker auto-walk, sent to the player one segment at a time. */
+struct AutoWalkRoute {
+	TrackerTargetCategory category;
+	int targetId;
+	/** The destination the path was searched for. */
+	Point plannedDestination;
+	PathJobResult path;
+	/** Steps of `path` already sent. */
+	int sentSteps;
+	/** Where the player stands once the sent steps are walked. */
+	Point expectedPosition;
+};
+
+std::optional<AutoWalkRoute> AutoWalkTrackerRoute;
+
+/**
+ * @brief The end of the next segment of the current route, if it can still be followed.
+ *
+ * Only the steps of that segment are checked against the level as it is now, the rest of the
+ * route is checked when its turn comes. Returns nothing, and drops the route, if the player got
+ * somewhere else, the target moved too far, the route is used up or a step got blocked.
+ */
+std::optional<Point> NextAutoWalkRouteWaypoint(const Player &player, Point playerPosition, Point destination)
+{
+	if (!AutoWalkTrackerRoute)
+		return std::nullopt;
+
+	AutoWalkRoute &route = *AutoWalkTrackerRoute;
+	const int remaining = route.path.steps - route.sentSteps;
+	if (route.category != AutoWalkTrackerTargetCategory || route.targetId != AutoWalkTrackerTargetId
+	    || route.expectedPosition != playerPosition || remaining <= 0
+	    || route.plannedDestination.WalkingDistance(destination) > AutoWalkRouteTargetTolerance) {
+		AutoWalkTrackerRoute = std::nullopt;
+		return std::nullopt;
+	}
+
+	// FindPath returns 0 if the path length is equal to the maximum.
+	// The player walkpath buffer is MaxPathLengthPlayer, so keep segments strictly shorter.
+	const int segmentSteps = std::min(remaining, static_cast<int>(MaxPathLengthPlayer - 1));
+	Point position = playerPosition;
+	for (int i = 0; i < segmentSteps; ++i) {
+		position = NextPositionForWalkDirection(position, route.path.path[route.sentSteps + i]);
+		if (!PosOkPlayer(player, position)) {
+			AutoWalkTrackerRoute = std::nullopt;
+			return std::nullopt;
+		}
+	}
+
+	route.sentSteps += segmentSteps;
+	route.expectedPosition = position;
+	return position;
+}
+
 /**
  * Called each game tick to advance auto-walk toward the current tracker target.
  * Does nothing if no target is active (AutoWalkTrackerTargetId < 0) or if the
  * player is not idle. Validates the target still exists and is reachable, then
  * computes a path. If a closed door blocks the path, reroutes to the tile
- * before the door. Long paths are sent in segments.
+ * before the door. Long paths are sent in segments, and the path is only
+ * searched again once it gets blocked or the target moves away from it.
  */
 void UpdateAutoWalkTracker()
 {
-	if (AutoWalkTrackerTargetId < 0)
+	if (AutoWalkTrackerTargetId < 0 && !StartNextItemTourStop())
 		return;
 	if (leveltype == DTYPE_TOWN || IsPlayerInStore() || ChatLogFlag || HelpFlag || InGameMenu()) {
 		AutoWalkTrackerTargetId = -1;
+		ClearItemTour();
 		return;
 	}
 	if (!CanPlayerTakeAction())
@@ -4044,12 +4390,7 @@ void UpdateAutoWalkTracker()
 	switch (AutoWalkTrackerTargetCategory) {
 	case TrackerTargetCategory::Items: {
 		const int itemId = AutoWalkTrackerTargetId;
-		if (itemId < 0 || itemId > MAXITEMS) {
-			AutoWalkTrackerTargetId = -1;
-			SpeakText(_("Target item is gone."), true);
-			return;
-		}
-		if (!IsGroundItemPresent(itemId)) {
+		if (!IsGroundItemPresent(itemId) || TrackerTargetGeneration(TrackerTargetCategory::Items, itemId) != AutoWalkTrackerTargetGeneration) {
 			AutoWalkTrackerTargetId = -1;
 			SpeakText(_("Target item is gone."), true);
 			return;
@@ -4057,6 +4398,8 @@ void UpdateAutoWalkTracker()
 		const Item &item = Items[itemId];
 		if (playerPosition.WalkingDistance(item.position) <= TrackerInteractDistanceTiles) {
 			AutoWalkTrackerTargetId = -1;
+			if (ItemTourActive)
+				ItemTourReachedStop = ItemTourStop { itemId, AutoWalkTrackerTargetGeneration };
 			SpeakText(_("Item in range."), true);
 			return;
 		}
@@ -4092,7 +4435,7 @@ void UpdateAutoWalkTracker()
 			return;
 		}
 		const Monster &monster = Monsters[monsterId];
-		if (!IsTrackedMonster(monster)) {
+		if (!IsTrackedMonster(monster) || monster.aiSeed != AutoWalkTrackerTargetGeneration) {
 			AutoWalkTrackerTargetId = -1;
 			SpeakText(_("Target monster is gone."), true);
 			return;
@@ -4132,51 +4475,43 @@ void UpdateAutoWalkTracker()
 		return;
 	}
 
-	constexpr size_t MaxAutoWalkPathLength = 512;
-	std::array<int8_t, MaxAutoWalkPathLength> path;
-	path.fill(WALK_NONE);
-
-	int steps = FindPath(CanStep, [&myPlayer](Point position) { return PosOkPlayer(myPlayer, position); }, playerPosition, *destination, path.data(), path.size());
-	// If no direct path exists, try pathfinding that treats closed doors as walkable.
-	// If that finds a path, identify the first closed door along it and re-route the
-	// player to the tile just before that door, so they can open it and retry.
-	if (steps == 0) {
-		std::array<int8_t, MaxAutoWalkPathLength> ignoreDoorPath;
-		ignoreDoorPath.fill(WALK_NONE);
+	if (const std::optional<Point> waypoint = NextAutoWalkRouteWaypoint(myPlayer, playerPosition, *destination)) {
+		NetSendCmdLoc(MyPlayerId, true, CMD_WALKXY, *waypoint);
+		return;
+	}
 
-		const int ignoreDoorSteps = FindPath(CanStep, [&myPlayer](Point position) { return PosOkPlayerIgnoreDoors(myPlayer, position); }, playerPosition, *destination, ignoreDoorPath.data(), ignoreDoorPath.size());
-		if (ignoreDoorSteps != 0) {
-			const std::optional<DoorBlockInfo> block = FindFirstClosedDoorOnWalkPath(playerPosition, ignoreDoorPath.data(), ignoreDoorSteps);
-			if (block) {
-				if (playerPosition.WalkingDistance(block->doorPosition) <= TrackerInteractDistanceTiles) {
-					AutoWalkTrackerTargetId = -1;
-					SpeakText(_("A door is blocking the path. Open it and try again."), true);
-					return;
-				}
+	// If no direct path exists, the worker retries treating closed doors as walkable.
+	// If that finds a path, the player is re-routed to the tile just before the first
+	// closed door along it, so they can open it and retry.
+	const std::optional<PathJobResult> pathResult = RequestAutoWalkPath(myPlayer, PathJob { .start = playerPosition, .destination = *destination, .routeBeforeClosedDoor = true });
+	if (!pathResult)
+		return; // Still searching, check again next tick.
 
-				*destination = block->beforeDoor;
-				path.fill(WALK_NONE);
-				steps = FindPath(CanStep, [&myPlayer](Point position) { return PosOkPlayer(myPlayer, position); }, playerPosition, *destination, path.data(), path.size());
-			}
-		}
-
-		if (steps == 0) {
-			AutoWalkTrackerTargetId = -1;
-			SpeakText(_("Can't find a path to the target."), true);
-			return;
-		}
+	if (pathResult->closedDoor && playerPosition.WalkingDistance(*pathResult->closedDoor) <= TrackerInteractDistanceTiles) {
+		AutoWalkTrackerTargetId = -1;
+		SpeakText(_("A door is blocking the path. Open it and try again."), true);
+		return;
 	}
 
-	// FindPath returns 0 if the path length is equal to the maximum.
-	// The player walkpath buffer is MaxPathLengthPlayer, so keep segments strictly shorter.
-	if (steps < static_cast<int>(MaxPathLengthPlayer)) {
-		NetSendCmdLoc(MyPlayerId, true, CMD_WALKXY, *destination);
+	if (pathResult->steps == 0) {
+		AutoWalkTrackerTargetId = -1;
+		SpeakText(_("Can't find a path to the target."), true);
 		return;
 	}
 
-	const int segmentSteps = std::min(steps - 1, static_cast<int>(MaxPathLengthPlayer - 1));
-	const Point waypoint = PositionAfterWalkPathSteps(playerPosition, path.data(), segmentSteps);
-	NetSendCmdLoc(MyPlayerId, true, CMD_WALKXY, waypoint);
+	AutoWalkTrackerRoute = AutoWalkRoute {
+		.category = AutoWalkTrackerTargetCategory,
+		.targetId = AutoWalkTrackerTargetId,
+		.plannedDestination = *destination,
+		.path = *pathResult,
+		.sentSteps = 0,
+		.expectedPosition = playerPosition,
+	};
+	if (const std::optional<Point> waypoint = NextAutoWalkRouteWaypoint(myPlayer, playerPosition, *destination)) {
+		NetSendCmdLoc(MyPlayerId, true, CMD_WALKXY, *waypoint);
+		return;
+	}
+	// The level changed while the path was searched, try again next tick.
 }
 
 /**
@@ -4185,6 +4520,9 @@ void UpdateAutoWalkTracker()
  * selected category. Sets AutoWalkTrackerTargetId/Category, then calls
  * UpdateAutoWalkTracker() to begin the first walk segment. Subsequent segments
  * are issued per-tick. Press M again to cancel.
+ *
+ * Shift+M plans a tour over the closest items instead, see PlanItemTour(). The tour waits
+ * at each item until it is picked up, pressing M there goes on without it.
  */
 void AutoWalkToTrackerTargetKeyPressed()
 {
@@ -4214,9 +4552,32 @@ void AutoWalkToTrackerTargetKeyPressed()
 		return;
 	}
 
+	const Point playerPosition = MyPlayer->position.future;
+
+	if ((SDL_GetModState() & SDL_KMOD_SHIFT) != 0) {
+		const std::vector<int> tour = PlanItemTour(*MyPlayer, playerPosition);
+		if (tour.empty()) {
+			SpeakText(_("No items found."), true);
+			return;
+		}
+		ClearItemTour();
+		ItemTourActive = true;
+		for (auto it = tour.rbegin(); it != tour.rend(); ++it)
+			ItemTourStops.push_back({ *it, TrackerTargetGeneration(TrackerTargetCategory::Items, *it) });
+		UpdateAutoWalkTracker();
+		return;
+	}
+
+	if (ItemTourActive) {
+		// Leave the item the tour stopped at behind and go on to the next one.
+		ItemTourReachedStop = std::nullopt;
+		UpdateAutoWalkTracker();
+		return;
+	}
+
 	EnsureTrackerLocksMatchCurrentLevel();
 
-	const Point playerPosition = MyPlayer->position.future;
+	ForgetStaleTrackerLock(SelectedTrackerTargetCategory);
 	int &lockedTargetId = LockedTrackerTargetId(SelectedTrackerTargetCategory);
 
 	std::optional<int> targetId;
@@ -4238,7 +4599,7 @@ void AutoWalkToTrackerTargetKeyPressed()
 			SpeakText(_("No items found."), true);
 			return;
 		}
-		lockedTargetId = *targetId;
+		LockTrackerTarget(SelectedTrackerTargetCategory, *targetId);
 		targetName = Items[*targetId].getName();
 		break;
 	}
@@ -4286,7 +4647,7 @@ void AutoWalkToTrackerTargetKeyPressed()
 				return;
 			}
 		}
-		lockedTargetId = *targetId;
+		LockTrackerTarget(SelectedTrackerTargetCategory, *targetId);
 		targetName = Monsters[*targetId].name();
 		break;
 	}
@@ -4305,7 +4666,7 @@ void AutoWalkToTrackerTargetKeyPressed()
 			SpeakText(_("No dead bodies found."), true);
 			return;
 		}
-		lockedTargetId = *targetId;
+		LockTrackerTarget(SelectedTrackerTargetCategory, *targetId);
 		targetName = _("Dead body");
 		break;
 	}
@@ -4316,6 +4677,7 @@ void AutoWalkToTrackerTargetKeyPressed()
 	SpeakText(msg, true);
 
 	AutoWalkTrackerTargetId = *targetId;
+	AutoWalkTrackerTargetGeneration = TrackerTargetGeneration(SelectedTrackerTargetCategory, *targetId);
 	AutoWalkTrackerTargetCategory = SelectedTrackerTargetCategory;
 	UpdateAutoWalkTracker();
 }
@@ -4391,329 +4753,530 @@ namespace {
 
 using PosOkForSpeechFn = bool (*)(const Player &, Point);
 
-template <size_t NumDirections>
-std::optional<std::vector<int8_t>> FindKeyboardWalkPathForSpeechBfs(const Player &player, Point startPosition, Point destinationPosition, PosOkForSpeechFn posOk, const std::array<int8_t, NumDirections> &walkDirections, bool allowDiagonalSteps, bool allowDestinationNonWalkable)
-{
-	if (!InDungeonBounds(startPosition) || !InDungeonBounds(destinationPosition))
-		return std::nullopt;
+/** Walk directions matching `SpeechWalkDisplacements`, the first four are the axis-aligned ones. */
+constexpr std::array<int8_t, NavigationField::MaxDirections> SpeechWalkDirections = {
+	WALK_NE,
+	WALK_SW,
+	WALK_SE,
+	WALK_NW,
+	WALK_N,
+	WALK_E,
+	WALK_S,
+	WALK_W,
+};
 
-	if (startPosition == destinationPosition)
-		return std::vector<int8_t> {};
+constexpr std::array<Displacement, NavigationField::MaxDirections> SpeechWalkDisplacements = {
+	Displacement { 0, -1 },
+	Displacement { 0, 1 },
+	Displacement { 1, 0 },
+	Displacement { -1, 0 },
+	Displacement { -1, -1 },
+	Displacement { 1, -1 },
+	Displacement { 1, 1 },
+	Displacement { -1, 1 },
+};
 
-	std::array<bool, MAXDUNX * MAXDUNY> visited {};
-	std::array<int8_t, MAXDUNX * MAXDUNY> parentDir {};
-	parentDir.fill(WALK_NONE);
+constexpr size_t SpeechAxisDirectionCount = 4;
 
-	std::queue<Point> queue;
+/** Extra steps a closed door on the way is worth, so short detours around it are preferred but long ones aren't. */
+constexpr NavigationField::DistanceType ClosedDoorStepPenalty = 20;
 
-	const auto indexOf = [](Point position) -> size_t {
-		return static_cast<size_t>(position.x) + static_cast<size_t>(position.y) * MAXDUNX;
-	};
+struct SpeechNavigationFieldKey {
+	PosOkForSpeechFn posOk = nullptr;
+	const Player *player = nullptr;
+	Point root;
+	bool allowDiagonalSteps = false;
+	bool penalizeClosedDoors = false;
+	uint32_t worldSignature = 0;
 
-	const auto enqueue = [&](Point current, int8_t dir) {
-		const Point next = NextPositionForWalkDirection(current, dir);
-		if (!InDungeonBounds(next))
-			return;
+	bool operator==(const SpeechNavigationFieldKey &other) const = default;
+};
 
-		const size_t idx = indexOf(next);
-		if (visited[idx])
-			return;
+struct SpeechNavigationFieldSlot {
+	SpeechNavigationFieldKey key;
+	std::unique_ptr<NavigationField> field;
+	uint32_t lastUse = 0;
+};
 
-		const bool ok = posOk(player, next);
-		if (ok) {
-			if (!CanStep(current, next))
-				return;
-		} else {
-			if (!allowDestinationNonWalkable || next != destinationPosition)
-				return;
+/** One slot for every walkability variant the speech helpers use, in both the axis-only and the diagonal variant. */
+constexpr size_t SpeechNavigationFieldSlotCount = 10;
+std::array<SpeechNavigationFieldSlot, SpeechNavigationFieldSlotCount> SpeechNavigationFields;
+uint32_t SpeechNavigationFieldUseCounter;
+
+/**
+ * @brief Summarizes everything the speech walkability predicates depend on besides the static dungeon.
+ *
+ * Monsters are only taken into account for the predicates that consider them, so the fields used to
+ * ignore monsters survive combat.
+ */
+uint32_t ComputeSpeechNavigationWorldSignature(PosOkForSpeechFn posOk)
+{
+	uint32_t hash = HashAccessCacheValue(HashCurrentLevelForAccessCache(), ObjectWalkabilityGeneration);
+
+	for (const Player &other : Players) {
+		if (!other.plractive || !other.isOnActiveLevel())
+			continue;
+		hash = HashAccessCachePosition(hash, other.position.tile);
+		hash = HashAccessCachePosition(hash, other.position.future);
+		hash = HashAccessCachePosition(hash, other.position.old);
+		hash = HashAccessCacheValue(hash, other.hasNoLife() ? 1 : 0);
+	}
+
+	if (posOk == PosOkPlayer || posOk == PosOkPlayerIgnoreDoors) {
+		for (size_t i = 0; i < ActiveMonsterCount; i++) {
+			const Monster &monster = Monsters[ActiveMonsters[i]];
+			hash = HashAccessCachePosition(hash, monster.position.tile);
+			hash = HashAccessCachePosition(hash, monster.position.future);
+			hash = HashAccessCachePosition(hash, monster.position.old);
+			hash = HashAccessCacheValue(hash, monster.hasNoLife() ? 1 : 0);
 		}
+	}
 
-		visited[idx] = true;
-		parentDir[idx] = dir;
-		queue.push(next);
-	};
+	return hash;
+}
 
-	visited[indexOf(startPosition)] = true;
-	queue.push(startPosition);
+using WalkabilityPlane = Bitset2d<MAXDUNX, MAXDUNY>;
 
-	const auto hasReachedDestination = [&]() -> bool {
-		return visited[indexOf(destinationPosition)];
-	};
+/**
+ * @brief Per-tile facts the speech walkability predicates are made of, gathered in a single pass.
+ *
+ * Combining the planes with whole-word bit operations gives the passable grid for any of the
+ * predicates, instead of calling the predicate (and querying dPiece/dObject/dMonster) per tile.
+ */
+struct SpeechWalkabilityPlanes {
+	/** The tile itself is solid or holds a solid object. */
+	WalkabilityPlane solid;
+	/** The tile holds a door, open or closed. */
+	WalkabilityPlane door;
+	/** The tile holds a solid object that can be broken (barrels...). */
+	WalkabilityPlane breakable;
+	/** The tile is occupied by a monster that blocks movement. */
+	WalkabilityPlane monster;
+	/** The tile is occupied by another living player. */
+	WalkabilityPlane player;
+
+	const Player *owner = nullptr;
+	uint32_t worldSignature = 0;
+	bool valid = false;
+};
 
-	while (!queue.empty() && !hasReachedDestination()) {
-		const Point current = queue.front();
-		queue.pop();
+SpeechWalkabilityPlanes SpeechPlanes;
 
-		const Displacement delta = destinationPosition - current;
-		const int deltaAbsX = delta.deltaX >= 0 ? delta.deltaX : -delta.deltaX;
-		const int deltaAbsY = delta.deltaY >= 0 ? delta.deltaY : -delta.deltaY;
+const SpeechWalkabilityPlanes &GetSpeechWalkabilityPlanes(const Player &player)
+{
+	// The signature including monsters covers everything any of the planes depends on.
+	const uint32_t worldSignature = ComputeSpeechNavigationWorldSignature(PosOkPlayer);
+	if (SpeechPlanes.valid && SpeechPlanes.owner == &player && SpeechPlanes.worldSignature == worldSignature)
+		return SpeechPlanes;
 
-		std::array<int8_t, 8> prioritizedDirs;
-		size_t prioritizedCount = 0;
+	SpeechPlanes.solid.reset();
+	SpeechPlanes.door.reset();
+	SpeechPlanes.breakable.reset();
+	SpeechPlanes.monster.reset();
+	SpeechPlanes.player.reset();
 
-		const auto addUniqueDir = [&](int8_t dir) {
-			if (dir == WALK_NONE)
-				return;
-			for (size_t i = 0; i < prioritizedCount; ++i) {
-				if (prioritizedDirs[i] == dir)
-					return;
-			}
-			prioritizedDirs[prioritizedCount++] = dir;
-		};
+	for (int y = 0; y < MAXDUNY; y++) {
+		for (int x = 0; x < MAXDUNX; x++) {
+			const Point position { x, y };
 
-		const int8_t xDir = delta.deltaX > 0 ? WALK_SE : (delta.deltaX < 0 ? WALK_NW : WALK_NONE);
-		const int8_t yDir = delta.deltaY > 0 ? WALK_SW : (delta.deltaY < 0 ? WALK_NE : WALK_NONE);
+			const Object *object = FindObjectAtPosition(position);
+			const bool solidObject = object != nullptr && object->_oSolidFlag;
+			if (solidObject || IsTileSolid(position))
+				SpeechPlanes.solid.set(x, y);
+			if (object != nullptr && object->isDoor())
+				SpeechPlanes.door.set(x, y);
+			if (solidObject && object->IsBreakable())
+				SpeechPlanes.breakable.set(x, y);
 
-		if (allowDiagonalSteps && delta.deltaX != 0 && delta.deltaY != 0) {
-			const int8_t diagDir = delta.deltaX > 0 ? (delta.deltaY > 0 ? WALK_S : WALK_E) : (delta.deltaY > 0 ? WALK_W : WALK_N);
-			addUniqueDir(diagDir);
+			const Player *otherPlayer = PlayerAtPosition(position);
+			if (otherPlayer != nullptr && otherPlayer != &player && !otherPlayer->hasNoLife())
+				SpeechPlanes.player.set(x, y);
+
+			const int monsterId = dMonster[x][y];
+			if (monsterId != 0 && (leveltype == DTYPE_TOWN || monsterId < 0 || !Monsters[monsterId - 1].hasNoLife()))
+				SpeechPlanes.monster.set(x, y);
 		}
+	}
+
+	SpeechPlanes.owner = &player;
+	SpeechPlanes.worldSignature = worldSignature;
+	SpeechPlanes.valid = true;
+	return SpeechPlanes;
+}
 
-		if (deltaAbsX >= deltaAbsY) {
-			addUniqueDir(xDir);
-			addUniqueDir(yDir);
+/**
+ * @brief Computes the tiles passing `posOk` from the precomputed planes.
+ * @return False if `posOk` isn't one of the speech predicates and has to be evaluated per tile.
+ */
+bool ComputeSpeechPassablePlane(const Player &player, PosOkForSpeechFn posOk, WalkabilityPlane &passable)
+{
+	const SpeechWalkabilityPlanes &planes = GetSpeechWalkabilityPlanes(player);
+
+	WalkabilityPlane blocked;
+	if (posOk == PosOkPlayer || posOk == PosOkPlayerIgnoreMonsters) {
+		blocked = planes.solid;
+	} else if (posOk == PosOkPlayerIgnoreDoors || posOk == PosOkPlayerIgnoreDoorsAndMonsters) {
+		blocked = ~planes.door;
+		blocked &= planes.solid;
+	} else if (posOk == PosOkPlayerIgnoreDoorsMonstersAndBreakables) {
+		blocked = ~planes.door;
+		blocked &= ~planes.breakable;
+		blocked &= planes.solid;
+	} else {
+		return false;
+	}
+
+	blocked |= planes.player;
+	if (posOk == PosOkPlayer || posOk == PosOkPlayerIgnoreDoors)
+		blocked |= planes.monster;
+
+	passable = ~blocked;
+	return true;
+}
+
+/**
+ * @brief Returns a navigation field rooted at `root`, reusing a cached one when nothing relevant changed.
+ *
+ * The speech helpers ask for many paths from the same tile per tick (every neighbour of a target,
+ * every tracker fallback mode...). Flooding once and answering each query by walking back through the
+ * field avoids repeating a full-level search for each of them.
+ */
+const NavigationField &GetSpeechNavigationField(const Player &player, Point root, PosOkForSpeechFn posOk, bool allowDiagonalSteps, bool penalizeClosedDoors = false)
+{
+	const SpeechNavigationFieldKey key { posOk, &player, root, allowDiagonalSteps, penalizeClosedDoors, ComputeSpeechNavigationWorldSignature(posOk) };
+	++SpeechNavigationFieldUseCounter;
+
+	SpeechNavigationFieldSlot *leastRecentlyUsed = &SpeechNavigationFields[0];
+	for (SpeechNavigationFieldSlot &slot : SpeechNavigationFields) {
+		if (slot.field != nullptr && slot.field->IsValid() && slot.key == key) {
+			slot.lastUse = SpeechNavigationFieldUseCounter;
+			return *slot.field;
+		}
+		if (slot.lastUse < leastRecentlyUsed->lastUse)
+			leastRecentlyUsed = &slot;
+	}
+
+	SpeechNavigationFieldSlot &slot = *leastRecentlyUsed;
+	if (slot.field == nullptr)
+		slot.field = std::make_unique<NavigationField>();
+	slot.key = key;
+	slot.lastUse = SpeechNavigationFieldUseCounter;
+
+	const std::span<const Displacement> directions(SpeechWalkDisplacements.data(), allowDiagonalSteps ? SpeechWalkDisplacements.size() : SpeechAxisDirectionCount);
+	WalkabilityPlane passable;
+	if (ComputeSpeechPassablePlane(player, posOk, passable)) {
+		if (penalizeClosedDoors) {
+			const SpeechWalkabilityPlanes &planes = GetSpeechWalkabilityPlanes(player);
+			WalkabilityPlane closedDoors = planes.door;
+			closedDoors &= planes.solid;
+			slot.field->Build(root, directions, passable, closedDoors, ClosedDoorStepPenalty, CanStep);
 		} else {
-			addUniqueDir(yDir);
-			addUniqueDir(xDir);
-		}
-		for (const int8_t dir : walkDirections) {
-			addUniqueDir(dir);
+			slot.field->Build(root, directions, passable, CanStep);
 		}
+	} else {
+		slot.field->Build(
+		    root, directions, [&player, posOk](Point position) { return posOk(player, position); }, CanStep);
+	}
+	return *slot.field;
+}
 
-		for (size_t i = 0; i < prioritizedCount; ++i) {
-			enqueue(current, prioritizedDirs[i]);
-		}
+std::optional<WalkPath> SpeechWalkPathFromField(const NavigationField &field, Point destinationPosition, bool allowDestinationNonWalkable)
+{
+	std::array<int8_t, MaxWalkPathLength> steps;
+	const std::optional<size_t> length = field.PathTo(destinationPosition, steps.data(), steps.size(), allowDestinationNonWalkable);
+	if (!length)
+		return std::nullopt;
+
+	std::optional<WalkPath> path { std::in_place };
+	for (size_t i = 0; i < *length; ++i) {
+		path->push_back(SpeechWalkDirections[steps[i]]);
 	}
+	return path;
+}
 
-	if (!hasReachedDestination())
+std::optional<WalkPath> FindKeyboardWalkPathForSpeechWithPosOk(const Player &player, Point startPosition, Point destinationPosition, PosOkForSpeechFn posOk, bool allowDestinationNonWalkable, bool penalizeClosedDoors = false)
+{
+	if (!InDungeonBounds(startPosition) || !InDungeonBounds(destinationPosition))
 		return std::nullopt;
 
-	std::vector<int8_t> path;
-	Point position = destinationPosition;
-	while (position != startPosition) {
-		const int8_t dir = parentDir[indexOf(position)];
-		if (dir == WALK_NONE)
-			return std::nullopt;
+	if (startPosition == destinationPosition)
+		return WalkPath {};
 
-		path.push_back(dir);
-		position = NextPositionForWalkDirection(position, OppositeWalkDirection(dir));
+	// Prefer paths without diagonal steps, they're easier to follow with the keyboard.
+	for (const bool allowDiagonalSteps : { false, true }) {
+		const NavigationField &field = GetSpeechNavigationField(player, startPosition, posOk, allowDiagonalSteps, penalizeClosedDoors);
+		if (std::optional<WalkPath> path = SpeechWalkPathFromField(field, destinationPosition, allowDestinationNonWalkable))
+			return path;
 	}
 
-	std::reverse(path.begin(), path.end());
-	return path;
+	return std::nullopt;
 }
 
-std::optional<std::vector<int8_t>> FindKeyboardWalkPathForSpeechWithPosOk(const Player &player, Point startPosition, Point destinationPosition, PosOkForSpeechFn posOk, bool allowDestinationNonWalkable)
+/** @brief The length of the path FindKeyboardWalkPathForSpeech would find, without building it. */
+std::optional<size_t> FindKeyboardWalkPathLengthForSpeech(const Player &player, Point startPosition, Point destinationPosition)
 {
-	constexpr std::array<int8_t, 4> AxisDirections = {
-		WALK_NE,
-		WALK_SW,
-		WALK_SE,
-		WALK_NW,
-	};
+	if (!InDungeonBounds(startPosition) || !InDungeonBounds(destinationPosition))
+		return std::nullopt;
 
-	constexpr std::array<int8_t, 8> AllDirections = {
-		WALK_NE,
-		WALK_SW,
-		WALK_SE,
-		WALK_NW,
-		WALK_N,
-		WALK_E,
-		WALK_S,
-		WALK_W,
-	};
+	if (startPosition == destinationPosition)
+		return 0;
 
-	if (const std::optional<std::vector<int8_t>> axisPath = FindKeyboardWalkPathForSpeechBfs(player, startPosition, destinationPosition, posOk, AxisDirections, /*allowDiagonalSteps=*/false, allowDestinationNonWalkable); axisPath) {
-		return axisPath;
+	for (const bool allowDiagonalSteps : { false, true }) {
+		const NavigationField &field = GetSpeechNavigationField(player, startPosition, PosOkPlayerIgnoreDoors, allowDiagonalSteps);
+		const NavigationField::DistanceType distance = field.Distance(destinationPosition);
+		if (distance != NavigationField::Unreachable && distance <= MaxWalkPathLength)
+			return distance;
 	}
 
-	return FindKeyboardWalkPathForSpeechBfs(player, startPosition, destinationPosition, posOk, AllDirections, /*allowDiagonalSteps=*/true, allowDestinationNonWalkable);
+	return std::nullopt;
 }
 
 } // namespace
 
-std::optional<std::vector<int8_t>> FindKeyboardWalkPathForSpeech(const Player &player, Point startPosition, Point destinationPosition, bool allowDestinationNonWalkable)
-{
-	return FindKeyboardWalkPathForSpeechWithPosOk(player, startPosition, destinationPosition, PosOkPlayerIgnoreDoors, allowDestinationNonWalkable);
-}
+/** Ticket of the auto-walk path search handed to the worker, or 0 if none. */
+uint32_t AutoWalkPathTicket = 0;
+/** The job behind AutoWalkPathTicket. */
+PathJob AutoWalkPathRequest;
 
-std::optional<std::vector<int8_t>> FindKeyboardWalkPathForSpeechRespectingDoors(const Player &player, Point startPosition, Point destinationPosition, bool allowDestinationNonWalkable)
+std::unique_ptr<PathSnapshot> TakeAutoWalkPathSnapshot(const Player &player)
 {
-	return FindKeyboardWalkPathForSpeechWithPosOk(player, startPosition, destinationPosition, PosOkPlayer, allowDestinationNonWalkable);
-}
+	auto snapshot = std::make_unique<PathSnapshot>();
+	if (!ComputeSpeechPassablePlane(player, PosOkPlayer, snapshot->passable))
+		app_fatal("PosOkPlayer has no walkability plane");
+	if (!ComputeSpeechPassablePlane(player, PosOkPlayerIgnoreDoors, snapshot->passableIgnoringDoors))
+		app_fatal("PosOkPlayerIgnoreDoors has no walkability plane");
 
-std::optional<std::vector<int8_t>> FindKeyboardWalkPathForSpeechIgnoringMonsters(const Player &player, Point startPosition, Point destinationPosition, bool allowDestinationNonWalkable)
-{
-	return FindKeyboardWalkPathForSpeechWithPosOk(player, startPosition, destinationPosition, PosOkPlayerIgnoreDoorsAndMonsters, allowDestinationNonWalkable);
-}
+	for (int y = 0; y < MAXDUNY; y++) {
+		for (int x = 0; x < MAXDUNX; x++) {
+			if (IsTileSolid({ x, y }))
+				snapshot->solid.set(x, y);
+		}
+	}
 
-std::optional<std::vector<int8_t>> FindKeyboardWalkPathForSpeechRespectingDoorsIgnoringMonsters(const Player &player, Point startPosition, Point destinationPosition, bool allowDestinationNonWalkable)
-{
-	return FindKeyboardWalkPathForSpeechWithPosOk(player, startPosition, destinationPosition, PosOkPlayerIgnoreMonsters, allowDestinationNonWalkable);
+	for (int i = 0; i < ActiveObjectCount; i++) {
+		const Object &object = Objects[ActiveObjects[i]];
+		// Only closed doors block the path; blocked doors (DOOR_BLOCKED) are physically passable.
+		if (object.isDoor() && object._oVar4 == DOOR_CLOSED && InDungeonBounds(object.position))
+			snapshot->closedDoor.set(object.position.x, object.position.y);
+	}
+
+	return snapshot;
 }
 
-std::optional<std::vector<int8_t>> FindKeyboardWalkPathForSpeechLenient(const Player &player, Point startPosition, Point destinationPosition, bool allowDestinationNonWalkable)
+/**
+ * @brief Returns the path for `job` once the worker has found it.
+ *
+ * The first call for a job hands it to the worker along with a snapshot of the level, later calls
+ * collect the result. Asking for a different job drops the previous one.
+ */
+std::optional<PathJobResult> RequestAutoWalkPath(const Player &player, const PathJob &job)
 {
-	return FindKeyboardWalkPathForSpeechWithPosOk(player, startPosition, destinationPosition, PosOkPlayerIgnoreDoorsMonstersAndBreakables, allowDestinationNonWalkable);
+	const bool isSameJob = AutoWalkPathTicket != 0
+	    && AutoWalkPathRequest.start == job.start
+	    && AutoWalkPathRequest.destination == job.destination
+	    && AutoWalkPathRequest.routeBeforeClosedDoor == job.routeBeforeClosedDoor;
+	if (!isSameJob) {
+		AutoWalkPathRequest = job;
+		AutoWalkPathTicket = SubmitPathJob(job, TakeAutoWalkPathSnapshot(player));
+	}
+
+	std::optional<PathJobResult> result = TakePathJobResult(AutoWalkPathTicket);
+	if (result)
+		AutoWalkPathTicket = 0;
+	return result;
 }
 
-namespace {
+struct TownNpcRouteKey {
+	uint32_t levelSignature = 0;
+	uint32_t walkabilityGeneration = 0;
+	Point townerPosition;
 
-template <size_t NumDirections>
-std::optional<std::vector<int8_t>> FindKeyboardWalkPathToClosestReachableForSpeechBfs(const Player &player, Point startPosition, Point destinationPosition, PosOkForSpeechFn posOk, const std::array<int8_t, NumDirections> &walkDirections, bool allowDiagonalSteps, Point &closestPosition)
-{
-	if (!InDungeonBounds(startPosition) || !InDungeonBounds(destinationPosition))
-		return std::nullopt;
+	bool operator==(const TownNpcRouteKey &other) const = default;
+};
 
-	if (startPosition == destinationPosition) {
-		closestPosition = destinationPosition;
-		return std::vector<int8_t> {};
-	}
+struct TownNpcRoute {
+	TownNpcRouteKey key;
+	std::unique_ptr<NavigationField> field;
+};
 
-	std::array<bool, MAXDUNX * MAXDUNY> visited {};
-	std::array<int8_t, MAXDUNX * MAXDUNY> parentDir {};
-	std::array<uint16_t, MAXDUNX * MAXDUNY> depth {};
-	parentDir.fill(WALK_NONE);
-	depth.fill(0);
+/** Navigation fields rooted at each towner, indexed like Towners, so walking to one never searches for a path. */
+std::vector<TownNpcRoute> TownNpcRoutes;
 
-	std::queue<Point> queue;
+/**
+ * @brief Returns the distance field from everywhere in town to a towner.
+ *
+ * The town only changes when a quest opens an entrance, so each field is flooded once and reused
+ * from wherever the player starts. Other players come and go, so only the town itself and the
+ * towners standing in it are obstacles.
+ */
+const NavigationField &GetTownNpcRoute(const Player &player, int townerIdx)
+{
+	const Towner &towner = Towners[townerIdx];
+	const TownNpcRouteKey key { HashCurrentLevelForAccessCache(), ObjectWalkabilityGeneration, towner.position };
+	if (TownNpcRoutes.size() < GetNumTowners())
+		TownNpcRoutes.resize(GetNumTowners());
 
-	const auto indexOf = [](Point position) -> size_t {
-		return static_cast<size_t>(position.x) + static_cast<size_t>(position.y) * MAXDUNX;
-	};
+	TownNpcRoute &route = TownNpcRoutes[static_cast<size_t>(townerIdx)];
+	if (route.field != nullptr && route.field->IsValid() && route.key == key)
+		return *route.field;
 
-	const auto enqueue = [&](Point current, int8_t dir) {
-		const Point next = NextPositionForWalkDirection(current, dir);
-		if (!InDungeonBounds(next))
-			return;
+	if (route.field == nullptr)
+		route.field = std::make_unique<NavigationField>();
+	route.key = key;
 
-		const size_t nextIdx = indexOf(next);
-		if (visited[nextIdx])
-			return;
+	const SpeechWalkabilityPlanes &planes = GetSpeechWalkabilityPlanes(player);
+	WalkabilityPlane blocked = planes.solid;
+	blocked |= planes.monster;
+	route.field->Build(towner.position, SpeechWalkDisplacements, ~blocked, CanStep);
+	return *route.field;
+}
 
-		if (!posOk(player, next))
-			return;
-		if (!CanStep(current, next))
-			return;
+/**
+ * @brief Walks down a navigation field from `start`, one step closer to its root each time.
+ * @return The tile reached after `steps` steps, or the last one before the root if that comes first.
+ */
+Point FollowNavigationFieldTowardsRoot(const NavigationField &field, Point start, int steps)
+{
+	Point position = start;
+	for (int i = 0; i < steps; ++i) {
+		const int distance = field.Distance(position);
+		if (distance <= 1 || distance == NavigationField::Unreachable)
+			break;
+		const auto next = std::find_if(SpeechWalkDisplacements.begin(), SpeechWalkDisplacements.end(), [&](Displacement step) {
+			return field.Distance(position + step) == distance - 1 && CanStep(position, position + step);
+		});
+		if (next == SpeechWalkDisplacements.end())
+			break;
+		position += *next;
+	}
+	return position;
+}
 
-		const size_t currentIdx = indexOf(current);
-		visited[nextIdx] = true;
-		parentDir[nextIdx] = dir;
-		depth[nextIdx] = static_cast<uint16_t>(depth[currentIdx] + 1);
-		queue.push(next);
-	};
+/** Most items planned into one tour, more would rarely be collected in one go before something changes. */
+constexpr size_t ItemTourMaxStops = 8;
 
-	const size_t startIdx = indexOf(startPosition);
-	visited[startIdx] = true;
-	queue.push(startPosition);
+/** Navigation fields rooted at each stop of the tour being planned, kept to reuse their memory. */
+std::vector<std::unique_ptr<NavigationField>> ItemTourFields;
 
-	Point best = startPosition;
-	int bestDistance = startPosition.WalkingDistance(destinationPosition);
-	uint16_t bestDepth = 0;
+/**
+ * @brief Picks the closest ground items and orders them into a short tour from `start`.
+ *
+ * The walking distances between all of them come from one field flooded from each item, so
+ * planning costs one search per item, and the tour is then walked leg by leg without asking
+ * the player to pick the next target. Items that can't be reached are left out.
+ *
+ * @return The item ids in visiting order.
+ */
+std::vector<int> PlanItemTour(const Player &player, Point start)
+{
+	std::vector<int> itemIds;
+	std::vector<Point> positions;
+	for (const SpatialIndex::Match &match : GetItemTrackerIndex().FindNearest(start, ItemTourMaxStops, IsTrackedGroundItem)) {
+		itemIds.push_back(match.id);
+		positions.push_back(Items[match.id].position);
+	}
 
-	const auto considerBest = [&](Point position) {
-		const int distance = position.WalkingDistance(destinationPosition);
-		const uint16_t posDepth = depth[indexOf(position)];
-		if (distance < bestDistance || (distance == bestDistance && posDepth < bestDepth)) {
-			best = position;
-			bestDistance = distance;
-			bestDepth = posDepth;
-		}
-	};
+	WalkabilityPlane passable;
+	if (itemIds.empty() || !ComputeSpeechPassablePlane(player, PosOkPlayerIgnoreDoorsAndMonsters, passable))
+		return {};
 
-	while (!queue.empty()) {
-		const Point current = queue.front();
-		queue.pop();
+	if (ItemTourFields.size() < itemIds.size())
+		ItemTourFields.resize(itemIds.size());
+	size_t reachable = 0;
+	for (size_t i = 0; i < itemIds.size(); ++i) {
+		std::unique_ptr<NavigationField> &field = ItemTourFields[reachable];
+		if (field == nullptr)
+			field = std::make_unique<NavigationField>();
+		field->Build(positions[i], SpeechWalkDisplacements, passable, CanStep);
+		if (field->Distance(start) == NavigationField::Unreachable)
+			continue;
+		itemIds[reachable] = itemIds[i];
+		positions[reachable] = positions[i];
+		reachable++;
+	}
+	itemIds.resize(reachable);
+	positions.resize(reachable);
+
+	// Node 0 is the start, node i the item in ItemTourFields[i - 1].
+	const std::vector<size_t> order = PlanTour(reachable, [&](size_t from, size_t to) -> int {
+		if (to == 0)
+			std::swap(from, to);
+		const Point fromPosition = from == 0 ? start : positions[from - 1];
+		return ItemTourFields[to - 1]->Distance(fromPosition);
+	});
 
-		considerBest(current);
+	std::vector<int> tour;
+	tour.reserve(order.size());
+	for (const size_t stop : order)
+		tour.push_back(itemIds[stop]);
+	return tour;
+}
 
-		const Displacement delta = destinationPosition - current;
-		const int deltaAbsX = delta.deltaX >= 0 ? delta.deltaX : -delta.deltaX;
-		const int deltaAbsY = delta.deltaY >= 0 ? delta.deltaY : -delta.deltaY;
+std::optional<WalkPath> FindKeyboardWalkPathForSpeech(const Player &player, Point startPosition, Point destinationPosition, bool allowDestinationNonWalkable)
+{
+	return FindKeyboardWalkPathForSpeechWithPosOk(player, startPosition, destinationPosition, PosOkPlayerIgnoreDoors, allowDestinationNonWalkable);
+}
 
-		std::array<int8_t, 8> prioritizedDirs;
-		size_t prioritizedCount = 0;
+std::optional<WalkPath> FindKeyboardWalkPathForSpeechAvoidingDoors(const Player &player, Point startPosition, Point destinationPosition, bool allowDestinationNonWalkable)
+{
+	return FindKeyboardWalkPathForSpeechWithPosOk(player, startPosition, destinationPosition, PosOkPlayerIgnoreDoors, allowDestinationNonWalkable, /*penalizeClosedDoors=*/true);
+}
 
-		const auto addUniqueDir = [&](int8_t dir) {
-			if (dir == WALK_NONE)
-				return;
-			for (size_t i = 0; i < prioritizedCount; ++i) {
-				if (prioritizedDirs[i] == dir)
-					return;
-			}
-			prioritizedDirs[prioritizedCount++] = dir;
-		};
+std::optional<WalkPath> FindKeyboardWalkPathForSpeechIgnoringMonsters(const Player &player, Point startPosition, Point destinationPosition, bool allowDestinationNonWalkable)
+{
+	return FindKeyboardWalkPathForSpeechWithPosOk(player, startPosition, destinationPosition, PosOkPlayerIgnoreDoorsAndMonsters, allowDestinationNonWalkable);
+}
 
-		const int8_t xDir = delta.deltaX > 0 ? WALK_SE : (delta.deltaX < 0 ? WALK_NW : WALK_NONE);
-		const int8_t yDir = delta.deltaY > 0 ? WALK_SW : (delta.deltaY < 0 ? WALK_NE : WALK_NONE);
+std::optional<WalkPath> FindKeyboardWalkPathForSpeechAvoidingDoorsIgnoringMonsters(const Player &player, Point startPosition, Point destinationPosition, bool allowDestinationNonWalkable)
+{
+	return FindKeyboardWalkPathForSpeechWithPosOk(player, startPosition, destinationPosition, PosOkPlayerIgnoreDoorsAndMonsters, allowDestinationNonWalkable, /*penalizeClosedDoors=*/true);
+}
 
-		if (allowDiagonalSteps && delta.deltaX != 0 && delta.deltaY != 0) {
-			const int8_t diagDir = delta.deltaX > 0 ? (delta.deltaY > 0 ? WALK_S : WALK_E) : (delta.deltaY > 0 ? WALK_W : WALK_N);
-			addUniqueDir(diagDir);
-		}
+std::optional<WalkPath> FindKeyboardWalkPathForSpeechLenient(const Player &player, Point startPosition, Point destinationPosition, bool allowDestinationNonWalkable)
+{
+	return FindKeyboardWalkPathForSpeechWithPosOk(player, startPosition, destinationPosition, PosOkPlayerIgnoreDoorsMonstersAndBreakables, allowDestinationNonWalkable);
+}
 
-		if (deltaAbsX >= deltaAbsY) {
-			addUniqueDir(xDir);
-			addUniqueDir(yDir);
-		} else {
-			addUniqueDir(yDir);
-			addUniqueDir(xDir);
-		}
-		for (const int8_t dir : walkDirections) {
-			addUniqueDir(dir);
-		}
+namespace {
 
-		for (size_t i = 0; i < prioritizedCount; ++i) {
-			enqueue(current, prioritizedDirs[i]);
+std::optional<WalkPath> FindKeyboardWalkPathToClosestReachableForSpeechInField(const NavigationField &field, Point destinationPosition, Point &closestPosition)
+{
+	Point best = field.Root();
+	int bestDistance = best.WalkingDistance(destinationPosition);
+
+	// Reached tiles are visited in breadth-first order, so on ties the one closest to the player wins.
+	for (size_t i = 1; i < field.ReachedCount(); ++i) {
+		const Point position = field.ReachedPosition(i);
+		const int distance = position.WalkingDistance(destinationPosition);
+		if (distance < bestDistance) {
+			best = position;
+			bestDistance = distance;
 		}
 	}
 
 	closestPosition = best;
-	if (best == startPosition)
-		return std::vector<int8_t> {};
-
-	std::vector<int8_t> path;
-	Point position = best;
-	while (position != startPosition) {
-		const int8_t dir = parentDir[indexOf(position)];
-		if (dir == WALK_NONE)
-			return std::nullopt;
-
-		path.push_back(dir);
-		position = NextPositionForWalkDirection(position, OppositeWalkDirection(dir));
-	}
-
-	std::reverse(path.begin(), path.end());
-	return path;
+	return SpeechWalkPathFromField(field, best, /*allowDestinationNonWalkable=*/false);
 }
 
 } // namespace
 
-std::optional<std::vector<int8_t>> FindKeyboardWalkPathToClosestReachableForSpeech(const Player &player, Point startPosition, Point destinationPosition, Point &closestPosition)
+std::optional<WalkPath> FindKeyboardWalkPathToClosestReachableForSpeech(const Player &player, Point startPosition, Point destinationPosition, Point &closestPosition)
 {
-	constexpr std::array<int8_t, 4> AxisDirections = {
-		WALK_NE,
-		WALK_SW,
-		WALK_SE,
-		WALK_NW,
-	};
+	if (!InDungeonBounds(startPosition) || !InDungeonBounds(destinationPosition))
+		return std::nullopt;
 
-	constexpr std::array<int8_t, 8> AllDirections = {
-		WALK_NE,
-		WALK_SW,
-		WALK_SE,
-		WALK_NW,
-		WALK_N,
-		WALK_E,
-		WALK_S,
-		WALK_W,
-	};
+	if (startPosition == destinationPosition) {
+		closestPosition = destinationPosition;
+		return WalkPath {};
+	}
 
 	Point axisClosest;
-	const std::optional<std::vector<int8_t>> axisPath = FindKeyboardWalkPathToClosestReachableForSpeechBfs(player, startPosition, destinationPosition, PosOkPlayerIgnoreDoors, AxisDirections, /*allowDiagonalSteps=*/false, axisClosest);
+	const std::optional<WalkPath> axisPath = FindKeyboardWalkPathToClosestReachableForSpeechInField(
+	    GetSpeechNavigationField(player, startPosition, PosOkPlayerIgnoreDoors, /*allowDiagonalSteps=*/false), destinationPosition, axisClosest);
 
 	Point diagClosest;
-	const std::optional<std::vector<int8_t>> diagPath = FindKeyboardWalkPathToClosestReachableForSpeechBfs(player, startPosition, destinationPosition, PosOkPlayerIgnoreDoors, AllDirections, /*allowDiagonalSteps=*/true, diagClosest);
+	const std::optional<WalkPath> diagPath = FindKeyboardWalkPathToClosestReachableForSpeechInField(
+	    GetSpeechNavigationField(player, startPosition, PosOkPlayerIgnoreDoors, /*allowDiagonalSteps=*/true), destinationPosition, diagClosest);
 
 	if (!axisPath && !diagPath)
 		return std::nullopt;
@@ -4737,9 +5300,9 @@ std::optional<std::vector<int8_t>> FindKeyboardWalkPathToClosestReachableForSpee
 	return axisPath;
 }
 
-void AppendKeyboardWalkPathForSpeech(std::string &message, const std::vector<int8_t> &path)
+void AppendKeyboardWalkPathForSpeech(std::string &message, const WalkPathRuns &runs)
 {
-	if (path.empty()) {
+	if (runs.empty()) {
 		message.append(_("here"));
 		return;
 	}
@@ -4775,32 +5338,106 @@ void AppendKeyboardWalkPathForSpeech(std::string &message, const std::vector<int
 		default:
 			return {};
 		}
-	};
-
-	int8_t currentDir = path.front();
-	int runLength = 1;
-	for (size_t i = 1; i < path.size(); ++i) {
-		if (path[i] == currentDir) {
-			++runLength;
-			continue;
-		}
+	};
 
-		const std::string_view label = labelForWalkDirection(currentDir);
+	for (const WalkPathRun &run : runs) {
+		const std::string_view label = labelForWalkDirection(run.direction);
 		if (!label.empty())
-			appendPart(label, runLength);
-
-		currentDir = path[i];
-		runLength = 1;
+			appendPart(label, run.steps);
 	}
 
-	const std::string_view label = labelForWalkDirection(currentDir);
-	if (!label.empty())
-		appendPart(label, runLength);
-
 	if (!any)
 		message.append(_("here"));
 }
 
+void AppendKeyboardWalkPathForSpeech(std::string &message, const WalkPath &path)
+{
+	AppendKeyboardWalkPathForSpeech(message, WalkPathRuns { path });
+}
+
+namespace {
+
+/** How many sector portals ahead long speech directions are searched tile by tile. */
+constexpr size_t SpeechRefinedPortalCount = 2;
+
+SectorGraph SpeechSectorGraph;
+uint32_t SpeechSectorGraphSignature = 0;
+bool SpeechSectorGraphValid = false;
+std::unique_ptr<NavigationField> SpeechLegField;
+
+/**
+ * @brief Returns the room graph of the current level, with rooms taken from the dTransVal regions.
+ */
+const SectorGraph &GetSpeechSectorGraph(const Player &player)
+{
+	const uint32_t worldSignature = ComputeSpeechNavigationWorldSignature(PosOkPlayerIgnoreDoorsAndMonsters);
+	if (SpeechSectorGraphValid && SpeechSectorGraphSignature == worldSignature)
+		return SpeechSectorGraph;
+
+	WalkabilityPlane passable;
+	if (ComputeSpeechPassablePlane(player, PosOkPlayerIgnoreDoorsAndMonsters, passable))
+		SpeechSectorGraph.Build(passable, [](Point position) { return static_cast<int>(dTransVal[position.x][position.y]); });
+	else
+		SpeechSectorGraph.Clear();
+
+	SpeechSectorGraphSignature = worldSignature;
+	SpeechSectorGraphValid = true;
+	return SpeechSectorGraph;
+}
+
+struct SpeechWalkPlan {
+	WalkPath path;
+	/** False if `path` only covers the first legs of the walk, up to a room further along the way. */
+	bool reachesDestination;
+};
+
+/**
+ * @brief Plans the walk from `startPosition` to `destinationPosition` for spoken directions.
+ *
+ * Long walks are planned room by room, and only the legs through the next few rooms are searched
+ * tile by tile, since that's all the player will follow before asking again.
+ */
+std::optional<SpeechWalkPlan> PlanKeyboardWalkForSpeech(const Player &player, Point startPosition, Point destinationPosition)
+{
+	const SectorGraph &graph = GetSpeechSectorGraph(player);
+	const std::optional<std::vector<SectorGraph::Portal>> route = graph.PlanRoute(startPosition, destinationPosition);
+
+	WalkabilityPlane passable;
+	if (route && route->size() > SpeechRefinedPortalCount && ComputeSpeechPassablePlane(player, PosOkPlayerIgnoreDoors, passable)) {
+		WalkabilityPlane corridor;
+		graph.AddSectorTiles(graph.SectorAt(startPosition), corridor);
+		for (size_t i = 0; i < SpeechRefinedPortalCount; i++)
+			graph.AddSectorTiles(graph.SectorAt((*route)[i].to), corridor);
+		passable &= corridor;
+
+		if (SpeechLegField == nullptr)
+			SpeechLegField = std::make_unique<NavigationField>();
+		const Point waypoint = (*route)[SpeechRefinedPortalCount - 1].to;
+		// Prefer paths without diagonal steps, they're easier to follow with the keyboard.
+		for (const bool allowDiagonalSteps : { false, true }) {
+			const std::span<const Displacement> directions(SpeechWalkDisplacements.data(), allowDiagonalSteps ? SpeechWalkDisplacements.size() : SpeechAxisDirectionCount);
+			SpeechLegField->Build(startPosition, directions, passable, CanStep);
+			if (std::optional<WalkPath> path = SpeechWalkPathFromField(*SpeechLegField, waypoint, /*allowDestinationNonWalkable=*/false))
+				return SpeechWalkPlan { .path = std::move(*path), .reachesDestination = false };
+		}
+	}
+
+	if (std::optional<WalkPath> path = FindKeyboardWalkPathForSpeech(player, startPosition, destinationPosition))
+		return SpeechWalkPlan { .path = std::move(*path), .reachesDestination = true };
+	return std::nullopt;
+}
+
+void AppendKeyboardWalkPlanForSpeech(std::string &message, const SpeechWalkPlan &plan)
+{
+	AppendKeyboardWalkPathForSpeech(message, plan.path);
+	if (!plan.reachesDestination) {
+		message.append(", ");
+		message.append(_("then ask again"));
+	}
+}
+
+} // namespace
+
 void AppendDirectionalFallback(std::string &message, const Displacement &delta)
 {
 	bool any = false;
@@ -4827,51 +5464,102 @@ void AppendDirectionalFallback(std::string &message, const Displacement &delta)
 		message.append(_("here"));
 }
 
-std::optional<Point> FindNearestUnexploredTile(Point startPosition)
-{
-	if (!InDungeonBounds(startPosition))
-		return std::nullopt;
+/**
+ * @brief Unexplored tiles bordering explored ones, kept up to date from the tiles revealed by vision.
+ *
+ * The closest unexplored tile reachable from an explored position is always one of these, so the
+ * search only has to look at the frontier rather than flooding the level.
+ */
+struct ExplorationFrontier {
+	std::vector<Point> tiles;
+	Bitset2d<MAXDUNX, MAXDUNY> isListed;
+	uint32_t levelSignature = 0;
+	bool valid = false;
+};
 
-	std::array<bool, MAXDUNX * MAXDUNY> visited {};
-	std::queue<Point> queue;
+ExplorationFrontier UnexploredFrontier;
+std::vector<Point> NewlyExploredTilesScratch;
 
-	const auto enqueue = [&](Point position) {
-		if (!InDungeonBounds(position))
-			return;
+[[nodiscard]] bool IsTileExplored(Point position)
+{
+	return HasAnyOf(dFlags[position.x][position.y], DungeonFlag::Explored);
+}
 
-		const size_t index = static_cast<size_t>(position.x) + static_cast<size_t>(position.y) * MAXDUNX;
-		if (visited[index])
-			return;
+void AddToExplorationFrontier(Point position)
+{
+	if (!InDungeonBounds(position) || IsTileExplored(position) || UnexploredFrontier.isListed.test(position.x, position.y))
+		return;
+	UnexploredFrontier.isListed.set(position.x, position.y);
+	UnexploredFrontier.tiles.push_back(position);
+}
 
-		if (!IsTileWalkable(position, /*ignoreDoors=*/true))
-			return;
+constexpr std::array<Direction, 4> ExplorationNeighbors = {
+	Direction::NorthEast,
+	Direction::SouthWest,
+	Direction::SouthEast,
+	Direction::NorthWest,
+};
 
-		visited[index] = true;
-		queue.push(position);
-	};
+void UpdateExplorationFrontier()
+{
+	const uint32_t levelSignature = HashAccessCacheValue(HashCurrentLevelForAccessCache(), ObjectWalkabilityGeneration);
+	const bool complete = TakeNewlyExploredTiles(NewlyExploredTilesScratch);
+
+	if (!complete || !UnexploredFrontier.valid || UnexploredFrontier.levelSignature != levelSignature) {
+		UnexploredFrontier.tiles.clear();
+		UnexploredFrontier.isListed.reset();
+		for (int y = 0; y < MAXDUNY; y++) {
+			for (int x = 0; x < MAXDUNX; x++) {
+				const Point position { x, y };
+				if (!IsTileExplored(position))
+					continue;
+				for (const Direction dir : ExplorationNeighbors)
+					AddToExplorationFrontier(position + dir);
+			}
+		}
+		UnexploredFrontier.levelSignature = levelSignature;
+		UnexploredFrontier.valid = true;
+		return;
+	}
 
-	enqueue(startPosition);
+	for (const Point position : NewlyExploredTilesScratch) {
+		for (const Direction dir : ExplorationNeighbors)
+			AddToExplorationFrontier(position + dir);
+	}
 
-	constexpr std::array<Direction, 4> Neighbors = {
-		Direction::NorthEast,
-		Direction::SouthWest,
-		Direction::SouthEast,
-		Direction::NorthWest,
-	};
+	// Drop tiles that have been explored in the meantime.
+	const auto explored = std::remove_if(UnexploredFrontier.tiles.begin(), UnexploredFrontier.tiles.end(), [](Point position) {
+		if (!IsTileExplored(position))
+			return false;
+		UnexploredFrontier.isListed.reset(position.x, position.y);
+		return true;
+	});
+	UnexploredFrontier.tiles.erase(explored, UnexploredFrontier.tiles.end());
+}
 
-	while (!queue.empty()) {
-		const Point position = queue.front();
-		queue.pop();
+std::optional<Point> FindNearestUnexploredTile(const Player &player, Point startPosition)
+{
+	if (!InDungeonBounds(startPosition))
+		return std::nullopt;
+	if (!IsTileWalkable(startPosition, /*ignoreDoors=*/true))
+		return std::nullopt;
+	if (!IsTileExplored(startPosition))
+		return startPosition;
 
-		if (!HasAnyOf(dFlags[position.x][position.y], DungeonFlag::Explored))
-			return position;
+	UpdateExplorationFrontier();
 
-		for (const Direction dir : Neighbors) {
-			enqueue(position + dir);
+	const NavigationField &field = GetSpeechNavigationField(player, startPosition, PosOkPlayerIgnoreDoorsAndMonsters, /*allowDiagonalSteps=*/false);
+	std::optional<Point> best;
+	NavigationField::DistanceType bestDistance = NavigationField::Unreachable;
+	for (const Point position : UnexploredFrontier.tiles) {
+		const NavigationField::DistanceType distance = field.Distance(position);
+		if (distance < bestDistance) {
+			best = position;
+			bestDistance = distance;
 		}
 	}
 
-	return std::nullopt;
+	return best;
 }
 
 std::string TriggerLabelForSpeech(const TriggerStruct &trigger)
@@ -4976,41 +5664,127 @@ std::optional<int> FindNextTownDungeonTriggerIndex(const std::vector<int> &candi
 	return *std::next(it);
 }
 
-std::optional<int> FindPreferredExitTriggerIndex()
+enum class LevelLandmarkKind : uint8_t {
+	Trigger,
+	QuestEntrance,
+	TownPortal,
+};
+
+struct LevelLandmark {
+	LevelLandmarkKind kind;
+	/** Index into trigs, Quests or Portals, depending on the kind. */
+	int index;
+	Point position;
+	/** Walking distances from everywhere on the level to the landmark. */
+	std::unique_ptr<NavigationField> field;
+};
+
+struct LevelLandmarkTable {
+	uint32_t levelSignature = 0;
+	uint32_t walkabilityGeneration = 0;
+	int triggerCount = 0;
+	std::vector<LevelLandmark> landmarks;
+	/** Town portals open and close while the level is loaded, so they get a slot each that is refreshed on use. */
+	std::array<std::optional<LevelLandmark>, MAXPORTAL> portals;
+};
+
+/** Stairs, exits, quest entrances and town portals of the current level, see GetLevelLandmarks(). */
+LevelLandmarkTable LevelLandmarks;
+
+[[nodiscard]] std::unique_ptr<NavigationField> BuildLevelLandmarkField(const Player &player, Point position)
 {
-	if (numtrigs <= 0)
-		return std::nullopt;
+	// Monsters move and doors can be opened, so only the level itself is an obstacle.
+	const SpeechWalkabilityPlanes &planes = GetSpeechWalkabilityPlanes(player);
+	WalkabilityPlane blocked = ~planes.door;
+	blocked &= planes.solid;
+	auto field = std::make_unique<NavigationField>();
+	field->Build(position, SpeechWalkDisplacements, ~blocked, CanStep);
+	return field;
+}
 
-	if (leveltype == DTYPE_TOWN && MyPlayer != nullptr) {
-		const Point playerPosition = MyPlayer->position.future;
-		std::optional<int> bestIndex;
-		int bestDistance = 0;
+[[nodiscard]] bool IsTownPortalOnCurrentLevel(const Portal &portal)
+{
+	const int currentLevel = setlevel ? static_cast<int>(setlvlnum) : currlevel;
+	return portal.open && portal.setlvl == setlevel && portal.level == currentLevel;
+}
 
-		for (int i = 0; i < numtrigs; ++i) {
-			if (!IsAnyOf(trigs[i]._tmsg, WM_DIABNEXTLVL, WM_DIABTOWNWARP))
-				continue;
+/**
+ * @brief Collects the landmarks of the current level and floods a navigation field from each of them.
+ *
+ * Called once the level is loaded, so the "nearest exit" style keys only have to look up the
+ * distance from the player in each field instead of searching for paths.
+ */
+void BuildLevelLandmarks(const Player &player)
+{
+	LevelLandmarkTable &table = LevelLandmarks;
+	table.levelSignature = HashCurrentLevelForAccessCache();
+	table.walkabilityGeneration = ObjectWalkabilityGeneration;
+	table.triggerCount = numtrigs;
+	table.landmarks.clear();
+	table.portals = {};
 
-			const Point triggerPosition { trigs[i].position.x, trigs[i].position.y };
-			const int distance = playerPosition.WalkingDistance(triggerPosition);
-			if (!bestIndex || distance < bestDistance) {
-				bestIndex = i;
-				bestDistance = distance;
-			}
+	for (int i = 0; i < numtrigs; ++i) {
+		const Point position { trigs[i].position.x, trigs[i].position.y };
+		table.landmarks.push_back({ LevelLandmarkKind::Trigger, i, position, BuildLevelLandmarkField(player, position) });
+	}
+
+	if (!setlevel) {
+		for (const Quest &quest : Quests) {
+			if (quest._qslvl == SL_NONE || quest._qlevel != currlevel || !InDungeonBounds(quest.position))
+				continue;
+			table.landmarks.push_back({ LevelLandmarkKind::QuestEntrance, quest._qidx, quest.position, BuildLevelLandmarkField(player, quest.position) });
 		}
+	}
+}
+
+/** @brief The landmarks of the current level, rebuilt if the level changed since BuildLevelLandmarks(). */
+const LevelLandmarkTable &GetLevelLandmarks(const Player &player)
+{
+	LevelLandmarkTable &table = LevelLandmarks;
+	// Quests can add a staircase to a loaded level, and opening a passage changes the walkable tiles.
+	if (table.levelSignature != HashCurrentLevelForAccessCache() || table.walkabilityGeneration != ObjectWalkabilityGeneration || table.triggerCount != numtrigs)
+		BuildLevelLandmarks(player);
 
-		if (bestIndex)
-			return bestIndex;
+	for (size_t i = 0; i < MAXPORTAL; ++i) {
+		const Portal &portal = Portals[i];
+		std::optional<LevelLandmark> &slot = table.portals[i];
+		if (leveltype == DTYPE_TOWN || !IsTownPortalOnCurrentLevel(portal)) {
+			slot = std::nullopt;
+			continue;
+		}
+		if (!slot || slot->position != portal.position)
+			slot = LevelLandmark { LevelLandmarkKind::TownPortal, static_cast<int>(i), portal.position, BuildLevelLandmarkField(player, portal.position) };
 	}
+	return table;
+}
 
-	const Point playerPosition = MyPlayer->position.future;
+/**
+ * @brief How far the player has to walk to reach a landmark.
+ *
+ * Landmarks that can't be reached rank after all reachable ones, by straight distance.
+ */
+[[nodiscard]] int LevelLandmarkDistance(const LevelLandmark &landmark, Point playerPosition)
+{
+	const NavigationField::DistanceType distance = landmark.field->Distance(playerPosition);
+	if (distance != NavigationField::Unreachable)
+		return distance;
+	return NavigationField::Unreachable + playerPosition.WalkingDistance(landmark.position);
+}
+
+/** @brief The trigger landmark closest to the player that passes the filter. */
+template <typename Filter>
+std::optional<int> FindNearestTriggerLandmark(const Player &player, Filter &&filter)
+{
+	const Point playerPosition = player.position.future;
 	std::optional<int> bestIndex;
 	int bestDistance = 0;
 
-	for (int i = 0; i < numtrigs; ++i) {
-		const Point triggerPosition { trigs[i].position.x, trigs[i].position.y };
-		const int distance = playerPosition.WalkingDistance(triggerPosition);
+	for (const LevelLandmark &landmark : GetLevelLandmarks(player).landmarks) {
+		if (landmark.kind != LevelLandmarkKind::Trigger || !filter(trigs[landmark.index]))
+			continue;
+		const int distance = LevelLandmarkDistance(landmark, playerPosition);
 		if (!bestIndex || distance < bestDistance) {
-			bestIndex = i;
+			bestIndex = landmark.index;
 			bestDistance = distance;
 		}
 	}
@@ -5018,28 +5792,28 @@ std::optional<int> FindPreferredExitTriggerIndex()
 	return bestIndex;
 }
 
-std::optional<int> FindNearestTriggerIndexWithMessage(int message)
+std::optional<int> FindPreferredExitTriggerIndex()
 {
 	if (numtrigs <= 0 || MyPlayer == nullptr)
 		return std::nullopt;
 
-	const Point playerPosition = MyPlayer->position.future;
-	std::optional<int> bestIndex;
-	int bestDistance = 0;
+	if (leveltype == DTYPE_TOWN) {
+		const std::optional<int> dungeonEntrance = FindNearestTriggerLandmark(*MyPlayer, [](const TriggerStruct &trigger) {
+			return IsAnyOf(trigger._tmsg, WM_DIABNEXTLVL, WM_DIABTOWNWARP);
+		});
+		if (dungeonEntrance)
+			return dungeonEntrance;
+	}
 
-	for (int i = 0; i < numtrigs; ++i) {
-		if (trigs[i]._tmsg != message)
-			continue;
+	return FindNearestTriggerLandmark(*MyPlayer, [](const TriggerStruct &) { return true; });
+}
 
-		const Point triggerPosition { trigs[i].position.x, trigs[i].position.y };
-		const int distance = playerPosition.WalkingDistance(triggerPosition);
-		if (!bestIndex || distance < bestDistance) {
-			bestIndex = i;
-			bestDistance = distance;
-		}
-	}
+std::optional<int> FindNearestTriggerIndexWithMessage(int message)
+{
+	if (numtrigs <= 0 || MyPlayer == nullptr)
+		return std::nullopt;
 
-	return bestIndex;
+	return FindNearestTriggerLandmark(*MyPlayer, [message](const TriggerStruct &trigger) { return trigger._tmsg == message; });
 }
 
 std::optional<Point> FindNearestTownPortalOnCurrentLevel()
@@ -5048,23 +5822,15 @@ std::optional<Point> FindNearestTownPortalOnCurrentLevel()
 		return std::nullopt;
 
 	const Point playerPosition = MyPlayer->position.future;
-	const int currentLevel = setlevel ? static_cast<int>(setlvlnum) : currlevel;
-
 	std::optional<Point> bestPosition;
 	int bestDistance = 0;
 
-	for (int i = 0; i < MAXPORTAL; ++i) {
-		const Portal &portal = Portals[i];
-		if (!portal.open)
-			continue;
-		if (portal.setlvl != setlevel)
+	for (const std::optional<LevelLandmark> &portal : GetLevelLandmarks(*MyPlayer).portals) {
+		if (!portal)
 			continue;
-		if (portal.level != currentLevel)
-			continue;
-
-		const int distance = playerPosition.WalkingDistance(portal.position);
+		const int distance = LevelLandmarkDistance(*portal, playerPosition);
 		if (!bestPosition || distance < bestDistance) {
-			bestPosition = portal.position;
+			bestPosition = portal->position;
 			bestDistance = distance;
 		}
 	}
@@ -5172,32 +5938,138 @@ std::optional<QuestSetLevelEntrance> FindNearestQuestSetLevelEntranceOnCurrentLe
 
 	const Point playerPosition = MyPlayer->position.future;
 	std::optional<QuestSetLevelEntrance> best;
-	int bestDistance = 0;
 
-	for (const Quest &quest : Quests) {
-		if (quest._qslvl == SL_NONE)
+	for (const LevelLandmark &landmark : GetLevelLandmarks(*MyPlayer).landmarks) {
+		if (landmark.kind != LevelLandmarkKind::QuestEntrance)
 			continue;
+		const Quest &quest = Quests[landmark.index];
 		if (quest._qactive == QUEST_NOTAVAIL)
 			continue;
-		if (quest._qlevel != currlevel)
-			continue;
-		if (!InDungeonBounds(quest.position))
-			continue;
 
-		const int distance = playerPosition.WalkingDistance(quest.position);
-		if (!best || distance < bestDistance) {
+		const int distance = LevelLandmarkDistance(landmark, playerPosition);
+		if (!best || distance < best->distance) {
 			best = QuestSetLevelEntrance {
 				.questLevel = quest._qslvl,
-				.entrancePosition = quest.position,
+				.entrancePosition = landmark.position,
 				.distance = distance,
 			};
-			bestDistance = distance;
 		}
 	}
 
 	return best;
 }
 
+/** The rooms of a level are the transparency regions the level generator marks in dTransVal, 0 is outside any room. */
+using RoomId = int8_t;
+
+[[nodiscard]] RoomId RoomAt(Point position)
+{
+	if (!InDungeonBounds(position))
+		return 0;
+	return dTransVal[position.x][position.y];
+}
+
+/**
+ * @brief Calls `visitor` once for every room touching `position`.
+ *
+ * Doors and stairs usually sit in the walls between rooms, so they belong to all the rooms around
+ * them rather than to the room of their own tile.
+ */
+template <typename Visitor>
+void ForEachRoomAround(Point position, Visitor &&visitor)
+{
+	StaticVector<RoomId, 9> rooms;
+	for (int dy = -1; dy <= 1; ++dy) {
+		for (int dx = -1; dx <= 1; ++dx) {
+			const RoomId room = RoomAt(position + Displacement { dx, dy });
+			if (room != 0 && c_find(rooms, room) == rooms.end())
+				rooms.push_back(room);
+		}
+	}
+	for (const RoomId room : rooms)
+		visitor(room);
+}
+
+struct RoomContents {
+	int monsters = 0;
+	int items = 0;
+	int doors = 0;
+	int exits = 0;
+};
+
+/** @brief Counts what is in a room by walking the entity lists once, without scanning the level. */
+[[nodiscard]] RoomContents CountRoomContents(RoomId room)
+{
+	RoomContents contents;
+
+	for (size_t i = 0; i < ActiveMonsterCount; ++i) {
+		const Monster &monster = Monsters[ActiveMonsters[i]];
+		if (IsTrackedMonster(monster) && !monster.isPlayerMinion() && RoomAt(monster.position.future) == room)
+			contents.monsters++;
+	}
+
+	for (uint8_t i = 0; i < ActiveItemCount; ++i) {
+		const int itemId = ActiveItems[i];
+		if (IsTrackedGroundItem(itemId) && RoomAt(Items[itemId].position) == room)
+			contents.items++;
+	}
+
+	for (int i = 0; i < ActiveObjectCount; ++i) {
+		const Object &object = Objects[ActiveObjects[i]];
+		if (!object.isDoor())
+			continue;
+		ForEachRoomAround(object.position, [&](RoomId around) {
+			if (around == room)
+				contents.doors++;
+		});
+	}
+
+	for (int i = 0; i < numtrigs; ++i) {
+		ForEachRoomAround(trigs[i].position, [&](RoomId around) {
+			if (around == room)
+				contents.exits++;
+		});
+	}
+
+	return contents;
+}
+
+void DescribeRoomKeyPressed()
+{
+	if (!CanPlayerTakeAction() || MyPlayer == nullptr)
+		return;
+
+	const RoomId room = RoomAt(MyPlayer->position.future);
+	if (leveltype == DTYPE_TOWN || room == 0) {
+		SpeakText(_("Not in a room."), true);
+		return;
+	}
+
+	const RoomContents contents = CountRoomContents(room);
+	std::vector<std::string> parts;
+	if (contents.monsters > 0)
+		parts.push_back(fmt::format(fmt::runtime(ngettext("{:d} monster", "{:d} monsters", contents.monsters)), contents.monsters));
+	if (contents.items > 0)
+		parts.push_back(fmt::format(fmt::runtime(ngettext("{:d} item", "{:d} items", contents.items)), contents.items));
+	if (contents.doors > 0)
+		parts.push_back(fmt::format(fmt::runtime(ngettext("{:d} door", "{:d} doors", contents.doors)), contents.doors));
+	if (contents.exits > 0)
+		parts.push_back(fmt::format(fmt::runtime(ngettext("{:d} exit", "{:d} exits", contents.exits)), contents.exits));
+
+	if (parts.empty()) {
+		SpeakText(_("The room is empty."), true);
+		return;
+	}
+
+	std::string joined;
+	for (size_t i = 0; i < parts.size(); ++i) {
+		if (i != 0)
+			joined += ", ";
+		joined += parts[i];
+	}
+	SpeakText(fmt::format(fmt::runtime(_(/* TRANSLATORS: {:s} is a list like "2 monsters, 1 door". */ "In this room: {:s}.")), joined), true);
+}
+
 void SpeakNearestExitKeyPressed()
 {
 	if (!CanPlayerTakeAction())
@@ -5225,28 +6097,28 @@ void SpeakNearestExitKeyPressed()
 
 			const TriggerStruct &trigger = trigs[*triggerIndex];
 			const Point targetPosition { trigger.position.x, trigger.position.y };
-			const std::optional<std::vector<int8_t>> path = FindKeyboardWalkPathForSpeech(*MyPlayer, startPosition, targetPosition);
+			const std::optional<SpeechWalkPlan> path = PlanKeyboardWalkForSpeech(*MyPlayer, startPosition, targetPosition);
 			std::string message = TriggerLabelForSpeech(trigger);
 			if (!message.empty())
 				message.append(": ");
 			if (!path)
 				AppendDirectionalFallback(message, targetPosition - startPosition);
 			else
-				AppendKeyboardWalkPathForSpeech(message, *path);
+				AppendKeyboardWalkPlanForSpeech(message, *path);
 			SpeakText(message, true);
 			return;
 		}
 
 		if (const std::optional<QuestSetLevelEntrance> entrance = FindNearestQuestSetLevelEntranceOnCurrentLevel(); entrance) {
 			const Point targetPosition = entrance->entrancePosition;
-			const std::optional<std::vector<int8_t>> path = FindKeyboardWalkPathForSpeech(*MyPlayer, startPosition, targetPosition);
+			const std::optional<SpeechWalkPlan> path = PlanKeyboardWalkForSpeech(*MyPlayer, startPosition, targetPosition);
 
 			std::string message { _(QuestLevelNames[entrance->questLevel]) };
 			message.append(": ");
 			if (!path)
 				AppendDirectionalFallback(message, targetPosition - startPosition);
 			else
-				AppendKeyboardWalkPathForSpeech(message, *path);
+				AppendKeyboardWalkPlanForSpeech(message, *path);
 			SpeakText(message, true);
 			return;
 		}
@@ -5289,14 +6161,14 @@ void SpeakNearestExitKeyPressed()
 		const TriggerStruct &trigger = trigs[triggerIndex];
 		const Point targetPosition { trigger.position.x, trigger.position.y };
 
-		const std::optional<std::vector<int8_t>> path = FindKeyboardWalkPathForSpeech(*MyPlayer, startPosition, targetPosition);
+		const std::optional<SpeechWalkPlan> path = PlanKeyboardWalkForSpeech(*MyPlayer, startPosition, targetPosition);
 		std::string message = TriggerLabelForSpeech(trigger);
 		if (!message.empty())
 			message.append(": ");
 		if (!path)
 			AppendDirectionalFallback(message, targetPosition - startPosition);
 		else
-			AppendKeyboardWalkPathForSpeech(message, *path);
+			AppendKeyboardWalkPlanForSpeech(message, *path);
 
 		SpeakText(message, true);
 		return;
@@ -5304,13 +6176,13 @@ void SpeakNearestExitKeyPressed()
 
 	if (leveltype != DTYPE_TOWN) {
 		if (const std::optional<Point> portalPosition = FindNearestTownPortalOnCurrentLevel(); portalPosition) {
-			const std::optional<std::vector<int8_t>> path = FindKeyboardWalkPathForSpeech(*MyPlayer, startPosition, *portalPosition);
+			const std::optional<SpeechWalkPlan> path = PlanKeyboardWalkForSpeech(*MyPlayer, startPosition, *portalPosition);
 			std::string message { _("Return to town") };
 			message.append(": ");
 			if (!path)
 				AppendDirectionalFallback(message, *portalPosition - startPosition);
 			else
-				AppendKeyboardWalkPathForSpeech(message, *path);
+				AppendKeyboardWalkPlanForSpeech(message, *path);
 			SpeakText(message, true);
 			return;
 		}
@@ -5323,14 +6195,14 @@ void SpeakNearestExitKeyPressed()
 
 		const TriggerStruct &trigger = trigs[*triggerIndex];
 		const Point targetPosition { trigger.position.x, trigger.position.y };
-		const std::optional<std::vector<int8_t>> path = FindKeyboardWalkPathForSpeech(*MyPlayer, startPosition, targetPosition);
+		const std::optional<SpeechWalkPlan> path = PlanKeyboardWalkForSpeech(*MyPlayer, startPosition, targetPosition);
 		std::string message = TriggerLabelForSpeech(trigger);
 		if (!message.empty())
 			message.append(": ");
 		if (!path)
 			AppendDirectionalFallback(message, targetPosition - startPosition);
 		else
-			AppendKeyboardWalkPathForSpeech(message, *path);
+			AppendKeyboardWalkPlanForSpeech(message, *path);
 		SpeakText(message, true);
 		return;
 	}
@@ -5344,14 +6216,14 @@ void SpeakNearestExitKeyPressed()
 	const TriggerStruct &trigger = trigs[*triggerIndex];
 	const Point targetPosition { trigger.position.x, trigger.position.y };
 
-	const std::optional<std::vector<int8_t>> path = FindKeyboardWalkPathForSpeech(*MyPlayer, startPosition, targetPosition);
+	const std::optional<SpeechWalkPlan> path = PlanKeyboardWalkForSpeech(*MyPlayer, startPosition, targetPosition);
 	std::string message = TriggerLabelForSpeech(trigger);
 	if (!message.empty())
 		message.append(": ");
 	if (!path)
 		AppendDirectionalFallback(message, targetPosition - startPosition);
 	else
-		AppendKeyboardWalkPathForSpeech(message, *path);
+		AppendKeyboardWalkPlanForSpeech(message, *path);
 
 	SpeakText(message, true);
 }
@@ -5380,14 +6252,14 @@ void SpeakNearestTownPortalInTownKeyPressed()
 	const Point startPosition = MyPlayer->position.future;
 	const Point targetPosition = portal->position;
 
-	const std::optional<std::vector<int8_t>> path = FindKeyboardWalkPathForSpeech(*MyPlayer, startPosition, targetPosition);
+	const std::optional<SpeechWalkPlan> path = PlanKeyboardWalkForSpeech(*MyPlayer, startPosition, targetPosition);
 
 	std::string message = TownPortalLabelForSpeech(Portals[portal->portalIndex]);
 	message.append(": ");
 	if (!path)
 		AppendDirectionalFallback(message, targetPosition - startPosition);
 	else
-		AppendKeyboardWalkPathForSpeech(message, *path);
+		AppendKeyboardWalkPlanForSpeech(message, *path);
 
 	SpeakText(message, true);
 }
@@ -5418,11 +6290,11 @@ void SpeakNearestStairsKeyPressed(int triggerMessage)
 	const Point targetPosition { trigger.position.x, trigger.position.y };
 
 	std::string message;
-	const std::optional<std::vector<int8_t>> path = FindKeyboardWalkPathForSpeech(*MyPlayer, startPosition, targetPosition);
+	const std::optional<SpeechWalkPlan> path = PlanKeyboardWalkForSpeech(*MyPlayer, startPosition, targetPosition);
 	if (!path) {
 		AppendDirectionalFallback(message, targetPosition - startPosition);
 	} else {
-		AppendKeyboardWalkPathForSpeech(message, *path);
+		AppendKeyboardWalkPlanForSpeech(message, *path);
 	}
 
 	SpeakText(message, true);
@@ -5458,6 +6330,32 @@ bool IsKeyboardWalkAllowed()
 	    && !qtextflag;
 }
 
+/** The direction of the walk key being held down, so the walk goes on without waiting for the key repeat. */
+std::optional<Direction> HeldKeyboardWalkDirection;
+
+void RepeatKeyboardWalk()
+{
+	if (!HeldKeyboardWalkDirection)
+		return;
+	if (!IsKeyboardWalkAllowed() || MyPlayer == nullptr) {
+		HeldKeyboardWalkDirection = std::nullopt;
+		return;
+	}
+
+	Player &myPlayer = *MyPlayer;
+	if (myPlayer.destAction != ACTION_NONE)
+		return;
+	// Same as the mouse walk in track.cpp: ask for the next step while the current one is still
+	// being animated, so the command has gone through by the time the step ends.
+	if (myPlayer._pmode != PM_STAND && (!myPlayer.isWalking() || myPlayer.AnimInfo.getFrameToUseForRendering() <= 6))
+		return;
+
+	const Point target = myPlayer.position.future + *HeldKeyboardWalkDirection;
+	if (myPlayer.GetTargetPosition() == target)
+		return;
+	NetSendCmdLoc(MyPlayerId, true, CMD_WALKXY, target);
+}
+
 void KeyboardWalkKeyPressed(Direction direction)
 {
 	CancelAutoWalk();
@@ -5467,29 +6365,56 @@ void KeyboardWalkKeyPressed(Direction direction)
 	if (MyPlayer == nullptr)
 		return;
 
+	HeldKeyboardWalkDirection = direction;
 	NetSendCmdLoc(MyPlayerId, true, CMD_WALKXY, MyPlayer->position.future + direction);
 }
 
+void KeyboardWalkKeyReleased(Direction direction)
+{
+	if (HeldKeyboardWalkDirection == direction)
+		HeldKeyboardWalkDirection = std::nullopt;
+}
+
 void KeyboardWalkNorthKeyPressed()
 {
 	KeyboardWalkKeyPressed(Direction::NorthEast);
 }
 
+void KeyboardWalkNorthKeyReleased()
+{
+	KeyboardWalkKeyReleased(Direction::NorthEast);
+}
+
 void KeyboardWalkSouthKeyPressed()
 {
 	KeyboardWalkKeyPressed(Direction::SouthWest);
 }
 
+void KeyboardWalkSouthKeyReleased()
+{
+	KeyboardWalkKeyReleased(Direction::SouthWest);
+}
+
 void KeyboardWalkEastKeyPressed()
 {
 	KeyboardWalkKeyPressed(Direction::SouthEast);
 }
 
+void KeyboardWalkEastKeyReleased()
+{
+	KeyboardWalkKeyReleased(Direction::SouthEast);
+}
+
 void KeyboardWalkWestKeyPressed()
 {
 	KeyboardWalkKeyPressed(Direction::NorthWest);
 }
 
+void KeyboardWalkWestKeyReleased()
+{
+	KeyboardWalkKeyReleased(Direction::NorthWest);
+}
+
 void SpeakNearestUnexploredTileKeyPressed()
 {
 	if (!CanPlayerTakeAction())
@@ -5506,12 +6431,12 @@ void SpeakNearestUnexploredTileKeyPressed()
 		return;
 
 	const Point startPosition = MyPlayer->position.future;
-	const std::optional<Point> target = FindNearestUnexploredTile(startPosition);
+	const std::optional<Point> target = FindNearestUnexploredTile(*MyPlayer, startPosition);
 	if (!target) {
 		SpeakText(_("No unexplored areas found."), true);
 		return;
 	}
-	const std::optional<std::vector<int8_t>> path = FindKeyboardWalkPathForSpeech(*MyPlayer, startPosition, *target);
+	const std::optional<WalkPath> path = FindKeyboardWalkPathForSpeech(*MyPlayer, startPosition, *target);
 	std::string message;
 	if (!path)
 		AppendDirectionalFallback(message, *target - startPosition);
@@ -5803,6 +6728,7 @@ void OptionLanguageCodeChanged()
 {
 	UnloadFonts();
 	LanguageInitialize();
+	ClearAnnouncementFormats();
 	LoadLanguageArchive();
 	effects_cleanup_sfx(false);
 	if (gbRunGame)
@@ -5817,10 +6743,49 @@ void CancelAutoWalkInternal()
 {
 	AutoWalkTrackerTargetId = -1;
 	AutoWalkTownNpcTarget = -1;
+	AutoWalkPathTicket = 0;
+	ClearItemTour();
+	CancelPathJobs();
 }
 
 } // namespace
 
+const AccessibilityStageTiming &GetAccessibilityStageTiming()
+{
+	return AccessibilityTiming;
+}
+
+void ResetAccessibilityStageTiming()
+{
+	AccessibilityTiming = {};
+}
+
+namespace accessibility_queries {
+
+std::optional<WalkPath> FindKeyboardWalkPathForSpeech(const Player &player, Point startPosition, Point destinationPosition)
+{
+	return devilution::FindKeyboardWalkPathForSpeech(player, startPosition, destinationPosition);
+}
+
+std::optional<Point> FindNearestUnexploredTile(const Player &player, Point startPosition)
+{
+	return devilution::FindNearestUnexploredTile(player, startPosition);
+}
+
+size_t CollectNearbyTrackerCandidates(Point playerPosition, int maxDistance)
+{
+	return CollectNearbyItemTrackerCandidates(playerPosition, maxDistance).size()
+	    + CollectNearbyChestTrackerCandidates(playerPosition, maxDistance).size()
+	    + CollectNearbyDoorTrackerCandidates(playerPosition, maxDistance).size()
+	    + CollectNearbyShrineTrackerCandidates(playerPosition, maxDistance).size()
+	    + CollectNearbyBreakableTrackerCandidates(playerPosition, maxDistance).size()
+	    + CollectNearbyObjectInteractableTrackerCandidates(playerPosition, maxDistance).size()
+	    + CollectNearbyMonsterTrackerCandidates(playerPosition, maxDistance).size()
+	    + CollectNearbyCorpseTrackerCandidates(playerPosition, maxDistance).size();
+}
+
+} // namespace accessibility_queries
+
 void CancelAutoWalk()
 {
 	CancelAutoWalkInternal();
@@ -6026,6 +6991,14 @@ void InitKeymapActions()
 	    SpeakNearestExitKeyPressed,
 	    nullptr,
 	    CanPlayerTakeAction);
+	options.Keymapper.AddAction(
+	    "DescribeRoom",
+	    N_("Describe room"),
+	    N_("Speaks how many monsters, items, doors and exits are in the room you are standing in."),
+	    SDLK_UNKNOWN,
+	    DescribeRoomKeyPressed,
+	    nullptr,
+	    []() { return CanPlayerTakeAction() && leveltype != DTYPE_TOWN; });
 	options.Keymapper.AddAction(
 	    "SpeakNearestStairsDown",
 	    N_("Nearest stairs down"),
@@ -6061,7 +7034,7 @@ void InitKeymapActions()
 	options.Keymapper.AddAction(
 	    "AutoWalkToTrackerTarget",
 	    N_("Walk to tracker target"),
-	    N_("Automatically walks to the currently selected tracker target. Press again to cancel."),
+	    N_("Automatically walks to the currently selected tracker target. Press again to cancel. Shift+M: walk to all nearby items one after the other."),
 	    'M',
 	    AutoWalkToTrackerTargetKeyPressed,
 	    nullptr,
@@ -6071,25 +7044,29 @@ void InitKeymapActions()
 	    N_("Walk north"),
 	    N_("Walk north (one tile)."),
 	    SDLK_UP,
-	    KeyboardWalkNorthKeyPressed);
+	    KeyboardWalkNorthKeyPressed,
+	    KeyboardWalkNorthKeyReleased);
 	options.Keymapper.AddAction(
 	    "KeyboardWalkSouth",
 	    N_("Walk south"),
 	    N_("Walk south (one tile)."),
 	    SDLK_DOWN,
-	    KeyboardWalkSouthKeyPressed);
+	    KeyboardWalkSouthKeyPressed,
+	    KeyboardWalkSouthKeyReleased);
 	options.Keymapper.AddAction(
 	    "KeyboardWalkEast",
 	    N_("Walk east"),
 	    N_("Walk east (one tile)."),
 	    SDLK_RIGHT,
-	    KeyboardWalkEastKeyPressed);
+	    KeyboardWalkEastKeyPressed,
+	    KeyboardWalkEastKeyReleased);
 	options.Keymapper.AddAction(
 	    "KeyboardWalkWest",
 	    N_("Walk west"),
 	    N_("Walk west (one tile)."),
 	    SDLK_LEFT,
-	    KeyboardWalkWestKeyPressed);
+	    KeyboardWalkWestKeyPressed,
+	    KeyboardWalkWestKeyReleased);
 	options.Keymapper.AddAction(
 	    "PrimaryAction",
 	    N_("Primary action"),
@@ -6260,6 +7237,13 @@ void InitKeymapActions()
 	    SDLK_PRINTSCREEN,
 	    nullptr,
 	    CaptureScreen);
+	options.Keymapper.AddAction(
+	    "FrameCapture",
+	    N_("Frame capture"),
+	    N_("Writes the frames of the last seconds and their timings, see the Frame Capture option."),
+	    SDLK_UNKNOWN,
+	    nullptr,
+	    CaptureFrames);
 	options.Keymapper.AddAction(
 	    "GameInfo",
 	    N_("Game info"),
@@ -6835,7 +7819,7 @@ void SetCursorPos(Point position)
 
 void FreeGameMem()
 {
-	pDungeonCels = nullptr;
+	StashDungeonCels();
 	pMegaTiles = nullptr;
 	pSpecialCels = std::nullopt;
 
@@ -6848,6 +7832,7 @@ void FreeGameMem()
 	DeactivateVirtualGamepad();
 	FreeVirtualGamepadGFX();
 #endif
+	LevelMemory.Release();
 }
 
 bool StartGame(bool bNewGame, bool bSinglePlayer)
@@ -6899,6 +7884,7 @@ bool StartGame(bool bNewGame, bool bSinglePlayer)
 
 void diablo_quit(int exitStatus)
 {
+	demo::FlushRecording();
 	FreeGameMem();
 	music_stop();
 	DiabloDeinit();
@@ -6921,6 +7907,7 @@ void setOnInitialized(void (*callback)())
 
 int DiabloMain(int argc, char **argv)
 {
+	BeginStartupTiming();
 #ifdef _DEBUG
 	SDL_SetLogPriorities(SDL_LOG_PRIORITY_DEBUG);
 #endif
@@ -6930,43 +7917,43 @@ int DiabloMain(int argc, char **argv)
 	InitPadmapActions();
 
 	// Need to ensure devilutionx.mpq (and fonts.mpq if available) are loaded before attempting to read translation settings
-	LoadCoreArchives();
+	RunStartupPhase("LoadCoreArchives", LoadCoreArchives);
 	was_archives_init = true;
 
 	// Read settings including translation next. This will use the presence of fonts.mpq and look for assets in devilutionx.mpq
-	LoadOptions();
+	RunStartupPhase("LoadOptions", LoadOptions);
 	if (demo::IsRunning()) demo::OverrideOptions();
 
 	// Then look for a voice pack file based on the selected translation
-	LoadLanguageArchive();
+	RunStartupPhase("LoadLanguageArchive", LoadLanguageArchive);
 
-	ApplicationInit();
-	LuaInitialize();
+	RunStartupPhase("ApplicationInit", ApplicationInit);
+	RunStartupPhase("LuaInitialize", LuaInitialize);
 	if (!demo::IsRunning()) SaveOptions();
 
 	// Finally load game data
-	LoadGameArchives();
+	RunStartupPhase("LoadGameArchives", LoadGameArchives);
 
-	LoadTextData();
+	RunStartupPhase("LoadTextData", LoadTextData);
 
 	// Load dynamic data before we go into the menu as we need to initialise player characters in memory pretty early.
-	LoadPlayerDataFiles();
+	RunStartupPhase("LoadPlayerDataFiles", LoadPlayerDataFiles);
 
 	// TODO: We can probably load this much later (when the game is starting).
-	LoadSpellData();
-	LoadMissileData();
-	LoadMonsterData();
-	LoadItemData();
-	LoadObjectData();
-	LoadQuestData();
-
-	DiabloInit();
+	RunStartupPhase("LoadSpellData", LoadSpellData);
+	RunStartupPhase("LoadMissileData", LoadMissileData);
+	RunStartupPhase("LoadMonsterData", LoadMonsterData);
+	RunStartupPhase("LoadItemData", LoadItemData);
+	RunStartupPhase("LoadObjectData", LoadObjectData);
+	RunStartupPhase("LoadQuestData", LoadQuestData);
+
+	RunStartupPhase("DiabloInit", DiabloInit);
 #ifdef __UWP__
 	onInitialized();
 #endif
 	if (!demo::IsRunning()) SaveOptions();
 
-	DiabloSplash();
+	RunStartupPhase("DiabloSplash", DiabloSplash);
 	mainmenu_loop();
 	DiabloDeinit();
 
@@ -7554,13 +8541,16 @@ void LoadGameLevelCalculateCursor()
 
 tl::expected<void, std::string> LoadGameLevel(bool firstflag, lvl_entry lvldir)
 {
+	DVL_TRACE_ZONE("LoadGameLevel");
 	const _music_id neededTrack = GetLevelMusic(leveltype);
 
 	ClearFloatingNumbers();
 	LoadGameLevelStopMusic(neededTrack);
+	PrefetchCueSounds();
 	LoadGameLevelResetCursor();
 	SetRndSeedForDungeonLevel();
 	NaKrulTomeSequence = 0;
+	ObjectWalkabilityGeneration++;
 
 	IncProgress();
 
@@ -7570,8 +8560,10 @@ tl::expected<void, std::string> LoadGameLevel(bool firstflag, lvl_entry lvldir)
 
 	IncProgress();
 
+	const bool dungeonCelsKept = RestoreDungeonCels();
 	RETURN_IF_ERROR(LoadLvlGFX());
-	SetDungeonMicros(pDungeonCels, MicroTileLen);
+	if (!dungeonCelsKept)
+		SetDungeonMicros(pDungeonCels, MicroTileLen);
 	ClearClxDrawCache();
 
 	IncProgress();
@@ -7610,6 +8602,7 @@ tl::expected<void, std::string> LoadGameLevel(bool firstflag, lvl_entry lvldir)
 
 	SyncPortals();
 	LoadGameLevelSyncPlayerEntry(lvldir);
+	BuildLevelLandmarks(myPlayer);
 
 	IncProgress();
 	IncProgress();
@@ -7635,6 +8628,7 @@ tl::expected<void, std::string> LoadGameLevel(bool firstflag, lvl_entry lvldir)
 	LoadGameLevelStartMusic(neededTrack);
 
 	CompleteProgress();
+	PrefetchAdjacentLevelFiles();
 
 	LoadGameLevelCalculateCursor();
 	if (leveltype != DTYPE_TOWN)
@@ -7653,6 +8647,8 @@ bool game_loop(bool bStartup)
 		}
 		TimeoutCursor(false);
 		GameLogic();
+		// Commands the single player sends during the tick are parsed right after it instead of at the start of the next one.
+		ProcessLocalCommands();
 		ClearLastSentPlayerCmd();
 
 		if (!gbRunGame || !gbIsMultiplayer || demo::IsRunning() || demo::IsRecording() || !nthread_has_500ms_passed())
@@ -104,6 +104,15 @@ bool IsDiabloAlive(bool playSFX);
 void PrintScreen(SDL_Keycode vkey);
 void CancelAutoWalk();
 
+/** @brief How long the per-tick accessibility announcements took. */
+struct AccessibilityStageTiming {
+	uint32_t lastTickMicroseconds = 0;
+	uint32_t maxTickMicroseconds = 0;
+};
+
+const AccessibilityStageTiming &GetAccessibilityStageTiming();
+void ResetAccessibilityStageTiming();
+
 /**
  * @param bStartup Process additional ticks before returning
  */
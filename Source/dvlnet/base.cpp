@@ -13,6 +13,7 @@
 
 #include <expected.hpp>
 
+#include "engine/net_stats.hpp"
 #include "player.h"
 
 namespace devilution {
@@ -208,6 +209,7 @@ bool base::IsConnected(plr_t player) const
 
 tl::expected<void, PacketError> base::RecvLocal(packet &pkt)
 {
+	CountNetPacket(NetDirection::Received, pkt.Type(), pkt.Data().size());
 	if (pkt.Source() < MAX_PLRS) {
 		if (tl::expected<void, PacketError> result = Connect(pkt.Source());
 		    !result.has_value()) {
@@ -15,6 +15,7 @@
 
 #include "dvlnet/base.h"
 #include "dvlnet/packet.h"
+#include "engine/net_stats.hpp"
 #include "player.h"
 #include "utils/algorithm/container.hpp"
 #include "utils/is_of.hpp"
@@ -255,6 +256,7 @@ tl::expected<void, PacketError> base_protocol<P>::InitiateHandshake(plr_t player
 template <class P>
 tl::expected<void, PacketError> base_protocol<P>::send(packet &pkt)
 {
+	CountNetPacket(NetDirection::Sent, pkt.Type(), pkt.Data().size());
 	plr_t destination = pkt.Destination();
 	if (destination == PLR_BROADCAST) {
 		for (plr_t player = 0; player < Players.size(); player++) {
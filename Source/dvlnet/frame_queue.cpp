@@ -1,5 +1,6 @@
 #include "dvlnet/frame_queue.h"
 
+#include <cstddef>
 #include <cstring>
 
 #include "appfat.h"
@@ -20,40 +21,21 @@ PacketError FrameQueueError()
 
 } // namespace
 
-framesize_t frame_queue::Size() const
+size_t frame_queue::Size() const
 {
-	return current_size;
+	return buffer.size() - read_pos;
 }
 
-tl::expected<buffer_t, PacketError> frame_queue::Read(framesize_t s)
+void frame_queue::Write(std::span<const unsigned char> data)
 {
-	if (current_size < s)
-		return tl::make_unexpected(FrameQueueError());
-	buffer_t ret;
-	while (s > 0 && s >= buffer_deque.front().size()) {
-		const framesize_t bufferSize = static_cast<framesize_t>(buffer_deque.front().size());
-		s -= bufferSize;
-		current_size -= bufferSize;
-		ret.insert(ret.end(),
-		    buffer_deque.front().begin(),
-		    buffer_deque.front().end());
-		buffer_deque.pop_front();
-	}
-	if (s > 0) {
-		ret.insert(ret.end(),
-		    buffer_deque.front().begin(),
-		    buffer_deque.front().begin() + s);
-		buffer_deque.front().erase(buffer_deque.front().begin(),
-		    buffer_deque.front().begin() + s);
-		current_size -= s;
+	if (read_pos == buffer.size()) {
+		buffer.clear();
+		read_pos = 0;
+	} else if (read_pos >= buffer.size() / 2) {
+		buffer.erase(buffer.begin(), buffer.begin() + static_cast<std::ptrdiff_t>(read_pos));
+		read_pos = 0;
 	}
-	return ret;
-}
-
-void frame_queue::Write(buffer_t buf)
-{
-	current_size += static_cast<framesize_t>(buf.size());
-	buffer_deque.push_back(std::move(buf));
+	buffer.insert(buffer.end(), data.begin(), data.end());
 }
 
 tl::expected<bool, PacketError> frame_queue::PacketReady()
@@ -61,10 +43,8 @@ tl::expected<bool, PacketError> frame_queue::PacketReady()
 	if (nextsize == 0) {
 		if (Size() < sizeof(framesize_t))
 			return false;
-		tl::expected<buffer_t, PacketError> szbuf = Read(sizeof(framesize_t));
-		if (!szbuf.has_value())
-			return tl::make_unexpected(szbuf.error());
-		nextsize = LoadLE32(szbuf->data());
+		nextsize = LoadLE32(buffer.data() + read_pos);
+		read_pos += sizeof(framesize_t);
 		if (nextsize == 0)
 			return tl::make_unexpected(FrameQueueError());
 	}
@@ -82,17 +62,20 @@ tl::expected<buffer_t, PacketError> frame_queue::ReadPacket()
 	const framesize_t packetSize = nextsize & frame_size_mask;
 	if (nextsize == 0 || Size() < packetSize)
 		return tl::make_unexpected(FrameQueueError());
-	tl::expected<buffer_t, PacketError> ret = Read(packetSize);
+	const auto first = buffer.begin() + static_cast<std::ptrdiff_t>(read_pos);
+	buffer_t ret(first, first + packetSize);
+	read_pos += packetSize;
 	nextsize = 0;
 	return ret;
 }
 
 tl::expected<buffer_t, PacketError> frame_queue::MakeFrame(buffer_t packetbuf, uint16_t flags)
 {
-	buffer_t ret;
 	const framesize_t size = static_cast<framesize_t>(packetbuf.size());
 	if (size > max_frame_size)
 		return tl::make_unexpected("Buffer exceeds maximum frame size");
+	buffer_t ret;
+	ret.reserve(sizeof(size) + size);
 	static_assert(sizeof(size) == 4, "framesize_t is not 4 bytes");
 	unsigned char sizeBuf[4];
 	WriteLE32(sizeBuf, size | (static_cast<framesize_t>(flags) << 16));
@@ -1,8 +1,9 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
-#include <deque>
 #include <exception>
+#include <span>
 #include <vector>
 
 #include <expected.hpp>
@@ -21,18 +22,22 @@ public:
 	constexpr static framesize_t max_frame_size = 0xFFFF;
 
 private:
-	framesize_t current_size = 0;
-	std::deque<buffer_t> buffer_deque;
+	/**
+	 * Received bytes, read from read_pos onwards. Frame headers are parsed in place and the
+	 * consumed bytes are only dropped once they make up half the buffer, so a steady stream
+	 * of frames reuses the same allocation.
+	 */
+	buffer_t buffer;
+	size_t read_pos = 0;
 	framesize_t nextsize = 0;
 
-	framesize_t Size() const;
-	tl::expected<buffer_t, PacketError> Read(framesize_t s);
+	size_t Size() const;
 
 public:
 	tl::expected<bool, PacketError> PacketReady();
 	uint16_t ReadPacketFlags();
 	tl::expected<buffer_t, PacketError> ReadPacket();
-	void Write(buffer_t buf);
+	void Write(std::span<const unsigned char> data);
 
 	static tl::expected<buffer_t, PacketError> MakeFrame(buffer_t packetbuf, uint16_t flags = 0);
 };
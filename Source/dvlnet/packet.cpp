@@ -12,6 +12,7 @@
 
 #include <expected.hpp>
 
+#include "engine/net_stats.hpp"
 #include "utils/algorithm/container.hpp"
 #include "utils/str_cat.hpp"
 
@@ -205,14 +206,11 @@ tl::expected<void, PacketError> packet_in::Create(buffer_t buf)
 	if (buf.size() < sizeof(packet_type) + 2 * sizeof(plr_t))
 		return tl::make_unexpected(PacketError());
 
+	// TCP server implementation forwards the original data to clients.
+	// Parsing leaves decrypted_buffer intact, so Data() returns it as is
+	// instead of keeping a second copy in encrypted_buffer.
 	decrypted_buffer = std::move(buf);
 	have_decrypted = true;
-
-	// TCP server implementation forwards the original data to clients
-	// so although we are not decrypting anything,
-	// we save a copy in encrypted_buffer anyway
-	encrypted_buffer = decrypted_buffer;
-	have_encrypted = true;
 	return {};
 }
 
@@ -222,6 +220,7 @@ tl::expected<void, PacketError> packet_in::Decrypt(buffer_t buf)
 	assert(!have_encrypted && !have_decrypted);
 	encrypted_buffer = std::move(buf);
 	have_encrypted = true;
+	const ScopedNetCryptoTimer timer;
 
 	if (encrypted_buffer.size() < crypto_secretbox_NONCEBYTES
 	        + crypto_secretbox_MACBYTES
@@ -255,12 +254,12 @@ tl::expected<void, PacketError> packet_out::Encrypt()
 
 	if (have_encrypted)
 		return {};
+	const ScopedNetCryptoTimer timer;
 
 	auto lenCleartext = decrypted_buffer.size();
-	encrypted_buffer.insert(encrypted_buffer.begin(),
-	    crypto_secretbox_NONCEBYTES, 0);
-	encrypted_buffer.insert(encrypted_buffer.end(),
-	    crypto_secretbox_MACBYTES + lenCleartext, 0);
+	// Nonce, MAC and ciphertext in a single allocation
+	encrypted_buffer.resize(crypto_secretbox_NONCEBYTES
+	    + crypto_secretbox_MACBYTES + lenCleartext);
 	randombytes_buf(encrypted_buffer.data(), crypto_secretbox_NONCEBYTES);
 	const int status = crypto_secretbox_easy(
 	    encrypted_buffer.data() + crypto_secretbox_NONCEBYTES,
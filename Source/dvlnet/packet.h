@@ -1,6 +1,7 @@
 #pragma once
 
 #include <array>
+#include <cstddef>
 #include <cstdint>
 #include <cstring>
 #include <memory>
@@ -165,6 +166,8 @@ protected:
 	bool have_decrypted = false;
 	buffer_t encrypted_buffer;
 	buffer_t decrypted_buffer;
+	/** How far packet_in has parsed decrypted_buffer, which is left intact so Data() can still return it. */
+	size_t m_read = 0;
 
 public:
 	packet(const key_t &k)
@@ -263,8 +266,8 @@ tl::expected<void, PacketError> packet_proc<P>::process_data()
 
 inline tl::expected<void, PacketError> packet_in::process_element(buffer_t &x)
 {
-	x.insert(x.begin(), decrypted_buffer.begin(), decrypted_buffer.end());
-	decrypted_buffer.resize(0);
+	x.insert(x.begin(), decrypted_buffer.begin() + static_cast<std::ptrdiff_t>(m_read), decrypted_buffer.end());
+	m_read = decrypted_buffer.size();
 	return {};
 }
 
@@ -273,18 +276,18 @@ tl::expected<void, PacketError> packet_in::process_element(T &x)
 {
 	static_assert(std::is_integral<T>::value || std::is_enum<T>::value, "Unsupported T");
 	static_assert(sizeof(T) == 4 || sizeof(T) == 2 || sizeof(T) == 1, "Unsupported T");
-	if (decrypted_buffer.size() < sizeof(T)) {
+	if (decrypted_buffer.size() - m_read < sizeof(T)) {
 		return tl::make_unexpected(PacketError());
 	}
+	const unsigned char *data = decrypted_buffer.data() + m_read;
 	if (sizeof(T) == 4) {
-		x = static_cast<T>(LoadLE32(decrypted_buffer.data()));
+		x = static_cast<T>(LoadLE32(data));
 	} else if (sizeof(T) == 2) {
-		x = static_cast<T>(LoadLE16(decrypted_buffer.data()));
+		x = static_cast<T>(LoadLE16(data));
 	} else if (sizeof(T) == 1) {
-		std::memcpy(&x, decrypted_buffer.data(), sizeof(T));
+		std::memcpy(&x, data, sizeof(T));
 	}
-	decrypted_buffer.erase(decrypted_buffer.begin(),
-	    decrypted_buffer.begin() + sizeof(T));
+	m_read += sizeof(T);
 	return {};
 }
 
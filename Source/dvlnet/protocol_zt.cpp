@@ -1,5 +1,6 @@
 #include "dvlnet/protocol_zt.h"
 
+#include <iterator>
 #include <optional>
 #include <random>
 
@@ -167,6 +168,13 @@ tl::expected<bool, PacketError> protocol_zt::send_queued_peer(const endpoint &pe
 		std::copy(peer.addr.begin(), peer.addr.end(), in6.sin6_addr.s6_addr);
 		lwip_connect(state.fd, (const struct sockaddr *)&in6, sizeof(in6));
 	}
+	// The connection is a stream, so the frames queued since the last call can go through the stack in a single send.
+	if (state.send_queue.size() > 1) {
+		buffer_t &batch = state.send_queue.front();
+		for (auto it = std::next(state.send_queue.begin()); it != state.send_queue.end(); ++it)
+			batch.insert(batch.end(), it->begin(), it->end());
+		state.send_queue.erase(std::next(state.send_queue.begin()), state.send_queue.end());
+	}
 	while (!state.send_queue.empty()) {
 		auto len = state.send_queue.front().size();
 		auto r = lwip_send(state.fd, state.send_queue.front().data(), len, 0);
@@ -198,7 +206,7 @@ bool protocol_zt::recv_peer(const endpoint &peer)
 	while (true) {
 		auto len = lwip_recv(state.fd, buf, sizeof(buf), 0);
 		if (len >= 0) {
-			state.recv_queue.Write(buffer_t(buf, buf + len));
+			state.recv_queue.Write({ buf, static_cast<size_t>(len) });
 		} else {
 			return errno == EAGAIN || errno == EWOULDBLOCK;
 		}
@@ -235,17 +243,21 @@ bool protocol_zt::recv_from_peers()
 bool protocol_zt::recv_from_udp()
 {
 	unsigned char buf[PKTBUF_LEN];
-	struct sockaddr_in6 in6 {
-	};
-	socklen_t addrlen = sizeof(in6);
-	auto len = lwip_recvfrom(fd_udp, buf, sizeof(buf), 0, (struct sockaddr *)&in6, &addrlen);
-	if (len < 0)
-		return false;
-	buffer_t data(buf, buf + len);
-	endpoint ep;
-	std::copy(in6.sin6_addr.s6_addr, in6.sin6_addr.s6_addr + 16, ep.addr.begin());
-	oob_recv_queue.emplace_back(ep, std::move(data));
-	return true;
+	bool received = false;
+	// Drain everything that arrived since the last call instead of a single datagram per call.
+	while (true) {
+		struct sockaddr_in6 in6 {
+		};
+		socklen_t addrlen = sizeof(in6);
+		auto len = lwip_recvfrom(fd_udp, buf, sizeof(buf), 0, (struct sockaddr *)&in6, &addrlen);
+		if (len < 0)
+			return received;
+		buffer_t data(buf, buf + len);
+		endpoint ep;
+		std::copy(in6.sin6_addr.s6_addr, in6.sin6_addr.s6_addr + 16, ep.addr.begin());
+		oob_recv_queue.emplace_back(ep, std::move(data));
+		received = true;
+	}
 }
 
 bool protocol_zt::accept_all()
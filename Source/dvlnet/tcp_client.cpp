@@ -14,8 +14,10 @@
 #endif
 
 #include <asio/connect.hpp>
+#include <asio/post.hpp>
 #include <expected.hpp>
 
+#include "engine/net_stats.hpp"
 #include "options.h"
 #include "utils/language.h"
 #include "utils/str_cat.hpp"
@@ -26,6 +28,15 @@ namespace devilution::net {
 int tcp_client::create(std::string_view addrstr)
 {
 	auto port = *GetOptions().Network.port;
+#ifndef ASIO_DISABLE_THREADS
+	if (*GetOptions().Network.relayThread) {
+		// The server only forwards packets between the sockets it owns, so it can run
+		// without waiting on the game loop. The host joins it through localhost like anyone else.
+		local_server = std::make_unique<tcp_server>(serverIoc, std::string(addrstr), port, *pktfty);
+		serverThread = SdlThread { &tcp_client::RunServerThread, this };
+		return join(local_server->LocalhostSelf());
+	}
+#endif
 	local_server = std::make_unique<tcp_server>(ioc, std::string(addrstr), port, *pktfty);
 	return join(local_server->LocalhostSelf());
 }
@@ -142,6 +153,8 @@ tl::expected<void, PacketError> tcp_client::poll()
 		ioHandlerResult = std::nullopt;
 		return packetError;
 	}
+	if (serverThread.joinable())
+		return local_server->CheckIoHandlerError();
 	return {};
 }
 
@@ -157,9 +170,7 @@ void tcp_client::HandleReceive(const asio::error_code &error, size_t bytesRead)
 		RaiseIoHandlerError(packetError);
 		return;
 	}
-	recv_buffer.resize(bytesRead);
-	recv_queue.Write(std::move(recv_buffer));
-	recv_buffer.resize(frame_queue::max_frame_size);
+	recv_queue.Write({ recv_buffer.data(), bytesRead });
 	while (true) {
 		tl::expected<bool, PacketError> ready = recv_queue.PacketReady();
 		if (!ready.has_value()) {
@@ -220,6 +231,7 @@ void tcp_client::HandleTcpErrorCode()
 
 tl::expected<void, PacketError> tcp_client::send(packet &pkt)
 {
+	CountNetPacket(NetDirection::Sent, pkt.Type(), pkt.Data().size());
 	tl::expected<buffer_t, PacketError> frame = frame_queue::MakeFrame(pkt.Data());
 	if (!frame.has_value())
 		return tl::make_unexpected(frame.error());
@@ -234,7 +246,7 @@ tl::expected<void, PacketError> tcp_client::send(packet &pkt)
 void tcp_client::DisconnectNet(plr_t plr)
 {
 	if (local_server != nullptr)
-		local_server->DisconnectNet(plr);
+		CallLocalServer([this, plr]() { local_server->DisconnectNet(plr); });
 }
 
 bool tcp_client::SNetLeaveGame(net::leaveinfo_t type)
@@ -242,7 +254,7 @@ bool tcp_client::SNetLeaveGame(net::leaveinfo_t type)
 	auto ret = base::SNetLeaveGame(type);
 	process_network_packets();
 	if (local_server != nullptr)
-		local_server->Close();
+		CallLocalServer([this]() { local_server->Close(); });
 	sock.close();
 	return ret;
 }
@@ -257,7 +269,23 @@ void tcp_client::RaiseIoHandlerError(const PacketError &error)
 	ioHandlerResult.emplace(error);
 }
 
+int SDLCALL tcp_client::RunServerThread(void *self)
+{
+	static_cast<tcp_client *>(self)->serverIoc.run();
+	return 0;
+}
+
+void tcp_client::StopServerThread()
+{
+	if (!serverThread.joinable())
+		return;
+	serverIoc.stop();
+	serverThread.join();
+}
+
 tcp_client::~tcp_client()
-    = default;
+{
+	StopServerThread();
+}
 
 } // namespace devilution::net
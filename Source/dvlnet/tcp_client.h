@@ -2,6 +2,7 @@
 
 #include <memory>
 #include <string>
+#include <utility>
 
 // This header must be included before any 3DS code
 // because 3DS SDK defines a macro with the same name
@@ -22,6 +23,7 @@
 #include "dvlnet/frame_queue.h"
 #include "dvlnet/packet.h"
 #include "dvlnet/tcp_server.h"
+#include "utils/sdl_thread.h"
 
 namespace devilution::net {
 
@@ -50,7 +52,10 @@ private:
 	asio::io_context ioc;
 	asio::ip::tcp::resolver resolver = asio::ip::tcp::resolver(ioc);
 	asio::ip::tcp::socket sock = asio::ip::tcp::socket(ioc);
-	std::unique_ptr<tcp_server> local_server; // must be declared *after* ioc
+	/** Runs the local server's handlers when it relays on serverThread instead of the game thread. */
+	asio::io_context serverIoc;
+	std::unique_ptr<tcp_server> local_server; // must be declared *after* ioc and serverIoc
+	SdlThread serverThread;
 
 	std::optional<PacketError> ioHandlerResult;
 
@@ -60,6 +65,19 @@ private:
 	void HandleTcpErrorCode();
 
 	void RaiseIoHandlerError(const PacketError &error);
+
+	/** @brief Runs a call on the local server, from the thread that owns it. */
+	template <typename F>
+	void CallLocalServer(F &&f)
+	{
+		if (serverThread.joinable())
+			asio::post(serverIoc, std::forward<F>(f));
+		else
+			f();
+	}
+
+	static int SDLCALL RunServerThread(void *self);
+	void StopServerThread();
 };
 
 } // namespace devilution::net
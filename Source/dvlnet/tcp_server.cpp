@@ -3,6 +3,7 @@
 #include <chrono>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <utility>
 
 #include <expected.hpp>
@@ -74,9 +75,7 @@ void tcp_server::HandleReceive(const scc &con, const asio::error_code &ec,
 		DropConnection(con);
 		return;
 	}
-	con->recv_buffer.resize(bytesRead);
-	con->recv_queue.Write(std::move(con->recv_buffer));
-	con->recv_buffer.resize(frame_queue::max_frame_size);
+	con->recv_queue.Write({ con->recv_buffer.data(), bytesRead });
 	while (true) {
 		tl::expected<bool, PacketError> ready = con->recv_queue.PacketReady();
 		if (!ready.has_value()) {
@@ -291,11 +290,13 @@ void tcp_server::DropConnection(const scc &con)
 
 void tcp_server::RaiseIoHandlerError(const PacketError &error)
 {
+	const std::lock_guard<SdlMutex> lock(ioHandlerMutex);
 	ioHandlerResult.emplace(error);
 }
 
 tl::expected<void, PacketError> tcp_server::CheckIoHandlerError()
 {
+	const std::lock_guard<SdlMutex> lock(ioHandlerMutex);
 	if (ioHandlerResult == std::nullopt)
 		return {};
 	tl::expected<void, PacketError> packetError = tl::make_unexpected(*ioHandlerResult);
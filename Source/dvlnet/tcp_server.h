@@ -25,6 +25,7 @@
 #include "dvlnet/frame_queue.h"
 #include "dvlnet/packet.h"
 #include "multi.h"
+#include "utils/sdl_mutex.h"
 
 namespace devilution::net {
 
@@ -71,7 +72,9 @@ private:
 	std::array<scc, MAX_PLRS> connections;
 	buffer_t game_init_info;
 
+	// Raised on the relay thread when the server has one, see tcp_client::create.
 	std::optional<PacketError> ioHandlerResult;
+	SdlMutex ioHandlerMutex;
 
 	scc MakeConnection();
 	plr_t NextFree();
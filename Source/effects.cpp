@@ -14,10 +14,12 @@
 #include "data/file.hpp"
 #include "data/iterators.hpp"
 #include "data/record_reader.hpp"
+#include "engine/audio_stats.hpp"
 #include "engine/random.hpp"
 #include "engine/sound.h"
 #include "engine/sound_defs.hpp"
 #include "engine/sound_position.hpp"
+#include "engine/tracing.hpp"
 #include "game_mode.hpp"
 #include "player.h"
 #include "utils/is_of.hpp"
@@ -239,10 +241,13 @@ void sound_stop()
 
 void sound_update()
 {
+	DVL_TRACE_ZONE("sound_update");
 	if (!gbSndInited) {
 		return;
 	}
 
+	UpdateAudioStats();
+	const ScopedAudioStatsTimer timer(AudioStatsTimer::SoundUpdate);
 	StreamUpdate();
 }
 
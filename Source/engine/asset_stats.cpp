@@ -0,0 +1,211 @@
+/**
+ * @file asset_stats.cpp
+ *
+ * Implementation of the per-file counters that show where asset loading spends its time.
+ */
+#include "engine/asset_stats.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+#include <fmt/format.h>
+
+#include "utils/file_util.h"
+#include "utils/log.hpp"
+#include "utils/sdl_mutex.h"
+
+namespace devilution {
+
+namespace {
+
+/** The file number of loose files, which are told apart by name instead. */
+constexpr uint32_t LooseFile = UINT32_MAX;
+
+struct Counters {
+	std::string name;
+	uint32_t loads = 0;
+	uint64_t bytes = 0;
+	uint64_t decompressNanoseconds = 0;
+	uint64_t wallNanoseconds = 0;
+};
+
+std::atomic<bool> Enabled { false };
+std::string ReportPath;
+
+/** Only created once the counters are enabled, so nothing is allocated without the flag. */
+std::unique_ptr<SdlMutex> CountersMutex;
+/** Keyed by archive path and file number, or by name and LooseFile. */
+std::map<std::pair<std::string, uint32_t>, Counters> AllCounters;
+
+[[nodiscard]] uint64_t NanosecondsSince(std::chrono::steady_clock::time_point start)
+{
+	return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+}
+
+[[nodiscard]] std::string_view BaseName(std::string_view path)
+{
+	const size_t slash = path.find_last_of("/\\");
+	return slash == std::string_view::npos ? path : path.substr(slash + 1);
+}
+
+void AppendJsonString(std::string &out, std::string_view str)
+{
+	out += '"';
+	for (const char c : str) {
+		if (c == '"' || c == '\\') {
+			out += '\\';
+			out += c;
+		} else if (static_cast<unsigned char>(c) < 0x20) {
+			out += fmt::format("\\u{:04x}", static_cast<int>(c));
+		} else {
+			out += c;
+		}
+	}
+	out += '"';
+}
+
+} // namespace
+
+bool IsAssetStatsEnabled()
+{
+	return Enabled.load(std::memory_order_relaxed);
+}
+
+void EnableAssetStats(std::string reportPath)
+{
+	if (IsAssetStatsEnabled())
+		return;
+	ReportPath = std::move(reportPath);
+	CountersMutex = std::make_unique<SdlMutex>();
+	Enabled.store(true, std::memory_order_relaxed);
+}
+
+ScopedAssetLoadTimer::ScopedAssetLoadTimer(std::string_view name)
+    : name_(name)
+    , enabled_(IsAssetStatsEnabled())
+{
+	if (enabled_)
+		start_ = std::chrono::steady_clock::now();
+}
+
+void ScopedAssetLoadTimer::SetArchive(std::string_view archivePath, uint32_t fileNumber)
+{
+	archivePath_ = archivePath;
+	fileNumber_ = fileNumber;
+}
+
+ScopedAssetLoadTimer::~ScopedAssetLoadTimer()
+{
+	if (!enabled_)
+		return;
+	const uint64_t elapsed = NanosecondsSince(start_);
+	const std::lock_guard<SdlMutex> lock(*CountersMutex);
+	Counters &counters = archivePath_.empty()
+	    ? AllCounters[{ std::string(name_), LooseFile }]
+	    : AllCounters[{ std::string(archivePath_), fileNumber_ }];
+	if (counters.name.empty())
+		counters.name = name_;
+	counters.loads++;
+	counters.bytes += size_;
+	counters.wallNanoseconds += elapsed;
+}
+
+ScopedMpqDecompressTimer::ScopedMpqDecompressTimer(std::string_view archivePath, uint32_t fileNumber)
+    : archivePath_(archivePath)
+    , fileNumber_(fileNumber)
+    , enabled_(IsAssetStatsEnabled())
+{
+	if (enabled_)
+		start_ = std::chrono::steady_clock::now();
+}
+
+ScopedMpqDecompressTimer::~ScopedMpqDecompressTimer()
+{
+	if (!enabled_)
+		return;
+	const uint64_t elapsed = NanosecondsSince(start_);
+	const std::lock_guard<SdlMutex> lock(*CountersMutex);
+	AllCounters[{ std::string(archivePath_), fileNumber_ }].decompressNanoseconds += elapsed;
+}
+
+std::vector<AssetLoadStats> GetAssetLoadStats()
+{
+	std::vector<AssetLoadStats> result;
+	if (!IsAssetStatsEnabled())
+		return result;
+	{
+		const std::lock_guard<SdlMutex> lock(*CountersMutex);
+		result.reserve(AllCounters.size());
+		for (const auto &[key, counters] : AllCounters) {
+			const bool loose = key.second == LooseFile;
+			result.push_back(AssetLoadStats {
+			    // Files only read straight through MpqArchive are never named.
+			    .name = !counters.name.empty() ? counters.name : fmt::format("#{}", key.second),
+			    .archive = loose ? std::string() : std::string(BaseName(key.first)),
+			    .loads = counters.loads,
+			    .bytes = counters.bytes,
+			    .decompressMicroseconds = counters.decompressNanoseconds / 1000,
+			    .wallMicroseconds = counters.wallNanoseconds / 1000,
+			});
+		}
+	}
+	std::stable_sort(result.begin(), result.end(), [](const AssetLoadStats &a, const AssetLoadStats &b) {
+		return a.wallMicroseconds + a.decompressMicroseconds > b.wallMicroseconds + b.decompressMicroseconds;
+	});
+	return result;
+}
+
+std::string FormatAssetStatsCsv(const std::vector<AssetLoadStats> &stats)
+{
+	std::string out = "name,archive,loads,bytes,decompress_us,wall_us\n";
+	for (const AssetLoadStats &file : stats) {
+		out += fmt::format("{},{},{},{},{},{}\n", file.name, file.archive, file.loads, file.bytes, file.decompressMicroseconds, file.wallMicroseconds);
+	}
+	return out;
+}
+
+std::string FormatAssetStatsJson(const std::vector<AssetLoadStats> &stats)
+{
+	std::string out = "[";
+	for (const AssetLoadStats &file : stats) {
+		if (out.size() > 1)
+			out += ',';
+		out += "\n{\"name\":";
+		AppendJsonString(out, file.name);
+		out += ",\"archive\":";
+		AppendJsonString(out, file.archive);
+		out += fmt::format(R"(,"loads":{},"bytes":{},"decompressUs":{},"wallUs":{}}})", file.loads, file.bytes, file.decompressMicroseconds, file.wallMicroseconds);
+	}
+	out += "\n]\n";
+	return out;
+}
+
+void WriteAssetStatsReport()
+{
+	if (!IsAssetStatsEnabled())
+		return;
+
+	const std::vector<AssetLoadStats> stats = GetAssetLoadStats();
+	const std::string_view path = ReportPath;
+	const bool json = path.size() >= 5 && path.substr(path.size() - 5) == ".json";
+	const std::string report = json ? FormatAssetStatsJson(stats) : FormatAssetStatsCsv(stats);
+
+	FILE *file = OpenFile(ReportPath.c_str(), "wb");
+	if (file == nullptr) {
+		LogError("Failed to write the asset stats to {}", ReportPath);
+		return;
+	}
+	const bool written = std::fwrite(report.data(), report.size(), 1, file) == 1;
+	if (std::fclose(file) != 0 || !written) {
+		LogError("Failed to write the asset stats to {}", ReportPath);
+		return;
+	}
+	LogInfo("Wrote the load stats of {} asset files to {}", stats.size(), ReportPath);
+}
+
+} // namespace devilution
@@ -0,0 +1,101 @@
+/**
+ * @file asset_stats.hpp
+ *
+ * Interface of the per-file counters that show where asset loading spends its time.
+ */
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace devilution {
+
+/** Everything loaded from one file since the counters were enabled. */
+struct AssetLoadStats {
+	std::string name;
+	/** File name of the MPQ archive the asset came from, empty for loose files. */
+	std::string archive;
+	uint32_t loads = 0;
+	uint64_t bytes = 0;
+	/** Time spent in libmpq decompressing the file, including blocks streamed after opening it. */
+	uint64_t decompressMicroseconds = 0;
+	/** Time from looking the file up to having it loaded, or only opened for streamed assets. */
+	uint64_t wallMicroseconds = 0;
+};
+
+/** @brief Whether the counters are being collected, from the `--asset-stats` flag. Safe from any thread. */
+[[nodiscard]] bool IsAssetStatsEnabled();
+
+/**
+ * @brief Starts collecting the counters.
+ * @param reportPath Where WriteAssetStatsReport() writes them, as JSON if it ends in ".json" and as CSV otherwise
+ */
+void EnableAssetStats(std::string reportPath);
+
+/** @brief Records a load of an asset for the time until it goes out of scope, if the counters are collected. */
+class ScopedAssetLoadTimer {
+public:
+	explicit ScopedAssetLoadTimer(std::string_view name);
+	~ScopedAssetLoadTimer();
+
+	ScopedAssetLoadTimer(const ScopedAssetLoadTimer &) = delete;
+	ScopedAssetLoadTimer &operator=(const ScopedAssetLoadTimer &) = delete;
+
+	[[nodiscard]] bool enabled() const
+	{
+		return enabled_;
+	}
+
+	/** @brief Marks the asset as file `fileNumber` of an archive, for attributing decompression to it. */
+	void SetArchive(std::string_view archivePath, uint32_t fileNumber);
+
+	void SetSize(size_t size)
+	{
+		size_ = size;
+	}
+
+	/** @brief Drops the load, for assets that weren't found. */
+	void Cancel()
+	{
+		enabled_ = false;
+	}
+
+private:
+	std::string_view name_;
+	std::string_view archivePath_;
+	uint32_t fileNumber_ = 0;
+	size_t size_ = 0;
+	std::chrono::steady_clock::time_point start_;
+	bool enabled_;
+};
+
+/** @brief Adds the time until it goes out of scope to the decompression time of an archive's file. Safe from any thread. */
+class ScopedMpqDecompressTimer {
+public:
+	ScopedMpqDecompressTimer(std::string_view archivePath, uint32_t fileNumber);
+	~ScopedMpqDecompressTimer();
+
+	ScopedMpqDecompressTimer(const ScopedMpqDecompressTimer &) = delete;
+	ScopedMpqDecompressTimer &operator=(const ScopedMpqDecompressTimer &) = delete;
+
+private:
+	std::string_view archivePath_;
+	uint32_t fileNumber_;
+	std::chrono::steady_clock::time_point start_;
+	bool enabled_;
+};
+
+/** @brief The counters of every file loaded so far, slowest first. */
+[[nodiscard]] std::vector<AssetLoadStats> GetAssetLoadStats();
+
+[[nodiscard]] std::string FormatAssetStatsCsv(const std::vector<AssetLoadStats> &stats);
+[[nodiscard]] std::string FormatAssetStatsJson(const std::vector<AssetLoadStats> &stats);
+
+/** @brief Writes the report to the path given to EnableAssetStats(), call once on shutdown. */
+void WriteAssetStatsReport();
+
+} // namespace devilution
@@ -1,9 +1,14 @@
 #include "engine/assets.hpp"
 
 #include <algorithm>
+#include <array>
+#include <cstddef>
 #include <cstdint>
 #include <cstring>
 #include <functional>
+#include <optional>
+#include <span>
+#include <string>
 #include <vector>
 
 #ifdef USE_SDL3
@@ -13,7 +18,14 @@
 #include <SDL.h>
 #endif
 
+#ifndef UNPACKED_MPQS
+#include <ankerl/unordered_dense.h>
+#endif
+
 #include "appfat.h"
+#include "engine/asset_stats.hpp"
+#include "engine/render/render_workers.hpp"
+#include "engine/tracing.hpp"
 #include "game_mode.hpp"
 #include "utils/file_util.h"
 #include "utils/log.hpp"
@@ -65,10 +77,41 @@ SDL_IOStream *OpenOptionalRWops(const std::string &path)
 	return SDL_IOFromFile(path.c_str(), "rb");
 };
 
+struct MpqFileIndexEntry {
+	/** nullptr if the archive has the hashes more than once, its own lookup then decides which one is meant. */
+	MpqArchive *archive;
+	uint32_t fileNumber;
+};
+
+/**
+ * The files of all the loaded archives by the two hashes that tell their names apart, each from
+ * the archive with the highest priority that has it.
+ */
+ankerl::unordered_dense::map<uint64_t, MpqFileIndexEntry> MpqFileIndex;
+
+/** False while MpqArchives has changed since the index was built, or if an archive's table couldn't be read. */
+bool MpqFileIndexValid = false;
+
+uint64_t MpqFileIndexKey(uint32_t hashA, uint32_t hashB)
+{
+	return (static_cast<uint64_t>(hashA) << 32) | hashB;
+}
+
 bool FindMpqFile(std::string_view filename, MpqArchive **archive, uint32_t *fileNumber)
 {
 	const MpqFileHash fileHash = CalculateMpqFileHash(filename);
 
+	if (MpqFileIndexValid) {
+		const auto it = MpqFileIndex.find(MpqFileIndexKey(fileHash[1], fileHash[2]));
+		if (it == MpqFileIndex.end())
+			return false;
+		if (it->second.archive != nullptr) {
+			*archive = it->second.archive;
+			*fileNumber = it->second.fileNumber;
+			return true;
+		}
+	}
+
 	for (auto &[_, mpqArchive] : MpqArchives) {
 		if (mpqArchive.GetFileNumber(fileHash, *fileNumber)) {
 			*archive = &mpqArchive;
@@ -179,13 +222,29 @@ AssetRef FindAsset(std::string_view filename)
 }
 #endif
 
+void RecordAssetSource(ScopedAssetLoadTimer &timer, const AssetRef &ref)
+{
+	if (!timer.enabled())
+		return;
+#ifndef UNPACKED_MPQS
+	if (ref.archive != nullptr)
+		timer.SetArchive(ref.archive->path(), ref.fileNumber);
+#endif
+	timer.SetSize(ref.size());
+}
+
 AssetHandle OpenAsset(AssetRef &&ref, bool threadsafe)
 {
 #if UNPACKED_MPQS
 	return AssetHandle { OpenFile(ref.path, "rb") };
 #else
-	if (ref.archive != nullptr)
+	if (ref.archive != nullptr) {
+		// Files stored as is are read from the mapped archive without copying them.
+		const std::span<const std::byte> stored = ref.archive->GetStoredFileView(ref.fileNumber);
+		if (!stored.empty())
+			return AssetHandle { SDL_IOFromConstMem(stored.data(), static_cast<int>(stored.size())) };
 		return AssetHandle { SDL_RWops_FromMpqFile(*ref.archive, ref.fileNumber, ref.filename, threadsafe) };
+	}
 	if (ref.directHandle != nullptr) {
 		// Transfer handle ownership:
 		auto *handle = ref.directHandle;
@@ -198,18 +257,28 @@ AssetHandle OpenAsset(AssetRef &&ref, bool threadsafe)
 
 AssetHandle OpenAsset(std::string_view filename, bool threadsafe)
 {
+	DVL_TRACE_ZONE("OpenAsset");
+	ScopedAssetLoadTimer timer(filename);
 	AssetRef ref = FindAsset(filename);
-	if (!ref.ok())
+	if (!ref.ok()) {
+		timer.Cancel();
 		return AssetHandle {};
+	}
+	RecordAssetSource(timer, ref);
 	return OpenAsset(std::move(ref), threadsafe);
 }
 
 AssetHandle OpenAsset(std::string_view filename, size_t &fileSize, bool threadsafe)
 {
+	DVL_TRACE_ZONE("OpenAsset");
+	ScopedAssetLoadTimer timer(filename);
 	AssetRef ref = FindAsset(filename);
-	if (!ref.ok())
+	if (!ref.ok()) {
+		timer.Cancel();
 		return AssetHandle {};
+	}
 	fileSize = ref.size();
+	RecordAssetSource(timer, ref);
 	return OpenAsset(std::move(ref), threadsafe);
 }
 
@@ -227,14 +296,29 @@ SDL_IOStream *OpenAssetAsSdlRwOps(std::string_view filename, bool threadsafe)
 
 tl::expected<AssetData, std::string> LoadAsset(std::string_view path)
 {
+	DVL_TRACE_ZONE("LoadAsset");
+	ScopedAssetLoadTimer timer(path);
 	AssetRef ref = FindAsset(path);
 	if (!ref.ok()) {
+		timer.Cancel();
 		return tl::make_unexpected(StrCat("Asset not found: ", path));
 	}
+	RecordAssetSource(timer, ref);
 
 	const size_t size = ref.size();
 	std::unique_ptr<char[]> data { new char[size] };
 
+#ifndef UNPACKED_MPQS
+	if (ref.archive != nullptr) {
+		// Decompress straight into the result instead of going through a stream's block buffer.
+		const int32_t error = ref.archive->ReadFile(ref.fileNumber, ref.filename, reinterpret_cast<std::byte *>(data.get()), size);
+		if (error != 0) {
+			return tl::make_unexpected(StrCat("Read failed: ", path, "\n", MpqArchive::ErrorMessage(error)));
+		}
+		return AssetData { std::move(data), size };
+	}
+#endif
+
 	AssetHandle handle = OpenAsset(std::move(ref));
 	if (!handle.ok()) {
 		return tl::make_unexpected(StrCat("Failed to open asset: ", path, "\n", handle.error()));
@@ -299,31 +383,99 @@ bool FindMPQ(std::span<const std::string> paths, std::string_view mpqName)
 	return false;
 }
 
-bool LoadMPQ(std::span<const std::string> paths, std::string_view mpqName, int priority, std::string_view ext = ".mpq")
-{
+/**
+ * The search path each archive was last opened from, by file name.
+ *
+ * Tried first when the archive is opened again, e.g. after switching between Diablo and Hellfire
+ * or changing the language, so only the first load probes every search path.
+ */
+ankerl::unordered_dense::map<std::string, std::string> MpqSearchPathCache;
+
+struct MpqToLoad {
+	std::string_view name;
+	int priority;
+	std::string_view ext = ".mpq";
+	/** Set once the archive is mounted. */
+	bool loaded = false;
+};
+
+struct OpenedMpq {
 	std::optional<MpqArchive> archive;
+	/** The search path the archive was found in, one of the `paths` passed to OpenMPQ(). */
+	std::string_view foundIn;
+};
+
+/** @brief Opens the first archive called `mpqName` in the search paths. Safe to call from several threads at once. */
+OpenedMpq OpenMPQ(std::span<const std::string> paths, std::string_view mpqName, std::string_view ext)
+{
+	OpenedMpq result;
 	std::string mpqAbsPath;
 	std::int32_t error = 0;
-	for (const auto &path : paths) {
+	const auto tryPath = [&](const std::string &path) {
 		mpqAbsPath = StrCat(path, mpqName, ext);
-		archive = MpqArchive::Open(mpqAbsPath.c_str(), error);
-		if (archive.has_value()) {
+		result.archive = MpqArchive::Open(mpqAbsPath.c_str(), error);
+		if (result.archive.has_value()) {
 			LogVerbose("  Found: {} in {}", mpqName, path);
-			auto [it, inserted] = MpqArchives.emplace(priority, *std::move(archive));
-			if (!inserted) {
-				LogError("MPQ with priority {} is already registered, skipping {}", priority, mpqName);
-			}
+			result.foundIn = path;
 			return true;
 		}
 		if (error != 0) {
 			LogError("Error {}: {}", MpqArchive::ErrorMessage(error), mpqAbsPath);
 		}
+		return false;
+	};
+
+	const std::string *cachedPath = nullptr;
+	if (const auto it = MpqSearchPathCache.find(StrCat(mpqName, ext)); it != MpqSearchPathCache.end()) {
+		const auto pathIt = std::find(paths.begin(), paths.end(), it->second);
+		if (pathIt != paths.end()) {
+			cachedPath = &*pathIt;
+			if (tryPath(*cachedPath))
+				return result;
+		}
+	}
+	for (const auto &path : paths) {
+		if (&path != cachedPath && tryPath(path))
+			return result;
 	}
 	if (error == 0) {
 		LogVerbose("Missing: {}", mpqName);
 	}
 
-	return false;
+	return result;
+}
+
+/**
+ * @brief Opens the archives in parallel, then mounts the ones that were found.
+ *
+ * Opening reads the header and the tables of each archive, which mostly waits on the disk.
+ */
+void LoadMPQs(std::span<const std::string> paths, std::span<MpqToLoad> mpqs)
+{
+	std::vector<OpenedMpq> opened(mpqs.size());
+	RunRenderBands(static_cast<int>(mpqs.size()), [&](int i) {
+		opened[i] = OpenMPQ(paths, mpqs[i].name, mpqs[i].ext);
+	});
+
+	for (size_t i = 0; i < mpqs.size(); i++) {
+		MpqToLoad &mpq = mpqs[i];
+		if (!opened[i].archive.has_value())
+			continue;
+		MpqSearchPathCache[StrCat(mpq.name, mpq.ext)] = std::string(opened[i].foundIn);
+		MpqFileIndexValid = false;
+		auto [it, inserted] = MpqArchives.emplace(mpq.priority, *std::move(opened[i].archive));
+		if (!inserted) {
+			LogError("MPQ with priority {} is already registered, skipping {}", mpq.priority, mpq.name);
+		}
+		mpq.loaded = true;
+	}
+}
+
+bool LoadMPQ(std::span<const std::string> paths, std::string_view mpqName, int priority, std::string_view ext = ".mpq")
+{
+	MpqToLoad mpq { .name = mpqName, .priority = priority, .ext = ext };
+	LoadMPQs(paths, { &mpq, 1 });
+	return mpq.loaded;
 }
 #endif
 
@@ -385,10 +537,42 @@ std::vector<std::string> GetMPQSearchPaths()
 
 } // namespace
 
+void RebuildMpqFileIndex()
+{
+#ifndef UNPACKED_MPQS
+	MpqFileIndex.clear();
+	MpqFileIndexValid = false;
+	std::vector<MpqHashEntry> hashTable;
+	// Highest priority first, so that the first archive to add a file keeps it.
+	for (auto &[_, mpqArchive] : MpqArchives) {
+		if (!mpqArchive.ReadHashTable(hashTable)) {
+			LogVerbose("Could not index the MPQ files, looking them up in each archive");
+			MpqFileIndex.clear();
+			return;
+		}
+		for (uint32_t i = 0; i < hashTable.size(); i++) {
+			const MpqHashEntry &entry = hashTable[i];
+			if (entry.block == MpqHashEntry::NullBlock || entry.block == MpqHashEntry::DeletedBlock)
+				continue;
+			// libmpq leaves the unused block table entries out of its file numbers, so ask it for the
+			// number, starting its search at this entry.
+			uint32_t fileNumber;
+			if (!mpqArchive.GetFileNumber({ i, entry.hashA, entry.hashB }, fileNumber))
+				continue;
+			const auto [it, inserted] = MpqFileIndex.emplace(MpqFileIndexKey(entry.hashA, entry.hashB), MpqFileIndexEntry { &mpqArchive, fileNumber });
+			if (!inserted && it->second.archive == &mpqArchive && it->second.fileNumber != fileNumber)
+				it->second.archive = nullptr;
+		}
+	}
+	MpqFileIndexValid = true;
+#endif
+}
+
 void LoadCoreArchives()
 {
 	auto paths = GetMPQSearchPaths();
 
+#ifdef UNPACKED_MPQS
 #if !defined(__ANDROID__) && !defined(__APPLE__) && !defined(__3DS__) && !defined(__SWITCH__)
 	// Load devilutionx.mpq first to get the font file for error messages
 #ifdef __DJGPP__
@@ -398,16 +582,34 @@ void LoadCoreArchives()
 #endif
 #endif
 	LoadMPQ(paths, "fonts", FontMpqPriority); // Extra fonts
+#else
+	std::vector<MpqToLoad> mpqs;
+#if !defined(__ANDROID__) && !defined(__APPLE__) && !defined(__3DS__) && !defined(__SWITCH__)
+	// Load devilutionx.mpq first to get the font file for error messages
+#ifdef __DJGPP__
+	mpqs.push_back({ .name = "devx", .priority = DevilutionXMpqPriority });
+#else
+	mpqs.push_back({ .name = "devilutionx", .priority = DevilutionXMpqPriority });
+#endif
+#endif
+	mpqs.push_back({ .name = "fonts", .priority = FontMpqPriority }); // Extra fonts
+	LoadMPQs(paths, mpqs);
+#endif
 	HasHellfireMpq = FindMPQ(paths, "hellfire");
+	RebuildMpqFileIndex();
 }
 
 void LoadLanguageArchive()
 {
 	MpqArchives.erase(LangMpqPriority);
+#ifndef UNPACKED_MPQS
+	MpqFileIndexValid = false;
+#endif
 	const std::string_view code = GetLanguageCode();
 	if (code != "en") {
 		LoadMPQ(GetMPQSearchPaths(), code, LangMpqPriority);
 	}
+	RebuildMpqFileIndex();
 }
 
 void LoadGameArchives()
@@ -418,7 +620,14 @@ void LoadGameArchives()
 
 #ifndef UNPACKED_MPQS
 	// DIABDAT.MPQ is uppercase on the original CD and the GOG version.
-	haveDiabdat = LoadMPQ(paths, "DIABDAT", MainMpqPriority, ".MPQ");
+	// In unpacked mode, all the hellfire data is in the hellfire directory.
+	std::array<MpqToLoad, 3> mpqs { {
+	    { .name = "DIABDAT", .priority = MainMpqPriority, .ext = ".MPQ" },
+	    { .name = "hfbard", .priority = 8110 },
+	    { .name = "hfbarb", .priority = 8120 },
+	} };
+	LoadMPQs(paths, mpqs);
+	haveDiabdat = mpqs[0].loaded;
 #endif
 
 	if (!haveDiabdat) {
@@ -443,19 +652,15 @@ void LoadGameArchives()
 #endif
 	}
 
-#ifndef UNPACKED_MPQS
-	// In unpacked mode, all the hellfire data is in the hellfire directory.
-	LoadMPQ(paths, "hfbard", 8110);
-	LoadMPQ(paths, "hfbarb", 8120);
-#endif
+	RebuildMpqFileIndex();
 }
 
 void LoadHellfireArchives()
 {
 	const std::vector<std::string> paths = GetMPQSearchPaths();
-	LoadMPQ(paths, "hellfire", 8000);
 
 #ifdef UNPACKED_MPQS
+	LoadMPQ(paths, "hellfire", 8000);
 	const std::string &hellfireDataPath = MpqArchives.at(8000);
 	const bool hasMonk = FileExists(hellfireDataPath + "plrgfx/monk/mha/mhaas.clx");
 	const bool hasMusic = FileExists(hellfireDataPath + "music/dlvlf.wav")
@@ -463,10 +668,18 @@ void LoadHellfireArchives()
 	const bool hasVoice = FileExists(hellfireDataPath + "sfx/hellfire/cowsut1.wav")
 	    || FileExists(hellfireDataPath + "sfx/hellfire/cowsut1.mp3");
 #else
-	const bool hasMonk = LoadMPQ(paths, "hfmonk", 8100);
-	const bool hasMusic = LoadMPQ(paths, "hfmusic", 8200);
-	const bool hasVoice = LoadMPQ(paths, "hfvoice", 8500);
+	std::array<MpqToLoad, 4> mpqs { {
+	    { .name = "hellfire", .priority = 8000 },
+	    { .name = "hfmonk", .priority = 8100 },
+	    { .name = "hfmusic", .priority = 8200 },
+	    { .name = "hfvoice", .priority = 8500 },
+	} };
+	LoadMPQs(paths, mpqs);
+	const bool hasMonk = mpqs[1].loaded;
+	const bool hasMusic = mpqs[2].loaded;
+	const bool hasVoice = mpqs[3].loaded;
 #endif
+	RebuildMpqFileIndex();
 
 	if (!hasMonk || !hasMusic || !hasVoice)
 		DisplayFatalErrorAndExit(_("Some Hellfire MPQs are missing"), _("Not all Hellfire MPQs were found.\nPlease copy all the hf*.mpq files."));
@@ -477,6 +690,7 @@ void UnloadModArchives()
 	OverridePaths.clear();
 
 #ifndef UNPACKED_MPQS
+	MpqFileIndexValid = false;
 	for (auto it = MpqArchives.begin(); it != MpqArchives.end();) {
 		if ((it->first >= 8000 && it->first < 9000) || it->first >= 10000) {
 			it = MpqArchives.erase(it); // erase returns the next valid iterator
@@ -484,6 +698,7 @@ void UnloadModArchives()
 			++it;
 		}
 	}
+	RebuildMpqFileIndex();
 #endif
 }
 
@@ -504,10 +719,23 @@ void LoadModArchives(std::span<const std::string_view> modnames)
 
 	int priority = 10000;
 	auto paths = GetMPQSearchPaths();
+#ifdef UNPACKED_MPQS
 	for (const std::string_view modname : modnames) {
 		LoadMPQ(paths, StrCat("mods" DIRECTORY_SEPARATOR_STR, modname), priority);
 		priority++;
 	}
+#else
+	std::vector<std::string> names;
+	names.reserve(modnames.size());
+	std::vector<MpqToLoad> mpqs;
+	for (const std::string_view modname : modnames) {
+		names.push_back(StrCat("mods" DIRECTORY_SEPARATOR_STR, modname));
+		mpqs.push_back({ .name = names.back(), .priority = priority });
+		priority++;
+	}
+	LoadMPQs(paths, mpqs);
+#endif
+	RebuildMpqFileIndex();
 }
 
 } // namespace devilution
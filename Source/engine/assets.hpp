@@ -39,6 +39,8 @@
 
 namespace devilution {
 
+class ScopedAssetLoadTimer;
+
 #ifdef UNPACKED_MPQS
 struct AssetRef {
 	static constexpr size_t PathBufSize = 4088;
@@ -275,6 +277,9 @@ inline bool ValidateHandle(std::string_view path, const AssetHandle &handle)
 
 AssetRef FindAsset(std::string_view filename);
 
+/** @brief Tells the timer of a load which archive the asset comes from and how large it is. */
+void RecordAssetSource(ScopedAssetLoadTimer &timer, const AssetRef &ref);
+
 AssetHandle OpenAsset(AssetRef &&ref, bool threadsafe = false);
 AssetHandle OpenAsset(std::string_view filename, bool threadsafe = false);
 AssetHandle OpenAsset(std::string_view filename, size_t &fileSize, bool threadsafe = false);
@@ -313,6 +318,13 @@ void LoadHellfireArchives();
 void UnloadModArchives();
 void LoadModArchives(std::span<const std::string_view> modnames);
 
+/**
+ * @brief Indexes the files of all the loaded archives so that finding one takes a single lookup.
+ *
+ * The functions above keep the index up to date, call this after changing MpqArchives directly.
+ */
+void RebuildMpqFileIndex();
+
 #ifdef BUILD_TESTING
 [[nodiscard]] inline bool HaveMainData() { return MpqArchives.find(MainMpqPriority) != MpqArchives.end(); }
 #endif
@@ -0,0 +1,134 @@
+/**
+ * @file audio_stats.cpp
+ *
+ * Implementation of the counters that show what the audio pipeline costs.
+ */
+#include "engine/audio_stats.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+#include <fmt/format.h>
+
+#include "options.h"
+#include "utils/log.hpp"
+
+namespace devilution {
+
+namespace {
+
+constexpr size_t AudioStatsTimerCount = static_cast<size_t>(AudioStatsTimer::COUNT);
+
+std::atomic<bool> Enabled { false };
+
+// Added up by the game and audio threads during the current second.
+std::array<std::atomic<uint64_t>, AudioStatsTimerCount> TimerNanoseconds {};
+std::atomic<uint32_t> Callbacks { 0 };
+std::atomic<uint32_t> Underruns { 0 };
+std::atomic<uint32_t> ActiveVoices { 0 };
+
+/** steady_clock ticks of the previous callback, 0 until the first one. */
+std::atomic<int64_t> LastCallbackTicks { 0 };
+
+// Only touched by the game thread.
+std::chrono::steady_clock::time_point WindowStart;
+AudioStats LastStats;
+
+[[nodiscard]] uint32_t TakeMicroseconds(AudioStatsTimer timer)
+{
+	return static_cast<uint32_t>(TimerNanoseconds[static_cast<size_t>(timer)].exchange(0, std::memory_order_relaxed) / 1000);
+}
+
+} // namespace
+
+bool IsAudioStatsEnabled()
+{
+	return Enabled.load(std::memory_order_relaxed);
+}
+
+void SetAudioStatsEnabled(bool enabled)
+{
+	if (enabled == IsAudioStatsEnabled())
+		return;
+	for (std::atomic<uint64_t> &nanoseconds : TimerNanoseconds)
+		nanoseconds.store(0, std::memory_order_relaxed);
+	Callbacks.store(0, std::memory_order_relaxed);
+	Underruns.store(0, std::memory_order_relaxed);
+	LastCallbackTicks.store(0, std::memory_order_relaxed);
+	WindowStart = std::chrono::steady_clock::now();
+	LastStats = {};
+	Enabled.store(enabled, std::memory_order_relaxed);
+}
+
+ScopedAudioStatsTimer::ScopedAudioStatsTimer(AudioStatsTimer timer)
+    : timer_(timer)
+    , enabled_(IsAudioStatsEnabled())
+{
+	if (enabled_)
+		start_ = std::chrono::steady_clock::now();
+}
+
+ScopedAudioStatsTimer::~ScopedAudioStatsTimer()
+{
+	if (!enabled_)
+		return;
+	const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start_);
+	TimerNanoseconds[static_cast<size_t>(timer_)].fetch_add(static_cast<uint64_t>(elapsed.count()), std::memory_order_relaxed);
+}
+
+void CountAudioCallback(int frames, int sampleRate)
+{
+	if (!IsAudioStatsEnabled() || sampleRate <= 0)
+		return;
+
+	const auto now = std::chrono::steady_clock::now().time_since_epoch();
+	const auto bufferDuration = std::chrono::microseconds { static_cast<int64_t>(frames) * 1000000 / sampleRate };
+	const std::chrono::steady_clock::duration last { LastCallbackTicks.exchange(now.count(), std::memory_order_relaxed) };
+	Callbacks.fetch_add(1, std::memory_order_relaxed);
+	if (last.count() != 0 && now - last > 2 * bufferDuration)
+		Underruns.fetch_add(1, std::memory_order_relaxed);
+}
+
+void SetActiveAudioVoices(uint32_t voices)
+{
+	ActiveVoices.store(voices, std::memory_order_relaxed);
+}
+
+void UpdateAudioStats()
+{
+	if (!IsAudioStatsEnabled())
+		return;
+
+	const auto now = std::chrono::steady_clock::now();
+	if (now - WindowStart < std::chrono::seconds { 1 })
+		return;
+	WindowStart = now;
+
+	const std::string_view resampler = ResamplerToString(*GetOptions().Audio.resampler);
+	LastStats = AudioStats {
+		.activeVoices = ActiveVoices.load(std::memory_order_relaxed),
+		.soundUpdateMicroseconds = TakeMicroseconds(AudioStatsTimer::SoundUpdate),
+		.soundPoolMicroseconds = TakeMicroseconds(AudioStatsTimer::SoundPool),
+		.decodeMicroseconds = TakeMicroseconds(AudioStatsTimer::Decode),
+		.resampleMicroseconds = TakeMicroseconds(AudioStatsTimer::Resample),
+		.callbacks = Callbacks.exchange(0, std::memory_order_relaxed),
+		.underruns = Underruns.exchange(0, std::memory_order_relaxed),
+		.resampler = resampler.empty() ? "None" : resampler,
+	};
+	LogInfo(LogCategory::Audio, "Audio stats: {}", FormatAudioStatsJson(LastStats));
+}
+
+const AudioStats &GetAudioStats()
+{
+	return LastStats;
+}
+
+std::string FormatAudioStatsJson(const AudioStats &stats)
+{
+	return fmt::format(R"({{"activeVoices":{},"soundUpdateUs":{},"soundPoolUs":{},"decodeUs":{},"resampleUs":{},"callbacks":{},"underruns":{},"resampler":"{}","bufferSize":{},"sampleRate":{}}})",
+	    stats.activeVoices, stats.soundUpdateMicroseconds, stats.soundPoolMicroseconds, stats.decodeMicroseconds, stats.resampleMicroseconds,
+	    stats.callbacks, stats.underruns, stats.resampler, *GetOptions().Audio.bufferSize, *GetOptions().Audio.sampleRate);
+}
+
+} // namespace devilution
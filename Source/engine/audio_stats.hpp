@@ -0,0 +1,81 @@
+/**
+ * @file audio_stats.hpp
+ *
+ * Interface of the counters that show what the audio pipeline costs, for tuning the buffer size.
+ */
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace devilution {
+
+/** What the audio pipeline did over the last full second. */
+struct AudioStats {
+	/** Navigation cue voices playing an emitter. */
+	uint32_t activeVoices = 0;
+	/** Time spent in sound_update() on the game thread. */
+	uint32_t soundUpdateMicroseconds = 0;
+	/** Time spent assigning emitters to voices on the game thread. */
+	uint32_t soundPoolMicroseconds = 0;
+	/** Time spent decoding, in the audio callback or ahead on the thread that decodes streamed sounds. */
+	uint32_t decodeMicroseconds = 0;
+	/** Time spent resampling in the audio callback. */
+	uint32_t resampleMicroseconds = 0;
+	uint32_t callbacks = 0;
+	/** Callbacks that came more than a buffer late, so the device most likely ran dry. */
+	uint32_t underruns = 0;
+	/** The resampler picked in the options, "None" if it was compiled out. */
+	std::string_view resampler;
+
+	bool operator==(const AudioStats &) const = default;
+};
+
+enum class AudioStatsTimer : uint8_t {
+	SoundUpdate,
+	SoundPool,
+	Decode,
+	Resample,
+	COUNT,
+};
+
+/** @brief Whether the counters are being collected, from the "Show Audio Statistics" option. Safe from any thread. */
+[[nodiscard]] bool IsAudioStatsEnabled();
+void SetAudioStatsEnabled(bool enabled);
+
+/** @brief Adds the time until it goes out of scope to a timer, if the counters are collected. Safe from any thread. */
+class ScopedAudioStatsTimer {
+public:
+	explicit ScopedAudioStatsTimer(AudioStatsTimer timer);
+	~ScopedAudioStatsTimer();
+
+	ScopedAudioStatsTimer(const ScopedAudioStatsTimer &) = delete;
+	ScopedAudioStatsTimer &operator=(const ScopedAudioStatsTimer &) = delete;
+
+private:
+	AudioStatsTimer timer_;
+	std::chrono::steady_clock::time_point start_;
+	bool enabled_;
+};
+
+/**
+ * @brief Counts an audio callback from the audio thread.
+ * @param frames The number of frames the callback has to fill
+ * @param sampleRate The output sample rate
+ */
+void CountAudioCallback(int frames, int sampleRate);
+
+void SetActiveAudioVoices(uint32_t voices);
+
+/** @brief Closes the current second if it is over, call once per game tick. */
+void UpdateAudioStats();
+
+/** @brief The counters of the last full second. */
+[[nodiscard]] const AudioStats &GetAudioStats();
+
+/** @brief The counters as a single line of JSON, for scripts that compare devices or buffer sizes. */
+[[nodiscard]] std::string FormatAudioStatsJson(const AudioStats &stats);
+
+} // namespace devilution
@@ -0,0 +1,142 @@
+/**
+ * @file converted_asset_cache.cpp
+ *
+ * Implementation of the on-disk cache of assets converted at load time.
+ */
+#include "engine/converted_asset_cache.hpp"
+
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <string>
+
+#include <fmt/format.h>
+
+#include "utils/endian_read.hpp"
+#include "utils/endian_write.hpp"
+#include "utils/file_util.h"
+#include "utils/fnv1a.hpp"
+#include "utils/log.hpp"
+#include "utils/paths.h"
+#include "utils/str_cat.hpp"
+
+namespace devilution {
+
+namespace {
+
+constexpr std::array<char, 4> Magic { 'D', 'X', 'C', 'A' };
+/** Magic, key and data size, all little-endian. */
+constexpr size_t HeaderSize = 4 + 8 + 4;
+
+std::string CacheDirectory()
+{
+	return StrCat(paths::PrefPath(), "cache", DIRECTORY_SEPARATOR_STR);
+}
+
+std::string CachePath(uint64_t key)
+{
+	return StrCat(CacheDirectory(), fmt::format("{:016x}", key), ".bin");
+}
+
+struct FileCloser {
+	void operator()(FILE *file) const
+	{
+		std::fclose(file);
+	}
+};
+
+using FileUniquePtr = std::unique_ptr<FILE, FileCloser>;
+
+} // namespace
+
+ConvertedAssetKey::ConvertedAssetKey(uint32_t version)
+    : hash_(Fnv1aOffsetBasis)
+{
+	Add(version);
+}
+
+void ConvertedAssetKey::AddSource(const AssetRef &ref)
+{
+#ifdef UNPACKED_MPQS
+	valid_ = false;
+#else
+	if (ref.archive == nullptr || ref.archive->Fingerprint() == 0) {
+		valid_ = false;
+		return;
+	}
+	Add(ref.archive->Fingerprint());
+	Add(ref.fileNumber);
+#endif
+}
+
+void ConvertedAssetKey::Add(uint64_t value)
+{
+	hash_ = Fnv1a(value, hash_);
+}
+
+std::unique_ptr<std::byte[]> LoadConvertedAsset(const ConvertedAssetKey &key, size_t &size)
+{
+	if (!key.valid())
+		return nullptr;
+
+	const std::string path = CachePath(key.value());
+	const FileUniquePtr file { OpenFile(path.c_str(), "rb") };
+	if (file == nullptr)
+		return nullptr;
+
+	std::array<uint8_t, HeaderSize> header;
+	if (std::fread(header.data(), header.size(), 1, file.get()) != 1
+	    || std::memcmp(header.data(), Magic.data(), Magic.size()) != 0
+	    || LoadLE32(&header[4]) != static_cast<uint32_t>(key.value())
+	    || LoadLE32(&header[8]) != static_cast<uint32_t>(key.value() >> 32))
+		return nullptr;
+
+	const uint32_t dataSize = LoadLE32(&header[12]);
+	uintmax_t fileSize;
+	if (!GetFileSize(path.c_str(), &fileSize) || fileSize != HeaderSize + dataSize)
+		return nullptr;
+
+	std::unique_ptr<std::byte[]> data { new std::byte[dataSize] };
+	if (dataSize > 0 && std::fread(data.get(), dataSize, 1, file.get()) != 1)
+		return nullptr;
+	size = static_cast<size_t>(dataSize);
+	return data;
+}
+
+void StoreConvertedAsset(const ConvertedAssetKey &key, std::span<const std::byte> data)
+{
+	if (!key.valid() || data.size() > std::numeric_limits<uint32_t>::max())
+		return;
+
+	const std::string directory = CacheDirectory();
+	if (!DirectoryExists(directory.c_str()))
+		RecursivelyCreateDir(directory.c_str());
+
+	// Written under a temporary name first, so a crash never leaves a truncated entry behind.
+	const std::string path = CachePath(key.value());
+	const std::string tempPath = StrCat(path, ".tmp");
+	{
+		const FileUniquePtr file { OpenFile(tempPath.c_str(), "wb") };
+		if (file == nullptr) {
+			LogVerbose("Failed to write the converted asset cache: {}", tempPath);
+			return;
+		}
+		std::array<uint8_t, HeaderSize> header;
+		std::memcpy(header.data(), Magic.data(), Magic.size());
+		WriteLE32(&header[4], static_cast<uint32_t>(key.value()));
+		WriteLE32(&header[8], static_cast<uint32_t>(key.value() >> 32));
+		WriteLE32(&header[12], static_cast<uint32_t>(data.size()));
+		if (std::fwrite(header.data(), header.size(), 1, file.get()) != 1
+		    || (!data.empty() && std::fwrite(data.data(), data.size(), 1, file.get()) != 1)) {
+			LogVerbose("Failed to write the converted asset cache: {}", tempPath);
+			return;
+		}
+	}
+	if (FileExists(path.c_str()))
+		RemoveFile(path.c_str());
+	RenameFile(tempPath.c_str(), path.c_str());
+}
+
+} // namespace devilution
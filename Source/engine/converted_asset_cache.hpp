@@ -0,0 +1,63 @@
+/**
+ * @file converted_asset_cache.hpp
+ *
+ * Interface of the on-disk cache of assets converted at load time, such as CL2 sprites converted to CLX.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+
+#include "engine/assets.hpp"
+
+namespace devilution {
+
+/**
+ * @brief Identifies a converted asset by everything it was converted from.
+ *
+ * Bump `Version` of the conversion whenever its output changes.
+ */
+class ConvertedAssetKey {
+public:
+	explicit ConvertedAssetKey(uint32_t version);
+
+	/**
+	 * @brief Adds a source file of the asset.
+	 *
+	 * Only files in memory mapped MPQs can be told apart from other versions of themselves; for any
+	 * other file the key becomes invalid and the asset isn't cached.
+	 */
+	void AddSource(const AssetRef &ref);
+
+	void Add(uint64_t value);
+
+	/** @brief Marks the asset as one that can't be cached. */
+	void Invalidate()
+	{
+		valid_ = false;
+	}
+
+	[[nodiscard]] bool valid() const
+	{
+		return valid_;
+	}
+
+	[[nodiscard]] uint64_t value() const
+	{
+		return hash_;
+	}
+
+private:
+	uint64_t hash_;
+	bool valid_ = true;
+};
+
+/** @brief Reads a cached asset, null if the cache has none for the key. Safe from any thread. */
+std::unique_ptr<std::byte[]> LoadConvertedAsset(const ConvertedAssetKey &key, size_t &size);
+
+/** @brief Caches an asset for the next time, failing quietly. Safe from any thread. */
+void StoreConvertedAsset(const ConvertedAssetKey &key, std::span<const std::byte> data);
+
+} // namespace devilution
@@ -0,0 +1,359 @@
+/**
+ * @file cue_voice.cpp
+ *
+ * Implementation of the voices that play repeating navigation cues from the audio callback.
+ */
+#include "engine/cue_voice.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <optional>
+#include <utility>
+
+#ifndef USE_SDL3
+#include <Aulib/Decoder.h>
+#include <Aulib/Stream.h>
+
+#include <SDL.h>
+#ifdef USE_SDL1
+#include "utils/sdl2_to_1_2_backports.h"
+#else
+#include "utils/sdl2_backports.h"
+#endif
+#include "utils/aulib.hpp"
+#endif
+
+#include "engine/audio_stats.hpp"
+#include "engine/sound_defs.hpp"
+#include "utils/log.hpp"
+#include "utils/spsc_queue.hpp"
+
+namespace devilution {
+
+namespace {
+
+/** Largest delay between the ears, for a sound straight to the side. */
+constexpr float MaxInterauralDelaySeconds = 0.00066F;
+/** How much quieter and duller the ear away from a sound to the side hears it. */
+constexpr float HeadShadowGain = 0.5F;
+constexpr float HeadShadowDulling = 0.6F;
+/** How much duller a sound straight behind is in both ears, so it can be told apart from one in front. */
+constexpr float RearDulling = 0.5F;
+
+/** Linear gains and binaural direction of a cue, worked out on the game thread. */
+struct CueMix {
+	std::array<float, 2> gains;
+	bool binaural;
+	float lateral;
+	float rear;
+};
+
+struct CueCommand {
+	enum class Type : uint8_t {
+		Play,
+		Update,
+	};
+
+	Type type;
+	const PcmBuffer *pcm;
+	uint32_t intervalMs;
+	CueMix mix;
+	/** CueCommandQueue::stops when the command was sent, it is dropped if a Stop came after it. */
+	uint32_t stops;
+};
+
+} // namespace
+
+struct CueCommandQueue {
+	// The game thread sends at most a few commands per voice and tick.
+	SpscQueue<CueCommand, 16> queue;
+	/**
+	 * Counts the calls to Stop(). It is not a command, so that a full queue can never lose one
+	 * and leave a cue repeating forever.
+	 */
+	std::atomic<uint32_t> stops { 0 };
+	/** A command that didn't fit into the full queue, sent again ahead of the next one. Game thread only. */
+	std::optional<CueCommand> pending;
+};
+
+namespace {
+
+#ifndef USE_SDL3
+/**
+ * Renders a voice's cues in stereo. Everything that changes how a cue sounds is latched when the
+ * cue starts, so updates never cause clicks mid-sound.
+ */
+class CueVoiceDecoder final : public Aulib::Decoder {
+public:
+	CueVoiceDecoder(std::shared_ptr<CueCommandQueue> commands, int rate)
+	    : commands_(std::move(commands))
+	    , rate_(rate)
+	{
+	}
+
+	auto open([[maybe_unused]] SDL_IOStream *rwops) -> bool override
+	{
+		setIsOpen(true);
+		return true;
+	}
+
+	auto getChannels() const -> int override
+	{
+		return 2;
+	}
+
+	auto getRate() const -> int override
+	{
+		return rate_;
+	}
+
+	auto rewind() -> bool override
+	{
+		return true;
+	}
+
+	auto duration() const -> std::chrono::microseconds override
+	{
+		return {};
+	}
+
+	auto seekToTime([[maybe_unused]] std::chrono::microseconds pos) -> bool override
+	{
+		return false;
+	}
+
+protected:
+	auto doDecoding(float buf[], int len, bool &callAgain) -> int override
+	{
+		const ScopedAudioStatsTimer timer(AudioStatsTimer::Decode);
+		callAgain = false;
+
+		// Everything sent before the last Stop() is outdated.
+		const uint32_t stops = commands_->stops.load(std::memory_order_acquire);
+		if (stops != appliedStops_)
+			ApplyStop(stops);
+		CueCommand command;
+		while (commands_->queue.Pop(command)) {
+			if (static_cast<int32_t>(command.stops - appliedStops_) < 0)
+				continue;
+			if (command.stops != appliedStops_)
+				ApplyStop(command.stops);
+			Apply(command);
+		}
+
+		const size_t frames = static_cast<size_t>(len) / 2;
+		for (size_t i = 0; i < frames; i++) {
+			if (intervalFrames_ != 0 && framesSinceStart_ >= intervalFrames_)
+				Start();
+			RenderFrame(&buf[i * 2]);
+			framesSinceStart_++;
+		}
+		std::fill(buf + frames * 2, buf + len, 0.F);
+		// Never report the end of the stream, an idle voice plays silence.
+		return len;
+	}
+
+private:
+	struct Ear {
+		float gain = 0;
+		size_t delayFrames = 0;
+		float coefficient = 1;
+		float state = 0;
+	};
+
+	void Apply(const CueCommand &command)
+	{
+		nextPcm_ = command.pcm;
+		nextMix_ = command.mix;
+		intervalFrames_ = static_cast<size_t>(command.intervalMs) * static_cast<size_t>(rate_) / 1000;
+		if (command.type == CueCommand::Type::Play)
+			Start();
+	}
+
+	void ApplyStop(uint32_t stops)
+	{
+		appliedStops_ = stops;
+		pcm_ = nullptr;
+		nextPcm_ = nullptr;
+		intervalFrames_ = 0;
+	}
+
+	void Start()
+	{
+		pcm_ = nextPcm_;
+		framesSinceStart_ = 0;
+		if (pcm_ == nullptr)
+			return;
+		step_ = static_cast<float>(pcm_->rate) / static_cast<float>(rate_);
+
+		const CueMix &mix = nextMix_;
+		for (size_t i = 0; i < ears_.size(); i++)
+			ears_[i] = Ear { .gain = mix.gains[i] };
+		if (!mix.binaural)
+			return;
+
+		const float lateral = std::clamp(mix.lateral, -1.F, 1.F);
+		const float side = std::abs(lateral);
+		const float nearCoefficient = 1.F - RearDulling * std::clamp(mix.rear, 0.F, 1.F);
+		Ear &nearEar = ears_[lateral > 0 ? 1 : 0];
+		Ear &farEar = ears_[lateral > 0 ? 0 : 1];
+		nearEar.coefficient = nearCoefficient;
+		farEar.coefficient = nearCoefficient * (1.F - HeadShadowDulling * side);
+		farEar.gain *= 1.F - HeadShadowGain * side;
+		farEar.delayFrames = static_cast<size_t>(std::lround(side * MaxInterauralDelaySeconds * static_cast<float>(rate_)));
+	}
+
+	[[nodiscard]] float SourceAt(size_t frame) const
+	{
+		const auto sourceFrame = static_cast<size_t>(static_cast<float>(frame) * step_);
+		const size_t channels = static_cast<size_t>(pcm_->channels);
+		if (sourceFrame >= pcm_->samples.size() / channels)
+			return 0;
+		const float *samples = &pcm_->samples[sourceFrame * channels];
+		float sum = 0;
+		for (size_t channel = 0; channel < channels; channel++)
+			sum += samples[channel];
+		return sum / static_cast<float>(channels);
+	}
+
+	void RenderFrame(float *out)
+	{
+		if (pcm_ == nullptr) {
+			out[0] = 0;
+			out[1] = 0;
+			return;
+		}
+		for (size_t i = 0; i < ears_.size(); i++) {
+			Ear &ear = ears_[i];
+			const float input = framesSinceStart_ >= ear.delayFrames ? SourceAt(framesSinceStart_ - ear.delayFrames) : 0;
+			ear.state += ear.coefficient * (input - ear.state);
+			out[i] = ear.state * ear.gain;
+		}
+	}
+
+	std::shared_ptr<CueCommandQueue> commands_;
+	int rate_;
+	uint32_t appliedStops_ = 0;
+
+	const PcmBuffer *pcm_ = nullptr;
+	const PcmBuffer *nextPcm_ = nullptr;
+	CueMix nextMix_ {};
+	size_t intervalFrames_ = 0;
+	size_t framesSinceStart_ = 0;
+	float step_ = 1;
+	std::array<Ear, 2> ears_;
+};
+
+CueMix ToCueMix(const CuePlacement &placement)
+{
+	const float volume = VolumeLogToLinear(std::max(placement.logVolume, ATTENUATION_MIN), ATTENUATION_MIN, 0);
+	CueMix mix { .gains = { volume, volume }, .binaural = placement.binaural, .lateral = placement.lateral, .rear = placement.rear };
+	if (!placement.binaural) {
+		// Same balance as Aulib::Stream::setStereoPosition.
+		const float pan = PanLogToLinear(placement.logPan);
+		if (pan > 0)
+			mix.gains[0] *= 1.F - pan;
+		else
+			mix.gains[1] *= 1.F + pan;
+	}
+	return mix;
+}
+
+/**
+ * @brief Queues a Play or Update command.
+ *
+ * If the queue is full, the command is kept and sent ahead of the next one. The newer command
+ * replaces one kept from before, keeping it a Play so that the cue still starts.
+ */
+void SendCueCommand(CueCommandQueue &commands, CueCommand command)
+{
+	command.stops = commands.stops.load(std::memory_order_relaxed);
+	if (commands.pending) {
+		if (commands.pending->stops != command.stops) {
+			commands.pending = std::nullopt;
+		} else if (commands.queue.Push(*commands.pending)) {
+			commands.pending = std::nullopt;
+		} else {
+			if (commands.pending->type == CueCommand::Type::Play)
+				command.type = CueCommand::Type::Play;
+			commands.pending = command;
+			return;
+		}
+	}
+	if (!commands.queue.Push(command))
+		commands.pending = command;
+}
+#endif
+
+} // namespace
+
+CueVoice::CueVoice() = default;
+
+CueVoice::~CueVoice()
+{
+	Close();
+}
+
+bool CueVoice::Open()
+{
+#ifdef USE_SDL3
+	return false;
+#else
+	if (stream_ != nullptr)
+		return true;
+
+	commands_ = std::make_shared<CueCommandQueue>();
+	const int rate = Aulib::sampleRate();
+	stream_ = std::make_unique<Aulib::Stream>(/*rwops=*/nullptr, std::make_unique<CueVoiceDecoder>(commands_, rate), CreateAulibResampler(rate), /*closeRw=*/false);
+	if (!stream_->open() || !stream_->play()) {
+		LogError(LogCategory::Audio, "Aulib::Stream::open (from CueVoice::Open): {}", SDL_GetError());
+		stream_ = nullptr;
+		commands_ = nullptr;
+		return false;
+	}
+	return true;
+#endif
+}
+
+void CueVoice::Close()
+{
+#ifndef USE_SDL3
+	stream_ = nullptr;
+#endif
+	commands_ = nullptr;
+}
+
+bool CueVoice::IsOpen() const
+{
+	return commands_ != nullptr;
+}
+
+void CueVoice::Play(const PcmBuffer &pcm, uint32_t intervalMs, const CuePlacement &placement)
+{
+#ifndef USE_SDL3
+	if (commands_ != nullptr)
+		SendCueCommand(*commands_, CueCommand { CueCommand::Type::Play, &pcm, intervalMs, ToCueMix(placement), 0 });
+#endif
+}
+
+void CueVoice::Update(const PcmBuffer &pcm, uint32_t intervalMs, const CuePlacement &placement)
+{
+#ifndef USE_SDL3
+	if (commands_ != nullptr)
+		SendCueCommand(*commands_, CueCommand { CueCommand::Type::Update, &pcm, intervalMs, ToCueMix(placement), 0 });
+#endif
+}
+
+void CueVoice::Stop()
+{
+#ifndef USE_SDL3
+	if (commands_ != nullptr)
+		commands_->stops.fetch_add(1, std::memory_order_release);
+#endif
+}
+
+} // namespace devilution
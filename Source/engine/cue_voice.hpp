@@ -0,0 +1,75 @@
+/**
+ * @file cue_voice.hpp
+ *
+ * Interface of the voices that play repeating navigation cues from the audio callback.
+ */
+#pragma once
+
+#include <cstdint>
+#include <memory>
+
+#include "utils/soundsample.h"
+
+#ifndef USE_SDL3
+namespace Aulib {
+class Stream;
+} // namespace Aulib
+#endif
+
+namespace devilution {
+
+struct CueCommandQueue;
+
+/** Where a cue is heard from, applied from the next time the cue starts. */
+struct CuePlacement {
+	/** Logarithmic volume, ATTENUATION_MIN (muted) to 0. */
+	int logVolume;
+	/** Logarithmic stereo position, PAN_MIN to PAN_MAX. Ignored for binaural cues. */
+	int logPan;
+	/** Render the cue for headphones with an interaural delay and head shadow instead of panning it. */
+	bool binaural;
+	/** Binaural direction from -1 (left) to 1 (right). */
+	float lateral;
+	/** Binaural direction from 0 (in front) to 1 (behind). */
+	float rear;
+
+	bool operator==(const CuePlacement &) const = default;
+};
+
+/**
+ * @brief A voice that plays a cue and repeats it on its own, mixed in the audio callback.
+ *
+ * The game thread only queues commands without locking; the voice starts the cue, repeats it
+ * down to the sample, and applies the volume, panning and binaural filter itself.
+ * The PcmBuffer passed in must outlive the voice or the next Stop().
+ */
+class CueVoice {
+public:
+	CueVoice();
+	~CueVoice();
+
+	CueVoice(const CueVoice &) = delete;
+	CueVoice &operator=(const CueVoice &) = delete;
+
+	/** @brief Starts the voice's stream, the audio device has to be initialized. */
+	bool Open();
+	void Close();
+
+	[[nodiscard]] bool IsOpen() const;
+
+	/** @brief Starts `pcm` right away, then again every `intervalMs` (0 plays it once). */
+	void Play(const PcmBuffer &pcm, uint32_t intervalMs, const CuePlacement &placement);
+
+	/** @brief Changes what the following repetitions play without restarting the cue. */
+	void Update(const PcmBuffer &pcm, uint32_t intervalMs, const CuePlacement &placement);
+
+	void Stop();
+
+private:
+	std::shared_ptr<CueCommandQueue> commands_;
+#ifndef USE_SDL3
+	std::unique_ptr<Aulib::Stream> stream_;
+#endif
+};
+
+} // namespace devilution
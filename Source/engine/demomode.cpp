@@ -4,6 +4,9 @@
 #include <cstdio>
 #include <limits>
 #include <optional>
+#include <string>
+#include <utility>
+#include <vector>
 
 #ifdef USE_SDL3
 #include <SDL3/SDL_events.h>
@@ -17,9 +20,13 @@
 #endif
 #endif
 
+#include <zlib.h>
+
 #include "controls/control_mode.hpp"
 #include "controls/plrctrls.h"
 #include "engine/events.hpp"
+#include "engine/frame_stats.hpp"
+#include "engine/tick_timing.hpp"
 #include "game_mode.hpp"
 #include "gmenu.h"
 #include "headless_mode.hpp"
@@ -43,7 +50,15 @@ namespace devilution {
 
 namespace {
 
-constexpr uint8_t Version = 3;
+constexpr uint8_t Version = 5;
+
+/** From this version on the messages are stored in compressed blocks, each starting at a game tick. */
+constexpr uint8_t FirstBlockVersion = 5;
+
+/** A block is closed at the first game tick after it has grown this large. */
+constexpr size_t DemoBlockSize = 64 * 1024;
+/** Or after this many game ticks, so that a crash loses at most a few seconds of the recording. */
+constexpr uint32_t DemoBlockTicks = 100;
 
 enum class LoadingStatus : uint8_t {
 	Success,
@@ -114,6 +129,8 @@ int DemoNumber = -1;
 std::optional<DemoMsg> CurrentDemoMessage;
 
 bool Timedemo = false;
+/** Timedemo without any rendering, to measure the game logic alone. */
+bool NoRender = false;
 int RecordNumber = -1;
 bool CreateDemoReference = false;
 
@@ -144,6 +161,9 @@ struct {
 	uint8_t numFullRejuPotionPickup = 0;
 } DemoSettings;
 
+// The keys bound to each keymapper action, so keybinds replay the same even if the player's own are different.
+std::vector<std::pair<std::string, uint32_t>> DemoKeymap;
+
 FILE *DemoRecording;
 uint32_t DemoModeLastTick = 0;
 
@@ -153,6 +173,119 @@ uint32_t StartTime = 0;
 uint16_t DemoGraphicsWidth = 640;
 uint16_t DemoGraphicsHeight = 480;
 
+/** Playback fast-forwards without drawing until this game tick. */
+int SeekTick = 0;
+
+/**
+ * The uncompressed messages of a block. On disk a block is its first game tick, its size,
+ * its compressed size and then the zlib stream, so tools can find a tick without decompressing.
+ */
+struct DemoBlock {
+	std::vector<uint8_t> data;
+	size_t position = 0;
+	uint32_t firstTick = 0;
+};
+
+DemoBlock PlaybackBlock;
+DemoBlock RecordingBlock;
+
+bool UsesBlocks()
+{
+	return DemoFileVersion >= FirstBlockVersion;
+}
+
+bool ReadDemoBlock()
+{
+	const uint32_t firstTick = ReadLE32(DemoFile);
+	const uint32_t size = ReadLE32(DemoFile);
+	const uint32_t compressedSize = ReadLE32(DemoFile);
+	if (std::feof(DemoFile) != 0 || size == 0 || compressedSize == 0)
+		return false;
+
+	std::vector<uint8_t> compressed(compressedSize);
+	LoggedFread(compressed.data(), compressed.size(), DemoFile);
+	PlaybackBlock.data.resize(size);
+	uLongf uncompressedSize = size;
+	if (uncompress(PlaybackBlock.data.data(), &uncompressedSize, compressed.data(), compressedSize) != Z_OK || uncompressedSize != size) {
+		LogError("Demo: the block starting at game tick {} is corrupt", firstTick);
+		return false;
+	}
+	PlaybackBlock.position = 0;
+	PlaybackBlock.firstTick = firstTick;
+	return true;
+}
+
+/** @brief Whether there are more messages, reads the next block once the current one is used up. */
+bool HasBlockData()
+{
+	return PlaybackBlock.position < PlaybackBlock.data.size() || ReadDemoBlock();
+}
+
+uint8_t ReadDemoByte()
+{
+	if (!UsesBlocks())
+		return ReadByte(DemoFile);
+	if (!HasBlockData()) {
+		LogError("Demo: a message continues past the end of the demo");
+		return 0;
+	}
+	return PlaybackBlock.data[PlaybackBlock.position++];
+}
+
+uint16_t ReadDemoLE16()
+{
+	if (!UsesBlocks())
+		return ReadLE16(DemoFile);
+	const uint16_t low = ReadDemoByte();
+	const uint16_t high = ReadDemoByte();
+	return static_cast<uint16_t>(low | (high << 8));
+}
+
+uint32_t ReadDemoLE32()
+{
+	if (!UsesBlocks())
+		return ReadLE32(DemoFile);
+	const uint32_t low = ReadDemoLE16();
+	const uint32_t high = ReadDemoLE16();
+	return low | (high << 16);
+}
+
+void WriteDemoByte(uint8_t value)
+{
+	RecordingBlock.data.push_back(value);
+}
+
+void WriteDemoLE16(uint16_t value)
+{
+	WriteDemoByte(static_cast<uint8_t>(value));
+	WriteDemoByte(static_cast<uint8_t>(value >> 8));
+}
+
+void WriteDemoLE32(uint32_t value)
+{
+	WriteDemoLE16(static_cast<uint16_t>(value));
+	WriteDemoLE16(static_cast<uint16_t>(value >> 16));
+}
+
+void FlushRecordingBlock()
+{
+	if (RecordingBlock.data.empty())
+		return;
+
+	// Taken out of the block first, so that the flush on the way out of app_fatal() finds nothing left to write.
+	const std::vector<uint8_t> data = std::exchange(RecordingBlock.data, {});
+	const uint32_t firstTick = std::exchange(RecordingBlock.firstTick, static_cast<uint32_t>(LogicTick));
+	uLongf compressedSize = compressBound(static_cast<uLong>(data.size()));
+	std::vector<uint8_t> compressed(compressedSize);
+	if (compress2(compressed.data(), &compressedSize, data.data(), static_cast<uLong>(data.size()), Z_BEST_COMPRESSION) != Z_OK)
+		app_fatal("Failed to compress the demo recording");
+	WriteLE32(DemoRecording, firstTick);
+	WriteLE32(DemoRecording, static_cast<uint32_t>(data.size()));
+	WriteLE32(DemoRecording, static_cast<uint32_t>(compressedSize));
+	LoggedFwrite(compressed.data(), compressedSize, DemoRecording);
+	std::fflush(DemoRecording);
+}
+
 void ReadSettings(FILE *in, uint8_t version) // NOLINT(readability-identifier-length)
 {
 	DemoGraphicsWidth = ReadLE16(in);
@@ -184,6 +317,17 @@ void ReadSettings(FILE *in, uint8_t version) // NOLINT(readability-identifier-le
 	} else {
 		DemoSettings = {};
 	}
+	DemoKeymap.clear();
+	if (version >= 4) {
+		const uint16_t actionCount = ReadLE16(in);
+		DemoKeymap.reserve(actionCount);
+		for (uint16_t i = 0; i < actionCount; i++) {
+			std::string actionKey(ReadByte(in), '\0');
+			LoggedFread(actionKey.data(), actionKey.size(), in);
+			const uint32_t boundKey = ReadLE32(in);
+			DemoKeymap.emplace_back(std::move(actionKey), boundKey);
+		}
+	}
 
 	std::string message = StrCat("⚙️\n", _("Resolution"), "=", DemoGraphicsWidth, "x", DemoGraphicsHeight);
 	for (const auto &[key, value] : std::initializer_list<std::pair<std::string_view, bool>> {
@@ -214,6 +358,7 @@ void ReadSettings(FILE *in, uint8_t version) // NOLINT(readability-identifier-le
 	         { _("Full Rejuvenation Potion Pickup"), DemoSettings.numFullRejuPotionPickup } }) {
 		StrAppend(message, "\n", key, "=", static_cast<int>(value));
 	}
+	StrAppend(message, "\n", _("Keybinds"), "=", DemoKeymap.size());
 	Log("{}", message);
 }
 
@@ -245,6 +390,38 @@ void WriteSettings(FILE *out)
 	WriteByte(out, *options.Gameplay.numFullManaPotionPickup);
 	WriteByte(out, *options.Gameplay.numRejuPotionPickup);
 	WriteByte(out, *options.Gameplay.numFullRejuPotionPickup);
+
+	const std::vector<OptionEntryBase *> actions = GetOptions().Keymapper.GetEntries();
+	WriteLE16(out, static_cast<uint16_t>(actions.size()));
+	for (const OptionEntryBase *action : actions) {
+		const std::string_view actionKey = action->key;
+		WriteByte(out, static_cast<uint8_t>(actionKey.size()));
+		LoggedFwrite(actionKey.data(), actionKey.size(), out);
+		WriteLE32(out, options.Keymapper.KeyForAction(actionKey));
+	}
+}
+
+void ApplyDemoKeymap()
+{
+	if (DemoKeymap.empty())
+		return;
+	const std::vector<OptionEntryBase *> actions = GetOptions().Keymapper.GetEntries();
+	const auto findRecorded = [](std::string_view actionKey) -> const uint32_t * {
+		for (const auto &[key, boundKey] : DemoKeymap) {
+			if (key == actionKey)
+				return &boundKey;
+		}
+		return nullptr;
+	};
+	// Unbind first, so a key moved between two actions is not taken back from the one it was moved to.
+	for (OptionEntryBase *action : actions) {
+		if (findRecorded(action->key) != nullptr)
+			static_cast<KeymapperOptions::Action *>(action)->SetValue(SDLK_UNKNOWN);
+	}
+	for (OptionEntryBase *action : actions) {
+		if (const uint32_t *boundKey = findRecorded(action->key); boundKey != nullptr)
+			static_cast<KeymapperOptions::Action *>(action)->SetValue(static_cast<int>(*boundKey));
+	}
 }
 
 #if SDL_VERSION_ATLEAST(2, 0, 0)
@@ -316,6 +493,9 @@ bool CreateSdlEvent(const DemoMsg &dmsg, SDL_Event &event, uint16_t &modState)
 		event.key.keysym.sym = dmsg.key.sym;
 		event.key.keysym.mod = dmsg.key.mod;
 #endif
+		// Keybinds such as Shift+N for cycling tracker targets read the modifiers from SDL, not the event.
+		modState = dmsg.key.mod;
+		SDL_SetModState(static_cast<SDL_Keymod>(dmsg.key.mod));
 		return true;
 	default:
 		if (type >= DemoMsg::MinCustomEvent) {
@@ -413,6 +593,8 @@ bool CreateSdlEvent(const DemoMsg &dmsg, SDL_Event &event, uint16_t &modState)
 		event.key.state = type == DemoMsg::KeyDownEvent ? SDL_PRESSED : SDL_RELEASED;
 		event.key.keysym.sym = Sdl2ToSdl1Key(dmsg.key.sym);
 		event.key.keysym.mod = static_cast<SDL_Keymod>(dmsg.key.mod);
+		modState = dmsg.key.mod;
+		SDL_SetModState(static_cast<SDL_Keymod>(dmsg.key.mod));
 		return true;
 	default:
 		if (type >= DemoMsg::MinCustomEvent) {
@@ -520,6 +702,7 @@ LoadingStatus OpenDemoFile(int demoNumber)
 		return LoadingStatus::UnsupportedVersion;
 	}
 	DemoNumber = demoNumber;
+	PlaybackBlock = {};
 
 	gSaveNumber = ReadLE32(DemoFile);
 	ReadSettings(DemoFile, DemoFileVersion);
@@ -529,9 +712,14 @@ LoadingStatus OpenDemoFile(int demoNumber)
 
 std::optional<DemoMsg> ReadDemoMessage()
 {
-	const uint8_t typeNum = DemoFileVersion >= 2 ? ReadByte(DemoFile) : ReadLE32(DemoFile);
+	if (UsesBlocks() && !HasBlockData()) {
+		CloseDemoFile();
+		return std::nullopt;
+	}
+
+	const uint8_t typeNum = DemoFileVersion >= 2 ? ReadDemoByte() : ReadDemoLE32();
 
-	if (std::feof(DemoFile) != 0) {
+	if (!UsesBlocks() && std::feof(DemoFile) != 0) {
 		CloseDemoFile();
 		return std::nullopt;
 	}
@@ -542,7 +730,7 @@ std::optional<DemoMsg> ReadDemoMessage()
 		DemoModeLastTick = SDL_GetTicks();
 		return DemoMsg { DemoMsg::Rendering, static_cast<uint8_t>(typeNum & 0b01111111u), {} };
 	}
-	const uint8_t progressToNextGameTick = ReadByte(DemoFile);
+	const uint8_t progressToNextGameTick = ReadDemoByte();
 
 	switch (typeNum) {
 	case DemoMsg::GameTick:
@@ -550,29 +738,29 @@ std::optional<DemoMsg> ReadDemoMessage()
 		DemoModeLastTick = SDL_GetTicks();
 		return DemoMsg { static_cast<DemoMsg::EventType>(typeNum), progressToNextGameTick, {} };
 	default: {
-		const uint8_t eventType = DemoFileVersion >= 2 ? typeNum : MapPreV2DemoMsgEventType(static_cast<uint16_t>(ReadLE32(DemoFile)));
+		const uint8_t eventType = DemoFileVersion >= 2 ? typeNum : MapPreV2DemoMsgEventType(static_cast<uint16_t>(ReadDemoLE32()));
 		DemoMsg result { static_cast<DemoMsg::EventType>(eventType), progressToNextGameTick, {} };
 		switch (eventType) {
 		case DemoMsg::MouseMotionEvent: {
-			result.motion.x = ReadLE16(DemoFile);
-			result.motion.y = ReadLE16(DemoFile);
+			result.motion.x = ReadDemoLE16();
+			result.motion.y = ReadDemoLE16();
 		} break;
 		case DemoMsg::MouseButtonDownEvent:
 		case DemoMsg::MouseButtonUpEvent: {
-			result.button.button = ReadByte(DemoFile);
-			result.button.x = ReadLE16(DemoFile);
-			result.button.y = ReadLE16(DemoFile);
-			result.button.mod = ReadLE16(DemoFile);
+			result.button.button = ReadDemoByte();
+			result.button.x = ReadDemoLE16();
+			result.button.y = ReadDemoLE16();
+			result.button.mod = ReadDemoLE16();
 		} break;
 		case DemoMsg::MouseWheelEvent: {
-			result.wheel.x = DemoFileVersion >= 2 ? ReadLE16<int16_t>(DemoFile) : static_cast<int16_t>(ReadLE32<int32_t>(DemoFile));
-			result.wheel.y = DemoFileVersion >= 2 ? ReadLE16<int16_t>(DemoFile) : static_cast<int16_t>(ReadLE32<int32_t>(DemoFile));
-			result.wheel.mod = ReadLE16(DemoFile);
+			result.wheel.x = DemoFileVersion >= 2 ? static_cast<int16_t>(ReadDemoLE16()) : static_cast<int16_t>(static_cast<int32_t>(ReadDemoLE32()));
+			result.wheel.y = DemoFileVersion >= 2 ? static_cast<int16_t>(ReadDemoLE16()) : static_cast<int16_t>(static_cast<int32_t>(ReadDemoLE32()));
+			result.wheel.mod = ReadDemoLE16();
 		} break;
 		case DemoMsg::KeyDownEvent:
 		case DemoMsg::KeyUpEvent: {
-			result.key.sym = static_cast<SDL_Keycode>(ReadLE32(DemoFile));
-			result.key.mod = static_cast<SDL_Keymod>(ReadLE16(DemoFile));
+			result.key.sym = static_cast<SDL_Keycode>(ReadDemoLE32());
+			result.key.mod = static_cast<SDL_Keymod>(ReadDemoLE16());
 		} break;
 		case DemoMsg::QuitEvent: // SDL_QUIT
 			break;
@@ -591,20 +779,21 @@ std::optional<DemoMsg> ReadDemoMessage()
 void WriteDemoMsgHeader(DemoMsg::EventType type)
 {
 	if (type == DemoMsg::Rendering && ProgressToNextGameTick <= 127) {
-		WriteByte(DemoRecording, ProgressToNextGameTick | 0b10000000);
+		WriteDemoByte(ProgressToNextGameTick | 0b10000000);
 		return;
 	}
-	WriteByte(DemoRecording, type);
-	WriteByte(DemoRecording, ProgressToNextGameTick);
+	WriteDemoByte(type);
+	WriteDemoByte(ProgressToNextGameTick);
 }
 
 } // namespace
 
 namespace demo {
 
-void InitPlayBack(int demoNumber, bool timedemo)
+void InitPlayBack(int demoNumber, bool timedemo, bool noRender)
 {
-	Timedemo = timedemo;
+	Timedemo = timedemo || noRender;
+	NoRender = noRender;
 	ControlMode = ControlTypes::KeyboardAndMouse;
 
 	const LoadingStatus status = OpenDemoFile(demoNumber);
@@ -622,6 +811,11 @@ void InitPlayBack(int demoNumber, bool timedemo)
 	diablo_quit(1);
 }
 
+void SeekPlayBack(int tick)
+{
+	SeekTick = tick;
+}
+
 void InitRecording(int recordNumber, bool createDemoReference)
 {
 	RecordNumber = recordNumber;
@@ -663,6 +857,7 @@ void OverrideOptions()
 	options.Gameplay.numFullManaPotionPickup.SetValue(DemoSettings.numFullManaPotionPickup);
 	options.Gameplay.numRejuPotionPickup.SetValue(DemoSettings.numRejuPotionPickup);
 	options.Gameplay.numFullRejuPotionPickup.SetValue(DemoSettings.numFullRejuPotionPickup);
+	ApplyDemoKeymap();
 }
 
 bool IsRunning()
@@ -687,9 +882,10 @@ bool GetRunGameLoop(bool &drawGame, bool &processInput)
 	if (CurrentDemoMessage->isEvent())
 		app_fatal("Unexpected event demo message in GetRunGameLoop");
 	LogDemoMessage(dmsg);
-	if (Timedemo) {
+	const bool seeking = LogicTick < SeekTick;
+	if (Timedemo || seeking) {
 		// disable additional rendering to speedup replay
-		drawGame = dmsg.type == DemoMsg::GameTick && !HeadlessMode;
+		drawGame = dmsg.type == DemoMsg::GameTick && !HeadlessMode && !NoRender && !seeking;
 	} else {
 		const int currentTickCount = SDL_GetTicks();
 		const int ticksElapsed = currentTickCount - DemoModeLastTick;
@@ -716,8 +912,11 @@ bool GetRunGameLoop(bool &drawGame, bool &processInput)
 	ProgressToNextGameTick = dmsg.progressToNextGameTick;
 	const bool isGameTick = dmsg.type == DemoMsg::GameTick;
 	CurrentDemoMessage = std::nullopt;
-	if (isGameTick)
+	if (isGameTick) {
 		LogicTick++;
+		if (LogicTick == SeekTick)
+			Log("Demo: reached game tick {}", SeekTick);
+	}
 	return isGameTick;
 }
 
@@ -762,6 +961,7 @@ bool FetchMessage(SDL_Event *event, uint16_t *modState)
 				CurrentDemoMessage = std::nullopt;
 				DemoNumber = -1;
 				Timedemo = false;
+				NoRender = false;
 				last_tick = SDL_GetTicks();
 			} else if (IsAnyOf(key, SDLK_KP_PLUS, SDLK_PLUS) && sgGameInitInfo.nTickRate < 255) {
 				sgGameInitInfo.nTickRate++;
@@ -793,6 +993,8 @@ bool FetchMessage(SDL_Event *event, uint16_t *modState)
 
 void RecordGameLoopResult(bool runGameLoop)
 {
+	if (runGameLoop && (RecordingBlock.data.size() >= DemoBlockSize || static_cast<uint32_t>(LogicTick) - RecordingBlock.firstTick >= DemoBlockTicks))
+		FlushRecordingBlock();
 	WriteDemoMsgHeader(runGameLoop ? DemoMsg::GameTick : DemoMsg::Rendering);
 
 	if (runGameLoop && !IsRunning())
@@ -812,8 +1014,8 @@ void RecordMessage(const SDL_Event &event, uint16_t modState)
 	case SDL_MOUSEMOTION:
 #endif
 		WriteDemoMsgHeader(DemoMsg::MouseMotionEvent);
-		WriteLE16(DemoRecording, event.motion.x);
-		WriteLE16(DemoRecording, event.motion.y);
+		WriteDemoLE16(event.motion.x);
+		WriteDemoLE16(event.motion.y);
 		break;
 #ifdef USE_SDL3
 	case SDL_EVENT_MOUSE_BUTTON_DOWN:
@@ -825,9 +1027,9 @@ void RecordMessage(const SDL_Event &event, uint16_t modState)
 #ifdef USE_SDL1
 		if (event.button.button == SDL_BUTTON_WHEELUP || event.button.button == SDL_BUTTON_WHEELDOWN) {
 			WriteDemoMsgHeader(DemoMsg::MouseWheelEvent);
-			WriteLE16(DemoRecording, 0);
-			WriteLE16(DemoRecording, event.button.button == SDL_BUTTON_WHEELUP ? 1 : -1);
-			WriteLE16(DemoRecording, modState);
+			WriteDemoLE16(0);
+			WriteDemoLE16(event.button.button == SDL_BUTTON_WHEELUP ? 1 : -1);
+			WriteDemoLE16(modState);
 		} else {
 #endif
 			WriteDemoMsgHeader(
@@ -838,10 +1040,10 @@ void RecordMessage(const SDL_Event &event, uint16_t modState)
 #endif
 			        ? DemoMsg::MouseButtonDownEvent
 			        : DemoMsg::MouseButtonUpEvent);
-			WriteByte(DemoRecording, event.button.button);
-			WriteLE16(DemoRecording, event.button.x);
-			WriteLE16(DemoRecording, event.button.y);
-			WriteLE16(DemoRecording, modState);
+			WriteDemoByte(event.button.button);
+			WriteDemoLE16(event.button.x);
+			WriteDemoLE16(event.button.y);
+			WriteDemoLE16(modState);
 #ifdef USE_SDL1
 		}
 #endif
@@ -870,8 +1072,8 @@ void RecordMessage(const SDL_Event &event, uint16_t modState)
 			app_fatal(StrCat("Mouse wheel event integer_x/y out of int16_t range. x=",
 			    wheelX, " y=", wheelY));
 		}
-		WriteLE16(DemoRecording, wheelX);
-		WriteLE16(DemoRecording, wheelY);
+		WriteDemoLE16(wheelX);
+		WriteDemoLE16(wheelY);
 #else
 		if (event.wheel.x < std::numeric_limits<int16_t>::min()
 		    || event.wheel.x > std::numeric_limits<int16_t>::max()
@@ -880,25 +1082,25 @@ void RecordMessage(const SDL_Event &event, uint16_t modState)
 			app_fatal(StrCat("Mouse wheel event x/y out of int16_t range. x=",
 			    event.wheel.x, " y=", event.wheel.y));
 		}
-		WriteLE16(DemoRecording, event.wheel.x);
-		WriteLE16(DemoRecording, event.wheel.y);
+		WriteDemoLE16(event.wheel.x);
+		WriteDemoLE16(event.wheel.y);
 #endif
-		WriteLE16(DemoRecording, modState);
+		WriteDemoLE16(modState);
 		break;
 #endif
 #ifdef USE_SDL3
 	case SDL_EVENT_KEY_DOWN:
 	case SDL_EVENT_KEY_UP:
 		WriteDemoMsgHeader(event.key.down ? DemoMsg::KeyDownEvent : DemoMsg::KeyUpEvent);
-		WriteLE32(DemoRecording, static_cast<uint32_t>(event.key.key));
-		WriteLE16(DemoRecording, static_cast<uint16_t>(event.key.mod));
+		WriteDemoLE32(static_cast<uint32_t>(event.key.key));
+		WriteDemoLE16(static_cast<uint16_t>(event.key.mod));
 		break;
 #else
 	case SDL_KEYDOWN:
 	case SDL_KEYUP:
 		WriteDemoMsgHeader(event.type == SDL_KEYDOWN ? DemoMsg::KeyDownEvent : DemoMsg::KeyUpEvent);
-		WriteLE32(DemoRecording, static_cast<uint32_t>(event.key.keysym.sym));
-		WriteLE16(DemoRecording, static_cast<uint16_t>(event.key.keysym.mod));
+		WriteDemoLE32(static_cast<uint32_t>(event.key.keysym.sym));
+		WriteDemoLE16(static_cast<uint16_t>(event.key.keysym.mod));
 		break;
 #endif
 #ifndef USE_SDL1
@@ -932,6 +1134,9 @@ void NotifyGameLoopStart()
 
 	if (IsRunning()) {
 		StartTime = SDL_GetTicks();
+		SetFrameStatsEnabled(true);
+		if (NoRender)
+			SetTickTimingEnabled(true);
 	}
 
 	if (IsRecording()) {
@@ -945,12 +1150,20 @@ void NotifyGameLoopStart()
 		WriteByte(DemoRecording, Version);
 		WriteLE32(DemoRecording, gSaveNumber);
 		WriteSettings(DemoRecording);
+		RecordingBlock = {};
 	}
 }
 
+void FlushRecording()
+{
+	if (IsRecording() && DemoRecording != nullptr)
+		FlushRecordingBlock();
+}
+
 void NotifyGameLoopEnd()
 {
 	if (IsRecording()) {
+		FlushRecordingBlock();
 		std::fclose(DemoRecording);
 		DemoRecording = nullptr;
 		if (CreateDemoReference)
@@ -962,7 +1175,14 @@ void NotifyGameLoopEnd()
 
 	if (IsRunning() && !HeadlessMode) {
 		const float seconds = (SDL_GetTicks() - StartTime) / 1000.0F;
-		Log("{} frames, {:.2f} seconds: {:.1f} fps", LogicTick, seconds, LogicTick / seconds);
+		if (NoRender) {
+			Log("{} ticks, {:.2f} seconds: {:.1f} ticks/s", LogicTick, seconds, LogicTick / seconds);
+			if (IsTickTimingEnabled())
+				Log("{}", FormatTickTimingTotals());
+		} else {
+			Log("{} frames, {:.2f} seconds: {:.1f} fps", LogicTick, seconds, LogicTick / seconds);
+		}
+		Log("{}", FormatFrameStats());
 		gbRunGameResult = false;
 		gbRunGame = false;
 
@@ -18,7 +18,13 @@ namespace devilution {
 namespace demo {
 
 #ifndef DISABLE_DEMOMODE
-void InitPlayBack(int demoNumber, bool timedemo);
+/**
+ * @param timedemo Replay as fast as possible
+ * @param noRender Replay as fast as possible without drawing anything, to measure the game logic alone
+ */
+void InitPlayBack(int demoNumber, bool timedemo, bool noRender = false);
+/** @brief Replays the first `tick` game ticks as fast as possible without drawing, then plays on as usual. */
+void SeekPlayBack(int tick);
 void InitRecording(int recordNumber, bool createDemoReference);
 void OverrideOptions();
 
@@ -32,6 +38,8 @@ void RecordMessage(const SDL_Event &event, uint16_t modState);
 
 void NotifyGameLoopStart();
 void NotifyGameLoopEnd();
+/** @brief Writes out what has been recorded so far, for when the game quits without ending the game loop. */
+void FlushRecording();
 
 uint32_t SimulateMillisecondsSinceStartup();
 #else
@@ -66,6 +74,9 @@ inline void NotifyGameLoopStart()
 inline void NotifyGameLoopEnd()
 {
 }
+inline void FlushRecording()
+{
+}
 inline uint32_t SimulateMillisecondsSinceStartup()
 {
 	return 0;
@@ -5,7 +5,13 @@
  */
 #include "engine/dx.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
+#include <thread>
+#include <vector>
 
 #ifdef USE_SDL3
 #include <SDL3/SDL_rect.h>
@@ -19,12 +25,15 @@
 
 #include "controls/control_mode.hpp"
 #include "controls/plrctrls.h"
+#include "engine/backbuffer_state.hpp"
+#include "engine/frame_pacer.hpp"
 #include "engine/render/primitive_render.hpp"
 #include "headless_mode.hpp"
 #include "init.hpp"
 #include "options.h"
 #include "utils/display.h"
 #include "utils/log.hpp"
+#include "utils/sdl_compat.h"
 #include "utils/sdl_wrap.h"
 
 #ifndef USE_SDL1
@@ -46,6 +55,11 @@ SDLTextureUniquePtr texture;
 /** Currently active palette */
 SDLPaletteUniquePtr Palette;
 
+#ifdef DEVILUTIONX_PALETTED_TEXTURE
+/** 8-bit renderer texture that the renderer applies `Palette` to, null if the renderer can't */
+SDLTextureUniquePtr PalettedTexture;
+#endif
+
 /** 24-bit renderer texture surface */
 SDLSurfaceUniquePtr RendererTextureSurface;
 
@@ -53,6 +67,35 @@ SDLSurfaceUniquePtr RendererTextureSurface;
 SDL_Surface *PalSurface;
 namespace {
 SDLSurfaceUniquePtr PinnedPalSurface;
+
+/** Copy of the back buffer as of the blits to the output, empty when it can't be trusted. */
+std::vector<uint8_t> BlittedPalSurface;
+
+void RememberBlittedArea(const SDL_Rect *area)
+{
+	const size_t pitch = static_cast<size_t>(PalSurface->pitch);
+	if (BlittedPalSurface.empty()) {
+		// Only a full blit makes the copy trustworthy again.
+		if (area != nullptr && (area->x > 0 || area->y > 0 || area->x + area->w < PalSurface->w || area->y + area->h < PalSurface->h))
+			return;
+		BlittedPalSurface.resize(pitch * static_cast<size_t>(PalSurface->h));
+	}
+	int left = 0;
+	int top = 0;
+	int right = PalSurface->w;
+	int bottom = PalSurface->h;
+	if (area != nullptr) {
+		left = std::max<int>(area->x, left);
+		top = std::max<int>(area->y, top);
+		right = std::min<int>(area->x + area->w, right);
+		bottom = std::min<int>(area->y + area->h, bottom);
+	}
+	const auto *src = static_cast<const uint8_t *>(PalSurface->pixels);
+	for (int y = top; y < bottom && left < right; y++) {
+		const size_t offset = static_cast<size_t>(y) * pitch + static_cast<size_t>(left);
+		std::memcpy(&BlittedPalSurface[offset], &src[offset], static_cast<size_t>(right - left));
+	}
+}
 } // namespace
 
 /** Whether we render directly to the screen surface, i.e. `PalSurface == GetOutputSurface()` */
@@ -81,21 +124,132 @@ bool CanRenderDirectlyToOutputSurface()
 #endif
 }
 
+/** Time between frames in audio-first mode, frequent enough for someone glancing at the panels. */
+constexpr uint32_t AudioFirstPresentIntervalMs = 250;
+
+uint32_t LastPresentMs;
+
+#ifndef USE_SDL1
+/** The part of the output surface that changed since the last present, only that is uploaded to the texture. */
+SDL_Rect OutputChangedArea {};
+bool OutputChangedEverywhere = true;
+
+void AddOutputChangedArea(const SDL_Rect *area)
+{
+	if (area == nullptr) {
+		OutputChangedEverywhere = true;
+		return;
+	}
+	if (area->w <= 0 || area->h <= 0)
+		return;
+	if (OutputChangedArea.w <= 0 || OutputChangedArea.h <= 0) {
+		OutputChangedArea = *area;
+		return;
+	}
+	const int left = std::min(OutputChangedArea.x, area->x);
+	const int top = std::min(OutputChangedArea.y, area->y);
+	const int right = std::max(OutputChangedArea.x + OutputChangedArea.w, area->x + area->w);
+	const int bottom = std::max(OutputChangedArea.y + OutputChangedArea.h, area->y + area->h);
+	OutputChangedArea = { left, top, right - left, bottom - top };
+}
+
+/** @brief Uploads what changed on the output surface since the last present to the renderer's texture. */
+void UpdateTextureFromOutput(SDL_Surface *surface)
+{
+	const SDL_Rect *area = nullptr;
+	const void *pixels = surface->pixels;
+	if (!OutputChangedEverywhere) {
+		SDL_Rect &changed = OutputChangedArea;
+		// The blits may have reached past the edges of the surface.
+		const int right = std::min(changed.x + changed.w, surface->w);
+		const int bottom = std::min(changed.y + changed.h, surface->h);
+		changed.x = std::max(changed.x, 0);
+		changed.y = std::max(changed.y, 0);
+		changed.w = right - changed.x;
+		changed.h = bottom - changed.y;
+		if (changed.w <= 0 || changed.h <= 0)
+			return;
+		area = &changed;
+		pixels = static_cast<const uint8_t *>(surface->pixels) + static_cast<ptrdiff_t>(area->y) * surface->pitch + area->x * (SDLC_SURFACE_BITSPERPIXEL(surface) / 8);
+	}
+#ifdef USE_SDL3
+	if (!SDL_UpdateTexture(texture.get(), area, pixels, surface->pitch)) ErrSdl();
+#else
+	if (SDL_UpdateTexture(texture.get(), area, pixels, surface->pitch) <= -1) ErrSdl();
+#endif
+	OutputChangedArea = {};
+	OutputChangedEverywhere = false;
+}
+#endif
+
+#ifdef DEVILUTIONX_PALETTED_TEXTURE
+/** Whether the last frame went to `PalettedTexture` rather than the output surface. */
+bool PresentPalettedTexture = false;
+
+/** @brief Uploads part of the back buffer to the paletted texture, clipped the same way as SDL_BlitSurface. */
+void UpdatePalettedTexture(const SDL_Rect *srcRect, const SDL_Rect *dstRect)
+{
+	SDL_Rect src = srcRect != nullptr ? *srcRect : SDL_Rect { 0, 0, PalSurface->w, PalSurface->h };
+	SDL_Rect dst = { dstRect != nullptr ? dstRect->x : 0, dstRect != nullptr ? dstRect->y : 0, src.w, src.h };
+
+	const int skipX = std::max({ 0, -src.x, -dst.x });
+	const int skipY = std::max({ 0, -src.y, -dst.y });
+	src.x += skipX;
+	dst.x += skipX;
+	src.y += skipY;
+	dst.y += skipY;
+	dst.w = std::min({ src.w - skipX, PalSurface->w - src.x, gnScreenWidth - dst.x });
+	dst.h = std::min({ src.h - skipY, PalSurface->h - src.y, gnScreenHeight - dst.y });
+	PresentPalettedTexture = true;
+	if (dst.w <= 0 || dst.h <= 0)
+		return;
+
+	const auto *pixels = static_cast<const uint8_t *>(PalSurface->pixels) + static_cast<ptrdiff_t>(src.y) * PalSurface->pitch + src.x;
+	if (!SDL_UpdateTexture(PalettedTexture.get(), &dst, pixels, PalSurface->pitch)) ErrSdl();
+}
+#endif
+
+/**
+ * @brief Sleeps until `deadline`, closer to it than the millisecond SDL_Delay() can manage
+ */
+void SleepUntil(FramePacer::Clock::time_point deadline)
+{
+	const auto now = FramePacer::Clock::now();
+	if (deadline <= now)
+		return;
+#ifdef USE_SDL3
+	SDL_DelayPrecise(static_cast<Uint64>(std::chrono::duration_cast<std::chrono::nanoseconds>(deadline - now).count()));
+#else
+	// SDL_Delay() may oversleep by a scheduler quantum, so only sleep through most of the wait
+	// and yield for the rest.
+	constexpr auto SpinMargin = std::chrono::milliseconds { 2 };
+	const auto sleep = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - now - SpinMargin);
+	if (sleep.count() > 0)
+		SDL_Delay(static_cast<uint32_t>(sleep.count()));
+	while (FramePacer::Clock::now() < deadline)
+		std::this_thread::yield();
+#endif
+}
+
+/**
+ * @brief Ends timing the frame right before it is presented, so waiting for v-sync doesn't count towards its cost
+ */
+void EndFrameTiming()
+{
+	GetFramePacer().EndFrame(FramePacer::Clock::now());
+}
+
 /**
  * @brief Limit FPS to avoid high CPU load, use when v-sync isn't available
  */
 void LimitFrameRate()
 {
+	const auto now = FramePacer::Clock::now();
 	if (*GetOptions().Graphics.frameRateControl != FrameRateControl::CPUSleep)
 		return;
-	static uint32_t frameDeadline;
-	const uint32_t tc = SDL_GetTicks() * 1000;
-	uint32_t v = 0;
-	if (frameDeadline > tc) {
-		v = tc % refreshDelay;
-		SDL_Delay(v / 1000 + 1); // ceil
-	}
-	frameDeadline = tc + v + refreshDelay;
+	static FramePacer::Clock::time_point frameDeadline;
+	SleepUntil(frameDeadline);
+	frameDeadline = NextFrameDeadline(frameDeadline, now, std::chrono::microseconds { refreshDelay });
 }
 
 } // namespace
@@ -110,6 +264,7 @@ void dx_init()
 	Palette = SDLWrap::AllocPalette();
 	palette_init();
 	CreateBackBuffer();
+	ReinitializePalettedTexture();
 }
 
 Surface GlobalBackBuffer()
@@ -128,6 +283,9 @@ void dx_cleanup()
 	PinnedPalSurface = nullptr;
 	Palette = nullptr;
 	RendererTextureSurface = nullptr;
+#ifdef DEVILUTIONX_PALETTED_TEXTURE
+	PalettedTexture = nullptr;
+#endif
 #ifndef USE_SDL1
 	texture = nullptr;
 	FreeVirtualGamepadTextures();
@@ -152,6 +310,7 @@ void CreateBackBuffer()
 		    SDL_PIXELFORMAT_INDEX8);
 		PalSurface = PinnedPalSurface.get();
 	}
+	ForgetBlittedBackBuffer();
 
 #if defined(USE_SDL3)
 	if (!SDL_SetSurfacePalette(PalSurface, Palette.get())) ErrSdl();
@@ -170,7 +329,62 @@ void BltFast(SDL_Rect *srcRect, SDL_Rect *dstRect)
 {
 	if (RenderDirectlyToOutputSurface)
 		return;
-	Blit(PalSurface, srcRect, dstRect);
+#ifdef DEVILUTIONX_PALETTED_TEXTURE
+	if (PalettedTexture != nullptr) {
+		if (!HeadlessMode)
+			UpdatePalettedTexture(srcRect, dstRect);
+	} else
+#endif
+		Blit(PalSurface, srcRect, dstRect);
+	if (srcRect == nullptr || (dstRect != nullptr && srcRect->x == dstRect->x && srcRect->y == dstRect->y))
+		RememberBlittedArea(srcRect);
+	else
+		ForgetBlittedBackBuffer();
+}
+
+void ForgetBlittedBackBuffer()
+{
+	BlittedPalSurface.clear();
+}
+
+Rectangle GetChangedBackBufferArea(Rectangle area)
+{
+	if (BlittedPalSurface.empty() || RenderDirectlyToOutputSurface)
+		return area;
+	const int left = std::max(area.position.x, 0);
+	const int top = std::max(area.position.y, 0);
+	const int right = std::min(area.position.x + area.size.width, PalSurface->w);
+	const int bottom = std::min(area.position.y + area.size.height, PalSurface->h);
+	if (left >= right || top >= bottom)
+		return {};
+
+	const size_t pitch = static_cast<size_t>(PalSurface->pitch);
+	const size_t width = static_cast<size_t>(right - left);
+	const auto *pixels = static_cast<const uint8_t *>(PalSurface->pixels);
+	int changedTop = bottom;
+	int changedBottom = top;
+	int changedLeft = right;
+	int changedRight = left;
+	for (int y = top; y < bottom; y++) {
+		const size_t offset = static_cast<size_t>(y) * pitch + static_cast<size_t>(left);
+		const uint8_t *now = &pixels[offset];
+		const uint8_t *before = &BlittedPalSurface[offset];
+		if (std::memcmp(now, before, width) == 0)
+			continue;
+		changedTop = std::min(changedTop, y);
+		changedBottom = y + 1;
+		int x = 0;
+		while (now[x] == before[x])
+			x++;
+		changedLeft = std::min(changedLeft, left + x);
+		x = static_cast<int>(width) - 1;
+		while (now[x] == before[x])
+			x--;
+		changedRight = std::max(changedRight, left + x + 1);
+	}
+	if (changedTop >= changedBottom)
+		return {};
+	return { { changedLeft, changedTop }, { changedRight - changedLeft, changedBottom - changedTop } };
 }
 
 void Blit(SDL_Surface *src, SDL_Rect *srcRect, SDL_Rect *dstRect)
@@ -181,9 +395,12 @@ void Blit(SDL_Surface *src, SDL_Rect *srcRect, SDL_Rect *dstRect)
 	SDL_Surface *dst = GetOutputSurface();
 #if defined(USE_SDL3)
 	if (!SDL_BlitSurface(src, srcRect, dst, dstRect)) ErrSdl();
+	AddOutputChangedArea(dstRect);
 #elif !defined(USE_SDL1)
 	if (SDL_BlitSurface(src, srcRect, dst, dstRect) < 0)
 		ErrSdl();
+	// SDL clipped the destination to what was actually drawn.
+	AddOutputChangedArea(dstRect);
 #else
 	if (!OutputRequiresScaling()) {
 		if (SDL_BlitSurface(src, srcRect, dst, dstRect) < 0)
@@ -228,14 +445,67 @@ void Blit(SDL_Surface *src, SDL_Rect *srcRect, SDL_Rect *dstRect)
 #endif
 }
 
+void InvalidateOutputSurface()
+{
+#ifndef USE_SDL1
+	OutputChangedEverywhere = true;
+#endif
+#ifdef DEVILUTIONX_PALETTED_TEXTURE
+	PresentPalettedTexture = false;
+#endif
+}
+
+bool IsPresentingPalettedFrames()
+{
+#ifdef DEVILUTIONX_PALETTED_TEXTURE
+	return PalettedTexture != nullptr;
+#else
+	return false;
+#endif
+}
+
+void ReinitializePalettedTexture()
+{
+#ifdef DEVILUTIONX_PALETTED_TEXTURE
+	PalettedTexture = nullptr;
+	PresentPalettedTexture = false;
+	if (renderer == nullptr || Palette == nullptr)
+		return;
+
+	PalettedTexture = SDLTextureUniquePtr { SDL_CreateTexture(renderer, SDL_PIXELFORMAT_INDEX8, SDL_TEXTUREACCESS_STREAMING, gnScreenWidth, gnScreenHeight) };
+	if (PalettedTexture == nullptr || !SDL_SetTexturePalette(PalettedTexture.get(), Palette.get())) {
+		Log("Presenting frames without a paletted texture: {}", SDL_GetError());
+		SDL_ClearError();
+		PalettedTexture = nullptr;
+		return;
+	}
+	// Nothing on the new texture is valid yet.
+	ForgetBlittedBackBuffer();
+	RedrawEverything();
+#endif
+}
+
+bool IsAudioFirstMode()
+{
+	return *GetOptions().Graphics.audioFirst;
+}
+
+bool IsAudioFirstFrameDue()
+{
+	return static_cast<uint32_t>(SDL_GetTicks()) - LastPresentMs >= AudioFirstPresentIntervalMs;
+}
+
 void RenderPresent()
 {
 	if (HeadlessMode)
 		return;
 
+	LastPresentMs = static_cast<uint32_t>(SDL_GetTicks());
+
 	SDL_Surface *surface = GetOutputSurface();
 
 	if (!gbActive) {
+		EndFrameTiming();
 		LimitFrameRate();
 		return;
 	}
@@ -245,28 +515,34 @@ void RenderPresent()
 #ifdef USE_SDL3
 		if (!SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255)) ErrSdl();
 		if (!SDL_RenderClear(renderer)) ErrSdl();
-		if (!SDL_UpdateTexture(texture.get(), nullptr, surface->pixels, surface->pitch)) ErrSdl();
-		if (!SDL_RenderTexture(renderer, texture.get(), nullptr, nullptr)) ErrSdl();
+#ifdef DEVILUTIONX_PALETTED_TEXTURE
+		if (PresentPalettedTexture) {
+			if (!SDL_RenderTexture(renderer, PalettedTexture.get(), nullptr, nullptr)) ErrSdl();
+		} else
+#endif
+		{
+			UpdateTextureFromOutput(surface);
+			if (!SDL_RenderTexture(renderer, texture.get(), nullptr, nullptr)) ErrSdl();
+		}
 #else
 		if (SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255) <= -1) ErrSdl();
 		if (SDL_RenderClear(renderer) <= -1) ErrSdl();
-		if (SDL_UpdateTexture(texture.get(), nullptr, surface->pixels, surface->pitch) <= -1) ErrSdl();
+		UpdateTextureFromOutput(surface);
 		if (SDL_RenderCopy(renderer, texture.get(), nullptr, nullptr) <= -1) ErrSdl();
 #endif
 
 		if (ControlMode == ControlTypes::VirtualGamepad) {
 			RenderVirtualGamepad(renderer);
 		}
+		EndFrameTiming();
 		SDL_RenderPresent(renderer);
-
-		if (*GetOptions().Graphics.frameRateControl != FrameRateControl::VerticalSync) {
-			LimitFrameRate();
-		}
+		LimitFrameRate();
 	} else {
 		if (ControlMode == ControlTypes::VirtualGamepad) {
 			RenderVirtualGamepad(surface);
 		}
 
+		EndFrameTiming();
 #ifdef USE_SDL3
 		if (!SDL_UpdateWindowSurface(ghMainWnd)) ErrSdl();
 #else
@@ -278,6 +554,7 @@ void RenderPresent()
 		LimitFrameRate();
 	}
 #else
+	EndFrameTiming();
 	if (SDL_Flip(surface) <= -1) {
 		ErrSdl();
 	}
@@ -27,7 +27,30 @@ void dx_init();
 void dx_cleanup();
 void CreateBackBuffer();
 void BltFast(SDL_Rect *srcRect, SDL_Rect *dstRect);
+/**
+ * @brief The part of `area` on the back buffer that differs from what BltFast() last sent to the output.
+ * @return `area` itself if that isn't known, an empty rectangle if nothing changed
+ */
+[[nodiscard]] Rectangle GetChangedBackBufferArea(Rectangle area);
+/** @brief Has the next blits send everything again, e.g. because the palette changed under the same pixels. */
+void ForgetBlittedBackBuffer();
 void Blit(SDL_Surface *src, SDL_Rect *srcRect, SDL_Rect *dstRect);
 void RenderPresent();
+/** @brief Has the whole output surface presented again, after it was drawn to without Blit(). */
+void InvalidateOutputSurface();
+
+/**
+ * @brief Whether BltFast() sends the back buffer to the renderer as palette indices.
+ *
+ * The renderer then applies the palette itself, so palette changes don't change what was sent.
+ */
+[[nodiscard]] bool IsPresentingPalettedFrames();
+/** @brief Creates the 8-bit texture for the current renderer and resolution, if the renderer supports it. */
+void ReinitializePalettedTexture();
+
+/** @brief Whether the "Audio-First Mode" option is on, where the dungeon isn't drawn and frames are presented only a few times per second. */
+[[nodiscard]] bool IsAudioFirstMode();
+/** @brief Whether enough time passed since the last frame to present another one in audio-first mode. */
+[[nodiscard]] bool IsAudioFirstFrameDue();
 
 } // namespace devilution
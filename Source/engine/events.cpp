@@ -17,6 +17,7 @@
 #include "controls/padmapper.hpp"
 #include "engine/demomode.h"
 #include "engine/render/primitive_render.hpp"
+#include "headless_mode.hpp"
 #include "interfac.h"
 #include "movie.h"
 #include "options.h"
@@ -211,6 +212,19 @@ bool FetchMessage(SDL_Event *event, uint16_t *modState)
 	return available;
 }
 
+void WaitForMessage(uint32_t timeoutMs)
+{
+#ifndef USE_SDL1
+	// SDL only processes events on the thread that created the window, so waiting here is the
+	// earliest the game can see them.
+	if (!HeadlessMode) {
+		SDL_WaitEventTimeout(nullptr, static_cast<int>(timeoutMs));
+		return;
+	}
+#endif
+	SDL_Delay(timeoutMs);
+}
+
 void HandleMessage(const SDL_Event &event, uint16_t modState)
 {
 	assert(CurrentEventHandler != nullptr);
@@ -25,6 +25,13 @@ EventHandler SetEventHandler(EventHandler NewProc);
 
 bool FetchMessage(SDL_Event *event, uint16_t *modState);
 
+/**
+ * @brief Sleeps until an event is queued or the timeout has passed, leaving the event for FetchMessage.
+ *
+ * Used instead of a plain delay so input is handled as soon as it arrives while idling between game ticks.
+ */
+void WaitForMessage(uint32_t timeoutMs);
+
 void HandleMessage(const SDL_Event &event, uint16_t modState);
 
 } // namespace devilution
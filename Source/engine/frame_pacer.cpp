@@ -0,0 +1,64 @@
+/**
+ * @file frame_pacer.cpp
+ *
+ * Implementation of the frame pacer that decides when frames are drawn and presented.
+ */
+#include "engine/frame_pacer.hpp"
+
+namespace devilution {
+
+namespace {
+
+FramePacer GameFramePacer;
+
+} // namespace
+
+void FramePacer::BeginFrame(Clock::time_point now)
+{
+	frameStart_ = now;
+	timingFrame_ = true;
+}
+
+void FramePacer::EndFrame(Clock::time_point now)
+{
+	if (!timingFrame_)
+		return;
+	timingFrame_ = false;
+
+	const Clock::duration cost = now - frameStart_;
+	// Follow slower frames quickly so the next tick isn't missed, and faster ones gradually
+	// so a single quick frame doesn't undo the prediction.
+	if (cost > predictedCost_)
+		predictedCost_ += (cost - predictedCost_) / 2;
+	else
+		predictedCost_ -= (predictedCost_ - cost) / 8;
+}
+
+bool FramePacer::ShouldDraw(Clock::duration untilNextTick)
+{
+	if (untilNextTick >= predictedCost_ || skippedFrames_ >= MaxSkippedFrames) {
+		skippedFrames_ = 0;
+		return true;
+	}
+	skippedFrames_++;
+	return false;
+}
+
+void FramePacer::Reset()
+{
+	*this = {};
+}
+
+FramePacer::Clock::time_point NextFrameDeadline(FramePacer::Clock::time_point deadline, FramePacer::Clock::time_point now, FramePacer::Clock::duration interval)
+{
+	if (now - deadline >= interval)
+		return now + interval;
+	return deadline + interval;
+}
+
+FramePacer &GetFramePacer()
+{
+	return GameFramePacer;
+}
+
+} // namespace devilution
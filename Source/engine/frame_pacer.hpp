@@ -0,0 +1,61 @@
+/**
+ * @file frame_pacer.hpp
+ *
+ * Interface of the frame pacer that decides when frames are drawn and presented.
+ */
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+namespace devilution {
+
+/**
+ * @brief Predicts how long a frame takes to draw from the recent frames, so drawing can be
+ * skipped when it would delay the next game tick.
+ */
+class FramePacer {
+public:
+	using Clock = std::chrono::steady_clock;
+
+	/** Game tick frames that may be skipped in a row, so the screen keeps updating on devices that can't keep up. */
+	static constexpr uint8_t MaxSkippedFrames = 4;
+
+	/** @brief Starts timing a frame. */
+	void BeginFrame(Clock::time_point now);
+	/** @brief Ends timing the frame started with BeginFrame(), ignored if there is none. */
+	void EndFrame(Clock::time_point now);
+
+	/** @brief How long the next frame is expected to take. */
+	[[nodiscard]] Clock::duration PredictedFrameCost() const
+	{
+		return predictedCost_;
+	}
+
+	/**
+	 * @brief Whether to draw the frame of a game tick or skip it to keep up with the following ticks.
+	 * @param untilNextTick Time left until the tick after this one is due, negative if it is overdue
+	 */
+	[[nodiscard]] bool ShouldDraw(Clock::duration untilNextTick);
+
+	void Reset();
+
+private:
+	Clock::duration predictedCost_ {};
+	Clock::time_point frameStart_ {};
+	bool timingFrame_ = false;
+	uint8_t skippedFrames_ = 0;
+};
+
+/**
+ * @brief When the frame after the one due at `deadline` should be presented.
+ *
+ * Keeps the cadence of the refresh rate when a frame is slightly late, but starts over from
+ * `now` instead of rushing frames out when it is late by a whole interval.
+ */
+[[nodiscard]] FramePacer::Clock::time_point NextFrameDeadline(FramePacer::Clock::time_point deadline, FramePacer::Clock::time_point now, FramePacer::Clock::duration interval);
+
+/** @brief The pacer of the game loop. */
+FramePacer &GetFramePacer();
+
+} // namespace devilution
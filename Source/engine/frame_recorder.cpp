@@ -0,0 +1,168 @@
+/**
+ * @file frame_recorder.cpp
+ *
+ * Implementation of the compressed ring of the last presented frames.
+ */
+#include "engine/frame_recorder.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+namespace devilution {
+
+namespace {
+
+/** Shorter runs of kept pixels are stored as new pixels, as each run costs a few bytes. */
+constexpr size_t MinKeptRun = 4;
+
+void AppendVarint(std::vector<uint8_t> &out, size_t value)
+{
+	while (value >= 0x80) {
+		out.push_back(static_cast<uint8_t>(value | 0x80));
+		value >>= 7;
+	}
+	out.push_back(static_cast<uint8_t>(value));
+}
+
+[[nodiscard]] size_t ReadVarint(const uint8_t *&in)
+{
+	size_t value = 0;
+	for (unsigned shift = 0;; shift += 7) {
+		const uint8_t byte = *in++;
+		value |= static_cast<size_t>(byte & 0x7F) << shift;
+		if ((byte & 0x80) == 0)
+			return value;
+	}
+}
+
+/**
+ * @brief Appends the pixels as pairs of a run of pixels that equal `previous` and a run of new ones.
+ * @param previous The frame before, nullptr to compare against index 0
+ */
+void EncodeRuns(const uint8_t *pixels, const uint8_t *previous, size_t size, std::vector<uint8_t> &out)
+{
+	const auto isKept = [&](size_t i) {
+		return pixels[i] == (previous != nullptr ? previous[i] : 0);
+	};
+
+	size_t i = 0;
+	while (i < size) {
+		const size_t keptStart = i;
+		while (i < size && isKept(i))
+			i++;
+		const size_t newStart = i;
+		while (i < size) {
+			if (!isKept(i)) {
+				i++;
+				continue;
+			}
+			size_t run = 1;
+			while (run < MinKeptRun && i + run < size && isKept(i + run))
+				run++;
+			if (run == MinKeptRun || i + run == size)
+				break;
+			i += run;
+		}
+		AppendVarint(out, newStart - keptStart);
+		AppendVarint(out, i - newStart);
+		out.insert(out.end(), pixels + newStart, pixels + i);
+	}
+}
+
+void DecodeRuns(const uint8_t *in, uint8_t *pixels, size_t size)
+{
+	size_t i = 0;
+	while (i < size) {
+		i += ReadVarint(in);
+		const size_t count = ReadVarint(in);
+		std::memcpy(pixels + i, in, count);
+		in += count;
+		i += count;
+	}
+}
+
+} // namespace
+
+FrameRecorder::FrameRecorder(size_t maxBytes)
+    : maxBytes_(maxBytes)
+{
+}
+
+void FrameRecorder::Add(const RecordedFrame &frame)
+{
+	const size_t size = static_cast<size_t>(frame.width) * frame.height;
+	std::vector<uint8_t> pixels(size);
+	for (size_t y = 0; y < frame.height; y++)
+		std::memcpy(&pixels[y * frame.width], frame.pixels + y * frame.pitch, frame.width);
+
+	const bool sameSize = !segments_.empty() && segments_.back().frames.back().width == frame.width
+	    && segments_.back().frames.back().height == frame.height;
+	if (!sameSize || segments_.back().frames.size() == SegmentFrames)
+		segments_.emplace_back();
+	Segment &segment = segments_.back();
+
+	const size_t dataBefore = segment.data.size();
+	segment.frames.push_back(FrameInfo {
+	    .width = frame.width,
+	    .height = frame.height,
+	    .palette = frame.palette,
+	    .frameMicroseconds = frame.frameMicroseconds,
+	    .timestampMicroseconds = frame.timestampMicroseconds,
+	    .offset = dataBefore,
+	});
+	EncodeRuns(pixels.data(), segment.frames.size() == 1 ? nullptr : previous_.data(), size, segment.data);
+	bytes_ += segment.data.size() - dataBefore + sizeof(FrameInfo);
+	frameCount_++;
+	previous_ = std::move(pixels);
+
+	while (bytes_ > maxBytes_ && segments_.size() > 1)
+		DropFront();
+}
+
+void FrameRecorder::DropBefore(uint64_t timestampMicroseconds)
+{
+	while (!segments_.empty() && segments_.front().frames.back().timestampMicroseconds < timestampMicroseconds)
+		DropFront();
+}
+
+void FrameRecorder::Clear()
+{
+	segments_.clear();
+	previous_ = {};
+	bytes_ = 0;
+	frameCount_ = 0;
+}
+
+void FrameRecorder::ForEach(tl::function_ref<void(const RecordedFrame &)> visit) const
+{
+	std::vector<uint8_t> pixels;
+	for (const Segment &segment : segments_) {
+		for (size_t i = 0; i < segment.frames.size(); i++) {
+			const FrameInfo &info = segment.frames[i];
+			const size_t size = static_cast<size_t>(info.width) * info.height;
+			if (i == 0)
+				pixels.assign(size, 0);
+			DecodeRuns(segment.data.data() + info.offset, pixels.data(), size);
+			visit(RecordedFrame {
+			    .width = info.width,
+			    .height = info.height,
+			    .pitch = info.width,
+			    .pixels = pixels.data(),
+			    .palette = info.palette,
+			    .frameMicroseconds = info.frameMicroseconds,
+			    .timestampMicroseconds = info.timestampMicroseconds,
+			});
+		}
+	}
+}
+
+void FrameRecorder::DropFront()
+{
+	const Segment &segment = segments_.front();
+	bytes_ -= segment.data.size() + segment.frames.size() * sizeof(FrameInfo);
+	frameCount_ -= segment.frames.size();
+	segments_.pop_front();
+}
+
+} // namespace devilution
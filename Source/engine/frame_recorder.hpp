@@ -0,0 +1,96 @@
+/**
+ * @file frame_recorder.hpp
+ *
+ * Interface of the compressed ring of the last presented frames, which shows what a stutter looked like.
+ */
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+#include <function_ref.hpp>
+
+namespace devilution {
+
+/** An 8-bit frame with the palette and timing it was presented with. */
+struct RecordedFrame {
+	uint16_t width = 0;
+	uint16_t height = 0;
+	/** Distance between the starts of two rows in `pixels`. */
+	uint16_t pitch = 0;
+	/** Palette index per pixel. */
+	const uint8_t *pixels = nullptr;
+	/** Red, green and blue of each palette entry. */
+	std::array<uint8_t, 256 * 3> palette {};
+	/** Time since the frame before. */
+	uint32_t frameMicroseconds = 0;
+	/** When the frame was presented, on a clock of the caller's choice. */
+	uint64_t timestampMicroseconds = 0;
+};
+
+/**
+ * @brief Keeps the last frames within a memory budget.
+ *
+ * Frames are grouped in segments. The first frame of a segment is stored whole and the others as
+ * the pixels that changed since the frame before, both as runs of kept and new pixels. Whole
+ * segments are dropped once they are too old or over the budget.
+ */
+class FrameRecorder {
+public:
+	/** Frames per segment, about a second at the usual refresh rates. */
+	static constexpr size_t SegmentFrames = 60;
+
+	explicit FrameRecorder(size_t maxBytes);
+
+	/** @brief Adds a frame, then drops the oldest segments while over the budget. */
+	void Add(const RecordedFrame &frame);
+
+	/** @brief Drops the segments whose last frame was presented before `timestampMicroseconds`. */
+	void DropBefore(uint64_t timestampMicroseconds);
+
+	void Clear();
+
+	[[nodiscard]] size_t frameCount() const
+	{
+		return frameCount_;
+	}
+
+	/** @brief Memory taken by the encoded frames. */
+	[[nodiscard]] size_t bytes() const
+	{
+		return bytes_;
+	}
+
+	/** @brief Decodes the frames, oldest first. The pixels passed to `visit` are only valid during the call. */
+	void ForEach(tl::function_ref<void(const RecordedFrame &)> visit) const;
+
+private:
+	struct FrameInfo {
+		uint16_t width;
+		uint16_t height;
+		std::array<uint8_t, 256 * 3> palette;
+		uint32_t frameMicroseconds;
+		uint64_t timestampMicroseconds;
+		/** Start of the frame's runs in the segment's data. */
+		size_t offset;
+	};
+
+	struct Segment {
+		std::vector<FrameInfo> frames;
+		std::vector<uint8_t> data;
+	};
+
+	void DropFront();
+
+	std::deque<Segment> segments_;
+	/** The pixels of the last frame, which the next one is compared to. */
+	std::vector<uint8_t> previous_;
+	size_t maxBytes_;
+	size_t bytes_ = 0;
+	size_t frameCount_ = 0;
+};
+
+} // namespace devilution
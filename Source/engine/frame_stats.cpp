@@ -0,0 +1,186 @@
+/**
+ * @file frame_stats.cpp
+ *
+ * Implementation of the frame and game tick time percentiles.
+ */
+#include "engine/frame_stats.hpp"
+
+#include <algorithm>
+#include <chrono>
+
+#include <fmt/format.h>
+
+#include "utils/str_cat.hpp"
+
+namespace devilution {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr std::array<std::string_view, 9> GameLogicStepNames {
+	"Other",
+	"ProcessPlayers",
+	"ProcessMonsters",
+	"ProcessObjects",
+	"ProcessMissiles",
+	"ProcessItems",
+	"ProcessTowners",
+	"ProcessItemsTown",
+	"ProcessMissilesTown",
+};
+static_assert(GameLogicStepNames.size() == static_cast<size_t>(GameLogicStep::ProcessMissilesTown) + 1);
+
+// Only touched by the game thread.
+bool Enabled = false;
+FrameStats Stats;
+uint32_t GameTick = 0;
+Clock::time_point LastFrame;
+bool HasLastFrame = false;
+
+Clock::time_point TickStart;
+Clock::time_point StepStart;
+GameLogicStep CurrentStep = GameLogicStep::None;
+std::array<uint32_t, GameLogicStepNames.size()> StepMicroseconds {};
+/** The slowest step of the last tick, which is blamed for the frames drawn after it. */
+GameLogicStep LastSlowestStep = GameLogicStep::None;
+uint32_t LastSlowestStepMicroseconds = 0;
+
+[[nodiscard]] uint32_t MicrosecondsSince(Clock::time_point start, Clock::time_point now)
+{
+	return static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::microseconds>(now - start).count());
+}
+
+void KeepIfSlow(std::array<SlowSample, SlowSampleCount> &slowest, uint32_t microseconds)
+{
+	if (microseconds <= slowest.back().microseconds)
+		return;
+	auto it = std::find_if(slowest.begin(), slowest.end(), [&](const SlowSample &sample) { return sample.microseconds < microseconds; });
+	std::move_backward(it, slowest.end() - 1, slowest.end());
+	*it = SlowSample {
+		.microseconds = microseconds,
+		.gameTick = GameTick,
+		.slowestStep = LastSlowestStep,
+		.slowestStepMicroseconds = LastSlowestStepMicroseconds,
+	};
+}
+
+[[nodiscard]] double Milliseconds(uint32_t microseconds)
+{
+	return microseconds / 1000.0;
+}
+
+void AppendPercentiles(std::string &out, std::string_view name, const TimeHistogram &histogram)
+{
+	StrAppend(out, fmt::format("{} p50/p95/p99/max: {:.1f}/{:.1f}/{:.1f}/{:.1f} ms", name,
+	                  Milliseconds(histogram.Percentile(0.5)), Milliseconds(histogram.Percentile(0.95)),
+	                  Milliseconds(histogram.Percentile(0.99)), Milliseconds(histogram.max())));
+}
+
+void AppendSlowest(std::string &out, std::string_view name, const std::array<SlowSample, SlowSampleCount> &slowest)
+{
+	for (const SlowSample &sample : slowest) {
+		if (sample.microseconds == 0)
+			break;
+		StrAppend(out, fmt::format("\n{} {:.1f} ms at tick {}, slowest step {} {:.1f} ms", name, Milliseconds(sample.microseconds),
+		                  sample.gameTick, GameLogicStepName(sample.slowestStep), Milliseconds(sample.slowestStepMicroseconds)));
+	}
+}
+
+} // namespace
+
+std::string_view GameLogicStepName(GameLogicStep step)
+{
+	return GameLogicStepNames[static_cast<size_t>(step)];
+}
+
+bool IsFrameStatsEnabled()
+{
+	return Enabled;
+}
+
+void SetFrameStatsEnabled(bool enabled)
+{
+	Stats = {};
+	GameTick = 0;
+	HasLastFrame = false;
+	LastSlowestStep = GameLogicStep::None;
+	LastSlowestStepMicroseconds = 0;
+	Enabled = enabled;
+}
+
+void CountFrame()
+{
+	if (!Enabled)
+		return;
+	const Clock::time_point now = Clock::now();
+	if (HasLastFrame) {
+		const uint32_t microseconds = MicrosecondsSince(LastFrame, now);
+		Stats.frames.Add(microseconds);
+		KeepIfSlow(Stats.slowestFrames, microseconds);
+	}
+	LastFrame = now;
+	HasLastFrame = true;
+}
+
+void BeginTickStats()
+{
+	if (!Enabled)
+		return;
+	TickStart = Clock::now();
+	StepStart = TickStart;
+	CurrentStep = GameLogicStep::None;
+	StepMicroseconds = {};
+	GameTick++;
+}
+
+void CountGameLogicStep(GameLogicStep next)
+{
+	if (!Enabled)
+		return;
+	const Clock::time_point now = Clock::now();
+	StepMicroseconds[static_cast<size_t>(CurrentStep)] += MicrosecondsSince(StepStart, now);
+	StepStart = now;
+	CurrentStep = next;
+}
+
+void EndTickStats()
+{
+	if (!Enabled)
+		return;
+	CountGameLogicStep(GameLogicStep::None);
+	const auto slowest = std::max_element(StepMicroseconds.begin(), StepMicroseconds.end());
+	LastSlowestStep = static_cast<GameLogicStep>(slowest - StepMicroseconds.begin());
+	LastSlowestStepMicroseconds = *slowest;
+
+	const uint32_t microseconds = MicrosecondsSince(TickStart, StepStart);
+	Stats.ticks.Add(microseconds);
+	KeepIfSlow(Stats.slowestTicks, microseconds);
+}
+
+const FrameStats &GetFrameStats()
+{
+	return Stats;
+}
+
+std::string FormatFramePercentiles()
+{
+	std::string out;
+	if (Stats.frames.count() != 0) {
+		AppendPercentiles(out, "Frame", Stats.frames);
+		out += '\n';
+	}
+	AppendPercentiles(out, "Tick", Stats.ticks);
+	return out;
+}
+
+std::string FormatFrameStats()
+{
+	std::string out = StrCat("Frame stats over ", Stats.frames.count(), " frames and ", Stats.ticks.count(), " ticks\n");
+	StrAppend(out, FormatFramePercentiles());
+	AppendSlowest(out, "Frame", Stats.slowestFrames);
+	AppendSlowest(out, "Tick", Stats.slowestTicks);
+	return out;
+}
+
+} // namespace devilution
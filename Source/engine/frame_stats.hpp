@@ -0,0 +1,70 @@
+/**
+ * @file frame_stats.hpp
+ *
+ * Interface of the frame and game tick time percentiles, which show hitches an average hides.
+ */
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "diablo.h"
+#include "utils/time_histogram.hpp"
+
+namespace devilution {
+
+/** How many of the slowest frames and ticks are kept. */
+constexpr size_t SlowSampleCount = 8;
+
+/** A slow frame or tick, with the part of the game logic that took the longest in the tick before it. */
+struct SlowSample {
+	uint32_t microseconds = 0;
+	/** Ticks since the counters were enabled. */
+	uint32_t gameTick = 0;
+	GameLogicStep slowestStep = GameLogicStep::None;
+	uint32_t slowestStepMicroseconds = 0;
+};
+
+struct FrameStats {
+	/** Time between the starts of two drawn frames. */
+	TimeHistogram frames;
+	/** Time spent in GameLogic(). */
+	TimeHistogram ticks;
+	/** Slowest first. */
+	std::array<SlowSample, SlowSampleCount> slowestFrames;
+	std::array<SlowSample, SlowSampleCount> slowestTicks;
+};
+
+/** @brief GameLogicStep::None is named "Other", as it covers everything outside of the named steps. */
+[[nodiscard]] std::string_view GameLogicStepName(GameLogicStep step);
+
+/** @brief Whether the times are collected, while the FPS are shown and during a timedemo. */
+[[nodiscard]] bool IsFrameStatsEnabled();
+
+/** @brief Starts or stops collecting, starting over from zero. */
+void SetFrameStatsEnabled(bool enabled);
+
+/** @brief Counts the time since the previous frame, call at the start of each drawn frame. */
+void CountFrame();
+
+/** @brief Call at the start of GameLogic(). */
+void BeginTickStats();
+
+/** @brief Adds the time since the previous step to that step, call with the step that comes next. */
+void CountGameLogicStep(GameLogicStep next);
+
+/** @brief Call at the end of GameLogic(). */
+void EndTickStats();
+
+[[nodiscard]] const FrameStats &GetFrameStats();
+
+/** @brief p50, p95 and p99 of the frame and tick times in milliseconds, for the FPS display. */
+[[nodiscard]] std::string FormatFramePercentiles();
+
+/** @brief The percentiles and the slowest frames and ticks, one per line. */
+[[nodiscard]] std::string FormatFrameStats();
+
+} // namespace devilution
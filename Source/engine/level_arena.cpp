@@ -0,0 +1,83 @@
+/**
+ * @file level_arena.cpp
+ *
+ * Implementation of the memory that lives as long as the current level.
+ */
+#include "engine/level_arena.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+namespace devilution {
+
+LevelArena LevelMemory;
+
+LevelArena::LevelArena(size_t chunkSize)
+    : chunkSize_(chunkSize)
+{
+}
+
+void *LevelArena::Allocate(size_t size, size_t alignment)
+{
+	// `new[]` aligns the chunks to `alignof(std::max_align_t)`.
+	assert(alignment != 0 && (alignment & (alignment - 1)) == 0 && alignment <= alignof(std::max_align_t));
+	if (!chunks_.empty()) {
+		Chunk &chunk = chunks_.back();
+		const auto base = reinterpret_cast<uintptr_t>(chunk.data.get());
+		const size_t start = ((base + used_ + alignment - 1) & ~(alignment - 1)) - base;
+		if (start + size <= chunk.size) {
+			used_ = start + size;
+			bytesUsed_ += size;
+			return chunk.data.get() + start;
+		}
+	}
+
+	bytesUsed_ += size;
+	if (size > chunkSize_ && !chunks_.empty()) {
+		// Keep filling the current chunk after an oversized allocation.
+		const auto it = chunks_.insert(chunks_.end() - 1, Chunk { std::unique_ptr<std::byte[]>(new std::byte[size]), size });
+		return it->data.get();
+	}
+	const size_t chunkSize = std::max(size, chunkSize_);
+	chunks_.push_back(Chunk { std::unique_ptr<std::byte[]>(new std::byte[chunkSize]), chunkSize });
+	used_ = size;
+	return chunks_.back().data.get();
+}
+
+std::span<uint8_t> LevelArena::Copy(std::span<const uint8_t> data)
+{
+	const std::span<uint8_t> copy = AllocateArray<uint8_t>(data.size());
+	if (!data.empty())
+		std::memcpy(copy.data(), data.data(), data.size());
+	return copy;
+}
+
+void LevelArena::Release()
+{
+	if (chunks_.size() > 1) {
+		// Keep a regular chunk, an oversized one would stay around for the rest of the session.
+		const auto kept = std::find_if(chunks_.begin(), chunks_.end(), [this](const Chunk &chunk) { return chunk.size == chunkSize_; });
+		if (kept != chunks_.end()) {
+			Chunk chunk = std::move(*kept);
+			chunks_.clear();
+			chunks_.push_back(std::move(chunk));
+		} else {
+			chunks_.clear();
+		}
+	} else if (!chunks_.empty() && chunks_.front().size != chunkSize_) {
+		chunks_.clear();
+	}
+	used_ = 0;
+	bytesUsed_ = 0;
+}
+
+size_t LevelArena::bytesReserved() const
+{
+	size_t bytes = 0;
+	for (const Chunk &chunk : chunks_)
+		bytes += chunk.size;
+	return bytes;
+}
+
+} // namespace devilution
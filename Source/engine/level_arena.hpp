@@ -0,0 +1,73 @@
+/**
+ * @file level_arena.hpp
+ *
+ * Interface of the memory that lives as long as the current level and is given back all at once.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+namespace devilution {
+
+/**
+ * @brief Hands out memory from large chunks and frees all of it in one go.
+ *
+ * Nothing allocated here is destroyed, so it only holds trivially destructible data.
+ * Release() keeps the first chunk for the next level, so a level that fits in it allocates nothing.
+ */
+class LevelArena {
+public:
+	static constexpr size_t DefaultChunkSize = 1024 * 1024;
+
+	explicit LevelArena(size_t chunkSize = DefaultChunkSize);
+
+	LevelArena(const LevelArena &) = delete;
+	LevelArena &operator=(const LevelArena &) = delete;
+
+	/** @brief Memory for `size` bytes, valid until the next Release(). Allocations larger than a chunk get one of their own. */
+	[[nodiscard]] void *Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+	template <typename T>
+	[[nodiscard]] std::span<T> AllocateArray(size_t count)
+	{
+		static_assert(std::is_trivially_destructible_v<T>, "LevelArena never runs destructors");
+		return { static_cast<T *>(Allocate(sizeof(T) * count, alignof(T))), count };
+	}
+
+	/** @brief A copy of `data` that lives until the next Release(). */
+	[[nodiscard]] std::span<uint8_t> Copy(std::span<const uint8_t> data);
+
+	/** @brief Frees everything allocated since the last Release(). */
+	void Release();
+
+	/** @brief Bytes handed out since the last Release(). */
+	[[nodiscard]] size_t bytesUsed() const
+	{
+		return bytesUsed_;
+	}
+
+	/** @brief Bytes held in chunks, including what is not handed out yet. */
+	[[nodiscard]] size_t bytesReserved() const;
+
+private:
+	struct Chunk {
+		std::unique_ptr<std::byte[]> data;
+		size_t size;
+	};
+
+	std::vector<Chunk> chunks_;
+	size_t chunkSize_;
+	/** Offset of the free space in the last chunk. */
+	size_t used_ = 0;
+	size_t bytesUsed_ = 0;
+};
+
+/** Graphics and other data of the current level, released by FreeGameMem(). */
+extern LevelArena LevelMemory;
+
+} // namespace devilution
@@ -1,8 +1,12 @@
 #include "engine/load_cl2.hpp"
 
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <memory>
+#include <span>
 #include <utility>
+#include <vector>
 
 #include <expected.hpp>
 
@@ -13,6 +17,7 @@
 #ifdef UNPACKED_MPQS
 #include "engine/load_clx.hpp"
 #else
+#include "engine/converted_asset_cache.hpp"
 #include "engine/load_file.hpp"
 #include "utils/cl2_to_clx.hpp"
 #endif
@@ -26,9 +31,27 @@ tl::expected<OwnedClxSpriteListOrSheet, std::string> LoadCl2ListOrSheetWithStatu
 #ifdef UNPACKED_MPQS
 	return LoadClxListOrSheetWithStatus(path);
 #else
+	ConvertedAssetKey key { Cl2ToClxVersion };
+	key.AddSource(FindAsset(path));
+	// Sprites with a width per list aren't cached, the key would need all the widths.
+	if (widthOrWidths.HoldsPointer())
+		key.Invalidate();
+	else
+		key.Add(widthOrWidths.AsValue());
+
 	size_t size;
+	if (std::unique_ptr<std::byte[]> cached = LoadConvertedAsset(key, size); cached != nullptr) {
+		return OwnedClxSpriteListOrSheet::FromBuffer(std::unique_ptr<uint8_t[]> { reinterpret_cast<uint8_t *>(cached.release()) }, size);
+	}
+
 	ASSIGN_OR_RETURN(std::unique_ptr<uint8_t[]> data, LoadFileInMemWithStatus<uint8_t>(path, &size));
-	return Cl2ToClx(std::move(data), size, widthOrWidths);
+	std::vector<uint8_t> clxData;
+	const uint16_t numLists = Cl2ToClx(data.get(), size, widthOrWidths, clxData);
+	StoreConvertedAsset(key, std::as_bytes(std::span { clxData }));
+	data = nullptr;
+	data = std::unique_ptr<uint8_t[]>(new uint8_t[clxData.size()]);
+	memcpy(&data[0], clxData.data(), clxData.size());
+	return OwnedClxSpriteListOrSheet { std::move(data), numLists };
 #endif
 }
 
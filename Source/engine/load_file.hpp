@@ -5,10 +5,12 @@
 #include <cstdint>
 #include <cstring>
 #include <memory>
+#include <string>
 
 #include <expected.hpp>
 
 #include "appfat.h"
+#include "engine/asset_stats.hpp"
 #include "engine/assets.hpp"
 #include "headless_mode.hpp"
 #include "mpq/mpq_common.hpp"
@@ -23,7 +25,9 @@ tl::expected<void, std::string> LoadFileInMemWithStatus(const char *path, T *dat
 	size_t size;
 	AssetHandle handle = OpenAsset(path, size);
 	if (!handle.ok()) {
-		if (HeadlessMode) return {};
+		if (HeadlessMode) {
+			return {};
+		}
 		return tl::make_unexpected(FailedToOpenFileErrorMessage(path, handle.error()));
 	}
 	if ((size % sizeof(T)) != 0) {
@@ -47,7 +51,9 @@ tl::expected<void, std::string> LoadFileInMemWithStatus(const char *path, T *dat
 {
 	AssetHandle handle = OpenAsset(path);
 	if (!handle.ok()) {
-		if (HeadlessMode) return {};
+		if (HeadlessMode) {
+			return {};
+		}
 		return tl::make_unexpected(FailedToOpenFileErrorMessage(path, handle.error()));
 	}
 	if (!handle.read(data, count * sizeof(T))) {
@@ -88,7 +94,9 @@ tl::expected<std::unique_ptr<T[]>, std::string> LoadFileInMemWithStatus(const ch
 	size_t size;
 	AssetHandle handle = OpenAsset(path, size);
 	if (!handle.ok()) {
-		if (HeadlessMode) return {};
+		if (HeadlessMode) {
+			return {};
+		}
 		return tl::make_unexpected(FailedToOpenFileErrorMessage(path, handle.error()));
 	}
 	if ((size % sizeof(T)) != 0) {
@@ -133,15 +141,18 @@ struct MultiFileLoader {
 		}
 	};
 
+	/** Open the files with their own archive handles, so that several loaders can run at once. */
+	bool threadsafe = false;
+
 	/**
 	 * @param numFiles number of files to read
 	 * @param pathFn a function that returns the path for the given index
 	 * @param outOffsets a buffer index for the start of each file will be written here, then the total file size at the end.
 	 * @param filterFn a function that returns whether to load a file for the given index
-	 * @return std::unique_ptr<std::byte[]> the buffer with all the files
+	 * @return std::unique_ptr<std::byte[]> the buffer with all the files, or the error message if a file couldn't be read
 	 */
 	template <typename PathFn, typename FilterFn = DefaultFilterFn>
-	[[nodiscard]] std::unique_ptr<std::byte[]> operator()(size_t numFiles, PathFn &&pathFn, uint32_t *outOffsets,
+	[[nodiscard]] tl::expected<std::unique_ptr<std::byte[]>, std::string> operator()(size_t numFiles, PathFn &&pathFn, uint32_t *outOffsets,
 	    FilterFn filterFn = DefaultFilterFn {})
 	{
 		StaticVector<std::array<char, MaxMpqPathSize>, MaxFiles> paths;
@@ -158,8 +169,12 @@ struct MultiFileLoader {
 			}
 			const char *path = paths.back().data();
 			files.emplace_back(FindAsset(path));
-			if (!ValidatAssetRef(path, files.back()))
-				return nullptr;
+			if (!files.back().ok()) {
+				if (HeadlessMode) {
+					return nullptr;
+				}
+				return tl::make_unexpected(FailedToOpenFileErrorMessage(path, files.back().error()));
+			}
 
 			const size_t size = files.back().size();
 			sizes.emplace_back(static_cast<uint32_t>(size));
@@ -172,13 +187,17 @@ struct MultiFileLoader {
 		for (size_t i = 0, j = 0; i < numFiles; ++i) {
 			if (!filterFn(i))
 				continue;
-			AssetHandle handle = OpenAsset(std::move(files[j]));
+			// Timed and named like a load of the file on its own, the name outlives the timer in `paths`.
+			ScopedAssetLoadTimer timer(paths[j].data());
+			RecordAssetSource(timer, files[j]);
+			AssetHandle handle = OpenAsset(std::move(files[j]), threadsafe);
 			if (!handle.ok() || !handle.read(&buf[outOffsets[j]], sizes[j])) {
-				FailedToOpenFileError(paths[j].data(), handle.error());
+				timer.Cancel();
+				return tl::make_unexpected(FailedToOpenFileErrorMessage(paths[j].data(), handle.error()));
 			}
 			++j;
 		}
-		return buf;
+		return { std::move(buf) };
 	}
 };
 
@@ -35,7 +35,7 @@
 
 namespace devilution {
 
-OptionalOwnedClxSpriteList LoadPcxSpriteList(const char *filename, int numFramesOrFrameHeight, std::optional<uint8_t> transparentColor, SDL_Color *outPalette, bool logError)
+OptionalOwnedClxSpriteList LoadPcxSpriteList(const char *filename, int numFramesOrFrameHeight, std::optional<uint8_t> transparentColor, SDL_Color *outPalette, bool logError, [[maybe_unused]] bool threadsafe)
 {
 	char path[MaxMpqPathSize];
 	char *pathEnd = BufCopy(path, filename, DEVILUTIONX_PCX_EXT);
@@ -63,7 +63,7 @@ OptionalOwnedClxSpriteList LoadPcxSpriteList(const char *filename, int numFrames
 	return result;
 #else
 	size_t fileSize;
-	AssetHandle handle = OpenAsset(path, fileSize);
+	AssetHandle handle = OpenAsset(path, fileSize, threadsafe);
 	if (!handle.ok()) {
 		if (logError)
 			LogError("Missing file: {}", path);
@@ -26,9 +26,10 @@ namespace devilution {
  * @param numFramesOrFrameHeight Pass a positive value with the number of frames, or the frame height as a negative value.
  * @param transparentColor
  * @param outPalette
+ * @param threadsafe Pass true when loading from another thread than the game thread.
  * @return OptionalOwnedClxSpriteList
  */
-OptionalOwnedClxSpriteList LoadPcxSpriteList(const char *filename, int numFramesOrFrameHeight, std::optional<uint8_t> transparentColor = std::nullopt, SDL_Color *outPalette = nullptr, bool logError = true);
+OptionalOwnedClxSpriteList LoadPcxSpriteList(const char *filename, int numFramesOrFrameHeight, std::optional<uint8_t> transparentColor = std::nullopt, SDL_Color *outPalette = nullptr, bool logError = true, bool threadsafe = false);
 
 /**
  * @brief Loads a PCX file as a CLX sprite list with a single sprite.
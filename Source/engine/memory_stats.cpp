@@ -0,0 +1,118 @@
+/**
+ * @file memory_stats.cpp
+ *
+ * Implementation of the breakdown of the memory held by the largest consumers.
+ */
+#include "engine/memory_stats.hpp"
+
+#include <algorithm>
+
+#include "engine/level_arena.hpp"
+#include "engine/render/text_render.hpp"
+#include "engine/sound_pool.hpp"
+#include "levels/gendung.h"
+#include "lua/lua_global.hpp"
+#include "monster.h"
+#include "msg.h"
+#include "utils/endian_read.hpp"
+#include "utils/language.h"
+#include "utils/str_cat.hpp"
+
+namespace devilution {
+
+namespace {
+
+constexpr size_t MemoryCategoryCount = static_cast<size_t>(MemoryCategory::COUNT);
+
+constexpr std::array<std::string_view, MemoryCategoryCount> MemoryCategoryNames {
+	"Monster sprites",
+	"Dungeon cels",
+	"Sound pool",
+	"Fonts",
+	"Translations",
+	"Lua",
+	"Level deltas",
+	"Level arena",
+};
+
+[[nodiscard]] size_t MonsterSpritesSize(const CMonster &monsterType)
+{
+	size_t bytes = 0;
+	for (const AnimStruct &anim : monsterType.anims) {
+		if (anim.sprites)
+			bytes += anim.sprites->dataSize();
+	}
+	return bytes;
+}
+
+[[nodiscard]] size_t DungeonCelsSize()
+{
+	size_t bytes = 0;
+	if (pDungeonCels != nullptr) {
+		// Both the original and the reencoded cels end their frame offsets with the size of the file.
+		const auto *data = reinterpret_cast<const uint8_t *>(pDungeonCels.get());
+		const uint32_t numFrames = LoadLE32(data);
+		bytes += LoadLE32(&data[4 * (numFrames + 1)]);
+	}
+	if (pSpecialCels)
+		bytes += pSpecialCels->dataSize();
+	return bytes;
+}
+
+[[nodiscard]] std::string KiB(size_t bytes)
+{
+	return StrCat((bytes + 1023) / 1024, " KiB");
+}
+
+} // namespace
+
+std::string_view MemoryCategoryName(MemoryCategory category)
+{
+	return MemoryCategoryNames[static_cast<size_t>(category)];
+}
+
+MemoryUsage GetMemoryUsage()
+{
+	MemoryUsage usage;
+	for (size_t i = 0; i < LevelMonsterTypeCount; i++) {
+		const CMonster &monsterType = LevelMonsterTypes[i];
+		const size_t bytes = MonsterSpritesSize(monsterType);
+		if (bytes == 0)
+			continue;
+		usage.monsterTypes.emplace_back(monsterType.data().name, bytes);
+		usage.bytes[static_cast<size_t>(MemoryCategory::MonsterSprites)] += bytes;
+	}
+	std::sort(usage.monsterTypes.begin(), usage.monsterTypes.end(), [](const auto &a, const auto &b) { return a.second > b.second; });
+
+	usage.bytes[static_cast<size_t>(MemoryCategory::DungeonCels)] = DungeonCelsSize();
+	usage.bytes[static_cast<size_t>(MemoryCategory::SoundPool)] = SoundPool::Get().MemoryUsage();
+	usage.bytes[static_cast<size_t>(MemoryCategory::Fonts)] = FontsMemoryUsage();
+	usage.bytes[static_cast<size_t>(MemoryCategory::Translations)] = LanguageMemoryUsage();
+	usage.bytes[static_cast<size_t>(MemoryCategory::Lua)] = LuaMemoryUsage();
+	usage.bytes[static_cast<size_t>(MemoryCategory::LevelDeltas)] = DeltaLevelsMemoryUsage();
+	usage.bytes[static_cast<size_t>(MemoryCategory::LevelArena)] = LevelMemory.bytesReserved();
+	return usage;
+}
+
+std::string FormatMemoryUsage(const MemoryUsage &usage, bool perMonsterType)
+{
+	std::array<MemoryCategory, MemoryCategoryCount> categories;
+	for (size_t i = 0; i < MemoryCategoryCount; i++)
+		categories[i] = static_cast<MemoryCategory>(i);
+	std::stable_sort(categories.begin(), categories.end(), [&usage](MemoryCategory a, MemoryCategory b) { return usage[a] > usage[b]; });
+
+	size_t total = 0;
+	for (const size_t bytes : usage.bytes)
+		total += bytes;
+	std::string out = StrCat("Memory: ", KiB(total), " in the tracked subsystems");
+	for (const MemoryCategory category : categories) {
+		StrAppend(out, "\n", MemoryCategoryName(category), ": ", KiB(usage[category]));
+		if (category != MemoryCategory::MonsterSprites || !perMonsterType)
+			continue;
+		for (const auto &[name, bytes] : usage.monsterTypes)
+			StrAppend(out, "\n  ", name, ": ", KiB(bytes));
+	}
+	return out;
+}
+
+} // namespace devilution
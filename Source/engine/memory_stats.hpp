@@ -0,0 +1,53 @@
+/**
+ * @file memory_stats.hpp
+ *
+ * Interface of the breakdown of the memory held by the largest consumers.
+ */
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace devilution {
+
+enum class MemoryCategory : uint8_t {
+	MonsterSprites,
+	DungeonCels,
+	SoundPool,
+	Fonts,
+	Translations,
+	Lua,
+	LevelDeltas,
+	LevelArena,
+	COUNT,
+};
+
+/** Bytes held by each category at the time it was gathered. */
+struct MemoryUsage {
+	std::array<size_t, static_cast<size_t>(MemoryCategory::COUNT)> bytes {};
+	/** The sprite bytes of each monster type on the current level, largest first. */
+	std::vector<std::pair<std::string_view, size_t>> monsterTypes;
+
+	[[nodiscard]] size_t operator[](MemoryCategory category) const
+	{
+		return bytes[static_cast<size_t>(category)];
+	}
+};
+
+[[nodiscard]] std::string_view MemoryCategoryName(MemoryCategory category);
+
+/** @brief Asks each subsystem what it holds right now, call from the game thread. */
+[[nodiscard]] MemoryUsage GetMemoryUsage();
+
+/**
+ * @brief One line per category in KiB, largest first.
+ * @param perMonsterType Also list the sprites of each monster type
+ */
+[[nodiscard]] std::string FormatMemoryUsage(const MemoryUsage &usage, bool perMonsterType);
+
+} // namespace devilution
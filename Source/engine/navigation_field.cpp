@@ -0,0 +1,252 @@
+/**
+ * @file navigation_field.cpp
+ *
+ * Implementation of the breadth-first navigation distance field.
+ */
+#include "engine/navigation_field.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <vector>
+
+namespace devilution {
+
+namespace {
+
+[[nodiscard]] bool IsInGrid(Point position)
+{
+	return position.x >= 0 && position.x < MAXDUNX && position.y >= 0 && position.y < MAXDUNY;
+}
+
+} // namespace
+
+template <typename IsPassable>
+void NavigationField::Flood(Point root, std::span<const Displacement> directions, IsPassable &&isPassable, tl::function_ref<bool(Point, Point)> canStep, DistanceType maxDistance)
+{
+	assert(directions.size() <= MaxDirections);
+	directionCount_ = std::min(directions.size(), MaxDirections);
+	std::copy_n(directions.begin(), directionCount_, directions_.begin());
+
+	root_ = root;
+	valid_ = true;
+	reachedCount_ = 0;
+	distance_.fill(Unreachable);
+	entryMask_.fill(0);
+	state_.fill(TileState::Unknown);
+
+	if (!IsInGrid(root))
+		return;
+
+	const size_t rootIndex = IndexOf(root);
+	distance_[rootIndex] = 0;
+	state_[rootIndex] = TileState::Passable;
+	reached_[reachedCount_++] = static_cast<uint16_t>(rootIndex);
+
+	for (size_t head = 0; head < reachedCount_; ++head) {
+		const Point current = PositionOf(reached_[head]);
+		// Tiles are reached in order of distance, so all the remaining ones are at the limit too.
+		if (distance_[reached_[head]] >= maxDistance)
+			break;
+		const DistanceType nextDistance = distance_[reached_[head]] + 1;
+
+		for (size_t i = 0; i < directionCount_; ++i) {
+			const Point next = current + directions_[i];
+			if (!IsInGrid(next))
+				continue;
+
+			const size_t nextIndex = IndexOf(next);
+			const DistanceType knownDistance = distance_[nextIndex];
+			// Tiles settled on an earlier breadth-first layer can't be part of a shortest path through `current`.
+			if (knownDistance != Unreachable && knownDistance != nextDistance)
+				continue;
+
+			if (!isPassable(next, nextIndex))
+				continue;
+			if (!canStep(current, next))
+				continue;
+
+			if (knownDistance == Unreachable) {
+				distance_[nextIndex] = nextDistance;
+				reached_[reachedCount_++] = static_cast<uint16_t>(nextIndex);
+			}
+			entryMask_[nextIndex] |= static_cast<uint8_t>(1U << i);
+		}
+	}
+}
+
+void NavigationField::Build(Point root, std::span<const Displacement> directions, tl::function_ref<bool(Point)> posOk, tl::function_ref<bool(Point, Point)> canStep, DistanceType maxDistance)
+{
+	Flood(
+	    root, directions, [this, posOk](Point position, size_t index) {
+		    TileState &state = state_[index];
+		    if (state == TileState::Unknown)
+			    state = posOk(position) ? TileState::Passable : TileState::Blocked;
+		    return state == TileState::Passable;
+	    },
+	    canStep, maxDistance);
+}
+
+void NavigationField::Build(Point root, std::span<const Displacement> directions, const Bitset2d<MAXDUNX, MAXDUNY> &passable, tl::function_ref<bool(Point, Point)> canStep, DistanceType maxDistance)
+{
+	Flood(
+	    root, directions, [this, &passable](Point position, size_t index) {
+		    const bool isPassable = passable.test(position.x, position.y);
+		    state_[index] = isPassable ? TileState::Passable : TileState::Blocked;
+		    return isPassable;
+	    },
+	    canStep, maxDistance);
+}
+
+void NavigationField::Build(Point root, std::span<const Displacement> directions, const Bitset2d<MAXDUNX, MAXDUNY> &passable, const Bitset2d<MAXDUNX, MAXDUNY> &penalized, DistanceType penalty, tl::function_ref<bool(Point, Point)> canStep)
+{
+	assert(directions.size() <= MaxDirections);
+	directionCount_ = std::min(directions.size(), MaxDirections);
+	std::copy_n(directions.begin(), directionCount_, directions_.begin());
+
+	root_ = root;
+	valid_ = true;
+	reachedCount_ = 0;
+	distance_.fill(Unreachable);
+	entryMask_.fill(0);
+	state_.fill(TileState::Unknown);
+
+	if (!IsInGrid(root))
+		return;
+
+	// Dijkstra on (cost, steps), so of the cheapest paths the one with the fewest steps wins and
+	// PathTo can walk back by steps like in the breadth-first field.
+	struct Entry {
+		uint32_t cost;
+		DistanceType steps;
+		uint16_t index;
+
+		bool operator>(const Entry &other) const
+		{
+			return cost != other.cost ? cost > other.cost : steps > other.steps;
+		}
+	};
+	std::vector<uint32_t> cost(TileCount, std::numeric_limits<uint32_t>::max());
+	std::priority_queue<Entry, std::vector<Entry>, std::greater<>> queue;
+
+	const size_t rootIndex = IndexOf(root);
+	distance_[rootIndex] = 0;
+	cost[rootIndex] = 0;
+	queue.push({ 0, 0, static_cast<uint16_t>(rootIndex) });
+
+	while (!queue.empty()) {
+		const Entry entry = queue.top();
+		queue.pop();
+		if (entry.cost != cost[entry.index] || entry.steps != distance_[entry.index] || state_[entry.index] == TileState::Passable)
+			continue;
+		// Reuse the breadth-first state to mark settled tiles, every tile that gets queued is passable.
+		state_[entry.index] = TileState::Passable;
+		reached_[reachedCount_++] = entry.index;
+		if (entry.steps == Unreachable - 1)
+			continue;
+
+		const Point current = PositionOf(entry.index);
+		for (size_t i = 0; i < directionCount_; ++i) {
+			const Point next = current + directions_[i];
+			if (!IsInGrid(next) || !passable.test(next.x, next.y))
+				continue;
+			const size_t nextIndex = IndexOf(next);
+			if (state_[nextIndex] == TileState::Passable)
+				continue;
+			if (!canStep(current, next))
+				continue;
+
+			const uint32_t nextCost = entry.cost + 1 + (penalized.test(next.x, next.y) ? penalty : 0);
+			const DistanceType nextSteps = entry.steps + 1;
+			if (nextCost == cost[nextIndex] && nextSteps == distance_[nextIndex]) {
+				entryMask_[nextIndex] |= static_cast<uint8_t>(1U << i);
+				continue;
+			}
+			if (nextCost > cost[nextIndex] || (nextCost == cost[nextIndex] && nextSteps > distance_[nextIndex]))
+				continue;
+
+			cost[nextIndex] = nextCost;
+			distance_[nextIndex] = nextSteps;
+			entryMask_[nextIndex] = static_cast<uint8_t>(1U << i);
+			queue.push({ nextCost, nextSteps, static_cast<uint16_t>(nextIndex) });
+		}
+	}
+
+	// Only the root and tiles in `passable` were settled, mark the rest like the breadth-first flood would.
+	for (size_t index = 0; index < TileCount; ++index) {
+		if (state_[index] != TileState::Unknown)
+			continue;
+		const Point position = PositionOf(static_cast<uint16_t>(index));
+		state_[index] = passable.test(position.x, position.y) ? TileState::Passable : TileState::Blocked;
+	}
+}
+
+NavigationField::DistanceType NavigationField::Distance(Point position) const
+{
+	if (!valid_ || !IsInGrid(position))
+		return Unreachable;
+	return distance_[IndexOf(position)];
+}
+
+std::optional<size_t> NavigationField::PathTo(Point destination, int8_t *path, size_t maxPathLength, bool allowBlockedDestination) const
+{
+	if (!valid_ || !IsInGrid(destination))
+		return std::nullopt;
+
+	Point position = destination;
+	size_t remaining = distance_[IndexOf(destination)];
+	size_t length = remaining;
+	int preferredDirection = -1;
+
+	if (remaining == Unreachable) {
+		if (!allowBlockedDestination || state_[IndexOf(destination)] != TileState::Blocked)
+			return std::nullopt;
+
+		DistanceType bestDistance = Unreachable;
+		for (size_t i = 0; i < directionCount_; ++i) {
+			const DistanceType neighbourDistance = Distance(destination - directions_[i]);
+			if (neighbourDistance < bestDistance) {
+				bestDistance = neighbourDistance;
+				preferredDirection = static_cast<int>(i);
+			}
+		}
+		if (preferredDirection < 0)
+			return std::nullopt;
+
+		remaining = bestDistance;
+		length = remaining + 1;
+		if (length > maxPathLength)
+			return std::nullopt;
+		path[remaining] = static_cast<int8_t>(preferredDirection);
+		position = destination - directions_[preferredDirection];
+	} else if (length > maxPathLength) {
+		return std::nullopt;
+	}
+
+	// Walk back towards the root. Keeping the direction of the following step where possible keeps
+	// the path in long straight runs, which are shorter to describe.
+	while (remaining > 0) {
+		const uint8_t mask = entryMask_[IndexOf(position)];
+		assert(mask != 0);
+		int direction;
+		if (preferredDirection >= 0 && (mask & (1U << preferredDirection)) != 0) {
+			direction = preferredDirection;
+		} else {
+			direction = 0;
+			while ((mask & (1U << direction)) == 0)
+				++direction;
+		}
+
+		--remaining;
+		path[remaining] = static_cast<int8_t>(direction);
+		position = position - directions_[direction];
+		preferredDirection = direction;
+	}
+
+	assert(position == root_);
+	return length;
+}
+
+} // namespace devilution
@@ -0,0 +1,150 @@
+/**
+ * @file navigation_field.hpp
+ *
+ * Interface of the breadth-first navigation distance field.
+ */
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <span>
+
+#include <function_ref.hpp>
+
+#include "engine/displacement.hpp"
+#include "engine/point.hpp"
+#include "levels/gendung_defs.hpp"
+#include "utils/bitset2d.hpp"
+
+namespace devilution {
+
+/**
+ * @brief Breadth-first distance field over the dungeon grid, rooted at a single tile.
+ *
+ * Building the field floods the area reachable from the root once. Afterwards any number
+ * of "path to X" queries can be answered by walking back from X in O(path length),
+ * instead of running a fresh search per query.
+ */
+class NavigationField {
+public:
+	using DistanceType = uint16_t;
+	static constexpr DistanceType Unreachable = std::numeric_limits<DistanceType>::max();
+	static constexpr size_t MaxDirections = 8;
+
+	/**
+	 * @brief Floods the field from `root`.
+	 *
+	 * @param root The tile all distances are measured from. It does not need to pass `posOk`.
+	 * @param directions The allowed step directions. Paths are returned as indices into this list,
+	 * and earlier directions are preferred when several shortest paths exist.
+	 * @param posOk specifies whether a position can be stepped on.
+	 * @param canStep specifies whether a step between two adjacent points is allowed.
+	 * @param maxDistance Tiles further than this from the root are left unreached.
+	 */
+	void Build(Point root, std::span<const Displacement> directions, tl::function_ref<bool(Point)> posOk, tl::function_ref<bool(Point, Point)> canStep, DistanceType maxDistance = Unreachable);
+
+	/**
+	 * @brief Floods the field from `root` using a precomputed walkability grid.
+	 *
+	 * @param passable Set for every tile that can be stepped on, indexed by (x, y).
+	 */
+	void Build(Point root, std::span<const Displacement> directions, const Bitset2d<MAXDUNX, MAXDUNY> &passable, tl::function_ref<bool(Point, Point)> canStep, DistanceType maxDistance = Unreachable);
+
+	/**
+	 * @brief Floods the field from `root`, making every step onto a `penalized` tile cost `penalty` extra steps.
+	 *
+	 * Distance() and PathTo() still count steps, the penalty only decides which path counts as the shortest,
+	 * e.g. to go around closed doors unless that is much longer. Tiles are reached in order of that cost.
+	 *
+	 * @param penalized Tiles to avoid, they must be set in `passable` to be entered at all.
+	 */
+	void Build(Point root, std::span<const Displacement> directions, const Bitset2d<MAXDUNX, MAXDUNY> &passable, const Bitset2d<MAXDUNX, MAXDUNY> &penalized, DistanceType penalty, tl::function_ref<bool(Point, Point)> canStep);
+
+	void Invalidate()
+	{
+		valid_ = false;
+	}
+
+	[[nodiscard]] bool IsValid() const
+	{
+		return valid_;
+	}
+
+	[[nodiscard]] Point Root() const
+	{
+		return root_;
+	}
+
+	/** @return The number of steps from the root to `position`, or `Unreachable`. */
+	[[nodiscard]] DistanceType Distance(Point position) const;
+
+	[[nodiscard]] bool IsReached(Point position) const
+	{
+		return Distance(position) != Unreachable;
+	}
+
+	/** @return The number of tiles reached by the flood, including the root. */
+	[[nodiscard]] size_t ReachedCount() const
+	{
+		return reachedCount_;
+	}
+
+	/** @return The `index`-th reached tile in breadth-first (or cost) order, index 0 is the root. */
+	[[nodiscard]] Point ReachedPosition(size_t index) const
+	{
+		return PositionOf(reached_[index]);
+	}
+
+	/**
+	 * @brief Reconstructs a shortest path from the root to `destination`.
+	 *
+	 * When several shortest paths exist, the one with the fewest changes of direction is preferred.
+	 *
+	 * @param destination The tile to walk to.
+	 * @param path Resulting path represented as indices into the `directions` passed to `Build`.
+	 * @param maxPathLength The capacity of `path`.
+	 * @param allowBlockedDestination If the destination itself failed `posOk`, end the path with
+	 * a step onto it from the closest reached neighbour (used for targets such as chests).
+	 * @return The length of the path, or an empty optional if there is no path that fits.
+	 */
+	[[nodiscard]] std::optional<size_t> PathTo(Point destination, int8_t *path, size_t maxPathLength, bool allowBlockedDestination = false) const;
+
+private:
+	static constexpr size_t TileCount = MAXDUNX * MAXDUNY;
+
+	[[nodiscard]] static size_t IndexOf(Point position)
+	{
+		return static_cast<size_t>(position.x) + static_cast<size_t>(position.y) * MAXDUNX;
+	}
+
+	[[nodiscard]] static Point PositionOf(uint16_t index)
+	{
+		return { index % MAXDUNX, index / MAXDUNX };
+	}
+
+	enum class TileState : uint8_t {
+		Unknown,
+		Passable,
+		Blocked,
+	};
+
+	template <typename IsPassable>
+	void Flood(Point root, std::span<const Displacement> directions, IsPassable &&isPassable, tl::function_ref<bool(Point, Point)> canStep, DistanceType maxDistance);
+
+	std::array<DistanceType, TileCount> distance_;
+	/** Bit `i` is set if the tile can be entered along a shortest path by a step in `directions_[i]`. */
+	std::array<uint8_t, TileCount> entryMask_;
+	/** Cached `posOk` results, so that each tile is tested at most once per build. */
+	std::array<TileState, TileCount> state_;
+	std::array<uint16_t, TileCount> reached_;
+	size_t reachedCount_ = 0;
+	std::array<Displacement, MaxDirections> directions_;
+	size_t directionCount_ = 0;
+	Point root_;
+	bool valid_ = false;
+};
+
+} // namespace devilution
@@ -0,0 +1,152 @@
+/**
+ * @file net_stats.cpp
+ *
+ * Implementation of the counters that show which commands and packets use the multiplayer bandwidth.
+ */
+#include "engine/net_stats.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <string_view>
+#include <vector>
+
+#include "dvlnet/packet.h"
+#include "msg.h"
+#include "utils/str_cat.hpp"
+
+namespace devilution {
+
+namespace {
+
+constexpr size_t DirectionCount = 2;
+
+using CounterTable = std::array<NetCounter, 256>;
+
+std::atomic<bool> Enabled { false };
+std::atomic<uint64_t> CryptoNanoseconds { 0 };
+
+// Only touched by the game thread.
+std::array<CounterTable, DirectionCount> CommandCounters {};
+std::array<CounterTable, DirectionCount> PacketCounters {};
+std::chrono::steady_clock::time_point EnabledSince;
+
+void Count(CounterTable &table, uint8_t id, size_t bytes)
+{
+	NetCounter &counter = table[id];
+	counter.count++;
+	counter.bytes += bytes;
+}
+
+NetCounter Total(const CounterTable &table)
+{
+	NetCounter total;
+	for (const NetCounter &counter : table) {
+		total.count += counter.count;
+		total.bytes += counter.bytes;
+	}
+	return total;
+}
+
+void AppendTopCommands(std::string &out, const CounterTable &table, size_t commands)
+{
+	std::vector<uint8_t> ids;
+	for (size_t id = 0; id < table.size(); id++) {
+		if (table[id].count != 0)
+			ids.push_back(static_cast<uint8_t>(id));
+	}
+	const size_t shown = std::min(commands, ids.size());
+	std::partial_sort(ids.begin(), ids.begin() + static_cast<std::ptrdiff_t>(shown), ids.end(), [&table](uint8_t a, uint8_t b) {
+		return table[a].bytes > table[b].bytes;
+	});
+	for (size_t i = 0; i < shown; i++) {
+		const NetCounter &counter = table[ids[i]];
+		const std::string_view name = CmdIdString(static_cast<_cmd_id>(ids[i]));
+		if (name.empty())
+			StrAppend(out, "\n  Command ", static_cast<unsigned>(ids[i]));
+		else
+			StrAppend(out, "\n  ", name);
+		StrAppend(out, ": ", counter.count, " x, ", counter.bytes, " B");
+	}
+}
+
+} // namespace
+
+bool IsNetStatsEnabled()
+{
+	return Enabled.load(std::memory_order_relaxed);
+}
+
+void SetNetStatsEnabled(bool enabled)
+{
+	CommandCounters = {};
+	PacketCounters = {};
+	CryptoNanoseconds.store(0, std::memory_order_relaxed);
+	EnabledSince = std::chrono::steady_clock::now();
+	Enabled.store(enabled, std::memory_order_relaxed);
+}
+
+void CountNetCommand(NetDirection direction, uint8_t command, size_t bytes)
+{
+	if (IsNetStatsEnabled())
+		Count(CommandCounters[static_cast<size_t>(direction)], command, bytes);
+}
+
+void CountNetPacket(NetDirection direction, uint8_t packetType, size_t bytes)
+{
+	if (IsNetStatsEnabled())
+		Count(PacketCounters[static_cast<size_t>(direction)], packetType, bytes);
+}
+
+ScopedNetCryptoTimer::ScopedNetCryptoTimer()
+    : enabled_(IsNetStatsEnabled())
+{
+	if (enabled_)
+		start_ = std::chrono::steady_clock::now();
+}
+
+ScopedNetCryptoTimer::~ScopedNetCryptoTimer()
+{
+	if (!enabled_)
+		return;
+	const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start_);
+	CryptoNanoseconds.fetch_add(static_cast<uint64_t>(elapsed.count()), std::memory_order_relaxed);
+}
+
+const NetCounter &GetNetCommandCounter(NetDirection direction, uint8_t command)
+{
+	return CommandCounters[static_cast<size_t>(direction)][command];
+}
+
+const NetCounter &GetNetPacketCounter(NetDirection direction, uint8_t packetType)
+{
+	return PacketCounters[static_cast<size_t>(direction)][packetType];
+}
+
+uint64_t GetNetCryptoMicroseconds()
+{
+	return CryptoNanoseconds.load(std::memory_order_relaxed) / 1000;
+}
+
+std::chrono::steady_clock::duration GetNetStatsDuration()
+{
+	return IsNetStatsEnabled() ? std::chrono::steady_clock::now() - EnabledSince : std::chrono::steady_clock::duration {};
+}
+
+std::string FormatNetStats(size_t commands)
+{
+	const auto seconds = std::chrono::duration_cast<std::chrono::seconds>(GetNetStatsDuration()).count();
+	std::string out = StrCat("Net over ", seconds, "s, crypto ", GetNetCryptoMicroseconds(), "us");
+	for (const NetDirection direction : { NetDirection::Sent, NetDirection::Received }) {
+		const size_t index = static_cast<size_t>(direction);
+		const NetCounter packets = Total(PacketCounters[index]);
+		const NetCounter turns = PacketCounters[index][net::PT_TURN];
+		const NetCounter messages = PacketCounters[index][net::PT_MESSAGE];
+		StrAppend(out, "\n", direction == NetDirection::Sent ? "Sent " : "Received ", packets.count, " packets, ", packets.bytes, " B (",
+		    turns.count, " turns, ", messages.count, " messages ", messages.bytes, " B)");
+		AppendTopCommands(out, CommandCounters[index], commands);
+	}
+	return out;
+}
+
+} // namespace devilution
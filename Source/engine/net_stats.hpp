@@ -0,0 +1,66 @@
+/**
+ * @file net_stats.hpp
+ *
+ * Interface of the counters that show which commands and packets use the multiplayer bandwidth.
+ */
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace devilution {
+
+enum class NetDirection : uint8_t {
+	Sent,
+	Received,
+};
+
+struct NetCounter {
+	uint32_t count = 0;
+	uint64_t bytes = 0;
+};
+
+/** @brief Whether the counters are being collected. Safe from any thread. */
+[[nodiscard]] bool IsNetStatsEnabled();
+
+/** @brief Starts or stops collecting, starting over from zero. */
+void SetNetStatsEnabled(bool enabled);
+
+/** @brief Counts a game command, by its _cmd_id. Game thread only. */
+void CountNetCommand(NetDirection direction, uint8_t command, size_t bytes);
+
+/** @brief Counts a dvlnet packet, by its packet_type. Game thread only. */
+void CountNetPacket(NetDirection direction, uint8_t packetType, size_t bytes);
+
+/** @brief Adds the time until it goes out of scope to the packet encryption time. Safe from any thread, the relay encrypts too. */
+class ScopedNetCryptoTimer {
+public:
+	ScopedNetCryptoTimer();
+	~ScopedNetCryptoTimer();
+
+	ScopedNetCryptoTimer(const ScopedNetCryptoTimer &) = delete;
+	ScopedNetCryptoTimer &operator=(const ScopedNetCryptoTimer &) = delete;
+
+private:
+	std::chrono::steady_clock::time_point start_;
+	bool enabled_;
+};
+
+[[nodiscard]] const NetCounter &GetNetCommandCounter(NetDirection direction, uint8_t command);
+[[nodiscard]] const NetCounter &GetNetPacketCounter(NetDirection direction, uint8_t packetType);
+
+/** @brief Time spent encrypting and decrypting packets since the counters were enabled. */
+[[nodiscard]] uint64_t GetNetCryptoMicroseconds();
+
+/** @brief How long the counters have been collected. */
+[[nodiscard]] std::chrono::steady_clock::duration GetNetStatsDuration();
+
+/**
+ * @brief The totals and the commands using the most bandwidth, one per line.
+ * @param commands How many commands to list per direction
+ */
+[[nodiscard]] std::string FormatNetStats(size_t commands);
+
+} // namespace devilution
@@ -9,6 +9,7 @@
 #include <array>
 #include <cstdint>
 #include <cstring>
+#include <initializer_list>
 #include <span>
 
 #ifdef USE_SDL3
@@ -49,45 +50,18 @@ void LoadBrightness()
 }
 
 /**
- * @brief Cycle the given range of colors in the palette
- * @param from First color index of the range
- * @param to First color index of the range
+ * @brief Cycle the given ranges of colors in the palette and the transparency lookups, all at once
  */
-void CycleColors(int from, int to)
+void CycleColors(std::initializer_list<PaletteCycle> cycles)
 {
-	std::rotate(logical_palette.begin() + from, logical_palette.begin() + from + 1, logical_palette.begin() + to + 1);
-	std::rotate(system_palette.begin() + from, system_palette.begin() + from + 1, system_palette.begin() + to + 1);
-
-	for (auto &palette : paletteTransparencyLookup) {
-		std::rotate(std::begin(palette) + from, std::begin(palette) + from + 1, std::begin(palette) + to + 1);
-	}
-
-	std::rotate(&paletteTransparencyLookup[from][0], &paletteTransparencyLookup[from + 1][0], &paletteTransparencyLookup[to + 1][0]);
-
-#if DEVILUTIONX_PALETTE_TRANSPARENCY_BLACK_16_LUT
-	UpdateTransparencyLookupBlack16(from, to);
-#endif
-}
-
-/**
- * @brief Cycle the given range of colors in the palette in reverse direction
- * @param from First color index of the range
- * @param to Last color index of the range
- */
-void CycleColorsReverse(int from, int to)
-{
-	std::rotate(logical_palette.begin() + from, logical_palette.begin() + to, logical_palette.begin() + to + 1);
-	std::rotate(system_palette.begin() + from, system_palette.begin() + to, system_palette.begin() + to + 1);
-
-	for (auto &palette : paletteTransparencyLookup) {
-		std::rotate(std::begin(palette) + from, std::begin(palette) + to, std::begin(palette) + to + 1);
+	for (const PaletteCycle &cycle : cycles) {
+		for (std::array<SDL_Color, 256> *palette : { &logical_palette, &system_palette }) {
+			const auto first = palette->begin() + cycle.from;
+			const auto last = palette->begin() + cycle.to + 1;
+			std::rotate(first, cycle.reverse ? last - 1 : first + 1, last);
+		}
 	}
-
-	std::rotate(&paletteTransparencyLookup[from][0], &paletteTransparencyLookup[to][0], &paletteTransparencyLookup[to + 1][0]);
-
-#if DEVILUTIONX_PALETTE_TRANSPARENCY_BLACK_16_LUT
-	UpdateTransparencyLookupBlack16(from, to);
-#endif
+	CycleBlendedLookupTable(std::span<const PaletteCycle>(cycles.begin(), cycles.size()));
 }
 
 // When brightness==0, then a==0 (identity mapping)
@@ -165,6 +139,9 @@ void SystemPaletteUpdated(int first, int ncolor)
 	if (!SDLC_SetSurfaceAndPaletteColors(PalSurface, Palette.get(), system_palette.data() + first, first, ncolor)) {
 		ErrSdl();
 	}
+	// The renderer applies the palette to paletted frames, what it was sent is still right.
+	if (!IsPresentingPalettedFrames())
+		ForgetBlittedBackBuffer();
 }
 
 void palette_init()
@@ -362,7 +339,7 @@ void PaletteFadeOut(int fr, const std::array<SDL_Color, 256> &srcPalette)
 
 void palette_update_caves()
 {
-	CycleColors(1, 31);
+	CycleColors({ { .from = 1, .to = 31, .reverse = false } });
 	SystemPaletteUpdated(1, 31);
 }
 
@@ -374,12 +351,15 @@ void palette_update_crypt()
 {
 	static bool delayLava = false;
 
+	constexpr PaletteCycle Lava { .from = 1, .to = 15, .reverse = true };
+	constexpr PaletteCycle Glow { .from = 16, .to = 31, .reverse = true };
 	if (!delayLava) {
-		CycleColorsReverse(1, 15);
+		CycleColors({ Lava, Glow });
 		delayLava = false;
+	} else {
+		CycleColors({ Glow });
 	}
 
-	CycleColorsReverse(16, 31);
 	SystemPaletteUpdated(1, 31);
 	delayLava = !delayLava;
 }
@@ -397,8 +377,7 @@ void palette_update_hive()
 		return;
 	}
 
-	CycleColorsReverse(1, 8);
-	CycleColorsReverse(9, 15);
+	CycleColors({ { .from = 1, .to = 8, .reverse = true }, { .from = 9, .to = 15, .reverse = true } });
 	SystemPaletteUpdated(1, 15);
 	delay = 0;
 }
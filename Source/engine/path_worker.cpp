@@ -0,0 +1,221 @@
+/**
+ * @file path_worker.cpp
+ *
+ * Implementation of the background path search used by auto-walk.
+ */
+#include "engine/path_worker.hpp"
+
+#include <mutex>
+#include <utility>
+
+#include "engine/path.h"
+#include "utils/sdl_cond.h"
+#include "utils/sdl_mutex.h"
+#include "utils/sdl_thread.h"
+
+namespace devilution {
+
+namespace {
+
+struct PathWorkerState {
+	SdlMutex mutex;
+	SdlCond wakeUp;
+
+	std::optional<PathJob> pendingJob;
+	std::unique_ptr<PathSnapshot> pendingSnapshot;
+	uint32_t pendingTicket = 0;
+
+	std::optional<PathJobResult> finishedResult;
+	uint32_t finishedTicket = 0;
+
+	/** Ticket of the job being searched right now, its result is dropped if this changes meanwhile. */
+	uint32_t runningTicket = 0;
+	uint32_t nextTicket = 1;
+	bool stop = false;
+};
+
+std::optional<PathWorkerState> State;
+SdlThread WorkerThread;
+
+/** Step offsets indexed by the path directions returned by GetPathDirection. */
+constexpr Displacement PathStepOffsets[9] = {
+	{ 0, 0 },
+	{ 0, -1 },
+	{ -1, 0 },
+	{ 1, 0 },
+	{ 0, 1 },
+	{ -1, -1 },
+	{ 1, -1 },
+	{ 1, 1 },
+	{ -1, 1 },
+};
+
+[[nodiscard]] bool IsInGrid(Point position)
+{
+	return position.x >= 0 && position.x < MAXDUNX && position.y >= 0 && position.y < MAXDUNY;
+}
+
+[[nodiscard]] bool IsSnapshotTileNotSolid(const PathSnapshot &snapshot, Point position)
+{
+	return IsInGrid(position) && !snapshot.solid.test(position.x, position.y);
+}
+
+/** @brief Same as CanStep, but looking at the snapshot instead of the live level. */
+[[nodiscard]] bool SnapshotCanStep(const PathSnapshot &snapshot, Point startPosition, Point destinationPosition)
+{
+	switch (GetPathDirection(startPosition, destinationPosition)) {
+	case 5: // Stepping north
+		return IsSnapshotTileNotSolid(snapshot, destinationPosition + Displacement { 0, 1 }) && IsSnapshotTileNotSolid(snapshot, destinationPosition + Displacement { 1, 0 });
+	case 6: // Stepping east
+		return IsSnapshotTileNotSolid(snapshot, destinationPosition + Displacement { 0, 1 }) && IsSnapshotTileNotSolid(snapshot, destinationPosition + Displacement { -1, 0 });
+	case 7: // Stepping south
+		return IsSnapshotTileNotSolid(snapshot, destinationPosition + Displacement { 0, -1 }) && IsSnapshotTileNotSolid(snapshot, destinationPosition + Displacement { -1, 0 });
+	case 8: // Stepping west
+		return IsSnapshotTileNotSolid(snapshot, destinationPosition + Displacement { 1, 0 }) && IsSnapshotTileNotSolid(snapshot, destinationPosition + Displacement { 0, -1 });
+	default:
+		return true;
+	}
+}
+
+int FindSnapshotPath(const PathSnapshot &snapshot, const Bitset2d<MAXDUNX, MAXDUNY> &passable, Point startPosition, Point destinationPosition, int8_t *path)
+{
+	return FindPath(
+	    [&snapshot](Point from, Point to) { return SnapshotCanStep(snapshot, from, to); },
+	    [&passable](Point position) { return IsInGrid(position) && passable.test(position.x, position.y); },
+	    startPosition, destinationPosition, path, MaxAutoWalkPathLength);
+}
+
+PathJobResult RunPathJob(const PathJob &job, const PathSnapshot &snapshot)
+{
+	PathJobResult result {
+		.job = job,
+		.destination = job.destination,
+		.closedDoor = std::nullopt,
+		.steps = 0,
+		.path = {},
+	};
+
+	result.steps = FindSnapshotPath(snapshot, snapshot.passable, job.start, job.destination, result.path.data());
+	if (result.steps != 0 || !job.routeBeforeClosedDoor)
+		return result;
+
+	std::array<int8_t, MaxAutoWalkPathLength> ignoreDoorPath;
+	const int ignoreDoorSteps = FindSnapshotPath(snapshot, snapshot.passableIgnoringDoors, job.start, job.destination, ignoreDoorPath.data());
+
+	Point position = job.start;
+	for (int i = 0; i < ignoreDoorSteps; ++i) {
+		const Point next = position + PathStepOffsets[ignoreDoorPath[i]];
+		if (snapshot.closedDoor.test(next.x, next.y)) {
+			result.destination = position;
+			result.closedDoor = next;
+			result.steps = FindSnapshotPath(snapshot, snapshot.passable, job.start, position, result.path.data());
+			break;
+		}
+		position = next;
+	}
+
+	return result;
+}
+
+void PathWorkerLoop()
+{
+	PathWorkerState &state = *State;
+	std::unique_lock<SdlMutex> lock(state.mutex);
+	while (true) {
+		while (!state.stop && !state.pendingJob)
+			state.wakeUp.wait(state.mutex);
+		if (state.stop)
+			return;
+
+		const PathJob job = *state.pendingJob;
+		const std::unique_ptr<PathSnapshot> snapshot = std::move(state.pendingSnapshot);
+		state.runningTicket = state.pendingTicket;
+		state.pendingJob = std::nullopt;
+
+		lock.unlock();
+		PathJobResult result = RunPathJob(job, *snapshot);
+		lock.lock();
+
+		if (state.runningTicket != 0) {
+			state.finishedResult = std::move(result);
+			state.finishedTicket = state.runningTicket;
+			state.runningTicket = 0;
+		}
+	}
+}
+
+} // namespace
+
+uint32_t SubmitPathJob(const PathJob &job, std::unique_ptr<PathSnapshot> snapshot)
+{
+#ifdef __DJGPP__
+	// No threads, search right away.
+	if (!State)
+		State.emplace();
+	const uint32_t ticket = State->nextTicket++;
+	State->finishedResult = RunPathJob(job, *snapshot);
+	State->finishedTicket = ticket;
+	return ticket;
+#else
+	if (!State)
+		State.emplace();
+
+	uint32_t ticket;
+	{
+		const std::lock_guard<SdlMutex> lock(State->mutex);
+		ticket = State->nextTicket++;
+		State->pendingJob = job;
+		State->pendingSnapshot = std::move(snapshot);
+		State->pendingTicket = ticket;
+	}
+	State->wakeUp.signal();
+
+	if (!WorkerThread.joinable())
+		WorkerThread = SdlThread { PathWorkerLoop };
+	return ticket;
+#endif
+}
+
+std::optional<PathJobResult> TakePathJobResult(uint32_t ticket)
+{
+	if (!State)
+		return std::nullopt;
+
+	const std::lock_guard<SdlMutex> lock(State->mutex);
+	if (!State->finishedResult || State->finishedTicket != ticket)
+		return std::nullopt;
+
+	std::optional<PathJobResult> result = std::move(State->finishedResult);
+	State->finishedResult = std::nullopt;
+	return result;
+}
+
+void CancelPathJobs()
+{
+	if (!State)
+		return;
+
+	const std::lock_guard<SdlMutex> lock(State->mutex);
+	State->pendingJob = std::nullopt;
+	State->pendingSnapshot = nullptr;
+	State->runningTicket = 0;
+	State->finishedResult = std::nullopt;
+}
+
+void ShutdownPathWorker()
+{
+	if (!State)
+		return;
+
+	if (WorkerThread.joinable()) {
+		{
+			const std::lock_guard<SdlMutex> lock(State->mutex);
+			State->stop = true;
+		}
+		State->wakeUp.signal();
+		WorkerThread.join();
+	}
+	State = std::nullopt;
+}
+
+} // namespace devilution
@@ -0,0 +1,74 @@
+/**
+ * @file path_worker.hpp
+ *
+ * Interface of the background path search used by auto-walk.
+ */
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+
+#include "engine/point.hpp"
+#include "levels/gendung_defs.hpp"
+#include "utils/bitset2d.hpp"
+
+namespace devilution {
+
+constexpr size_t MaxAutoWalkPathLength = 512;
+
+/**
+ * @brief Copy of the walkability state taken on the game thread, so that a path can be searched while the game keeps running.
+ */
+struct PathSnapshot {
+	/** Tiles the player can stand on (see PosOkPlayer). */
+	Bitset2d<MAXDUNX, MAXDUNY> passable;
+	/** Same as `passable`, but treating doors as open. */
+	Bitset2d<MAXDUNX, MAXDUNY> passableIgnoringDoors;
+	/** Tiles made solid by the dungeon itself, used to reject diagonal steps around corners (see CanStep). */
+	Bitset2d<MAXDUNX, MAXDUNY> solid;
+	/** Tiles covered by a closed door. */
+	Bitset2d<MAXDUNX, MAXDUNY> closedDoor;
+};
+
+struct PathJob {
+	Point start;
+	Point destination;
+	/**
+	 * If there is no path, search again treating doors as open,
+	 * and walk up to the first closed door on that path instead.
+	 */
+	bool routeBeforeClosedDoor;
+};
+
+struct PathJobResult {
+	PathJob job;
+	/** The tile the path leads to, either the job's destination or the tile before a closed door. */
+	Point destination;
+	/** The first closed door on the path, if the path was shortened because of it. */
+	std::optional<Point> closedDoor;
+	/** Number of steps in `path`, 0 if no path was found. */
+	int steps;
+	std::array<int8_t, MaxAutoWalkPathLength> path;
+};
+
+/**
+ * @brief Queues a path search on the worker thread, replacing any job that hasn't started yet.
+ * @return A ticket to collect the result with.
+ */
+uint32_t SubmitPathJob(const PathJob &job, std::unique_ptr<PathSnapshot> snapshot);
+
+/**
+ * @brief Collects the result of the job with the given ticket, if it has finished.
+ */
+std::optional<PathJobResult> TakePathJobResult(uint32_t ticket);
+
+/** @brief Drops the pending job and any result that hasn't been collected yet. */
+void CancelPathJobs();
+
+/** @brief Stops the worker thread. */
+void ShutdownPathWorker();
+
+} // namespace devilution
@@ -1,5 +1,7 @@
 #include "engine/random.hpp"
 
+#include <algorithm>
+#include <array>
 #include <bit>
 #include <chrono>
 #include <cmath>
@@ -7,6 +9,7 @@
 #include <cstring>
 #include <limits>
 #include <random>
+#include <span>
 
 namespace devilution {
 
@@ -14,7 +17,7 @@ namespace devilution {
 uint32_t sglGameSeed;
 
 /** Borland C/C++ psuedo-random number generator needed for vanilla compatibility */
-std::linear_congruential_engine<uint32_t, 0x015A4E35, 1, 0> diabloGenerator;
+DiabloLCG diabloGenerator;
 
 /** Xoshiro pseudo-random number generator to provide less predictable seeds */
 xoshiro128plusplus seedGenerator;
@@ -74,10 +77,9 @@ uint32_t GetLCGEngineState()
 
 void DiscardRandomValues(unsigned count)
 {
-	while (count != 0) {
-		GenerateRandomNumber();
-		count--;
-	}
+	if (count == 0)
+		return;
+	SetRndSeed(JumpLCGState(sglGameSeed, count));
 }
 
 uint32_t GenerateRandomNumber()
@@ -86,20 +88,70 @@ uint32_t GenerateRandomNumber()
 	return sglGameSeed;
 }
 
-int32_t AdvanceRndSeed()
+void GenerateRandomNumbers(std::span<uint32_t> values)
+{
+	// Interleaving a few sequences that each skip ahead by that many rounds breaks the dependency on the previous
+	// value, so the loop can be vectorized.
+	constexpr size_t Lanes = 4;
+	constexpr uint32_t LaneMultiplier = JumpLCGState(1, Lanes) - JumpLCGState(0, Lanes);
+	constexpr uint32_t LaneIncrement = JumpLCGState(0, Lanes);
+
+	const size_t head = std::min(values.size(), Lanes);
+	for (size_t i = 0; i < head; i++)
+		values[i] = GenerateRandomNumber();
+	if (values.size() <= Lanes)
+		return;
+	for (size_t i = Lanes; i < values.size(); i++)
+		values[i] = LaneMultiplier * values[i - Lanes] + LaneIncrement;
+	SetRndSeed(values.back());
+}
+
+namespace {
+
+int32_t SeedFromState(uint32_t state)
 {
-	const int32_t seed = static_cast<int32_t>(GenerateRandomNumber());
+	const int32_t seed = static_cast<int32_t>(state);
 	// since abs(INT_MIN) is undefined behavior, handle this value specially
 	return seed == std::numeric_limits<int32_t>::min() ? std::numeric_limits<int32_t>::min() : std::abs(seed);
 }
 
+/** @brief Turns a value from AdvanceRndSeed() into a GenerateRnd(v) result, v must be positive. */
+int32_t LimitSeed(int32_t seed, int32_t v)
+{
+	if (v <= 0x7FFF) // use the high bits to correct for LCG bias
+		return (seed >> 16) % v;
+	return seed % v;
+}
+
+} // namespace
+
+int32_t AdvanceRndSeed()
+{
+	return SeedFromState(GenerateRandomNumber());
+}
+
 int32_t GenerateRnd(int32_t v)
 {
 	if (v <= 0)
 		return 0;
-	if (v <= 0x7FFF) // use the high bits to correct for LCG bias
-		return (AdvanceRndSeed() >> 16) % v;
-	return AdvanceRndSeed() % v;
+	return LimitSeed(AdvanceRndSeed(), v);
+}
+
+int32_t GenerateRndSum(int32_t v, int32_t count)
+{
+	if (v <= 0)
+		return 0;
+
+	std::array<uint32_t, 16> values;
+	int32_t sum = 0;
+	while (count > 0) {
+		const std::span<uint32_t> batch { values.data(), std::min<size_t>(values.size(), static_cast<size_t>(count)) };
+		GenerateRandomNumbers(batch);
+		for (const uint32_t value : batch)
+			sum += LimitSeed(SeedFromState(value), v);
+		count -= static_cast<int32_t>(batch.size());
+	}
+	return sum;
 }
 
 bool FlipCoin(unsigned frequency)
@@ -11,13 +11,37 @@
 #include <cstdint>
 #include <initializer_list>
 #include <random>
+#include <span>
 
 namespace devilution {
 
+/** Borland C/C++ psuedo-random number generator needed for vanilla compatibility */
+using DiabloLCG = std::linear_congruential_engine<uint32_t, 0x015A4E35, 1, 0>;
+
+/**
+ * @brief Works out the state of the vanilla LCG after the given number of rounds in O(log count) steps
+ * @param state The current engine state
+ * @param count How many rounds to skip
+ * @return The engine state after count rounds
+ */
+constexpr uint32_t JumpLCGState(uint32_t state, uint64_t count)
+{
+	// Applying x -> a * x + c twice gives x -> a^2 * x + (a + 1) * c, so the rounds can be squared up like a power.
+	uint32_t multiplier = DiabloLCG::multiplier;
+	uint32_t increment = DiabloLCG::increment;
+	while (count != 0) {
+		if ((count & 1) != 0)
+			state = multiplier * state + increment;
+		increment *= multiplier + 1;
+		multiplier *= multiplier;
+		count >>= 1;
+	}
+	return state;
+}
+
 class DiabloGenerator {
 private:
-	/** Borland C/C++ psuedo-random number generator needed for vanilla compatibility */
-	std::linear_congruential_engine<uint32_t, 0x015A4E35, 1, 0> lcg;
+	DiabloLCG lcg;
 
 public:
 	/**
@@ -37,7 +61,9 @@ public:
 	 */
 	void discardRandomValues(unsigned count)
 	{
-		lcg.discard(count);
+		if (count == 0)
+			return;
+		lcg.seed(JumpLCGState(lcg(), count - 1));
 	}
 
 	/**
@@ -323,6 +349,14 @@ void DiscardRandomValues(unsigned count);
  */
 uint32_t GenerateRandomNumber();
 
+/**
+ * @brief Fills the buffer with the next values of the global RandomNumberEngine
+ *
+ * Gives the same values and leaves the engine in the same state as calling GenerateRandomNumber() once per element.
+ * @param values Where to store the values
+ */
+void GenerateRandomNumbers(std::span<uint32_t> values);
+
 /**
  * @brief Generates a random non-negative integer (most of the time) using the vanilla RNG
  *
@@ -353,6 +387,14 @@ uint32_t GenerateRandomNumber();
  */
 int32_t GenerateRnd(int32_t v);
 
+/**
+ * @brief Adds up the given number of GenerateRnd(v) results, drawing the values in batches
+ * @param v The upper limit for each value
+ * @param count How many values to add up
+ * @return The same sum as calling GenerateRnd(v) count times
+ */
+int32_t GenerateRndSum(int32_t v, int32_t count);
+
 /**
  * @brief Generates a random boolean value using the vanilla RNG
  *
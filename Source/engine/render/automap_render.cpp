@@ -55,6 +55,8 @@ void DrawMapLineSteep(const Surface &out, Point from, int width, std::uint8_t co
 	SetMapPixel(out, from, colorIndex);
 }
 
+bool MapPixelsToLayer = false;
+
 } // namespace
 
 void DrawMapLineNS(const Surface &out, Point from, int height, std::uint8_t colorIndex)
@@ -163,8 +165,18 @@ void DrawMapFreeLine(const Surface &out, Point from, Point to, uint8_t colorInde
 	}
 }
 
+void SetMapPixelsToLayer(bool enabled)
+{
+	MapPixelsToLayer = enabled;
+}
+
 void SetMapPixel(const Surface &out, Point position, uint8_t color)
 {
+	if (MapPixelsToLayer) {
+		out.SetPixel(position, color);
+		return;
+	}
+
 	if (GetAutomapType() == AutomapType::Minimap && !MinimapRect.contains(position))
 		return;
 
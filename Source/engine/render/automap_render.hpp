@@ -99,4 +99,11 @@ void DrawMapFreeLine(const Surface &out, Point from, Point to, uint8_t colorInde
  */
 void SetMapPixel(const Surface &out, Point position, uint8_t color);
 
+/**
+ * @brief Draw map pixels as they are, for a layer that is blended into the automap later.
+ *
+ * While enabled, SetMapPixel neither clips to the minimap nor blends.
+ */
+void SetMapPixelsToLayer(bool enabled);
+
 } // namespace devilution
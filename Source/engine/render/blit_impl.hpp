@@ -1,5 +1,6 @@
 #pragma once
 
+#include <bit>
 #include <cstdint>
 #include <cstring>
 #include <execution>
@@ -74,13 +75,47 @@ DVL_ALWAYS_INLINE DVL_ATTRIBUTE_HOT void BlitFillWithLightmap(uint8_t *dst, unsi
 	});
 }
 
+/**
+ * @brief Number of light levels from the start of `light` that are the same as the first one, at most `length`.
+ *
+ * Compares 8 levels at a time, the lightmap only changes where the light does, so runs are long.
+ */
+DVL_ALWAYS_INLINE DVL_ATTRIBUTE_HOT unsigned LightRunLength(const uint8_t *DVL_RESTRICT light, unsigned length)
+{
+	const uint64_t repeated = uint64_t { 0x0101010101010101 } * light[0];
+	unsigned run = 1;
+	for (; run + 8 <= length; run += 8) {
+		uint64_t levels;
+		std::memcpy(&levels, light + run, sizeof(levels));
+		const uint64_t differences = levels ^ repeated;
+		if (differences != 0) {
+			if constexpr (std::endian::native == std::endian::little)
+				return run + static_cast<unsigned>(std::countr_zero(differences)) / 8;
+			else
+				return run + static_cast<unsigned>(std::countl_zero(differences)) / 8;
+		}
+	}
+	while (run < length && light[run] == light[0])
+		++run;
+	return run;
+}
+
 DVL_ALWAYS_INLINE DVL_ATTRIBUTE_HOT void BlitPixelsWithLightmap(uint8_t *DVL_RESTRICT dst, const uint8_t *DVL_RESTRICT src, unsigned length, const Lightmap &lightmap)
 {
 	DVL_ASSUME(length != 0);
 	const uint8_t *light = lightmap.getLightingAt(dst);
-	std::transform(DEVILUTIONX_BLIT_EXECUTION_POLICY src, src + length, light, dst, [&lightmap](uint8_t srcColor, uint8_t lightLevel) {
-		return lightmap.adjustColor(srcColor, lightLevel);
-	});
+	// Each run of equal light levels is a plain lookup in a single table, or no lookup at all when fully lit or dark.
+	for (unsigned i = 0; i < length;) {
+		const unsigned run = LightRunLength(light + i, length - i);
+		const uint8_t *tbl = lightmap.lightTable(light[i]);
+		if (lightmap.isFullyLitLightTable(tbl))
+			BlitPixelsDirect(dst + i, src + i, run);
+		else if (lightmap.isFullyDarkLightTable(tbl))
+			BlitFillDirect(dst + i, run, 0);
+		else
+			BlitPixelsWithMap(dst + i, src + i, run, tbl);
+		i += run;
+	}
 }
 
 struct BlitWithLightmap {
@@ -158,24 +193,10 @@ DVL_ALWAYS_INLINE DVL_ATTRIBUTE_HOT void BlitPixelsBlendedWithLightmap(uint8_t *
 {
 	DVL_ASSUME(length != 0);
 	const uint8_t *light = lightmap.getLightingAt(dst);
-
-	if (length < 1024) {
-		uint8_t litSrc[1024];
-		std::transform(DEVILUTIONX_BLIT_EXECUTION_POLICY src, src + length, light, litSrc, [&lightmap](uint8_t srcColor, uint8_t lightLevel) {
-			return lightmap.adjustColor(srcColor, lightLevel);
-		});
-		std::transform(DEVILUTIONX_BLIT_EXECUTION_POLICY litSrc, litSrc + length, dst, dst, [pal = paletteTransparencyLookup](uint8_t srcColor, uint8_t dstColor) {
-			return pal[dstColor][srcColor];
-		});
-		return;
-	}
-
-	for (size_t i = 0; i < length; i++) {
-		uint8_t srcColor = src[i];
-		uint8_t dstColor = dst[i];
-		uint8_t lightLevel = light[i];
-		uint8_t litColor = lightmap.adjustColor(srcColor, lightLevel);
-		dst[i] = paletteTransparencyLookup[dstColor][litColor];
+	for (unsigned i = 0; i < length;) {
+		const unsigned run = LightRunLength(light + i, length - i);
+		BlitPixelsBlendedWithMap(dst + i, src + i, run, lightmap.lightTable(light[i]));
+		i += run;
 	}
 }
 
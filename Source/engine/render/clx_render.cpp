@@ -6,7 +6,10 @@
 #include "clx_render.hpp"
 
 #include <algorithm>
+#include <array>
 #include <cstdint>
+#include <cstring>
+#include <vector>
 
 #include "engine/point.hpp"
 #include "engine/render/blit_impl.hpp"
@@ -238,12 +241,34 @@ constexpr size_t MaxOutlineSpriteWidth = 253;
 using OutlinePixels = StaticVector<PointOf<uint8_t>, MaxOutlinePixels>;
 using OutlineRowSolidRuns = StaticVector<std::pair<uint8_t, uint8_t>, MaxOutlineSpriteWidth / 2 + 1>;
 
-struct OutlinePixelsCacheEntry {
-	OutlinePixels outlinePixels;
+/** A run of outline pixels on a row, relative to the sprite's top-left corner minus one pixel. */
+struct OutlineSpan {
+	uint8_t x;
+	uint8_t y;
+	uint8_t length;
+};
+
+struct OutlineCacheEntry {
+	std::vector<OutlineSpan> spans;
+	/**
+	 * The sprite is told apart by its size as well, as sprites freed without clearing the cache
+	 * can leave their address to another one.
+	 */
 	const void *spriteData = nullptr;
+	uint32_t spriteDataSize = 0;
+	uint16_t spriteWidth = 0;
+	uint16_t spriteHeight = 0;
 	bool skipColorIndexZero;
+	uint32_t lastUse = 0;
 };
-OutlinePixelsCacheEntry OutlinePixelsCache;
+
+/** Several monsters, items and towners can be outlined in the same frame, each keeps its entry. */
+constexpr size_t OutlineCacheSize = 16;
+std::array<OutlineCacheEntry, OutlineCacheSize> OutlineCache;
+uint32_t OutlineCacheUses = 0;
+
+/** The outline pixels of the sprite being added to the cache. */
+OutlinePixels OutlinePixelsScratch;
 
 void PopulateOutlinePixelsForRow(
     const OutlineRowSolidRuns &runs,
@@ -388,33 +413,80 @@ void GetOutline(ClxSprite sprite, OutlinePixels &result) // NOLINT(readability-f
 	}
 }
 
+/** @brief Merges the outline pixels into runs along the rows, dropping the pixels that were found twice. */
+void OutlinePixelsToSpans(OutlinePixels &pixels, std::vector<OutlineSpan> &spans)
+{
+	std::sort(pixels.begin(), pixels.end(), [](PointOf<uint8_t> a, PointOf<uint8_t> b) {
+		return a.y != b.y ? a.y < b.y : a.x < b.x;
+	});
+	spans.clear();
+	for (const PointOf<uint8_t> pixel : pixels) {
+		if (!spans.empty() && spans.back().y == pixel.y) {
+			OutlineSpan &span = spans.back();
+			const int end = span.x + span.length;
+			if (pixel.x < end)
+				continue;
+			if (pixel.x == end && span.length < UINT8_MAX) {
+				++span.length;
+				continue;
+			}
+		}
+		spans.push_back({ pixel.x, pixel.y, 1 });
+	}
+}
+
+/**
+ * @brief The outline of a sprite, from the cache or found and added to it in place of the least recently used one.
+ */
 template <bool SkipColorIndexZero>
-void UpdateOutlinePixelsCache(ClxSprite sprite)
+const std::vector<OutlineSpan> &GetOutlineSpans(ClxSprite sprite)
 {
-	if (OutlinePixelsCache.spriteData == sprite.pixelData()
-	    && OutlinePixelsCache.skipColorIndexZero == SkipColorIndexZero) {
-		return;
+	++OutlineCacheUses;
+	OutlineCacheEntry *leastRecentlyUsed = &OutlineCache[0];
+	for (OutlineCacheEntry &entry : OutlineCache) {
+		if (entry.spriteData == sprite.pixelData() && entry.spriteDataSize == sprite.pixelDataSize()
+		    && entry.spriteWidth == sprite.width() && entry.spriteHeight == sprite.height()
+		    && entry.skipColorIndexZero == SkipColorIndexZero) {
+			entry.lastUse = OutlineCacheUses;
+			return entry.spans;
+		}
+		if (entry.lastUse < leastRecentlyUsed->lastUse)
+			leastRecentlyUsed = &entry;
 	}
-	OutlinePixelsCache.skipColorIndexZero = SkipColorIndexZero;
-	OutlinePixelsCache.spriteData = sprite.pixelData();
-	OutlinePixelsCache.outlinePixels.clear();
-	GetOutline<SkipColorIndexZero>(sprite, OutlinePixelsCache.outlinePixels);
+
+	OutlinePixelsScratch.clear();
+	GetOutline<SkipColorIndexZero>(sprite, OutlinePixelsScratch);
+	OutlineCacheEntry &entry = *leastRecentlyUsed;
+	OutlinePixelsToSpans(OutlinePixelsScratch, entry.spans);
+	entry.spriteData = sprite.pixelData();
+	entry.spriteDataSize = sprite.pixelDataSize();
+	entry.spriteWidth = sprite.width();
+	entry.spriteHeight = sprite.height();
+	entry.skipColorIndexZero = SkipColorIndexZero;
+	entry.lastUse = OutlineCacheUses;
+	return entry.spans;
 }
 
 template <bool SkipColorIndexZero>
 void RenderClxOutline(const Surface &out, Point position, ClxSprite sprite, uint8_t color)
 {
-	UpdateOutlinePixelsCache<SkipColorIndexZero>(sprite);
+	const std::vector<OutlineSpan> &spans = GetOutlineSpans<SkipColorIndexZero>(sprite);
 	--position.x;
 	position.y -= sprite.height();
 	if (position.x >= 0 && position.x + sprite.width() + 2 < out.w()
 	    && position.y >= 0 && position.y + sprite.height() + 2 < out.h()) {
-		for (const auto &[x, y] : OutlinePixelsCache.outlinePixels) {
-			*out.at(position.x + x, position.y + y) = color;
+		for (const OutlineSpan &span : spans) {
+			std::memset(out.at(position.x + span.x, position.y + span.y), color, span.length);
 		}
 	} else {
-		for (const auto &[x, y] : OutlinePixelsCache.outlinePixels) {
-			out.SetPixel(Point(position.x + x, position.y + y), color);
+		for (const OutlineSpan &span : spans) {
+			const int y = position.y + span.y;
+			if (y < 0 || y >= out.h())
+				continue;
+			const int begin = std::max(position.x + span.x, 0);
+			const int end = std::min(position.x + span.x + span.length, out.w());
+			if (begin < end)
+				std::memset(out.at(begin, y), color, end - begin);
 		}
 	}
 }
@@ -620,7 +692,11 @@ void ClxDrawOutlineSkipColorZero(const Surface &out, uint8_t col, Point position
 
 void ClearClxDrawCache()
 {
-	OutlinePixelsCache.spriteData = nullptr;
+	for (OutlineCacheEntry &entry : OutlineCache) {
+		entry.spriteData = nullptr;
+		entry.lastUse = 0;
+	}
+	OutlineCacheUses = 0;
 }
 
 } // namespace devilution
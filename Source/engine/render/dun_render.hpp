@@ -126,6 +126,14 @@ DVL_ALWAYS_INLINE const uint8_t *GetDunFrame(const std::byte *dungeonCelData, ui
 	return reinterpret_cast<const uint8_t *>(&dungeonCelData[Swap32LE(frameTable[frame])]);
 }
 
+/**
+ * @brief Returns the raw data for a dungeon frame that was already looked up.
+ */
+DVL_ALWAYS_INLINE const uint8_t *GetDunFrame(const std::byte *dungeonCelData, DunFrameRef frame)
+{
+	return reinterpret_cast<const uint8_t *>(&dungeonCelData[frame.offset]);
+}
+
 /**
  * @brief Returns the raw data for the given dungeon frame's foliage.
  */
@@ -166,6 +174,30 @@ DVL_ALWAYS_INLINE void RenderTileFoliage(const Surface &out, const Lightmap &lig
 	    GetDunFrameFoliage(dungeonCelData, levelCelBlock.frame()), /*height=*/16, MaskType::Solid, tbl);
 }
 
+/**
+ * @brief Blit a world CEL frame that was already looked up to the given buffer
+ * @see RenderTile
+ */
+DVL_ALWAYS_INLINE void RenderTile(const Surface &out, const Lightmap &lightmap, const Point &position,
+    const std::byte *dungeonCelData, DunFrameRef frame, MaskType maskType, const uint8_t *tbl)
+{
+	RenderTileFrame(out, lightmap, position, frame.type, GetDunFrame(dungeonCelData, frame),
+	    (frame.type == TileType::LeftTriangle || frame.type == TileType::RightTriangle)
+	        ? DunFrameTriangleHeight
+	        : DunFrameHeight,
+	    maskType, tbl);
+}
+
+/**
+ * @brief Renders a floor foliage tile that was already looked up.
+ */
+DVL_ALWAYS_INLINE void RenderTileFoliage(const Surface &out, const Lightmap &lightmap, const Point &position,
+    const std::byte *dungeonCelData, DunFrameRef frame, const uint8_t *tbl)
+{
+	RenderTileFrame(out, lightmap, Point { position.x, position.y - 16 }, TileType::TransparentSquare,
+	    GetDunFrame(dungeonCelData, frame) + ReencodedTriangleFrameSize, /*height=*/16, MaskType::Solid, tbl);
+}
+
 /**
  * @brief Render a black 64x31 tile ◆
  * @param out Target buffer
@@ -0,0 +1,158 @@
+/**
+ * @file floor_tile_cache.cpp
+ *
+ * Implementation of the cache of floor triangles that were already rendered at a light level.
+ */
+#include "engine/render/floor_tile_cache.hpp"
+
+#include <cstddef>
+#include <cstring>
+
+#include "engine/render/dun_render.hpp"
+#include "lighting.h"
+
+namespace devilution {
+
+namespace {
+
+/** About two screens of distinct triangles and light levels at 640x480. */
+constexpr uint16_t Capacity = 512;
+
+constexpr size_t TriangleSize = static_cast<size_t>(DunFrameWidth) * DunFrameTriangleHeight;
+
+} // namespace
+
+uint8_t *FloorTileCache::Pixels(uint16_t index) const
+{
+	return &atlas_[index * TriangleSize];
+}
+
+void FloorTileCache::Clear()
+{
+	index_.clear();
+	entries_.clear();
+	newest_ = NoEntry;
+	oldest_ = NoEntry;
+}
+
+void FloorTileCache::Unlink(uint16_t index)
+{
+	Entry &entry = entries_[index];
+	if (entry.newer != NoEntry)
+		entries_[entry.newer].older = entry.older;
+	else
+		newest_ = entry.older;
+	if (entry.older != NoEntry)
+		entries_[entry.older].newer = entry.newer;
+	else
+		oldest_ = entry.newer;
+}
+
+void FloorTileCache::MakeNewest(uint16_t index)
+{
+	Entry &entry = entries_[index];
+	entry.newer = NoEntry;
+	entry.older = newest_;
+	if (newest_ != NoEntry)
+		entries_[newest_].newer = index;
+	newest_ = index;
+	if (oldest_ == NoEntry)
+		oldest_ = index;
+}
+
+void FloorTileCache::Touch(uint16_t index)
+{
+	if (index == newest_)
+		return;
+	Unlink(index);
+	MakeNewest(index);
+}
+
+uint16_t FloorTileCache::Render(const Lightmap &lightmap, Key key, TileType tile)
+{
+	if (atlas_ == nullptr) {
+		atlas_ = std::make_unique<uint8_t[]>(Capacity * TriangleSize);
+		entries_.reserve(Capacity);
+		index_.reserve(Capacity);
+	}
+	if (!scratch_)
+		scratch_.emplace(static_cast<int>(DunFrameWidth), static_cast<int>(DunFrameTriangleHeight));
+
+	uint16_t slot;
+	if (entries_.size() < Capacity) {
+		slot = static_cast<uint16_t>(entries_.size());
+		entries_.push_back({ .key = key, .rows = {}, .copyable = true, .newer = NoEntry, .older = NoEntry });
+	} else {
+		slot = oldest_;
+		Unlink(slot);
+		index_.erase(entries_[slot].key);
+		entries_[slot].key = key;
+	}
+
+	// The triangle is rendered over two backgrounds, a pixel it covers comes out the same over both.
+	const Surface &scratch = *scratch_;
+	const Point bottomLeft { 0, DunFrameTriangleHeight - 1 };
+	uint8_t *pixels = Pixels(slot);
+	std::memset(scratch.begin(), 0, static_cast<size_t>(scratch.pitch()) * scratch.h());
+	RenderTileFrame(scratch, lightmap, bottomLeft, tile, key.src, DunFrameTriangleHeight, MaskType::Solid, key.tbl);
+	for (int y = 0; y < DunFrameTriangleHeight; ++y)
+		std::memcpy(&pixels[y * DunFrameWidth], scratch.at(0, y), DunFrameWidth);
+	std::memset(scratch.begin(), 0xFF, static_cast<size_t>(scratch.pitch()) * scratch.h());
+	RenderTileFrame(scratch, lightmap, bottomLeft, tile, key.src, DunFrameTriangleHeight, MaskType::Solid, key.tbl);
+
+	Entry &entry = entries_[slot];
+	entry.copyable = true;
+	for (int y = 0; y < DunFrameTriangleHeight; ++y) {
+		const uint8_t *row = &pixels[y * DunFrameWidth];
+		const uint8_t *probe = scratch.at(0, y);
+		int start = 0;
+		while (start < DunFrameWidth && row[start] != probe[start])
+			++start;
+		int end = start;
+		while (end < DunFrameWidth && row[end] == probe[end])
+			++end;
+		entry.rows[y] = { static_cast<uint8_t>(start), static_cast<uint8_t>(end - start) };
+		for (int x = end; x < DunFrameWidth; ++x) {
+			if (row[x] == probe[x])
+				entry.copyable = false;
+		}
+	}
+
+	index_.emplace(key, slot);
+	MakeNewest(slot);
+	return slot;
+}
+
+bool FloorTileCache::Draw(const Surface &out, const Lightmap &lightmap, Point position, TileType tile, const uint8_t *src, const uint8_t *tbl)
+{
+	const int top = position.y - (DunFrameTriangleHeight - 1);
+	if (position.x < 0 || position.x + DunFrameWidth > out.w() || top < 0 || position.y >= out.h())
+		return false;
+
+	if (lightTablesVersion_ != LightTablesVersion) {
+		Clear();
+		lightTablesVersion_ = LightTablesVersion;
+	}
+
+	const Key key { src, tbl };
+	uint16_t slot;
+	if (const auto it = index_.find(key); it != index_.end()) {
+		slot = it->second;
+		Touch(slot);
+	} else {
+		slot = Render(lightmap, key, tile);
+	}
+
+	const Entry &entry = entries_[slot];
+	if (!entry.copyable)
+		return false;
+	const uint8_t *pixels = Pixels(slot);
+	for (int y = 0; y < DunFrameTriangleHeight; ++y) {
+		const RowSpan span = entry.rows[y];
+		if (span.length != 0)
+			std::memcpy(out.at(position.x + span.start, top + y), &pixels[y * DunFrameWidth + span.start], span.length);
+	}
+	return true;
+}
+
+} // namespace devilution
@@ -0,0 +1,89 @@
+/**
+ * @file floor_tile_cache.hpp
+ *
+ * Interface of the cache of floor triangles that were already rendered at a light level.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include <ankerl/unordered_dense.h>
+
+#include "engine/point.hpp"
+#include "engine/render/light_render.hpp"
+#include "engine/surface.hpp"
+#include "levels/dun_tile.hpp"
+
+namespace devilution {
+
+/**
+ * @brief Floor triangles rendered once per light table and then copied row by row.
+ *
+ * The least recently drawn triangle makes room for a new one. Each render band has its own cache,
+ * so a cache is never used by two threads at once.
+ */
+class FloorTileCache {
+public:
+	/**
+	 * @brief Draws a floor triangle with a uniform light table from the cache, rendering it into the cache first if needed.
+	 * @return false if the triangle isn't entirely inside `out`, it has to be rendered normally then.
+	 */
+	bool Draw(const Surface &out, const Lightmap &lightmap, Point position, TileType tile, const uint8_t *src, const uint8_t *tbl);
+
+	void Clear();
+
+private:
+	struct Key {
+		const uint8_t *src;
+		const uint8_t *tbl;
+
+		bool operator==(const Key &) const = default;
+	};
+
+	struct KeyHash {
+		size_t operator()(const Key &key) const noexcept
+		{
+			return std::hash<const uint8_t *> {}(key.src) ^ (std::hash<const uint8_t *> {}(key.tbl) << 1);
+		}
+	};
+
+	/** The covered columns of a row of a triangle. */
+	struct RowSpan {
+		uint8_t start;
+		uint8_t length;
+	};
+
+	struct Entry {
+		Key key;
+		RowSpan rows[DunFrameTriangleHeight];
+		/** Whether every row covers a single run of columns, otherwise the triangle is always rendered normally. */
+		bool copyable;
+		uint16_t newer;
+		uint16_t older;
+	};
+
+	uint16_t Render(const Lightmap &lightmap, Key key, TileType tile);
+	void MakeNewest(uint16_t index);
+	void Touch(uint16_t index);
+	void Unlink(uint16_t index);
+	[[nodiscard]] uint8_t *Pixels(uint16_t index) const;
+
+	/** Everything is dropped when this stops matching LightTablesVersion. */
+	uint32_t lightTablesVersion_ = 0;
+	ankerl::unordered_dense::map<Key, uint16_t, KeyHash> index_;
+	std::vector<Entry> entries_;
+	/** The rendered triangles, one after the other with a pitch of DunFrameWidth. */
+	std::unique_ptr<uint8_t[]> atlas_;
+	std::optional<OwnedSurface> scratch_;
+	uint16_t newest_ = NoEntry;
+	uint16_t oldest_ = NoEntry;
+
+	static constexpr uint16_t NoEntry = UINT16_MAX;
+};
+
+} // namespace devilution
@@ -11,6 +11,7 @@
 #include "engine/displacement.hpp"
 #include "engine/lighting_defs.hpp"
 #include "engine/point.hpp"
+#include "engine/render/render_workers.hpp"
 #include "levels/dun_tile.hpp"
 #include "levels/gendung_defs.hpp"
 
@@ -20,9 +21,20 @@ namespace {
 
 std::vector<uint8_t> LightmapBuffer;
 
-void RenderFullTile(Point position, uint8_t lightLevel, uint8_t *lightmap, uint16_t pitch)
+/** The rows of the lightmap that one band renders, each band can be built on its own thread. */
+struct LightmapBand {
+	uint8_t *lightmap;
+	uint16_t pitch;
+	/** First row of the band. */
+	uint16_t top;
+	/** One past the last row of the band. */
+	uint16_t bottom;
+};
+
+void RenderFullTile(Point position, uint8_t lightLevel, const LightmapBand &band)
 {
-	uint8_t *top = lightmap + (position.y + 1) * pitch + position.x - TILE_WIDTH / 2;
+	const uint16_t pitch = band.pitch;
+	uint8_t *top = band.lightmap + (position.y + 1) * pitch + position.x - TILE_WIDTH / 2;
 	uint8_t *bottom = top + (TILE_HEIGHT - 2) * pitch;
 	for (int y = 0, w = 4; y < TILE_HEIGHT / 2 - 1; y++, w += 4) {
 		const int x = (TILE_WIDTH - w) / 2;
@@ -42,8 +54,10 @@ int DecrementTowardZero(int num)
 // Half-space method for drawing triangles
 // Points must be provided using counter-clockwise rotation
 // https://web.archive.org/web/20050408192410/http://sw-shader.sourceforge.net/rasterizer.html
-void RenderTriangle(Point p1, Point p2, Point p3, uint8_t lightLevel, uint8_t *lightmap, uint16_t pitch, uint16_t scanLines)
+void RenderTriangle(Point p1, Point p2, Point p3, uint8_t lightLevel, const LightmapBand &band)
 {
+	const uint16_t pitch = band.pitch;
+
 	// Deltas (points are already 28.4 fixed-point)
 	const int dx12 = p1.x - p2.x;
 	const int dx23 = p2.x - p3.x;
@@ -67,11 +81,11 @@ void RenderTriangle(Point p1, Point p2, Point p3, uint8_t lightLevel, uint8_t *l
 	const int maxx = std::min<int>((std::max({ p1.x, p2.x, p3.x }) + 0xF) >> 4, pitch);
 	const int xlen = maxx - minx;
 	if (xlen <= 0) return;
-	const int miny = std::max((std::min({ p1.y, p2.y, p3.y }) + 0xF) >> 4, 0);
-	const int maxy = std::min<int>((std::max({ p1.y, p2.y, p3.y }) + 0xF) >> 4, scanLines);
+	const int miny = std::max<int>((std::min({ p1.y, p2.y, p3.y }) + 0xF) >> 4, band.top);
+	const int maxy = std::min<int>((std::max({ p1.y, p2.y, p3.y }) + 0xF) >> 4, band.bottom);
 	if (maxy <= miny) return;
 
-	uint8_t *dst = lightmap + static_cast<ptrdiff_t>(miny * pitch);
+	uint8_t *dst = band.lightmap + static_cast<ptrdiff_t>(miny * pitch);
 
 	// Half-edge constants
 	constexpr auto CalcHalfEdge = [](const Point &p, int dx, int dy) {
@@ -147,7 +161,7 @@ uint8_t Interpolate(int q1, int q2, int lightLevel)
 	return static_cast<uint8_t>(result);
 }
 
-void RenderCell(uint8_t quad[4], Point position, uint8_t lightLevel, uint8_t *lightmap, uint16_t pitch, uint16_t scanLines)
+void RenderCell(uint8_t quad[4], Point position, uint8_t lightLevel, const LightmapBand &band)
 {
 	const Point center0 = position;
 	const Point center1 = position + Displacement { TILE_WIDTH / 2, TILE_HEIGHT / 2 };
@@ -180,7 +194,7 @@ void RenderCell(uint8_t quad[4], Point position, uint8_t lightLevel, uint8_t *li
 		const Point p1 = fpCenter3 + (center2 - center3) * bottomFactor;
 		const Point p2 = fpCenter3;
 		const Point p3 = fpCenter3 + (center0 - center3) * leftFactor;
-		RenderTriangle(p1, p3, p2, lightLevel, lightmap, pitch, scanLines);
+		RenderTriangle(p1, p3, p2, lightLevel, band);
 	} break;
 
 	// Fill in the bottom-right corner of the cell
@@ -191,7 +205,7 @@ void RenderCell(uint8_t quad[4], Point position, uint8_t lightLevel, uint8_t *li
 		const Point p1 = fpCenter2 + (center1 - center2) * rightFactor;
 		const Point p2 = fpCenter2;
 		const Point p3 = fpCenter2 + (center3 - center2) * bottomFactor;
-		RenderTriangle(p1, p3, p2, lightLevel, lightmap, pitch, scanLines);
+		RenderTriangle(p1, p3, p2, lightLevel, band);
 	} break;
 
 	// Fill in the bottom half of the cell
@@ -203,8 +217,8 @@ void RenderCell(uint8_t quad[4], Point position, uint8_t lightLevel, uint8_t *li
 		const Point p2 = fpCenter2;
 		const Point p3 = fpCenter3;
 		const Point p4 = fpCenter3 + (center1 - center2) * leftFactor;
-		RenderTriangle(p1, p4, p2, lightLevel, lightmap, pitch, scanLines);
-		RenderTriangle(p2, p4, p3, lightLevel, lightmap, pitch, scanLines);
+		RenderTriangle(p1, p4, p2, lightLevel, band);
+		RenderTriangle(p2, p4, p3, lightLevel, band);
 	} break;
 
 	// Fill in the top-right corner of the cell
@@ -215,7 +229,7 @@ void RenderCell(uint8_t quad[4], Point position, uint8_t lightLevel, uint8_t *li
 		const Point p1 = fpCenter1 + (center0 - center1) * topFactor;
 		const Point p2 = fpCenter1;
 		const Point p3 = fpCenter1 + (center2 - center1) * rightFactor;
-		RenderTriangle(p1, p3, p2, lightLevel, lightmap, pitch, scanLines);
+		RenderTriangle(p1, p3, p2, lightLevel, band);
 	} break;
 
 	// Fill in the top-right and bottom-left corners of the cell
@@ -239,21 +253,21 @@ void RenderCell(uint8_t quad[4], Point position, uint8_t lightLevel, uint8_t *li
 			const uint8_t midFactor2 = Interpolate(quad[2], cell, lightLevel);
 			const Point p7 = fpCenter0 + (center2 - center0) / 2 * midFactor0;
 			const Point p8 = fpCenter2 + (center0 - center2) / 2 * midFactor2;
-			RenderTriangle(p1, p7, p2, lightLevel, lightmap, pitch, scanLines);
-			RenderTriangle(p2, p7, p8, lightLevel, lightmap, pitch, scanLines);
-			RenderTriangle(p2, p8, p3, lightLevel, lightmap, pitch, scanLines);
-			RenderTriangle(p4, p8, p5, lightLevel, lightmap, pitch, scanLines);
-			RenderTriangle(p5, p8, p7, lightLevel, lightmap, pitch, scanLines);
-			RenderTriangle(p5, p7, p6, lightLevel, lightmap, pitch, scanLines);
+			RenderTriangle(p1, p7, p2, lightLevel, band);
+			RenderTriangle(p2, p7, p8, lightLevel, band);
+			RenderTriangle(p2, p8, p3, lightLevel, band);
+			RenderTriangle(p4, p8, p5, lightLevel, band);
+			RenderTriangle(p5, p8, p7, lightLevel, band);
+			RenderTriangle(p5, p7, p6, lightLevel, band);
 		} else {
 			const uint8_t midFactor1 = Interpolate(quad[1], cell, lightLevel);
 			const uint8_t midFactor3 = Interpolate(quad[3], cell, lightLevel);
 			const Point p7 = fpCenter1 + (center3 - center1) / 2 * midFactor1;
 			const Point p8 = fpCenter3 + (center1 - center3) / 2 * midFactor3;
-			RenderTriangle(p1, p7, p2, lightLevel, lightmap, pitch, scanLines);
-			RenderTriangle(p2, p7, p3, lightLevel, lightmap, pitch, scanLines);
-			RenderTriangle(p4, p8, p5, lightLevel, lightmap, pitch, scanLines);
-			RenderTriangle(p5, p8, p6, lightLevel, lightmap, pitch, scanLines);
+			RenderTriangle(p1, p7, p2, lightLevel, band);
+			RenderTriangle(p2, p7, p3, lightLevel, band);
+			RenderTriangle(p4, p8, p5, lightLevel, band);
+			RenderTriangle(p5, p8, p6, lightLevel, band);
 		}
 	} break;
 
@@ -266,8 +280,8 @@ void RenderCell(uint8_t quad[4], Point position, uint8_t lightLevel, uint8_t *li
 		const Point p2 = fpCenter1;
 		const Point p3 = fpCenter2;
 		const Point p4 = fpCenter2 + (center3 - center2) * bottomFactor;
-		RenderTriangle(p1, p4, p2, lightLevel, lightmap, pitch, scanLines);
-		RenderTriangle(p2, p4, p3, lightLevel, lightmap, pitch, scanLines);
+		RenderTriangle(p1, p4, p2, lightLevel, band);
+		RenderTriangle(p2, p4, p3, lightLevel, band);
 	} break;
 
 	// Fill in everything except the top-left corner of the cell
@@ -280,9 +294,9 @@ void RenderCell(uint8_t quad[4], Point position, uint8_t lightLevel, uint8_t *li
 		const Point p3 = fpCenter2;
 		const Point p4 = fpCenter3;
 		const Point p5 = fpCenter3 + (center0 - center3) * leftFactor;
-		RenderTriangle(p1, p3, p2, lightLevel, lightmap, pitch, scanLines);
-		RenderTriangle(p1, p5, p3, lightLevel, lightmap, pitch, scanLines);
-		RenderTriangle(p3, p5, p4, lightLevel, lightmap, pitch, scanLines);
+		RenderTriangle(p1, p3, p2, lightLevel, band);
+		RenderTriangle(p1, p5, p3, lightLevel, band);
+		RenderTriangle(p3, p5, p4, lightLevel, band);
 	} break;
 
 	// Fill in the top-left corner of the cell
@@ -293,7 +307,7 @@ void RenderCell(uint8_t quad[4], Point position, uint8_t lightLevel, uint8_t *li
 		const Point p1 = fpCenter0;
 		const Point p2 = fpCenter0 + (center1 - center0) * topFactor;
 		const Point p3 = fpCenter0 + (center3 - center0) * leftFactor;
-		RenderTriangle(p1, p3, p2, lightLevel, lightmap, pitch, scanLines);
+		RenderTriangle(p1, p3, p2, lightLevel, band);
 	} break;
 
 	// Fill in the left half of the cell
@@ -305,8 +319,8 @@ void RenderCell(uint8_t quad[4], Point position, uint8_t lightLevel, uint8_t *li
 		const Point p2 = fpCenter0 + (center1 - center0) * topFactor;
 		const Point p3 = fpCenter3 + (center2 - center3) * bottomFactor;
 		const Point p4 = fpCenter3;
-		RenderTriangle(p1, p3, p2, lightLevel, lightmap, pitch, scanLines);
-		RenderTriangle(p1, p4, p3, lightLevel, lightmap, pitch, scanLines);
+		RenderTriangle(p1, p3, p2, lightLevel, band);
+		RenderTriangle(p1, p4, p3, lightLevel, band);
 	} break;
 
 	// Fill in the top-left and bottom-right corners of the cell
@@ -330,21 +344,21 @@ void RenderCell(uint8_t quad[4], Point position, uint8_t lightLevel, uint8_t *li
 			const uint8_t midFactor3 = Interpolate(quad[3], cell, lightLevel);
 			const Point p7 = fpCenter1 + (center3 - center1) / 2 * midFactor1;
 			const Point p8 = fpCenter3 + (center1 - center3) / 2 * midFactor3;
-			RenderTriangle(p1, p7, p2, lightLevel, lightmap, pitch, scanLines);
-			RenderTriangle(p1, p6, p8, lightLevel, lightmap, pitch, scanLines);
-			RenderTriangle(p1, p8, p7, lightLevel, lightmap, pitch, scanLines);
-			RenderTriangle(p3, p7, p4, lightLevel, lightmap, pitch, scanLines);
-			RenderTriangle(p4, p8, p5, lightLevel, lightmap, pitch, scanLines);
-			RenderTriangle(p4, p7, p8, lightLevel, lightmap, pitch, scanLines);
+			RenderTriangle(p1, p7, p2, lightLevel, band);
+			RenderTriangle(p1, p6, p8, lightLevel, band);
+			RenderTriangle(p1, p8, p7, lightLevel, band);
+			RenderTriangle(p3, p7, p4, lightLevel, band);
+			RenderTriangle(p4, p8, p5, lightLevel, band);
+			RenderTriangle(p4, p7, p8, lightLevel, band);
 		} else {
 			const uint8_t midFactor0 = Interpolate(quad[0], cell, lightLevel);
 			const uint8_t midFactor2 = Interpolate(quad[2], cell, lightLevel);
 			const Point p7 = fpCenter0 + (center2 - center0) / 2 * midFactor0;
 			const Point p8 = fpCenter2 + (center0 - center2) / 2 * midFactor2;
-			RenderTriangle(p1, p7, p2, lightLevel, lightmap, pitch, scanLines);
-			RenderTriangle(p1, p6, p7, lightLevel, lightmap, pitch, scanLines);
-			RenderTriangle(p3, p8, p4, lightLevel, lightmap, pitch, scanLines);
-			RenderTriangle(p4, p8, p5, lightLevel, lightmap, pitch, scanLines);
+			RenderTriangle(p1, p7, p2, lightLevel, band);
+			RenderTriangle(p1, p6, p7, lightLevel, band);
+			RenderTriangle(p3, p8, p4, lightLevel, band);
+			RenderTriangle(p4, p8, p5, lightLevel, band);
 		}
 	} break;
 
@@ -358,9 +372,9 @@ void RenderCell(uint8_t quad[4], Point position, uint8_t lightLevel, uint8_t *li
 		const Point p3 = fpCenter2 + (center1 - center2) * rightFactor;
 		const Point p4 = fpCenter2;
 		const Point p5 = fpCenter3;
-		RenderTriangle(p1, p5, p2, lightLevel, lightmap, pitch, scanLines);
-		RenderTriangle(p2, p5, p3, lightLevel, lightmap, pitch, scanLines);
-		RenderTriangle(p3, p5, p4, lightLevel, lightmap, pitch, scanLines);
+		RenderTriangle(p1, p5, p2, lightLevel, band);
+		RenderTriangle(p2, p5, p3, lightLevel, band);
+		RenderTriangle(p3, p5, p4, lightLevel, band);
 	} break;
 
 	// Fill in the top half of the cell
@@ -372,8 +386,8 @@ void RenderCell(uint8_t quad[4], Point position, uint8_t lightLevel, uint8_t *li
 		const Point p2 = fpCenter1;
 		const Point p3 = fpCenter1 + (center2 - center1) * rightFactor;
 		const Point p4 = fpCenter0 + (center3 - center0) * leftFactor;
-		RenderTriangle(p1, p3, p2, lightLevel, lightmap, pitch, scanLines);
-		RenderTriangle(p1, p4, p3, lightLevel, lightmap, pitch, scanLines);
+		RenderTriangle(p1, p3, p2, lightLevel, band);
+		RenderTriangle(p1, p4, p3, lightLevel, band);
 	} break;
 
 	// Fill in everything except the bottom-right corner of the cell
@@ -386,9 +400,9 @@ void RenderCell(uint8_t quad[4], Point position, uint8_t lightLevel, uint8_t *li
 		const Point p3 = fpCenter1 + (center2 - center1) * rightFactor;
 		const Point p4 = fpCenter3 + (center2 - center3) * bottomFactor;
 		const Point p5 = fpCenter3;
-		RenderTriangle(p1, p3, p2, lightLevel, lightmap, pitch, scanLines);
-		RenderTriangle(p1, p4, p3, lightLevel, lightmap, pitch, scanLines);
-		RenderTriangle(p1, p5, p4, lightLevel, lightmap, pitch, scanLines);
+		RenderTriangle(p1, p3, p2, lightLevel, band);
+		RenderTriangle(p1, p4, p3, lightLevel, band);
+		RenderTriangle(p1, p5, p4, lightLevel, band);
 	} break;
 
 	// Fill in everything except the bottom-left corner of the cell
@@ -401,48 +415,36 @@ void RenderCell(uint8_t quad[4], Point position, uint8_t lightLevel, uint8_t *li
 		const Point p3 = fpCenter2;
 		const Point p4 = fpCenter2 + (center3 - center2) * bottomFactor;
 		const Point p5 = fpCenter0 + (center3 - center0) * leftFactor;
-		RenderTriangle(p1, p5, p2, lightLevel, lightmap, pitch, scanLines);
-		RenderTriangle(p2, p5, p4, lightLevel, lightmap, pitch, scanLines);
-		RenderTriangle(p2, p4, p3, lightLevel, lightmap, pitch, scanLines);
+		RenderTriangle(p1, p5, p2, lightLevel, band);
+		RenderTriangle(p2, p5, p4, lightLevel, band);
+		RenderTriangle(p2, p4, p3, lightLevel, band);
 	} break;
 
 	// Fill in the whole cell
 	// All four tiles in the quad are lit
 	case 15: {
-		if (center3.x < 0 || center1.x >= pitch || center0.y < 0 || center2.y >= scanLines) {
-			RenderTriangle(fpCenter0, fpCenter2, fpCenter1, lightLevel, lightmap, pitch, scanLines);
-			RenderTriangle(fpCenter0, fpCenter3, fpCenter2, lightLevel, lightmap, pitch, scanLines);
+		if (center3.x < 0 || center1.x >= band.pitch || center0.y < band.top || center2.y >= band.bottom) {
+			RenderTriangle(fpCenter0, fpCenter2, fpCenter1, lightLevel, band);
+			RenderTriangle(fpCenter0, fpCenter3, fpCenter2, lightLevel, band);
 		} else {
 			// Optimized rendering path if full tile is visible
-			RenderFullTile(center0, lightLevel, lightmap, pitch);
+			RenderFullTile(center0, lightLevel, band);
 		}
 	} break;
 	}
 }
 
-void BuildLightmap(Point tilePosition, Point targetBufferPosition, uint16_t viewportWidth, uint16_t viewportHeight,
-    int rows, int columns, const uint8_t tileLights[MAXDUNX][MAXDUNY], uint_fast8_t microTileLen)
+void BuildLightmapBand(const LightmapBand &band, Point tilePosition, Point targetBufferPosition,
+    int rows, int columns, const uint8_t tileLights[MAXDUNX][MAXDUNY])
 {
-	// Since light may need to bleed up to the top of wall tiles,
-	// expand the buffer space to include the full base diamond of the tallest tile graphics
-	const uint16_t bufferHeight = viewportHeight + TILE_HEIGHT * (microTileLen / 2 + 1);
-	rows += microTileLen + 2;
-
-	const size_t totalPixels = static_cast<size_t>(viewportWidth) * bufferHeight;
-	LightmapBuffer.resize(totalPixels);
-
-	// Since rendering occurs in cells between quads,
-	// expand the rendering space to include tiles outside the viewport
-	tilePosition += Displacement(Direction::NorthWest) * 2;
-	targetBufferPosition -= Displacement { TILE_WIDTH, TILE_HEIGHT };
-	rows += 3;
-	columns++;
-
-	uint8_t *lightmap = LightmapBuffer.data();
-	memset(lightmap, LightsMax, totalPixels);
+	memset(band.lightmap + static_cast<ptrdiff_t>(band.top * band.pitch), LightsMax, static_cast<size_t>(band.bottom - band.top) * band.pitch);
 	for (int i = 0; i < rows; i++) {
 		for (int j = 0; j < columns; j++, tilePosition += Direction::East, targetBufferPosition.x += TILE_WIDTH) {
 			const Point center0 = targetBufferPosition + Displacement { TILE_WIDTH / 2, -TILE_HEIGHT / 2 };
+			// Every band goes over all cells in the same order and only keeps its own rows,
+			// so overlapping cells come out the same as when built in one go.
+			if (center0.y > band.bottom || center0.y + TILE_HEIGHT < band.top)
+				continue;
 
 			const Point tile0 = tilePosition;
 			const Point tile1 = tilePosition + Displacement { 1, 0 };
@@ -465,7 +467,7 @@ void BuildLightmap(Point tilePosition, Point targetBufferPosition, uint16_t view
 					continue;
 				if (lightLevel < minLight)
 					break;
-				RenderCell(quad, center0, lightLevel, lightmap, viewportWidth, bufferHeight);
+				RenderCell(quad, center0, lightLevel, band);
 			}
 		}
 
@@ -487,6 +489,37 @@ void BuildLightmap(Point tilePosition, Point targetBufferPosition, uint16_t view
 	}
 }
 
+void BuildLightmap(Point tilePosition, Point targetBufferPosition, uint16_t viewportWidth, uint16_t viewportHeight,
+    int rows, int columns, const uint8_t tileLights[MAXDUNX][MAXDUNY], uint_fast8_t microTileLen, int bands)
+{
+	// Since light may need to bleed up to the top of wall tiles,
+	// expand the buffer space to include the full base diamond of the tallest tile graphics
+	const uint16_t bufferHeight = viewportHeight + TILE_HEIGHT * (microTileLen / 2 + 1);
+	rows += microTileLen + 2;
+
+	const size_t totalPixels = static_cast<size_t>(viewportWidth) * bufferHeight;
+	LightmapBuffer.resize(totalPixels);
+
+	// Since rendering occurs in cells between quads,
+	// expand the rendering space to include tiles outside the viewport
+	tilePosition += Displacement(Direction::NorthWest) * 2;
+	targetBufferPosition -= Displacement { TILE_WIDTH, TILE_HEIGHT };
+	rows += 3;
+	columns++;
+
+	uint8_t *lightmap = LightmapBuffer.data();
+	bands = std::clamp<int>(bands, 1, bufferHeight);
+	const int bandHeight = (bufferHeight + bands - 1) / bands;
+	RunRenderBands(bands, [&](int band) {
+		const int top = band * bandHeight;
+		const int bottom = std::min<int>(top + bandHeight, bufferHeight);
+		if (top >= bottom)
+			return;
+		BuildLightmapBand({ lightmap, viewportWidth, static_cast<uint16_t>(top), static_cast<uint16_t>(bottom) },
+		    tilePosition, targetBufferPosition, rows, columns, tileLights);
+	});
+}
+
 } // namespace
 
 Lightmap::Lightmap(const uint8_t *outBuffer, uint16_t outPitch,
@@ -509,10 +542,10 @@ Lightmap Lightmap::build(bool perPixelLighting, Point tilePosition, Point target
     std::span<const std::array<uint8_t, LightTableSize>, NumLightingLevels> lightTables,
     const uint8_t *fullyLitLightTable, const uint8_t *fullyDarkLightTable,
     const uint8_t tileLights[MAXDUNX][MAXDUNY],
-    uint_fast8_t microTileLen)
+    uint_fast8_t microTileLen, int bands)
 {
 	if (perPixelLighting) {
-		BuildLightmap(tilePosition, targetBufferPosition, viewportWidth, viewportHeight, rows, columns, tileLights, microTileLen);
+		BuildLightmap(tilePosition, targetBufferPosition, viewportWidth, viewportHeight, rows, columns, tileLights, microTileLen, bands);
 	}
 	return Lightmap(outBuffer, outPitch, LightmapBuffer, viewportWidth, lightTables, fullyLitLightTable, fullyDarkLightTable);
 }
@@ -30,6 +30,11 @@ public:
 		return lightTables[lightLevel][color];
 	}
 
+	[[nodiscard]] const uint8_t *lightTable(uint8_t lightLevel) const
+	{
+		return lightTables[lightLevel].data();
+	}
+
 	const uint8_t *getLightingAt(const uint8_t *outLoc) const
 	{
 		const ptrdiff_t outDist = outLoc - outBuffer;
@@ -49,13 +54,17 @@ public:
 	[[nodiscard]] bool isFullyLitLightTable(const uint8_t *lightTable) const { return lightTable == fullyLitLightTable_; }
 	[[nodiscard]] bool isFullyDarkLightTable(const uint8_t *lightTable) const { return lightTable == fullyDarkLightTable_; }
 
+	/**
+	 * @brief Builds the per-pixel lightmap of the viewport.
+	 * @param bands Number of row bands the lightmap is split into, they are built in parallel by the render workers
+	 */
 	static Lightmap build(bool perPixelLighting, Point tilePosition, Point targetBufferPosition,
 	    int viewportWidth, int viewportHeight, int rows, int columns,
 	    const uint8_t *outBuffer, uint16_t outPitch,
 	    std::span<const std::array<uint8_t, LightTableSize>, NumLightingLevels> lightTables,
 	    const uint8_t *fullyLitLightTable, const uint8_t *fullyDarkLightTable,
 	    const uint8_t tileLights[MAXDUNX][MAXDUNY],
-	    uint_fast8_t microTileLen);
+	    uint_fast8_t microTileLen, int bands = 1);
 
 	static Lightmap bleedUp(bool perPixelLighting, const Lightmap &source, Point targetBufferPosition, std::span<uint8_t> lightmapBuffer);
 
@@ -0,0 +1,148 @@
+/**
+ * @file render_workers.cpp
+ *
+ * Implementation of the threads that help render independent parts of a frame.
+ */
+#include "engine/render/render_workers.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <mutex>
+#include <optional>
+
+#ifdef USE_SDL3
+#include <SDL3/SDL_cpuinfo.h>
+#else
+#include <SDL.h>
+#endif
+
+#include "utils/sdl_cond.h"
+#include "utils/sdl_mutex.h"
+#include "utils/sdl_thread.h"
+
+namespace devilution {
+
+namespace {
+
+constexpr size_t MaxRenderWorkers = MaxRenderThreads - 1;
+
+struct RenderWorkersState {
+	SdlMutex mutex;
+	SdlCond wakeUp;
+	SdlCond finished;
+
+	std::optional<tl::function_ref<void(int)>> task;
+	int bands = 0;
+	int nextBand = 0;
+	int finishedBands = 0;
+	bool stop = false;
+};
+
+std::optional<RenderWorkersState> State;
+std::array<SdlThread, MaxRenderWorkers> Workers;
+size_t WorkerCount = 0;
+
+[[nodiscard]] size_t GetWantedWorkerCount()
+{
+#if defined(__DJGPP__) || defined(USE_SDL1)
+	return 0;
+#else
+#ifdef USE_SDL3
+	const int cores = SDL_GetNumLogicalCPUCores();
+#else
+	const int cores = SDL_GetCPUCount();
+#endif
+	return std::min(static_cast<size_t>(std::max(cores - 1, 0)), MaxRenderWorkers);
+#endif
+}
+
+/** @brief Takes the next band while there is one, `lock` must hold the state's mutex. */
+void RunPendingBands(RenderWorkersState &state, std::unique_lock<SdlMutex> &lock)
+{
+	while (state.nextBand < state.bands) {
+		const int band = state.nextBand++;
+		const tl::function_ref<void(int)> task = *state.task;
+		lock.unlock();
+		task(band);
+		lock.lock();
+		if (++state.finishedBands == state.bands)
+			state.finished.signal();
+	}
+}
+
+void RenderWorkerLoop()
+{
+	RenderWorkersState &state = *State;
+	std::unique_lock<SdlMutex> lock(state.mutex);
+	while (true) {
+		while (!state.stop && state.nextBand >= state.bands)
+			state.wakeUp.wait(state.mutex);
+		if (state.stop)
+			return;
+		RunPendingBands(state, lock);
+	}
+}
+
+void StartRenderWorkers()
+{
+	State.emplace();
+	WorkerCount = GetWantedWorkerCount();
+	for (size_t i = 0; i < WorkerCount; i++)
+		Workers[i] = SdlThread { RenderWorkerLoop };
+}
+
+} // namespace
+
+void RunRenderBands(int bands, tl::function_ref<void(int)> task)
+{
+	if (!State)
+		StartRenderWorkers();
+
+	if (WorkerCount == 0 || bands <= 1) {
+		for (int band = 0; band < bands; band++)
+			task(band);
+		return;
+	}
+
+	RenderWorkersState &state = *State;
+	std::unique_lock<SdlMutex> lock(state.mutex);
+	state.task = task;
+	state.bands = bands;
+	state.nextBand = 0;
+	state.finishedBands = 0;
+	state.wakeUp.broadcast();
+
+	RunPendingBands(state, lock);
+	while (state.finishedBands < state.bands)
+		state.finished.wait(state.mutex);
+
+	state.bands = 0;
+	state.nextBand = 0;
+	state.task = std::nullopt;
+}
+
+int GetRenderThreadCount()
+{
+	if (!State)
+		StartRenderWorkers();
+	return static_cast<int>(WorkerCount) + 1;
+}
+
+void ShutdownRenderWorkers()
+{
+	if (!State)
+		return;
+
+	{
+		const std::lock_guard<SdlMutex> lock(State->mutex);
+		State->stop = true;
+	}
+	State->wakeUp.broadcast();
+	for (size_t i = 0; i < WorkerCount; i++)
+		Workers[i].join();
+	WorkerCount = 0;
+	State = std::nullopt;
+}
+
+} // namespace devilution
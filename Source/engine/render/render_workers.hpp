@@ -0,0 +1,27 @@
+/**
+ * @file render_workers.hpp
+ *
+ * Interface of the threads that help render independent parts of a frame.
+ */
+#pragma once
+
+#include <function_ref.hpp>
+
+namespace devilution {
+
+/** Most threads RunRenderBands() ever uses, the calling thread included. Beyond this the bands get too thin to pay off. */
+constexpr int MaxRenderThreads = 4;
+
+/**
+ * @brief Runs `task` for every band from 0 to `bands - 1`, spread over the render workers and the calling thread.
+ *
+ * Returns once every band is done. The bands must not write to the same memory.
+ */
+void RunRenderBands(int bands, tl::function_ref<void(int)> task);
+
+/** @brief Number of threads RunRenderBands() spreads the bands over, the calling thread included. */
+[[nodiscard]] int GetRenderThreadCount();
+
+void ShutdownRenderWorkers();
+
+} // namespace devilution
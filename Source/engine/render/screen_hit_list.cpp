@@ -0,0 +1,56 @@
+/**
+ * @file screen_hit_list.cpp
+ *
+ * Implementation of the list of sprite bounds drawn in a frame.
+ */
+#include "engine/render/screen_hit_list.hpp"
+
+#include <algorithm>
+
+namespace devilution {
+
+void ScreenHitList::Clear()
+{
+	entries_.clear();
+	// Keep the columns' memory for the next frame.
+	for (std::vector<uint32_t> &column : columns_)
+		column.clear();
+}
+
+void ScreenHitList::Add(Rectangle bounds, uint32_t id)
+{
+	if (bounds.size.width <= 0 || bounds.size.height <= 0)
+		return;
+	const int right = bounds.position.x + bounds.size.width - 1;
+	if (right < 0)
+		return;
+
+	const auto index = static_cast<uint32_t>(entries_.size());
+	entries_.push_back({ bounds, id });
+
+	const size_t first = static_cast<size_t>(std::max(bounds.position.x, 0) / ColumnWidth);
+	const size_t last = static_cast<size_t>(right / ColumnWidth);
+	if (columns_.size() <= last)
+		columns_.resize(last + 1);
+	for (size_t column = first; column <= last; column++)
+		columns_[column].push_back(index);
+}
+
+std::optional<uint32_t> ScreenHitList::FindAt(Point position, tl::function_ref<bool(uint32_t id)> accept) const
+{
+	if (position.x < 0)
+		return std::nullopt;
+	const size_t column = static_cast<size_t>(position.x / ColumnWidth);
+	if (column >= columns_.size())
+		return std::nullopt;
+
+	const std::vector<uint32_t> &indices = columns_[column];
+	for (auto it = indices.rbegin(); it != indices.rend(); ++it) {
+		const Entry &entry = entries_[*it];
+		if (entry.bounds.contains(position) && accept(entry.id))
+			return entry.id;
+	}
+	return std::nullopt;
+}
+
+} // namespace devilution
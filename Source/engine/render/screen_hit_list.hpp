@@ -0,0 +1,59 @@
+/**
+ * @file screen_hit_list.hpp
+ *
+ * Interface of the list of sprite bounds drawn in a frame, for finding what is under the mouse.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include <function_ref.hpp>
+
+#include "engine/point.hpp"
+#include "engine/rectangle.hpp"
+
+namespace devilution {
+
+/**
+ * @brief The screen bounds of the sprites drawn in a frame, in drawing order.
+ *
+ * Entries are bucketed into columns of `ColumnWidth` pixels, so a lookup only looks at the sprites
+ * overlapping the column of the point instead of everything that was drawn.
+ */
+class ScreenHitList {
+public:
+	static constexpr int ColumnWidth = 64;
+
+	void Clear();
+
+	/** @brief Adds a sprite drawn on top of all the ones added before it. */
+	void Add(Rectangle bounds, uint32_t id);
+
+	[[nodiscard]] size_t size() const
+	{
+		return entries_.size();
+	}
+
+	/**
+	 * @brief Finds the last drawn sprite at `position` that `accept` agrees is hit.
+	 *
+	 * `accept` is called for the sprites whose bounds contain `position`, the last drawn first, and
+	 * is where a pixel test belongs.
+	 */
+	[[nodiscard]] std::optional<uint32_t> FindAt(Point position, tl::function_ref<bool(uint32_t id)> accept) const;
+
+private:
+	struct Entry {
+		Rectangle bounds;
+		uint32_t id;
+	};
+
+	std::vector<Entry> entries_;
+	/** Indices into `entries_` of the entries overlapping each column, in drawing order. */
+	std::vector<std::vector<uint32_t>> columns_;
+};
+
+} // namespace devilution
@@ -5,9 +5,13 @@
  */
 #include "engine/render/scrollrt.h"
 
+#include <algorithm>
+#include <array>
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
+#include <span>
+#include <vector>
 
 #ifdef USE_SDL3
 #include <SDL3/SDL_keyboard.h>
@@ -21,20 +25,31 @@
 
 #include "DiabloUI/ui_flags.hpp"
 #include "automap.h"
+#include "capture.h"
 #include "controls/control_mode.hpp"
 #include "controls/plrctrls.h"
 #include "cursor.h"
 #include "dead.h"
 #include "diablo_msg.hpp"
 #include "doom.h"
+#include "engine/audio_stats.hpp"
+#include "engine/net_stats.hpp"
 #include "engine/backbuffer_state.hpp"
 #include "engine/displacement.hpp"
 #include "engine/dx.h"
+#include "engine/frame_pacer.hpp"
+#include "engine/frame_stats.hpp"
 #include "engine/point.hpp"
 #include "engine/render/clx_render.hpp"
 #include "engine/render/dun_render.hpp"
+#include "engine/render/floor_tile_cache.hpp"
 #include "engine/render/light_render.hpp"
+#include "engine/render/primitive_render.hpp"
+#include "engine/render/render_workers.hpp"
+#include "engine/render/screen_hit_list.hpp"
 #include "engine/render/text_render.hpp"
+#include "engine/tick_timing.hpp"
+#include "engine/tracing.hpp"
 #include "engine/trn.hpp"
 #include "engine/world_tile.hpp"
 #include "game_mode.hpp"
@@ -70,6 +85,7 @@
 #include "utils/display.h"
 #include "utils/is_of.hpp"
 #include "utils/log.hpp"
+#include "utils/pixel_doubling.hpp"
 #include "utils/sdl_compat.h"
 #include "utils/str_cat.hpp"
 
@@ -113,6 +129,17 @@ constexpr auto RightFrameDisplacement = Displacement { DunFrameWidth, 0 };
  */
 ankerl::unordered_dense::map<WorldTilePosition, std::vector<Missile *>> MissilesAtRenderingTile;
 
+/** The selectable sprites of the last frame in the order they were drawn, looked up by FindDrawnSprite(). */
+std::vector<DrawnSprite> DrawnSprites;
+ScreenHitList DrawnSpriteHits;
+
+void AddDrawnSprite(DrawnSprite::Kind kind, int index, Point tilePosition, Point spritePosition, ClxSprite sprite)
+{
+	const Rectangle bounds { spritePosition - Displacement { 0, sprite.height() }, Size { sprite.width(), sprite.height() } };
+	DrawnSpriteHits.Add(bounds, static_cast<uint32_t>(DrawnSprites.size()));
+	DrawnSprites.push_back({ kind, index, tilePosition });
+}
+
 /**
  * @brief Could the missile (at the next game tick) collide? This method is a simplified version of CheckMissileCol (for example without random).
  */
@@ -340,17 +367,16 @@ void DrawMissilePrivate(const Surface &out, const Missile &missile, Point target
 }
 
 /**
- * @brief Render a missile sprites for a given tile
+ * @brief Render the missile sprites of a tile
  * @param out Output buffer
- * @param tilePosition dPiece coordinates
+ * @param missiles The missiles at the tile's rendering position, may be null
  * @param targetBufferPosition Output buffer coordinates
  * @param pre Is the sprite in the background
  */
-void DrawMissile(const Surface &out, WorldTilePosition tilePosition, Point targetBufferPosition, bool pre, int lightTableIndex)
+void DrawMissiles(const Surface &out, const std::vector<Missile *> *missiles, Point targetBufferPosition, bool pre, int lightTableIndex)
 {
-	const auto it = MissilesAtRenderingTile.find(tilePosition);
-	if (it == MissilesAtRenderingTile.end()) return;
-	for (Missile *missile : it->second) {
+	if (missiles == nullptr) return;
+	for (Missile *missile : *missiles) {
 		DrawMissilePrivate(out, *missile, targetBufferPosition, pre, lightTableIndex);
 	}
 }
@@ -445,6 +471,7 @@ void DrawPlayer(const Surface &out, const Player &player, Point tilePosition, Po
 
 	const ClxSprite sprite = player.currentSprite();
 	const Point spriteBufferPosition = targetBufferPosition + player.getRenderingOffset(sprite);
+	AddDrawnSprite(DrawnSprite::Kind::Player, player.getId(), tilePosition, spriteBufferPosition, sprite);
 
 	if (&player == PlayerUnderCursor)
 		ClxDrawOutlineSkipColorZero(out, 165, spriteBufferPosition, sprite);
@@ -498,6 +525,7 @@ void DrawObject(const Surface &out, const Object &objectToDraw, Point tilePositi
 	const ClxSprite sprite = objectToDraw.currentSprite();
 
 	const Point screenPosition = targetBufferPosition + objectToDraw.getRenderingOffset(sprite, tilePosition);
+	AddDrawnSprite(DrawnSprite::Kind::Object, static_cast<int>(objectToDraw.GetId()), tilePosition, screenPosition, sprite);
 
 	if (&objectToDraw == ObjectUnderCursor) {
 		ClxDrawOutlineSkipColorZero(out, 194, screenPosition, sprite);
@@ -509,8 +537,6 @@ void DrawObject(const Surface &out, const Object &objectToDraw, Point tilePositi
 	}
 }
 
-static void DrawDungeon(const Surface & /*out*/, const Lightmap & /*lightmap*/, Point /*tilePosition*/, Point /*targetBufferPosition*/);
-
 /**
  * @brief Render a cell
  * @param out Target buffer
@@ -521,7 +547,7 @@ static void DrawDungeon(const Surface & /*out*/, const Lightmap & /*lightmap*/,
 void DrawCell(const Surface &out, const Lightmap lightmap, Point tilePosition, Point targetBufferPosition, int lightTableIndex)
 {
 	const uint16_t levelPieceId = dPiece[tilePosition.x][tilePosition.y];
-	const MICROS *pMap = &DPieceMicros[levelPieceId];
+	const PieceFrames *pMap = &DPieceFrames[levelPieceId];
 
 	const uint8_t *tbl = LightTables[lightTableIndex].data();
 	const uint8_t *foliageTbl = tbl;
@@ -585,27 +611,27 @@ void DrawCell(const Surface &out, const Lightmap lightmap, Point tilePosition, P
 	// If the first micro tile is a floor tile, it may be followed
 	// by foliage which should be rendered now.
 	const bool isFloor = IsFloor(tilePosition);
-	if (const LevelCelBlock levelCelBlock { pMap->mt[0] }; levelCelBlock.hasValue()) {
-		const TileType tileType = levelCelBlock.type();
+	if (const DunFrameRef frame = pMap->mt[0]; frame.hasValue()) {
+		const TileType tileType = frame.type;
 		if (!isFloor || tileType == TileType::TransparentSquare) {
 			if (isFloor && tileType == TileType::TransparentSquare) {
 				RenderTileFoliage(out, bleedLightmap, targetBufferPosition,
-				    pDungeonCels.get(), levelCelBlock, foliageTbl);
+				    pDungeonCels.get(), frame, foliageTbl);
 			} else {
 				RenderTile(out, bleedLightmap, targetBufferPosition,
-				    pDungeonCels.get(), levelCelBlock, getFirstTileMaskLeft(tileType), tbl);
+				    pDungeonCels.get(), frame, getFirstTileMaskLeft(tileType), tbl);
 			}
 		}
 	}
-	if (const LevelCelBlock levelCelBlock { pMap->mt[1] }; levelCelBlock.hasValue()) {
-		const TileType tileType = levelCelBlock.type();
+	if (const DunFrameRef frame = pMap->mt[1]; frame.hasValue()) {
+		const TileType tileType = frame.type;
 		if (!isFloor || tileType == TileType::TransparentSquare) {
 			if (isFloor && tileType == TileType::TransparentSquare) {
 				RenderTileFoliage(out, bleedLightmap, targetBufferPosition + RightFrameDisplacement,
-				    pDungeonCels.get(), levelCelBlock, foliageTbl);
+				    pDungeonCels.get(), frame, foliageTbl);
 			} else {
 				RenderTile(out, bleedLightmap, targetBufferPosition + RightFrameDisplacement,
-				    pDungeonCels.get(), levelCelBlock, getFirstTileMaskRight(tileType), tbl);
+				    pDungeonCels.get(), frame, getFirstTileMaskRight(tileType), tbl);
 			}
 		}
 	}
@@ -613,18 +639,18 @@ void DrawCell(const Surface &out, const Lightmap lightmap, Point tilePosition, P
 
 	for (uint_fast8_t i = 2, n = MicroTileLen; i < n; i += 2) {
 		{
-			const LevelCelBlock levelCelBlock { pMap->mt[i] };
-			if (levelCelBlock.hasValue()) {
+			const DunFrameRef frame = pMap->mt[i];
+			if (frame.hasValue()) {
 				RenderTile(out, bleedLightmap, targetBufferPosition,
-				    pDungeonCels.get(), levelCelBlock,
+				    pDungeonCels.get(), frame,
 				    transparency ? MaskType::Transparent : MaskType::Solid, foliageTbl);
 			}
 		}
 		{
-			const LevelCelBlock levelCelBlock { pMap->mt[i + 1] };
-			if (levelCelBlock.hasValue()) {
+			const DunFrameRef frame = pMap->mt[i + 1];
+			if (frame.hasValue()) {
 				RenderTile(out, bleedLightmap, targetBufferPosition + RightFrameDisplacement,
-				    pDungeonCels.get(), levelCelBlock,
+				    pDungeonCels.get(), frame,
 				    transparency ? MaskType::Transparent : MaskType::Solid, foliageTbl);
 			}
 		}
@@ -646,10 +672,11 @@ void DrawCell(const Surface &out, const Lightmap lightmap, Point tilePosition, P
  * @brief Render a floor tile.
  * @param out Target buffer
  * @param lightmap Per-pixel light buffer
+ * @param cache Already lit floor triangles of the band being drawn
  * @param tilePosition dPiece coordinates
  * @param targetBufferPosition Target buffer coordinate
  */
-void DrawFloorTile(const Surface &out, const Lightmap &lightmap, Point tilePosition, Point targetBufferPosition)
+void DrawFloorTile(const Surface &out, const Lightmap &lightmap, FloorTileCache &cache, Point tilePosition, Point targetBufferPosition)
 {
 	const int lightTableIndex = dLight[tilePosition.x][tilePosition.y];
 
@@ -659,19 +686,24 @@ void DrawFloorTile(const Surface &out, const Lightmap &lightmap, Point tilePosit
 		tbl = GetPauseTRN();
 #endif
 
+	// Per-pixel lighting varies across a triangle, so only uniformly lit ones can be cached.
+	const bool useCache = !*GetOptions().Graphics.perPixelLighting;
 	const uint16_t levelPieceId = dPiece[tilePosition.x][tilePosition.y];
 	{
-		const LevelCelBlock levelCelBlock { DPieceMicros[levelPieceId].mt[0] };
-		if (levelCelBlock.hasValue()) {
-			RenderTileFrame(out, lightmap, targetBufferPosition, TileType::LeftTriangle,
-			    GetDunFrame(pDungeonCels.get(), levelCelBlock.frame()), DunFrameTriangleHeight, MaskType::Solid, tbl);
+		const DunFrameRef frame = DPieceFrames[levelPieceId].mt[0];
+		if (frame.hasValue()) {
+			const uint8_t *src = GetDunFrame(pDungeonCels.get(), frame);
+			if (!useCache || !cache.Draw(out, lightmap, targetBufferPosition, TileType::LeftTriangle, src, tbl))
+				RenderTileFrame(out, lightmap, targetBufferPosition, TileType::LeftTriangle, src, DunFrameTriangleHeight, MaskType::Solid, tbl);
 		}
 	}
 	{
-		const LevelCelBlock levelCelBlock { DPieceMicros[levelPieceId].mt[1] };
-		if (levelCelBlock.hasValue()) {
-			RenderTileFrame(out, lightmap, targetBufferPosition + RightFrameDisplacement, TileType::RightTriangle,
-			    GetDunFrame(pDungeonCels.get(), levelCelBlock.frame()), DunFrameTriangleHeight, MaskType::Solid, tbl);
+		const DunFrameRef frame = DPieceFrames[levelPieceId].mt[1];
+		if (frame.hasValue()) {
+			const uint8_t *src = GetDunFrame(pDungeonCels.get(), frame);
+			const Point position = targetBufferPosition + RightFrameDisplacement;
+			if (!useCache || !cache.Draw(out, lightmap, position, TileType::RightTriangle, src, tbl))
+				RenderTileFrame(out, lightmap, position, TileType::RightTriangle, src, DunFrameTriangleHeight, MaskType::Solid, tbl);
 		}
 	}
 }
@@ -683,11 +715,12 @@ void DrawFloorTile(const Surface &out, const Lightmap &lightmap, Point tilePosit
  * @param targetBufferPosition Output buffer coordinates
  * @param pre Is the sprite in the background
  */
-void DrawItem(const Surface &out, int8_t itemIndex, Point targetBufferPosition, int lightTableIndex)
+void DrawItem(const Surface &out, int8_t itemIndex, Point tilePosition, Point targetBufferPosition, int lightTableIndex)
 {
 	const Item &item = Items[itemIndex];
 	const ClxSprite sprite = item.AnimInfo.currentSprite();
 	const Point position = targetBufferPosition + item.getRenderingOffset(sprite);
+	AddDrawnSprite(DrawnSprite::Kind::Item, itemIndex, tilePosition, position, sprite);
 	if (!IsPlayerInStore() && (itemIndex == pcursitem || AutoMapShowItems)) {
 		ClxDrawOutlineSkipColorZero(out, GetOutlineColor(item, false), position, sprite);
 	}
@@ -712,6 +745,7 @@ void DrawMonsterHelper(const Surface &out, Point tilePosition, Point targetBuffe
 		auto &towner = Towners[mi];
 		const Point position = targetBufferPosition + towner.getRenderingOffset();
 		const ClxSprite sprite = towner.currentSprite();
+		AddDrawnSprite(DrawnSprite::Kind::Towner, mi, tilePosition, position, sprite);
 		if (mi == pcursmonst) {
 			ClxDrawOutlineSkipColorZero(out, 166, position, sprite);
 		}
@@ -737,6 +771,7 @@ void DrawMonsterHelper(const Surface &out, Point tilePosition, Point targetBuffe
 	const Displacement offset = monster.getRenderingOffset(sprite);
 
 	const Point monsterRenderPosition = targetBufferPosition + offset;
+	AddDrawnSprite(DrawnSprite::Kind::Monster, mi, tilePosition, monsterRenderPosition, sprite);
 	if (mi == pcursmonst) {
 		ClxDrawOutlineSkipColorZero(out, 233, monsterRenderPosition, sprite);
 	}
@@ -744,58 +779,52 @@ void DrawMonsterHelper(const Surface &out, Point tilePosition, Point targetBuffe
 }
 
 /**
- * @brief Render object sprites
- * @param out Target buffer
- * @param lightmap Per-pixel light buffer
+ * @brief Everything DrawDungeon() draws on a tile, looked up before the frame's sprites are drawn
+ */
+struct TileDrawEntry {
+	Point tilePosition;
+	Point targetBufferPosition;
+	const std::vector<Missile *> *missiles;
+	const Object *object;
+	/** The player to draw here, at the tile they are drawn from when moving. */
+	const Player *player;
+	Point playerTilePosition;
+	Point playerBufferPosition;
+	/** The monster to draw here, at the tile they are drawn from when moving. */
+	bool hasMonster;
+	Point monsterTilePosition;
+	Point monsterBufferPosition;
+	uint8_t lightTableIndex;
+	int8_t corpse;
+	int8_t item;
+	bool deadPlayer;
+};
+
+/** The tiles of the current frame in the order they are drawn, kept to reuse the memory. */
+std::vector<TileDrawEntry> TileDrawList;
+
+/**
+ * @brief Looks up everything that is drawn on a tile
  * @param tilePosition dPiece coordinates
  * @param targetBufferPosition Target buffer coordinates
  */
-void DrawDungeon(const Surface &out, const Lightmap &lightmap, Point tilePosition, Point targetBufferPosition)
+TileDrawEntry GetTileDrawEntry(Point tilePosition, Point targetBufferPosition)
 {
 	assert(InDungeonBounds(tilePosition));
-	const int lightTableIndex = dLight[tilePosition.x][tilePosition.y];
-
-	DrawCell(out, lightmap, tilePosition, targetBufferPosition, lightTableIndex);
-
-	const int8_t bDead = dCorpse[tilePosition.x][tilePosition.y];
-	const int8_t bMap = dTransVal[tilePosition.x][tilePosition.y];
-
-#ifdef _DEBUG
-	if (DebugVision && IsTileLit(tilePosition)) {
-		ClxDraw(out, targetBufferPosition, (*pSquareCel)[0]);
-	}
-#endif
-
-	if (MissilePreFlag) {
-		DrawMissile(out, tilePosition, targetBufferPosition, true, lightTableIndex);
-	}
-
-	if (lightTableIndex < LightsMax && bDead != 0) {
-		const Corpse &corpse = Corpses[(bDead & 0x1F) - 1];
-		const Point position { targetBufferPosition.x - CalculateSpriteTileCenterX(corpse.width), targetBufferPosition.y };
-		const ClxSprite sprite = corpse.spritesForDirection(static_cast<Direction>((bDead >> 5) & 7))[corpse.frame];
-		if (corpse.translationPaletteIndex != 0) {
-			const uint8_t *trn = Monsters[corpse.translationPaletteIndex - 1].uniqueMonsterTRN.get();
-			ClxDrawTRN(out, position, sprite, trn);
-		} else {
-			ClxDrawLight(out, position, sprite, lightTableIndex);
-		}
-	}
-
-	const int8_t bItem = dItem[tilePosition.x][tilePosition.y];
-	const Object *object = lightTableIndex < LightsMax
+	TileDrawEntry entry {};
+	entry.tilePosition = tilePosition;
+	entry.targetBufferPosition = targetBufferPosition;
+	entry.lightTableIndex = dLight[tilePosition.x][tilePosition.y];
+	entry.corpse = dCorpse[tilePosition.x][tilePosition.y];
+	entry.item = dItem[tilePosition.x][tilePosition.y];
+	entry.deadPlayer = TileContainsDeadPlayer(tilePosition);
+	entry.object = entry.lightTableIndex < LightsMax
 	    ? FindObjectAtPosition(tilePosition)
 	    : nullptr;
-	if (object != nullptr && object->_oPreFlag) {
-		DrawObject(out, *object, tilePosition, targetBufferPosition, lightTableIndex);
-	}
-	if (bItem > 0 && !Items[bItem - 1]._iPostDraw) {
-		DrawItem(out, static_cast<int8_t>(bItem - 1), targetBufferPosition, lightTableIndex);
-	}
 
-	if (TileContainsDeadPlayer(tilePosition)) {
-		DrawDeadPlayer(out, tilePosition, targetBufferPosition, lightTableIndex);
-	}
+	const auto missiles = MissilesAtRenderingTile.find(tilePosition);
+	entry.missiles = missiles != MissilesAtRenderingTile.end() ? &missiles->second : nullptr;
+
 	Player *player = PlayerAtPosition(tilePosition);
 	if (player != nullptr) {
 		const uint8_t pid = player->getId();
@@ -829,7 +858,9 @@ void DrawDungeon(const Surface &out, const Lightmap &lightmap, Point tilePositio
 				tempTargetBufferPosition += { -TILE_WIDTH, 0 };
 				tempTilePosition += Opposite(player->_pdir);
 			}
-			DrawPlayer(out, *player, tempTilePosition, tempTargetBufferPosition, lightTableIndex);
+			entry.player = player;
+			entry.playerTilePosition = tempTilePosition;
+			entry.playerBufferPosition = tempTargetBufferPosition;
 		}
 	}
 
@@ -866,17 +897,80 @@ void DrawDungeon(const Surface &out, const Lightmap &lightmap, Point tilePositio
 				tempTargetBufferPosition += { -TILE_WIDTH, 0 };
 				tempTilePosition += Opposite(monster->direction);
 			}
-			DrawMonsterHelper(out, tempTilePosition, tempTargetBufferPosition, lightTableIndex);
+			entry.hasMonster = true;
+			entry.monsterTilePosition = tempTilePosition;
+			entry.monsterBufferPosition = tempTargetBufferPosition;
+		}
+	}
+
+	return entry;
+}
+
+/**
+ * @brief Render a tile and the sprites on it
+ * @param out Target buffer
+ * @param lightmap Per-pixel light buffer
+ * @param entry What is drawn on the tile
+ */
+void DrawDungeon(const Surface &out, const Lightmap &lightmap, const TileDrawEntry &entry)
+{
+	const Point tilePosition = entry.tilePosition;
+	const Point targetBufferPosition = entry.targetBufferPosition;
+	const int lightTableIndex = entry.lightTableIndex;
+
+	DrawCell(out, lightmap, tilePosition, targetBufferPosition, lightTableIndex);
+
+	const int8_t bDead = entry.corpse;
+	const int8_t bMap = dTransVal[tilePosition.x][tilePosition.y];
+
+#ifdef _DEBUG
+	if (DebugVision && IsTileLit(tilePosition)) {
+		ClxDraw(out, targetBufferPosition, (*pSquareCel)[0]);
+	}
+#endif
+
+	if (MissilePreFlag) {
+		DrawMissiles(out, entry.missiles, targetBufferPosition, true, lightTableIndex);
+	}
+
+	if (lightTableIndex < LightsMax && bDead != 0) {
+		const Corpse &corpse = Corpses[(bDead & 0x1F) - 1];
+		const Point position { targetBufferPosition.x - CalculateSpriteTileCenterX(corpse.width), targetBufferPosition.y };
+		const ClxSprite sprite = corpse.spritesForDirection(static_cast<Direction>((bDead >> 5) & 7))[corpse.frame];
+		if (corpse.translationPaletteIndex != 0) {
+			const uint8_t *trn = Monsters[corpse.translationPaletteIndex - 1].uniqueMonsterTRN.get();
+			ClxDrawTRN(out, position, sprite, trn);
+		} else {
+			ClxDrawLight(out, position, sprite, lightTableIndex);
 		}
 	}
 
-	DrawMissile(out, tilePosition, targetBufferPosition, false, lightTableIndex);
+	const int8_t bItem = entry.item;
+	const Object *object = entry.object;
+	if (object != nullptr && object->_oPreFlag) {
+		DrawObject(out, *object, tilePosition, targetBufferPosition, lightTableIndex);
+	}
+	if (bItem > 0 && !Items[bItem - 1]._iPostDraw) {
+		DrawItem(out, static_cast<int8_t>(bItem - 1), tilePosition, targetBufferPosition, lightTableIndex);
+	}
+
+	if (entry.deadPlayer) {
+		DrawDeadPlayer(out, tilePosition, targetBufferPosition, lightTableIndex);
+	}
+	if (entry.player != nullptr) {
+		DrawPlayer(out, *entry.player, entry.playerTilePosition, entry.playerBufferPosition, lightTableIndex);
+	}
+	if (entry.hasMonster) {
+		DrawMonsterHelper(out, entry.monsterTilePosition, entry.monsterBufferPosition, lightTableIndex);
+	}
+
+	DrawMissiles(out, entry.missiles, targetBufferPosition, false, lightTableIndex);
 
 	if (object != nullptr && !object->_oPreFlag) {
 		DrawObject(out, *object, tilePosition, targetBufferPosition, lightTableIndex);
 	}
 	if (bItem > 0 && Items[bItem - 1]._iPostDraw) {
-		DrawItem(out, static_cast<int8_t>(bItem - 1), targetBufferPosition, lightTableIndex);
+		DrawItem(out, static_cast<int8_t>(bItem - 1), tilePosition, targetBufferPosition, lightTableIndex);
 	}
 
 	if (leveltype != DTYPE_TOWN) {
@@ -915,64 +1009,154 @@ void DrawDungeon(const Surface &out, const Lightmap &lightmap, Point tilePositio
 	}
 }
 
+/**
+ * @brief The tiles in view in the order they are drawn, relative to the first tile and its buffer position.
+ *
+ * The walk only depends on how many rows and columns are drawn, so it is laid out again when those change
+ * (the player starts walking, a side panel opens or the level type changes MicroTileLen) and not when the
+ * camera moves. Which tiles are in the dungeon, floors or walls is still decided per frame.
+ */
+class ViewTileWalk {
+public:
+	struct Cell {
+		Displacement tile;
+		Displacement buffer;
+	};
+
+	/** @brief Lays the walk out again if it doesn't have `rows` rows starting with `columns` tiles. */
+	void Prepare(int rows, int columns)
+	{
+		if (rows == rows_ && columns == columns_)
+			return;
+		rows_ = rows;
+		columns_ = columns;
+		cells_.clear();
+		rowStart_.clear();
+
+		Displacement tile {};
+		Displacement buffer {};
+		for (int i = 0; i < rows; i++) {
+			rowStart_.push_back(static_cast<uint32_t>(cells_.size()));
+			for (int j = 0; j < columns; j++)
+				cells_.push_back({ tile + Displacement(Direction::East) * j, buffer + Displacement { j * TILE_WIDTH, 0 } });
+
+			// Jump to next row
+			buffer.deltaY += TILE_HEIGHT / 2;
+			if ((i & 1) != 0) {
+				tile.deltaX++;
+				columns--;
+				buffer.deltaX += TILE_WIDTH / 2;
+			} else {
+				tile.deltaY++;
+				columns++;
+				buffer.deltaX -= TILE_WIDTH / 2;
+			}
+		}
+		rowStart_.push_back(static_cast<uint32_t>(cells_.size()));
+	}
+
+	[[nodiscard]] int rows() const
+	{
+		return rows_;
+	}
+
+	/** @brief The cells of the first `rows` rows. */
+	[[nodiscard]] std::span<const Cell> FirstRows(int rows) const
+	{
+		return { cells_.data(), rowStart_[std::min(rows, rows_)] };
+	}
+
+	[[nodiscard]] std::span<const Cell> Row(int row) const
+	{
+		return { cells_.data() + rowStart_[row], cells_.data() + rowStart_[row + 1] };
+	}
+
+private:
+	int rows_ = -1;
+	int columns_ = -1;
+	std::vector<Cell> cells_;
+	/** The cells of row `i` are `[rowStart_[i], rowStart_[i + 1])`. */
+	std::vector<uint32_t> rowStart_;
+};
+
+ViewTileWalk ViewWalk;
+
 /**
  * @brief Render a row of tiles
  * @param out Buffer to render to
  * @param lightmap Per-pixel light buffer
+ * @param cache Already lit floor triangles of the band being drawn
+ * @param walk The tiles in view
  * @param tilePosition dPiece coordinates
  * @param targetBufferPosition Target buffer coordinates
  * @param rows Number of rows
- * @param columns Tile in a row
  */
-void DrawFloor(const Surface &out, const Lightmap &lightmap, Point tilePosition, Point targetBufferPosition, int rows, int columns)
+void DrawFloor(const Surface &out, const Lightmap &lightmap, FloorTileCache &cache, const ViewTileWalk &walk, Point tilePosition, Point targetBufferPosition, int rows)
 {
-	for (int i = 0; i < rows; i++) {
-		for (int j = 0; j < columns; j++, tilePosition += Direction::East, targetBufferPosition.x += TILE_WIDTH) {
-			if (!InDungeonBounds(tilePosition))
-				continue;
-			if (IsFloor(tilePosition)) {
-				DrawFloorTile(out, lightmap, tilePosition, targetBufferPosition);
-			}
-		}
-		// Return to start of row
-		tilePosition += Displacement(Direction::West) * columns;
-		targetBufferPosition.x -= columns * TILE_WIDTH;
-
-		// Jump to next row
-		targetBufferPosition.y += TILE_HEIGHT / 2;
-		if ((i & 1) != 0) {
-			tilePosition.x++;
-			columns--;
-			targetBufferPosition.x += TILE_WIDTH / 2;
-		} else {
-			tilePosition.y++;
-			columns++;
-			targetBufferPosition.x -= TILE_WIDTH / 2;
+	for (const ViewTileWalk::Cell &cell : walk.FirstRows(rows)) {
+		const Point position = tilePosition + cell.tile;
+		if (!InDungeonBounds(position))
+			continue;
+		if (IsFloor(position)) {
+			DrawFloorTile(out, lightmap, cache, position, targetBufferPosition + cell.buffer);
 		}
 	}
 }
 
+/** One per render band, since the bands are drawn at the same time. */
+std::array<FloorTileCache, MaxRenderThreads> FloorTileCaches;
+
+/**
+ * @brief Renders the floor tiles in horizontal bands, spread over the render workers
+ *
+ * Floor tiles never overlap each other, so each band only has to clip them to its own rows.
+ */
+void DrawFloorInBands(const Surface &out, const Lightmap &lightmap, const ViewTileWalk &walk, Point tilePosition, Point targetBufferPosition, int rows)
+{
+#ifdef DUN_RENDER_STATS
+	// The stats map isn't safe to update from several threads.
+	const int bands = 1;
+#else
+	const int bands = GetRenderThreadCount();
+#endif
+	const int bandHeight = (out.h() + bands - 1) / bands;
+	RunRenderBands(bands, [&](int band) {
+		const int top = band * bandHeight;
+		const int height = std::min(bandHeight, out.h() - top);
+		if (height <= 0)
+			return;
+		DrawFloor(out.subregionY(top, height), lightmap, FloorTileCaches[band], walk, tilePosition, targetBufferPosition - Displacement { 0, top }, rows);
+	});
+}
+
 /**
  * @brief Renders the floor tiles
  * @param out Output buffer
  * @param lightmap Per-pixel light buffer
- * @param tilePosition dPiece coordinates
- * @param targetBufferPosition Buffer coordinates
+ * @param walk The tiles in view
+ * @param firstTilePosition dPiece coordinates
+ * @param firstBufferPosition Buffer coordinates
  * @param rows Number of rows
- * @param columns Tile in a row
  */
-void DrawTileContent(const Surface &out, const Lightmap &lightmap, Point tilePosition, Point targetBufferPosition, int rows, int columns)
+void DrawTileContent(const Surface &out, const Lightmap &lightmap, const ViewTileWalk &walk, Point firstTilePosition, Point firstBufferPosition, int rows)
 {
 	// Keep evaluating until MicroTiles can't affect screen
 	rows += MicroTileLen;
 
 #ifdef _DEBUG
-	DebugCoordsMap.reserve(rows * columns);
+	DebugCoordsMap.reserve(walk.FirstRows(rows).size());
 #endif
 
+	// Look everything up first and draw afterwards, the tiles keep the order they are walked in
+	// since that is what makes the walls cover the sprites behind them.
+	TileDrawList.clear();
+	DrawnSprites.clear();
+	DrawnSpriteHits.Clear();
 	for (int i = 0; i < rows; i++) {
 		bool skip = false;
-		for (int j = 0; j < columns; j++) {
+		for (const ViewTileWalk::Cell &cell : walk.Row(i)) {
+			const Point tilePosition = firstTilePosition + cell.tile;
+			const Point targetBufferPosition = firstBufferPosition + cell.buffer;
 			if (InDungeonBounds(tilePosition)) {
 				bool skipNext = false;
 #ifdef _DEBUG
@@ -985,35 +1169,21 @@ void DrawTileContent(const Surface &out, const Lightmap &lightmap, Point tilePos
 					// sprite screen position rather than tile position.
 					if (IsWall(tilePosition) && (IsWall(tilePosition + Displacement { 1, 0 }) || (tilePosition.x > 0 && IsWall(tilePosition + Displacement { -1, 0 })))) { // Part of a wall aligned on the x-axis
 						if (IsTileNotSolid(tilePosition + Displacement { 1, -1 }) && IsTileNotSolid(tilePosition + Displacement { 0, -1 })) {                              // Has walkable area behind it
-							DrawDungeon(out, lightmap, tilePosition + Direction::East, { targetBufferPosition.x + TILE_WIDTH, targetBufferPosition.y });
+							TileDrawList.push_back(GetTileDrawEntry(tilePosition + Direction::East, { targetBufferPosition.x + TILE_WIDTH, targetBufferPosition.y }));
 							skipNext = true;
 						}
 					}
 				}
 				if (!skip) {
-					DrawDungeon(out, lightmap, tilePosition, targetBufferPosition);
+					TileDrawList.push_back(GetTileDrawEntry(tilePosition, targetBufferPosition));
 				}
 				skip = skipNext;
 			}
-			tilePosition += Direction::East;
-			targetBufferPosition.x += TILE_WIDTH;
-		}
-		// Return to start of row
-		tilePosition += Displacement(Direction::West) * columns;
-		targetBufferPosition.x -= columns * TILE_WIDTH;
-
-		// Jump to next row
-		targetBufferPosition.y += TILE_HEIGHT / 2;
-		if ((i & 1) != 0) {
-			tilePosition.x++;
-			columns--;
-			targetBufferPosition.x += TILE_WIDTH / 2;
-		} else {
-			tilePosition.y++;
-			columns++;
-			targetBufferPosition.x -= TILE_WIDTH / 2;
 		}
 	}
+
+	for (const TileDrawEntry &entry : TileDrawList)
+		DrawDungeon(out, lightmap, entry);
 }
 
 void DrawDirtTile(const Surface &out, const Lightmap &lightmap, Point tilePosition, Point targetBufferPosition)
@@ -1052,37 +1222,23 @@ void DrawDirtTile(const Surface &out, const Lightmap &lightmap, Point tilePositi
  * @brief Render a row of tiles
  * @param out Buffer to render to
  * @param lightmap Per-pixel light buffer
+ * @param walk The tiles in view
  * @param tilePosition dPiece coordinates
  * @param targetBufferPosition Target buffer coordinates
  * @param rows Number of rows
- * @param columns Tile in a row
  */
-void DrawOOB(const Surface &out, const Lightmap &lightmap, Point tilePosition, Point targetBufferPosition, int rows, int columns)
+void DrawOOB(const Surface &out, const Lightmap &lightmap, const ViewTileWalk &walk, Point tilePosition, Point targetBufferPosition, int rows)
 {
-	for (int i = 0; i < rows + 5; i++) { // 5 extra rows needed to make sure everything gets rendered at the bottom half of the screen
-		for (int j = 0; j < columns; j++, tilePosition += Direction::East, targetBufferPosition.x += TILE_WIDTH) {
-			if (!InDungeonBounds(tilePosition)) {
-				if (leveltype == DTYPE_TOWN) {
-					world_draw_black_tile(out, targetBufferPosition.x, targetBufferPosition.y);
-				} else {
-					DrawDirtTile(out, lightmap, tilePosition, targetBufferPosition);
-				}
-			}
-		}
-		// Return to start of row
-		tilePosition += Displacement(Direction::West) * columns;
-		targetBufferPosition.x -= columns * TILE_WIDTH;
-
-		// Jump to next row
-		targetBufferPosition.y += TILE_HEIGHT / 2;
-		if ((i & 1) != 0) {
-			tilePosition.x++;
-			columns--;
-			targetBufferPosition.x += TILE_WIDTH / 2;
+	// 5 extra rows needed to make sure everything gets rendered at the bottom half of the screen
+	for (const ViewTileWalk::Cell &cell : walk.FirstRows(rows + 5)) {
+		const Point position = tilePosition + cell.tile;
+		if (InDungeonBounds(position))
+			continue;
+		const Point bufferPosition = targetBufferPosition + cell.buffer;
+		if (leveltype == DTYPE_TOWN) {
+			world_draw_black_tile(out, bufferPosition.x, bufferPosition.y);
 		} else {
-			tilePosition.y++;
-			columns++;
-			targetBufferPosition.x -= TILE_WIDTH / 2;
+			DrawDirtTile(out, lightmap, position, bufferPosition);
 		}
 	}
 }
@@ -1116,11 +1272,9 @@ void Zoom(const Surface &out)
 
 	for (int hgt = 0; hgt < doubleableHeight; hgt++) {
 		// Double the pixels in the line.
-		for (int i = 0; i < doubleableWidth; i++) {
-			*dst-- = *src;
-			*dst-- = *src;
-			--src;
-		}
+		DoublePixels(src - doubleableWidth + 1, dst - 2 * doubleableWidth + 1, doubleableWidth);
+		src -= doubleableWidth;
+		dst -= 2 * doubleableWidth;
 
 		// Copy a single extra pixel if the output width is odd.
 		if (oddViewportWidth) {
@@ -1248,11 +1402,12 @@ void DrawGame(const Surface &fullOut, Point position, Displacement offset)
 	Lightmap lightmap = Lightmap::build(*GetOptions().Graphics.perPixelLighting, position, Point {} + offset,
 	    gnScreenWidth, gnViewportHeight, rows, columns,
 	    out.at(0, 0), out.pitch(), LightTables, FullyLitLightTable, FullyDarkLightTable,
-	    dLight, MicroTileLen);
+	    dLight, MicroTileLen, GetRenderThreadCount());
 
-	DrawFloor(out, lightmap, position, Point {} + offset, rows, columns);
-	DrawTileContent(out, lightmap, position, Point {} + offset, rows, columns);
-	DrawOOB(out, lightmap, position, Point {} + offset, rows, columns);
+	ViewWalk.Prepare(rows + std::max<int>(MicroTileLen, 5), columns);
+	DrawFloorInBands(out, lightmap, ViewWalk, position, Point {} + offset, rows);
+	DrawTileContent(out, lightmap, ViewWalk, position, Point {} + offset, rows);
+	DrawOOB(out, lightmap, ViewWalk, position, Point {} + offset, rows);
 
 	if (*GetOptions().Graphics.zoom) {
 		Zoom(fullOut.subregionY(0, gnViewportHeight));
@@ -1284,13 +1439,19 @@ void DrawGame(const Surface &fullOut, Point position, Displacement offset)
  */
 void DrawView(const Surface &out, Point startPosition)
 {
+	DVL_TRACE_ZONE("DrawView");
 #ifdef _DEBUG
 	DebugCoordsMap.clear();
 #endif
 	Displacement offset = {};
 	CalcFirstTilePosition(startPosition, offset);
-	DrawGame(out, startPosition, offset);
-	if (AutomapActive) {
+	if (IsAudioFirstMode()) {
+		// Only the panels are kept, for a sighted helper looking over the player's shoulder.
+		FillRect(out, 0, 0, out.w(), gnViewportHeight, 0);
+	} else {
+		DrawGame(out, startPosition, offset);
+	}
+	if (AutomapActive && !IsAudioFirstMode()) {
 		DrawAutomap(out.subregionY(0, gnViewportHeight));
 	}
 #ifdef _DEBUG
@@ -1361,9 +1522,11 @@ void DrawView(const Surface &out, Point startPosition)
 		}
 	}
 #endif
-	DrawItemNameLabels(out);
-	DrawMonsterHealthBar(out);
-	DrawFloatingNumbers(out, startPosition, offset);
+	if (!IsAudioFirstMode()) {
+		DrawItemNameLabels(out);
+		DrawMonsterHealthBar(out);
+		DrawFloatingNumbers(out, startPosition, offset);
+	}
 
 	if (IsPlayerInStore() && !qtextflag)
 		DrawSText(out);
@@ -1422,6 +1585,73 @@ void DrawView(const Surface &out, Point startPosition)
 	DrawManaFlaskUpper(out);
 }
 
+/**
+ * @brief Display what the audio pipeline cost over the last second, below the FPS counter
+ */
+void DrawAudioStats(const Surface &out)
+{
+	static AudioStats formattedStats {};
+	static std::string formatted;
+
+	const AudioStats &stats = GetAudioStats();
+	if (formatted.empty() || stats != formattedStats) {
+		formattedStats = stats;
+		formatted = StrCat(
+		    "Audio: ", stats.activeVoices, " voices, ", stats.callbacks, " callbacks, ", stats.underruns, " underruns\n",
+		    "Decode ", stats.decodeMicroseconds, "us, resample (", stats.resampler, ") ", stats.resampleMicroseconds, "us\n",
+		    "Update ", stats.soundUpdateMicroseconds, "us, pool ", stats.soundPoolMicroseconds, "us per second");
+	}
+	DrawString(out, formatted, Point { 8, 28 }, { .flags = UiFlags::ColorRed });
+}
+
+/**
+ * @brief Display the network traffic counted so far, below the FPS counter and audio statistics
+ */
+void DrawNetStats(const Surface &out)
+{
+	static uint32_t lastUpdate = 0;
+	static std::string formatted;
+
+	const uint32_t now = SDL_GetTicks();
+	if (formatted.empty() || now - lastUpdate >= 1000) {
+		lastUpdate = now;
+		formatted = FormatNetStats(3);
+	}
+	DrawString(out, formatted, Point { 8, IsAudioStatsEnabled() ? 88 : 28 }, { .flags = UiFlags::ColorRed });
+}
+
+/**
+ * @brief Display what each step of the last game ticks cost, along the right edge
+ */
+void DrawTickTimings(const Surface &out)
+{
+	static uint32_t lastUpdate = 0;
+	static std::string formatted;
+
+	const uint32_t now = SDL_GetTicks();
+	if (formatted.empty() || now - lastUpdate >= 250) {
+		lastUpdate = now;
+		formatted = FormatTickTimings(/*skipIdle=*/true);
+	}
+	DrawString(out, formatted, Rectangle { { 0, 8 }, { out.w() - 8, out.h() - 8 } }, { .flags = UiFlags::ColorRed | UiFlags::AlignRight });
+}
+
+/**
+ * @brief Display the frame and tick time percentiles below the FPS
+ */
+void DrawFramePercentiles(const Surface &out)
+{
+	static uint32_t lastUpdate = 0;
+	static std::string formatted;
+
+	const uint32_t now = SDL_GetTicks();
+	if (formatted.empty() || now - lastUpdate >= 1000) {
+		lastUpdate = now;
+		formatted = FormatFramePercentiles();
+	}
+	DrawString(out, formatted, Point { 8, 24 }, { .flags = UiFlags::ColorRed });
+}
+
 /**
  * @brief Display the current average FPS over 1 sec
  */
@@ -1430,6 +1660,13 @@ void DrawFPS(const Surface &out)
 	static int framesSinceLastUpdate = 0;
 	static std::string_view formatted {};
 
+	if (IsAudioStatsEnabled() && gbActive)
+		DrawAudioStats(out);
+	if (IsNetStatsEnabled() && gbActive)
+		DrawNetStats(out);
+	if (IsTickTimingEnabled() && gbActive)
+		DrawTickTimings(out);
+
 	if (!frameflag || !gbActive) {
 		return;
 	}
@@ -1450,6 +1687,8 @@ void DrawFPS(const Surface &out)
 		formatted = { buf, static_cast<std::string_view::size_type>(end - buf) };
 	};
 	DrawString(out, formatted, Point { 8, 8 }, { .flags = UiFlags::ColorRed });
+	if (IsFrameStatsEnabled())
+		DrawFramePercentiles(out);
 }
 
 /**
@@ -1488,7 +1727,13 @@ void DrawMain(int dwHgt, bool drawDesc, bool drawHp, bool drawMana, bool drawSba
 
 	assert(dwHgt >= 0 && dwHgt <= gnScreenHeight);
 
-	if (dwHgt > 0) {
+	if (dwHgt > 0 && !IsRedrawEverything()) {
+		// Most frames only change a small part of the view, e.g. an animating monster.
+		// After a full redraw the output may hold something else, so everything is sent then.
+		const Rectangle changed = GetChangedBackBufferArea({ { 0, 0 }, { gnScreenWidth, dwHgt } });
+		if (changed.size.width > 0 && changed.size.height > 0)
+			DoBlitScreen(changed);
+	} else if (dwHgt > 0) {
 		DoBlitScreen({ { 0, 0 }, { gnScreenWidth, dwHgt } });
 	}
 	if (dwHgt < gnScreenHeight) {
@@ -1534,26 +1779,48 @@ void OptionShowFPSChanged()
 	if (*GetOptions().Graphics.showFPS)
 		EnableFrameCount();
 	else
-		frameflag = false;
+		DisableFrameCount();
 }
 const auto OptionChangeHandlerShowFPS = (GetOptions().Graphics.showFPS.SetValueChangedCallback(OptionShowFPSChanged), true);
 
-} // namespace
-
-Displacement GetOffsetForWalking(const AnimationInfo &animationInfo, const Direction dir, bool cameraMode /*= false*/)
+void OptionAudioFirstChanged()
 {
+	RedrawEverything();
+}
+const auto OptionChangeHandlerAudioFirst = (GetOptions().Graphics.audioFirst.SetValueChangedCallback(OptionAudioFirstChanged), true);
+
+/**
+ * @brief The walking offset of every direction at every animation progress (a fraction of AnimationInfo::baseValueFraction).
+ *
+ * Filled with the same integer scaling that used to run for every walking actor and frame, so the offsets are exact.
+ */
+constexpr auto WalkingOffsets = [] {
 	// clang-format off
 	//                                           South,        SouthWest,    West,         NorthWest,    North,        NorthEast,     East,         SouthEast,
 	constexpr Displacement MovingOffset[8]   = { {   0,  32 }, { -32,  16 }, { -64,   0 }, { -32, -16 }, {   0, -32 }, {  32, -16 },  {  64,   0 }, {  32,  16 } };
 	// clang-format on
 
-	const uint8_t animationProgress = animationInfo.getAnimationProgress();
-	Displacement offset = MovingOffset[static_cast<size_t>(dir)];
-	offset *= animationProgress;
-	offset /= AnimationInfo::baseValueFraction;
+	std::array<std::array<Displacement, AnimationInfo::baseValueFraction + 1>, 8> offsets {};
+	for (size_t dir = 0; dir < offsets.size(); dir++) {
+		for (int progress = 0; progress <= AnimationInfo::baseValueFraction; progress++) {
+			Displacement offset = MovingOffset[dir];
+			offset *= progress;
+			offset /= AnimationInfo::baseValueFraction;
+			offsets[dir][progress] = offset;
+		}
+	}
+	return offsets;
+}();
+
+} // namespace
+
+Displacement GetOffsetForWalking(const AnimationInfo &animationInfo, const Direction dir, bool cameraMode /*= false*/)
+{
+	const uint8_t animationProgress = std::min(animationInfo.getAnimationProgress(), AnimationInfo::baseValueFraction);
+	const Displacement offset = WalkingOffsets[static_cast<size_t>(dir)][animationProgress];
 
 	if (cameraMode) {
-		offset = -offset;
+		return -offset;
 	}
 
 	return offset;
@@ -1687,6 +1954,14 @@ void CalcViewportGeometry()
 	tileColumns = (screenWidth - renderStart.x + TILE_WIDTH - 1) / TILE_WIDTH;
 }
 
+std::optional<DrawnSprite> FindDrawnSprite(Point position, tl::function_ref<bool(const DrawnSprite &)> accept)
+{
+	const std::optional<uint32_t> id = DrawnSpriteHits.FindAt(position, [&](uint32_t candidate) { return accept(DrawnSprites[candidate]); });
+	if (!id)
+		return std::nullopt;
+	return DrawnSprites[*id];
+}
+
 Point GetScreenPosition(Point tile)
 {
 	Point firstTile = ViewPosition;
@@ -1777,6 +2052,13 @@ void EnableFrameCount()
 {
 	frameflag = true;
 	lastFpsUpdateInMs = SDL_GetTicks();
+	SetFrameStatsEnabled(true);
+}
+
+void DisableFrameCount()
+{
+	frameflag = false;
+	SetFrameStatsEnabled(false);
 }
 
 void scrollrt_draw_game_screen()
@@ -1786,8 +2068,8 @@ void scrollrt_draw_game_screen()
 
 	int hgt = 0;
 
-	if (IsRedrawEverything()) {
-		RedrawComplete();
+	const bool redrawEverything = IsRedrawEverything();
+	if (redrawEverything) {
 		hgt = gnScreenHeight;
 	}
 
@@ -1795,15 +2077,27 @@ void scrollrt_draw_game_screen()
 	UndrawCursor(out);
 	DrawCursor(out);
 	DrawMain(hgt, false, false, false, false, false);
+	if (redrawEverything) {
+		RedrawComplete();
+	}
 
 	RenderPresent();
 }
 
 void DrawAndBlit()
 {
+	DVL_TRACE_ZONE("DrawAndBlit");
 	if (!gbRunGame || HeadlessMode) {
 		return;
 	}
+	// The redraw flags stay set, so whatever changed in between is drawn with the next frame.
+	if (IsAudioFirstMode() && !IsAudioFirstFrameDue()) {
+		return;
+	}
+	// Timed until the frame is handed over for presenting, without the wait for v-sync or the frame limiter.
+	// nthread_has_500ms_passed() skips frames that wouldn't fit before the next game tick.
+	GetFramePacer().BeginFrame(FramePacer::Clock::now());
+	CountFrame();
 
 	int hgt = 0;
 	bool drawHealth = IsRedrawComponent(PanelDrawComponent::Health);
@@ -1888,6 +2182,7 @@ void DrawAndBlit()
 		}
 	}
 
+	RecordFrame();
 	RenderPresent();
 }
 
@@ -5,6 +5,11 @@
  */
 #pragma once
 
+#include <cstdint>
+#include <optional>
+
+#include <function_ref.hpp>
+
 #include "engine/animationinfo.h"
 #include "engine/direction.hpp"
 #include "engine/displacement.hpp"
@@ -63,6 +68,30 @@ void CalcViewportGeometry();
  */
 Point GetScreenPosition(Point tile);
 
+/** @brief A sprite of the last drawn frame that the mouse can select. */
+struct DrawnSprite {
+	enum class Kind : uint8_t {
+		Monster,
+		Towner,
+		Player,
+		Object,
+		Item,
+	};
+
+	Kind kind;
+	/** Index into Monsters, Towners, Players, Objects or Items. */
+	int index;
+	/** The tile the sprite was drawn for. */
+	Point tile;
+};
+
+/**
+ * @brief Finds the sprite of the last drawn frame at a position of the game view, before zooming
+ * @param position Position in the same coordinates as GetScreenPosition()
+ * @param accept Whether the sprite is really hit, only asked for sprites whose bounds contain the position, the last drawn first
+ */
+std::optional<DrawnSprite> FindDrawnSprite(Point position, tl::function_ref<bool(const DrawnSprite &)> accept);
+
 /**
  * @brief Render the whole screen black
  */
@@ -80,6 +109,11 @@ void ScrollView();
  */
 void EnableFrameCount();
 
+/**
+ * @brief Hide the FPS meter
+ */
+void DisableFrameCount();
+
 /**
  * @brief Redraw screen
  */
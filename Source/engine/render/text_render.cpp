@@ -10,9 +10,11 @@
 #include <cstddef>
 #include <cstdint>
 #include <optional>
+#include <string>
 #include <string_view>
 #include <utility>
 #include <variant>
+#include <vector>
 
 #include <ankerl/unordered_dense.h>
 #include <fmt/core.h>
@@ -35,6 +37,7 @@
 #include "utils/language.h"
 #include "utils/log.hpp"
 #include "utils/str_cat.hpp"
+#include "utils/string_view_hash.hpp"
 #include "utils/utf8.hpp"
 
 namespace devilution {
@@ -185,12 +188,17 @@ uint32_t GetFontId(GameFontTables size, uint16_t row)
 	return (size << 16) | row;
 }
 
-FontStack LoadFont(GameFontTables size, text_color color, uint16_t row)
+void LoadColorTranslation(text_color color)
 {
 	if (ColorTranslations[color] != nullptr && !ColorTranslationsData[color]) {
 		ColorTranslationsData[color].emplace();
 		LoadFileInMem(ColorTranslations[color], *ColorTranslationsData[color]);
 	}
+}
+
+FontStack LoadFont(GameFontTables size, text_color color, uint16_t row)
+{
+	LoadColorTranslation(color);
 
 	const uint32_t fontId = GetFontId(size, row);
 	auto hotFont = Fonts.find(fontId);
@@ -278,6 +286,94 @@ void DrawFont(const Surface &out, Point position, ClxSprite glyph, text_color co
 	}
 }
 
+struct ShapedGlyph {
+	ClxSprite sprite;
+	/** Sum of the widths of the glyphs before this one, the spacing is added when drawing. */
+	int x;
+};
+
+/** A line of text with its glyphs looked up, so that it can be measured and drawn again without decoding it. */
+struct ShapedLine {
+	std::vector<ShapedGlyph> glyphs;
+	int glyphsWidth = 0;
+	/** Whether the text is a single line that DoDrawString() would draw in full, i.e. it has no newline, NUL or invalid UTF-8. */
+	bool singleLine = true;
+
+	[[nodiscard]] int width(int spacing) const
+	{
+		const int lineWidth = glyphsWidth + static_cast<int>(glyphs.size()) * spacing;
+		return lineWidth != 0 ? (lineWidth - spacing) : 0;
+	}
+};
+
+/**
+ * Item labels, floating numbers and panel text are drawn the same way frame after frame.
+ * The cache is emptied once it gets this big, that only costs shaping what is on screen again.
+ */
+constexpr size_t MaxShapedLinesPerSize = 1024;
+
+std::array<ankerl::unordered_dense::map<std::string, ShapedLine, StringViewHash, StringViewEquals>, LineHeights.size()> ShapedLines;
+
+/** @brief Looks up the glyphs of the text up to the first newline, the same way GetLineWidth() measures it. */
+const ShapedLine &ShapeLine(std::string_view text, GameFontTables size)
+{
+	auto &lines = ShapedLines[size];
+	const auto cached = lines.find(text);
+	if (cached != lines.end())
+		return cached->second;
+
+	if (lines.size() >= MaxShapedLinesPerSize)
+		lines.clear();
+	ShapedLine &line = lines[std::string(text)];
+	CurrentFont currentFont;
+	while (!text.empty()) {
+		char32_t next = ConsumeFirstUtf8CodePoint(&text);
+		if (next == Utf8DecodeError || next == U'\n') {
+			line.singleLine = false;
+			break;
+		}
+		if (next == ZWSP)
+			continue;
+		if (next == U'\0')
+			line.singleLine = false;
+
+		if (!currentFont.load(size, text_color::ColorDialogWhite, next)) {
+			next = U'?';
+			if (!currentFont.load(size, text_color::ColorDialogWhite, next)) {
+				app_fatal("Missing fonts");
+			}
+		}
+
+		const ClxSprite glyph = currentFont.glyph(next & 0xFF);
+		line.glyphs.push_back(ShapedGlyph { glyph, line.glyphsWidth });
+		line.glyphsWidth += glyph.width();
+	}
+	return line;
+}
+
+/**
+ * @brief Draws a shaped line if it fits without wrapping.
+ * @return Whether the line was drawn, if not it has to go through DoDrawString().
+ */
+bool DrawShapedLine(const Surface &out, const ShapedLine &line, Point &characterPosition, int rightMargin, int spacing, text_color color, bool outline)
+{
+	if (!line.singleLine)
+		return false;
+	for (size_t i = 0; i < line.glyphs.size(); i++) {
+		const ShapedGlyph &glyph = line.glyphs[i];
+		if (characterPosition.x + glyph.x + static_cast<int>(i) * spacing + glyph.sprite.width() > rightMargin)
+			return false;
+	}
+
+	LoadColorTranslation(color);
+	for (size_t i = 0; i < line.glyphs.size(); i++) {
+		const ShapedGlyph &glyph = line.glyphs[i];
+		DrawFont(out, characterPosition + Displacement { glyph.x + static_cast<int>(i) * spacing, 0 }, glyph.sprite, color, outline);
+	}
+	characterPosition.x += line.glyphsWidth + static_cast<int>(line.glyphs.size()) * spacing;
+	return true;
+}
+
 bool IsFullWidthPunct(char32_t c)
 {
 	return IsAnyOf(c, U'，', U'、', U'。', U'？', U'！');
@@ -364,6 +460,10 @@ private:
 bool ContainsSmallFontTallCodepoints(std::string_view text)
 {
 	while (!text.empty()) {
+		// ASCII has neither tall glyphs nor zero-width spaces.
+		text.remove_prefix(CountAsciiPrefix(text));
+		if (text.empty())
+			break;
 		const char32_t next = ConsumeFirstUtf8CodePoint(&text);
 		if (next == Utf8DecodeError)
 			break;
@@ -629,40 +729,31 @@ void LoadSmallSelectionSpinner()
 
 void UnloadFonts()
 {
+	// The shaped lines point into the fonts.
+	for (auto &lines : ShapedLines)
+		lines.clear();
 	Fonts.clear();
 }
 
-int GetLineWidth(std::string_view text, GameFontTables size, int spacing, int *charactersInLine)
+size_t FontsMemoryUsage()
 {
-	int lineWidth = 0;
-	CurrentFont currentFont;
-	uint32_t codepoints = 0;
-	char32_t next;
-	while (!text.empty()) {
-		next = ConsumeFirstUtf8CodePoint(&text);
-		if (next == Utf8DecodeError)
-			break;
-		if (next == ZWSP)
-			continue;
-
-		if (next == U'\n')
-			break;
-
-		if (!currentFont.load(size, text_color::ColorDialogWhite, next)) {
-			next = U'?';
-			if (!currentFont.load(size, text_color::ColorDialogWhite, next)) {
-				app_fatal("Missing fonts");
-			}
-		}
-
-		const uint8_t frame = next & 0xFF;
-		lineWidth += currentFont.glyph(frame).width() + spacing;
-		++codepoints;
+	size_t bytes = 0;
+	for (const auto &[fontId, font] : Fonts) {
+		if (font.baseFont)
+			bytes += font.baseFont->dataSize();
+		if (font.overrideFont)
+			bytes += font.overrideFont->dataSize();
 	}
+	return bytes;
+}
+
+int GetLineWidth(std::string_view text, GameFontTables size, int spacing, int *charactersInLine)
+{
+	const ShapedLine &line = ShapeLine(text, size);
 	if (charactersInLine != nullptr)
-		*charactersInLine = codepoints;
+		*charactersInLine = static_cast<int>(line.glyphs.size());
 
-	return lineWidth != 0 ? (lineWidth - spacing) : 0;
+	return line.width(spacing);
 }
 
 bool IsConsumed(std::string_view s) { return s.empty() || s[0] == '\0'; };
@@ -865,8 +956,16 @@ uint32_t DrawString(const Surface &out, std::string_view text, const Rectangle &
 		opts.cursorPosition = -1;
 	}
 
-	const uint32_t bytesDrawn = DoDrawString(clippedOut, text, rect, characterPosition,
-	    lineWidth, charactersInLine, rightMargin, bottomMargin, size, color, outlined, opts);
+	// Lines without a cursor or highlight that fit are drawn straight from their cached glyphs.
+	uint32_t bytesDrawn;
+	if (opts.cursorPosition == -1 && opts.highlightRange.begin >= opts.highlightRange.end
+	    && (!HasAnyOf(opts.flags, UiFlags::KerningFitSpacing) || lineWidth <= rect.size.width)
+	    && DrawShapedLine(clippedOut, ShapeLine(text, size), characterPosition, rightMargin, opts.spacing, color, outlined)) {
+		bytesDrawn = static_cast<uint32_t>(text.size());
+	} else {
+		bytesDrawn = DoDrawString(clippedOut, text, rect, characterPosition,
+		    lineWidth, charactersInLine, rightMargin, bottomMargin, size, color, outlined, opts);
+	}
 
 	if (HasAnyOf(opts.flags, UiFlags::PentaCursor)) {
 		const ClxSprite sprite = (*pSPentSpn2Cels)[PentSpn2Spin()];
@@ -266,6 +266,9 @@ inline void DrawStringWithColors(const Surface &out, std::string_view fmt, std::
 uint8_t PentSpn2Spin();
 void UnloadFonts();
 
+/** @brief Bytes held by the glyphs of the fonts loaded so far. */
+size_t FontsMemoryUsage();
+
 /** @brief Whether this character can be substituted by a newline when word-wrapping. */
 bool IsBreakableWhitespace(char32_t c);
 
@@ -0,0 +1,188 @@
+/**
+ * @file sector_graph.cpp
+ *
+ * Implementation of the coarse room/sector graph used to plan long walks.
+ */
+#include "engine/sector_graph.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <queue>
+#include <utility>
+
+namespace devilution {
+
+namespace {
+
+constexpr std::array<Displacement, 4> AxisSteps = {
+	Displacement { 0, -1 },
+	Displacement { -1, 0 },
+	Displacement { 1, 0 },
+	Displacement { 0, 1 },
+};
+
+[[nodiscard]] bool IsInGrid(Point position)
+{
+	return position.x >= 0 && position.x < MAXDUNX && position.y >= 0 && position.y < MAXDUNY;
+}
+
+[[nodiscard]] size_t IndexOf(Point position)
+{
+	return static_cast<size_t>(position.x) + static_cast<size_t>(position.y) * MAXDUNX;
+}
+
+} // namespace
+
+void SectorGraph::Build(const Bitset2d<MAXDUNX, MAXDUNY> &passable, tl::function_ref<int(Point)> regionOf)
+{
+	Clear();
+
+	std::vector<Point> queue;
+	for (int y = 0; y < MAXDUNY; y++) {
+		for (int x = 0; x < MAXDUNX; x++) {
+			const Point seed { x, y };
+			if (!passable.test(x, y) || sectorOf_[IndexOf(seed)] != NoSector)
+				continue;
+
+			if (links_.size() == NoSector)
+				return; // Can't happen with a 112x112 grid, but don't overflow the ids.
+
+			const SectorId sector = static_cast<SectorId>(links_.size());
+			links_.emplace_back();
+			const int region = regionOf(seed);
+
+			queue.clear();
+			queue.push_back(seed);
+			sectorOf_[IndexOf(seed)] = sector;
+			for (size_t head = 0; head < queue.size(); head++) {
+				for (const Displacement step : AxisSteps) {
+					const Point next = queue[head] + step;
+					if (!IsInGrid(next) || !passable.test(next.x, next.y) || sectorOf_[IndexOf(next)] != NoSector)
+						continue;
+					if (regionOf(next) != region)
+						continue;
+					sectorOf_[IndexOf(next)] = sector;
+					queue.push_back(next);
+				}
+			}
+		}
+	}
+
+	// Collect every crossing between two sectors, then keep the middle one of each pair as its portal.
+	std::vector<std::vector<Link>> crossings(links_.size());
+	for (int y = 0; y < MAXDUNY; y++) {
+		for (int x = 0; x < MAXDUNX; x++) {
+			const Point from { x, y };
+			const SectorId sector = sectorOf_[IndexOf(from)];
+			if (sector == NoSector)
+				continue;
+			for (const Displacement step : AxisSteps) {
+				const Point to = from + step;
+				if (!IsInGrid(to))
+					continue;
+				const SectorId other = sectorOf_[IndexOf(to)];
+				if (other == NoSector || other == sector)
+					continue;
+				crossings[sector].push_back({ other, { from, to } });
+			}
+		}
+	}
+
+	for (size_t sector = 0; sector < crossings.size(); sector++) {
+		std::vector<Link> &sectorCrossings = crossings[sector];
+		std::stable_sort(sectorCrossings.begin(), sectorCrossings.end(), [](const Link &a, const Link &b) { return a.sector < b.sector; });
+		for (size_t first = 0; first < sectorCrossings.size();) {
+			size_t last = first;
+			while (last < sectorCrossings.size() && sectorCrossings[last].sector == sectorCrossings[first].sector)
+				last++;
+			links_[sector].push_back(sectorCrossings[first + (last - first) / 2]);
+			first = last;
+		}
+	}
+}
+
+void SectorGraph::Clear()
+{
+	sectorOf_.fill(NoSector);
+	links_.clear();
+}
+
+SectorGraph::SectorId SectorGraph::SectorAt(Point position) const
+{
+	if (!IsInGrid(position))
+		return NoSector;
+	return sectorOf_[IndexOf(position)];
+}
+
+std::optional<std::vector<SectorGraph::Portal>> SectorGraph::PlanRoute(Point start, Point destination) const
+{
+	const SectorId startSector = SectorAt(start);
+	const SectorId destinationSector = SectorAt(destination);
+	if (startSector == NoSector || destinationSector == NoSector)
+		return std::nullopt;
+	if (startSector == destinationSector)
+		return std::vector<Portal> {};
+
+	constexpr int Unvisited = std::numeric_limits<int>::max();
+	constexpr size_t NoLink = std::numeric_limits<size_t>::max();
+
+	/** How a sector was entered: the sector we came from and the link taken out of it. */
+	struct Arrival {
+		int cost = Unvisited;
+		Point position;
+		SectorId previous = NoSector;
+		size_t link = NoLink;
+	};
+	std::vector<Arrival> arrivals(links_.size());
+	arrivals[startSector].cost = 0;
+	arrivals[startSector].position = start;
+
+	using QueueEntry = std::pair<int, SectorId>;
+	std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<>> queue;
+	queue.emplace(0, startSector);
+	while (!queue.empty()) {
+		const auto [cost, sector] = queue.top();
+		queue.pop();
+		if (cost != arrivals[sector].cost)
+			continue;
+		if (sector == destinationSector)
+			break;
+
+		const Point position = arrivals[sector].position;
+		for (size_t i = 0; i < links_[sector].size(); i++) {
+			const Link &link = links_[sector][i];
+			const int nextCost = cost + position.WalkingDistance(link.portal.from) + 1;
+			Arrival &next = arrivals[link.sector];
+			if (nextCost >= next.cost)
+				continue;
+			next.cost = nextCost;
+			next.position = link.portal.to;
+			next.previous = sector;
+			next.link = i;
+			queue.emplace(nextCost, link.sector);
+		}
+	}
+
+	if (arrivals[destinationSector].cost == Unvisited)
+		return std::nullopt;
+
+	std::vector<Portal> route;
+	for (SectorId sector = destinationSector; sector != startSector; sector = arrivals[sector].previous) {
+		const Arrival &arrival = arrivals[sector];
+		route.push_back(links_[arrival.previous][arrival.link].portal);
+	}
+	std::reverse(route.begin(), route.end());
+	return route;
+}
+
+void SectorGraph::AddSectorTiles(SectorId sector, Bitset2d<MAXDUNX, MAXDUNY> &tiles) const
+{
+	for (int y = 0; y < MAXDUNY; y++) {
+		for (int x = 0; x < MAXDUNX; x++) {
+			if (sectorOf_[IndexOf({ x, y })] == sector)
+				tiles.set(x, y);
+		}
+	}
+}
+
+} // namespace devilution
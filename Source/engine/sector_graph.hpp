@@ -0,0 +1,84 @@
+/**
+ * @file sector_graph.hpp
+ *
+ * Interface of the coarse room/sector graph used to plan long walks.
+ */
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <vector>
+
+#include <function_ref.hpp>
+
+#include "engine/point.hpp"
+#include "levels/gendung_defs.hpp"
+#include "utils/bitset2d.hpp"
+
+namespace devilution {
+
+/**
+ * @brief Splits the passable tiles of a level into sectors and links neighbouring sectors.
+ *
+ * A sector is a 4-connected group of passable tiles sharing the same region value (such as the
+ * dTransVal room a tile belongs to). Two sectors are linked by a portal where they touch. Planning
+ * a route over sectors first means only the first few legs of a long walk have to be searched tile
+ * by tile.
+ */
+class SectorGraph {
+public:
+	using SectorId = uint16_t;
+	static constexpr SectorId NoSector = std::numeric_limits<SectorId>::max();
+
+	/** A pair of adjacent tiles, `from` in one sector and `to` in the next. */
+	struct Portal {
+		Point from;
+		Point to;
+	};
+
+	/**
+	 * @brief Rebuilds the graph.
+	 *
+	 * @param passable Set for every tile that can be stepped on, indexed by (x, y).
+	 * @param regionOf The region a tile belongs to; sectors never span several regions.
+	 */
+	void Build(const Bitset2d<MAXDUNX, MAXDUNY> &passable, tl::function_ref<int(Point)> regionOf);
+
+	void Clear();
+
+	/** @return The sector of `position`, or `NoSector` if the tile isn't passable. */
+	[[nodiscard]] SectorId SectorAt(Point position) const;
+
+	[[nodiscard]] size_t SectorCount() const
+	{
+		return links_.size();
+	}
+
+	/**
+	 * @brief Finds the portals to cross to walk from `start` to `destination`.
+	 *
+	 * Sector to sector costs are estimated from the walking distance between portals, so the
+	 * route is short but not necessarily the shortest one.
+	 *
+	 * @return The portals in walking order (empty if both tiles share a sector), or an empty
+	 * optional if either tile isn't in a sector or the sectors aren't connected.
+	 */
+	[[nodiscard]] std::optional<std::vector<Portal>> PlanRoute(Point start, Point destination) const;
+
+	/** @brief Sets the bit of every tile of `sector` in `tiles`. */
+	void AddSectorTiles(SectorId sector, Bitset2d<MAXDUNX, MAXDUNY> &tiles) const;
+
+private:
+	struct Link {
+		SectorId sector;
+		Portal portal;
+	};
+
+	std::array<SectorId, MAXDUNX * MAXDUNY> sectorOf_;
+	std::vector<std::vector<Link>> links_;
+};
+
+} // namespace devilution
@@ -6,13 +6,17 @@
 #include "engine/sound.h"
 
 #include <algorithm>
+#include <array>
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
 #include <list>
 #include <memory>
 #include <mutex>
 #include <optional>
+#include <span>
 #include <string>
+#include <string_view>
 #include <utility>
 
 #ifdef USE_SDL3
@@ -20,6 +24,7 @@
 #include <SDL3/SDL_error.h>
 #include <SDL3/SDL_timer.h>
 #else
+#include <Aulib/Decoder.h>
 #include <Aulib/Stream.h>
 #include <SDL.h>
 #endif
@@ -27,12 +32,14 @@
 
 #include "appfat.h"
 #include "engine/assets.hpp"
+#include "engine/audio_stats.hpp"
 #include "engine/sound_pool.hpp"
 #include "game_mode.hpp"
 #include "options.h"
 #include "utils/log.hpp"
 #include "utils/math.h"
 #include "utils/sdl_mutex.h"
+#include "utils/sdl_thread.h"
 #include "utils/status_macros.hpp"
 #include "utils/stdcompat/shared_ptr_array.hpp"
 #include "utils/str_cat.hpp"
@@ -118,11 +125,13 @@ tl::expected<void, std::string> LoadAudioFile(const char *path, bool stream, Sou
 std::list<std::unique_ptr<SoundSample>> duplicateSounds;
 std::optional<SdlMutex> duplicateSoundsMutex;
 
-SoundSample *DuplicateSound(const SoundSample &sound)
+SoundSample *DuplicateSound(SoundSample &sound)
 {
 #ifdef USE_SDL3
 	return nullptr;
 #else
+	// Overlapping plays share one decoded copy instead of each decoding the file again.
+	sound.DecodeForDuplicates();
 	auto duplicate = std::make_unique<SoundSample>();
 	if (duplicate->DuplicateFrom(sound) != 0)
 		return nullptr;
@@ -190,6 +199,225 @@ const auto OptionChangeResamplingQuality = (GetOptions().Audio.resamplingQuality
 const auto OptionChangeResampler = (GetOptions().Audio.resampler.SetValueChangedCallback(OptionAudioChanged), true);
 const auto OptionChangeDevice = (GetOptions().Audio.device.SetValueChangedCallback(OptionAudioChanged), true);
 
+#ifndef USE_SDL3
+/** Plays silence to find out when the audio callback runs, for the underrun counter. */
+class AudioCallbackProbe final : public Aulib::Decoder {
+public:
+	auto open([[maybe_unused]] SDL_RWops *rwops) -> bool override
+	{
+		setIsOpen(true);
+		return true;
+	}
+
+	auto getChannels() const -> int override
+	{
+		return Aulib::channelCount();
+	}
+
+	auto getRate() const -> int override
+	{
+		return Aulib::sampleRate();
+	}
+
+	auto rewind() -> bool override
+	{
+		return true;
+	}
+
+	auto duration() const -> std::chrono::microseconds override
+	{
+		return {};
+	}
+
+	auto seekToTime([[maybe_unused]] std::chrono::microseconds pos) -> bool override
+	{
+		return false;
+	}
+
+protected:
+	auto doDecoding(float buf[], int len, bool &callAgain) -> int override
+	{
+		callAgain = false;
+		std::fill_n(buf, len, 0.F);
+		CountAudioCallback(len / std::max(Aulib::channelCount(), 1), Aulib::sampleRate());
+		return len;
+	}
+};
+
+std::unique_ptr<Aulib::Stream> AudioCallbackProbeStream;
+#endif
+
+/** @brief Starts or stops collecting the audio statistics to match the "Show Audio Statistics" option. */
+void UpdateAudioStatsCollection()
+{
+	const bool enabled = gbSndInited && *GetOptions().Audio.showAudioStats;
+	SetAudioStatsEnabled(enabled);
+#ifndef USE_SDL3
+	if (!enabled) {
+		AudioCallbackProbeStream = nullptr;
+		return;
+	}
+	if (AudioCallbackProbeStream != nullptr)
+		return;
+	AudioCallbackProbeStream = std::make_unique<Aulib::Stream>(/*rwops=*/nullptr, std::make_unique<AudioCallbackProbe>(), /*resampler=*/nullptr, /*closeRw=*/false);
+	if (!AudioCallbackProbeStream->open() || !AudioCallbackProbeStream->play()) {
+		LogError(LogCategory::Audio, "Aulib::Stream::open (from UpdateAudioStatsCollection): {}", SDL_GetError());
+		AudioCallbackProbeStream = nullptr;
+	}
+#endif
+}
+
+const auto OptionChangeShowAudioStats = (GetOptions().Audio.showAudioStats.SetValueChangedCallback(UpdateAudioStatsCollection), true);
+
+constexpr size_t PrefetchedCueCount = static_cast<size_t>(PrefetchedCue::COUNT);
+
+struct PrefetchCandidate {
+	std::string_view path;
+	bool isMp3;
+};
+
+// Support both the new "playerhaslowhp" name and the older underscore version.
+constexpr PrefetchCandidate PlayerLowHpWarningCandidates[] = {
+	{ "audio\\playerhaslowhp.ogg", false },
+	{ "..\\audio\\playerhaslowhp.ogg", false },
+	{ "audio\\player_has_low_hp.ogg", false },
+	{ "..\\audio\\player_has_low_hp.ogg", false },
+	{ "audio\\playerhaslowhp.mp3", true },
+	{ "..\\audio\\playerhaslowhp.mp3", true },
+	{ "audio\\player_has_low_hp.mp3", true },
+	{ "..\\audio\\player_has_low_hp.mp3", true },
+	{ "audio\\playerhaslowhp.wav", false },
+	{ "..\\audio\\playerhaslowhp.wav", false },
+	{ "audio\\player_has_low_hp.wav", false },
+	{ "..\\audio\\player_has_low_hp.wav", false },
+};
+
+/** Candidate files of each prefetched cue, the first one that decodes is used. */
+constexpr std::array<std::span<const PrefetchCandidate>, PrefetchedCueCount> PrefetchedCueCandidates = {
+	PlayerLowHpWarningCandidates,
+};
+
+struct CuePrefetchState {
+	SdlMutex mutex;
+	/** Decoded by the prefetch thread, taken by the game thread. */
+	std::array<std::shared_ptr<const PcmBuffer>, PrefetchedCueCount> decoded;
+};
+
+std::optional<CuePrefetchState> CuePrefetch;
+SdlThread CuePrefetchThread;
+/** Only touched by the game thread. */
+std::array<std::unique_ptr<TSnd>, PrefetchedCueCount> PrefetchedCueSounds;
+
+std::shared_ptr<const PcmBuffer> DecodeFirstCandidate(std::span<const PrefetchCandidate> candidates)
+{
+	for (const PrefetchCandidate &candidate : candidates) {
+		AssetRef ref = FindAsset(candidate.path);
+		if (!ref.ok())
+			continue;
+
+		const size_t size = ref.size();
+		if (size == 0)
+			continue;
+
+		AssetHandle handle = OpenAsset(std::move(ref), /*threadsafe=*/true);
+		if (!handle.ok())
+			continue;
+
+		std::unique_ptr<std::uint8_t[]> fileData { new std::uint8_t[size] };
+		if (!handle.read(fileData.get(), size))
+			continue;
+
+		std::shared_ptr<const PcmBuffer> pcm = DecodeToPcm(fileData.get(), size, candidate.isMp3);
+		if (pcm != nullptr)
+			return pcm;
+	}
+	return nullptr;
+}
+
+void DecodePrefetchedCues()
+{
+	for (size_t i = 0; i < PrefetchedCueCount; i++) {
+		std::shared_ptr<const PcmBuffer> pcm = DecodeFirstCandidate(PrefetchedCueCandidates[i]);
+		const std::lock_guard<SdlMutex> lock(CuePrefetch->mutex);
+		CuePrefetch->decoded[i] = std::move(pcm);
+	}
+}
+
+/** @brief Waits for the prefetch thread and drops the cues, they are decoded at the current sample rate. */
+void ReleasePrefetchedCueSounds()
+{
+	CuePrefetchThread.join();
+	PrefetchedCueSounds = {};
+	CuePrefetch = std::nullopt;
+}
+
+/** Decoded sounds take about twice the space of their files, this keeps a level's worth of monster sounds. */
+constexpr size_t SoundPrefetchBudget = 16 * 1024 * 1024;
+
+struct PrefetchedSoundFile {
+	std::string path;
+	std::shared_ptr<const PcmBuffer> pcm;
+};
+
+/** Set by the game thread before the prefetch thread starts. */
+std::vector<std::string> SoundPrefetchPaths;
+/** Filled by the prefetch thread, only touched by the game thread once it was joined. */
+std::vector<PrefetchedSoundFile> PrefetchedSoundFiles;
+SdlThread SoundPrefetchThread;
+
+void DecodePrefetchedSoundFiles()
+{
+	size_t decodedBytes = 0;
+	for (const std::string &path : SoundPrefetchPaths) {
+		bool isMp3 = true;
+		AssetRef ref = FindAsset(GetMp3Path(path.c_str()).c_str());
+		if (!ref.ok()) {
+			ref = FindAsset(path);
+			isMp3 = false;
+		}
+		if (!ref.ok())
+			continue;
+
+		const size_t size = ref.size();
+#ifdef STREAM_ALL_AUDIO_MIN_FILE_SIZE
+		// Leave the sounds that are streamed to LoadAudioFile().
+		if (size >= STREAM_ALL_AUDIO_MIN_FILE_SIZE)
+			continue;
+#endif
+		if (size == 0)
+			continue;
+
+		AssetHandle handle = OpenAsset(std::move(ref), /*threadsafe=*/true);
+		if (!handle.ok())
+			continue;
+
+		std::unique_ptr<std::uint8_t[]> fileData { new std::uint8_t[size] };
+		if (!handle.read(fileData.get(), size))
+			continue;
+
+		std::shared_ptr<const PcmBuffer> pcm = DecodeToPcm(fileData.get(), size, isMp3);
+		if (pcm == nullptr)
+			continue;
+		decodedBytes += pcm->samples.size() * sizeof(float);
+		if (decodedBytes > SoundPrefetchBudget)
+			break;
+		PrefetchedSoundFiles.push_back({ path, std::move(pcm) });
+	}
+}
+
+[[nodiscard]] std::shared_ptr<const PcmBuffer> TakePrefetchedSoundFile(std::string_view path)
+{
+	if (std::find(SoundPrefetchPaths.begin(), SoundPrefetchPaths.end(), path) == SoundPrefetchPaths.end())
+		return nullptr;
+	SoundPrefetchThread.join();
+	const auto it = std::find_if(PrefetchedSoundFiles.begin(), PrefetchedSoundFiles.end(), [path](const PrefetchedSoundFile &file) { return file.path == path; });
+	if (it == PrefetchedSoundFiles.end())
+		return nullptr;
+	std::shared_ptr<const PcmBuffer> pcm = std::move(it->pcm);
+	PrefetchedSoundFiles.erase(it);
+	return pcm;
+}
+
 } // namespace
 
 void ClearDuplicateSounds()
@@ -225,6 +453,8 @@ tl::expected<std::unique_ptr<TSnd>, std::string> SoundFileLoadWithStatus(const c
 	auto snd = std::make_unique<TSnd>();
 	snd->start_tc = SDL_GetTicks() - 80 - 1;
 #ifndef NOSOUND
+	if (std::shared_ptr<const PcmBuffer> pcm = stream ? nullptr : TakePrefetchedSoundFile(path); pcm != nullptr && snd->DSB.SetPcm(std::move(pcm)) == 0)
+		return snd;
 	RETURN_IF_ERROR(LoadAudioFile(path, stream, snd->DSB));
 #endif
 	return snd;
@@ -281,22 +511,30 @@ void snd_init()
 
 	duplicateSoundsMutex.emplace();
 	gbSndInited = true;
+	UpdateAudioStatsCollection();
 }
 
 void snd_deinit()
 {
 	if (gbSndInited) {
 		SoundPool::Get().Clear();
+		ReleasePrefetchedCueSounds();
+		ReleasePrefetchedSoundFiles();
+#ifndef USE_SDL3
+		AudioCallbackProbeStream = nullptr;
+#endif
 #ifdef USE_SDL3
 		const AudioOptions &audioOptions = GetOptions().Audio;
 		SDL_CloseAudioDevice(audioOptions.device.id());
 #else
+		StopStreamDecoding();
 		Aulib::quit();
 #endif
 		duplicateSoundsMutex = std::nullopt;
 	}
 
 	gbSndInited = false;
+	SetAudioStatsEnabled(false);
 }
 
 _music_id GetLevelMusic(dungeon_type dungeonType)
@@ -414,4 +652,65 @@ void music_unmute()
 		music.Unmute();
 }
 
+void PrefetchCueSounds()
+{
+	if (!gbSndInited || CuePrefetch)
+		return;
+
+	CuePrefetch.emplace();
+#ifdef __DJGPP__
+	// No threads, decode right away.
+	DecodePrefetchedCues();
+#else
+	CuePrefetchThread = SdlThread { DecodePrefetchedCues };
+#endif
+}
+
+TSnd *GetPrefetchedCueSound(PrefetchedCue cue)
+{
+	const size_t index = static_cast<size_t>(cue);
+	if (PrefetchedCueSounds[index] != nullptr)
+		return PrefetchedCueSounds[index].get();
+
+	// Audio may have been restarted since the last level load.
+	if (!CuePrefetch) {
+		PrefetchCueSounds();
+		return nullptr;
+	}
+
+	std::shared_ptr<const PcmBuffer> pcm;
+	{
+		const std::lock_guard<SdlMutex> lock(CuePrefetch->mutex);
+		pcm = std::move(CuePrefetch->decoded[index]);
+	}
+	if (pcm == nullptr)
+		return nullptr;
+
+	auto snd = std::make_unique<TSnd>();
+	snd->start_tc = SDL_GetTicks() - 80 - 1;
+	if (snd->DSB.SetPcm(std::move(pcm)) != 0)
+		return nullptr;
+	PrefetchedCueSounds[index] = std::move(snd);
+	return PrefetchedCueSounds[index].get();
+}
+
+void PrefetchSoundFiles(std::vector<std::string> paths)
+{
+	ReleasePrefetchedSoundFiles();
+#ifndef __DJGPP__
+	if (!gbSndInited || paths.empty())
+		return;
+
+	SoundPrefetchPaths = std::move(paths);
+	SoundPrefetchThread = SdlThread { DecodePrefetchedSoundFiles };
+#endif
+}
+
+void ReleasePrefetchedSoundFiles()
+{
+	SoundPrefetchThread.join();
+	PrefetchedSoundFiles.clear();
+	SoundPrefetchPaths.clear();
+}
+
 } // namespace devilution
@@ -8,6 +8,7 @@
 #include <cstdint>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include <expected.hpp>
 
@@ -78,6 +79,31 @@ int sound_get_or_set_sound_volume(int volume);
 int sound_get_or_set_audio_cues_volume(int volume);
 void music_mute();
 void music_unmute();
+
+/** Cues that are decoded into memory ahead of time, so playing them for the first time never reads from disk. */
+enum class PrefetchedCue : uint8_t {
+	PlayerLowHpWarning,
+	COUNT,
+};
+
+/** @brief Starts decoding the prefetched cues on a background thread, unless that already happened. */
+void PrefetchCueSounds();
+
+/**
+ * @brief Returns a prefetched cue without blocking.
+ * @return nullptr while the cue is still being decoded or if none of its files could be decoded
+ */
+TSnd *GetPrefetchedCueSound(PrefetchedCue cue);
+
+/**
+ * @brief Starts reading and decoding sound files on a background thread, SoundFileLoadWithStatus() takes them from there.
+ *
+ * Sounds that are streamed, and the ones beyond the memory budget, are still loaded by SoundFileLoadWithStatus().
+ */
+void PrefetchSoundFiles(std::vector<std::string> paths);
+
+/** @brief Waits for the prefetch and drops the sounds that were not loaded, has to happen before the archives are closed. */
+void ReleasePrefetchedSoundFiles();
 
 /* data */
 
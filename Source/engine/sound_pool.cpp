@@ -2,9 +2,9 @@
 
 #include <algorithm>
 #include <array>
-#include <cassert>
 #include <cctype>
 #include <cstddef>
+#include <memory>
 #include <optional>
 
 #ifdef USE_SDL3
@@ -14,21 +14,22 @@
 #endif
 
 #include "engine/assets.hpp"
+#include "engine/audio_stats.hpp"
+#include "engine/cue_voice.hpp"
 #include "engine/sound.h"
 #include "engine/sound_position.hpp"
-#include "utils/stdcompat/shared_ptr_array.hpp"
+#include "options.h"
+#include "utils/soundsample.h"
 
 namespace devilution {
 
 namespace {
 
-constexpr size_t MaxEmitters = 3;
 constexpr size_t SoundIdCount = static_cast<size_t>(SoundPool::SoundId::COUNT);
 
 struct CachedSoundData {
-	ArraySharedPtr<std::uint8_t> data;
-	size_t size;
-	bool isMp3;
+	// Decoded once, every voice plays from the same buffer.
+	std::shared_ptr<const PcmBuffer> pcm;
 };
 
 [[nodiscard]] size_t ToIndex(SoundPool::SoundId id)
@@ -54,67 +55,73 @@ struct CachedSoundData {
 } // namespace
 
 struct SoundPool::Impl {
-	struct ActiveEmitter {
-		uint32_t emitterId;
-		SoundId sound;
-		SoundSample sample;
-		uint32_t lastPlayMs;
+	struct Voice {
+		CueVoice cue;
+		std::optional<uint32_t> emitterId;
+		SoundId sound = SoundId::COUNT;
+		// What the cue was last told to play, so unchanged emitters send no commands.
+		uint32_t intervalMs = 0;
+		CuePlacement placement {};
 	};
 
 	std::array<std::optional<CachedSoundData>, SoundIdCount> cachedSounds;
-	std::array<std::optional<ActiveEmitter>, MaxEmitters> activeEmitters;
+	std::array<bool, SoundIdCount> resolvedSounds {};
+	std::array<Voice, MaxVoices> voices;
+	/** Voices [0, openVoices) have their stream running. */
+	size_t openVoices = 0;
 
-	std::optional<SoundId> oneShotSoundId;
-	SoundSample oneShotSample;
+	CueVoice oneShotVoice;
 
-	void StopEmitter(ActiveEmitter &emitter)
+	void StopVoice(Voice &voice)
 	{
-		if (emitter.sample.IsLoaded())
-			emitter.sample.Stop();
-		emitter.sample.Release();
+		voice.cue.Stop();
+		voice.emitterId = std::nullopt;
+		voice.sound = SoundId::COUNT;
 	}
 
-	void StopOneShot()
+	void StopAllEmitters()
 	{
-		if (oneShotSample.IsLoaded())
-			oneShotSample.Stop();
-		oneShotSample.Release();
-		oneShotSoundId = std::nullopt;
+		for (Voice &voice : voices) {
+			if (voice.emitterId)
+				StopVoice(voice);
+		}
 	}
 
-	void StopAllEmitters()
+	/** @brief Starts the streams of voices [begin, end). */
+	void OpenVoices(size_t begin, size_t end)
 	{
-		for (auto &slot : activeEmitters) {
-			if (!slot)
-				continue;
-			StopEmitter(*slot);
-			slot = std::nullopt;
+		for (size_t i = begin; i < end; i++)
+			(void)voices[i].cue.Open();
+	}
+
+	void CloseVoices()
+	{
+		for (Voice &voice : voices) {
+			voice.cue.Close();
+			voice.emitterId = std::nullopt;
+			voice.sound = SoundId::COUNT;
 		}
+		openVoices = 0;
+		oneShotVoice.Close();
 	}
 
-	[[nodiscard]] bool EnsureSampleLoaded(SoundSample &sample, SoundId id)
+	[[nodiscard]] const PcmBuffer *GetPcm(SoundId id) const
 	{
 		const std::optional<CachedSoundData> &cached = cachedSounds[ToIndex(id)];
-		if (!cached)
-			return false;
-
-		const int error = sample.SetChunk(cached->data, cached->size, cached->isMp3);
-		return error == 0;
+		return cached ? cached->pcm.get() : nullptr;
 	}
 
-	[[nodiscard]] bool PlaySampleAt(SoundSample &sample, Point position)
+	/** @brief Where a cue at `position` is heard from, muted if it is out of range. */
+	[[nodiscard]] static CuePlacement GetPlacement(Point position, int attenuation = 0)
 	{
-		if (!sample.IsLoaded())
-			return false;
-
+		CuePlacement placement { .logVolume = ATTENUATION_MIN, .logPan = 0, .binaural = false, .lateral = 0, .rear = 0 };
 		int logVolume = 0;
 		int logPan = 0;
 		if (!CalculateSoundPosition(position, &logVolume, &logPan))
-			return false;
-
-		// Restart to keep tempo readable.
-		if (sample.IsPlaying())
-			sample.Stop();
+			return placement;
+		logVolume += attenuation;
+		if (logVolume <= ATTENUATION_MIN)
+			return placement;
 
 		const int soundVolume = sound_get_or_set_sound_volume(/*volume=*/1);
 		const int cuesVolume = sound_get_or_set_audio_cues_volume(/*volume=*/1);
@@ -125,7 +132,16 @@ struct SoundPool::Impl {
 		const int combinedOffset = (soundOffset * cuesOffset + range / 2) / range;
 		const int combinedVolume = VOLUME_MIN + combinedOffset;
 
-		return sample.PlayWithVolumeAndPan(logVolume, combinedVolume, logPan);
+		// Same scaling as SoundSample::PlayWithVolumeAndPan.
+		placement.logVolume = std::max(logVolume + (combinedVolume * (ATTENUATION_MIN / VOLUME_MIN)), ATTENUATION_MIN);
+		placement.logPan = logPan;
+
+		// A binaural cue places itself between the ears, panning it as well would overdo the effect.
+		if (*GetOptions().Audio.binauralAudioCues) {
+			placement.binaural = true;
+			CalculateSoundDirection(position, &placement.lateral, &placement.rear);
+		}
+		return placement;
 	}
 };
 
@@ -147,12 +163,13 @@ void SoundPool::Clear()
 	if (impl_ == nullptr)
 		return;
 
-	impl_->StopAllEmitters();
-	impl_->StopOneShot();
+	// The voices point into the cached sounds, so they go first.
+	impl_->CloseVoices();
 	impl_->cachedSounds = {};
+	impl_->resolvedSounds = {};
 }
 
-bool SoundPool::EnsureLoaded(SoundId id, std::initializer_list<std::string_view> candidatePaths)
+bool SoundPool::EnsureLoaded(SoundId id, std::span<const std::string_view> candidatePaths)
 {
 	if (impl_ == nullptr)
 		return false;
@@ -160,8 +177,9 @@ bool SoundPool::EnsureLoaded(SoundId id, std::initializer_list<std::string_view>
 		return false;
 
 	std::optional<CachedSoundData> &cached = impl_->cachedSounds[ToIndex(id)];
-	if (cached)
-		return true;
+	if (impl_->resolvedSounds[ToIndex(id)])
+		return cached.has_value();
+	impl_->resolvedSounds[ToIndex(id)] = true;
 
 	// Match the old proximity-audio behavior: try multiple file types/paths and keep the first one
 	// that successfully decodes in the current audio pipeline. This avoids caching an asset we can
@@ -179,16 +197,15 @@ bool SoundPool::EnsureLoaded(SoundId id, std::initializer_list<std::string_view>
 		if (!handle.ok())
 			continue;
 
-		auto fileData = MakeArraySharedPtr<std::uint8_t>(size);
+		std::unique_ptr<std::uint8_t[]> fileData { new std::uint8_t[size] };
 		if (!handle.read(fileData.get(), size))
 			continue;
 
-		const bool isMp3 = IsMp3Path(path);
-		SoundSample testSample;
-		if (testSample.SetChunk(fileData, size, isMp3) != 0)
+		std::shared_ptr<const PcmBuffer> pcm = DecodeToPcm(fileData.get(), size, IsMp3Path(path));
+		if (pcm == nullptr)
 			continue;
 
-		cached = CachedSoundData { .data = std::move(fileData), .size = size, .isMp3 = isMp3 };
+		cached = CachedSoundData { .pcm = std::move(pcm) };
 		return true;
 	}
 
@@ -205,82 +222,130 @@ bool SoundPool::IsLoaded(SoundId id) const
 	return impl_->cachedSounds[ToIndex(id)].has_value();
 }
 
+bool SoundPool::IsResolved(SoundId id) const
+{
+	if (impl_ == nullptr)
+		return true;
+	if (id == SoundId::COUNT)
+		return true;
+
+	return impl_->resolvedSounds[ToIndex(id)];
+}
+
+size_t SoundPool::VoiceCount() const
+{
+	return std::clamp<size_t>(*GetOptions().Audio.audioCueVoices, 1, MaxVoices);
+}
+
+size_t SoundPool::ActiveVoiceCount() const
+{
+	if (impl_ == nullptr)
+		return 0;
+	return static_cast<size_t>(std::count_if(impl_->voices.begin(), impl_->voices.end(), [](const Impl::Voice &voice) { return voice.emitterId.has_value(); }));
+}
+
+size_t SoundPool::MemoryUsage() const
+{
+	if (impl_ == nullptr)
+		return 0;
+	size_t bytes = 0;
+	for (const std::optional<CachedSoundData> &cached : impl_->cachedSounds) {
+		if (cached && cached->pcm != nullptr)
+			bytes += cached->pcm->samples.capacity() * sizeof(float);
+	}
+	return bytes;
+}
+
 void SoundPool::UpdateEmitters(std::span<const EmitterRequest> emitters, uint32_t nowMs)
 {
 	if (impl_ == nullptr)
 		return;
 
+	const ScopedAudioStatsTimer timer(AudioStatsTimer::SoundPool);
+
 	if (!gbSndInited || !gbSoundOn) {
 		impl_->StopAllEmitters();
 		return;
 	}
 
-	assert(emitters.size() <= MaxEmitters);
-
-	const auto isRequested = [&emitters](uint32_t emitterId) {
-		for (const auto &req : emitters) {
-			if (req.emitterId == emitterId)
-				return true;
-		}
-		return false;
-	};
+	const size_t voiceCount = VoiceCount();
+	if (voiceCount > impl_->openVoices) {
+		impl_->OpenVoices(impl_->openVoices, voiceCount);
+		impl_->openVoices = voiceCount;
+	}
 
-	for (auto &slot : impl_->activeEmitters) {
-		if (!slot)
-			continue;
-		if (isRequested(slot->emitterId))
+	// Keep the most important emitters, sorted by priority, one per voice.
+	std::array<const EmitterRequest *, MaxVoices> winners;
+	size_t winnerCount = 0;
+	for (const EmitterRequest &req : emitters) {
+		size_t insertAt = winnerCount;
+		while (insertAt > 0 && req.priority < winners[insertAt - 1]->priority)
+			insertAt--;
+		if (insertAt >= voiceCount)
 			continue;
-		impl_->StopEmitter(*slot);
-		slot = std::nullopt;
+		if (winnerCount < voiceCount)
+			winnerCount++;
+		for (size_t i = winnerCount - 1; i > insertAt; i--)
+			winners[i] = winners[i - 1];
+		winners[insertAt] = &req;
 	}
 
-	for (const auto &req : emitters) {
-		std::optional<size_t> slotIndex;
-		for (size_t i = 0; i < impl_->activeEmitters.size(); ++i) {
-			if (impl_->activeEmitters[i] && impl_->activeEmitters[i]->emitterId == req.emitterId) {
-				slotIndex = i;
-				break;
-			}
-		}
-
-		bool isNew = false;
-		if (!slotIndex) {
-			for (size_t i = 0; i < impl_->activeEmitters.size(); ++i) {
-				if (!impl_->activeEmitters[i]) {
-					impl_->activeEmitters[i].emplace();
-					impl_->activeEmitters[i]->emitterId = req.emitterId;
-					impl_->activeEmitters[i]->sound = SoundId::COUNT;
-					impl_->activeEmitters[i]->lastPlayMs = nowMs;
-					impl_->activeEmitters[i]->sample.Release();
-					slotIndex = i;
-					isNew = true;
+	// Voices past the limit and voices whose emitter lost its place are freed (stolen) first.
+	std::array<std::optional<size_t>, MaxVoices> voiceOfWinner;
+	for (size_t v = 0; v < MaxVoices; v++) {
+		Impl::Voice &voice = impl_->voices[v];
+		if (!voice.emitterId)
+			continue;
+		std::optional<size_t> winner;
+		if (v < voiceCount) {
+			for (size_t w = 0; w < winnerCount; w++) {
+				if (winners[w]->emitterId == *voice.emitterId) {
+					winner = w;
 					break;
 				}
 			}
 		}
-
-		if (!slotIndex)
+		if (!winner) {
+			impl_->StopVoice(voice);
 			continue;
+		}
+		voiceOfWinner[*winner] = v;
+	}
 
-		Impl::ActiveEmitter &active = *impl_->activeEmitters[*slotIndex];
+	// The voices repeat their cues on their own, they only hear about changes.
+	(void)nowMs;
+	size_t nextFreeVoice = 0;
+	for (size_t w = 0; w < winnerCount; w++) {
+		const EmitterRequest &req = *winners[w];
+		const PcmBuffer *pcm = impl_->GetPcm(req.sound);
+
+		if (!voiceOfWinner[w]) {
+			while (impl_->voices[nextFreeVoice].emitterId)
+				nextFreeVoice++;
+			voiceOfWinner[w] = nextFreeVoice;
+		}
 
-		if (active.sound != req.sound || !active.sample.IsLoaded()) {
-			active.sample.Release();
-			active.sound = req.sound;
-			if (!impl_->EnsureSampleLoaded(active.sample, req.sound)) {
-				impl_->StopEmitter(active);
-				impl_->activeEmitters[*slotIndex] = std::nullopt;
+		Impl::Voice &voice = impl_->voices[*voiceOfWinner[w]];
+		const CuePlacement placement = Impl::GetPlacement(req.position, req.attenuation);
+		if (!voice.emitterId) {
+			if (pcm == nullptr)
+				continue;
+			voice.cue.Play(*pcm, req.intervalMs, placement);
+		} else if (voice.sound != req.sound || voice.intervalMs != req.intervalMs || voice.placement != placement) {
+			if (pcm == nullptr) {
+				impl_->StopVoice(voice);
 				continue;
 			}
+			voice.cue.Update(*pcm, req.intervalMs, placement);
 		}
-
-		const bool shouldPlay = isNew || (req.intervalMs != 0 && nowMs - active.lastPlayMs >= req.intervalMs);
-		if (!shouldPlay)
-			continue;
-
-		if (impl_->PlaySampleAt(active.sample, req.position))
-			active.lastPlayMs = nowMs;
+		voice.emitterId = req.emitterId;
+		voice.sound = req.sound;
+		voice.intervalMs = req.intervalMs;
+		voice.placement = placement;
 	}
+
+	if (IsAudioStatsEnabled())
+		SetActiveAudioVoices(static_cast<uint32_t>(ActiveVoiceCount()));
 }
 
 void SoundPool::PlayOneShot(SoundId id, Point position, bool stopEmitters, uint32_t nowMs)
@@ -290,21 +355,21 @@ void SoundPool::PlayOneShot(SoundId id, Point position, bool stopEmitters, uint3
 
 	if (!gbSndInited || !gbSoundOn)
 		return;
+	if (id == SoundId::COUNT)
+		return;
 
 	if (stopEmitters)
 		impl_->StopAllEmitters();
 
-	if (impl_->oneShotSoundId != id || !impl_->oneShotSample.IsLoaded()) {
-		impl_->oneShotSample.Release();
-		impl_->oneShotSoundId = id;
-		if (!impl_->EnsureSampleLoaded(impl_->oneShotSample, id)) {
-			impl_->StopOneShot();
-			return;
-		}
-	}
+	const PcmBuffer *pcm = impl_->GetPcm(id);
+	if (pcm == nullptr)
+		return;
+	if (!impl_->oneShotVoice.IsOpen() && !impl_->oneShotVoice.Open())
+		return;
 
 	(void)nowMs;
-	impl_->PlaySampleAt(impl_->oneShotSample, position);
+	// Restarts a one-shot that is still playing to keep the tempo readable.
+	impl_->oneShotVoice.Play(*pcm, /*intervalMs=*/0, Impl::GetPlacement(position));
 }
 
 } // namespace devilution
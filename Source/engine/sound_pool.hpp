@@ -1,7 +1,7 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
-#include <initializer_list>
 #include <memory>
 #include <span>
 #include <string_view>
@@ -26,11 +26,18 @@ public:
 		COUNT,
 	};
 
+	/** Most emitters that can play at once, the "Audio Cue Voices" option picks how many are used. */
+	static constexpr size_t MaxVoices = 16;
+
 	struct EmitterRequest {
 		uint32_t emitterId;
 		SoundId sound;
 		Point position;
 		uint32_t intervalMs;
+		/** Emitters with a lower value win a voice first, e.g. the distance to the player. */
+		int priority;
+		/** Added to the distance based volume, e.g. for emitters behind walls. Same scale as ATTENUATION_MIN. */
+		int attenuation;
 	};
 
 	static SoundPool &Get();
@@ -40,12 +47,35 @@ public:
 
 	void Clear();
 
-	[[nodiscard]] bool EnsureLoaded(SoundId id, std::initializer_list<std::string_view> candidatePaths);
+	/**
+	 * @brief Loads the first candidate that can be decoded.
+	 *
+	 * The candidates are only probed once until the next Clear(), a sound that can't be found stays
+	 * unloaded instead of being searched for again.
+	 */
+	[[nodiscard]] bool EnsureLoaded(SoundId id, std::span<const std::string_view> candidatePaths);
 	[[nodiscard]] bool IsLoaded(SoundId id) const;
+	/** @brief Whether EnsureLoaded has already run for the sound since the last Clear(). */
+	[[nodiscard]] bool IsResolved(SoundId id) const;
+
+	/** @brief The number of voices emitters currently share, from the "Audio Cue Voices" option. */
+	[[nodiscard]] size_t VoiceCount() const;
+
+	/** @brief The number of voices playing an emitter right now. */
+	[[nodiscard]] size_t ActiveVoiceCount() const;
+
+	/** @brief Bytes held by the decoded sounds. */
+	[[nodiscard]] size_t MemoryUsage() const;
 
+	/**
+	 * @brief Plays the requested emitters on the available voices.
+	 *
+	 * If more emitters are requested than there are voices, the ones with the lowest priority value
+	 * keep playing and any voice still held by a less important emitter is stolen.
+	 */
 	void UpdateEmitters(std::span<const EmitterRequest> emitters, uint32_t nowMs);
 
-	// For one-shot navigation cues (not counted in the 3 emitter limit).
+	// For one-shot navigation cues (not counted in the voice limit).
 	void PlayOneShot(SoundId id, Point position, bool stopEmitters, uint32_t nowMs);
 
 private:
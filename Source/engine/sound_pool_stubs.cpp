@@ -23,7 +23,7 @@ void SoundPool::Clear()
 {
 }
 
-bool SoundPool::EnsureLoaded(SoundId id, std::initializer_list<std::string_view> candidatePaths)
+bool SoundPool::EnsureLoaded(SoundId id, std::span<const std::string_view> candidatePaths)
 {
 	(void)id;
 	(void)candidatePaths;
@@ -36,6 +36,27 @@ bool SoundPool::IsLoaded(SoundId id) const
 	return false;
 }
 
+bool SoundPool::IsResolved(SoundId id) const
+{
+	(void)id;
+	return true;
+}
+
+size_t SoundPool::VoiceCount() const
+{
+	return 0;
+}
+
+size_t SoundPool::ActiveVoiceCount() const
+{
+	return 0;
+}
+
+size_t SoundPool::MemoryUsage() const
+{
+	return 0;
+}
+
 void SoundPool::UpdateEmitters(std::span<const EmitterRequest> emitters, uint32_t nowMs)
 {
 	(void)emitters;
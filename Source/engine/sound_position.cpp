@@ -1,5 +1,8 @@
 #include "engine/sound_position.hpp"
 
+#include <algorithm>
+#include <cmath>
+
 #include "engine/sound_defs.hpp"
 #include "player.h"
 
@@ -23,4 +26,23 @@ bool CalculateSoundPosition(Point soundPosition, int *plVolume, int *plPan)
 	return true;
 }
 
+void CalculateSoundDirection(Point soundPosition, float *lateral, float *rear)
+{
+	const Point playerPosition { MyPlayer->position.tile };
+	const Displacement delta = soundPosition - playerPosition;
+
+	// Screen offset of the tile, isometric tiles are twice as wide as they are high.
+	const float screenX = static_cast<float>(delta.deltaX - delta.deltaY) * 2;
+	const float screenY = static_cast<float>(delta.deltaX + delta.deltaY);
+	const float length = std::hypot(screenX, screenY);
+	if (length == 0) {
+		*lateral = 0;
+		*rear = 0;
+		return;
+	}
+
+	*lateral = screenX / length;
+	*rear = std::max(screenY / length, 0.F);
+}
+
 } // namespace devilution
@@ -6,4 +6,11 @@ namespace devilution {
 
 bool CalculateSoundPosition(Point soundPosition, int *plVolume, int *plPan);
 
+/**
+ * @brief Direction of a sound as seen on screen from the player.
+ * @param lateral Set from -1 (left) to 1 (right)
+ * @param rear Set from 0 (level with or above the player) to 1 (straight below)
+ */
+void CalculateSoundDirection(Point soundPosition, float *lateral, float *rear);
+
 } // namespace devilution
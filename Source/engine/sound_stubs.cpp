@@ -24,5 +24,9 @@ int sound_get_or_set_audio_cues_volume(int volume) { return 0; }
 void music_mute() { }
 void music_unmute() { }
 _music_id GetLevelMusic(dungeon_type dungeonType) { return TMUSIC_TOWN; }
+void PrefetchCueSounds() { }
+TSnd *GetPrefetchedCueSound(PrefetchedCue cue) { return nullptr; }
+void PrefetchSoundFiles(std::vector<std::string> paths) { }
+void ReleasePrefetchedSoundFiles() { }
 
 } // namespace devilution
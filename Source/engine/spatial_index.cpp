@@ -0,0 +1,182 @@
+/**
+ * @file spatial_index.cpp
+ *
+ * Implementation of the uniform grid spatial index over dungeon tiles.
+ */
+#include "engine/spatial_index.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+namespace devilution {
+
+namespace {
+
+/** Sorts `matches` by id and keeps only the closest match of every id. */
+void RemoveDuplicateMatches(std::vector<SpatialIndex::Match> &matches)
+{
+	std::sort(matches.begin(), matches.end(), [](const SpatialIndex::Match &a, const SpatialIndex::Match &b) {
+		if (a.id != b.id)
+			return a.id < b.id;
+		return a.distance < b.distance;
+	});
+	matches.erase(std::unique(matches.begin(), matches.end(), [](const SpatialIndex::Match &a, const SpatialIndex::Match &b) { return a.id == b.id; }), matches.end());
+}
+
+[[nodiscard]] bool IsCloserMatch(const SpatialIndex::Match &a, const SpatialIndex::Match &b)
+{
+	if (a.distance != b.distance)
+		return a.distance < b.distance;
+	return a.id < b.id;
+}
+
+} // namespace
+
+int SpatialIndex::CellIndexOf(Point position)
+{
+	const int cellX = std::clamp(position.x / CellSize, 0, CellsX - 1);
+	const int cellY = std::clamp(position.y / CellSize, 0, CellsY - 1);
+	return cellX + cellY * CellsX;
+}
+
+void SpatialIndex::Build(std::span<const Entry> entries)
+{
+	cellStart_.fill(0);
+	for (const Entry &entry : entries)
+		cellStart_[CellIndexOf(entry.position) + 1]++;
+	for (size_t i = 1; i < cellStart_.size(); i++)
+		cellStart_[i] += cellStart_[i - 1];
+
+	std::array<uint32_t, CellsX * CellsY> next;
+	std::copy_n(cellStart_.begin(), next.size(), next.begin());
+	entries_.resize(entries.size());
+	for (const Entry &entry : entries)
+		entries_[next[CellIndexOf(entry.position)]++] = entry;
+	generation_++;
+}
+
+void SpatialIndex::Clear()
+{
+	entries_.clear();
+	cellStart_.fill(0);
+	generation_++;
+}
+
+void SpatialIndex::ForEachEntryInSquare(Point center, int radius, tl::function_ref<void(const Entry &)> visitor) const
+{
+	if (radius < 0 || entries_.empty())
+		return;
+
+	const int minCellX = std::clamp((center.x - radius) / CellSize, 0, CellsX - 1);
+	const int maxCellX = std::clamp((center.x + radius) / CellSize, 0, CellsX - 1);
+	const int minCellY = std::clamp((center.y - radius) / CellSize, 0, CellsY - 1);
+	const int maxCellY = std::clamp((center.y + radius) / CellSize, 0, CellsY - 1);
+
+	for (int cellY = minCellY; cellY <= maxCellY; cellY++) {
+		for (int cellX = minCellX; cellX <= maxCellX; cellX++) {
+			const int cell = cellX + cellY * CellsX;
+			for (uint32_t i = cellStart_[cell]; i < cellStart_[cell + 1]; i++)
+				visitor(entries_[i]);
+		}
+	}
+}
+
+void SpatialIndex::ForEachInRadius(Point center, int radius, tl::function_ref<void(const Match &)> visitor) const
+{
+	std::vector<Match> matches;
+	ForEachEntryInSquare(center, radius, [&](const Entry &entry) {
+		const int distance = center.WalkingDistance(entry.position);
+		if (distance <= radius)
+			matches.push_back({ entry.id, distance });
+	});
+
+	RemoveDuplicateMatches(matches);
+	for (const Match &match : matches)
+		visitor(match);
+}
+
+std::vector<SpatialIndex::Match> SpatialIndex::FindNearest(Point center, size_t count, tl::function_ref<bool(int id)> accept) const
+{
+	std::vector<Match> matches;
+	if (count == 0 || entries_.empty())
+		return matches;
+
+	const int centerCellX = std::clamp(center.x / CellSize, 0, CellsX - 1);
+	const int centerCellY = std::clamp(center.y / CellSize, 0, CellsY - 1);
+	const int maxRing = std::max({ centerCellX, CellsX - 1 - centerCellX, centerCellY, CellsY - 1 - centerCellY });
+
+	for (int ring = 0; ring <= maxRing; ring++) {
+		for (int cellY = centerCellY - ring; cellY <= centerCellY + ring; cellY++) {
+			if (cellY < 0 || cellY >= CellsY)
+				continue;
+			const bool isEdgeRow = cellY == centerCellY - ring || cellY == centerCellY + ring;
+			const int step = isEdgeRow || ring == 0 ? 1 : 2 * ring;
+			for (int cellX = centerCellX - ring; cellX <= centerCellX + ring; cellX += step) {
+				if (cellX < 0 || cellX >= CellsX)
+					continue;
+				const int cell = cellX + cellY * CellsX;
+				for (uint32_t i = cellStart_[cell]; i < cellStart_[cell + 1]; i++) {
+					const Entry &entry = entries_[i];
+					if (accept(entry.id))
+						matches.push_back({ entry.id, center.WalkingDistance(entry.position) });
+				}
+			}
+		}
+
+		RemoveDuplicateMatches(matches);
+		if (matches.size() < count)
+			continue;
+
+		// Anything in the next ring is at least this far away from the center.
+		const int nextRingDistance = ring * CellSize + 1;
+		std::nth_element(matches.begin(), matches.begin() + (count - 1), matches.end(), IsCloserMatch);
+		if (matches[count - 1].distance < nextRingDistance)
+			break;
+	}
+
+	std::sort(matches.begin(), matches.end(), IsCloserMatch);
+	if (matches.size() > count)
+		matches.resize(count);
+	return matches;
+}
+
+std::optional<SpatialIndex::Match> SpatialIndex::FindNearest(Point center, tl::function_ref<bool(int id)> accept) const
+{
+	const std::vector<Match> matches = FindNearest(center, 1, accept);
+	if (matches.empty())
+		return std::nullopt;
+	return matches.front();
+}
+
+bool RadiusWatch::Update(const SpatialIndex &index, Point center)
+{
+	entered_.clear();
+	left_.clear();
+	if (index_ == &index && generation_ == index.generation() && center_ == center)
+		return false;
+
+	index_ = &index;
+	generation_ = index.generation();
+	center_ = center;
+
+	std::swap(previous_, inRange_);
+	inRange_.clear();
+	index.ForEachInRadius(center, radius_, [&](const SpatialIndex::Match &match) { inRange_.push_back(match.id); });
+	std::sort(inRange_.begin(), inRange_.end());
+
+	std::set_difference(inRange_.begin(), inRange_.end(), previous_.begin(), previous_.end(), std::back_inserter(entered_));
+	std::set_difference(previous_.begin(), previous_.end(), inRange_.begin(), inRange_.end(), std::back_inserter(left_));
+	return !entered_.empty() || !left_.empty();
+}
+
+void RadiusWatch::Reset()
+{
+	index_ = nullptr;
+	inRange_.clear();
+	previous_.clear();
+	entered_.clear();
+	left_.clear();
+}
+
+} // namespace devilution
@@ -0,0 +1,148 @@
+/**
+ * @file spatial_index.hpp
+ *
+ * Interface of the uniform grid spatial index over dungeon tiles.
+ */
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include <function_ref.hpp>
+
+#include "engine/point.hpp"
+#include "levels/gendung_defs.hpp"
+
+namespace devilution {
+
+/**
+ * @brief Buckets entities by dungeon position so that nearby ones can be found without scanning the whole map.
+ *
+ * The level is split into square cells of `CellSize` tiles. Entries are stored contiguously, sorted by cell,
+ * so rebuilding the index is a single counting sort over the entity list.
+ *
+ * An entity may be added with several positions (e.g. objects covering more than one tile), queries report
+ * each id once with the distance of its closest position. Distances are tile walking distances (Chebyshev).
+ */
+class SpatialIndex {
+public:
+	static constexpr int CellSize = 8;
+
+	struct Entry {
+		int id;
+		Point position;
+	};
+
+	struct Match {
+		int id;
+		int distance;
+	};
+
+	/** @brief Replaces the contents of the index with `entries`. */
+	void Build(std::span<const Entry> entries);
+
+	void Clear();
+
+	[[nodiscard]] size_t size() const
+	{
+		return entries_.size();
+	}
+
+	/** @brief Changes whenever the index is rebuilt or cleared, so watchers know their results may be stale. */
+	[[nodiscard]] uint32_t generation() const
+	{
+		return generation_;
+	}
+
+	/**
+	 * @brief Calls `visitor` for every id with a position within `radius` tiles of `center`.
+	 *
+	 * Ids are reported once, with their smallest distance, in no particular order.
+	 */
+	void ForEachInRadius(Point center, int radius, tl::function_ref<void(const Match &)> visitor) const;
+
+	/**
+	 * @brief Finds the up to `count` closest ids accepted by `accept`, closest first (ties broken by id).
+	 */
+	[[nodiscard]] std::vector<Match> FindNearest(Point center, size_t count, tl::function_ref<bool(int id)> accept) const;
+
+	/** @brief Finds the closest id accepted by `accept`. */
+	[[nodiscard]] std::optional<Match> FindNearest(Point center, tl::function_ref<bool(int id)> accept) const;
+
+private:
+	static constexpr int CellsX = (MAXDUNX + CellSize - 1) / CellSize;
+	static constexpr int CellsY = (MAXDUNY + CellSize - 1) / CellSize;
+
+	[[nodiscard]] static int CellIndexOf(Point position);
+
+	/** Visits the entries of all cells overlapping the square of `radius` tiles around `center`. */
+	void ForEachEntryInSquare(Point center, int radius, tl::function_ref<void(const Entry &)> visitor) const;
+
+	/** Entries sorted by cell. The entries of cell `i` are `[cellStart_[i], cellStart_[i + 1])`. */
+	std::vector<Entry> entries_;
+	std::array<uint32_t, CellsX * CellsY + 1> cellStart_ {};
+	uint32_t generation_ = 0;
+};
+
+/**
+ * @brief Tracks which ids of a SpatialIndex are within a radius of a moving center, reporting who entered and left.
+ *
+ * The query only runs again when the center moved or the index was rebuilt, otherwise an update costs a
+ * comparison. Ids are kept sorted so the differences are a single merge.
+ */
+class RadiusWatch {
+public:
+	explicit RadiusWatch(int radius)
+	    : radius_(radius)
+	{
+	}
+
+	/**
+	 * @brief Queries the ids around `center` if anything changed since the last update.
+	 *
+	 * @return Whether any id entered or left the radius.
+	 */
+	bool Update(const SpatialIndex &index, Point center);
+
+	/** @brief Forgets the ids in range, e.g. when leaving the level; the next update reports all of them as entered. */
+	void Reset();
+
+	[[nodiscard]] int radius() const
+	{
+		return radius_;
+	}
+
+	/** The ids within the radius as of the last update, sorted. */
+	[[nodiscard]] std::span<const int> inRange() const
+	{
+		return inRange_;
+	}
+
+	/** The ids that came within the radius in the last update, sorted. */
+	[[nodiscard]] std::span<const int> entered() const
+	{
+		return entered_;
+	}
+
+	/** The ids that went out of the radius in the last update, sorted. */
+	[[nodiscard]] std::span<const int> left() const
+	{
+		return left_;
+	}
+
+private:
+	int radius_;
+	const SpatialIndex *index_ = nullptr;
+	uint32_t generation_ = 0;
+	Point center_ {};
+	std::vector<int> inRange_;
+	std::vector<int> previous_;
+	std::vector<int> entered_;
+	std::vector<int> left_;
+};
+
+} // namespace devilution
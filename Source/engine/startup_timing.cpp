@@ -0,0 +1,111 @@
+/**
+ * @file startup_timing.cpp
+ *
+ * Implementation of the timers that show what each phase of the startup costs.
+ */
+#include "engine/startup_timing.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "utils/log.hpp"
+
+namespace devilution {
+
+namespace {
+
+bool Benchmark = false;
+bool Finished = false;
+std::chrono::steady_clock::time_point Epoch;
+uint8_t Depth = 0;
+std::vector<StartupPhase> Phases;
+
+[[nodiscard]] int64_t MicrosecondsSinceEpoch(std::chrono::steady_clock::time_point time)
+{
+	return std::chrono::duration_cast<std::chrono::microseconds>(time - Epoch).count();
+}
+
+void AppendLine(std::string &report, unsigned indent, std::string_view name, int64_t microseconds)
+{
+	if (!report.empty())
+		report += '\n';
+	fmt::format_to(std::back_inserter(report), "startup: {:{}}{} {:.3f} ms", "", indent, name, static_cast<double>(microseconds) / 1000);
+}
+
+} // namespace
+
+bool IsStartupBenchmark()
+{
+	return Benchmark;
+}
+
+void EnableStartupBenchmark()
+{
+	Benchmark = true;
+}
+
+void BeginStartupTiming()
+{
+	Epoch = std::chrono::steady_clock::now();
+	Phases.reserve(32);
+}
+
+ScopedStartupPhase::ScopedStartupPhase(const char *name)
+    : name_(name)
+    , start_(std::chrono::steady_clock::now())
+    , depth_(Depth)
+    , enabled_(!Finished)
+{
+	if (enabled_)
+		Depth++;
+}
+
+ScopedStartupPhase::~ScopedStartupPhase()
+{
+	if (!enabled_)
+		return;
+	Depth--;
+	if (Finished)
+		return;
+	const int64_t start = MicrosecondsSinceEpoch(start_);
+	Phases.push_back(StartupPhase { name_, depth_, start, MicrosecondsSinceEpoch(std::chrono::steady_clock::now()) - start });
+}
+
+void FinishStartupTiming()
+{
+	if (Finished)
+		return;
+	Finished = true;
+	const int64_t total = MicrosecondsSinceEpoch(std::chrono::steady_clock::now());
+
+	// Phases are recorded when they end, so the inner ones come before the phase around them.
+	std::stable_sort(Phases.begin(), Phases.end(), [](const StartupPhase &a, const StartupPhase &b) {
+		return a.startMicroseconds < b.startMicroseconds;
+	});
+	const std::string report = FormatStartupReport(Phases, total);
+	if (Benchmark)
+		Log("{}", report);
+	else
+		LogVerbose("{}", report);
+	Phases = {};
+}
+
+std::string FormatStartupReport(std::span<const StartupPhase> phases, int64_t totalMicroseconds)
+{
+	std::string report;
+	int64_t timed = 0;
+	for (const StartupPhase &phase : phases) {
+		if (phase.depth == 0)
+			timed += phase.durationMicroseconds;
+		AppendLine(report, phase.depth * 2U, phase.name, phase.durationMicroseconds);
+	}
+	if (totalMicroseconds > timed)
+		AppendLine(report, 0, "other", totalMicroseconds - timed);
+	AppendLine(report, 0, "total", totalMicroseconds);
+	return report;
+}
+
+} // namespace devilution
@@ -0,0 +1,61 @@
+/**
+ * @file startup_timing.hpp
+ *
+ * Interface of the timers that show what each phase of the startup to the main menu costs.
+ */
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <span>
+#include <string>
+
+namespace devilution {
+
+/** A phase of the startup that was entered and left. */
+struct StartupPhase {
+	/** A string literal, so phases never allocate. */
+	const char *name;
+	/** How many phases were running around this one. */
+	uint8_t depth;
+	int64_t startMicroseconds;
+	int64_t durationMicroseconds;
+};
+
+/** @brief Whether the game exits once it reaches the main menu, from the `--startup-benchmark` flag. */
+[[nodiscard]] bool IsStartupBenchmark();
+void EnableStartupBenchmark();
+
+/** @brief Starts the clock the phases are measured against, call first thing on startup. */
+void BeginStartupTiming();
+
+/** @brief Records a startup phase for the time until it goes out of scope. Main thread only. */
+class ScopedStartupPhase {
+public:
+	explicit ScopedStartupPhase(const char *name);
+	~ScopedStartupPhase();
+
+	ScopedStartupPhase(const ScopedStartupPhase &) = delete;
+	ScopedStartupPhase &operator=(const ScopedStartupPhase &) = delete;
+
+private:
+	const char *name_;
+	std::chrono::steady_clock::time_point start_;
+	uint8_t depth_;
+	bool enabled_;
+};
+
+/**
+ * @brief Stops the timing once the main menu is shown and reports the phases.
+ *
+ * The report goes to the log, or to the console with `--startup-benchmark`. Later calls do nothing.
+ */
+void FinishStartupTiming();
+
+/**
+ * @brief The phases in the order they started, one line each.
+ * @param totalMicroseconds Time from BeginStartupTiming() to the main menu
+ */
+[[nodiscard]] std::string FormatStartupReport(std::span<const StartupPhase> phases, int64_t totalMicroseconds);
+
+} // namespace devilution
@@ -0,0 +1,152 @@
+/**
+ * @file tick_timing.cpp
+ *
+ * Implementation of the timers that show what each step of a game tick costs.
+ */
+#include "engine/tick_timing.hpp"
+
+#include <algorithm>
+#include <array>
+
+#include "utils/str_cat.hpp"
+
+namespace devilution {
+
+namespace {
+
+constexpr std::array<std::string_view, TickTimerCount> TickTimerNames {
+	"ProcessPlayers",
+	"AutoWalk",
+	"ProcessMonsters",
+	"ProcessObjects",
+	"ProcessMissiles",
+	"ProcessItems",
+	"LightAndVision",
+	"ProcessTowners",
+	"MonsterHotState",
+	"AccessibilityGather",
+	"LowDurabilityWarnings",
+	"BossHealthAnnouncements",
+	"ProximityAudioCues",
+	"AttackableMonsterAnnouncements",
+	"InteractableDoorAnnouncements",
+	"LowHpWarningSound",
+	"StatChangeAnnouncements",
+	"SoundUpdate",
+};
+
+// Only touched by the game thread.
+bool Enabled = false;
+std::array<std::array<uint32_t, TickTimerCount>, TickTimingHistory> History {};
+/** The entry of the current tick. */
+size_t Current = 0;
+/** How many entries hold a full tick, at most TickTimingHistory - 1 as the current one is still running. */
+size_t Filled = 0;
+/** Whether the current entry belongs to a tick, false right after the timers are enabled. */
+bool Started = false;
+/** Everything since the timers were enabled, for runs longer than the history. */
+std::array<uint64_t, TickTimerCount> TotalMicroseconds {};
+uint64_t TotalTicks = 0;
+
+} // namespace
+
+std::string_view TickTimerName(TickTimer timer)
+{
+	return TickTimerNames[static_cast<size_t>(timer)];
+}
+
+bool IsTickTimingEnabled()
+{
+	return Enabled;
+}
+
+void SetTickTimingEnabled(bool enabled)
+{
+#ifdef DEVILUTIONX_TICK_TIMING
+	History = {};
+	Current = 0;
+	Filled = 0;
+	Started = false;
+	TotalMicroseconds = {};
+	TotalTicks = 0;
+	Enabled = enabled;
+#else
+	(void)enabled;
+#endif
+}
+
+void BeginTickTiming()
+{
+	if (!Enabled)
+		return;
+	if (Started) {
+		Current = (Current + 1) % TickTimingHistory;
+		History[Current] = {};
+		Filled = std::min(Filled + 1, TickTimingHistory - 1);
+	}
+	Started = true;
+	TotalTicks++;
+}
+
+ScopedTickTimer::ScopedTickTimer(TickTimer timer)
+    : timer_(timer)
+    , enabled_(Enabled)
+{
+	if (enabled_)
+		start_ = std::chrono::steady_clock::now();
+}
+
+ScopedTickTimer::~ScopedTickTimer()
+{
+	if (!enabled_ || !Enabled)
+		return;
+	const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start_);
+	History[Current][static_cast<size_t>(timer_)] += static_cast<uint32_t>(elapsed.count());
+	TotalMicroseconds[static_cast<size_t>(timer_)] += static_cast<uint64_t>(elapsed.count());
+}
+
+TickTimerSummary SummarizeTickTimer(TickTimer timer)
+{
+	TickTimerSummary summary;
+	if (Filled == 0)
+		return summary;
+
+	const size_t index = static_cast<size_t>(timer);
+	uint64_t total = 0;
+	for (size_t i = 1; i <= Filled; i++) {
+		const uint32_t microseconds = History[(Current + TickTimingHistory - i) % TickTimingHistory][index];
+		total += microseconds;
+		summary.maxMicroseconds = std::max(summary.maxMicroseconds, microseconds);
+	}
+	summary.lastMicroseconds = History[(Current + TickTimingHistory - 1) % TickTimingHistory][index];
+	summary.averageMicroseconds = static_cast<uint32_t>(total / Filled);
+	return summary;
+}
+
+std::string FormatTickTimings(bool skipIdle)
+{
+	std::string out = StrCat("Tick timings over ", Filled, " ticks (last/avg/max us)");
+	for (size_t i = 0; i < TickTimerCount; i++) {
+		const auto timer = static_cast<TickTimer>(i);
+		const TickTimerSummary summary = SummarizeTickTimer(timer);
+		if (skipIdle && summary.maxMicroseconds == 0)
+			continue;
+		StrAppend(out, "\n", TickTimerName(timer), " ", summary.lastMicroseconds, "/", summary.averageMicroseconds, "/", summary.maxMicroseconds);
+	}
+	return out;
+}
+
+std::string FormatTickTimingTotals()
+{
+	std::string out = StrCat("Tick timings over ", TotalTicks, " ticks (avg/total us)");
+	if (TotalTicks == 0)
+		return out;
+	for (size_t i = 0; i < TickTimerCount; i++) {
+		if (TotalMicroseconds[i] == 0)
+			continue;
+		StrAppend(out, "\n", TickTimerName(static_cast<TickTimer>(i)), " ", TotalMicroseconds[i] / TotalTicks, "/", TotalMicroseconds[i]);
+	}
+	return out;
+}
+
+} // namespace devilution
@@ -0,0 +1,95 @@
+/**
+ * @file tick_timing.hpp
+ *
+ * Interface of the timers that show what each step of a game tick costs.
+ */
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace devilution {
+
+/** The parts of GameLogic() that are timed separately. */
+enum class TickTimer : uint8_t {
+	ProcessPlayers,
+	AutoWalk,
+	ProcessMonsters,
+	ProcessObjects,
+	ProcessMissiles,
+	ProcessItems,
+	LightAndVision,
+	ProcessTowners,
+	MonsterHotState,
+	AccessibilityGather,
+	LowDurabilityWarnings,
+	BossHealthAnnouncements,
+	ProximityAudioCues,
+	AttackableMonsterAnnouncements,
+	InteractableDoorAnnouncements,
+	LowHpWarningSound,
+	StatChangeAnnouncements,
+	SoundUpdate,
+	COUNT,
+};
+
+constexpr size_t TickTimerCount = static_cast<size_t>(TickTimer::COUNT);
+
+/** How many of the last ticks are kept. */
+constexpr size_t TickTimingHistory = 64;
+
+/** A timer over the kept ticks. */
+struct TickTimerSummary {
+	uint32_t lastMicroseconds = 0;
+	uint32_t averageMicroseconds = 0;
+	uint32_t maxMicroseconds = 0;
+};
+
+[[nodiscard]] std::string_view TickTimerName(TickTimer timer);
+
+/** @brief Whether the timers are collected. Always false if the markers are compiled out. */
+[[nodiscard]] bool IsTickTimingEnabled();
+void SetTickTimingEnabled(bool enabled);
+
+/** @brief Starts the next entry of the history, call at the start of each game tick. */
+void BeginTickTiming();
+
+/** @brief Adds the time until it goes out of scope to a timer of the current tick, if enabled. */
+class ScopedTickTimer {
+public:
+	explicit ScopedTickTimer(TickTimer timer);
+	~ScopedTickTimer();
+
+	ScopedTickTimer(const ScopedTickTimer &) = delete;
+	ScopedTickTimer &operator=(const ScopedTickTimer &) = delete;
+
+private:
+	TickTimer timer_;
+	std::chrono::steady_clock::time_point start_;
+	bool enabled_;
+};
+
+[[nodiscard]] TickTimerSummary SummarizeTickTimer(TickTimer timer);
+
+/**
+ * @brief One line per timer with its last, average and largest time over the kept ticks.
+ * @param skipIdle Leave out the timers that have not run in any kept tick
+ */
+[[nodiscard]] std::string FormatTickTimings(bool skipIdle);
+
+/** @brief One line per timer that has run with its average time over all ticks since the timers were enabled. */
+[[nodiscard]] std::string FormatTickTimingTotals();
+
+} // namespace devilution
+
+#ifdef DEVILUTIONX_TICK_TIMING
+#define DVL_TICK_TIMING_CONCAT_(a, b) a##b
+#define DVL_TICK_TIMING_CONCAT(a, b) DVL_TICK_TIMING_CONCAT_(a, b)
+/** Times the rest of the enclosing scope, compiled out unless DEVILUTIONX_TICK_TIMING is set. */
+#define DVL_TICK_TIMER(timer) const ::devilution::ScopedTickTimer DVL_TICK_TIMING_CONCAT(tickTimer, __LINE__)(timer)
+#else
+#define DVL_TICK_TIMER(timer)
+#endif
@@ -0,0 +1,83 @@
+/**
+ * @file tour_planner.cpp
+ *
+ * Implementation of the planner that orders several walk destinations into one short tour.
+ */
+#include "engine/tour_planner.hpp"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace devilution {
+
+namespace {
+
+/** Gives up on improving a tour after this many passes, each pass already tries every reversal. */
+constexpr int MaxImprovementPasses = 16;
+
+} // namespace
+
+std::vector<size_t> PlanTour(size_t stopCount, tl::function_ref<int(size_t from, size_t to)> distance)
+{
+	// Nodes of the tour, the start followed by the stops in visiting order.
+	std::vector<size_t> tour;
+	tour.reserve(stopCount + 1);
+	tour.push_back(0);
+
+	std::vector<bool> visited(stopCount + 1, false);
+	visited[0] = true;
+	for (size_t i = 0; i < stopCount; i++) {
+		const size_t from = tour.back();
+		size_t best = 0;
+		int64_t bestDistance = 0;
+		for (size_t node = 1; node <= stopCount; node++) {
+			if (visited[node])
+				continue;
+			const int64_t nodeDistance = distance(from, node);
+			if (best == 0 || nodeDistance < bestDistance) {
+				best = node;
+				bestDistance = nodeDistance;
+			}
+		}
+		visited[best] = true;
+		tour.push_back(best);
+	}
+
+	// Reversing tour[first..last] replaces the edges into `first` and out of `last`. The tour is
+	// open, so reversing up to the last stop only replaces the edge into `first`.
+	for (int pass = 0; pass < MaxImprovementPasses; pass++) {
+		bool improved = false;
+		for (size_t first = 1; first + 1 < tour.size(); first++) {
+			for (size_t last = first + 1; last < tour.size(); last++) {
+				const bool hasNext = last + 1 < tour.size();
+				const int64_t before = int64_t { distance(tour[first - 1], tour[first]) } + (hasNext ? distance(tour[last], tour[last + 1]) : 0);
+				const int64_t after = int64_t { distance(tour[first - 1], tour[last]) } + (hasNext ? distance(tour[first], tour[last + 1]) : 0);
+				if (after < before) {
+					std::reverse(tour.begin() + static_cast<std::ptrdiff_t>(first), tour.begin() + static_cast<std::ptrdiff_t>(last) + 1);
+					improved = true;
+				}
+			}
+		}
+		if (!improved)
+			break;
+	}
+
+	std::vector<size_t> order;
+	order.reserve(stopCount);
+	for (size_t i = 1; i < tour.size(); i++)
+		order.push_back(tour[i] - 1);
+	return order;
+}
+
+int TourLength(const std::vector<size_t> &order, tl::function_ref<int(size_t from, size_t to)> distance)
+{
+	int length = 0;
+	size_t from = 0;
+	for (const size_t stop : order) {
+		length += distance(from, stop + 1);
+		from = stop + 1;
+	}
+	return length;
+}
+
+} // namespace devilution
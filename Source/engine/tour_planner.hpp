@@ -0,0 +1,32 @@
+/**
+ * @file tour_planner.hpp
+ *
+ * Interface of the planner that orders several walk destinations into one short tour.
+ */
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include <function_ref.hpp>
+
+namespace devilution {
+
+/**
+ * @brief Orders `stopCount` stops so that walking to them one after the other is short.
+ *
+ * The tour starts at node 0 and ends at whichever stop comes last, the stops are nodes 1 to
+ * `stopCount`. It is built greedily from the nearest stop and then improved by reversing parts
+ * of it (2-opt) for as long as that makes it shorter, which is close to the best order for the
+ * handful of stops a player would visit in one go.
+ *
+ * @param distance The walking distance between two nodes. Unreachable pairs should return a cost
+ * larger than any real tour, they are then visited last.
+ * @return The stops in visiting order, as indices from 0 to `stopCount - 1`.
+ */
+[[nodiscard]] std::vector<size_t> PlanTour(size_t stopCount, tl::function_ref<int(size_t from, size_t to)> distance);
+
+/** @brief The length of walking the stops in `order` from node 0, as returned by PlanTour(). */
+[[nodiscard]] int TourLength(const std::vector<size_t> &order, tl::function_ref<int(size_t from, size_t to)> distance);
+
+} // namespace devilution
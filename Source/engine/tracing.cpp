@@ -0,0 +1,130 @@
+/**
+ * @file tracing.cpp
+ *
+ * Implementation of the timeline zones exported in the Chrome trace format.
+ */
+#include "engine/tracing.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+#include <fmt/format.h>
+
+#include "utils/file_util.h"
+#include "utils/log.hpp"
+#include "utils/sdl_mutex.h"
+
+namespace devilution {
+
+namespace {
+
+/** Enough for an hour at a few hundred zones per second, so a forgotten flag can't eat all memory. */
+constexpr size_t MaxTraceZones = 1 << 22;
+
+std::atomic<bool> Enabled { false };
+std::string TracePath;
+std::chrono::steady_clock::time_point Epoch;
+
+std::atomic<uint32_t> ThreadCount { 0 };
+thread_local uint32_t ThreadNumber = 0;
+
+/** Only created once tracing is enabled, so nothing is allocated without the flag. */
+std::unique_ptr<SdlMutex> ZonesMutex;
+std::vector<TraceZone> Zones;
+size_t DroppedZones = 0;
+
+[[nodiscard]] int64_t MicrosecondsSinceEpoch(std::chrono::steady_clock::time_point time)
+{
+	return std::chrono::duration_cast<std::chrono::microseconds>(time - Epoch).count();
+}
+
+} // namespace
+
+bool IsTracingEnabled()
+{
+	return Enabled.load(std::memory_order_relaxed);
+}
+
+void EnableTracing(std::string tracePath)
+{
+	if (IsTracingEnabled())
+		return;
+	TracePath = std::move(tracePath);
+	ZonesMutex = std::make_unique<SdlMutex>();
+	Zones.reserve(4096);
+	Epoch = std::chrono::steady_clock::now();
+	Enabled.store(true, std::memory_order_relaxed);
+}
+
+ScopedTraceZone::ScopedTraceZone(const char *name)
+    : name_(name)
+    , enabled_(IsTracingEnabled())
+{
+	if (enabled_)
+		start_ = std::chrono::steady_clock::now();
+}
+
+ScopedTraceZone::~ScopedTraceZone()
+{
+	if (!enabled_)
+		return;
+	const auto end = std::chrono::steady_clock::now();
+	if (ThreadNumber == 0)
+		ThreadNumber = ThreadCount.fetch_add(1, std::memory_order_relaxed) + 1;
+
+	const int64_t start = MicrosecondsSinceEpoch(start_);
+	const TraceZone zone { name_, ThreadNumber, start, MicrosecondsSinceEpoch(end) - start };
+	const std::lock_guard<SdlMutex> lock(*ZonesMutex);
+	if (Zones.size() < MaxTraceZones)
+		Zones.push_back(zone);
+	else
+		DroppedZones++;
+}
+
+std::string FormatChromeTrace(const std::vector<TraceZone> &zones)
+{
+	std::string out = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+	for (const TraceZone &zone : zones) {
+		if (out.back() != '[')
+			out += ',';
+		// Zone names are identifiers from the code, so they need no escaping.
+		out += fmt::format("\n{{\"name\":\"{}\",\"ph\":\"X\",\"pid\":1,\"tid\":{},\"ts\":{},\"dur\":{}}}",
+		    zone.name, zone.thread, zone.startMicroseconds, zone.durationMicroseconds);
+	}
+	out += "\n]}\n";
+	return out;
+}
+
+void WriteTrace()
+{
+	if (!IsTracingEnabled())
+		return;
+
+	std::string trace;
+	size_t zoneCount;
+	{
+		const std::lock_guard<SdlMutex> lock(*ZonesMutex);
+		if (DroppedZones != 0)
+			LogWarn("The trace is full, dropped the last {} zones", DroppedZones);
+		trace = FormatChromeTrace(Zones);
+		zoneCount = Zones.size();
+	}
+
+	FILE *file = OpenFile(TracePath.c_str(), "wb");
+	if (file == nullptr) {
+		LogError("Failed to write the trace to {}", TracePath);
+		return;
+	}
+	const bool written = std::fwrite(trace.data(), trace.size(), 1, file) == 1;
+	if (std::fclose(file) != 0 || !written) {
+		LogError("Failed to write the trace to {}", TracePath);
+		return;
+	}
+	LogInfo("Wrote {} trace zones to {}", zoneCount, TracePath);
+}
+
+} // namespace devilution
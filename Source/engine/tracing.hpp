@@ -0,0 +1,63 @@
+/**
+ * @file tracing.hpp
+ *
+ * Interface of the timeline zones that show where the main thread stalls, exported in the Chrome trace format.
+ */
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace devilution {
+
+/** A zone that was entered and left, with times relative to when tracing was enabled. */
+struct TraceZone {
+	/** A string literal, so zones never allocate. */
+	const char *name;
+	/** Numbers the threads in the order they first entered a zone, starting at 1. */
+	uint32_t thread;
+	int64_t startMicroseconds;
+	int64_t durationMicroseconds;
+};
+
+/** @brief Whether zones are being recorded, from the `--trace` flag. Safe from any thread. */
+[[nodiscard]] bool IsTracingEnabled();
+
+/**
+ * @brief Starts recording zones.
+ * @param tracePath Where WriteTrace() writes them, loadable by chrome://tracing and ui.perfetto.dev
+ */
+void EnableTracing(std::string tracePath);
+
+/** @brief Records a zone for the time until it goes out of scope, if tracing is enabled. Safe from any thread. */
+class ScopedTraceZone {
+public:
+	explicit ScopedTraceZone(const char *name);
+	~ScopedTraceZone();
+
+	ScopedTraceZone(const ScopedTraceZone &) = delete;
+	ScopedTraceZone &operator=(const ScopedTraceZone &) = delete;
+
+private:
+	const char *name_;
+	std::chrono::steady_clock::time_point start_;
+	bool enabled_;
+};
+
+[[nodiscard]] std::string FormatChromeTrace(const std::vector<TraceZone> &zones);
+
+/** @brief Writes the trace to the path given to EnableTracing(), call once on shutdown. */
+void WriteTrace();
+
+} // namespace devilution
+
+#ifdef DEVILUTIONX_TRACING
+#define DVL_TRACE_CONCAT_(a, b) a##b
+#define DVL_TRACE_CONCAT(a, b) DVL_TRACE_CONCAT_(a, b)
+/** Records the rest of the enclosing scope as a zone, compiled out unless DEVILUTIONX_TRACING is set. */
+#define DVL_TRACE_ZONE(name) const ::devilution::ScopedTraceZone DVL_TRACE_CONCAT(traceZone, __LINE__)(name)
+#else
+#define DVL_TRACE_ZONE(name)
+#endif
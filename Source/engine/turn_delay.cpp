@@ -0,0 +1,80 @@
+/**
+ * @file turn_delay.cpp
+ *
+ * Implementation of the controller that picks how many turns are kept in transit in multiplayer.
+ */
+#include "engine/turn_delay.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace devilution {
+
+void TurnDelayController::Reset(uint32_t minTurns, uint32_t maxTurns, uint32_t initialTurns)
+{
+	minTurns_ = minTurns;
+	maxTurns_ = std::max(minTurns, maxTurns);
+	turns_ = std::clamp(initialTurns, minTurns_, maxTurns_);
+	smoothedRoundTrip_ = 0;
+	roundTripDeviation_ = 0;
+	measured_ = false;
+	quietSamples_ = 0;
+	samplesBeforeLowering_ = SamplesBeforeLowering;
+	stalled_ = false;
+}
+
+void TurnDelayController::AddRoundTrip(uint32_t roundTripMs, uint32_t turnMs)
+{
+	const auto sample = static_cast<float>(roundTripMs);
+	if (!measured_) {
+		smoothedRoundTrip_ = sample;
+		roundTripDeviation_ = sample / 2;
+		measured_ = true;
+	} else {
+		roundTripDeviation_ += (std::abs(smoothedRoundTrip_ - sample) - roundTripDeviation_) / 4;
+		smoothedRoundTrip_ += (sample - smoothedRoundTrip_) / 8;
+	}
+
+	// The turns in transit have to cover the trip one way plus the jitter, with half a turn to spare
+	// for the tick the turn is sent in.
+	const auto turnLength = static_cast<float>(std::max<uint32_t>(turnMs, 1));
+	const float covered = smoothedRoundTrip_ / 2 + 2 * roundTripDeviation_ + turnLength / 2;
+	const auto wanted = static_cast<uint32_t>(std::ceil(covered / turnLength));
+	const uint32_t target = std::clamp(wanted, minTurns_, maxTurns_);
+
+	if (target > turns_) {
+		Raise(target);
+		return;
+	}
+	if (target == turns_) {
+		quietSamples_ = 0;
+		return;
+	}
+	if (++quietSamples_ >= samplesBeforeLowering_) {
+		turns_--;
+		quietSamples_ = 0;
+		samplesBeforeLowering_ = SamplesBeforeLowering;
+	}
+}
+
+void TurnDelayController::AddTick(bool turnsArrived)
+{
+	// A wait only counts once, however many times the tick is retried before the turns show up.
+	if (turnsArrived) {
+		stalled_ = false;
+		return;
+	}
+	if (stalled_)
+		return;
+	stalled_ = true;
+	Raise(turns_ + 1);
+	samplesBeforeLowering_ = SamplesBeforeLoweringAfterStall;
+}
+
+void TurnDelayController::Raise(uint32_t turns)
+{
+	turns_ = std::min(turns, maxTurns_);
+	quietSamples_ = 0;
+}
+
+} // namespace devilution
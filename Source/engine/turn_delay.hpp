@@ -0,0 +1,64 @@
+/**
+ * @file turn_delay.hpp
+ *
+ * Interface of the controller that picks how many turns are kept in transit in multiplayer.
+ */
+#pragma once
+
+#include <cstdint>
+
+namespace devilution {
+
+/**
+ * @brief Picks how many turns to send ahead from the measured round trips and the ticks that had
+ * to wait for a peer, so LAN games get little input lag and bad links don't stall.
+ *
+ * Round trips are smoothed like TCP does for its retransmission timer. More turns are used as
+ * soon as a link needs them, fewer only once it has been quiet for a while.
+ */
+class TurnDelayController {
+public:
+	/** Round trip samples without a stall before one turn less is tried. */
+	static constexpr uint32_t SamplesBeforeLowering = 3;
+	/** Same after a stall, which the round trips failed to predict, so trying fewer turns again is likely to stall again. */
+	static constexpr uint32_t SamplesBeforeLoweringAfterStall = 12;
+
+	/**
+	 * @param minTurns Fewest turns to keep in transit
+	 * @param maxTurns Most turns to keep in transit
+	 * @param initialTurns Turns to use until the links have been measured
+	 */
+	void Reset(uint32_t minTurns, uint32_t maxTurns, uint32_t initialTurns);
+
+	/**
+	 * @brief Adds the worst round trip to any peer measured since the last sample.
+	 * @param roundTripMs Round trip in milliseconds
+	 * @param turnMs How long a turn lasts in milliseconds
+	 */
+	void AddRoundTrip(uint32_t roundTripMs, uint32_t turnMs);
+
+	/** @brief Notes whether the turns of a game tick had arrived when it was due. */
+	void AddTick(bool turnsArrived);
+
+	[[nodiscard]] uint32_t TurnsInTransit() const
+	{
+		return turns_;
+	}
+
+private:
+	void Raise(uint32_t turns);
+
+	uint32_t minTurns_ = 1;
+	uint32_t maxTurns_ = 1;
+	uint32_t turns_ = 1;
+	/** Smoothed round trip and its mean deviation, in milliseconds. */
+	float smoothedRoundTrip_ = 0;
+	float roundTripDeviation_ = 0;
+	bool measured_ = false;
+	/** Samples in a row that asked for fewer turns than are in use, without a stall in between. */
+	uint32_t quietSamples_ = 0;
+	uint32_t samplesBeforeLowering_ = SamplesBeforeLowering;
+	bool stalled_ = false;
+};
+
+} // namespace devilution
@@ -0,0 +1,78 @@
+/**
+ * @file walk_path.hpp
+ *
+ * Fixed-capacity walk paths and their run-length encoding, used for spoken directions.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "utils/static_vector.hpp"
+
+namespace devilution {
+
+/** Longest walk path the speech helpers keep, longer paths are reported as not found. */
+constexpr size_t MaxWalkPathLength = 1024;
+
+/** A path as a list of walk directions (WALK_*), stored inline. */
+using WalkPath = StaticVector<int8_t, MaxWalkPathLength>;
+
+/** A number of consecutive steps in the same walk direction. */
+struct WalkPathRun {
+	int8_t direction;
+	uint16_t steps;
+};
+
+/** A walk path compressed to its straight runs, "3 north, 2 east" style. */
+class WalkPathRuns {
+public:
+	WalkPathRuns() = default;
+
+	explicit WalkPathRuns(std::span<const int8_t> path)
+	{
+		for (const int8_t direction : path)
+			Append(direction);
+	}
+
+	void Append(int8_t direction)
+	{
+		if (!runs_.empty() && runs_.back().direction == direction) {
+			runs_.back().steps++;
+			return;
+		}
+		runs_.push_back(WalkPathRun { direction, 1 });
+	}
+
+	[[nodiscard]] bool empty() const
+	{
+		return runs_.empty();
+	}
+
+	[[nodiscard]] size_t size() const
+	{
+		return runs_.size();
+	}
+
+	[[nodiscard]] const WalkPathRun *begin() const
+	{
+		return runs_.begin();
+	}
+
+	[[nodiscard]] const WalkPathRun *end() const
+	{
+		return runs_.end();
+	}
+
+	[[nodiscard]] const WalkPathRun &operator[](size_t index) const
+	{
+		return runs_[index];
+	}
+
+private:
+	// A path can't have more runs than steps.
+	StaticVector<WalkPathRun, MaxWalkPathLength> runs_;
+};
+
+} // namespace devilution
@@ -123,8 +123,10 @@ void init_cleanup()
 		pfile_write_hero(/*writeGameData=*/false);
 		sfile_write_stash();
 	}
+	pfile_finish_writes();
 
 	MpqArchives.clear();
+	RebuildMpqFileIndex();
 	HasHellfireMpq = false;
 
 	NetClose();
@@ -698,32 +698,31 @@ std::optional<inv_xy_slot> FindSlotUnderCursor(Point cursorPosition)
 }
 
 /**
- * @brief Checks whether an item of the given size can be placed on the specified player's inventory slot.
+ * @brief The occupied cells of a player's inventory as bits, cell i of InvGrid being bit i.
  * @param player The player whose inventory will be checked.
- * @param slotIndex The 0-based index of the slot to put the item on.
- * @param itemSize The size of the item to be checked.
- * @param itemIndexToIgnore can be used to check if an item of the given size would fit if the item with the given (positive) ID was removed.
- * @return 'True' in case the item can be placed on the specified player's inventory slot and 'False' otherwise.
+ * @param itemIndexToIgnore Cells of the item with this (positive) ID are treated as free.
  */
-bool CheckItemFitsInInventorySlot(const Player &player, int slotIndex, const Size &itemSize, int itemIndexToIgnore)
+uint64_t GetInventoryOccupancy(const Player &player, int itemIndexToIgnore)
 {
-	int yy = (slotIndex > 0) ? (10 * (slotIndex / 10)) : 0;
-
-	for (int j = 0; j < itemSize.height; j++) {
-		if (yy >= InventoryGridCells) {
-			return false;
-		}
-		int xx = (slotIndex > 0) ? (slotIndex % 10) : 0;
-		for (int i = 0; i < itemSize.width; i++) {
-			if (xx >= 10 || !(player.InvGrid[xx + yy] == 0 || std::abs(player.InvGrid[xx + yy]) - 1 == itemIndexToIgnore)) {
-				// The item is too wide to fit in the specified column, or one of the cells is occupied (and not by the item we're planning on removing)
-				return false;
-			}
-			xx++;
-		}
-		yy += 10;
+	uint64_t occupied = 0;
+	for (int i = 0; i < InventoryGridCells; i++) {
+		const int8_t itemIndex = player.InvGrid[i];
+		if (itemIndex != 0 && std::abs(itemIndex) - 1 != itemIndexToIgnore)
+			occupied |= uint64_t { 1 } << i;
 	}
-	return true;
+	return occupied;
+}
+
+/**
+ * @brief The cells an item of the given size covers when placed on slot 0, shift it by the slot index to place it elsewhere.
+ */
+uint64_t GetInventoryFootprint(const Size &itemSize)
+{
+	const uint64_t row = (uint64_t { 1 } << itemSize.width) - 1;
+	uint64_t footprint = 0;
+	for (int j = 0; j < itemSize.height; j++)
+		footprint |= row << (j * InventorySizeInSlots.width);
+	return footprint;
 }
 
 /**
@@ -735,14 +734,22 @@ bool CheckItemFitsInInventorySlot(const Player &player, int slotIndex, const Siz
  */
 std::optional<int> FindSlotForItem(const Player &player, const Size &itemSize, int itemIndexToIgnore = -1)
 {
+	const uint64_t occupied = GetInventoryOccupancy(player, itemIndexToIgnore);
+	const uint64_t footprint = GetInventoryFootprint(itemSize);
+	const auto fits = [&](int slotIndex) {
+		if (slotIndex % InventorySizeInSlots.width + itemSize.width > InventorySizeInSlots.width || slotIndex / InventorySizeInSlots.width + itemSize.height > InventorySizeInSlots.height)
+			return false;
+		return (occupied & (footprint << slotIndex)) == 0;
+	};
+
 	if (itemSize.height == 1) {
 		for (int i = 30; i <= 39; i++) {
-			if (CheckItemFitsInInventorySlot(player, i, itemSize, itemIndexToIgnore))
+			if (fits(i))
 				return i;
 		}
 		for (int x = 9; x >= 0; x--) {
 			for (int y = 2; y >= 0; y--) {
-				if (CheckItemFitsInInventorySlot(player, 10 * y + x, itemSize, itemIndexToIgnore))
+				if (fits(10 * y + x))
 					return 10 * y + x;
 			}
 		}
@@ -752,7 +759,7 @@ std::optional<int> FindSlotForItem(const Player &player, const Size &itemSize, i
 	if (itemSize.height == 2) {
 		for (int x = 10 - itemSize.width; x >= 0; x--) {
 			for (int y = 0; y < 3; y++) {
-				if (CheckItemFitsInInventorySlot(player, 10 * y + x, itemSize, itemIndexToIgnore))
+				if (fits(10 * y + x))
 					return 10 * y + x;
 			}
 		}
@@ -761,7 +768,7 @@ std::optional<int> FindSlotForItem(const Player &player, const Size &itemSize, i
 
 	if (itemSize == Size { 1, 3 }) {
 		for (int i = 0; i < 20; i++) {
-			if (CheckItemFitsInInventorySlot(player, i, itemSize, itemIndexToIgnore))
+			if (fits(i))
 				return i;
 		}
 		return {};
@@ -769,12 +776,12 @@ std::optional<int> FindSlotForItem(const Player &player, const Size &itemSize, i
 
 	if (itemSize == Size { 2, 3 }) {
 		for (int i = 0; i < 9; i++) {
-			if (CheckItemFitsInInventorySlot(player, i, itemSize, itemIndexToIgnore))
+			if (fits(i))
 				return i;
 		}
 
 		for (int i = 10; i < 19; i++) {
-			if (CheckItemFitsInInventorySlot(player, i, itemSize, itemIndexToIgnore))
+			if (fits(i))
 				return i;
 		}
 		return {};
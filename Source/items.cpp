@@ -13,6 +13,7 @@
 #include <cstdint>
 #include <cstring>
 #include <optional>
+#include <span>
 #include <string>
 #include <string_view>
 #include <type_traits>
@@ -25,6 +26,7 @@
 #include <SDL.h>
 #endif
 
+#include <ankerl/unordered_dense.h>
 #include <fmt/core.h>
 
 #include "DiabloUI/ui_flags.hpp"
@@ -65,6 +67,7 @@
 #include "objects.h"
 #include "options.h"
 #include "pack.h"
+#include "panels/charpanel.hpp"
 #include "panels/info_box.hpp"
 #include "panels/ui_panels.hpp"
 #include "player.h"
@@ -80,6 +83,7 @@
 #include "tables/spelldat.h"
 #include "tables/textdat.h"
 #include "utils/enum_traits.h"
+#include "utils/fnv1a.hpp"
 #include "utils/format_int.hpp"
 #include "utils/is_of.hpp"
 #include "utils/language.h"
@@ -1060,6 +1064,75 @@ void SaveItemAffix(const Player &player, Item &item, const PLStruct &affix)
 	}
 }
 
+/**
+ * @brief The affixes a roll can land on, each repeated by its drop chance.
+ *
+ * Vendors roll dozens of items with the same few filters, so the tables are built once per filter
+ * and reused until the affix data is reloaded.
+ */
+class AffixCandidateTables {
+public:
+	[[nodiscard]] const std::vector<const PLStruct *> &Get(
+	    const std::vector<PLStruct> &affixList,
+	    AffixItemType type,
+	    int minlvl, int maxlvl,
+	    bool onlygood,
+	    goodorevil goe,
+	    bool excludeChargesForStaffs)
+	{
+		if (generation_ != ItemDataGeneration) {
+			tables_.clear();
+			generation_ = ItemDataGeneration;
+		}
+
+		// PLMinLvl is an int8_t, so levels outside of that range all filter the same way.
+		const auto clampLevel = [](int level) { return static_cast<uint64_t>(std::clamp(level, INT8_MIN - 1, INT8_MAX + 1) - (INT8_MIN - 1)); };
+		const uint64_t key = static_cast<uint64_t>(type)
+		    | (clampLevel(minlvl) << 8)
+		    | (clampLevel(maxlvl) << 17)
+		    | (static_cast<uint64_t>(goe) << 26)
+		    | (static_cast<uint64_t>(onlygood) << 28)
+		    | (static_cast<uint64_t>(excludeChargesForStaffs) << 29)
+		    | (static_cast<uint64_t>(&affixList == &ItemSuffixes) << 30);
+
+		auto [it, inserted] = tables_.try_emplace(key);
+		if (inserted)
+			Build(it->second, affixList, type, minlvl, maxlvl, onlygood, goe, excludeChargesForStaffs);
+		return it->second;
+	}
+
+private:
+	static void Build(
+	    std::vector<const PLStruct *> &eligibleAffixes,
+	    const std::vector<PLStruct> &affixList,
+	    AffixItemType type,
+	    int minlvl, int maxlvl,
+	    bool onlygood,
+	    goodorevil goe,
+	    bool excludeChargesForStaffs)
+	{
+		for (const PLStruct &affix : affixList) {
+			if (!HasAnyOf(type, affix.PLIType))
+				continue;
+			if (affix.PLMinLvl < minlvl || affix.PLMinLvl > maxlvl)
+				continue;
+			if (onlygood && !affix.PLOk)
+				continue;
+			if ((goe == GOE_GOOD && affix.PLGOE == GOE_EVIL) || (goe == GOE_EVIL && affix.PLGOE == GOE_GOOD))
+				continue;
+			if (excludeChargesForStaffs && type == AffixItemType::Staff && affix.power.type == IPL_CHARGES)
+				continue;
+
+			eligibleAffixes.insert(eligibleAffixes.end(), affix.PLChance, &affix);
+		}
+	}
+
+	ankerl::unordered_dense::map<uint64_t, std::vector<const PLStruct *>> tables_;
+	uint32_t generation_ = 0;
+};
+
+AffixCandidateTables AffixCandidates;
+
 std::optional<const PLStruct *> SelectAffix(
     const std::vector<PLStruct> &affixList,
     AffixItemType type,
@@ -1068,24 +1141,7 @@ std::optional<const PLStruct *> SelectAffix(
     goodorevil goe,
     bool excludeChargesForStaffs)
 {
-	StaticVector<const PLStruct *, 256> eligibleAffixes;
-
-	for (const PLStruct &affix : affixList) {
-		if (!HasAnyOf(type, affix.PLIType))
-			continue;
-		if (affix.PLMinLvl < minlvl || affix.PLMinLvl > maxlvl)
-			continue;
-		if (onlygood && !affix.PLOk)
-			continue;
-		if ((goe == GOE_GOOD && affix.PLGOE == GOE_EVIL) || (goe == GOE_EVIL && affix.PLGOE == GOE_GOOD))
-			continue;
-		if (excludeChargesForStaffs && type == AffixItemType::Staff && affix.power.type == IPL_CHARGES)
-			continue;
-
-		for (int i = 0; i < affix.PLChance; ++i) {
-			eligibleAffixes.push_back(&affix);
-		}
-	}
+	const std::vector<const PLStruct *> &eligibleAffixes = AffixCandidates.Get(affixList, type, minlvl, maxlvl, onlygood, goe, excludeChargesForStaffs);
 
 	if (eligibleAffixes.empty())
 		return std::nullopt;
@@ -1416,17 +1472,68 @@ _item_indexes RndTypeItems(ItemType itemType, int imid, int lvl)
 	});
 }
 
-std::vector<uint8_t> GetValidUniques(int lvl, unique_base_item baseItemId)
-{
-	std::vector<uint8_t> validUniques;
-	int index = 0;
-	for (const UniqueItem &itemData : UniqueItems) {
-		if (itemData.UIItemId == baseItemId && lvl >= itemData.UIMinLvl) {
-			validUniques.push_back(index);
+/**
+ * @brief The uniques of each base item, split into bands by the levels at which new ones become available.
+ *
+ * Each band lists every unique up to its level in the order of UniqueItems, so a roll only looks up a band.
+ */
+class UniqueCandidateIndex {
+public:
+	[[nodiscard]] std::span<const uint8_t> Get(int lvl, unique_base_item baseItemId)
+	{
+		if (generation_ != ItemDataGeneration)
+			Build();
+
+		const auto it = bands_.find(baseItemId);
+		if (it == bands_.end())
+			return {};
+		const std::vector<Band> &bands = it->second;
+		const auto band = std::upper_bound(bands.begin(), bands.end(), lvl, [](int level, const Band &b) { return level < b.minLevel; });
+		if (band == bands.begin())
+			return {};
+		return std::prev(band)->uniques;
+	}
+
+private:
+	struct Band {
+		int minLevel;
+		std::vector<uint8_t> uniques;
+	};
+
+	void Build()
+	{
+		bands_.clear();
+		generation_ = ItemDataGeneration;
+
+		ankerl::unordered_dense::map<unique_base_item, std::vector<int>> levels;
+		for (const UniqueItem &itemData : UniqueItems)
+			levels[itemData.UIItemId].push_back(itemData.UIMinLvl);
+
+		for (auto &[baseItemId, minLevels] : levels) {
+			std::sort(minLevels.begin(), minLevels.end());
+			minLevels.erase(std::unique(minLevels.begin(), minLevels.end()), minLevels.end());
+			std::vector<Band> &bands = bands_[baseItemId];
+			for (const int minLevel : minLevels) {
+				Band &band = bands.emplace_back(Band { minLevel, {} });
+				int index = 0;
+				for (const UniqueItem &itemData : UniqueItems) {
+					if (itemData.UIItemId == baseItemId && minLevel >= itemData.UIMinLvl)
+						band.uniques.push_back(index);
+					index++;
+				}
+			}
 		}
-		index++;
 	}
-	return validUniques;
+
+	ankerl::unordered_dense::map<unique_base_item, std::vector<Band>> bands_;
+	uint32_t generation_ = 0;
+};
+
+UniqueCandidateIndex UniqueCandidates;
+
+std::span<const uint8_t> GetValidUniques(int lvl, unique_base_item baseItemId)
+{
+	return UniqueCandidates.Get(lvl, baseItemId);
 }
 
 _unique_items CheckUnique(Item &item, int lvl, int uper, int uidOffset = 0)
@@ -2370,6 +2477,112 @@ std::string GetTranslatedItemNameMagical(const Item &item, bool hellfireItem, bo
 	return identifiedName;
 }
 
+/**
+ * @brief Items regenerated from their seeds, so rolling the same item again is a copy.
+ *
+ * Joining a game regenerates every item of every player, and the hero list, loading a hero and each
+ * later join do so again for the same items. Besides the packed item, generation also reads the game
+ * mode and a few of the player's base stats, so they are part of the key as well.
+ */
+class RecreatedItemCache {
+public:
+	/** Entries kept before the cache starts over, a few parties of geared heroes. */
+	static constexpr size_t MaxEntries = 1024;
+
+	struct Entry {
+		Item item;
+		/** The state of the game's random number generator after rolling the item. */
+		uint32_t rngState;
+		/** Whether SetupItem() still has to be called on the item. */
+		bool needsSetup;
+	};
+
+	[[nodiscard]] static std::array<uint64_t, 5> MakeKey(const Player &player, _item_indexes idx, uint16_t icreateinfo, uint32_t iseed, uint32_t dwBuff)
+	{
+		const auto word = [](int32_t low, int32_t high) {
+			return static_cast<uint32_t>(low) | (static_cast<uint64_t>(static_cast<uint32_t>(high)) << 32);
+		};
+		const uint64_t flags = (gbIsMultiplayer ? 1 : 0) | (gbIsSpawn ? 2 : 0) | (*GetOptions().Gameplay.testBard ? 4 : 0);
+		return {
+			iseed | (static_cast<uint64_t>(dwBuff) << 32),
+			static_cast<uint16_t>(idx) | (static_cast<uint64_t>(icreateinfo) << 16) | (static_cast<uint64_t>(player._pClass) << 32) | (flags << 40),
+			word(player._pBaseStr, player._pBaseMag),
+			word(player._pBaseDex, player._pBaseVit),
+			word(player._pMaxHPBase, player._pMaxManaBase),
+		};
+	}
+
+	[[nodiscard]] const Entry *Find(const std::array<uint64_t, 5> &key)
+	{
+		if (generation_ != ItemDataGeneration) {
+			entries_.clear();
+			generation_ = ItemDataGeneration;
+		}
+		const auto it = entries_.find(key);
+		return it != entries_.end() ? &it->second : nullptr;
+	}
+
+	void Add(const std::array<uint64_t, 5> &key, const Item &item, bool needsSetup)
+	{
+		if (entries_.size() >= MaxEntries)
+			entries_.clear();
+		entries_.insert_or_assign(key, Entry { item, GetLCGEngineState(), needsSetup });
+	}
+
+private:
+	struct KeyHash {
+		using is_avalanching = void;
+
+		[[nodiscard]] uint64_t operator()(const std::array<uint64_t, 5> &key) const
+		{
+			uint64_t hash = Fnv1aOffsetBasis;
+			for (const uint64_t word : key)
+				hash = Fnv1a(word, hash);
+			return hash;
+		}
+	};
+
+	ankerl::unordered_dense::map<std::array<uint64_t, 5>, Entry, KeyHash> entries_;
+	uint32_t generation_ = 0;
+};
+
+RecreatedItemCache RecreatedItems;
+
+/**
+ * @brief Rolls a town, useful or dungeon item from its seed into an empty item.
+ * @return Whether SetupItem() still has to be called on the item
+ */
+bool RollRecreatedItem(const Player &player, Item &item, _item_indexes idx, uint16_t icreateinfo, uint32_t iseed)
+{
+	if ((icreateinfo & CF_UNIQUE) == 0) {
+		if ((icreateinfo & CF_TOWN) != 0) {
+			RecreateTownItem(player, item, idx, icreateinfo, iseed);
+			return false;
+		}
+
+		if ((icreateinfo & CF_USEFUL) == CF_USEFUL) {
+			SetupAllUseful(item, iseed, icreateinfo & CF_LEVEL);
+			return false;
+		}
+	}
+
+	const int level = icreateinfo & CF_LEVEL;
+
+	int uper = 0;
+	if ((icreateinfo & CF_UPER1) != 0)
+		uper = 1;
+	if ((icreateinfo & CF_UPER15) != 0)
+		uper = 15;
+
+	const bool onlygood = (icreateinfo & CF_ONLYGOOD) != 0;
+	const bool forceNotUnique = (icreateinfo & CF_UNIQUE) == 0;
+	const bool pregen = (icreateinfo & CF_PREGEN) != 0;
+	auto uidOffset = static_cast<int>((item.dwBuff & CF_UIDOFFSET) >> 1);
+
+	SetupAllItems(player, item, idx, iseed, level, uper, onlygood, pregen, uidOffset, forceNotUnique);
+	return true;
+}
+
 } // namespace
 
 bool IsItemAvailable(int i)
@@ -2884,6 +3097,7 @@ void CalcPlrItemVals(Player &player, bool loadgfx)
 	CalcPlrAuricBonus(player);
 	RedrawComponent(PanelDrawComponent::Mana);
 	RedrawComponent(PanelDrawComponent::Health);
+	MarkCharacterStatsChanged(player);
 }
 
 void CalcPlrInv(Player &player, bool loadgfx)
@@ -2900,6 +3114,7 @@ void CalcPlrInv(Player &player, bool loadgfx)
 	CalcPlrItemVals(player, loadgfx);
 
 	if (&player == MyPlayer) {
+		MyPlayerEquipmentDurabilityGeneration++;
 		// Now that stat gains from equipped items have been calculated, mark unusable scrolls etc
 		for (Item &item : InventoryAndBeltPlayerItemsRange { player }) {
 			item.updateRequiredStatsCacheForPlayer(player);
@@ -3524,35 +3739,19 @@ void RecreateItem(const Player &player, Item &item, _item_indexes idx, uint16_t
 		return;
 	}
 
-	if ((icreateinfo & CF_UNIQUE) == 0) {
-		if ((icreateinfo & CF_TOWN) != 0) {
-			RecreateTownItem(player, item, idx, icreateinfo, iseed);
-			gbIsHellfire = tmpIsHellfire;
-			return;
-		}
-
-		if ((icreateinfo & CF_USEFUL) == CF_USEFUL) {
-			SetupAllUseful(item, iseed, icreateinfo & CF_LEVEL);
-			gbIsHellfire = tmpIsHellfire;
-			return;
-		}
+	// The random number generator is left as rolling the item would leave it, as the game keeps using it.
+	const std::array<uint64_t, 5> key = RecreatedItemCache::MakeKey(player, idx, icreateinfo, iseed, dwBuff);
+	bool needsSetup;
+	if (const RecreatedItemCache::Entry *cached = RecreatedItems.Find(key); cached != nullptr) {
+		item = cached->item;
+		SetRndSeed(cached->rngState);
+		needsSetup = cached->needsSetup;
+	} else {
+		needsSetup = RollRecreatedItem(player, item, idx, icreateinfo, iseed);
+		RecreatedItems.Add(key, item, needsSetup);
 	}
-
-	const int level = icreateinfo & CF_LEVEL;
-
-	int uper = 0;
-	if ((icreateinfo & CF_UPER1) != 0)
-		uper = 1;
-	if ((icreateinfo & CF_UPER15) != 0)
-		uper = 15;
-
-	const bool onlygood = (icreateinfo & CF_ONLYGOOD) != 0;
-	const bool forceNotUnique = (icreateinfo & CF_UNIQUE) == 0;
-	const bool pregen = (icreateinfo & CF_PREGEN) != 0;
-	auto uidOffset = static_cast<int>((item.dwBuff & CF_UIDOFFSET) >> 1);
-
-	SetupAllItems(player, item, idx, iseed, level, uper, onlygood, pregen, uidOffset, forceNotUnique);
-	SetupItem(item);
+	if (needsSetup)
+		SetupItem(item);
 	gbIsHellfire = tmpIsHellfire;
 }
 
@@ -120,6 +120,25 @@ struct MICROS {
 	LevelCelBlock mt[16];
 };
 
+/**
+ * A MIN block with its frame already looked up, so drawing it doesn't go through the frame table.
+ */
+struct DunFrameRef {
+	/** Where the frame starts in `pDungeonCels`, 0 for an empty block. */
+	uint32_t offset;
+	TileType type;
+
+	[[nodiscard]] bool hasValue() const
+	{
+		return offset != 0;
+	}
+};
+
+/** The blocks of a dungeon piece in the order of `MICROS`, next to each other for drawing. */
+struct PieceFrames {
+	DunFrameRef mt[16];
+};
+
 /** Width of a tile rendering primitive. */
 constexpr int_fast16_t DunFrameWidth = TILE_WIDTH / 2;
 
@@ -1,5 +1,7 @@
 #include "levels/gendung.h"
 
+#include <algorithm>
+#include <array>
 #include <cstddef>
 #include <cstdint>
 #include <memory>
@@ -12,6 +14,7 @@
 #include <expected.hpp>
 #include <magic_enum/magic_enum.hpp>
 
+#include "dead.h"
 #include "engine/clx_sprite.hpp"
 #include "engine/load_file.hpp"
 #include "engine/random.hpp"
@@ -22,6 +25,7 @@
 #include "levels/drlg_l2.h"
 #include "levels/drlg_l3.h"
 #include "levels/drlg_l4.h"
+#include "levels/level_prefetch.hpp"
 #include "levels/reencode_dun_cels.hpp"
 #include "levels/town.h"
 #include "lighting.h"
@@ -59,6 +63,7 @@ int8_t TransVal;
 std::array<bool, 256> TransList;
 uint16_t dPiece[MAXDUNX][MAXDUNY];
 MICROS DPieceMicros[MAXTILES];
+PieceFrames DPieceFrames[MAXTILES];
 int8_t dTransVal[MAXDUNX][MAXDUNY];
 uint8_t dLight[MAXDUNX][MAXDUNY];
 uint8_t dPreLight[MAXDUNX][MAXDUNY];
@@ -73,29 +78,68 @@ THEME_LOC themeLoc[MAXTHEMES];
 
 namespace {
 
+/** Dungeon CELs and micros of a level type the player has left. */
+struct DungeonCelCacheEntry {
+	dungeon_type type = DTYPE_NONE;
+	std::unique_ptr<std::byte[]> cels;
+	uint_fast8_t microTileLen = 0;
+	std::unique_ptr<MICROS[]> micros;
+	std::unique_ptr<PieceFrames[]> frames;
+};
+
+/** The most recently left level type first. */
+std::array<DungeonCelCacheEntry, 2> DungeonCelCache;
+
+/** The level type `pDungeonCels` and the micros were set up for. */
+dungeon_type DungeonCelsType = DTYPE_NONE;
+
+/** @brief Looks up the frame of every block of the level pieces once, instead of on each draw. */
+void ResolvePieceFrames(const std::byte *dungeonCels, size_t pieceCount, size_t blocks)
+{
+	const auto *frameTable = reinterpret_cast<const uint32_t *>(dungeonCels);
+	for (size_t levelPieceId = 0; levelPieceId < MAXTILES; levelPieceId++) {
+		PieceFrames &frames = DPieceFrames[levelPieceId];
+		frames = {};
+		if (levelPieceId >= pieceCount)
+			continue;
+		for (size_t block = 0; block < blocks; block++) {
+			const LevelCelBlock levelCelBlock = DPieceMicros[levelPieceId].mt[block];
+			if (levelCelBlock.hasValue())
+				frames.mt[block] = DunFrameRef { Swap32LE(frameTable[levelCelBlock.frame()]), levelCelBlock.type() };
+		}
+	}
+}
+
+std::unique_ptr<uint16_t[]> LoadMin(const char *path, size_t &tileCount)
+{
+	tl::expected<std::unique_ptr<uint16_t[]>, std::string> min = LoadLevelFileWithStatus<uint16_t>(path, &tileCount);
+	if (!min.has_value()) app_fatal(min.error());
+	return std::move(min).value();
+}
+
 std::unique_ptr<uint16_t[]> LoadMinData(size_t &tileCount)
 {
 	switch (leveltype) {
 	case DTYPE_TOWN: {
-		auto min = LoadFileInMemWithStatus<uint16_t>("nlevels\\towndata\\town.min", &tileCount);
+		auto min = LoadLevelFileWithStatus<uint16_t>("nlevels\\towndata\\town.min", &tileCount);
 		if (!min.has_value()) {
-			return LoadFileInMem<uint16_t>("levels\\towndata\\town.min", &tileCount);
+			return LoadMin("levels\\towndata\\town.min", tileCount);
 		} else {
 			return std::move(*min);
 		}
 	}
 	case DTYPE_CATHEDRAL:
-		return LoadFileInMem<uint16_t>("levels\\l1data\\l1.min", &tileCount);
+		return LoadMin("levels\\l1data\\l1.min", tileCount);
 	case DTYPE_CATACOMBS:
-		return LoadFileInMem<uint16_t>("levels\\l2data\\l2.min", &tileCount);
+		return LoadMin("levels\\l2data\\l2.min", tileCount);
 	case DTYPE_CAVES:
-		return LoadFileInMem<uint16_t>("levels\\l3data\\l3.min", &tileCount);
+		return LoadMin("levels\\l3data\\l3.min", tileCount);
 	case DTYPE_HELL:
-		return LoadFileInMem<uint16_t>("levels\\l4data\\l4.min", &tileCount);
+		return LoadMin("levels\\l4data\\l4.min", tileCount);
 	case DTYPE_NEST:
-		return LoadFileInMem<uint16_t>("nlevels\\l6data\\l6.min", &tileCount);
+		return LoadMin("nlevels\\l6data\\l6.min", tileCount);
 	case DTYPE_CRYPT:
-		return LoadFileInMem<uint16_t>("nlevels\\l5data\\l5.min", &tileCount);
+		return LoadMin("nlevels\\l5data\\l5.min", tileCount);
 	default:
 		app_fatal("LoadMinData");
 	}
@@ -363,6 +407,7 @@ void InitGlobals()
 	memset(dPlayer, 0, sizeof(dPlayer));
 	memset(dMonster, 0, sizeof(dMonster));
 	memset(dCorpse, 0, sizeof(dCorpse));
+	SyncCorpseEntries();
 	memset(dItem, 0, sizeof(dItem));
 	memset(dObject, 0, sizeof(dObject));
 	memset(dSpecial, 0, sizeof(dSpecial));
@@ -543,20 +588,64 @@ void SetDungeonMicros(std::unique_ptr<std::byte[]> &dungeonCels, uint_fast8_t &m
 	});
 	ReencodeDungeonCels(dungeonCels, frameToTypeList);
 
+	const size_t pieceCount = tileCount / blocks;
 	std::vector<std::pair<uint16_t, uint16_t>> celBlockAdjustments = ComputeCelBlockAdjustments(frameToTypeList);
-	if (celBlockAdjustments.size() == 0) return;
-	for (size_t levelPieceId = 0; levelPieceId < tileCount / blocks; levelPieceId++) {
-		for (uint32_t block = 0; block < blocks; block++) {
-			LevelCelBlock &levelCelBlock = DPieceMicros[levelPieceId].mt[block];
-			const uint16_t frame = levelCelBlock.frame();
-			const auto pair = std::make_pair(frame, frame);
-			const auto it = std::upper_bound(celBlockAdjustments.begin(), celBlockAdjustments.end(), pair,
-			    [](std::pair<uint16_t, uint16_t> p1, std::pair<uint16_t, uint16_t> p2) { return p1.first < p2.first; });
-			if (it != celBlockAdjustments.end()) {
-				levelCelBlock.data -= it->second;
+	if (celBlockAdjustments.size() != 0) {
+		for (size_t levelPieceId = 0; levelPieceId < pieceCount; levelPieceId++) {
+			for (uint32_t block = 0; block < blocks; block++) {
+				LevelCelBlock &levelCelBlock = DPieceMicros[levelPieceId].mt[block];
+				const uint16_t frame = levelCelBlock.frame();
+				const auto pair = std::make_pair(frame, frame);
+				const auto it = std::upper_bound(celBlockAdjustments.begin(), celBlockAdjustments.end(), pair,
+				    [](std::pair<uint16_t, uint16_t> p1, std::pair<uint16_t, uint16_t> p2) { return p1.first < p2.first; });
+				if (it != celBlockAdjustments.end()) {
+					levelCelBlock.data -= it->second;
+				}
 			}
 		}
 	}
+
+	ResolvePieceFrames(dungeonCels.get(), pieceCount, blocks);
+	DungeonCelsType = leveltype;
+}
+
+void StashDungeonCels()
+{
+	if (pDungeonCels == nullptr)
+		return;
+	if (DungeonCelCache[0].type != DungeonCelsType)
+		DungeonCelCache[1] = std::move(DungeonCelCache[0]);
+
+	DungeonCelCacheEntry &entry = DungeonCelCache[0];
+	entry.type = DungeonCelsType;
+	entry.cels = std::move(pDungeonCels);
+	entry.microTileLen = MicroTileLen;
+	entry.micros = std::make_unique<MICROS[]>(MAXTILES);
+	std::copy_n(DPieceMicros, MAXTILES, entry.micros.get());
+	entry.frames = std::make_unique<PieceFrames[]>(MAXTILES);
+	std::copy_n(DPieceFrames, MAXTILES, entry.frames.get());
+	DungeonCelsType = DTYPE_NONE;
+}
+
+bool RestoreDungeonCels()
+{
+	for (DungeonCelCacheEntry &entry : DungeonCelCache) {
+		if (entry.cels == nullptr || entry.type != leveltype)
+			continue;
+		pDungeonCels = std::move(entry.cels);
+		MicroTileLen = entry.microTileLen;
+		std::copy_n(entry.micros.get(), MAXTILES, DPieceMicros);
+		std::copy_n(entry.frames.get(), MAXTILES, DPieceFrames);
+		DungeonCelsType = leveltype;
+		entry = {};
+		return true;
+	}
+	return false;
+}
+
+void ClearDungeonCelCache()
+{
+	DungeonCelCache = {};
 }
 
 void DRLG_InitTrans()
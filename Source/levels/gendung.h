@@ -150,6 +150,8 @@ extern std::array<bool, 256> TransList;
 extern DVL_API_FOR_TEST uint16_t dPiece[MAXDUNX][MAXDUNY];
 /** Map of micros that comprises a full tile for any given dungeon piece. */
 extern DVL_API_FOR_TEST MICROS DPieceMicros[MAXTILES];
+/** The blocks of `DPieceMicros` resolved to their frames in `pDungeonCels`. */
+extern DVL_API_FOR_TEST PieceFrames DPieceFrames[MAXTILES];
 /** Specifies the transparency at each coordinate of the map. */
 extern DVL_API_FOR_TEST int8_t dTransVal[MAXDUNX][MAXDUNY];
 /** Current realtime lighting. Per tile. */
@@ -157,7 +159,7 @@ extern DVL_API_FOR_TEST uint8_t dLight[MAXDUNX][MAXDUNY];
 /** Precalculated static lights. dLight uses this as a base before applying lights. Per tile. */
 extern uint8_t dPreLight[MAXDUNX][MAXDUNY];
 /** Holds various information about dungeon tiles, @see DungeonFlag */
-extern DungeonFlag dFlags[MAXDUNX][MAXDUNY];
+extern DVL_API_FOR_TEST DungeonFlag dFlags[MAXDUNX][MAXDUNY];
 /** Contains the player numbers (players array indices) of the map. negative id indicates player moving. */
 extern int8_t dPlayer[MAXDUNX][MAXDUNY];
 /**
@@ -300,6 +302,18 @@ struct Miniset {
 
 tl::expected<void, std::string> LoadLevelSOLData();
 void SetDungeonMicros(std::unique_ptr<std::byte[]> &dungeonCels, uint_fast8_t &microTileLen);
+/**
+ * @brief Frees `pDungeonCels`, keeping it and the micros for when the player comes back to this level type.
+ *
+ * The last two level types left are kept, which covers going back and forth between town and the dungeon.
+ */
+void StashDungeonCels();
+/**
+ * @brief Brings back the dungeon CELs and micros of `leveltype` if they were kept.
+ * @return Whether they were, otherwise they have to be loaded and passed to SetDungeonMicros() again
+ */
+bool RestoreDungeonCels();
+void ClearDungeonCelCache();
 void DRLG_InitTrans();
 void DRLG_MRectTrans(WorldTilePosition origin, WorldTilePosition extent);
 void DRLG_MRectTrans(WorldTileRectangle area);
@@ -0,0 +1,140 @@
+/**
+ * @file levels/level_prefetch.cpp
+ *
+ * Implementation of reading the tile graphics of the neighbouring levels ahead of time.
+ */
+#include "levels/level_prefetch.hpp"
+
+#include <algorithm>
+#include <initializer_list>
+#include <span>
+#include <vector>
+
+#include "engine/assets.hpp"
+#include "headless_mode.hpp"
+#include "levels/gendung.h"
+#include "utils/sdl_thread.h"
+
+namespace devilution {
+
+namespace {
+
+struct PrefetchedFileEntry {
+	std::string path;
+	PrefetchedLevelFile file;
+};
+
+/** Set by the game thread before the prefetch thread starts. */
+std::vector<std::string_view> PrefetchPaths;
+/** Filled by the prefetch thread, only touched by the game thread once it was joined. */
+std::vector<PrefetchedFileEntry> PrefetchedFiles;
+SdlThread PrefetchThread;
+
+constexpr std::string_view TownFiles[] = { "nlevels\\towndata\\town.cel", "levels\\towndata\\town.cel", "nlevels\\towndata\\town.til", "levels\\towndata\\town.til", "nlevels\\towndata\\town.min", "levels\\towndata\\town.min" };
+constexpr std::string_view CathedralFiles[] = { "levels\\l1data\\l1.cel", "levels\\l1data\\l1.til", "levels\\l1data\\l1.min" };
+constexpr std::string_view CatacombsFiles[] = { "levels\\l2data\\l2.cel", "levels\\l2data\\l2.til", "levels\\l2data\\l2.min" };
+constexpr std::string_view CavesFiles[] = { "levels\\l3data\\l3.cel", "levels\\l3data\\l3.til", "levels\\l3data\\l3.min" };
+constexpr std::string_view HellFiles[] = { "levels\\l4data\\l4.cel", "levels\\l4data\\l4.til", "levels\\l4data\\l4.min" };
+constexpr std::string_view NestFiles[] = { "nlevels\\l6data\\l6.cel", "nlevels\\l6data\\l6.til", "nlevels\\l6data\\l6.min" };
+constexpr std::string_view CryptFiles[] = { "nlevels\\l5data\\l5.cel", "nlevels\\l5data\\l5.til", "nlevels\\l5data\\l5.min" };
+
+/** @brief The files LoadLvlGFX() and SetDungeonMicros() read for a level type, with the fallbacks for the town. */
+std::span<const std::string_view> GetLevelTileFiles(dungeon_type type)
+{
+	switch (type) {
+	case DTYPE_TOWN:
+		return TownFiles;
+	case DTYPE_CATHEDRAL:
+		return CathedralFiles;
+	case DTYPE_CATACOMBS:
+		return CatacombsFiles;
+	case DTYPE_CAVES:
+		return CavesFiles;
+	case DTYPE_HELL:
+		return HellFiles;
+	case DTYPE_NEST:
+		return NestFiles;
+	case DTYPE_CRYPT:
+		return CryptFiles;
+	default:
+		return {};
+	}
+}
+
+/** @brief The level the up stairs lead to, the Hive and the Crypt are entered from the town. */
+int GetPreviousLevel(int level)
+{
+	if (level == 17 || level == 21)
+		return 0;
+	return level - 1;
+}
+
+/** @brief The level the down stairs lead to, -1 if there are none. */
+int GetNextLevel(int level)
+{
+	if (level == 16 || level == 20 || level == 24)
+		return -1;
+	return level + 1;
+}
+
+void ReadPrefetchedFiles()
+{
+	for (const std::string_view path : PrefetchPaths) {
+		AssetRef ref = FindAsset(path);
+		if (!ref.ok())
+			continue;
+
+		const size_t size = ref.size();
+		AssetHandle handle = OpenAsset(std::move(ref), /*threadsafe=*/true);
+		if (!handle.ok())
+			continue;
+
+		std::unique_ptr<std::byte[]> data { new std::byte[size] };
+		if (!handle.read(data.get(), size))
+			continue;
+		PrefetchedFiles.push_back({ std::string(path), { std::move(data), size } });
+	}
+}
+
+} // namespace
+
+void PrefetchAdjacentLevelFiles()
+{
+	ReleasePrefetchedLevelFiles();
+#ifndef __DJGPP__
+	// Set levels return to where they were entered from, which was just loaded anyway.
+	if (HeadlessMode || setlevel)
+		return;
+
+	for (const int level : { GetPreviousLevel(currlevel), GetNextLevel(currlevel) }) {
+		if (level < 0)
+			continue;
+		for (const std::string_view path : GetLevelTileFiles(GetLevelType(level))) {
+			if (std::find(PrefetchPaths.begin(), PrefetchPaths.end(), path) == PrefetchPaths.end())
+				PrefetchPaths.push_back(path);
+		}
+	}
+	if (!PrefetchPaths.empty())
+		PrefetchThread = SdlThread { ReadPrefetchedFiles };
+#endif
+}
+
+std::optional<PrefetchedLevelFile> TakePrefetchedLevelFile(std::string_view path)
+{
+	PrefetchThread.join();
+	const auto it = std::find_if(PrefetchedFiles.begin(), PrefetchedFiles.end(), [path](const PrefetchedFileEntry &entry) { return entry.path == path; });
+	if (it == PrefetchedFiles.end())
+		return std::nullopt;
+	PrefetchedLevelFile file = std::move(it->file);
+	PrefetchedFiles.erase(it);
+	return file;
+}
+
+void ReleasePrefetchedLevelFiles()
+{
+	PrefetchThread.join();
+	PrefetchedFiles.clear();
+	PrefetchPaths.clear();
+}
+
+} // namespace devilution
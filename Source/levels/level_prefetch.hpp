@@ -0,0 +1,60 @@
+/**
+ * @file levels/level_prefetch.hpp
+ *
+ * Interface of reading the tile graphics of the neighbouring levels ahead of time.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include <expected.hpp>
+
+#include "engine/load_file.hpp"
+
+namespace devilution {
+
+struct PrefetchedLevelFile {
+	std::unique_ptr<std::byte[]> data;
+	size_t size;
+};
+
+/**
+ * @brief Starts reading the tile graphics of the levels above and below the current one on a background thread.
+ *
+ * Only the files are read ahead, the levels themselves are still generated when they are entered.
+ */
+void PrefetchAdjacentLevelFiles();
+
+/** @brief Takes a file that was read ahead, waiting for the prefetch to finish first. */
+std::optional<PrefetchedLevelFile> TakePrefetchedLevelFile(std::string_view path);
+
+/** @brief Waits for the prefetch and drops what it read, has to happen before the archives are closed. */
+void ReleasePrefetchedLevelFiles();
+
+/** @brief Same as LoadFileInMemWithStatus(), but takes the file from the prefetch if it was read ahead. */
+template <typename T = std::byte>
+tl::expected<std::unique_ptr<T[]>, std::string> LoadLevelFileWithStatus(const char *path, std::size_t *numRead = nullptr)
+{
+	std::optional<PrefetchedLevelFile> file = TakePrefetchedLevelFile(path);
+	if (!file || (file->size % sizeof(T)) != 0)
+		return LoadFileInMemWithStatus<T>(path, numRead);
+
+	if (numRead != nullptr)
+		*numRead = file->size / sizeof(T);
+	if constexpr (std::is_same_v<T, std::byte>) {
+		return { std::move(file->data) };
+	} else {
+		std::unique_ptr<T[]> buf { new T[file->size / sizeof(T)] };
+		std::memcpy(buf.get(), file->data.get(), file->size);
+		return { std::move(buf) };
+	}
+}
+
+} // namespace devilution
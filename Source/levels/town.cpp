@@ -9,6 +9,7 @@
 #include "levels/drlg_l1.h"
 #include "levels/trigs.h"
 #include "multi.h"
+#include "objects.h"
 #include "player.h"
 #include "quests.h"
 #include "utils/endian_swap.hpp"
@@ -330,6 +331,7 @@ void TownOpenHive()
 	dPiece[85][64] = 15;
 	dPiece[86][60] = 16;
 	dPiece[86][61] = 17;
+	ObjectWalkabilityGeneration++;
 }
 
 void TownOpenGrave()
@@ -347,6 +349,7 @@ void TownOpenGrave()
 	dPiece[37][24] = 0x539;
 	dPiece[35][21] = 0x53a;
 	dPiece[34][21] = 0x53b;
+	ObjectWalkabilityGeneration++;
 }
 
 void CleanTownFountain()
@@ -354,6 +357,7 @@ void CleanTownFountain()
 	if (!pMegaTiles)
 		return;
 	FillTile(60, 70, 71);
+	ObjectWalkabilityGeneration++;
 }
 
 void CreateTown(lvl_entry entry)
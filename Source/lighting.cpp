@@ -6,10 +6,15 @@
 #include "lighting.h"
 
 #include <algorithm>
+#include <array>
 #include <cstdint>
+#include <cstdlib>
 #include <cstring>
 #include <numeric>
+#include <optional>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include <expected.hpp>
 
@@ -24,6 +29,7 @@
 #include "objects.h"
 #include "player.h"
 #include "utils/attributes.h"
+#include "utils/bitset2d.hpp"
 #include "utils/is_of.hpp"
 #include "utils/status_macros.hpp"
 #include "vision.hpp"
@@ -38,6 +44,7 @@ int ActiveLightCount;
 std::array<std::array<uint8_t, LightTableSize>, NumLightingLevels> LightTables;
 uint8_t *FullyLitLightTable = nullptr;
 uint8_t *FullyDarkLightTable = nullptr;
+uint32_t LightTablesVersion;
 std::array<uint8_t, 256> InfravisionTable;
 std::array<uint8_t, 256> StoneTable;
 std::array<uint8_t, 256> PauseTable;
@@ -53,9 +60,43 @@ constexpr size_t NumLightRadiuses = 16;
 /** Falloff tables for the light cone */
 uint8_t LightFalloffs[NumLightRadiuses][128];
 bool UpdateVision;
+/** Capacity of NewlyExploredTiles, beyond this consumers have to rescan the level. */
+constexpr size_t NewlyExploredTilesCapacity = 4096;
+std::vector<Point> NewlyExploredTiles;
+bool NewlyExploredTilesOverflowed;
 /** interpolations of a 32x32 (16x16 mirrored) light circle moving between tiles in steps of 1/8 of a tile */
 uint8_t LightConeInterpolations[8][8][16][16];
 
+/** Set by the light functions, ProcessLightList then only recasts the lights around what moved. */
+bool LightsChanged;
+/** Lights that were added or changed since the last ProcessLightList. */
+std::array<bool, MAXLIGHTS> LightNeedsRelight;
+/** DoorStateGeneration at the last ProcessLightList. */
+uint32_t LitDoorStateGeneration;
+
+/** An area DoUnLight reset to dPreLight, every light reaching into it has to be cast again. */
+struct UnlitArea {
+	WorldTilePosition position;
+	uint8_t radius;
+};
+std::vector<UnlitArea> UnlitAreas;
+
+/** @brief How far from its tile a light can brighten, the same margin DoUnLight resets. */
+int LightReach(uint8_t radius)
+{
+	return radius + 2;
+}
+
+bool TouchesUnlitArea(const Light &light)
+{
+	for (const UnlitArea &area : UnlitAreas) {
+		const int reach = LightReach(light.radius) + LightReach(area.radius);
+		if (std::abs(light.position.tile.x - area.position.x) <= reach && std::abs(light.position.tile.y - area.position.y) <= reach)
+			return true;
+	}
+	return false;
+}
+
 void RotateRadius(DisplacementOf<int8_t> &offset, DisplacementOf<int8_t> &dist, DisplacementOf<int8_t> &light, DisplacementOf<int8_t> &block)
 {
 	dist = { static_cast<int8_t>(7 - dist.deltaY), dist.deltaX };
@@ -90,18 +131,17 @@ DVL_ALWAYS_INLINE uint8_t GetLight(Point position)
 	return dLight[position.x][position.y];
 }
 
-bool TileAllowsLight(Point position)
-{
-	if (!InDungeonBounds(position))
-		return false;
-	return !TileHasAny(position, TileProperties::BlockLight);
-}
-
 void DoVisionFlags(Point position, MapExplorationType doAutomap, bool visible)
 {
 	if (doAutomap != MAP_EXP_NONE) {
 		if (dFlags[position.x][position.y] != DungeonFlag::None)
 			SetAutomapView(position, doAutomap);
+		if (!HasAnyOf(dFlags[position.x][position.y], DungeonFlag::Explored)) {
+			if (NewlyExploredTiles.size() < NewlyExploredTilesCapacity)
+				NewlyExploredTiles.push_back(position);
+			else
+				NewlyExploredTilesOverflowed = true;
+		}
 		dFlags[position.x][position.y] |= DungeonFlag::Explored;
 	}
 	if (visible)
@@ -109,8 +149,124 @@ void DoVisionFlags(Point position, MapExplorationType doAutomap, bool visible)
 	dFlags[position.x][position.y] |= DungeonFlag::Visible;
 }
 
+struct VisionBlockersKey {
+	uint8_t level;
+	bool isSetLevel;
+	_setlevels setLevel;
+	uint32_t objectGeneration;
+
+	bool operator==(const VisionBlockersKey &other) const = default;
+};
+
+/** Tiles that stop light and vision, so rays test a bit instead of the tile's piece properties. */
+Bitset2d<MAXDUNX, MAXDUNY> VisionBlockers;
+std::optional<VisionBlockersKey> VisionBlockersBuiltFor;
+/** Incremented whenever VisionBlockers is rebuilt, which makes every cached vision set stale. */
+uint32_t VisionBlockersVersion;
+
+void UpdateVisionBlockers()
+{
+	const VisionBlockersKey key { currlevel, setlevel, setlvlnum, ObjectWalkabilityGeneration };
+	if (VisionBlockersBuiltFor == key)
+		return;
+	for (int x = 0; x < MAXDUNX; x++) {
+		for (int y = 0; y < MAXDUNY; y++)
+			VisionBlockers.set(x, y, TileHasAny({ x, y }, TileProperties::BlockLight));
+	}
+	VisionBlockersBuiltFor = key;
+	VisionBlockersVersion++;
+}
+
+/** What a ray cast from a position saw, replayed while nothing that blocks light changes. */
+struct VisionCacheSlot {
+	WorldTilePosition position;
+	uint8_t radius;
+	uint32_t blockersVersion;
+	bool valid;
+	uint32_t lastUse;
+	/** Each visible tile once, in the order the rays first reached them. */
+	std::vector<WorldTilePosition> visible;
+	/** Each transparency group seen through once. */
+	std::vector<int8_t> transparent;
+};
+
+/** Enough for every player's vision plus a few revisited positions. */
+std::array<VisionCacheSlot, 8> VisionCache;
+uint32_t VisionCacheClock;
+
+const VisionCacheSlot &GetVisionFrom(Point position, uint8_t radius)
+{
+	UpdateVisionBlockers();
+	VisionCacheClock++;
+
+	const WorldTilePosition tile = position;
+	VisionCacheSlot *slot = &VisionCache[0];
+	for (VisionCacheSlot &candidate : VisionCache) {
+		if (candidate.valid && candidate.position == tile && candidate.radius == radius && candidate.blockersVersion == VisionBlockersVersion) {
+			candidate.lastUse = VisionCacheClock;
+			return candidate;
+		}
+		if (!candidate.valid || (slot->valid && candidate.lastUse < slot->lastUse))
+			slot = &candidate;
+	}
+
+	static Bitset2d<MAXDUNX, MAXDUNY> seen;
+	seen.reset();
+	std::array<bool, 256> seenTrans {};
+	slot->visible.clear();
+	slot->transparent.clear();
+	auto markVisibleFn = [&](Point rayPoint) {
+		if (seen.test(rayPoint.x, rayPoint.y))
+			return;
+		seen.set(rayPoint.x, rayPoint.y);
+		slot->visible.emplace_back(rayPoint);
+	};
+	auto markTransparentFn = [&](Point rayPoint) {
+		const int8_t trans = dTransVal[rayPoint.x][rayPoint.y];
+		if (trans != 0 && !std::exchange(seenTrans[static_cast<uint8_t>(trans)], true))
+			slot->transparent.push_back(trans);
+	};
+	auto passesLightFn = [](Point rayPoint) {
+		return InDungeonBounds(rayPoint) && !VisionBlockers.test(rayPoint.x, rayPoint.y);
+	};
+	auto inBoundsFn = [](Point rayPoint) {
+		return InDungeonBounds(rayPoint);
+	};
+	DoVision(position, radius, markVisibleFn, markTransparentFn, passesLightFn, inBoundsFn);
+
+	slot->position = tile;
+	slot->radius = radius;
+	slot->blockersVersion = VisionBlockersVersion;
+	slot->valid = true;
+	slot->lastUse = VisionCacheClock;
+	return *slot;
+}
+
 } // namespace
 
+bool TakeNewlyExploredTiles(std::vector<Point> &tiles)
+{
+	tiles.clear();
+	tiles.swap(NewlyExploredTiles);
+	const bool complete = !NewlyExploredTilesOverflowed;
+	NewlyExploredTilesOverflowed = false;
+	return complete;
+}
+
+bool IsOccludedFromMyPlayer(Point position)
+{
+	if (MyPlayer == nullptr || !InDungeonBounds(position))
+		return false;
+	if (!VisionActive[MyPlayerId])
+		return false;
+
+	// DoVision only sets Lit for the local player's vision, so this is its line of sight.
+	const Light &vision = VisionList[MyPlayerId];
+	if (vision.position.tile.ApproxDistance(position) > vision.radius)
+		return false;
+	return !HasAnyOf(dFlags[position.x][position.y], DungeonFlag::Lit);
+}
+
 void DoUnLight(Point position, uint8_t radius)
 {
 	radius++;
@@ -203,22 +359,11 @@ void DoUnVision(Point position, uint8_t radius)
 
 void DoVision(Point position, uint8_t radius, MapExplorationType doAutomap, bool visible)
 {
-	auto markVisibleFn = [doAutomap, visible](Point rayPoint) {
-		DoVisionFlags(rayPoint, doAutomap, visible);
-	};
-	auto markTransparentFn = [](Point rayPoint) {
-		const int8_t trans = dTransVal[rayPoint.x][rayPoint.y];
-		if (trans != 0)
-			TransList[trans] = true;
-	};
-	auto passesLightFn = [](Point rayPoint) {
-		return TileAllowsLight(rayPoint);
-	};
-	auto inBoundsFn = [](Point rayPoint) {
-		return InDungeonBounds(rayPoint);
-	};
-
-	DoVision(position, radius, markVisibleFn, markTransparentFn, passesLightFn, inBoundsFn);
+	const VisionCacheSlot &slot = GetVisionFrom(position, radius);
+	for (const WorldTilePosition tile : slot.visible)
+		DoVisionFlags(tile, doAutomap, visible);
+	for (const int8_t trans : slot.transparent)
+		TransList[trans] = true;
 }
 
 tl::expected<void, std::string> LoadTrns()
@@ -255,6 +400,7 @@ void MakeLightTable()
 	}
 
 	LightTables[15] = {}; // Make last shade pitch black
+	LightTablesVersion++;
 	FullyLitLightTable = LightTables[0].data();
 	FullyDarkLightTable = LightTables[LightsMax].data();
 
@@ -343,6 +489,7 @@ void ToggleLighting()
 			DoLighting(player.position.tile, player._pLightRad, {});
 		}
 	}
+	UpdateLighting = true;
 }
 #endif
 
@@ -350,6 +497,8 @@ void InitLighting()
 {
 	ActiveLightCount = 0;
 	UpdateLighting = false;
+	LightsChanged = false;
+	LightNeedsRelight = {};
 	UpdateVision = false;
 #ifdef _DEBUG
 	DisableLighting = false;
@@ -376,8 +525,9 @@ int AddLight(Point position, uint8_t radius)
 	light.position.offset = { 0, 0 };
 	light.isInvalid = false;
 	light.hasChanged = false;
+	LightNeedsRelight[lid] = true;
 
-	UpdateLighting = true;
+	LightsChanged = true;
 
 	return lid;
 }
@@ -393,7 +543,7 @@ void AddUnLight(int i)
 
 	Lights[i].isInvalid = true;
 
-	UpdateLighting = true;
+	LightsChanged = true;
 }
 
 void ChangeLightRadius(int i, uint8_t radius)
@@ -411,7 +561,7 @@ void ChangeLightRadius(int i, uint8_t radius)
 	light.oldRadius = light.radius;
 	light.radius = radius;
 
-	UpdateLighting = true;
+	LightsChanged = true;
 }
 
 void ChangeLightXY(int i, Point position)
@@ -429,7 +579,7 @@ void ChangeLightXY(int i, Point position)
 	light.oldRadius = light.radius;
 	light.position.tile = position;
 
-	UpdateLighting = true;
+	LightsChanged = true;
 }
 
 void ChangeLightOffset(int i, DisplacementOf<int8_t> offset)
@@ -450,7 +600,7 @@ void ChangeLightOffset(int i, DisplacementOf<int8_t> offset)
 	light.oldRadius = light.radius;
 	light.position.offset = offset;
 
-	UpdateLighting = true;
+	LightsChanged = true;
 }
 
 void ChangeLight(int i, Point position, uint8_t radius)
@@ -469,7 +619,7 @@ void ChangeLight(int i, Point position, uint8_t radius)
 	light.position.tile = position;
 	light.radius = radius;
 
-	UpdateLighting = true;
+	LightsChanged = true;
 }
 
 void ProcessLightList()
@@ -478,32 +628,47 @@ void ProcessLightList()
 	if (DisableLighting)
 		return;
 #endif
-	if (!UpdateLighting)
+	// An opened or closed door changes how far the lights that didn't move reach.
+	const bool doorsChanged = LitDoorStateGeneration != DoorStateGeneration;
+	if (!UpdateLighting && !LightsChanged && !doorsChanged)
 		return;
+
+	// While map objects are loading DoLighting writes to dPreLight, so only the full pass is safe.
+	const bool relightAll = UpdateLighting || LoadingMapObjects || doorsChanged;
+	LitDoorStateGeneration = DoorStateGeneration;
+	UnlitAreas.clear();
 	for (int i = 0; i < ActiveLightCount; i++) {
 		Light &light = Lights[ActiveLights[i]];
 		if (light.isInvalid) {
 			DoUnLight(light.position.tile, light.radius);
+			UnlitAreas.push_back({ light.position.tile, light.radius });
 		}
 		if (light.hasChanged) {
 			DoUnLight(light.position.old, light.oldRadius);
+			UnlitAreas.push_back({ light.position.old, light.oldRadius });
 			light.hasChanged = false;
+			LightNeedsRelight[ActiveLights[i]] = true;
 		}
 	}
 	for (int i = 0; i < ActiveLightCount; i++) {
-		const Light &light = Lights[ActiveLights[i]];
+		const int lid = ActiveLights[i];
+		const Light &light = Lights[lid];
 		if (light.isInvalid) {
 			ActiveLightCount--;
 			std::swap(ActiveLights[ActiveLightCount], ActiveLights[i]);
 			i--;
 			continue;
 		}
+		const bool needsRelight = std::exchange(LightNeedsRelight[lid], false);
+		if (!relightAll && !needsRelight && !TouchesUnlitArea(light))
+			continue; // What this light cast last time is still in dLight
 		if (TileHasAny(light.position.tile, TileProperties::Solid))
 			continue; // Monster hidden in a wall, don't spoil the surprise
 		DoLighting(light.position.tile, light.radius, light.position.offset);
 	}
 
 	UpdateLighting = false;
+	LightsChanged = false;
 }
 
 void SavePreLighting()
@@ -585,6 +750,7 @@ void ProcessVisionList()
 
 void lighting_color_cycling()
 {
+	LightTablesVersion++;
 	for (auto &lightTable : LightTables) {
 		// shift elements between indexes 1-31 to left
 		std::rotate(lightTable.begin() + 1, lightTable.begin() + 2, lightTable.begin() + 32);
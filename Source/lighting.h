@@ -7,6 +7,7 @@
 
 #include <array>
 #include <cstdint>
+#include <vector>
 
 #include <expected.hpp>
 
@@ -45,14 +46,29 @@ extern DVL_API_FOR_TEST std::array<std::array<uint8_t, LightTableSize>, NumLight
 extern DVL_API_FOR_TEST uint8_t *FullyLitLightTable;
 /** @brief Contains a pointer to a light table that is fully dark (every color result to 0/black). Can be null in hellfire levels. */
 extern DVL_API_FOR_TEST uint8_t *FullyDarkLightTable;
+/** @brief Changes whenever the light tables do, for caches of lit graphics. */
+extern uint32_t LightTablesVersion;
 extern std::array<uint8_t, 256> InfravisionTable;
 extern std::array<uint8_t, 256> StoneTable;
 extern std::array<uint8_t, 256> PauseTable;
 #ifdef _DEBUG
 extern bool DisableLighting;
 #endif
+/** @brief Makes the next ProcessLightList cast every light again, for code that wrote to dLight or dPreLight itself. */
 extern bool UpdateLighting;
 
+/**
+ * @brief Hands over the tiles that became explored since the last call.
+ * @param tiles Receives the tiles; its previous contents are discarded.
+ * @return False if too many tiles were explored to be recorded, `tiles` is then incomplete.
+ */
+bool TakeNewlyExploredTiles(std::vector<Point> &tiles);
+/**
+ * @brief Whether a wall blocks the local player's line of sight to the tile, as of the last vision pass.
+ *
+ * Tiles beyond the vision radius aren't reported as occluded since the vision pass didn't reach them.
+ */
+bool IsOccludedFromMyPlayer(Point position);
 void DoUnLight(Point position, uint8_t radius);
 void DoLighting(Point position, uint8_t radius, DisplacementOf<int8_t> offset);
 void DoUnVision(Point position, uint8_t radius);
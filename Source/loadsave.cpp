@@ -183,18 +183,65 @@ public:
 	{
 		return Next<uint32_t>() != 0;
 	}
+
+	/**
+	 * @brief Reads a grid saved row by row (y outer, x inner) with one bounds check for the whole grid.
+	 *
+	 * If what is left of the file is shorter than the grid, nothing is read and the whole grid is filled with `convert(0)`.
+	 * @param convert Turns each saved value into the grid's type
+	 */
+	template <class TSource, typename T, size_t Width, size_t Height, typename Convert>
+	void NextGridLE(T (&grid)[Width][Height], Convert &&convert)
+	{
+		NextGrid<TSource, /*BigEndian=*/false>(grid, convert);
+	}
+
+	template <class TSource, typename T, size_t Width, size_t Height>
+	void NextGridLE(T (&grid)[Width][Height])
+	{
+		NextGridLE<TSource>(grid, [](TSource value) { return static_cast<T>(value); });
+	}
+
+	template <class TSource, typename T, size_t Width, size_t Height, typename Convert>
+	void NextGridBE(T (&grid)[Width][Height], Convert &&convert)
+	{
+		NextGrid<TSource, /*BigEndian=*/true>(grid, convert);
+	}
+
+private:
+	template <class TSource, bool BigEndian, typename T, size_t Width, size_t Height, typename Convert>
+	void NextGrid(T (&grid)[Width][Height], Convert &convert)
+	{
+		constexpr size_t Size = sizeof(TSource) * Width * Height;
+		if (!IsValid(Size)) {
+			for (auto &column : grid)
+				std::fill(std::begin(column), std::end(column), convert(TSource {}));
+			return;
+		}
+
+		const std::byte *src = &m_buffer_[m_cur_];
+		for (size_t j = 0; j < Height; j++) {
+			for (size_t i = 0; i < Width; i++) { // NOLINT(modernize-loop-convert)
+				TSource value;
+				memcpy(&value, src, sizeof(TSource));
+				src += sizeof(TSource);
+				grid[i][j] = convert(BigEndian ? SwapBE(value) : SwapLE(value));
+			}
+		}
+		m_cur_ += Size;
+	}
 };
 
 class SaveHelper {
-	SaveWriter &m_mpqWriter;
+	SaveBatch &m_saveBatch;
 	const char *m_szFileName_;
 	std::unique_ptr<std::byte[]> m_buffer_;
 	size_t m_cur_ = 0;
 	size_t m_capacity_;
 
 public:
-	SaveHelper(SaveWriter &mpqWriter, const char *szFileName, size_t bufferLen)
-	    : m_mpqWriter(mpqWriter)
+	SaveHelper(SaveBatch &saveBatch, const char *szFileName, size_t bufferLen)
+	    : m_saveBatch(saveBatch)
 	    , m_szFileName_(szFileName)
 	    , m_buffer_(new std::byte[codec_get_encoded_len(bufferLen)])
 	    , m_capacity_(bufferLen)
@@ -247,10 +294,7 @@ public:
 
 	~SaveHelper()
 	{
-		const auto encodedLen = codec_get_encoded_len(m_cur_);
-		const char *const password = pfile_get_password();
-		codec_encode(m_buffer_.get(), m_cur_, encodedLen, password);
-		m_mpqWriter.WriteFile(m_szFileName_, m_buffer_.get(), encodedLen);
+		m_saveBatch.AddFile(m_szFileName_, std::move(m_buffer_), m_cur_);
 	}
 };
 
@@ -1859,11 +1903,11 @@ void SaveDroppedItemLocations(SaveHelper &file, const ankerl::unordered_dense::m
 
 constexpr uint32_t VersionAdditionalMissiles = 0;
 
-void SaveAdditionalMissiles(SaveWriter &saveWriter)
+void SaveAdditionalMissiles(SaveBatch &saveBatch)
 {
 	constexpr size_t BytesWrittenBySaveMissile = 180;
 	const uint32_t missileCountAdditional = (Missiles.size() > MaxMissilesForSaveGame) ? static_cast<uint32_t>(Missiles.size() - MaxMissilesForSaveGame) : 0;
-	SaveHelper file(saveWriter, "additionalMissiles", sizeof(uint32_t) + sizeof(uint32_t) + (missileCountAdditional * BytesWrittenBySaveMissile));
+	SaveHelper file(saveBatch, "additionalMissiles", sizeof(uint32_t) + sizeof(uint32_t) + (missileCountAdditional * BytesWrittenBySaveMissile));
 
 	file.WriteLE<uint32_t>(VersionAdditionalMissiles);
 	file.WriteLE<uint32_t>(missileCountAdditional);
@@ -1898,9 +1942,9 @@ void LoadAdditionalMissiles()
 	}
 }
 
-void SaveLevelSeeds(SaveWriter &saveWriter)
+void SaveLevelSeeds(SaveBatch &saveBatch)
 {
-	SaveHelper file(saveWriter, "levelseeds", giNumberOfLevels * (sizeof(uint8_t) + sizeof(uint32_t)));
+	SaveHelper file(saveBatch, "levelseeds", giNumberOfLevels * (sizeof(uint8_t) + sizeof(uint32_t)));
 
 	for (int i = 0; i < giNumberOfLevels; i++) {
 		file.WriteLE<uint8_t>(LevelSeeds[i] ? 1 : 0);
@@ -1925,7 +1969,7 @@ void LoadLevelSeeds()
 	}
 }
 
-void SaveLevel(SaveWriter &saveWriter, LevelConversionData *levelConversionData)
+void SaveLevel(SaveBatch &saveBatch, LevelConversionData *levelConversionData)
 {
 	Player &myPlayer = *MyPlayer;
 
@@ -1936,7 +1980,7 @@ void SaveLevel(SaveWriter &saveWriter, LevelConversionData *levelConversionData)
 
 	char szName[MaxMpqPathSize];
 	GetTempLevelNames(szName);
-	SaveHelper file(saveWriter, szName, 256 * 1024);
+	SaveHelper file(saveBatch, szName, 256 * 1024);
 
 	if (leveltype != DTYPE_TOWN) {
 		for (int j = 0; j < MAXDUNY; j++) {
@@ -2016,10 +2060,8 @@ tl::expected<void, std::string> LoadLevel(LevelConversionData *levelConversionDa
 		return tl::make_unexpected(std::string(_("Unable to open save file archive")));
 
 	if (leveltype != DTYPE_TOWN) {
-		for (int j = 0; j < MAXDUNY; j++) {
-			for (int i = 0; i < MAXDUNX; i++) // NOLINT(modernize-loop-convert)
-				dCorpse[i][j] = file.NextLE<int8_t>();
-		}
+		file.NextGridLE<int8_t>(dCorpse);
+		SyncCorpseEntries();
 		MoveLightsToCorpses();
 	}
 
@@ -2050,39 +2092,23 @@ tl::expected<void, std::string> LoadLevel(LevelConversionData *levelConversionDa
 
 	LoadDroppedItems(file, savedItemCount);
 
-	for (int j = 0; j < MAXDUNY; j++) {
-		for (int i = 0; i < MAXDUNX; i++) // NOLINT(modernize-loop-convert)
-			dFlags[i][j] = static_cast<DungeonFlag>(file.NextLE<uint8_t>()) & DungeonFlag::LoadedFlags;
-	}
+	file.NextGridLE<uint8_t>(dFlags, [](uint8_t flags) { return static_cast<DungeonFlag>(flags) & DungeonFlag::LoadedFlags; });
 
 	// skip dItem indexes, this gets populated in LoadDroppedItems
 	file.Skip<uint8_t>(MAXDUNX * MAXDUNY);
 
 	if (leveltype != DTYPE_TOWN) {
-		for (int j = 0; j < MAXDUNY; j++) {
-			for (int i = 0; i < MAXDUNX; i++) // NOLINT(modernize-loop-convert)
-			{
-				dMonster[i][j] = file.NextBE<int32_t>();
-				if (dMonster[i][j] > 0 && removedMonsterIds.contains(std::abs(dMonster[i][j]) - 1)) {
-					dMonster[i][j] = 0;
-				}
-			}
-		}
-		for (int j = 0; j < MAXDUNY; j++) {
-			for (int i = 0; i < MAXDUNX; i++) // NOLINT(modernize-loop-convert)
-				dObject[i][j] = file.NextLE<int8_t>();
-		}
+		file.NextGridBE<int32_t>(dMonster, [&removedMonsterIds](int32_t monsterId) -> int16_t {
+			if (monsterId > 0 && removedMonsterIds.contains(std::abs(monsterId) - 1))
+				return 0;
+			return static_cast<int16_t>(monsterId);
+		});
+		file.NextGridLE<int8_t>(dObject);
 		file.Skip<uint8_t>(MAXDUNY * MAXDUNX); // dLight
-		for (int j = 0; j < MAXDUNY; j++) {
-			for (int i = 0; i < MAXDUNX; i++) // NOLINT(modernize-loop-convert)
-				dPreLight[i][j] = file.NextLE<uint8_t>();
-		}
-		for (int j = 0; j < DMAXY; j++) {
-			for (int i = 0; i < DMAXX; i++) { // NOLINT(modernize-loop-convert)
-				const auto automapView = static_cast<MapExplorationType>(file.NextLE<uint8_t>());
-				AutomapView[i][j] = automapView == MAP_EXP_OLD ? MAP_EXP_SELF : automapView;
-			}
-		}
+		file.NextGridLE<uint8_t>(dPreLight);
+		file.NextGridLE<uint8_t>(AutomapView, [](uint8_t automapView) -> uint8_t {
+			return automapView == MAP_EXP_OLD ? MAP_EXP_SELF : automapView;
+		});
 
 		// No need to load dLight, we can recreate it accurately from LightList
 		memcpy(dLight, dPreLight, sizeof(dLight));                                     // resets the light on entering a level to get rid of incorrect light
@@ -2145,7 +2171,9 @@ tl::expected<void, std::string> ConvertLevels(SaveWriter &saveWriter)
 
 		LevelConversionData levelConversionData;
 		RETURN_IF_ERROR(LoadLevel(&levelConversionData));
-		SaveLevel(saveWriter, &levelConversionData);
+		SaveBatch saveBatch;
+		SaveLevel(saveBatch, &levelConversionData);
+		saveBatch.Write(saveWriter, pfile_get_password());
 	}
 
 	setlevel = true; // Convert quest levels
@@ -2165,7 +2193,9 @@ tl::expected<void, std::string> ConvertLevels(SaveWriter &saveWriter)
 
 		LevelConversionData levelConversionData;
 		RETURN_IF_ERROR(LoadLevel(&levelConversionData));
-		SaveLevel(saveWriter, &levelConversionData);
+		SaveBatch saveBatch;
+		SaveLevel(saveBatch, &levelConversionData);
+		saveBatch.Write(saveWriter, pfile_get_password());
 	}
 
 	gbSkipSync = false;
@@ -2371,9 +2401,9 @@ void LoadHotkeys()
 	myPlayer._pRSplType = static_cast<SpellType>(file.NextLE<uint8_t>());
 }
 
-void SaveHotkeys(SaveWriter &saveWriter, const Player &player)
+void SaveHotkeys(SaveBatch &saveBatch, const Player &player)
 {
-	SaveHelper file(saveWriter, "hotkeys", HotkeysSize());
+	SaveHelper file(saveBatch, "hotkeys", HotkeysSize());
 
 	// Write the number of spell hotkeys
 	file.WriteLE<uint8_t>(static_cast<uint8_t>(NumHotkeys));
@@ -2598,47 +2628,26 @@ tl::expected<void, std::string> LoadGame(bool firstflag)
 		uniqueItemFlag = file.NextBool8();
 
 	file.Skip<uint8_t>(MAXDUNY * MAXDUNX); // dLight
-	for (int j = 0; j < MAXDUNY; j++) {
-		for (int i = 0; i < MAXDUNX; i++) // NOLINT(modernize-loop-convert)
-			dFlags[i][j] = static_cast<DungeonFlag>(file.NextLE<uint8_t>()) & DungeonFlag::LoadedFlags;
-	}
-	for (int j = 0; j < MAXDUNY; j++) {
-		for (int i = 0; i < MAXDUNX; i++) // NOLINT(modernize-loop-convert)
-			dPlayer[i][j] = file.NextLE<int8_t>();
-	}
+	file.NextGridLE<uint8_t>(dFlags, [](uint8_t flags) { return static_cast<DungeonFlag>(flags) & DungeonFlag::LoadedFlags; });
+	file.NextGridLE<int8_t>(dPlayer);
 
 	// skip dItem indexes, this gets populated in LoadDroppedItems
 	file.Skip<uint8_t>(MAXDUNX * MAXDUNY);
 
 	if (leveltype != DTYPE_TOWN) {
-		for (int j = 0; j < MAXDUNY; j++) {
-			for (int i = 0; i < MAXDUNX; i++) // NOLINT(modernize-loop-convert)
-			{
-				dMonster[i][j] = file.NextBE<int32_t>();
-				if (dMonster[i][j] > 0 && removedMonsterIds.contains(std::abs(dMonster[i][j]) - 1)) {
-					dMonster[i][j] = 0;
-				}
-			}
-		}
-		for (int j = 0; j < MAXDUNY; j++) {
-			for (int i = 0; i < MAXDUNX; i++) // NOLINT(modernize-loop-convert)
-				dCorpse[i][j] = file.NextLE<int8_t>();
-		}
-		for (int j = 0; j < MAXDUNY; j++) {
-			for (int i = 0; i < MAXDUNX; i++) // NOLINT(modernize-loop-convert)
-				dObject[i][j] = file.NextLE<int8_t>();
-		}
+		file.NextGridBE<int32_t>(dMonster, [&removedMonsterIds](int32_t monsterId) -> int16_t {
+			if (monsterId > 0 && removedMonsterIds.contains(std::abs(monsterId) - 1))
+				return 0;
+			return static_cast<int16_t>(monsterId);
+		});
+		file.NextGridLE<int8_t>(dCorpse);
+		SyncCorpseEntries();
+		file.NextGridLE<int8_t>(dObject);
 		file.Skip<uint8_t>(MAXDUNY * MAXDUNX); // dLight
-		for (int j = 0; j < MAXDUNY; j++) {
-			for (int i = 0; i < MAXDUNX; i++) // NOLINT(modernize-loop-convert)
-				dPreLight[i][j] = file.NextLE<uint8_t>();
-		}
-		for (int j = 0; j < DMAXY; j++) {
-			for (int i = 0; i < DMAXX; i++) { // NOLINT(modernize-loop-convert)
-				const auto automapView = static_cast<MapExplorationType>(file.NextLE<uint8_t>());
-				AutomapView[i][j] = automapView == MAP_EXP_OLD ? MAP_EXP_SELF : automapView;
-			}
-		}
+		file.NextGridLE<uint8_t>(dPreLight);
+		file.NextGridLE<uint8_t>(AutomapView, [](uint8_t automapView) -> uint8_t {
+			return automapView == MAP_EXP_OLD ? MAP_EXP_SELF : automapView;
+		});
 		file.Skip(MAXDUNX * MAXDUNY); // dMissile
 
 		// No need to load dLight, we can recreate it accurately from LightList
@@ -2687,10 +2696,10 @@ tl::expected<void, std::string> LoadGame(bool firstflag)
 	return {};
 }
 
-void SaveHeroItems(SaveWriter &saveWriter, Player &player)
+void SaveHeroItems(SaveBatch &saveBatch, Player &player)
 {
 	const size_t itemCount = static_cast<size_t>(NUM_INVLOC) + InventoryGridCells + MaxBeltItems;
-	SaveHelper file(saveWriter, "heroitems", itemCount * (gbIsHellfire ? HellfireItemSaveSize : DiabloItemSaveSize) + sizeof(uint8_t));
+	SaveHelper file(saveBatch, "heroitems", itemCount * (gbIsHellfire ? HellfireItemSaveSize : DiabloItemSaveSize) + sizeof(uint8_t));
 
 	file.WriteLE<uint8_t>(gbIsHellfire ? 1 : 0);
 
@@ -2702,7 +2711,7 @@ void SaveHeroItems(SaveWriter &saveWriter, Player &player)
 		SaveItem(file, item);
 }
 
-void SaveStash(SaveWriter &stashWriter)
+void SaveStash(SaveBatch &stashBatch)
 {
 	const char *filename;
 	if (!gbIsMultiplayer)
@@ -2713,7 +2722,7 @@ void SaveStash(SaveWriter &stashWriter)
 	const int itemSize = (gbIsHellfire ? HellfireItemSaveSize : DiabloItemSaveSize);
 
 	SaveHelper file(
-	    stashWriter,
+	    stashBatch,
 	    filename,
 	    sizeof(uint8_t)
 	        + sizeof(uint32_t)
@@ -2759,9 +2768,9 @@ void SaveStash(SaveWriter &stashWriter)
 	file.WriteLE<uint32_t>(static_cast<uint32_t>(Stash.GetPage()));
 }
 
-void SaveGameData(SaveWriter &saveWriter)
+void SaveGameData(SaveBatch &saveBatch)
 {
-	SaveHelper file(saveWriter, "game", 320 * 1024);
+	SaveHelper file(saveBatch, "game", 320 * 1024);
 
 	if (gbIsSpawn && !gbIsHellfire)
 		file.WriteLE<uint32_t>(LoadLE32("SHAR"));
@@ -2922,8 +2931,8 @@ void SaveGameData(SaveWriter &saveWriter)
 	file.WriteLE<uint8_t>(AutomapActive ? 1 : 0);
 	file.WriteBE<int32_t>(AutoMapScale);
 
-	SaveAdditionalMissiles(saveWriter);
-	SaveLevelSeeds(saveWriter);
+	SaveAdditionalMissiles(saveBatch);
+	SaveLevelSeeds(saveBatch);
 }
 
 void SaveGame()
@@ -2933,9 +2942,9 @@ void SaveGame()
 	sfile_write_stash();
 }
 
-void SaveLevel(SaveWriter &saveWriter)
+void SaveLevel(SaveBatch &saveBatch)
 {
-	SaveLevel(saveWriter, nullptr);
+	SaveLevel(saveBatch, nullptr);
 }
 
 tl::expected<void, std::string> LoadLevel()
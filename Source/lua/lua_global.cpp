@@ -1,7 +1,16 @@
 #include "lua/lua_global.hpp"
 
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
 #include <optional>
+#include <span>
 #include <string_view>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
 
 #include <ankerl/unordered_dense.h>
 #include <sol/debug.hpp>
@@ -12,6 +21,8 @@
 #include "appfat.h"
 #include "effects.h"
 #include "engine/assets.hpp"
+#include "engine/converted_asset_cache.hpp"
+#include "lua/metadoc.hpp"
 #include "lua/modules/audio.hpp"
 #include "lua/modules/floatingnumbers.hpp"
 #include "lua/modules/hellfire.hpp"
@@ -28,8 +39,10 @@
 #include "player.h"
 #include "plrmsg.h"
 #include "utils/console.h"
+#include "utils/fnv1a.hpp"
 #include "utils/log.hpp"
 #include "utils/str_cat.hpp"
+#include "utils/string_view_hash.hpp"
 
 #ifdef _DEBUG
 #include "lua/modules/dev.hpp"
@@ -40,18 +53,87 @@ namespace devilution {
 
 namespace {
 
+/**
+ * The events of one kind fired during a game tick, handed to the handlers added with addBatched()
+ * in one call. Lua sees it as userdata that is only valid during that call.
+ */
+template <typename Subject>
+struct LuaEventBatch {
+	struct Event {
+		const Subject *subject;
+		int64_t arg1;
+		int64_t arg2;
+	};
+
+	std::vector<Event> events;
+
+	/** @brief The event at a 1-based Lua index, nullptr if there is none. */
+	[[nodiscard]] const Event *At(size_t index) const
+	{
+		return index >= 1 && index <= events.size() ? &events[index - 1] : nullptr;
+	}
+};
+
+/** An event's trigger resolved once, so firing it doesn't look it up in the events table again. */
+struct LuaEventHandle {
+	sol::protected_function trigger;
+	/** The functions the trigger calls, if the event exposes them. */
+	std::optional<sol::table> handlers;
+	std::optional<sol::protected_function> triggerBatch;
+	std::optional<sol::table> batchedHandlers;
+	std::variant<std::monostate, LuaEventBatch<Player>, LuaEventBatch<Monster>> batch;
+
+	[[nodiscard]] bool HasHandlers() const
+	{
+		return !handlers.has_value() || handlers->size() != 0;
+	}
+
+	[[nodiscard]] bool HasBatchedHandlers() const
+	{
+		return triggerBatch.has_value() && batchedHandlers.has_value() && batchedHandlers->size() != 0;
+	}
+};
+
 struct LuaState {
 	sol::state sol = {};
 	sol::table commonPackages = {};
 	ankerl::unordered_dense::segmented_map<std::string, sol::bytecode> compiledScripts = {};
 	sol::environment sandbox = {};
 	sol::table events = {};
+	/**
+	 * Resolved on first use, nothing for names that aren't an event. Cleared when the events table is
+	 * reloaded, and segmented so an event fired from a handler doesn't move the handle being called.
+	 */
+	ankerl::unordered_dense::segmented_map<std::string, std::optional<LuaEventHandle>, StringViewHash, StringViewEquals> eventHandles = {};
 };
 
 std::optional<LuaState> CurrentLuaState;
 
 std::vector<tl::function_ref<void()>> IsModChangeHandlers;
 
+template <typename Subject>
+void InitLuaEventBatchUserType(sol::state_view &lua)
+{
+	using Batch = LuaEventBatch<Subject>;
+	sol::usertype<Batch> batchType = lua.new_usertype<Batch>(sol::no_constructor);
+	batchType[sol::meta_function::length] = [](const Batch &batch) { return batch.events.size(); };
+	LuaSetDocFn(batchType, "subject", "(index: integer)", "The player or monster of the event at the 1-based index, the first argument of trigger.",
+	    [](const Batch &batch, size_t index) -> const Subject * {
+		    const auto *event = batch.At(index);
+		    return event != nullptr ? event->subject : nullptr;
+	    });
+	LuaSetDocFn(batchType, "arg1", "(index: integer)", "The second argument of trigger for the event at the 1-based index.",
+	    [](const Batch &batch, size_t index) -> std::optional<int64_t> {
+		    const auto *event = batch.At(index);
+		    return event != nullptr ? std::optional<int64_t>(event->arg1) : std::nullopt;
+	    });
+	LuaSetDocFn(batchType, "arg2", "(index: integer)", "The third argument of trigger for the event at the 1-based index.",
+	    [](const Batch &batch, size_t index) -> std::optional<int64_t> {
+		    const auto *event = batch.At(index);
+		    return event != nullptr ? std::optional<int64_t>(event->arg2) : std::nullopt;
+	    });
+}
+
 // A Lua function that we use to generate a `require` implementation.
 constexpr std::string_view RequireGenSrc = R"lua(
 function requireGen(env, loaded, loadFn)
@@ -71,6 +153,21 @@ function requireGen(env, loaded, loadFn)
 end
 )lua";
 
+/** Bump whenever the bytecode cached for a script changes for the same source. */
+constexpr uint32_t LuaBytecodeCacheVersion = 1;
+
+ConvertedAssetKey LuaBytecodeCacheKey(std::string_view path, std::string_view source)
+{
+	ConvertedAssetKey key { LuaBytecodeCacheVersion };
+	// Lua refuses bytecode of another release or number format, don't even try it.
+	key.Add(LUA_VERSION_RELEASE_NUM);
+	key.Add(sizeof(lua_Integer) | (sizeof(lua_Number) << 8) | (sizeof(size_t) << 16));
+	// The path ends up in the debug information of the bytecode.
+	key.Add(Fnv1a(std::as_bytes(std::span { path })));
+	key.Add(Fnv1a(std::as_bytes(std::span { source })));
+	return key;
+}
+
 sol::object LuaLoadScriptFromAssets(std::string_view packageName)
 {
 	LuaState &luaState = *CurrentLuaState;
@@ -91,14 +188,31 @@ sol::object LuaLoadScriptFromAssets(std::string_view packageName)
 		sol::stack::push(luaState.sol.lua_state(), assetData.error());
 		return sol::stack_object(luaState.sol.lua_state(), -1);
 	}
-	const sol::load_result result = luaState.sol.load(std::string_view(*assetData), path, sol::load_mode::text);
+	const std::string_view source { *assetData };
+
+	// Scripts compiled on an earlier run are loaded from the on-disk cache instead of being compiled again.
+	const ConvertedAssetKey cacheKey = LuaBytecodeCacheKey(path, source);
+	size_t cachedSize;
+	if (const std::unique_ptr<std::byte[]> cached = LoadConvertedAsset(cacheKey, cachedSize); cached != nullptr) {
+		sol::bytecode bytecode;
+		bytecode.assign(cached.get(), cached.get() + cachedSize);
+		const sol::load_result result = luaState.sol.load(bytecode.as_string_view(), path, sol::load_mode::binary);
+		if (result.valid()) {
+			luaState.compiledScripts[path] = std::move(bytecode);
+			return result;
+		}
+		LogVerbose("Ignoring the cached bytecode of {}: {}", path, result.get<std::string>());
+	}
+
+	const sol::load_result result = luaState.sol.load(source, path, sol::load_mode::text);
 	if (!result.valid()) {
 		sol::stack::push(luaState.sol.lua_state(),
 		    StrCat("Lua error when loading ", path, ": ", result.get<std::string>()));
 		return sol::stack_object(luaState.sol.lua_state(), -1);
 	}
 	const sol::function fn = result;
-	luaState.compiledScripts[path] = fn.dump();
+	const sol::bytecode &bytecode = luaState.compiledScripts[path] = fn.dump();
+	StoreConvertedAsset(cacheKey, std::span<const std::byte>(bytecode.data(), bytecode.size()));
 	return result;
 }
 
@@ -221,6 +335,7 @@ void LuaReloadActiveMods()
 	// Loaded without a sandbox.
 	CurrentLuaState->events = RunScript(/*env=*/std::nullopt, "devilutionx.events", /*optional=*/false);
 	CurrentLuaState->commonPackages["devilutionx.events"] = CurrentLuaState->events;
+	CurrentLuaState->eventHandles.clear();
 
 	gbIsHellfire = false;
 	UnloadModArchives();
@@ -276,6 +391,9 @@ void LuaInitialize()
 	// Registering devilutionx object table
 	SafeCallResult(lua.safe_script(RequireGenSrc), /*optional=*/false);
 
+	InitLuaEventBatchUserType<Player>(lua);
+	InitLuaEventBatchUserType<Monster>(lua);
+
 	CurrentLuaState->commonPackages = lua.create_table_with(
 #ifdef _DEBUG
 	    "devilutionx.dev", LuaDevModule(lua),
@@ -314,20 +432,75 @@ void LuaShutdown()
 	CurrentLuaState = std::nullopt;
 }
 
+/** @brief The event to trigger, nullptr if there is no such event or no handler was added to it. */
+LuaEventHandle *GetLuaEventHandle(std::string_view name)
+{
+	if (!CurrentLuaState.has_value())
+		return nullptr;
+	LuaState &luaState = *CurrentLuaState;
+	auto it = luaState.eventHandles.find(name);
+	if (it == luaState.eventHandles.end()) {
+		std::optional<LuaEventHandle> handle;
+		const auto trigger = luaState.events.traverse_get<std::optional<sol::object>>(name, "trigger");
+		if (trigger.has_value() && trigger->is<sol::protected_function>()) {
+			handle = LuaEventHandle {
+				.trigger = trigger->as<sol::protected_function>(),
+				.handlers = luaState.events.traverse_get<std::optional<sol::table>>(name, "__handlers"),
+				.triggerBatch = luaState.events.traverse_get<std::optional<sol::protected_function>>(name, "triggerBatch"),
+				.batchedHandlers = luaState.events.traverse_get<std::optional<sol::table>>(name, "__batchedHandlers"),
+			};
+		} else {
+			LogError("events.{}.trigger is not a function", name);
+		}
+		it = luaState.eventHandles.emplace(std::string(name), std::move(handle)).first;
+	}
+
+	std::optional<LuaEventHandle> &handle = it->second;
+	if (!handle.has_value() || (!handle->HasHandlers() && !handle->HasBatchedHandlers()))
+		return nullptr;
+	return &*handle;
+}
+
 template <typename... Args>
 void CallLuaEvent(std::string_view name, Args &&...args)
 {
-	if (!CurrentLuaState.has_value()) {
+	const LuaEventHandle *handle = GetLuaEventHandle(name);
+	if (handle == nullptr || !handle->HasHandlers())
 		return;
-	}
+	SafeCallResult(handle->trigger(std::forward<Args>(args)...), /*optional=*/true);
+}
 
-	const auto trigger = CurrentLuaState->events.traverse_get<std::optional<sol::object>>(name, "trigger");
-	if (!trigger.has_value() || !trigger->is<sol::protected_function>()) {
-		LogError("events.{}.trigger is not a function", name);
+/** @brief Calls the event's handlers now and keeps it for the batched handlers. */
+template <typename Subject>
+void CallOrBatchLuaEvent(std::string_view name, const Subject *subject, int64_t arg1, int64_t arg2, int argCount)
+{
+	LuaEventHandle *handle = GetLuaEventHandle(name);
+	if (handle == nullptr)
 		return;
+	if (handle->HasHandlers()) {
+		if (argCount == 1)
+			SafeCallResult(handle->trigger(subject, arg1), /*optional=*/true);
+		else
+			SafeCallResult(handle->trigger(subject, arg1, arg2), /*optional=*/true);
+	}
+	if (handle->HasBatchedHandlers()) {
+		if (!std::holds_alternative<LuaEventBatch<Subject>>(handle->batch))
+			handle->batch.emplace<LuaEventBatch<Subject>>();
+		std::get<LuaEventBatch<Subject>>(handle->batch).events.push_back({ subject, arg1, arg2 });
+	}
+}
+
+template <typename Subject>
+void TriggerLuaEventBatch(const LuaEventHandle &handle, LuaEventBatch<Subject> &batch)
+{
+	// Events fired by the handlers go into the next batch.
+	LuaEventBatch<Subject> triggered;
+	std::swap(triggered.events, batch.events);
+	SafeCallResult((*handle.triggerBatch)(std::ref(triggered)), /*optional=*/true);
+	if (batch.events.empty()) {
+		triggered.events.clear();
+		std::swap(triggered.events, batch.events);
 	}
-	const sol::protected_function fn = trigger->as<sol::protected_function>();
-	SafeCallResult(fn(std::forward<Args>(args)...), /*optional=*/true);
 }
 
 void LuaEvent(std::string_view name)
@@ -337,32 +510,42 @@ void LuaEvent(std::string_view name)
 
 void LuaEvent(std::string_view name, const Player *player, int arg1, int arg2)
 {
-	CallLuaEvent(name, player, arg1, arg2);
+	CallOrBatchLuaEvent(name, player, arg1, arg2, /*argCount=*/2);
 }
 
 void LuaEvent(std::string_view name, const Monster *monster, int arg1, int arg2)
 {
-	CallLuaEvent(name, monster, arg1, arg2);
+	CallOrBatchLuaEvent(name, monster, arg1, arg2, /*argCount=*/2);
 }
 
 void LuaEvent(std::string_view name, const Player *player, uint32_t arg1)
 {
-	CallLuaEvent(name, player, arg1);
+	CallOrBatchLuaEvent(name, player, arg1, 0, /*argCount=*/1);
 }
 
 void LuaEvent(std::string_view name, std::string_view arg)
 {
-	if (!CurrentLuaState.has_value()) {
-		return;
-	}
+	CallLuaEvent(name, arg);
+}
 
-	const auto trigger = CurrentLuaState->events.traverse_get<std::optional<sol::object>>(name, "trigger");
-	if (!trigger.has_value() || !trigger->is<sol::protected_function>()) {
-		LogError("events.{}.trigger is not a function", name);
+void LuaFlushEventBatches()
+{
+	if (!CurrentLuaState.has_value())
 		return;
+	// By index, handlers may fire events that haven't been resolved yet.
+	auto &handles = CurrentLuaState->eventHandles.values();
+	for (size_t i = 0; i < handles.size(); i++) {
+		std::optional<LuaEventHandle> &handle = handles[i].second;
+		if (!handle.has_value() || !handle->triggerBatch.has_value())
+			continue;
+		std::visit([&](auto &batch) {
+			if constexpr (!std::is_same_v<std::decay_t<decltype(batch)>, std::monostate>) {
+				if (!batch.events.empty())
+					TriggerLuaEventBatch(*handle, batch);
+			}
+		},
+		    handle->batch);
 	}
-	const sol::protected_function fn = trigger->as<sol::protected_function>();
-	SafeCallResult(fn(arg), /*optional=*/true);
 }
 
 sol::state &GetLuaState()
@@ -370,6 +553,16 @@ sol::state &GetLuaState()
 	return CurrentLuaState->sol;
 }
 
+size_t LuaMemoryUsage()
+{
+	if (!CurrentLuaState)
+		return 0;
+	size_t bytes = CurrentLuaState->sol.memory_used();
+	for (const auto &[name, bytecode] : CurrentLuaState->compiledScripts)
+		bytes += bytecode.size();
+	return bytes;
+}
+
 sol::object SafeCallResult(sol::protected_function_result result, bool optional)
 {
 	const bool valid = result.valid();
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <string_view>
 
 #include <expected.hpp>
@@ -19,7 +20,11 @@ void LuaEvent(std::string_view name, std::string_view arg);
 void LuaEvent(std::string_view name, const Player *player, int arg1, int arg2);
 void LuaEvent(std::string_view name, const Monster *monster, int arg1, int arg2);
 void LuaEvent(std::string_view name, const Player *player, uint32_t arg1);
+/** @brief Hands the player and monster events of the tick to the handlers added with addBatched(), call once per game tick. */
+void LuaFlushEventBatches();
 sol::state &GetLuaState();
+/** @brief Bytes allocated by the Lua state and the compiled scripts, 0 before LuaInitialize. */
+size_t LuaMemoryUsage();
 sol::environment CreateLuaSandbox();
 sol::object SafeCallResult(sol::protected_function_result result, bool optional);
 
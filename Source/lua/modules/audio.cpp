@@ -1,11 +1,19 @@
 #include "lua/modules/audio.hpp"
 
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
 #include <magic_enum/magic_enum.hpp>
 #include <sol/sol.hpp>
 
 #include "effects.h"
+#include "engine/point.hpp"
+#include "engine/sound_pool.hpp"
 #include "lua/metadoc.hpp"
 #include "sound_effect_enums.h"
+#include "utils/proximity_audio.hpp"
+#include "utils/screen_reader.hpp"
 
 namespace devilution {
 
@@ -32,6 +40,26 @@ void RegisterSfxIDEnum(sol::state_view &lua)
 	lua["SfxID"] = enumTable;
 }
 
+template <typename Enum>
+sol::table CreateEnumTable(sol::state_view &lua)
+{
+	sol::table enumTable = lua.create_table();
+	for (const auto enumValue : magic_enum::enum_values<Enum>()) {
+		if (enumValue != Enum::COUNT)
+			enumTable[magic_enum::enum_name(enumValue)] = static_cast<uint8_t>(enumValue);
+	}
+	return enumTable;
+}
+
+void Speak(std::string_view text, std::optional<bool> interrupt, std::optional<uint8_t> channel)
+{
+	const auto speechChannel = static_cast<SpeechChannel>(channel.value_or(static_cast<uint8_t>(SpeechChannel::UI)));
+	if (speechChannel >= SpeechChannel::COUNT)
+		return;
+	// Queued by default so a mod doesn't cut off the built-in announcements; repeats are dropped like theirs.
+	SpeakText(text, /*force=*/false, interrupt.value_or(false) ? SpeechPriority::Interrupt : SpeechPriority::Queued, speechChannel);
+}
+
 } // namespace
 
 sol::table LuaAudioModule(sol::state_view &lua)
@@ -44,8 +72,26 @@ sol::table LuaAudioModule(sol::state_view &lua)
 	LuaSetDocFn(table,
 	    "playSfxLoc", "(id: number, x: number, y: number)",
 	    [](int16_t psfx, int x, int y) { if (IsValidSfx(psfx)) PlaySfxLoc(static_cast<SfxID>(psfx), { x, y }); });
+	LuaSetDocFn(table,
+	    "speak", "(text: string, interrupt: boolean = false, channel: SpeechChannel = SpeechChannel.UI)",
+	    "Speaks the text with the screen reader, after what is already waiting on the channel unless interrupt is set",
+	    Speak);
+	LuaSetDocFn(table,
+	    "addCue", "(sound: CueSound, x: number, y: number) -> integer",
+	    "Plays a navigation cue at a tile of the current level until it is removed, returns 0 if there are too many cues",
+	    [](uint8_t sound, int x, int y) { return AddCustomProximityCue({ x, y }, static_cast<SoundPool::SoundId>(sound)); });
+	LuaSetDocFn(table,
+	    "moveCue", "(id: integer, x: number, y: number) -> boolean",
+	    "Moves a cue added with addCue",
+	    [](uint32_t id, int x, int y) { return MoveCustomProximityCue(id, { x, y }); });
+	LuaSetDocFn(table,
+	    "removeCue", "(id: integer)",
+	    "Stops a cue added with addCue",
+	    RemoveCustomProximityCue);
 	// Expose SfxID enum through the module table
 	table["SfxID"] = lua["SfxID"];
+	table["SpeechChannel"] = CreateEnumTable<SpeechChannel>(lua);
+	table["CueSound"] = CreateEnumTable<SoundPool::SoundId>(lua);
 	return table;
 }
 
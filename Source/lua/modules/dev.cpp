@@ -8,6 +8,7 @@
 #include "lua/modules/dev/items.hpp"
 #include "lua/modules/dev/level.hpp"
 #include "lua/modules/dev/monsters.hpp"
+#include "lua/modules/dev/perf.hpp"
 #include "lua/modules/dev/player.hpp"
 #include "lua/modules/dev/quests.hpp"
 #include "lua/modules/dev/search.hpp"
@@ -22,6 +23,7 @@ sol::table LuaDevModule(sol::state_view &lua)
 	LuaSetDoc(table, "items", "", "Item-related commands.", LuaDevItemsModule(lua));
 	LuaSetDoc(table, "level", "", "Level-related commands.", LuaDevLevelModule(lua));
 	LuaSetDoc(table, "monsters", "", "Monster-related commands.", LuaDevMonstersModule(lua));
+	LuaSetDoc(table, "perf", "", "Performance counters, for profiling scripts.", LuaDevPerfModule(lua));
 	LuaSetDoc(table, "player", "", "Player-related commands.", LuaDevPlayerModule(lua));
 	LuaSetDoc(table, "quests", "", "Quest-related commands.", LuaDevQuestsModule(lua));
 	LuaSetDoc(table, "search", "", "Search the map for monsters / items / objects.", LuaDevSearchModule(lua));
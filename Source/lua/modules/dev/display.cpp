@@ -2,20 +2,109 @@
 #include "lua/modules/dev/display.hpp"
 
 #include <array>
+#include <chrono>
 #include <optional>
 #include <string>
+#include <string_view>
 
 #include <sol/sol.hpp>
 
 #include "debug.h"
+#include "diablo.h"
+#include "engine/frame_stats.hpp"
+#include "engine/memory_stats.hpp"
+#include "engine/net_stats.hpp"
+#include "engine/render/scrollrt.h"
+#include "engine/tick_timing.hpp"
 #include "lighting.h"
 #include "lua/metadoc.hpp"
 #include "player.h"
+#include "utils/screen_reader.hpp"
 #include "utils/str_cat.hpp"
 
 namespace devilution {
 namespace {
 
+std::string DebugCmdAccessibilityTime(std::optional<bool> reset)
+{
+	const AccessibilityStageTiming timing = GetAccessibilityStageTiming();
+	if (reset.value_or(false))
+		ResetAccessibilityStageTiming();
+	return StrCat("Accessibility announcements: ", timing.lastTickMicroseconds, "us last tick, ", timing.maxTickMicroseconds, "us max");
+}
+
+std::string DebugCmdSpeechLatency()
+{
+	const SpeechLatency latency = GetSpeechLatency();
+	if (latency.backend.empty())
+		return "Speech: Off";
+	std::string result = StrCat("Speech through ", latency.backend, ": ", latency.blocking.count(), "us blocking");
+	if (latency.previousOutput)
+		StrAppend(result, ", ", latency.previousOutput->count(), "us until the message before was heard");
+	return result;
+}
+
+std::string DebugCmdSpeechTrace(std::optional<bool> on)
+{
+	if (on) {
+		SetSpeechTraceEnabled(*on);
+		return StrCat("Speech trace: ", *on ? "On" : "Off");
+	}
+	if (!IsSpeechTraceEnabled())
+		return "Speech trace: Off";
+
+	constexpr std::array<std::string_view, static_cast<size_t>(SpeechChannel::COUNT)> ChannelNames { "UI", "Navigation", "Combat", "Chat" };
+	const auto toMicroseconds = [](std::chrono::steady_clock::duration duration) {
+		return std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+	};
+	std::string result;
+	for (const SpeechTraceEntry &entry : GetSpeechTrace()) {
+		if (!result.empty())
+			result += '\n';
+		StrAppend(result, "[", ChannelNames[static_cast<size_t>(entry.channel)], "] ");
+		if (!entry.handedOff) {
+			StrAppend(result, "not spoken");
+		} else {
+			StrAppend(result, "queued ", toMicroseconds(*entry.handedOff - entry.enqueued), "us, backend ", toMicroseconds(*entry.returned - *entry.handedOff), "us");
+			if (entry.outputLatency)
+				StrAppend(result, ", heard after ", entry.outputLatency->count(), "us");
+		}
+		StrAppend(result, ": ", entry.text);
+	}
+	return result.empty() ? "Speech trace: empty" : result;
+}
+
+std::string DebugCmdNetStats(std::optional<bool> on)
+{
+	if (on) {
+		SetNetStatsEnabled(*on);
+		return StrCat("Network statistics: ", *on ? "On" : "Off");
+	}
+	if (!IsNetStatsEnabled())
+		return "Network statistics: Off";
+	return FormatNetStats(10);
+}
+
+std::string DebugCmdMemoryUsage(std::optional<bool> perMonsterType)
+{
+	return FormatMemoryUsage(GetMemoryUsage(), perMonsterType.value_or(false));
+}
+
+std::string DebugCmdTickTiming(std::optional<bool> on)
+{
+#ifndef DEVILUTIONX_TICK_TIMING
+	return "Tick timing: compiled out, configure with -DDEVILUTIONX_TICK_TIMING=ON";
+#else
+	if (on) {
+		SetTickTimingEnabled(*on);
+		return StrCat("Tick timing: ", *on ? "On" : "Off");
+	}
+	if (!IsTickTimingEnabled())
+		return "Tick timing: Off";
+	return FormatTickTimings(/*skipIdle=*/false);
+#endif
+}
+
 std::string DebugCmdShowGrid(std::optional<bool> on)
 {
 	DebugGrid = on.value_or(!DebugGrid);
@@ -112,20 +201,37 @@ std::string DebugCmdScrollView(std::optional<bool> on)
 
 std::string DebugCmdToggleFPS(std::optional<bool> on)
 {
-	frameflag = on.value_or(!frameflag);
+	if (on.value_or(!frameflag))
+		EnableFrameCount();
+	else
+		DisableFrameCount();
 	return StrCat("FPS counter: ", frameflag ? "On" : "Off");
 }
 
+std::string DebugCmdFrameStats()
+{
+	if (!IsFrameStatsEnabled())
+		return "Frame stats: Off, shown with the FPS";
+	return FormatFrameStats();
+}
+
 } // namespace
 
 sol::table LuaDevDisplayModule(sol::state_view &lua)
 {
 	sol::table table = lua.create_table();
+	LuaSetDocFn(table, "accessibilityTime", "(reset: boolean = nil)", "Show time spent on accessibility announcements per tick.", &DebugCmdAccessibilityTime);
 	LuaSetDocFn(table, "fps", "(name: string = nil)", "Toggle FPS display.", &DebugCmdToggleFPS);
+	LuaSetDocFn(table, "frameStats", "()", "Show the frame and tick time percentiles and the slowest frames and ticks since the FPS display was turned on.", &DebugCmdFrameStats);
 	LuaSetDocFn(table, "fullbright", "(on: boolean = nil)", "Toggle light shading.", &DebugCmdFullbright);
 	LuaSetDocFn(table, "grid", "(on: boolean = nil)", "Toggle showing the grid.", &DebugCmdShowGrid);
+	LuaSetDocFn(table, "tickTiming", "(on: boolean = nil)", "Toggle timing each game logic step and accessibility updater, or show the timings.", &DebugCmdTickTiming);
+	LuaSetDocFn(table, "memoryUsage", "(perMonsterType: boolean = nil)", "Show the memory held by the largest subsystems.", &DebugCmdMemoryUsage);
+	LuaSetDocFn(table, "netStats", "(on: boolean = nil)", "Toggle counting network traffic per command and packet type, or show the counts.", &DebugCmdNetStats);
 	LuaSetDocFn(table, "path", "(on: boolean = nil)", "Toggle path debug rendering.", &DebugCmdPath);
 	LuaSetDocFn(table, "scrollView", "(on: boolean = nil)", "Toggle view scrolling via Shift+Mouse.", &DebugCmdScrollView);
+	LuaSetDocFn(table, "speechLatency", "()", "Show the speech backend and how long the last message took.", &DebugCmdSpeechLatency);
+	LuaSetDocFn(table, "speechTrace", "(on: boolean = nil)", "Toggle tracing speech latency, or show the latest traced messages.", &DebugCmdSpeechTrace);
 	LuaSetDocFn(table, "tileData", "(name: string = nil)", "Toggle showing tile data.", &DebugCmdShowTileData);
 	LuaSetDocFn(table, "vision", "(on: boolean = nil)", "Toggle vision debug rendering.", &DebugCmdVision);
 	return table;
@@ -0,0 +1,159 @@
+#ifdef _DEBUG
+#include "lua/modules/dev/perf.hpp"
+
+#include <array>
+#include <cstddef>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+#include <sol/sol.hpp>
+
+#include "engine/asset_stats.hpp"
+#include "engine/frame_stats.hpp"
+#include "engine/path.h"
+#include "engine/sound_pool.hpp"
+#include "engine/tick_timing.hpp"
+#include "lua/metadoc.hpp"
+#include "utils/screen_reader.hpp"
+
+namespace devilution {
+namespace {
+
+sol::table HistogramTable(sol::state_view &lua, const TimeHistogram &histogram)
+{
+	sol::table table = lua.create_table();
+	table["count"] = histogram.count();
+	table["p50"] = histogram.Percentile(0.5);
+	table["p95"] = histogram.Percentile(0.95);
+	table["p99"] = histogram.Percentile(0.99);
+	table["max"] = histogram.max();
+	return table;
+}
+
+sol::table SlowSamplesTable(sol::state_view &lua, const std::array<SlowSample, SlowSampleCount> &samples)
+{
+	sol::table table = lua.create_table();
+	size_t index = 1;
+	for (const SlowSample &sample : samples) {
+		if (sample.microseconds == 0)
+			break;
+		sol::table entry = lua.create_table();
+		entry["us"] = sample.microseconds;
+		entry["tick"] = sample.gameTick;
+		entry["step"] = GameLogicStepName(sample.slowestStep);
+		entry["stepUs"] = sample.slowestStepMicroseconds;
+		table[index++] = entry;
+	}
+	return table;
+}
+
+sol::table PerfTickTimings(sol::this_state state)
+{
+	sol::state_view lua(state);
+	sol::table table = lua.create_table();
+	if (!IsTickTimingEnabled())
+		return table;
+	for (size_t i = 0; i < TickTimerCount; i++) {
+		const auto timer = static_cast<TickTimer>(i);
+		const TickTimerSummary summary = SummarizeTickTimer(timer);
+		sol::table entry = lua.create_table();
+		entry["last"] = summary.lastMicroseconds;
+		entry["avg"] = summary.averageMicroseconds;
+		entry["max"] = summary.maxMicroseconds;
+		table[TickTimerName(timer)] = entry;
+	}
+	return table;
+}
+
+sol::table PerfFrames(sol::this_state state)
+{
+	sol::state_view lua(state);
+	const FrameStats &stats = GetFrameStats();
+	sol::table table = lua.create_table();
+	table["enabled"] = IsFrameStatsEnabled();
+	table["frames"] = HistogramTable(lua, stats.frames);
+	table["ticks"] = HistogramTable(lua, stats.ticks);
+	table["slowestFrames"] = SlowSamplesTable(lua, stats.slowestFrames);
+	table["slowestTicks"] = SlowSamplesTable(lua, stats.slowestTicks);
+	return table;
+}
+
+sol::table PerfPaths(sol::this_state state, std::optional<bool> reset)
+{
+	sol::state_view lua(state);
+	const PathQueryStats stats = GetPathQueryStats();
+	if (reset.value_or(false))
+		ResetPathQueryStats();
+	sol::table table = lua.create_table();
+	table["queries"] = stats.queries;
+	table["failed"] = stats.failed;
+	table["nodesExpanded"] = stats.nodesExpanded;
+	return table;
+}
+
+sol::table PerfSpeechQueue(sol::this_state state)
+{
+	constexpr std::array<std::string_view, static_cast<size_t>(SpeechChannel::COUNT)> ChannelNames { "ui", "navigation", "combat", "chat" };
+	sol::state_view lua(state);
+	sol::table table = lua.create_table();
+	for (size_t i = 0; i < ChannelNames.size(); i++)
+		table[ChannelNames[i]] = GetQueuedSpeechCount(static_cast<SpeechChannel>(i));
+	return table;
+}
+
+sol::table PerfVoices(sol::this_state state)
+{
+	sol::state_view lua(state);
+	const SoundPool &pool = SoundPool::Get();
+	sol::table table = lua.create_table();
+	table["active"] = pool.ActiveVoiceCount();
+	table["available"] = pool.VoiceCount();
+	return table;
+}
+
+std::optional<sol::table> PerfAssets(sol::this_state state)
+{
+	if (!IsAssetStatsEnabled())
+		return std::nullopt;
+	uint64_t loads = 0;
+	uint64_t bytes = 0;
+	uint64_t decompressMicroseconds = 0;
+	uint64_t wallMicroseconds = 0;
+	const std::vector<AssetLoadStats> stats = GetAssetLoadStats();
+	for (const AssetLoadStats &asset : stats) {
+		loads += asset.loads;
+		bytes += asset.bytes;
+		decompressMicroseconds += asset.decompressMicroseconds;
+		wallMicroseconds += asset.wallMicroseconds;
+	}
+	sol::state_view lua(state);
+	sol::table table = lua.create_table();
+	table["files"] = stats.size();
+	table["loads"] = loads;
+	table["bytes"] = bytes;
+	table["decompressUs"] = decompressMicroseconds;
+	table["wallUs"] = wallMicroseconds;
+	if (!stats.empty()) {
+		table["slowest"] = stats.front().name;
+		table["slowestUs"] = stats.front().wallMicroseconds;
+	}
+	return table;
+}
+
+} // namespace
+
+sol::table LuaDevPerfModule(sol::state_view &lua)
+{
+	sol::table table = lua.create_table();
+	LuaSetDocFn(table, "assets", "() -> table", "Asset load totals and the slowest file, nil unless started with --asset-stats.", &PerfAssets);
+	LuaSetDocFn(table, "frames", "() -> table", "Frame and tick time percentiles and the slowest ones in microseconds, collected while the FPS are shown.", &PerfFrames);
+	LuaSetDocFn(table, "paths", "(reset: boolean = nil) -> table", "Path searches, failed searches and nodes expanded since the last reset.", &PerfPaths);
+	LuaSetDocFn(table, "speechQueue", "() -> table", "Messages waiting to be spoken per speech channel.", &PerfSpeechQueue);
+	LuaSetDocFn(table, "tickTimings", "() -> table", "Last, average and largest microseconds of each game tick step, empty unless dev.display.tickTiming(true).", &PerfTickTimings);
+	LuaSetDocFn(table, "voices", "() -> table", "Navigation cue voices in use and available.", &PerfVoices);
+	return table;
+}
+
+} // namespace devilution
+#endif // _DEBUG
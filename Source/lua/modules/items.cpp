@@ -1,6 +1,9 @@
 #include "lua/modules/items.hpp"
 
+#include <cstddef>
+#include <optional>
 #include <string_view>
+#include <tuple>
 
 #include <fmt/format.h>
 #include <sol/sol.hpp>
@@ -112,6 +115,61 @@ void InitItemUserType(sol::state_view &lua)
 	LuaSetDocFn(itemType, "getName", "() -> string", "Gets the translated item name", &Item::getName);
 }
 
+/**
+ * A read-only view of the item slots that reads them in place, so scripts can scan the items on
+ * the ground every tick without building tables.
+ */
+struct ItemsView {
+	/** Whether only the items in ActiveItems are visited, rather than all slots. */
+	bool activeOnly;
+
+	[[nodiscard]] size_t size() const
+	{
+		return activeOnly ? ActiveItemCount : MAXITEMS;
+	}
+
+	/** @brief The item at the 1-based index, nullptr past the end. */
+	[[nodiscard]] const Item *At(size_t index) const
+	{
+		if (index == 0 || index > size())
+			return nullptr;
+		return &Items[activeOnly ? ActiveItems[index - 1] : index - 1];
+	}
+};
+
+void InitItemsViewUserType(sol::state_view &lua)
+{
+	sol::usertype<ItemsView> viewType = lua.new_usertype<ItemsView>(sol::no_constructor);
+	viewType[sol::meta_function::length] = &ItemsView::size;
+	viewType[sol::meta_function::index] = [](const ItemsView &view, sol::stack_object key) -> const Item * {
+		return key.is<size_t>() ? view.At(key.as<size_t>()) : nullptr;
+	};
+	LuaSetDocFn(viewType, "slot", "(index: integer) -> integer",
+	    "The 0-based slot in the Items array of the item at the 1-based index",
+	    [](const ItemsView &view, size_t index) -> std::optional<size_t> {
+		    const Item *item = view.At(index);
+		    if (item == nullptr)
+			    return std::nullopt;
+		    return static_cast<size_t>(item - Items);
+	    });
+	LuaSetDocFn(viewType, "tile", "(index: integer) -> (integer, integer)",
+	    "The tile of the item at the 1-based index, without creating a Point",
+	    [](const ItemsView &view, size_t index) -> std::tuple<int, int> {
+		    const Item *item = view.At(index);
+		    if (item == nullptr)
+			    return { -1, -1 };
+		    return { item->position.x, item->position.y };
+	    });
+	LuaSetDocFn(viewType, "type", "(index: integer) -> ItemType",
+	    "The type of the item at the 1-based index",
+	    [](const ItemsView &view, size_t index) -> std::optional<ItemType> {
+		    const Item *item = view.At(index);
+		    if (item == nullptr)
+			    return std::nullopt;
+		    return item->_itype;
+	    });
+}
+
 void RegisterItemTypeEnum(sol::state_view &lua)
 {
 	lua.new_enum<ItemType>("ItemType",
@@ -470,6 +528,7 @@ void AddUniqueItemDataFromTsv(const std::string_view path, const int32_t baseMap
 sol::table LuaItemModule(sol::state_view &lua)
 {
 	InitItemUserType(lua);
+	InitItemsViewUserType(lua);
 	RegisterItemTypeEnum(lua);
 	RegisterItemEquipTypeEnum(lua);
 	RegisterItemClassEnum(lua);
@@ -484,6 +543,12 @@ sol::table LuaItemModule(sol::state_view &lua)
 
 	LuaSetDocFn(table, "addItemDataFromTsv", "(path: string, baseMappingId: number)", AddItemDataFromTsv);
 	LuaSetDocFn(table, "addUniqueItemDataFromTsv", "(path: string, baseMappingId: number)", AddUniqueItemDataFromTsv);
+	LuaSetDoc(table, "all", "ItemsView",
+	    "All item slots, read in place: `#items.all`, `items.all[i]` (1-based), `items.all:tile(i)`",
+	    ItemsView { .activeOnly = false });
+	LuaSetDoc(table, "active", "ItemsView",
+	    "The items on the ground of the current level, read in place: `#items.active`, `items.active[i]` (1-based), `items.active:tile(i)`",
+	    ItemsView { .activeOnly = true });
 
 	// Expose enums through the module table
 	table["ItemIndex"] = lua["ItemIndex"];
@@ -1,6 +1,9 @@
 #include "lua/modules/monsters.hpp"
 
+#include <cstddef>
+#include <optional>
 #include <string_view>
+#include <tuple>
 
 #include <fmt/format.h>
 #include <sol/sol.hpp>
@@ -42,6 +45,71 @@ void InitMonsterUserType(sol::state_view &lua)
 	    [](const Monster &monster) {
 		    return static_cast<int>(reinterpret_cast<uintptr_t>(&monster));
 	    });
+	LuaSetDocReadonlyProperty(monsterType, "name", "string",
+	    "Monster's name (readonly)",
+	    [](const Monster &monster) {
+		    return monster.name();
+	    });
+	LuaSetDocReadonlyProperty(monsterType, "hitPoints", "integer",
+	    "Monster's current life, in 64ths of a hit point (readonly)",
+	    [](const Monster &monster) {
+		    return monster.hitPoints;
+	    });
+}
+
+/**
+ * A read-only view of the monster slots that reads them in place, so scripts can scan the
+ * monsters every tick without building tables.
+ */
+struct MonstersView {
+	/** Whether only the monsters in ActiveMonsters are visited, rather than all slots. */
+	bool activeOnly;
+
+	[[nodiscard]] size_t size() const
+	{
+		return activeOnly ? ActiveMonsterCount : MaxMonsters;
+	}
+
+	/** @brief The monster at the 1-based index, nullptr past the end. */
+	[[nodiscard]] const Monster *At(size_t index) const
+	{
+		if (index == 0 || index > size())
+			return nullptr;
+		return &Monsters[activeOnly ? ActiveMonsters[index - 1] : index - 1];
+	}
+};
+
+void InitMonstersViewUserType(sol::state_view &lua)
+{
+	sol::usertype<MonstersView> viewType = lua.new_usertype<MonstersView>(sol::no_constructor);
+	viewType[sol::meta_function::length] = &MonstersView::size;
+	viewType[sol::meta_function::index] = [](const MonstersView &view, sol::stack_object key) -> const Monster * {
+		return key.is<size_t>() ? view.At(key.as<size_t>()) : nullptr;
+	};
+	LuaSetDocFn(viewType, "slot", "(index: integer) -> integer",
+	    "The 0-based slot in the Monsters array of the monster at the 1-based index",
+	    [](const MonstersView &view, size_t index) -> std::optional<size_t> {
+		    const Monster *monster = view.At(index);
+		    if (monster == nullptr)
+			    return std::nullopt;
+		    return static_cast<size_t>(monster - Monsters);
+	    });
+	LuaSetDocFn(viewType, "tile", "(index: integer) -> (integer, integer)",
+	    "The tile of the monster at the 1-based index, without creating a Point",
+	    [](const MonstersView &view, size_t index) -> std::tuple<int, int> {
+		    const Monster *monster = view.At(index);
+		    if (monster == nullptr)
+			    return { -1, -1 };
+		    return { monster->position.tile.x, monster->position.tile.y };
+	    });
+	LuaSetDocFn(viewType, "hitPoints", "(index: integer) -> integer",
+	    "The current life of the monster at the 1-based index, in 64ths of a hit point",
+	    [](const MonstersView &view, size_t index) -> std::optional<int> {
+		    const Monster *monster = view.At(index);
+		    if (monster == nullptr)
+			    return std::nullopt;
+		    return monster->hitPoints;
+	    });
 }
 
 } // namespace
@@ -49,9 +117,16 @@ void InitMonsterUserType(sol::state_view &lua)
 sol::table LuaMonstersModule(sol::state_view &lua)
 {
 	InitMonsterUserType(lua);
+	InitMonstersViewUserType(lua);
 	sol::table table = lua.create_table();
 	LuaSetDocFn(table, "addMonsterDataFromTsv", "(path: string)", AddMonsterDataFromTsv);
 	LuaSetDocFn(table, "addUniqueMonsterDataFromTsv", "(path: string)", AddUniqueMonsterDataFromTsv);
+	LuaSetDoc(table, "all", "MonstersView",
+	    "All monster slots, read in place: `#monsters.all`, `monsters.all[i]` (1-based), `monsters.all:tile(i)`",
+	    MonstersView { .activeOnly = false });
+	LuaSetDoc(table, "active", "MonstersView",
+	    "The monsters on the current level, read in place: `#monsters.active`, `monsters.active[i]` (1-based), `monsters.active:tile(i)`",
+	    MonstersView { .activeOnly = true });
 	return table;
 }
 
@@ -3,6 +3,7 @@
  *
  * Implementation of scrolling dialog text.
  */
+#include <algorithm>
 #include <cstdint>
 #include <optional>
 #include <string>
@@ -17,6 +18,7 @@
 #include "engine/render/clx_render.hpp"
 #include "engine/render/primitive_render.hpp"
 #include "engine/render/text_render.hpp"
+#include "engine/surface.hpp"
 #include "tables/playerdat.hpp"
 #include "tables/textdat.h"
 #include "utils/language.h"
@@ -38,23 +40,40 @@ OptionalOwnedClxSpriteList pTextBoxCels;
 
 /** Pixels for a line of text and the empty space under it. */
 const int LineHeight = 38;
+/** Width of the text column. */
+const int TextWidth = 543;
 
-std::vector<std::string> TextLines;
+size_t NumTextLines;
+/**
+ * The whole text, laid out and drawn once when the narration starts, scrolling only copies the visible part.
+ * Color index 0 is left for the window behind the text.
+ */
+std::optional<OwnedSurface> TextStrip;
 
 void LoadText(std::string_view text)
 {
-	TextLines.clear();
+	std::vector<std::string> lines;
 
-	const std::string paragraphs = WordWrapString(text, 543, GameFont30);
+	const std::string paragraphs = WordWrapString(text, TextWidth, GameFont30);
 
 	size_t previous = 0;
 	while (true) {
 		const size_t next = paragraphs.find('\n', previous);
-		TextLines.emplace_back(paragraphs.substr(previous, next - previous));
+		lines.emplace_back(paragraphs.substr(previous, next - previous));
 		if (next == std::string::npos)
 			break;
 		previous = next + 1;
 	}
+	NumTextLines = lines.size();
+
+	TextStrip.emplace(TextWidth, static_cast<int>(LineHeight * lines.size()));
+	FillRect(*TextStrip, 0, 0, TextStrip->w(), TextStrip->h(), 0);
+	for (size_t i = 0; i < lines.size(); i++) {
+		if (lines[i].empty())
+			continue;
+		DrawString(*TextStrip, lines[i], { { 0, static_cast<int>(i) * LineHeight }, { TextWidth, LineHeight } },
+		    { .flags = UiFlags::FontSize30 | UiFlags::ColorGold });
+	}
 }
 
 /**
@@ -64,7 +83,7 @@ void LoadText(std::string_view text)
  */
 uint32_t CalculateTextSpeed(SfxID nSFX)
 {
-	const auto numLines = static_cast<uint32_t>(TextLines.size());
+	const auto numLines = static_cast<uint32_t>(NumTextLines);
 
 #ifndef NOSOUND
 	uint32_t sfxFrames = GetSFXLength(nSFX);
@@ -87,7 +106,7 @@ int CalculateTextPosition()
 
 	const int y = (currTime - ScrollStart) / qtextSpd - 260;
 
-	const auto textHeight = static_cast<int>(LineHeight * TextLines.size());
+	const auto textHeight = static_cast<int>(LineHeight * NumTextLines);
 	if (y >= textHeight)
 		qtextflag = false;
 
@@ -100,26 +119,17 @@ int CalculateTextPosition()
 void DrawQTextContent(const Surface &out)
 {
 	const int y = CalculateTextPosition();
+	if (!TextStrip)
+		return;
 
 	const int sx = GetUIRectangle().position.x + 48;
-	const int sy = 0 - (y % LineHeight);
-
-	const unsigned int skipLines = y / LineHeight;
 
-	for (int i = 0; i < 8; i++) {
-		const unsigned int lineNumber = skipLines + i;
-		if (lineNumber >= TextLines.size()) {
-			continue;
-		}
-
-		const std::string &line = TextLines[lineNumber];
-		if (line.empty()) {
-			continue;
-		}
-
-		DrawString(out, line, { { sx, sy + i * LineHeight }, { 543, LineHeight } },
-		    { .flags = UiFlags::FontSize30 | UiFlags::ColorGold });
-	}
+	// The text starts below the window and scrolls up, `y` is negative until its first line reaches the top.
+	const int top = std::max(y, 0);
+	const int bottom = std::min(y + out.h(), TextStrip->h());
+	if (top >= bottom)
+		return;
+	out.BlitFromSkipColorIndexZero(*TextStrip, MakeSdlRect(0, top, TextWidth, bottom - top), { sx, top - y });
 }
 
 } // namespace
@@ -127,6 +137,7 @@ void DrawQTextContent(const Surface &out)
 void FreeQuestText()
 {
 	pTextBoxCels = std::nullopt;
+	TextStrip = std::nullopt;
 }
 
 void InitQuestText()
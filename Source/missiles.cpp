@@ -13,7 +13,6 @@
 #include <cstddef>
 #include <cstdint>
 #include <limits>
-#include <list>
 #include <optional>
 #include <type_traits>
 #include <utility>
@@ -65,12 +64,13 @@
 #include "levels/trigs.h"
 #include "lighting.h"
 #include "monster.h"
+#include "utils/bitset2d.hpp"
 #include "utils/is_of.hpp"
 #include "utils/str_cat.hpp"
 
 namespace devilution {
 
-std::list<Missile> Missiles;
+SlotPool<Missile> Missiles;
 bool MissilePreFlag;
 
 void Missile::setAnimation(MissileGraphicID animtype)
@@ -107,6 +107,39 @@ void Missile::setAnimation(MissileGraphicID animtype)
 
 namespace {
 
+/**
+ * Tiles that may hold a monster or player while ProcessMissiles runs, marked from the actors' positions
+ * at the start of the tick and from every tile they move onto during it. Hundreds of missiles checking
+ * empty tiles then stay within this small grid instead of looking up dMonster and dPlayer each time.
+ */
+Bitset2d<MAXDUNX, MAXDUNY> MissileTargetTiles;
+bool MissileTargetTilesValid;
+
+void MarkActorPosition(const ActorPosition &position)
+{
+	for (const WorldTilePosition tile : { position.tile, position.future, position.old, position.last }) {
+		if (InDungeonBounds(tile))
+			MissileTargetTiles.set(tile.x, tile.y);
+	}
+}
+
+void BuildMissileTargetTiles()
+{
+	MissileTargetTiles.reset();
+	for (size_t i = 0; i < ActiveMonsterCount; i++)
+		MarkActorPosition(Monsters[ActiveMonsters[i]].position);
+	for (const Player &player : Players) {
+		if (player.plractive && player.isOnActiveLevel())
+			MarkActorPosition(player.position);
+	}
+	MissileTargetTilesValid = true;
+}
+
+[[nodiscard]] bool MayHoldMissileTarget(Point tile)
+{
+	return !MissileTargetTilesValid || MissileTargetTiles.test(tile.x, tile.y);
+}
+
 int AddClassHealingBonus(int hp, HeroClass heroClass)
 {
 	switch (heroClass) {
@@ -131,16 +164,6 @@ int ScaleSpellEffect(int base, int spellLevel)
 	return base;
 }
 
-int GenerateRndSum(int range, int iterations)
-{
-	int value = 0;
-	for (int i = 0; i < iterations; i++) {
-		value += GenerateRnd(range);
-	}
-
-	return value;
-}
-
 bool CheckBlock(Point from, Point to)
 {
 	while (from != to) {
@@ -157,7 +180,7 @@ Monster *FindClosest(Point source, int rad)
 	std::optional<Point> monsterPosition = FindClosestValidPosition(
 	    [&source](Point target) {
 		    // search for a monster with clear line of sight
-		    return InDungeonBounds(target) && dMonster[target.x][target.y] > 0 && !CheckBlock(source, target);
+		    return InDungeonBounds(target) && MayHoldMissileTarget(target) && dMonster[target.x][target.y] > 0 && !CheckBlock(source, target);
 	    },
 	    source, 1, rad);
 
@@ -486,9 +509,10 @@ void CheckMissileCol(Missile &missile, DamageType damageType, int minDamage, int
 {
 	if (!InDungeonBounds(position))
 		return;
+	const bool mayHoldTarget = MayHoldMissileTarget(position);
 
 	bool isMonsterHit = false;
-	int mid = dMonster[position.x][position.y];
+	int mid = mayHoldTarget ? dMonster[position.x][position.y] : 0;
 	if (mid != 0) {
 		Monster &monster = Monsters[std::abs(mid) - 1];
 		if (onlyHitWalking.has_value() ? (monster.isWalking() && CheckCanHitOnlyWalking(missile, monster.position, *onlyHitWalking)) : (mid > 0 || monster.mode == MonsterMode::Petrified)) {
@@ -514,7 +538,7 @@ void CheckMissileCol(Missile &missile, DamageType damageType, int minDamage, int
 
 	bool isPlayerHit = false;
 	bool blocked = false;
-	Player *player = PlayerAtPosition(position, !onlyHitWalking.has_value());
+	Player *player = mayHoldTarget ? PlayerAtPosition(position, !onlyHitWalking.has_value()) : nullptr;
 	if (player != nullptr && (onlyHitWalking.has_value() ? (player->isWalking() && CheckCanHitOnlyWalking(missile, player->position, *onlyHitWalking)) : true)) {
 		if (missile._micaster != TARGET_BOTH && !missile.IsTrap()) {
 			if (missile._micaster == TARGET_MONSTERS) {
@@ -3581,7 +3605,7 @@ void ProcessChainLightning(Missile &missile)
 	const int rad = std::min<int>(missile._mispllvl + 3, MaxCrawlRadius);
 	Crawl(1, rad, [&](Displacement displacement) {
 		const Point target = position + displacement;
-		if (InDungeonBounds(target) && dMonster[target.x][target.y] > 0) {
+		if (InDungeonBounds(target) && MayHoldMissileTarget(target) && dMonster[target.x][target.y] > 0) {
 			dir = GetDirection(position, target);
 			AddMissile(position, target, dir, MissileID::LightningControl, TARGET_MONSTERS, id, 1, missile._mispllvl);
 		}
@@ -4228,6 +4252,10 @@ void ProcessMissiles()
 
 	MissilePreFlag = false;
 
+	// Towners share dMonster with monsters in town, so only the dungeon gets the broadphase.
+	if (leveltype != DTYPE_TOWN)
+		BuildMissileTargetTiles();
+
 	for (auto &missile : Missiles) {
 		const MissileData &missileData = GetMissileData(missile._mitype);
 		if (missileData.processFn != nullptr)
@@ -4247,10 +4275,18 @@ void ProcessMissiles()
 			missile._miAnimFrame = missile._miAnimLen;
 	}
 
+	MissileTargetTilesValid = false;
+
 	ProcessManaShield();
 	DeleteMissiles();
 }
 
+void MarkMissileTarget(Point tile)
+{
+	if (MissileTargetTilesValid && InDungeonBounds(tile))
+		MissileTargetTiles.set(tile.x, tile.y);
+}
+
 void SetUpMissileAnimationData()
 {
 	for (auto &missile : Missiles) {
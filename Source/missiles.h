@@ -6,7 +6,6 @@
 #pragma once
 
 #include <cstdint>
-#include <list>
 #include <optional>
 
 #include "engine/displacement.hpp"
@@ -17,6 +16,7 @@
 #include "tables/misdat.h"
 #include "tables/spelldat.h"
 #include "utils/is_of.hpp"
+#include "utils/slot_pool.hpp"
 
 namespace devilution {
 
@@ -235,7 +235,7 @@ public:
 	}
 };
 
-extern std::list<Missile> Missiles;
+extern SlotPool<Missile> Missiles;
 extern bool MissilePreFlag;
 
 struct DamageRange {
@@ -486,6 +486,8 @@ void ProcessBoneSpirit(Missile &missile);
 void ProcessResurrectBeam(Missile &missile);
 void ProcessRedPortal(Missile &missile);
 void ProcessMissiles();
+/** @brief Tells the missile collision broadphase that a monster or player moved onto `tile`. */
+void MarkMissileTarget(Point tile);
 void SetUpMissileAnimationData();
 void RedoMissileFlags();
 
@@ -19,6 +19,7 @@
 #include <memory>
 #include <numeric>
 #include <optional>
+#include <span>
 #include <string>
 #include <string_view>
 #include <utility>
@@ -43,15 +44,19 @@
 #include "effects.h"
 #include "engine/animationinfo.h"
 #include "engine/clx_sprite.hpp"
+#include "engine/converted_asset_cache.hpp"
+#include "engine/demomode.h"
 #include "engine/direction.hpp"
 #include "engine/lighting_defs.hpp"
 #include "engine/load_cl2.hpp"
 #include "engine/load_file.hpp"
+#include "engine/navigation_field.hpp"
 #include "engine/path.h"
 #include "engine/point.hpp"
 #include "engine/points_in_rectangle_range.hpp"
 #include "engine/random.hpp"
 #include "engine/render/clx_render.hpp"
+#include "engine/render/render_workers.hpp"
 #include "engine/sound.h"
 #include "engine/sound_position.hpp"
 #include "engine/world_tile.hpp"
@@ -91,7 +96,9 @@
 #include "utils/algorithm/container.hpp"
 #include "utils/attributes.h"
 #include "utils/cl2_to_clx.hpp"
+#include "utils/endian_read.hpp"
 #include "utils/endian_swap.hpp"
+#include "utils/endian_write.hpp"
 #include "utils/enum_traits.h"
 #include "utils/file_name_generator.hpp"
 #include "utils/is_of.hpp"
@@ -113,6 +120,7 @@ size_t LevelMonsterTypeCount;
 Monster Monsters[MaxMonsters];
 unsigned ActiveMonsters[MaxMonsters];
 size_t ActiveMonsterCount;
+ActiveMonsterHotState ActiveMonsterHot;
 /** Tracks the total number of monsters killed per monster_id. */
 int MonsterKillCounts[NUM_MAX_MTYPES];
 bool sgbSaveSoundOn;
@@ -128,6 +136,10 @@ constexpr int HellAcBonus = 80;
 /** @brief Reserved some entries in @Monster for golems. For vanilla compatibility, this must remain 4. */
 constexpr int ReservedMonsterSlotsForGolems = 4;
 
+/** Monsters whose hit points went down since TakeMonstersWithChangedHealth was last called. */
+std::vector<size_t> MonstersWithChangedHealth;
+std::array<bool, MaxMonsters> IsMonsterHealthChangeListed;
+
 /** Tracks which missile files are already loaded */
 size_t totalmonsters;
 int monstimgtot;
@@ -1699,18 +1711,30 @@ bool RandomWalk2(Monster &monster, Direction md)
 /**
  * @brief Check if a tile is affected by a spell we are vulnerable to
  */
-bool IsTileSafe(const Monster &monster, Point position)
+bool FearsFire(const Monster &monster)
+{
+	return (monster.resistance & IMMUNE_FIRE) == 0 || monster.type().type == MT_DIABLO;
+}
+
+bool FearsLightning(const Monster &monster)
+{
+	return (monster.resistance & IMMUNE_LIGHTNING) == 0 || monster.type().type == MT_DIABLO;
+}
+
+bool IsTileSafe(Point position, bool fearsFire, bool fearsLightning)
 {
 	if (!InDungeonBounds(position))
 		return false;
 
-	const bool fearsFire = (monster.resistance & IMMUNE_FIRE) == 0 || monster.type().type == MT_DIABLO;
-	const bool fearsLightning = (monster.resistance & IMMUNE_LIGHTNING) == 0 || monster.type().type == MT_DIABLO;
-
 	return !(fearsFire && HasAnyOf(dFlags[position.x][position.y], DungeonFlag::MissileFireWall))
 	    && !(fearsLightning && HasAnyOf(dFlags[position.x][position.y], DungeonFlag::MissileLightningWall));
 }
 
+bool IsTileSafe(const Monster &monster, Point position)
+{
+	return IsTileSafe(position, FearsFire(monster), FearsLightning(monster));
+}
+
 /**
  * @brief Check that the given tile is not currently blocked
  */
@@ -1739,6 +1763,107 @@ bool IsTileAccessible(const Monster &monster, Point position)
 	return IsTileSafe(monster, position);
 }
 
+/** Which monsters can share a path field: the ones that are stopped by the same tiles. */
+struct MonsterPathFieldKey {
+	Point root;
+	bool canOpenDoors;
+	bool fearsFire;
+	bool fearsLightning;
+	uint32_t tick;
+
+	bool operator==(const MonsterPathFieldKey &other) const = default;
+};
+
+struct MonsterPathFieldSlot {
+	MonsterPathFieldKey key {};
+	std::unique_ptr<NavigationField> field;
+	/** The field is only flooded once a second monster of the tick asks for it. */
+	bool built = false;
+	uint32_t lastUse = 0;
+};
+
+/** Enough for every player with a few kinds of monsters chasing each. */
+constexpr size_t MonsterPathFieldSlotCount = 8;
+std::array<MonsterPathFieldSlot, MonsterPathFieldSlotCount> MonsterPathFields;
+uint32_t MonsterPathFieldUseCounter;
+/** Advanced once per game tick, so the fields never outlive the monster and door positions they were built from. */
+uint32_t MonsterPathFieldTick;
+
+/**
+ * @brief Whether monsters may take their steps from a shared path field instead of FindPath.
+ *
+ * The field doesn't weigh straight and diagonal steps like FindPath and only checks other monsters on the
+ * next tile, so the routes differ. Multiplayer games and demos must play out the same, they keep FindPath.
+ */
+bool UseSharedMonsterPaths()
+{
+	return *GetOptions().Gameplay.sharedMonsterPaths && !gbIsMultiplayer && !demo::IsRunning() && !demo::IsRecording();
+}
+
+/**
+ * @brief Returns the path field of the monsters heading to `monster.enemyPosition` this tick.
+ *
+ * In big packs many monsters plan a path to the same player on the same tick. Flooding the
+ * surroundings of the target once lets each of them read its next step instead of running its own search.
+ * @return nullptr for the first monster asking this tick, which is cheaper to path on its own
+ */
+const NavigationField *GetMonsterPathField(const Monster &monster)
+{
+	const bool canOpenDoors = (monster.flags & MFLAG_CAN_OPEN_DOOR) != 0;
+	const bool fearsFire = FearsFire(monster);
+	const bool fearsLightning = FearsLightning(monster);
+	const MonsterPathFieldKey key { monster.enemyPosition, canOpenDoors, fearsFire, fearsLightning, MonsterPathFieldTick };
+	++MonsterPathFieldUseCounter;
+
+	MonsterPathFieldSlot *leastRecentlyUsed = &MonsterPathFields[0];
+	for (MonsterPathFieldSlot &slot : MonsterPathFields) {
+		if (slot.lastUse != 0 && slot.key == key) {
+			slot.lastUse = MonsterPathFieldUseCounter;
+			if (!slot.built) {
+				if (slot.field == nullptr)
+					slot.field = std::make_unique<NavigationField>();
+				// Other monsters are left out, they move during the tick. The step read from the field checks them.
+				slot.field->Build(
+				    key.root, PathDirs, [&key](Point position) { return IsTileWalkable(position, key.canOpenDoors) && IsTileSafe(position, key.fearsFire, key.fearsLightning); },
+				    CanStep, MaxPathLengthMonsters);
+				slot.built = true;
+			}
+			return slot.field.get();
+		}
+		if (slot.lastUse < leastRecentlyUsed->lastUse)
+			leastRecentlyUsed = &slot;
+	}
+
+	leastRecentlyUsed->key = key;
+	leastRecentlyUsed->built = false;
+	leastRecentlyUsed->lastUse = MonsterPathFieldUseCounter;
+	return nullptr;
+}
+
+/**
+ * @brief Reads the monster's next step towards the root of its path field.
+ * @return The step as returned by GetPathDirection(), or an empty optional if no free neighbour is closer to the root
+ */
+std::optional<int8_t> GetMonsterStepFromField(const NavigationField &field, const Monster &monster)
+{
+	const Point position = monster.position.tile;
+	const NavigationField::DistanceType distance = field.Distance(position);
+	if (distance == 0 || distance > MaxPathLengthMonsters)
+		return std::nullopt;
+
+	for (const Displacement step : PathDirs) {
+		const Point next = position + step;
+		if (field.Distance(next) != distance - 1)
+			continue;
+		if (next != field.Root() && !IsTileAccessible(monster, next))
+			continue;
+		if (!CanStep(position, next))
+			continue;
+		return GetPathDirection(position, next);
+	}
+	return std::nullopt;
+}
+
 bool AiPlanWalk(Monster &monster)
 {
 	int8_t path[MaxPathLengthMonsters];
@@ -1746,7 +1871,15 @@ bool AiPlanWalk(Monster &monster)
 	/** Maps from walking path step to facing direction. */
 	const Direction plr2monst[9] = { Direction::South, Direction::NorthEast, Direction::NorthWest, Direction::SouthEast, Direction::SouthWest, Direction::North, Direction::East, Direction::South, Direction::West };
 
-	if (FindPath(CanStep, [&monster](Point position) { return IsTileAccessible(monster, position); }, monster.position.tile, monster.enemyPosition, path, MaxPathLengthMonsters) == 0) {
+	if (const NavigationField *field = UseSharedMonsterPaths() ? GetMonsterPathField(monster) : nullptr; field != nullptr) {
+		if (const std::optional<int8_t> step = GetMonsterStepFromField(*field, monster); step) {
+			RandomWalk(monster, plr2monst[*step]);
+			return true;
+		}
+	}
+
+	// Monsters out of the field's reach or blocked in by others still search on their own.
+	if (FindPath([](Point from, Point to) { return CanStep(from, to); }, [&monster](Point position) { return IsTileAccessible(monster, position); }, monster.position.tile, monster.enemyPosition, path, MaxPathLengthMonsters) == 0) {
 		return false;
 	}
 
@@ -2146,8 +2279,9 @@ void ScavengerAi(Monster &monster)
 				const int mMaxHP = monster.maxHitPoints;
 				monster.hitPoints += mMaxHP / 8;
 				monster.hitPoints = std::min(monster.hitPoints, monster.maxHitPoints);
-				if (monster.goalVar3 <= 0 || monster.hitPoints == monster.maxHitPoints)
-					dCorpse[monster.position.tile.x][monster.position.tile.y] = 0;
+				if (monster.goalVar3 <= 0 || monster.hitPoints == monster.maxHitPoints) {
+					RemoveCorpse(monster.position.tile);
+				}
 			} else {
 				monster.hitPoints += 64;
 			}
@@ -3134,16 +3268,88 @@ bool UpdateModeStance(Monster &monster)
 	}
 }
 
-MonsterSpritesData LoadMonsterSpritesData(const MonsterData &monsterData)
+/** Sprites of monster types from earlier levels, kept for when they show up again. */
+constexpr size_t MonsterSpriteCacheBudget = 32 * 1024 * 1024;
+
+struct CachedMonsterSprites {
+	_monster_id type;
+	/** With the TRN of the type already applied. */
+	MonsterSpritesData sprites;
+	size_t size;
+};
+
+/** Least recently used first. */
+std::vector<CachedMonsterSprites> MonsterSpriteCache;
+size_t MonsterSpriteCacheSize = 0;
+
+void EvictMonsterSprites(size_t budget)
+{
+	while (MonsterSpriteCacheSize > budget) {
+		MonsterSpriteCacheSize -= MonsterSpriteCache.front().size;
+		MonsterSpriteCache.erase(MonsterSpriteCache.begin());
+	}
+}
+
+std::optional<MonsterSpritesData> TakeCachedMonsterSprites(_monster_id type)
+{
+	const auto it = std::find_if(MonsterSpriteCache.begin(), MonsterSpriteCache.end(), [type](const CachedMonsterSprites &entry) { return entry.type == type; });
+	if (it == MonsterSpriteCache.end())
+		return std::nullopt;
+	MonsterSpritesData sprites = std::move(it->sprites);
+	MonsterSpriteCacheSize -= it->size;
+	MonsterSpriteCache.erase(it);
+	return sprites;
+}
+
+bool HasCachedMonsterSprites(_monster_id type)
+{
+	return std::any_of(MonsterSpriteCache.begin(), MonsterSpriteCache.end(), [type](const CachedMonsterSprites &entry) { return entry.type == type; });
+}
+
+void StoreCachedMonsterSprites(_monster_id type, MonsterSpritesData &&sprites, size_t size)
+{
+	if (size > MonsterSpriteCacheBudget)
+		return;
+	(void)TakeCachedMonsterSprites(type);
+	EvictMonsterSprites(MonsterSpriteCacheBudget - size);
+	MonsterSpriteCache.push_back({ type, std::move(sprites), size });
+	MonsterSpriteCacheSize += size;
+}
+
+tl::expected<MonsterSpritesData, std::string> LoadMonsterSpritesData(const MonsterData &monsterData, bool threadsafe = false)
 {
 	const size_t numAnims = GetNumAnims(monsterData);
 
-	MonsterSpritesData result;
-	result.data = MultiFileLoader<MonsterSpritesData::MaxAnims> {}(
-	    numAnims,
-	    FileNameWithCharAffixGenerator({ "monsters\\", monsterData.spritePath() }, DEVILUTIONX_CL2_EXT, Animletter),
-	    result.offsets.data(),
-	    [&monsterData](size_t index) { return monsterData.hasAnim(index); });
+	MonsterSpritesData result {};
+	const FileNameWithCharAffixGenerator pathFn({ "monsters\\", monsterData.spritePath() }, DEVILUTIONX_CL2_EXT, Animletter);
+
+#ifndef UNPACKED_MPQS
+	// The cached sprites end with the offsets of the animations.
+	constexpr size_t OffsetsSize = sizeof(result.offsets);
+	const size_t numAnimsWithGraphics = GetNumAnimsWithGraphics(monsterData);
+	ConvertedAssetKey key { Cl2ToClxVersion };
+	key.Add(monsterData.width);
+	for (size_t i = 0; i < numAnims; ++i) {
+		if (monsterData.hasAnim(i))
+			key.AddSource(FindAsset(pathFn(i)));
+	}
+	size_t cachedSize;
+	if (std::unique_ptr<std::byte[]> cached = LoadConvertedAsset(key, cachedSize); cached != nullptr && cachedSize >= OffsetsSize) {
+		for (size_t i = 0; i < result.offsets.size(); ++i)
+			result.offsets[i] = LoadLE32(&cached[cachedSize - OffsetsSize + i * 4]);
+		if (result.offsets[numAnimsWithGraphics] == cachedSize - OffsetsSize) {
+			result.data = std::move(cached);
+			return { std::move(result) };
+		}
+	}
+#endif
+
+	MultiFileLoader<MonsterSpritesData::MaxAnims> loader { .threadsafe = threadsafe };
+	ASSIGN_OR_RETURN(result.data, loader(
+	                                  numAnims,
+	                                  pathFn,
+	                                  result.offsets.data(),
+	                                  [&monsterData](size_t index) { return monsterData.hasAnim(index); }));
 
 #ifndef UNPACKED_MPQS
 	// Convert CL2 to CLX:
@@ -3163,13 +3369,16 @@ MonsterSpritesData LoadMonsterSpritesData(const MonsterData &monsterData)
 	}
 	result.offsets[clxData.size()] = static_cast<uint32_t>(accumulatedSize);
 	result.data = nullptr;
-	result.data = std::unique_ptr<std::byte[]>(new std::byte[accumulatedSize]);
+	result.data = std::unique_ptr<std::byte[]>(new std::byte[accumulatedSize + OffsetsSize]);
 	for (size_t i = 0; i < clxData.size(); ++i) {
 		memcpy(&result.data[result.offsets[i]], clxData[i].data(), clxData[i].size());
 	}
+	for (size_t i = 0; i < result.offsets.size(); ++i)
+		WriteLE32(&result.data[accumulatedSize + i * 4], result.offsets[i]);
+	StoreConvertedAsset(key, { result.data.get(), accumulatedSize + OffsetsSize });
 #endif
 
-	return result;
+	return { std::move(result) };
 }
 
 void EnsureMonsterIndexIsActive(size_t monsterId)
@@ -3224,7 +3433,12 @@ tl::expected<size_t, std::string> AddMonsterType(_monster_id type, placeflag pla
 			}
 		}
 
-		RETURN_IF_ERROR(InitMonsterSND(monsterType));
+		// The sounds are loaded with the graphics, drop the ones of a type this replaces.
+		for (auto &variants : monsterType.sounds) {
+			for (auto &sound : variants) {
+				sound = nullptr;
+			}
+		}
 	}
 
 	monsterType.placeFlags |= placeflag;
@@ -3340,7 +3554,9 @@ void InitLevelMonsters()
 	uniquetrans = 0;
 }
 
-tl::expected<void, std::string> GetLevelMTypes()
+namespace {
+
+tl::expected<void, std::string> AddLevelMonsterTypes()
 {
 	RETURN_IF_ERROR(AddMonsterType(MT_GOLEM, PLACE_SPECIAL));
 	if (currlevel == 16) {
@@ -3426,30 +3642,74 @@ tl::expected<void, std::string> GetLevelMTypes()
 	return {};
 }
 
+constexpr std::string_view MonsterSoundPrefixes[] {
+	"a", // Attack
+	"h", // Hit
+	"d", // Death
+	"s", // Special
+};
+
+[[nodiscard]] bool HasMonsterSound(const MonsterData &data, size_t sound)
+{
+	return MonsterSoundPrefixes[sound] != "s" || data.hasSpecialSound;
+}
+
+void GetMonsterSoundPath(char (&path)[64], const MonsterData &data, size_t sound, size_t variant)
+{
+	*BufCopy(path, "monsters\\", data.soundPath(), MonsterSoundPrefixes[sound], variant + 1, ".wav") = '\0';
+}
+
+[[nodiscard]] bool HasMonsterSounds(const CMonster &monsterType)
+{
+	// Every monster has an attack sound.
+	return monsterType.sounds[0][0] != nullptr;
+}
+
+void PrefetchLevelMonsterSounds()
+{
+	std::vector<std::string> paths;
+	for (size_t i = 0; i < LevelMonsterTypeCount; ++i) {
+		const CMonster &monsterType = LevelMonsterTypes[i];
+		if (HasMonsterSounds(monsterType))
+			continue;
+		for (size_t sound = 0; sound < std::size(MonsterSoundPrefixes); sound++) {
+			if (!HasMonsterSound(monsterType.data(), sound))
+				continue;
+			for (size_t variant = 0; variant < 2; variant++) {
+				char path[64];
+				GetMonsterSoundPath(path, monsterType.data(), sound, variant);
+				paths.emplace_back(path);
+			}
+		}
+	}
+	PrefetchSoundFiles(std::move(paths));
+}
+
+} // namespace
+
+tl::expected<void, std::string> GetLevelMTypes()
+{
+	RETURN_IF_ERROR(AddLevelMonsterTypes());
+	// Decode the sounds while the rest of the level is generated, InitAllMonsterGFX() picks them up.
+	if (!HeadlessMode)
+		PrefetchLevelMonsterSounds();
+	return {};
+}
+
 tl::expected<void, std::string> InitMonsterSND(CMonster &monsterType)
 {
 	if (!gbSndInited)
 		return {};
 
-	const char *prefixes[] {
-		"a", // Attack
-		"h", // Hit
-		"d", // Death
-		"s", // Special
-	};
-
 	const MonsterData &data = MonstersData[monsterType.type];
-	const std::string_view soundSuffix = data.soundPath();
-
-	for (int i = 0; i < 4; i++) {
-		const std::string_view prefix = prefixes[i];
-		if (prefix == "s" && !data.hasSpecialSound)
+	for (size_t sound = 0; sound < std::size(MonsterSoundPrefixes); sound++) {
+		if (!HasMonsterSound(data, sound))
 			continue;
 
-		for (int j = 0; j < 2; j++) {
+		for (size_t variant = 0; variant < 2; variant++) {
 			char path[64];
-			*BufCopy(path, "monsters\\", soundSuffix, prefix, j + 1, ".wav") = '\0';
-			ASSIGN_OR_RETURN(monsterType.sounds[i][j], SoundFileLoadWithStatus(path));
+			GetMonsterSoundPath(path, data, sound, variant);
+			ASSIGN_OR_RETURN(monsterType.sounds[sound][variant], SoundFileLoadWithStatus(path));
 		}
 	}
 	return {};
@@ -3457,14 +3717,24 @@ tl::expected<void, std::string> InitMonsterSND(CMonster &monsterType)
 
 tl::expected<void, std::string> InitMonsterGFX(CMonster &monsterType, MonsterSpritesData &&spritesData)
 {
+	if (!HasMonsterSounds(monsterType))
+		RETURN_IF_ERROR(InitMonsterSND(monsterType));
 	if (HeadlessMode)
 		return {};
 
 	const _monster_id mtype = monsterType.type;
 	const MonsterData &monsterData = MonstersData[mtype];
-	if (spritesData.data == nullptr)
-		spritesData = LoadMonsterSpritesData(monsterData);
+	bool translated = false;
+	if (spritesData.data == nullptr) {
+		if (std::optional<MonsterSpritesData> cached = TakeCachedMonsterSprites(mtype); cached) {
+			spritesData = std::move(*cached);
+			translated = true;
+		} else {
+			ASSIGN_OR_RETURN(spritesData, LoadMonsterSpritesData(monsterData));
+		}
+	}
 	monsterType.animData = std::move(spritesData.data);
+	monsterType.animOffsets = spritesData.offsets;
 
 	const size_t numAnims = GetNumAnims(monsterData);
 	for (size_t i = 0, j = 0; i < numAnims; ++i) {
@@ -3480,7 +3750,7 @@ tl::expected<void, std::string> InitMonsterGFX(CMonster &monsterType, MonsterSpr
 		++j;
 	}
 
-	if (!monsterData.trnFile.empty()) {
+	if (!translated && !monsterData.trnFile.empty()) {
 		InitMonsterTRN(monsterType);
 	}
 
@@ -3531,23 +3801,55 @@ tl::expected<void, std::string> InitMonsterGFX(CMonster &monsterType, MonsterSpr
 
 tl::expected<void, std::string> InitAllMonsterGFX()
 {
+	for (size_t i = 0; i < LevelMonsterTypeCount; ++i) {
+		CMonster &monsterType = LevelMonsterTypes[i];
+		if (!HasMonsterSounds(monsterType))
+			RETURN_IF_ERROR(InitMonsterSND(monsterType));
+	}
+	ReleasePrefetchedSoundFiles();
+
 	if (HeadlessMode)
 		return {};
 
+	// Types seen on a recent level come from the cache, already converted and translated.
+	size_t cachedTypes = 0;
+	for (size_t i = 0; i < LevelMonsterTypeCount; ++i) {
+		CMonster &monsterType = LevelMonsterTypes[i];
+		if (monsterType.animData != nullptr || !HasCachedMonsterSprites(monsterType.type))
+			continue;
+		RETURN_IF_ERROR(InitMonsterGFX(monsterType));
+		++cachedTypes;
+	}
+
 	using LevelMonsterTypeIndices = StaticVector<size_t, 8>;
 	std::vector<LevelMonsterTypeIndices> monstersBySprite(GetNumMonsterSprites());
 	for (size_t i = 0; i < LevelMonsterTypeCount; ++i) {
-		monstersBySprite[static_cast<size_t>(LevelMonsterTypes[i].data().spriteId)].emplace_back(i);
+		if (LevelMonsterTypes[i].animData == nullptr)
+			monstersBySprite[static_cast<size_t>(LevelMonsterTypes[i].data().spriteId)].emplace_back(i);
+	}
+	std::vector<const LevelMonsterTypeIndices *> spritesToLoad;
+	for (const LevelMonsterTypeIndices &monsterTypes : monstersBySprite) {
+		if (!monsterTypes.empty())
+			spritesToLoad.push_back(&monsterTypes);
 	}
+
+	// Reading and converting the sprites of each monster doesn't depend on the others, and dominates
+	// the level load, so do it on the render workers, which are idle until the level is shown.
+	// A worker must not call app_fatal, so the errors are only reported back here.
+	std::vector<tl::expected<MonsterSpritesData, std::string>> loadedSprites(spritesToLoad.size());
+	RunRenderBands(static_cast<int>(spritesToLoad.size()), [&](int i) {
+		const CMonster &firstMonster = LevelMonsterTypes[(*spritesToLoad[i])[0]];
+		loadedSprites[i] = LoadMonsterSpritesData(firstMonster.data(), /*threadsafe=*/true);
+	});
+
 	size_t totalUniqueBytes = 0;
 	size_t totalBytes = 0;
-	for (const LevelMonsterTypeIndices &monsterTypes : monstersBySprite) {
-		if (monsterTypes.empty())
-			continue;
+	for (size_t sprite = 0; sprite < spritesToLoad.size(); ++sprite) {
+		const LevelMonsterTypeIndices &monsterTypes = *spritesToLoad[sprite];
 		CMonster &firstMonster = LevelMonsterTypes[monsterTypes[0]];
-		if (firstMonster.animData != nullptr)
-			continue;
-		MonsterSpritesData spritesData = LoadMonsterSpritesData(firstMonster.data());
+		if (!loadedSprites[sprite].has_value())
+			return tl::make_unexpected(std::move(loadedSprites[sprite]).error());
+		MonsterSpritesData &spritesData = *loadedSprites[sprite];
 		const size_t spritesDataSize = spritesData.offsets[GetNumAnimsWithGraphics(firstMonster.data())];
 		for (size_t i = 1; i < monsterTypes.size(); ++i) {
 			MonsterSpritesData spritesDataCopy { std::unique_ptr<std::byte[]> { new std::byte[spritesDataSize] }, spritesData.offsets };
@@ -3559,9 +3861,9 @@ tl::expected<void, std::string> InitAllMonsterGFX()
 		totalBytes += spritesDataSize * monsterTypes.size();
 		RETURN_IF_ERROR(InitMonsterGFX(firstMonster, std::move(spritesData)));
 	}
-	LogVerbose(" Total monster graphics:                 {:>4d} KiB {:>4d} KiB", totalUniqueBytes / 1024, totalBytes / 1024);
+	LogVerbose(" Total monster graphics:                 {:>4d} KiB {:>4d} KiB, {:d} types cached", totalUniqueBytes / 1024, totalBytes / 1024, cachedTypes);
 
-	if (totalUniqueBytes > 0) {
+	if (totalUniqueBytes > 0 || cachedTypes > 0) {
 		// we loaded new sprites, check if we need to update existing monsters
 		for (size_t i = 0; i < ActiveMonsterCount; i++) {
 			Monster &monster = Monsters[ActiveMonsters[i]];
@@ -3776,11 +4078,29 @@ void AddDoppelganger(Monster &monster)
 	}
 }
 
+void MarkMonsterHealthChanged(const Monster &monster)
+{
+	const size_t monsterId = monster.getId();
+	if (IsMonsterHealthChangeListed[monsterId])
+		return;
+	IsMonsterHealthChangeListed[monsterId] = true;
+	MonstersWithChangedHealth.push_back(monsterId);
+}
+
+void TakeMonstersWithChangedHealth(std::vector<size_t> &monsterIds)
+{
+	monsterIds.clear();
+	monsterIds.swap(MonstersWithChangedHealth);
+	for (const size_t monsterId : monsterIds)
+		IsMonsterHealthChangeListed[monsterId] = false;
+}
+
 void ApplyMonsterDamage(DamageType damageType, Monster &monster, int damage)
 {
 	LuaEvent("OnMonsterTakeDamage", &monster, damage, static_cast<int>(damageType));
 
 	monster.hitPoints -= damage;
+	MarkMonsterHealthChanged(monster);
 
 	if (monster.hasNoLife()) {
 		delta_kill_monster(monster, monster.position.tile, *MyPlayer);
@@ -3873,6 +4193,7 @@ void MonsterDeath(Monster &monster, Direction md, bool sendmsg)
 
 	MonsterKillCounts[monster.type().type]++;
 	monster.hitPoints = 0;
+	MarkMonsterHealthChanged(monster);
 	monster.flags &= ~MFLAG_HIDDEN;
 	SetRndSeed(monster.rndItemSeed);
 
@@ -4127,83 +4448,144 @@ void RemoveEnemyReferences(const Player &player)
 	}
 }
 
-void ProcessMonsters()
+void UpdateActiveMonsterHotState()
 {
-	DeleteMonsterList();
-
-	assert(ActiveMonsterCount <= MaxMonsters);
+	ActiveMonsterHotState &hot = ActiveMonsterHot;
+	hot.count = ActiveMonsterCount;
 	for (size_t i = 0; i < ActiveMonsterCount; i++) {
-		Monster &monster = Monsters[ActiveMonsters[i]];
-		FollowTheLeader(monster);
-		if (gbIsMultiplayer) {
-			SetRndSeed(monster.aiSeed);
-			monster.aiSeed = AdvanceRndSeed();
+		const Monster &monster = Monsters[ActiveMonsters[i]];
+		hot.id[i] = static_cast<uint16_t>(ActiveMonsters[i]);
+		hot.tile[i] = monster.position.tile;
+		hot.future[i] = monster.position.future;
+		hot.mode[i] = monster.mode;
+		hot.flags[i] = monster.flags;
+		hot.hitPoints[i] = monster.hitPoints;
+		hot.enemy[i] = monster.enemy;
+		hot.isInvalid[i] = monster.isInvalid;
+	}
+}
+
+namespace {
+
+/** @brief Updates a monster for a game tick: its life, its enemy, its AI and its animation. */
+void ProcessMonster(Monster &monster)
+{
+	FollowTheLeader(monster);
+	if (gbIsMultiplayer) {
+		SetRndSeed(monster.aiSeed);
+		monster.aiSeed = AdvanceRndSeed();
+	}
+	if (monster.hitPoints < monster.maxHitPoints && !monster.hasNoLife()) {
+		if (monster.level(sgGameInitInfo.nDifficulty) > 1) {
+			monster.hitPoints += monster.level(sgGameInitInfo.nDifficulty) / 2;
+		} else {
+			monster.hitPoints += monster.level(sgGameInitInfo.nDifficulty);
+		}
+		monster.hitPoints = std::min(monster.hitPoints, monster.maxHitPoints); // prevent going over max HP with part of a single regen tick
+	}
+
+	const bool isMonsterVisible = IsTileVisible(monster.position.tile);
+	if (isMonsterVisible && monster.activeForTicks == 0) {
+		if (monster.type().type == MT_CLEAVER) {
+			PlaySFX(SfxID::ButcherGreeting);
 		}
-		if (monster.hitPoints < monster.maxHitPoints && !monster.hasNoLife()) {
-			if (monster.level(sgGameInitInfo.nDifficulty) > 1) {
-				monster.hitPoints += monster.level(sgGameInitInfo.nDifficulty) / 2;
+		if (monster.type().type == MT_NAKRUL) {
+			if (sgGameInitInfo.bCowQuest != 0) {
+				PlaySFX(SfxID::NaKrul6);
 			} else {
-				monster.hitPoints += monster.level(sgGameInitInfo.nDifficulty);
+				if (IsUberRoomOpened)
+					PlaySFX(SfxID::NaKrul4);
+				else
+					PlaySFX(SfxID::NaKrul5);
 			}
-			monster.hitPoints = std::min(monster.hitPoints, monster.maxHitPoints); // prevent going over max HP with part of a single regen tick
 		}
+		if (monster.type().type == MT_DEFILER)
+			PlaySFX(SfxID::Defiler8);
+		UpdateEnemy(monster);
+	}
 
-		const bool isMonsterVisible = IsTileVisible(monster.position.tile);
-		if (isMonsterVisible && monster.activeForTicks == 0) {
-			if (monster.type().type == MT_CLEAVER) {
-				PlaySFX(SfxID::ButcherGreeting);
-			}
-			if (monster.type().type == MT_NAKRUL) {
-				if (sgGameInitInfo.bCowQuest != 0) {
-					PlaySFX(SfxID::NaKrul6);
-				} else {
-					if (IsUberRoomOpened)
-						PlaySFX(SfxID::NaKrul4);
-					else
-						PlaySFX(SfxID::NaKrul5);
-				}
+	if ((monster.flags & MFLAG_NO_ENEMY) == 0) {
+		if ((monster.flags & MFLAG_TARGETS_MONSTER) != 0) {
+			assert(monster.enemy >= 0 && monster.enemy < MaxMonsters);
+			monster.position.last = Monsters[monster.enemy].position.future;
+			monster.enemyPosition = monster.position.last;
+		} else {
+			assert(monster.enemy >= 0 && monster.enemy < MAX_PLRS);
+			const Player &player = Players[monster.enemy];
+			monster.enemyPosition = player.position.future;
+			if (isMonsterVisible) {
+				monster.position.last = player.position.future;
 			}
-			if (monster.type().type == MT_DEFILER)
-				PlaySFX(SfxID::Defiler8);
-			UpdateEnemy(monster);
 		}
+	}
 
-		if ((monster.flags & MFLAG_NO_ENEMY) == 0) {
-			if ((monster.flags & MFLAG_TARGETS_MONSTER) != 0) {
-				assert(monster.enemy >= 0 && monster.enemy < MaxMonsters);
-				monster.position.last = Monsters[monster.enemy].position.future;
-				monster.enemyPosition = monster.position.last;
-			} else {
-				assert(monster.enemy >= 0 && monster.enemy < MAX_PLRS);
-				const Player &player = Players[monster.enemy];
-				monster.enemyPosition = player.position.future;
-				if (isMonsterVisible) {
-					monster.position.last = player.position.future;
-				}
-			}
+	if ((monster.flags & MFLAG_TARGETS_MONSTER) == 0) {
+		if (isMonsterVisible) {
+			monster.activeForTicks = UINT8_MAX;
+		} else if (monster.activeForTicks != 0 && monster.type().type != MT_DIABLO) {
+			monster.activeForTicks--;
 		}
+	}
 
-		if ((monster.flags & MFLAG_TARGETS_MONSTER) == 0) {
-			if (isMonsterVisible) {
-				monster.activeForTicks = UINT8_MAX;
-			} else if (monster.activeForTicks != 0 && monster.type().type != MT_DIABLO) {
-				monster.activeForTicks--;
-			}
+	while (true) {
+		if ((monster.flags & MFLAG_SEARCH) == 0 || !AiPlanPath(monster)) {
+			AiProc[static_cast<int8_t>(monster.ai)](monster);
 		}
 
-		while (true) {
-			if ((monster.flags & MFLAG_SEARCH) == 0 || !AiPlanPath(monster)) {
-				AiProc[static_cast<int8_t>(monster.ai)](monster);
-			}
+		if (!UpdateModeStance(monster))
+			break;
 
-			if (!UpdateModeStance(monster))
-				break;
+		GroupUnity(monster);
+	}
+	if (monster.mode != MonsterMode::Petrified && (monster.flags & MFLAG_ALLOW_SPECIAL) == 0) {
+		monster.animInfo.processAnimation((monster.flags & MFLAG_LOCK_ANIMATION) != 0);
+	}
+}
 
-			GroupUnity(monster);
-		}
-		if (monster.mode != MonsterMode::Petrified && (monster.flags & MFLAG_ALLOW_SPECIAL) == 0) {
-			monster.animInfo.processAnimation((monster.flags & MFLAG_LOCK_ANIMATION) != 0);
-		}
+/**
+ * @brief Whether to update the monsters grouped by AI, so that each AI runs for all its monsters in a row.
+ *
+ * The order monsters act in decides who gets to a tile first and the order of the random numbers, so
+ * the order they were activated in is kept in multiplayer and in demos, which must play out the same.
+ */
+bool ShouldGroupMonsterAi()
+{
+	return *GetOptions().Gameplay.groupMonsterAi && !gbIsMultiplayer && !demo::IsRunning() && !demo::IsRecording();
+}
+
+/** @brief The active monsters ordered by AI, in activation order within each AI. */
+std::span<const unsigned> ActiveMonstersByAi()
+{
+	static std::array<unsigned, MaxMonsters> ordered;
+	std::array<size_t, std::size(AiProc) + 1> starts {};
+	for (size_t i = 0; i < ActiveMonsterCount; i++)
+		starts[static_cast<size_t>(Monsters[ActiveMonsters[i]].ai) + 1]++;
+	std::partial_sum(starts.begin(), starts.end(), starts.begin());
+	for (size_t i = 0; i < ActiveMonsterCount; i++) {
+		const unsigned monsterId = ActiveMonsters[i];
+		ordered[starts[static_cast<size_t>(Monsters[monsterId].ai)]++] = monsterId;
+	}
+	return { ordered.data(), ActiveMonsterCount };
+}
+
+} // namespace
+
+void ProcessMonsters()
+{
+	DeleteMonsterList();
+	MonsterPathFieldTick++;
+
+	assert(ActiveMonsterCount <= MaxMonsters);
+	size_t processed = 0;
+	if (ShouldGroupMonsterAi()) {
+		const std::span<const unsigned> monsterIds = ActiveMonstersByAi();
+		for (const unsigned monsterId : monsterIds)
+			ProcessMonster(Monsters[monsterId]);
+		processed = monsterIds.size();
+	}
+	// Monsters activated during the loop are updated in the same tick.
+	for (size_t i = processed; i < ActiveMonsterCount; i++) {
+		ProcessMonster(Monsters[ActiveMonsters[i]]);
 	}
 
 	DeleteMonsterList();
@@ -4212,6 +4594,10 @@ void ProcessMonsters()
 void FreeMonsters()
 {
 	for (CMonster &monsterType : LevelMonsterTypes) {
+		if (monsterType.animData != nullptr) {
+			const size_t size = monsterType.animOffsets[GetNumAnimsWithGraphics(monsterType.data())];
+			StoreCachedMonsterSprites(monsterType.type, { std::move(monsterType.animData), monsterType.animOffsets }, size);
+		}
 		monsterType.animData = nullptr;
 		monsterType.corpseId = 0;
 		for (AnimStruct &animData : monsterType.anims) {
@@ -4226,6 +4612,12 @@ void FreeMonsters()
 	}
 }
 
+void ClearMonsterSpriteCache()
+{
+	MonsterSpriteCache.clear();
+	MonsterSpriteCacheSize = 0;
+}
+
 bool DirOK(const Monster &monster, Direction mdir)
 {
 	const Point position = monster.position.tile;
@@ -4983,6 +5375,7 @@ void Monster::occupyTile(Point tile, bool isMoving) const
 {
 	const auto id = static_cast<int16_t>(this->getId() + 1);
 	dMonster[tile.x][tile.y] = isMoving ? -id : id;
+	MarkMissileTarget(tile);
 }
 
 } // namespace devilution
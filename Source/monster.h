@@ -11,6 +11,7 @@
 #include <array>
 #include <functional>
 #include <string>
+#include <vector>
 
 #include <expected.hpp>
 #include <function_ref.hpp>
@@ -185,6 +186,8 @@ struct MonsterSpritesData {
 
 struct CMonster {
 	std::unique_ptr<std::byte[]> animData;
+	/** Where each animation with graphics starts in animData, see MonsterSpritesData. */
+	std::array<uint32_t, MonsterSpritesData::MaxAnims + 1> animOffsets {};
 	AnimStruct anims[6];
 	std::unique_ptr<TSnd> sounds[4][2];
 
@@ -483,10 +486,36 @@ struct Monster { // note: missing field _mAFNum
 	}
 };
 
+/**
+ * @brief Dense copy of the monster fields that per-tick scans filter on, in ActiveMonsters order.
+ *
+ * Refreshed once the game logic of a tick is done, so the scans running after it can skip most
+ * monsters without pulling their whole Monster into the cache.
+ */
+struct ActiveMonsterHotState {
+	size_t count;
+	std::array<uint16_t, MaxMonsters> id;
+	std::array<WorldTilePosition, MaxMonsters> tile;
+	std::array<WorldTilePosition, MaxMonsters> future;
+	std::array<MonsterMode, MaxMonsters> mode;
+	std::array<uint32_t, MaxMonsters> flags;
+	std::array<int, MaxMonsters> hitPoints;
+	std::array<uint8_t, MaxMonsters> enemy;
+	std::array<bool, MaxMonsters> isInvalid;
+
+	/** @brief Whether the `i`-th active monster is alive and neither hidden nor invalid. */
+	[[nodiscard]] bool isPresent(size_t i) const
+	{
+		return !isInvalid[i] && (flags[i] & MFLAG_HIDDEN) == 0 && hitPoints[i] > 0;
+	}
+};
+
 extern size_t LevelMonsterTypeCount;
 extern Monster Monsters[MaxMonsters];
 extern unsigned ActiveMonsters[MaxMonsters];
 extern size_t ActiveMonsterCount;
+/** Only up to date between the end of a tick's game logic and the start of the next one. */
+extern ActiveMonsterHotState ActiveMonsterHot;
 extern int MonsterKillCounts[NUM_MAX_MTYPES];
 extern bool sgbSaveSoundOn;
 
@@ -522,6 +551,14 @@ void LoadDeltaSpawnedMonster(size_t typeIndex, size_t monsterId, uint32_t seed,
 void InitializeSpawnedMonster(Point position, Direction dir, size_t typeIndex, size_t monsterId, uint32_t seed, uint8_t golemOwnerPlayerId, int16_t golemSpellLevel);
 void AddDoppelganger(Monster &monster);
 void ApplyMonsterDamage(DamageType damageType, Monster &monster, int damage);
+/**
+ * @brief Records that the hit points of the monster went down, see TakeMonstersWithChangedHealth.
+ */
+void MarkMonsterHealthChanged(const Monster &monster);
+/**
+ * @brief Moves the ids of the monsters that took damage or died since the last call into `monsterIds`.
+ */
+void TakeMonstersWithChangedHealth(std::vector<size_t> &monsterIds);
 bool M_Talker(const Monster &monster);
 void M_StartStand(Monster &monster, Direction md);
 void M_ClearSquares(const Monster &monster);
@@ -541,7 +578,12 @@ void GolumAi(Monster &golem);
 void DeleteMonsterList();
 void RemoveEnemyReferences(const Player &player);
 void ProcessMonsters();
+/** @brief Copies the active monsters' state into ActiveMonsterHot, call when the game logic of a tick is done. */
+void UpdateActiveMonsterHotState();
+/** @brief Frees the graphics of the level, keeping the most recent ones for the next levels. */
 void FreeMonsters();
+/** @brief Frees the graphics FreeMonsters kept, call when the game ends. */
+void ClearMonsterSpriteCache();
 bool DirOK(const Monster &monster, Direction mdir);
 bool PosOkMissile(Point position);
 bool LineClearMissile(Point startPoint, Point endPoint);
@@ -0,0 +1,160 @@
+/**
+ * @file mpq/block_read_ahead.hpp
+ *
+ * Decompresses the blocks of a file ahead of the reads on a background thread.
+ */
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+#include "utils/sdl_cond.h"
+#include "utils/sdl_mutex.h"
+#include "utils/sdl_thread.h"
+
+namespace devilution {
+
+/**
+ * @brief Decompresses the blocks after the one being read on a background thread.
+ *
+ * `readBlock` is only called on the background thread, so an archive it reads from has to be
+ * one of its own. Blocks are kept in a ring of `ReadAheadBlocks` slots, starting at the block
+ * read last. Reading a block outside of that window, after a seek, restarts it there.
+ */
+class BlockReadAhead {
+public:
+	static constexpr uint32_t ReadAheadBlocks = 16;
+
+	/** Reads block `block` of `size` bytes into `out`, returns 0 or the error. */
+	using ReadBlockFn = std::function<int32_t(uint32_t block, uint8_t *out, size_t size)>;
+
+	BlockReadAhead(ReadBlockFn readBlock, uint32_t numBlocks, size_t blockSize, size_t lastBlockSize)
+	    : readBlock_(std::move(readBlock))
+	    , numBlocks_(numBlocks)
+	    , blockSize_(blockSize)
+	    , lastBlockSize_(lastBlockSize)
+	{
+		for (Slot &slot : slots_)
+			slot.data = std::unique_ptr<uint8_t[]> { new uint8_t[blockSize] };
+		thread_ = SdlThread { &BlockReadAhead::Run, this };
+	}
+
+	~BlockReadAhead()
+	{
+		{
+			const std::lock_guard<SdlMutex> lock(mutex_);
+			stop_ = true;
+		}
+		workAvailable_.signal();
+		thread_.join();
+	}
+
+	BlockReadAhead(const BlockReadAhead &) = delete;
+	BlockReadAhead &operator=(const BlockReadAhead &) = delete;
+
+	/**
+	 * @brief Copies the decompressed block into `out`, waiting for it if it isn't ready yet.
+	 * @return 0, or the error of reading this block or one before it in the window
+	 */
+	int32_t ReadBlock(uint32_t blockNumber, uint8_t *out, size_t outSize)
+	{
+		const std::lock_guard<SdlMutex> lock(mutex_);
+		if (blockNumber < first_ || blockNumber >= first_ + ReadAheadBlocks) {
+			// A seek: drop the block being decompressed and start over from here.
+			next_ = blockNumber;
+			failedBlock_ = NoBlock;
+			generation_++;
+		}
+		first_ = blockNumber;
+		workAvailable_.signal();
+
+		const Slot &slot = slots_[blockNumber % ReadAheadBlocks];
+		while (slot.block != blockNumber) {
+			// The background thread stops at an error, the blocks after it never come.
+			if (blockNumber >= failedBlock_)
+				return failedError_;
+			blockReady_.wait(mutex_);
+		}
+		std::memcpy(out, slot.data.get(), outSize);
+		return 0;
+	}
+
+private:
+	static constexpr uint32_t NoBlock = static_cast<uint32_t>(-1);
+
+	struct Slot {
+		uint32_t block = NoBlock;
+		std::unique_ptr<uint8_t[]> data;
+	};
+
+	static int SDLCALL Run(void *self)
+	{
+		static_cast<BlockReadAhead *>(self)->Run();
+		return 0;
+	}
+
+	void Run()
+	{
+		const std::unique_ptr<uint8_t[]> buffer { new uint8_t[blockSize_] };
+		std::unique_lock<SdlMutex> lock(mutex_);
+		while (!stop_) {
+			if (next_ >= numBlocks_ || next_ >= first_ + ReadAheadBlocks) {
+				workAvailable_.wait(mutex_);
+				continue;
+			}
+			const uint32_t block = next_;
+			const uint32_t generation = generation_;
+			const size_t size = block + 1 == numBlocks_ ? lastBlockSize_ : blockSize_;
+
+			lock.unlock();
+			const int32_t error = readBlock_(block, buffer.get(), size);
+			lock.lock();
+
+			if (generation != generation_)
+				continue;
+			if (error == 0) {
+				Slot &slot = slots_[block % ReadAheadBlocks];
+				slot.block = block;
+				std::memcpy(slot.data.get(), buffer.get(), size);
+				next_ = block + 1;
+			} else {
+				// Stop at an error, the reader gets it for this block and any after it.
+				// It isn't kept in the slot, so that a seek back to the block retries it.
+				failedBlock_ = block;
+				failedError_ = error;
+				next_ = numBlocks_;
+			}
+			blockReady_.signal();
+		}
+	}
+
+	ReadBlockFn readBlock_;
+	uint32_t numBlocks_;
+	size_t blockSize_;
+	size_t lastBlockSize_;
+
+	SdlMutex mutex_;
+	SdlCond workAvailable_;
+	SdlCond blockReady_;
+	std::array<Slot, ReadAheadBlocks> slots_;
+	/** The block read last, the window ends `ReadAheadBlocks` after it. */
+	uint32_t first_ = 0;
+	/** The next block for the background thread to decompress. */
+	uint32_t next_ = 0;
+	/** The block the background thread stopped at with `failedError_`, NoBlock if none. */
+	uint32_t failedBlock_ = NoBlock;
+	int32_t failedError_ = 0;
+	/** Changes on every seek, so that a block decompressed for the old position is dropped. */
+	uint32_t generation_ = 0;
+	bool stop_ = false;
+
+	SdlThread thread_;
+};
+
+} // namespace devilution
@@ -2,13 +2,79 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
 #include <optional>
+#include <span>
 #include <string_view>
+#include <vector>
 
 #include <libmpq/mpq.h>
 
+#include "encrypt.h"
+#include "engine/asset_stats.hpp"
+#include "utils/endian_read.hpp"
+#include "utils/file_util.h"
+#include "utils/fnv1a.hpp"
+
 namespace devilution {
 
+namespace {
+
+/**
+ * @brief Maps the archive, if it starts at the beginning of the file.
+ *
+ * File offsets are only the same in the mapping and the archive in that case, which is how all
+ * the game's MPQs are laid out.
+ */
+std::shared_ptr<const MappedFile> MapArchive(const char *path)
+{
+	std::unique_ptr<MappedFile> mapping = MappedFile::Open(path);
+	if (mapping == nullptr)
+		return nullptr;
+	constexpr char Signature[] = { 'M', 'P', 'Q', '\x1A' };
+	const std::span<const std::byte> data = mapping->data();
+	if (data.size() < sizeof(Signature) || std::memcmp(data.data(), Signature, sizeof(Signature)) != 0)
+		return nullptr;
+	return mapping;
+}
+
+/**
+ * @brief FNV-1a hash of the header, hash table and block table of a mapped archive.
+ *
+ * The block table has the offset, size and flags of every file, so any change to the archive's
+ * contents changes the hash.
+ */
+uint64_t FingerprintArchive(const MappedFile *mapping)
+{
+	if (mapping == nullptr)
+		return 0;
+	const std::span<const std::byte> data = mapping->data();
+	constexpr size_t HeaderSize = 32;
+	constexpr size_t TableEntrySize = 16;
+	if (data.size() < HeaderSize)
+		return 0;
+
+	uint64_t hash = Fnv1aOffsetBasis;
+	const auto hashBytes = [&hash](std::span<const std::byte> bytes) {
+		hash = Fnv1a(bytes, hash);
+	};
+	const auto hashTable = [&](size_t offsetInHeader, size_t entriesInHeader) {
+		const size_t offset = LoadLE32(&data[offsetInHeader]);
+		const size_t size = static_cast<size_t>(LoadLE32(&data[entriesInHeader])) * TableEntrySize;
+		if (offset <= data.size() && size <= data.size() - offset)
+			hashBytes(data.subspan(offset, size));
+	};
+	hashBytes(data.first(HeaderSize));
+	hashTable(16, 24);
+	hashTable(20, 28);
+	// 0 means "not mapped".
+	return hash != 0 ? hash : 1;
+}
+
+} // namespace
+
 std::optional<MpqArchive> MpqArchive::Open(const char *path, int32_t &error)
 {
 	mpq_archive_s *archive;
@@ -18,7 +84,9 @@ std::optional<MpqArchive> MpqArchive::Open(const char *path, int32_t &error)
 			error = 0;
 		return std::nullopt;
 	}
-	return MpqArchive { std::string(path), archive };
+	std::shared_ptr<const MappedFile> mapping = MapArchive(path);
+	const uint64_t fingerprint = FingerprintArchive(mapping.get());
+	return MpqArchive { std::string(path), archive, std::move(mapping), fingerprint };
 }
 
 std::optional<MpqArchive> MpqArchive::Clone(int32_t &error)
@@ -27,7 +95,7 @@ std::optional<MpqArchive> MpqArchive::Clone(int32_t &error)
 	error = libmpq__archive_dup(archive_, path_.c_str(), &copy);
 	if (error != 0)
 		return std::nullopt;
-	return MpqArchive { path_, copy };
+	return MpqArchive { path_, copy, mapping_, fingerprint_ };
 }
 
 const char *MpqArchive::ErrorMessage(int32_t errorCode)
@@ -42,6 +110,8 @@ MpqArchive &MpqArchive::operator=(MpqArchive &&other) noexcept
 		libmpq__archive_close(archive_);
 	archive_ = other.archive_;
 	other.archive_ = nullptr;
+	mapping_ = std::move(other.mapping_);
+	fingerprint_ = other.fingerprint_;
 	tmp_buf_ = std::move(other.tmp_buf_);
 	return *this;
 }
@@ -65,41 +135,80 @@ std::unique_ptr<std::byte[]> MpqArchive::ReadFile(std::string_view filename, std
 	if (error != 0)
 		return result;
 
-	libmpq__off_t unpackedSize;
-	error = libmpq__file_size_unpacked(archive_, fileNumber, &unpackedSize);
+	const std::size_t unpackedSize = GetUnpackedFileSize(fileNumber, error);
 	if (error != 0)
 		return result;
 
-	error = OpenBlockOffsetTable(fileNumber, filename);
-	if (error != 0)
+	result = std::make_unique<std::byte[]>(unpackedSize);
+	error = ReadFile(fileNumber, filename, result.get(), unpackedSize);
+	if (error != 0) {
+		result = nullptr;
 		return result;
+	}
 
-	result = std::make_unique<std::byte[]>(static_cast<size_t>(unpackedSize));
+	fileSize = unpackedSize;
+	return result;
+}
 
-	const std::size_t blockSize = GetBlockSize(fileNumber, 0, error);
-	if (error != 0)
-		return result;
+int32_t MpqArchive::ReadFile(uint32_t fileNumber, std::string_view filename, std::byte *out, std::size_t outSize)
+{
+	const std::span<const std::byte> stored = GetStoredFileView(fileNumber);
+	if (!stored.empty()) {
+		if (stored.size() != outSize)
+			return LIBMPQ_ERROR_SIZE;
+		std::memcpy(out, stored.data(), outSize);
+		return 0;
+	}
 
-	std::vector<std::uint8_t> &tmp = GetTemporaryBuffer(blockSize);
+	const ScopedMpqDecompressTimer timer(path_, fileNumber);
+	int32_t error = OpenBlockOffsetTable(fileNumber, filename);
 	if (error != 0)
-		return result;
+		return error;
 
-	error = libmpq__file_read_with_filename_and_temporary_buffer_s(
-	    archive_, fileNumber, filename.data(), filename.size(), reinterpret_cast<std::uint8_t *>(result.get()), unpackedSize,
-	    tmp.data(), static_cast<libmpq__off_t>(blockSize), nullptr);
-	if (error != 0) {
-		result = nullptr;
-		CloseBlockOffsetTable(fileNumber);
-		return result;
+	const std::size_t blockSize = GetBlockSize(fileNumber, 0, error);
+	if (error == 0) {
+		std::vector<std::uint8_t> &tmp = GetTemporaryBuffer(blockSize);
+		error = libmpq__file_read_with_filename_and_temporary_buffer_s(
+		    archive_, fileNumber, filename.data(), filename.size(), reinterpret_cast<std::uint8_t *>(out), static_cast<libmpq__off_t>(outSize),
+		    tmp.data(), static_cast<libmpq__off_t>(blockSize), nullptr);
 	}
 	CloseBlockOffsetTable(fileNumber);
+	return error;
+}
 
-	fileSize = static_cast<size_t>(unpackedSize);
-	return result;
+std::span<const std::byte> MpqArchive::GetStoredFileView(uint32_t fileNumber)
+{
+	if (mapping_ == nullptr)
+		return {};
+
+	uint32_t compressed;
+	uint32_t imploded;
+	uint32_t encrypted;
+	if (libmpq__file_compressed(archive_, fileNumber, &compressed) != 0
+	    || libmpq__file_imploded(archive_, fileNumber, &imploded) != 0
+	    || libmpq__file_encrypted(archive_, fileNumber, &encrypted) != 0
+	    || compressed != 0 || imploded != 0 || encrypted != 0)
+		return {};
+
+	libmpq__off_t offset;
+	libmpq__off_t packedSize;
+	libmpq__off_t unpackedSize;
+	if (libmpq__file_offset(archive_, fileNumber, &offset) != 0
+	    || libmpq__file_size_packed(archive_, fileNumber, &packedSize) != 0
+	    || libmpq__file_size_unpacked(archive_, fileNumber, &unpackedSize) != 0
+	    || packedSize != unpackedSize)
+		return {};
+
+	const std::span<const std::byte> data = mapping_->data();
+	if (offset < 0 || unpackedSize <= 0 || static_cast<uint64_t>(offset) > data.size()
+	    || static_cast<uint64_t>(unpackedSize) > data.size() - static_cast<size_t>(offset))
+		return {};
+	return data.subspan(static_cast<size_t>(offset), static_cast<size_t>(unpackedSize));
 }
 
 int32_t MpqArchive::ReadBlock(uint32_t fileNumber, uint32_t blockNumber, uint8_t *out, size_t outSize)
 {
+	const ScopedMpqDecompressTimer timer(path_, fileNumber);
 	std::vector<std::uint8_t> &tmpBuf = GetTemporaryBuffer(outSize);
 	return libmpq__block_read_with_temporary_buffer(
 	    archive_, fileNumber, blockNumber, out, static_cast<libmpq__off_t>(outSize),
@@ -146,4 +255,62 @@ bool MpqArchive::HasFile(std::string_view filename) const
 	return error == 0;
 }
 
+bool MpqArchive::ReadHashTable(std::vector<MpqHashEntry> &entries) const
+{
+	constexpr size_t HeaderSize = 32;
+	std::vector<std::byte> bytes;
+	const auto readBytes = [&](std::FILE *file, size_t offset, size_t size) {
+		bytes.resize(size);
+		if (mapping_ != nullptr) {
+			const std::span<const std::byte> data = mapping_->data();
+			if (offset > data.size() || size > data.size() - offset)
+				return false;
+			std::memcpy(bytes.data(), &data[offset], size);
+			return true;
+		}
+		return std::fseek(file, static_cast<long>(offset), SEEK_SET) == 0
+		    && std::fread(bytes.data(), size, 1, file) == 1;
+	};
+
+	std::uintmax_t archiveSize;
+	std::FILE *file = nullptr;
+	if (mapping_ != nullptr) {
+		archiveSize = mapping_->data().size();
+	} else {
+		if (!GetFileSize(path_.c_str(), &archiveSize))
+			return false;
+		file = OpenFile(path_.c_str(), "rb");
+		if (file == nullptr)
+			return false;
+	}
+	bool ok = readBytes(file, 0, HeaderSize) && LoadLE32(&bytes[0]) == MpqFileHeader::DiabloSignature;
+	if (ok) {
+		const size_t offset = LoadLE32(&bytes[16]);
+		const size_t count = LoadLE32(&bytes[24]);
+		// The count comes from the file, so it must fit in it before anything is allocated for it.
+		ok = offset <= archiveSize && count <= (archiveSize - offset) / sizeof(MpqHashEntry)
+		    && readBytes(file, offset, count * sizeof(MpqHashEntry));
+		if (ok) {
+			std::vector<uint32_t> words(count * sizeof(MpqHashEntry) / sizeof(uint32_t));
+			for (size_t i = 0; i < words.size(); i++)
+				words[i] = LoadLE32(&bytes[i * sizeof(uint32_t)]);
+			libmpq__decrypt_block(words.data(), static_cast<uint32_t>(words.size() * sizeof(uint32_t)), LIBMPQ_HASH_TABLE_HASH_KEY);
+			entries.resize(count);
+			for (size_t i = 0; i < count; i++) {
+				const uint32_t *word = &words[i * 4];
+				entries[i] = MpqHashEntry {
+					.hashA = word[0],
+					.hashB = word[1],
+					.locale = static_cast<uint16_t>(word[2] & 0xFFFF),
+					.platform = static_cast<uint16_t>(word[2] >> 16),
+					.block = word[3],
+				};
+			}
+		}
+	}
+	if (file != nullptr)
+		std::fclose(file);
+	return ok;
+}
+
 } // namespace devilution
@@ -4,12 +4,14 @@
 #include <cstdint>
 #include <memory>
 #include <optional>
+#include <span>
 #include <string>
 #include <string_view>
 #include <utility>
 #include <vector>
 
 #include "mpq/mpq_common.hpp"
+#include "utils/mapped_file.hpp"
 
 // Forward-declare so that we can avoid exposing libmpq.
 struct mpq_archive;
@@ -29,6 +31,8 @@ public:
 	MpqArchive(MpqArchive &&other) noexcept
 	    : path_(std::move(other.path_))
 	    , archive_(other.archive_)
+	    , mapping_(std::move(other.mapping_))
+	    , fingerprint_(other.fingerprint_)
 	    , tmp_buf_(std::move(other.tmp_buf_))
 	{
 		other.archive_ = nullptr;
@@ -43,6 +47,35 @@ public:
 
 	std::unique_ptr<std::byte[]> ReadFile(std::string_view filename, std::size_t &fileSize, int32_t &error);
 
+	/**
+	 * @brief Reads a whole file into `out`, decompressing it there directly.
+	 * @param out Buffer of GetUnpackedFileSize() bytes
+	 * @return Error code
+	 */
+	int32_t ReadFile(uint32_t fileNumber, std::string_view filename, std::byte *out, std::size_t outSize);
+
+	/**
+	 * @brief The file's bytes in the memory mapped archive if it is stored as is, empty otherwise.
+	 *
+	 * The view stays valid for as long as the archive or one of its clones is open.
+	 */
+	std::span<const std::byte> GetStoredFileView(uint32_t fileNumber);
+
+	/**
+	 * @brief A hash of the archive's file tables, which changes whenever any file in it does.
+	 *
+	 * 0 if the archive isn't memory mapped.
+	 */
+	[[nodiscard]] uint64_t Fingerprint() const
+	{
+		return fingerprint_;
+	}
+
+	[[nodiscard]] const std::string &path() const
+	{
+		return path_;
+	}
+
 	// Returns error code.
 	int32_t ReadBlock(uint32_t fileNumber, uint32_t blockNumber, uint8_t *out, size_t outSize);
 
@@ -59,10 +92,22 @@ public:
 
 	bool HasFile(std::string_view filename) const;
 
+	/**
+	 * @brief Reads the archive's decrypted hash table, for indexing it together with other archives.
+	 *
+	 * The `block` of a hash entry is its index in the block table. That is not the file number
+	 * when the block table has unused entries, GetFileNumber() with the entry's index as the first
+	 * hash gives the file number.
+	 * @return false if the table couldn't be read or doesn't fit in the archive
+	 */
+	bool ReadHashTable(std::vector<MpqHashEntry> &entries) const;
+
 private:
-	MpqArchive(std::string path, mpq_archive_s *archive)
+	MpqArchive(std::string path, mpq_archive_s *archive, std::shared_ptr<const MappedFile> mapping, uint64_t fingerprint)
 	    : path_(std::move(path))
 	    , archive_(archive)
+	    , mapping_(std::move(mapping))
+	    , fingerprint_(fingerprint)
 	{
 	}
 
@@ -75,6 +120,9 @@ private:
 
 	std::string path_;
 	mpq_archive_s *archive_;
+	/** The whole archive mapped into memory, null where the platform can't map files. Shared with clones. */
+	std::shared_ptr<const MappedFile> mapping_;
+	uint64_t fingerprint_;
 	std::vector<std::uint8_t> tmp_buf_;
 };
 
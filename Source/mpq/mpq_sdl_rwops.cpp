@@ -14,10 +14,21 @@
 #include "utils/sdl_compat.h"
 #endif
 
+#include "mpq/block_read_ahead.hpp"
+
 namespace devilution {
 
 namespace {
 
+#ifndef __DJGPP__
+#define DEVILUTIONX_MPQ_READ_AHEAD
+#endif
+
+#ifdef DEVILUTIONX_MPQ_READ_AHEAD
+/** Files at least this large, such as music and videos, are decompressed ahead of the reads. */
+constexpr size_t ReadAheadMinFileSize = 256 * 1024;
+#endif
+
 struct Data {
 	// File information:
 	std::optional<MpqArchive> ownedArchive;
@@ -32,6 +43,11 @@ struct Data {
 	size_t position;
 	bool blockRead;
 	std::unique_ptr<uint8_t[]> blockData;
+
+#ifdef DEVILUTIONX_MPQ_READ_AHEAD
+	// Set for large files, owns `mpqArchive` while it exists.
+	std::unique_ptr<BlockReadAhead> readAhead;
+#endif
 };
 
 #ifdef USE_SDL3
@@ -145,7 +161,13 @@ static SizeType MpqFileRwRead(struct SDL_RWops *context, void *ptr, SizeType siz
 		const size_t currentBlockSize = blockNumber + 1 == data.numBlocks ? data.lastBlockSize : data.blockSize;
 
 		if (!data.blockRead) {
+#ifdef DEVILUTIONX_MPQ_READ_AHEAD
+			const int32_t error = data.readAhead != nullptr
+			    ? data.readAhead->ReadBlock(blockNumber, data.blockData.get(), currentBlockSize)
+			    : data.mpqArchive->ReadBlock(data.fileNumber, blockNumber, data.blockData.get(), currentBlockSize);
+#else
 			const int32_t error = data.mpqArchive->ReadBlock(data.fileNumber, blockNumber, data.blockData.get(), currentBlockSize);
+#endif
 			if (error != 0) {
 				SDL_SetError("MpqFileRwRead ReadBlock: %s", MpqArchive::ErrorMessage(error));
 				return 0;
@@ -188,6 +210,9 @@ static int MpqFileRwClose(struct SDL_RWops *context)
 #endif
 {
 	Data *data = GetData(context);
+#ifdef DEVILUTIONX_MPQ_READ_AHEAD
+	data->readAhead = nullptr;
+#endif
 	data->mpqArchive->CloseBlockOffsetTable(data->fileNumber);
 	delete data;
 #ifdef USE_SDL3
@@ -233,7 +258,19 @@ SDL_IOStream *SDL_RWops_FromMpqFile(MpqArchive &mpqArchive, uint32_t fileNumber,
 	auto data = std::make_unique<Data>();
 	int32_t error = 0;
 
+	data->size = mpqArchive.GetUnpackedFileSize(fileNumber, error);
+	if (error != 0) {
+		SDL_SetError("MpqFileRwRead GetUnpackedFileSize: %s", MpqArchive::ErrorMessage(error));
+		return nullptr;
+	}
+
+#ifdef DEVILUTIONX_MPQ_READ_AHEAD
+	// The read-ahead thread needs an archive of its own.
+	const bool readAhead = data->size >= ReadAheadMinFileSize;
+	if (threadsafe || readAhead) {
+#else
 	if (threadsafe) {
+#endif
 		data->ownedArchive = mpqArchive.Clone(error);
 		if (error != 0) {
 			SDL_SetError("MpqFileRwRead Clone: %s", MpqArchive::ErrorMessage(error));
@@ -252,12 +289,6 @@ SDL_IOStream *SDL_RWops_FromMpqFile(MpqArchive &mpqArchive, uint32_t fileNumber,
 		return nullptr;
 	}
 
-	data->size = archive.GetUnpackedFileSize(fileNumber, error);
-	if (error != 0) {
-		SDL_SetError("MpqFileRwRead GetUnpackedFileSize: %s", MpqArchive::ErrorMessage(error));
-		return nullptr;
-	}
-
 	const std::uint32_t numBlocks = archive.GetNumBlocks(fileNumber, error);
 	if (error != 0) {
 		SDL_SetError("MpqFileRwRead GetNumBlocks: %s", MpqArchive::ErrorMessage(error));
@@ -285,6 +316,13 @@ SDL_IOStream *SDL_RWops_FromMpqFile(MpqArchive &mpqArchive, uint32_t fileNumber,
 	data->position = 0;
 	data->blockRead = false;
 
+#ifdef DEVILUTIONX_MPQ_READ_AHEAD
+	if (readAhead && numBlocks > 1)
+		data->readAhead = std::make_unique<BlockReadAhead>(
+		    [&archive, fileNumber](uint32_t block, uint8_t *out, size_t size) { return archive.ReadBlock(fileNumber, block, out, size); },
+		    numBlocks, blockSize, data->lastBlockSize);
+#endif
+
 #ifdef USE_SDL3
 	return SDL_OpenIO(&interface, data.release());
 #else
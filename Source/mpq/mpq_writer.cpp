@@ -1,10 +1,13 @@
 #include "mpq/mpq_writer.hpp"
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
 #include <memory>
 #include <type_traits>
+#include <utility>
+#include <vector>
 
 #include <libmpq/mpq.h>
 
@@ -84,6 +87,41 @@ bool IsUnallocatedBlock(const MpqBlockEntry *block)
 	return block->offset == 0 && block->packedSize == 0 && block->unpackedSize == 0 && block->flags == 0;
 }
 
+/**
+ * @brief Compresses a file for the archive: the table of sector offsets followed by the sectors.
+ */
+std::vector<std::byte> CompressFile(const std::byte *fileData, uint32_t fileSize)
+{
+	const uint32_t numSectors = (fileSize + (BlockSize - 1)) / BlockSize;
+	const uint32_t offsetTableByteSize = sizeof(uint32_t) * (numSectors + 1);
+
+	// First offset is the start of the first sector, last offset is the end of the last sector.
+	// Compressed sectors are never larger than the plain ones, so the buffer is only shrunk at the end.
+	std::vector<std::byte> packed(offsetTableByteSize + fileSize);
+	uint32_t destSize = offsetTableByteSize;
+	std::byte mpqBuf[BlockSize];
+	size_t curSector = 0;
+	while (true) {
+		uint32_t len = std::min<uint32_t>(fileSize, BlockSize);
+		memcpy(mpqBuf, fileData, len);
+		fileData += len;
+		len = PkwareCompress(mpqBuf, len);
+		const uint32_t offset = Swap32LE(destSize);
+		memcpy(packed.data() + sizeof(uint32_t) * curSector++, &offset, sizeof(offset));
+		memcpy(packed.data() + destSize, mpqBuf, len);
+		destSize += len; // compressed length
+		if (fileSize <= BlockSize)
+			break;
+
+		fileSize -= BlockSize;
+	}
+
+	const uint32_t end = Swap32LE(destSize);
+	memcpy(packed.data() + sizeof(uint32_t) * numSectors, &end, sizeof(end));
+	packed.resize(destSize);
+	return packed;
+}
+
 } // namespace
 
 MpqWriter::MpqWriter(const char *path)
@@ -181,7 +219,11 @@ MpqWriter::~MpqWriter()
 	LogVerbose("Closing {}", name_);
 
 	bool result = true;
-	if (!(stream_.Seekp(0, SEEK_SET) && WriteHeaderAndTables()))
+	if (batching_)
+		result = CommitFiles();
+	if (commitFailed_)
+		result = false;
+	else if (tablesDirty_ && !(stream_.Seekp(0, SEEK_SET) && WriteHeaderAndTables()))
 		result = false;
 	stream_.Close();
 	if (result && size_ != 0) {
@@ -373,79 +415,54 @@ MpqBlockEntry *MpqWriter::AddFile(std::string_view filename, MpqBlockEntry *bloc
 	return block;
 }
 
-bool MpqWriter::WriteFileContents(const std::byte *fileData, uint32_t fileSize, MpqBlockEntry *block)
+bool MpqWriter::WriteFileContents(const std::byte *fileData, uint32_t fileSize, MpqBlockEntry *block, uint32_t blockIndex)
 {
-	const uint32_t numSectors = (fileSize + (BlockSize - 1)) / BlockSize;
-	const uint32_t offsetTableByteSize = sizeof(uint32_t) * (numSectors + 1);
-	block->offset = FindFreeBlock(fileSize + offsetTableByteSize);
-	// `packedSize` is reduced at the end of the function if it turns out to be smaller.
-	block->packedSize = fileSize + offsetTableByteSize;
+	std::vector<std::byte> packed = CompressFile(fileData, fileSize);
+	block->packedSize = static_cast<uint32_t>(packed.size());
 	block->unpackedSize = fileSize;
 	block->flags = MpqBlockEntry::FlagExists | MpqBlockEntry::CompressPkZip;
+	tablesDirty_ = true;
 
-	// We populate the table of sector offsets while we write the data.
-	// We can't pre-populate it because we don't know the compressed sector sizes yet.
-	// First offset is the start of the first sector, last offset is the end of the last sector.
-	const std::unique_ptr<uint32_t[]> offsetTable { new uint32_t[numSectors + 1] };
+	if (batching_) {
+		// The offset is assigned once the whole batch is laid out.
+		pending_.push_back({ blockIndex, std::move(packed) });
+		return true;
+	}
 
+	block->offset = FindFreeBlock(block->packedSize);
+	return SeekToWrite(block->offset) && stream_.Write(reinterpret_cast<const char *>(packed.data()), packed.size());
+}
+
+bool MpqWriter::SeekToWrite(uint32_t offset)
+{
 #ifdef CAN_SEEKP_BEYOND_EOF
-	if (!stream_.Seekp(block->offset + offsetTableByteSize, SEEK_SET))
-		return false;
+	return stream_.Seekp(offset, SEEK_SET);
 #else
 	// Ensure we do not Seekp beyond EOF by filling the missing space.
-	long stream_end;
-	if (!stream_.Seekp(0, SEEK_END) || !stream_.Tellp(&stream_end))
+	long streamEnd;
+	if (!stream_.Seekp(0, SEEK_END) || !stream_.Tellp(&streamEnd))
 		return false;
-	const std::uintmax_t cur_size = stream_end - streamBegin_;
-	if (cur_size < block->offset + offsetTableByteSize) {
-		if (cur_size < block->offset) {
-			std::unique_ptr<char[]> filler { new char[block->offset - cur_size] };
-			if (!stream_.Write(filler.get(), block->offset - cur_size))
-				return false;
-		}
-		if (!stream_.Write(reinterpret_cast<const char *>(offsetTable.get()), offsetTableByteSize))
-			return false;
-	} else {
-		if (!stream_.Seekp(block->offset + offsetTableByteSize, SEEK_SET))
-			return false;
-	}
+	const std::uintmax_t curSize = streamEnd - streamBegin_;
+	if (curSize >= offset)
+		return stream_.Seekp(offset, SEEK_SET);
+	const std::unique_ptr<char[]> filler { new char[offset - curSize] {} };
+	return stream_.Write(filler.get(), offset - curSize);
 #endif
+}
 
-	uint32_t destSize = offsetTableByteSize;
-	std::byte mpqBuf[BlockSize];
-	size_t curSector = 0;
-	while (true) {
-		uint32_t len = std::min<uint32_t>(fileSize, BlockSize);
-		memcpy(mpqBuf, fileData, len);
-		fileData += len;
-		len = PkwareCompress(mpqBuf, len);
-		if (!stream_.Write(reinterpret_cast<const char *>(&mpqBuf[0]), len))
-			return false;
-		offsetTable[curSector++] = Swap32LE(destSize);
-		destSize += len; // compressed length
-		if (fileSize <= BlockSize)
-			break;
-
-		fileSize -= BlockSize;
-	}
-
-	offsetTable[numSectors] = Swap32LE(destSize);
-	if (!stream_.Seekp(block->offset, SEEK_SET))
-		return false;
-	if (!stream_.Write(reinterpret_cast<const char *>(offsetTable.get()), offsetTableByteSize))
-		return false;
-	if (!stream_.Seekp(destSize - offsetTableByteSize, SEEK_CUR))
-		return false;
-
-	if (destSize < block->packedSize) {
-		const uint32_t remainingBlockSize = block->packedSize - destSize;
-		if (remainingBlockSize >= MinBlockSize) {
-			// Allocate another block if we didn't use all of this one.
-			block->packedSize = destSize;
-			AllocBlock(block->packedSize + block->offset, remainingBlockSize);
-		}
+void MpqWriter::DropBlock(uint32_t blockIndex)
+{
+	for (unsigned i = 0; i < HashEntriesCount; ++i) {
+		if (hashTable_[i].block == blockIndex)
+			hashTable_[i].block = MpqHashEntry::DeletedBlock;
 	}
-	return true;
+	MpqBlockEntry *block = &blockTable_[blockIndex];
+	const uint32_t blockOffset = block->offset;
+	const uint32_t blockSize = block->packedSize;
+	memset(block, 0, sizeof(*block));
+	if (blockOffset != 0)
+		AllocBlock(blockOffset, blockSize);
+	tablesDirty_ = true;
 }
 
 bool MpqWriter::WriteHeader()
@@ -491,8 +508,17 @@ void MpqWriter::RemoveHashEntry(std::string_view filename)
 	}
 
 	MpqHashEntry *hashEntry = &hashTable_[hIdx];
-	MpqBlockEntry *block = &blockTable_[hashEntry->block];
+	const uint32_t blockIndex = hashEntry->block;
+	MpqBlockEntry *block = &blockTable_[blockIndex];
 	hashEntry->block = MpqHashEntry::DeletedBlock;
+	tablesDirty_ = true;
+	const auto pending = std::find_if(pending_.begin(), pending_.end(), [blockIndex](const PendingFile &file) { return file.blockIndex == blockIndex; });
+	if (pending != pending_.end()) {
+		// Written earlier in the batch, so it has no space in the archive yet.
+		pending_.erase(pending);
+		memset(block, 0, sizeof(*block));
+		return;
+	}
 	const uint32_t blockOffset = block->offset;
 	const uint32_t blockSize = block->packedSize;
 	memset(block, 0, sizeof(*block));
@@ -513,8 +539,10 @@ bool MpqWriter::WriteFile(std::string_view filename, const std::byte *data, size
 	MpqBlockEntry *blockEntry;
 
 	RemoveHashEntry(filename);
-	blockEntry = AddFile(filename, nullptr, 0);
-	if (!WriteFileContents(data, static_cast<uint32_t>(size), blockEntry)) {
+	uint32_t blockIndex;
+	blockEntry = NewBlock(&blockIndex);
+	AddFile(filename, blockEntry, blockIndex);
+	if (!WriteFileContents(data, static_cast<uint32_t>(size), blockEntry, blockIndex)) {
 		RemoveHashEntry(filename);
 		return false;
 	}
@@ -533,6 +561,45 @@ void MpqWriter::RenameFile(std::string_view name, std::string_view newName) // N
 	MpqBlockEntry *blockEntry = &blockTable_[block];
 	hashEntry->block = MpqHashEntry::DeletedBlock;
 	AddFile(newName, blockEntry, block);
+	tablesDirty_ = true;
+}
+
+void MpqWriter::BeginFiles()
+{
+	batching_ = true;
+}
+
+bool MpqWriter::CommitFiles()
+{
+	batching_ = false;
+	size_t totalSize = 0;
+	for (const PendingFile &file : pending_)
+		totalSize += file.data.size();
+
+	bool ok = true;
+	if (totalSize != 0) {
+		uint32_t offset = FindFreeBlock(static_cast<uint32_t>(totalSize));
+		ok = SeekToWrite(offset);
+		for (const PendingFile &file : pending_) {
+			blockTable_[file.blockIndex].offset = offset;
+			offset += static_cast<uint32_t>(file.data.size());
+			ok = ok && stream_.Write(reinterpret_cast<const char *>(file.data.data()), file.data.size());
+		}
+		if (!ok) {
+			for (const PendingFile &file : pending_)
+				DropBlock(file.blockIndex);
+		}
+	}
+	pending_.clear();
+
+	if (ok && stream_.Seekp(0, SEEK_SET) && WriteHeaderAndTables() && stream_.Sync()) {
+		tablesDirty_ = false;
+		return true;
+	}
+	// Leave the archive as it is, the caller discards it.
+	commitFailed_ = true;
+	tablesDirty_ = false;
+	return false;
 }
 
 bool MpqWriter::HasFile(std::string_view name) const
@@ -8,6 +8,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <string_view>
+#include <vector>
 
 #include "mpq/mpq_common.hpp"
 #include "utils/logged_fstream.hpp"
@@ -31,14 +32,38 @@ public:
 	bool WriteFile(std::string_view filename, const std::byte *data, size_t size);
 	void RenameFile(std::string_view name, std::string_view newName);
 
+	/**
+	 * @brief Starts a batch of changes, in which WriteFile() only compresses the files to memory.
+	 */
+	void BeginFiles();
+
+	/**
+	 * @brief Writes the files of the batch back to back, then the header and tables, and flushes the archive to storage.
+	 * @return false if writing failed, the files of the batch are then left out of the archive,
+	 *         and the header and tables are no longer written, not even when the archive is closed
+	 */
+	bool CommitFiles();
+
 private:
+	/** A file compressed during a batch, waiting for CommitFiles(). */
+	struct PendingFile {
+		uint32_t blockIndex;
+		std::vector<std::byte> data;
+	};
+
 	bool IsValidMpqHeader(MpqFileHeader *hdr) const;
 	uint32_t GetHashIndex(MpqFileHash fileHash) const;
 	uint32_t FetchHandle(std::string_view filename) const;
 
 	bool ReadMPQHeader(MpqFileHeader *hdr);
 	MpqBlockEntry *AddFile(std::string_view filename, MpqBlockEntry *block, uint32_t blockIndex);
-	bool WriteFileContents(const std::byte *fileData, uint32_t fileSize, MpqBlockEntry *block);
+	bool WriteFileContents(const std::byte *fileData, uint32_t fileSize, MpqBlockEntry *block, uint32_t blockIndex);
+
+	// Seeks to `offset` for writing, growing the file first where it cannot seek beyond its end.
+	bool SeekToWrite(uint32_t offset);
+
+	// Removes a block and the hash entries pointing to it, and marks its space as free.
+	void DropBlock(uint32_t blockIndex);
 
 	// Returns an unused entry in the block entry table.
 	MpqBlockEntry *NewBlock(uint32_t *blockIndex = nullptr);
@@ -60,6 +85,12 @@ private:
 	uint32_t size_ {};
 	std::unique_ptr<MpqHashEntry[]> hashTable_;
 	std::unique_ptr<MpqBlockEntry[]> blockTable_;
+	std::vector<PendingFile> pending_;
+	bool batching_ = false;
+	// Whether the header and tables on disk are out of date.
+	bool tablesDirty_ = true;
+	// Whether a batch failed to commit. The tables in memory may then point at data that isn't on disk.
+	bool commitFailed_ = false;
 
 // Amiga cannot Seekp beyond EOF.
 // See https://github.com/bebbo/libnix/issues/30
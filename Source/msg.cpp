@@ -10,6 +10,7 @@
 #include <cstdint>
 #include <list>
 #include <memory>
+#include <vector>
 
 #ifdef USE_SDL3
 #include <SDL3/SDL_timer.h>
@@ -106,9 +107,6 @@ void LogFailedPacket(const char *condition, const char *name1, T1 value1, const
 uint8_t gbBufferMsgs;
 int dwRecCount;
 
-namespace {
-
-#ifdef LOG_RECEIVED_MESSAGES
 std::string_view CmdIdString(_cmd_id cmd)
 {
 	// clang-format off
@@ -124,7 +122,6 @@ std::string_view CmdIdString(_cmd_id cmd)
 	case CMD_AGETITEM: return "CMD_AGETITEM";
 	case CMD_PUTITEM: return "CMD_PUTITEM";
 	case CMD_SPAWNITEM: return "CMD_SPAWNITEM";
-	case CMD_ATTACKXY: return "CMD_ATTACKXY";
 	case CMD_RATTACKXY: return "CMD_RATTACKXY";
 	case CMD_SPELLXY: return "CMD_SPELLXY";
 	case CMD_OPOBJXY: return "CMD_OPOBJXY";
@@ -148,6 +145,7 @@ std::string_view CmdIdString(_cmd_id cmd)
 	case CMD_MONSTDEATH: return "CMD_MONSTDEATH";
 	case CMD_MONSTDAMAGE: return "CMD_MONSTDAMAGE";
 	case CMD_PLRDEAD: return "CMD_PLRDEAD";
+	case CMD_PLRALIVE: return "CMD_PLRALIVE";
 	case CMD_REQUESTGITEM: return "CMD_REQUESTGITEM";
 	case CMD_REQUESTAGITEM: return "CMD_REQUESTAGITEM";
 	case CMD_GOTOGETITEM: return "CMD_GOTOGETITEM";
@@ -200,7 +198,8 @@ std::string_view CmdIdString(_cmd_id cmd)
 	}
 	// clang-format on
 }
-#endif // LOG_RECEIVED_MESSAGES
+
+namespace {
 
 struct TMegaPkt {
 	size_t spaceLeft;
@@ -233,11 +232,19 @@ struct DSpawnedMonster {
 	int16_t golemSpellLevel;
 };
 
+/**
+ * @brief The changes to a level, only the touched items and monsters are kept.
+ *
+ * On the network the items and monsters are still sent as MAXITEMS and MaxMonsters slots,
+ * with a single 0xFF for each unused one.
+ */
 struct DLevel {
-	TCmdPItem item[MAXITEMS];
+	/** Items spawned during dungeon generation which have been picked up, and items dropped by a player, at most MAXITEMS. */
+	std::vector<TCmdPItem> item;
 	ankerl::unordered_dense::map<WorldTilePosition, DObjectStr> object;
 	ankerl::unordered_dense::map<size_t, DSpawnedMonster> spawnedMonsters;
-	DMonsterStr monster[MaxMonsters];
+	/** Latest state of the monsters that changed, by monster id. */
+	ankerl::unordered_dense::map<size_t, DMonsterStr> monster;
 };
 
 #pragma pack(push, 1)
@@ -285,10 +292,10 @@ uint8_t sbLastCmd;
  */
 std::byte sgRecvBuf[1U                                             /* marker byte, always 0 */
     + sizeof(uint8_t)                                              /* level id */
-    + sizeof(DLevel::item)                                         /* items spawned during dungeon generation which have been picked up, and items dropped by a player during a game */
+    + sizeof(TCmdPItem) * MAXITEMS                                 /* items spawned during dungeon generation which have been picked up, and items dropped by a player during a game */
     + sizeof(uint8_t)                                              /* count of object interactions which caused a state change since dungeon generation */
     + (sizeof(WorldTilePosition) + sizeof(_cmd_id)) * MAXOBJECTS   /* location/action pairs for the object interactions */
-    + sizeof(DLevel::monster)                                      /* latest monster state */
+    + sizeof(DMonsterStr) * MaxMonsters                            /* latest monster state */
     + sizeof(uint16_t)                                             /* spawned monster count */
     + (sizeof(uint16_t) + sizeof(DSpawnedMonster)) * MaxMonsters]; /* spawned monsters */
 
@@ -330,13 +337,7 @@ uint8_t GetLevelForMultiplayer(uint8_t level, bool isSetLevel)
 /** @brief Gets a delta level. */
 DLevel &GetDeltaLevel(uint8_t level)
 {
-	auto keyIt = DeltaLevels.find(level);
-	if (keyIt != DeltaLevels.end())
-		return keyIt->second;
-	DLevel &deltaLevel = DeltaLevels[level];
-	memset(&deltaLevel.item, 0xFF, sizeof(deltaLevel.item));
-	memset(&deltaLevel.monster, 0xFF, sizeof(deltaLevel.monster));
-	return deltaLevel;
+	return DeltaLevels[level];
 }
 
 /** @brief Gets a delta level. */
@@ -346,6 +347,43 @@ DLevel &GetDeltaLevel(const Player &player)
 	return GetDeltaLevel(level);
 }
 
+[[nodiscard]] bool IsDeltaLevelEmpty(const DLevel &deltaLevel)
+{
+	return deltaLevel.item.empty() && deltaLevel.object.empty() && deltaLevel.spawnedMonsters.empty() && deltaLevel.monster.empty();
+}
+
+/** @brief Finds the delta of a monster, nullptr if it didn't change. */
+DMonsterStr *FindMonsterDelta(DLevel &deltaLevel, size_t monsterId)
+{
+	const auto it = deltaLevel.monster.find(monsterId);
+	return it != deltaLevel.monster.end() ? &it->second : nullptr;
+}
+
+const DMonsterStr *FindMonsterDelta(const DLevel &deltaLevel, size_t monsterId)
+{
+	const auto it = deltaLevel.monster.find(monsterId);
+	return it != deltaLevel.monster.end() ? &it->second : nullptr;
+}
+
+/** @brief Gets the delta of a monster, adding an unset one if it didn't change before. */
+DMonsterStr &GetMonsterDelta(DLevel &deltaLevel, size_t monsterId)
+{
+	const auto [it, inserted] = deltaLevel.monster.try_emplace(monsterId);
+	if (inserted)
+		memset(&it->second, 0xFF, sizeof(it->second));
+	return it->second;
+}
+
+/** @brief Adds an unset item delta, nullptr if the level already has MAXITEMS of them. */
+TCmdPItem *AddItemDelta(DLevel &deltaLevel)
+{
+	if (deltaLevel.item.size() >= MAXITEMS)
+		return nullptr;
+	TCmdPItem &item = deltaLevel.item.emplace_back();
+	memset(&item, 0xFF, sizeof(item));
+	return &item;
+}
+
 Point GetItemPosition(Point position)
 {
 	if (CanPut(position))
@@ -529,35 +567,35 @@ int WaitForTurns()
 	return 100 * sgbDeltaChunks / static_cast<int>(MaxChunks);
 }
 
-std::byte *DeltaExportItem(std::byte *dst, const TCmdPItem *src)
+std::byte *DeltaExportItem(std::byte *dst, const std::vector<TCmdPItem> &src)
 {
-	for (int i = 0; i < MAXITEMS; i++, src++) {
-		if (src->bCmd == CMD_INVALID) {
-			*dst++ = std::byte { 0xFF };
-		} else {
-			memcpy(dst, src, sizeof(TCmdPItem));
-			dst += sizeof(TCmdPItem);
-		}
+	for (const TCmdPItem &item : src) {
+		memcpy(dst, &item, sizeof(TCmdPItem));
+		dst += sizeof(TCmdPItem);
 	}
+	for (size_t i = src.size(); i < MAXITEMS; i++)
+		*dst++ = std::byte { 0xFF };
 
 	return dst;
 }
 
-const std::byte *DeltaImportItem(const std::byte *src, const std::byte *end, TCmdPItem *dst)
+const std::byte *DeltaImportItem(const std::byte *src, const std::byte *end, std::vector<TCmdPItem> &dst)
 {
+	dst.clear();
+
 	size_t size = 0;
-	for (int i = 0; i < MAXITEMS; i++, dst++) {
+	for (int i = 0; i < MAXITEMS; i++) {
 		if (&src[size] >= end)
 			return nullptr;
 		if (src[size] == std::byte { 0xFF }) {
-			memset(dst, 0xFF, sizeof(TCmdPItem));
 			size++;
 		} else {
 			if (&src[size] + sizeof(TCmdPItem) > end)
 				return nullptr;
-			memcpy(dst, &src[size], sizeof(TCmdPItem));
-			if (!IsItemDeltaValid(*dst))
-				memset(dst, 0xFF, sizeof(TCmdPItem));
+			TCmdPItem item;
+			memcpy(&item, &src[size], sizeof(TCmdPItem));
+			if (IsItemDeltaValid(item))
+				dst.push_back(item);
 			size += sizeof(TCmdPItem);
 		}
 	}
@@ -603,13 +641,14 @@ const std::byte *DeltaImportObjects(const std::byte *src, const std::byte *end,
 	return src;
 }
 
-std::byte *DeltaExportMonster(std::byte *dst, const DMonsterStr *src)
+std::byte *DeltaExportMonster(std::byte *dst, const DLevel &deltaLevel)
 {
-	for (size_t i = 0; i < MaxMonsters; i++, src++) {
-		if (src->position.x == 0xFF) {
+	for (size_t i = 0; i < MaxMonsters; i++) {
+		const DMonsterStr *monster = FindMonsterDelta(deltaLevel, i);
+		if (monster == nullptr || monster->position.x == 0xFF) {
 			*dst++ = std::byte { 0xFF };
 		} else {
-			memcpy(dst, src, sizeof(DMonsterStr));
+			memcpy(dst, monster, sizeof(DMonsterStr));
 			dst += sizeof(DMonsterStr);
 		}
 	}
@@ -617,22 +656,23 @@ std::byte *DeltaExportMonster(std::byte *dst, const DMonsterStr *src)
 	return dst;
 }
 
-const std::byte *DeltaImportMonster(const std::byte *src, const std::byte *end, DMonsterStr *dst)
+const std::byte *DeltaImportMonster(const std::byte *src, const std::byte *end, ankerl::unordered_dense::map<size_t, DMonsterStr> &dst)
 {
+	dst.clear();
+
 	if (src == nullptr)
 		return nullptr;
 
 	size_t size = 0;
-	for (size_t i = 0; i < MaxMonsters; i++, dst++) {
+	for (size_t i = 0; i < MaxMonsters; i++) {
 		if (&src[size] >= end)
 			return nullptr;
 		if (src[size] == std::byte { 0xFF }) {
-			memset(dst, 0xFF, sizeof(DMonsterStr));
 			size++;
 		} else {
 			if (&src[size] + sizeof(DMonsterStr) > end)
 				return nullptr;
-			memcpy(dst, &src[size], sizeof(DMonsterStr));
+			memcpy(&dst[i], &src[size], sizeof(DMonsterStr));
 			size += sizeof(DMonsterStr);
 		}
 	}
@@ -817,16 +857,17 @@ void DeltaLoadSpawnedMonsters(const DLevel &deltaLevel)
 	for (const auto &deltaSpawnedMonster : deltaLevel.spawnedMonsters) {
 		const auto &monsterData = deltaSpawnedMonster.second;
 		LoadDeltaSpawnedMonster(deltaSpawnedMonster.second.typeIndex, deltaSpawnedMonster.first, monsterData.seed, monsterData.golemOwnerPlayerId, monsterData.golemSpellLevel);
-		assert(deltaLevel.monster[deltaSpawnedMonster.first].position.x != 0xFF);
+		assert(FindMonsterDelta(deltaLevel, deltaSpawnedMonster.first) != nullptr && FindMonsterDelta(deltaLevel, deltaSpawnedMonster.first)->position.x != 0xFF);
 	}
 }
 
 void DeltaLoadEnemies(const DLevel &deltaLevel)
 {
 	for (size_t i = 0; i < MaxMonsters; i++) {
-		const DMonsterStr &deltaMonster = deltaLevel.monster[i];
-		if (!IsMonsterDeltaValid(deltaMonster))
+		const DMonsterStr *delta = FindMonsterDelta(deltaLevel, i);
+		if (delta == nullptr || !IsMonsterDeltaValid(*delta))
 			continue;
+		const DMonsterStr &deltaMonster = *delta;
 		if (deltaMonster.hitPoints == 0)
 			continue;
 		Monster &monster = Monsters[i];
@@ -847,9 +888,10 @@ void DeltaLoadEnemies(const DLevel &deltaLevel)
 void DeltaLoadMonsters(const DLevel &deltaLevel)
 {
 	for (size_t i = 0; i < MaxMonsters; i++) {
-		const DMonsterStr &deltaMonster = deltaLevel.monster[i];
-		if (!IsMonsterDeltaValid(deltaMonster))
+		const DMonsterStr *delta = FindMonsterDelta(deltaLevel, i);
+		if (delta == nullptr || !IsMonsterDeltaValid(*delta))
 			continue;
+		const DMonsterStr &deltaMonster = *delta;
 
 		Monster &monster = Monsters[i];
 		M_ClearSquares(monster);
@@ -924,9 +966,6 @@ void DeltaLoadObjects(DLevel &deltaLevel)
 void DeltaLoadItems(const DLevel &deltaLevel)
 {
 	for (const TCmdPItem &deltaItem : deltaLevel.item) {
-		if (deltaItem.bCmd == CMD_INVALID)
-			continue;
-
 		if (deltaItem.bCmd == TCmdPItem::PickedUpItem) {
 			const int activeItemIndex = FindGetItem(
 			    Swap32LE(deltaItem.def.dwSeed),
@@ -1020,7 +1059,7 @@ void DeltaLeaveSync(uint8_t bLevel)
 		Monster &monster = Monsters[ma];
 		if (monster.hitPoints == 0)
 			continue;
-		DMonsterStr &delta = deltaLevel.monster[ma];
+		DMonsterStr &delta = GetMonsterDelta(deltaLevel, ma);
 		delta.position = monster.position.tile;
 		delta.menemy = encode_enemy(monster);
 		delta.hitPoints = monster.hitPoints;
@@ -1046,9 +1085,9 @@ bool DeltaGetItem(const TCmdGItem &message, uint8_t bLevel)
 
 	DLevel &deltaLevel = GetDeltaLevel(bLevel);
 
-	for (TCmdPItem &item : deltaLevel.item) {
-		if (item.bCmd == CMD_INVALID || item.def.wIndx != message.def.wIndx
-		    || item.def.wCI != message.def.wCI || item.def.dwSeed != message.def.dwSeed) {
+	for (auto it = deltaLevel.item.begin(); it != deltaLevel.item.end(); ++it) {
+		TCmdPItem &item = *it;
+		if (item.def.wIndx != message.def.wIndx || item.def.wCI != message.def.wCI || item.def.dwSeed != message.def.dwSeed) {
 			continue;
 		}
 
@@ -1060,7 +1099,7 @@ bool DeltaGetItem(const TCmdGItem &message, uint8_t bLevel)
 			return true;
 		}
 		if (item.bCmd == TCmdPItem::DroppedItem) {
-			item.bCmd = CMD_INVALID;
+			deltaLevel.item.erase(it);
 			return true;
 		}
 
@@ -1072,28 +1111,26 @@ bool DeltaGetItem(const TCmdGItem &message, uint8_t bLevel)
 	if ((message.def.wCI & CF_PREGEN) == 0)
 		return false;
 
-	for (TCmdPItem &delta : deltaLevel.item) {
-		if (delta.bCmd == CMD_INVALID) {
-			delta.bCmd = TCmdPItem::PickedUpItem;
-			delta.x = message.x;
-			delta.y = message.y;
-			delta.def.wIndx = message.def.wIndx;
-			delta.def.wCI = message.def.wCI;
-			delta.def.dwSeed = message.def.dwSeed;
-			if (message.def.wIndx == IDI_EAR) {
-				delta.ear.bCursval = message.ear.bCursval;
-				CopyUtf8(delta.ear.heroname, message.ear.heroname, sizeof(delta.ear.heroname));
-			} else {
-				delta.item.bId = message.item.bId;
-				delta.item.bDur = message.item.bDur;
-				delta.item.bMDur = message.item.bMDur;
-				delta.item.bCh = message.item.bCh;
-				delta.item.bMCh = message.item.bMCh;
-				delta.item.wValue = message.item.wValue;
-				delta.item.dwBuff = message.item.dwBuff;
-				delta.item.wToHit = message.item.wToHit;
-			}
-			break;
+	if (TCmdPItem *added = AddItemDelta(deltaLevel); added != nullptr) {
+		TCmdPItem &delta = *added;
+		delta.bCmd = TCmdPItem::PickedUpItem;
+		delta.x = message.x;
+		delta.y = message.y;
+		delta.def.wIndx = message.def.wIndx;
+		delta.def.wCI = message.def.wCI;
+		delta.def.dwSeed = message.def.dwSeed;
+		if (message.def.wIndx == IDI_EAR) {
+			delta.ear.bCursval = message.ear.bCursval;
+			CopyUtf8(delta.ear.heroname, message.ear.heroname, sizeof(delta.ear.heroname));
+		} else {
+			delta.item.bId = message.item.bId;
+			delta.item.bDur = message.item.bDur;
+			delta.item.bMDur = message.item.bMDur;
+			delta.item.bCh = message.item.bCh;
+			delta.item.bMCh = message.item.bMCh;
+			delta.item.wValue = message.item.wValue;
+			delta.item.dwBuff = message.item.dwBuff;
+			delta.item.wToHit = message.item.wToHit;
 		}
 	}
 	return true;
@@ -1108,7 +1145,6 @@ void DeltaPutItem(const TCmdPItem &message, Point position, const Player &player
 
 	for (const TCmdPItem &item : deltaLevel.item) {
 		if (item.bCmd != TCmdPItem::PickedUpItem
-		    && item.bCmd != CMD_INVALID
 		    && item.def.wIndx == message.def.wIndx
 		    && item.def.wCI == message.def.wCI
 		    && item.def.dwSeed == message.def.dwSeed) {
@@ -1120,14 +1156,11 @@ void DeltaPutItem(const TCmdPItem &message, Point position, const Player &player
 		}
 	}
 
-	for (TCmdPItem &item : deltaLevel.item) {
-		if (item.bCmd == CMD_INVALID) {
-			memcpy(&item, &message, sizeof(TCmdPItem));
-			item.bCmd = TCmdPItem::DroppedItem;
-			item.x = position.x;
-			item.y = position.y;
-			return;
-		}
+	if (TCmdPItem *item = AddItemDelta(deltaLevel); item != nullptr) {
+		memcpy(item, &message, sizeof(TCmdPItem));
+		item->bCmd = TCmdPItem::DroppedItem;
+		item->x = position.x;
+		item->y = position.y;
 	}
 }
 
@@ -2048,6 +2081,7 @@ size_t OnMonstDamage(const TCmdMonDamage &message, Player &player)
 					monster.hitPoints -= Swap32LE(message.dwDam);
 					if ((monster.hitPoints >> 6) < 1)
 						monster.hitPoints = 1 << 6;
+					MarkMonsterHealthChanged(monster);
 					delta_monster_hp(monster, player);
 				}
 			}
@@ -2604,7 +2638,7 @@ size_t OnSpawnMonster(const TCmdSpawnMonster &message, const Player &player)
 
 	deltaLevel.spawnedMonsters[monsterId] = { typeIndex, message.seed, golemOwnerPlayerId, golemSpellLevel };
 	// Override old monster delta information
-	auto &deltaMonster = deltaLevel.monster[monsterId];
+	DMonsterStr &deltaMonster = GetMonsterDelta(deltaLevel, monsterId);
 	deltaMonster.position = position;
 	deltaMonster.hitPoints = -1;
 	deltaMonster.menemy = 0;
@@ -2755,12 +2789,15 @@ void run_delta_info()
 void DeltaExportData(uint8_t pnum)
 {
 	for (const auto &[levelNum, deltaLevel] : DeltaLevels) {
+		// Levels that were only looked at would be sent as nothing but unused slots.
+		if (IsDeltaLevelEmpty(deltaLevel))
+			continue;
 		const size_t bufferSize = 1U                                                            /* marker byte, always 0 */
 		    + sizeof(uint8_t)                                                                   /* level id */
-		    + sizeof(deltaLevel.item)                                                           /* items spawned during dungeon generation which have been picked up, and items dropped by a player during a game */
+		    + sizeof(TCmdPItem) * deltaLevel.item.size() + (MAXITEMS - deltaLevel.item.size())  /* items spawned during dungeon generation which have been picked up, and items dropped by a player during a game */
 		    + sizeof(uint8_t)                                                                   /* count of object interactions which caused a state change since dungeon generation */
 		    + (sizeof(WorldTilePosition) + sizeof(DObjectStr)) * deltaLevel.object.size()       /* location/action pairs for the object interactions */
-		    + sizeof(deltaLevel.monster)                                                        /* latest monster state */
+		    + sizeof(DMonsterStr) * deltaLevel.monster.size() + MaxMonsters                     /* latest monster state */
 		    + sizeof(uint16_t)                                                                  /* spawned monster count */
 		    + (sizeof(uint16_t) + sizeof(DSpawnedMonster)) * deltaLevel.spawnedMonsters.size(); /* spawned monsters */
 		const std::unique_ptr<std::byte[]> dst { new std::byte[bufferSize] };
@@ -2770,7 +2807,7 @@ void DeltaExportData(uint8_t pnum)
 		dstEnd += sizeof(uint8_t);
 		dstEnd = DeltaExportItem(dstEnd, deltaLevel.item);
 		dstEnd = DeltaExportObject(dstEnd, deltaLevel.object);
-		dstEnd = DeltaExportMonster(dstEnd, deltaLevel.monster);
+		dstEnd = DeltaExportMonster(dstEnd, deltaLevel);
 		dstEnd = DeltaExportSpawnedMonsters(dstEnd, deltaLevel.spawnedMonsters);
 		const uint32_t size = CompressData(dst.get(), dstEnd);
 		multi_send_zero_packet(pnum, CMD_DLEVEL, dst.get(), size);
@@ -2799,14 +2836,26 @@ void DeltaClearLevel(uint8_t level)
 	LocalLevels.erase(level);
 }
 
+size_t DeltaLevelsMemoryUsage()
+{
+	size_t bytes = DeltaLevels.size() * sizeof(DLevel) + LocalLevels.size() * sizeof(LocalLevel);
+	for (const auto &[level, deltaLevel] : DeltaLevels) {
+		bytes += deltaLevel.item.capacity() * sizeof(TCmdPItem);
+		bytes += deltaLevel.monster.size() * sizeof(decltype(deltaLevel.monster)::value_type);
+		bytes += deltaLevel.object.size() * sizeof(decltype(deltaLevel.object)::value_type);
+		bytes += deltaLevel.spawnedMonsters.size() * sizeof(decltype(deltaLevel.spawnedMonsters)::value_type);
+	}
+	return bytes;
+}
+
 void delta_kill_monster(const Monster &monster, Point position, const Player &player)
 {
 	if (!gbIsMultiplayer)
 		return;
 
-	DMonsterStr *pD = &GetDeltaLevel(player).monster[monster.getId()];
-	pD->position = position;
-	pD->hitPoints = 0;
+	DMonsterStr &delta = GetMonsterDelta(GetDeltaLevel(player), monster.getId());
+	delta.position = position;
+	delta.hitPoints = 0;
 }
 
 void delta_monster_hp(const Monster &monster, const Player &player)
@@ -2814,8 +2863,8 @@ void delta_monster_hp(const Monster &monster, const Player &player)
 	if (!gbIsMultiplayer)
 		return;
 
-	DMonsterStr *pD = &GetDeltaLevel(player).monster[monster.getId()];
-	if (SwapSigned32LE(pD->hitPoints) > monster.hitPoints)
+	DMonsterStr *pD = FindMonsterDelta(GetDeltaLevel(player), monster.getId());
+	if (pD != nullptr && SwapSigned32LE(pD->hitPoints) > monster.hitPoints)
 		pD->hitPoints = SwapSigned32LE(monster.hitPoints);
 }
 
@@ -2826,7 +2875,7 @@ void delta_sync_monster(const TSyncMonster &monsterSync, uint8_t level)
 
 	assert(level <= MaxMultiplayerLevels);
 
-	DMonsterStr &monster = GetDeltaLevel(level).monster[monsterSync._mndx];
+	DMonsterStr &monster = GetMonsterDelta(GetDeltaLevel(level), monsterSync._mndx);
 	if (monster.hitPoints == 0)
 		return;
 
@@ -2879,8 +2928,7 @@ void DeltaAddItem(int ii)
 	DLevel &deltaLevel = GetDeltaLevel(localLevel);
 
 	for (const TCmdPItem &item : deltaLevel.item) {
-		if (item.bCmd != CMD_INVALID
-		    && static_cast<_item_indexes>(Swap16LE(item.def.wIndx)) == Items[ii].IDidx
+		if (static_cast<_item_indexes>(Swap16LE(item.def.wIndx)) == Items[ii].IDidx
 		    && Swap16LE(item.def.wCI) == Items[ii]._iCreateInfo
 		    && static_cast<uint32_t>(Swap32LE(item.def.dwSeed)) == Items[ii]._iSeed
 		    && IsAnyOf(item.bCmd, TCmdPItem::PickedUpItem, TCmdPItem::FloorItem)) {
@@ -2888,15 +2936,11 @@ void DeltaAddItem(int ii)
 		}
 	}
 
-	for (TCmdPItem &delta : deltaLevel.item) {
-		if (delta.bCmd != CMD_INVALID)
-			continue;
-
-		delta.bCmd = TCmdPItem::FloorItem;
-		delta.x = Items[ii].position.x;
-		delta.y = Items[ii].position.y;
-		PrepareItemForNetwork(Items[ii], delta);
-		return;
+	if (TCmdPItem *delta = AddItemDelta(deltaLevel); delta != nullptr) {
+		delta->bCmd = TCmdPItem::FloorItem;
+		delta->x = Items[ii].position.x;
+		delta->y = Items[ii].position.y;
+		PrepareItemForNetwork(Items[ii], *delta);
 	}
 }
 
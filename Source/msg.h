@@ -6,6 +6,7 @@
 #pragma once
 
 #include <cstdint>
+#include <string_view>
 
 #include "dvlnet/leaveinfo.hpp"
 #include "engine/point.hpp"
@@ -726,6 +727,8 @@ void DeltaExportData(uint8_t pnum);
 void DeltaSyncJunk();
 void delta_init();
 void DeltaClearLevel(uint8_t level);
+/** @brief Bytes held by the level deltas and the remembered automaps of other levels. */
+size_t DeltaLevelsMemoryUsage();
 void delta_kill_monster(const Monster &monster, Point position, const Player &player);
 void delta_monster_hp(const Monster &monster, const Player &player);
 void delta_sync_monster(const TSyncMonster &monsterSync, uint8_t level);
@@ -761,5 +764,7 @@ void NetSendCmdString(uint32_t pmask, const char *pszStr);
 void delta_close_portal(const Player &player);
 bool ValidateCmdSize(size_t requiredCmdSize, size_t maxCmdSize, size_t playerId);
 size_t ParseCmd(uint8_t pnum, const TCmd *pCmd, size_t maxCmdSize);
+/** @brief The name of a command for logs and statistics, empty for unknown ones. */
+std::string_view CmdIdString(_cmd_id cmd);
 
 } // namespace devilution
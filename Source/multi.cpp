@@ -9,6 +9,7 @@
 #include <cstdint>
 #include <cstring>
 #include <string_view>
+#include <vector>
 
 #ifdef USE_SDL3
 #include <SDL3/SDL_endian.h>
@@ -24,7 +25,9 @@
 #include "DiabloUI/diabloui.h"
 #include "diablo.h"
 #include "engine/demomode.h"
+#include "engine/net_stats.hpp"
 #include "engine/point.hpp"
+#include "engine/tracing.hpp"
 #include "engine/random.hpp"
 #include "engine/world_tile.hpp"
 #include "game_mode.hpp"
@@ -372,10 +375,47 @@ void HandleAllPackets(uint8_t pnum, const std::byte *data, size_t size)
 		if (messageSize == 0) {
 			break;
 		}
+		CountNetCommand(NetDirection::Received, static_cast<uint8_t>(data[offset]), messageSize);
 		offset += messageSize;
 	}
 }
 
+/** Commands to the single player that wait for the game to be able to take them. */
+std::vector<std::byte> LocalCommands;
+/** The commands being parsed right now, kept apart so handlers can send more. */
+std::vector<std::byte> LocalCommandsInFlight;
+
+/**
+ * @brief Whether a command to `playerId` can skip the network provider and go to the handlers directly.
+ *
+ * Demos were recorded with every command taking a round trip through the provider, so they keep doing that.
+ */
+bool IsLocalCommand(uint8_t playerId)
+{
+	return !gbIsMultiplayer && playerId == MyPlayerId && !demo::IsRunning() && !demo::IsRecording();
+}
+
+/** @brief Parses the queued single player commands, including the ones their handlers send. */
+void DispatchLocalCommands()
+{
+	if (!LocalCommandsInFlight.empty())
+		return; // Called from one of the handlers, the loop below picks up the new commands.
+	while (!LocalCommands.empty()) {
+		LocalCommandsInFlight.swap(LocalCommands);
+		HandleAllPackets(MyPlayerId, LocalCommandsInFlight.data(), LocalCommandsInFlight.size());
+		LocalCommandsInFlight.clear();
+	}
+}
+
+void SendLocalCommand(const std::byte *data, size_t size)
+{
+	// The packet header would have told the receiver where the sender stood.
+	MyPlayer->position.last = MyPlayer->position.tile;
+	// Parsed later, like after a round trip through the provider, so the sender can still change
+	// the state the handler sees after sending it.
+	LocalCommands.insert(LocalCommands.end(), data, data + size);
+}
+
 void ProcessTmsgs()
 {
 	while (true) {
@@ -575,6 +615,11 @@ void InitGameInfo()
 void NetSendLoPri(uint8_t playerId, const std::byte *data, size_t size)
 {
 	if (data != nullptr && size != 0) {
+		CountNetCommand(NetDirection::Sent, static_cast<uint8_t>(data[0]), size);
+		if (IsLocalCommand(playerId)) {
+			SendLocalCommand(data, size);
+			return;
+		}
 		CopyPacket(&lowPriorityBuffer, data, size);
 		SendPacket(playerId, data, size);
 	}
@@ -583,6 +628,11 @@ void NetSendLoPri(uint8_t playerId, const std::byte *data, size_t size)
 void NetSendHiPri(uint8_t playerId, const std::byte *data, size_t size)
 {
 	if (data != nullptr && size != 0) {
+		CountNetCommand(NetDirection::Sent, static_cast<uint8_t>(data[0]), size);
+		if (IsLocalCommand(playerId)) {
+			SendLocalCommand(data, size);
+			return;
+		}
 		CopyPacket(&highPriorityBuffer, data, size);
 		SendPacket(playerId, data, size);
 	}
@@ -604,6 +654,7 @@ void NetSendHiPri(uint8_t playerId, const std::byte *data, size_t size)
 
 void multi_send_msg_packet(uint32_t pmask, const std::byte *data, size_t size)
 {
+	CountNetCommand(NetDirection::Sent, static_cast<uint8_t>(data[0]), size);
 	TPkt pkt;
 	NetReceivePlayerData(&pkt);
 	const size_t len = size + sizeof(pkt.hdr);
@@ -660,9 +711,11 @@ bool multi_handle_delta()
 	sgbSentThisCycle = nthread_send_and_recv_turn(sgbSentThisCycle, 1);
 	bool received;
 	if (!nthread_recv_turns(&received)) {
+		nthread_update_turn_delay(false);
 		BeginTimeout();
 		return false;
 	}
+	nthread_update_turn_delay(true);
 
 	sgbTimeout = false;
 	if (received) {
@@ -686,8 +739,10 @@ bool multi_handle_delta()
 
 void ProcessGameMessagePackets()
 {
+	DVL_TRACE_ZONE("ProcessGameMessagePackets");
 	ClearPlayerLeftState();
 	ProcessTmsgs();
+	DispatchLocalCommands();
 
 	uint8_t playerId = std::numeric_limits<uint8_t>::max();
 	TPktHdr *pkt;
@@ -758,6 +813,13 @@ void ProcessGameMessagePackets()
 	CheckPlayerInfoTimeouts();
 }
 
+void ProcessLocalCommands()
+{
+	// Messages are only buffered while waiting for the level from other players, which the single player never does.
+	if (gbBufferMsgs == 0)
+		DispatchLocalCommands();
+}
+
 void multi_send_zero_packet(uint8_t pnum, _cmd_id bCmd, const std::byte *data, size_t size)
 {
 	assert(pnum != MyPlayerId);
@@ -787,6 +849,7 @@ void multi_send_zero_packet(uint8_t pnum, _cmd_id bCmd, const std::byte *data, s
 			nthread_terminate_game("SNetSendMessage2");
 			return;
 		}
+		CountNetCommand(NetDirection::Sent, bCmd, sizeof(message) + dwBody);
 
 		offset += dwBody;
 	}
@@ -799,6 +862,7 @@ void NetClose()
 	}
 
 	sgbNetInited = false;
+	LocalCommands.clear();
 	nthread_cleanup();
 	tmsg_cleanup();
 	UnregisterNetEventHandlers();
@@ -82,6 +82,12 @@ void multi_net_ping();
  */
 bool multi_handle_delta();
 void ProcessGameMessagePackets();
+/**
+ * @brief Parses the commands the single player sent since they were last parsed.
+ *
+ * They are never parsed while being sent, but here after the tick and in ProcessGameMessagePackets().
+ */
+void ProcessLocalCommands();
 void multi_send_zero_packet(uint8_t pnum, _cmd_id bCmd, const std::byte *data, size_t size);
 void NetClose();
 bool NetInit(bool bSinglePlayer);
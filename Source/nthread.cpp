@@ -5,6 +5,8 @@
  */
 #include "nthread.h"
 
+#include <algorithm>
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
 
@@ -17,6 +19,8 @@
 #include "diablo.h"
 #include "engine/animationinfo.h"
 #include "engine/demomode.h"
+#include "engine/frame_pacer.hpp"
+#include "engine/turn_delay.hpp"
 #include "game_mode.hpp"
 #include "gmenu.h"
 #include "storm/storm_net.hpp"
@@ -45,6 +49,13 @@ int8_t sgbPacketCountdown;
 bool sgbThreadIsRunning;
 SdlThread Thread;
 
+/** Most turns sent ahead on a bad link, a bit over a second at normal speed. */
+constexpr uint32_t MaxTurnsInTransit = 8;
+/** Round trips are measured by the echo requests dvlnet sends every five seconds. */
+constexpr uint32_t RoundTripSampleInterval = 5000;
+TurnDelayController TurnDelay;
+uint32_t LastRoundTripSample;
+
 void NthreadHandler()
 {
 	if (!nthread_should_run) {
@@ -84,6 +95,10 @@ uint32_t nthread_send_and_recv_turn(uint32_t curTurn, int turnDelta)
 		nthread_terminate_game("SNetGetTurnsInTransit");
 		return 0;
 	}
+	// Only take up more turns when the game sends its own, so the extra turns carry real turn
+	// numbers instead of the padding the network thread sends while the game is loading.
+	if (turnDelta != 0)
+		gdwTurnsInTransit = TurnDelay.TurnsInTransit();
 	while (curTurnsInTransit++ < gdwTurnsInTransit) {
 
 		const uint32_t turnTmp = turn_upper_bit | (curTurn & 0x7FFFFFFF);
@@ -145,6 +160,7 @@ void nthread_set_turn_upper_bit()
 void nthread_start(bool setTurnUpperBit)
 {
 	last_tick = SDL_GetTicks();
+	GetFramePacer().Reset();
 	sgbPacketCountdown = 1;
 	sgbSyncCountdown = 1;
 	sgbTicsOutOfSync = true;
@@ -158,6 +174,8 @@ void nthread_start(bool setTurnUpperBit)
 	gdwTurnsInTransit = caps.defaultturnsintransit;
 	if (gdwTurnsInTransit == 0)
 		gdwTurnsInTransit = 1;
+	TurnDelay.Reset(1, gbIsMultiplayer ? MaxTurnsInTransit : 1, gdwTurnsInTransit);
+	LastRoundTripSample = SDL_GetTicks();
 	if (caps.defaultturnssec <= 20 && caps.defaultturnssec != 0)
 		sgbNetUpdateRate = 20 / caps.defaultturnssec;
 	else
@@ -211,6 +229,32 @@ void nthread_ignore_mutex(bool bStart)
 	sgbThreadIsRunning = bStart;
 }
 
+void nthread_update_turn_delay(bool turnsArrived)
+{
+	if (!gbIsMultiplayer)
+		return;
+	TurnDelay.AddTick(turnsArrived);
+
+	const uint32_t now = SDL_GetTicks();
+	if (now - LastRoundTripSample < RoundTripSampleInterval)
+		return;
+	LastRoundTripSample = now;
+	uint32_t worstRoundTrip = 0;
+	bool measured = false;
+	for (size_t i = 0; i < Players.size(); i++) {
+		if ((player_state[i] & PS_CONNECTED) == 0 || i == MyPlayerId)
+			continue;
+		const uint32_t roundTrip = DvlNet_GetLatencies(static_cast<uint8_t>(i)).echoLatency;
+		// Zero until the first echo reply came back.
+		if (roundTrip == 0)
+			continue;
+		worstRoundTrip = std::max(worstRoundTrip, roundTrip);
+		measured = true;
+	}
+	if (measured)
+		TurnDelay.AddRoundTrip(worstRoundTrip, static_cast<uint32_t>(gnTickDelay) * sgbNetUpdateRate);
+}
+
 bool nthread_has_500ms_passed(bool *drawGame /*= nullptr*/)
 {
 	const int currentTickCount = SDL_GetTicks();
@@ -234,11 +278,15 @@ bool nthread_has_500ms_passed(bool *drawGame /*= nullptr*/)
 		}
 	}
 	if (drawGame != nullptr) {
-		// Check if we missed a game tick.
+		// Check if drawing a frame now would make us miss the next game tick.
 		// This can happen when we run a low-end device that can't render fast enough (typically 20fps).
 		// If this happens, try to speed-up the game by skipping the rendering.
 		// This avoids desyncs and hourglasses when running multiplayer and slowdowns in singleplayer.
-		*drawGame = ticksElapsed <= gnTickDelay;
+		// Frames between ticks are only drawn if they fit, the frame of the tick itself decides whether to skip.
+		if (ticksElapsed >= 0)
+			*drawGame = GetFramePacer().ShouldDraw(std::chrono::milliseconds { gnTickDelay - ticksElapsed });
+		else
+			*drawGame = std::chrono::milliseconds { -ticksElapsed } >= GetFramePacer().PredictedFrameCost();
 	}
 	return ticksElapsed >= 0;
 }
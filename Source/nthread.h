@@ -29,6 +29,11 @@ void nthread_set_turn_upper_bit();
 void nthread_start(bool setTurnUpperBit);
 void nthread_cleanup();
 void nthread_ignore_mutex(bool bStart);
+/**
+ * @brief Adapts the turns kept in transit to the links to the other players, call once per game tick
+ * @param turnsArrived Whether the turns of the tick had arrived when it was due
+ */
+void nthread_update_turn_delay(bool turnsArrived);
 
 /**
  * @brief Checks if it's time for the logic to advance
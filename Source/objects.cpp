@@ -23,6 +23,7 @@
 #endif
 #include "diablo_msg.hpp"
 #include "engine/backbuffer_state.hpp"
+#include "engine/level_arena.hpp"
 #include "engine/load_cel.hpp"
 #include "engine/load_file.hpp"
 #include "engine/points_in_rectangle_range.hpp"
@@ -60,6 +61,8 @@ int ActiveObjects[MAXOBJECTS];
 int ActiveObjectCount;
 bool LoadingMapObjects;
 int NaKrulTomeSequence;
+uint32_t ObjectWalkabilityGeneration;
+uint32_t DoorStateGeneration;
 
 namespace {
 
@@ -103,7 +106,8 @@ enum shrine_type : uint8_t {
 
 int trapid;
 int trapdir;
-OptionalOwnedClxSpriteList pObjCels[40];
+/** Object graphics of the current level, stored in `LevelMemory`. */
+OptionalClxSpriteList pObjCels[40];
 object_graphic_id ObjFileList[40];
 /** Specifies the number of active objects. */
 int leverid;
@@ -325,6 +329,7 @@ void ClrAllObjects()
 		AvailableObjects[i] = i;
 	}
 	memset(ActiveObjects, 0, sizeof(ActiveObjects));
+	ObjectWalkabilityGeneration++;
 	trapdir = 0;
 	trapid = 1;
 	leverid = 1;
@@ -714,6 +719,7 @@ void SetupObject(Object &object, Point position, _object_id ot)
 	object._oPreFlag = false;
 	object._oTrapFlag = false;
 	object._oDoorFlag = false;
+	ObjectWalkabilityGeneration++;
 }
 
 void AddCryptBook(_object_id ot, int v2, Point position)
@@ -897,6 +903,7 @@ void DeleteObject(int oi, int i)
 	const Object &object = Objects[oi];
 	const Point position = object.position;
 	dObject[position.x][position.y] = 0;
+	ObjectWalkabilityGeneration++;
 	AvailableObjects[-ActiveObjectCount + MAXOBJECTS] = oi;
 	ActiveObjectCount--;
 	if (ObjectUnderCursor == &object) // Unselect object if this was highlighted by player
@@ -944,6 +951,7 @@ void AddChest(Object &chest)
 void ObjSetMicro(Point position, int pn)
 {
 	dPiece[position.x][position.y] = pn;
+	ObjectWalkabilityGeneration++;
 }
 
 void DoorSet(Point position, bool isLeftDoor)
@@ -1048,6 +1056,8 @@ void SetDoorStateOpen(Object &door)
 	door._oVar4 = DOOR_OPEN;
 	door._oPreFlag = true;
 	door._oMissFlag = true;
+	ObjectWalkabilityGeneration++;
+	DoorStateGeneration++;
 	door.selectionRegion = SelectionRegion::Middle;
 
 	switch (door._otype) {
@@ -1096,6 +1106,8 @@ void SetDoorStateClosed(Object &door)
 	door._oVar4 = DOOR_CLOSED;
 	door._oPreFlag = false;
 	door._oMissFlag = false;
+	ObjectWalkabilityGeneration++;
+	DoorStateGeneration++;
 	door.selectionRegion = SelectionRegion::Bottom | SelectionRegion::Middle;
 
 	switch (door._otype) {
@@ -1563,7 +1575,11 @@ void UpdateDoor(Object &door)
 		return;
 	}
 
-	door._oVar4 = IsDoorClear(door) ? DOOR_OPEN : DOOR_BLOCKED;
+	const int state = IsDoorClear(door) ? DOOR_OPEN : DOOR_BLOCKED;
+	if (door._oVar4 != state) {
+		door._oVar4 = state;
+		DoorStateGeneration++;
+	}
 }
 
 void UpdateSarcophagus(Object &sarcophagus)
@@ -1765,7 +1781,10 @@ void OperateDoor(Object &door, bool sendflag)
 
 	if (!openDoor && !IsDoorClear(door)) {
 		PlaySfxLoc(isCrypt ? SfxID::CryptDoorClose : SfxID::DoorClose, door.position);
-		door._oVar4 = DOOR_BLOCKED;
+		if (door._oVar4 != DOOR_BLOCKED) {
+			door._oVar4 = DOOR_BLOCKED;
+			DoorStateGeneration++;
+		}
 		return;
 	}
 
@@ -2320,6 +2339,7 @@ void OperateShrineHidden(DiabloGenerator &rng, Player &player)
 				player.InvBody[r]._iDurability = 1;
 			if (player.InvBody[r]._iMaxDur <= 0)
 				player.InvBody[r]._iMaxDur = 1;
+			MyPlayerEquipmentDurabilityGeneration++;
 			break;
 		}
 	}
@@ -3445,6 +3465,7 @@ void BreakCrux(Object &crux, bool sendmsg)
 	crux._oAnimFrame = 1;
 	crux._oAnimDelay = 1;
 	crux._oSolidFlag = true;
+	ObjectWalkabilityGeneration++;
 	crux._oMissFlag = true;
 	crux._oBreak = -1;
 	crux.selectionRegion = SelectionRegion::None;
@@ -3472,6 +3493,7 @@ void BreakBarrel(const Player &player, Object &barrel, bool forcebreak, bool sen
 	barrel._oAnimDelay = 1;
 	barrel._oSolidFlag = false;
 	barrel._oMissFlag = true;
+	ObjectWalkabilityGeneration++;
 	barrel._oBreak = -1;
 	barrel.selectionRegion = SelectionRegion::None;
 	barrel._oPreFlag = true;
@@ -3700,7 +3722,9 @@ tl::expected<void, std::string> LoadLevelObjects(uint16_t filesWidths[65])
 		ObjFileList[numobjfiles] = static_cast<object_graphic_id>(i);
 		char filestr[32];
 		*BufCopy(filestr, "objects\\", ObjMasterLoadList[i]) = '\0';
-		ASSIGN_OR_RETURN(pObjCels[numobjfiles], LoadCelWithStatus(filestr, filesWidths[i]));
+		ASSIGN_OR_RETURN(const OwnedClxSpriteList sprites, LoadCelWithStatus(filestr, filesWidths[i]));
+		const ClxSpriteList list { sprites };
+		pObjCels[numobjfiles].emplace(ClxSpriteList { LevelMemory.Copy({ list.data(), list.dataSize() }).data() });
 		numobjfiles++;
 	}
 	return {};
@@ -3744,6 +3768,7 @@ tl::expected<void, std::string> InitObjectGFX()
 
 void FreeObjectGFX()
 {
+	// The sprites themselves go with the rest of `LevelMemory` in FreeGameMem().
 	for (int i = 0; i < numobjfiles; i++) {
 		pObjCels[i] = std::nullopt;
 	}
@@ -4715,6 +4740,7 @@ void DeltaSyncBreakObj(Object &object)
 
 	if (object.IsBarrel()) {
 		object._oSolidFlag = false;
+		ObjectWalkabilityGeneration++;
 	} else if (object.IsCrux() && AreAllCruxesOfTypeBroken(object._oVar8)) {
 		ObjChangeMap(object._oVar1, object._oVar2, object._oVar3, object._oVar4);
 	}
@@ -4923,6 +4949,7 @@ void SyncNakrulRoom()
 	dPiece[UberRow][UberCol - 1] = 300;
 	dPiece[UberRow][UberCol - 2] = 299;
 	dPiece[UberRow][UberCol + 1] = 298;
+	ObjectWalkabilityGeneration++;
 }
 
 } // namespace devilution
@@ -300,6 +300,10 @@ extern int ActiveObjectCount;
 extern bool LoadingMapObjects;
 /** Tracks progress through the tome sequence that spawns Na-Krul (see OperateNakrulBook()) */
 extern int NaKrulTomeSequence;
+/** @brief Incremented whenever objects or map pieces change in a way that may affect walkability (doors, barrels, map changes...). */
+extern uint32_t ObjectWalkabilityGeneration;
+/** @brief Incremented whenever a door changes between open, closed and blocked. */
+extern uint32_t DoorStateGeneration;
 
 /**
  * @brief Find an object given a point in map coordinates
@@ -12,17 +12,21 @@
 #include <cstring>
 #include <functional>
 #include <iterator>
+#include <mutex>
 #include <optional>
 #include <span>
 #include <string>
 #include <unordered_set>
+#include <utility>
 
 #ifdef USE_SDL3
 #include <SDL3/SDL_audio.h>
 #include <SDL3/SDL_keycode.h>
 #include <SDL3/SDL_stdinc.h>
+#include <SDL3/SDL_timer.h>
 #include <SDL3/SDL_version.h>
 #else
+#include <SDL_timer.h>
 #include <SDL_version.h>
 #endif
 
@@ -44,7 +48,10 @@
 #include "utils/log.hpp"
 #include "utils/logged_fstream.hpp"
 #include "utils/paths.h"
+#include "utils/sdl_cond.h"
+#include "utils/sdl_mutex.h"
 #include "utils/sdl_ptrs.h"
+#include "utils/sdl_thread.h"
 #include "utils/str_cat.hpp"
 #include "utils/str_split.hpp"
 #include "utils/utf8.hpp"
@@ -162,24 +169,102 @@ void LoadIni()
 	ini.emplace(std::move(result).value());
 }
 
-void SaveIni()
+/** Least time between two writes of the ini file, so options changed in quick succession are written once. */
+constexpr uint32_t IniWriteIntervalMs = 3000;
+
+struct IniFileContents {
+	std::string configPath;
+	std::string iniPath;
+	std::string contents;
+};
+
+struct IniWriterState {
+	SdlMutex mutex;
+	SdlCond wakeUp;
+	/** Only the latest contents are kept, they include all the changes before them. */
+	std::optional<IniFileContents> pending;
+	/** Set when the last write failed, so that the next SaveIni() writes the ini again even if it didn't change. */
+	bool failed = false;
+	bool stop = false;
+};
+
+std::optional<IniWriterState> IniWriter;
+SdlThread IniWriterThread;
+
+bool WriteIniFile(const IniFileContents &file)
 {
-	if (!ini.has_value()) return;
-	if (!ini->changed()) return;
-	if (!paths::ConfigPath().empty()) {
-		RecursivelyCreateDir(paths::ConfigPath().c_str());
+	if (!file.configPath.empty()) {
+		RecursivelyCreateDir(file.configPath.c_str());
 	}
-	const std::string iniPath = GetIniPath();
 	LoggedFStream out;
-	if (!out.Open(iniPath.c_str(), "wb")) {
-		LogError("Failed to open ini file for writing at {}: {}", iniPath, std::strerror(errno));
-		return;
-	}
-	const std::string newContents = ini->serialize();
-	if (out.Write(newContents.data(), newContents.size())) {
-		ini->markAsUnchanged();
+	if (!out.Open(file.iniPath.c_str(), "wb")) {
+		LogError("Failed to open ini file for writing at {}: {}", file.iniPath, std::strerror(errno));
+		return false;
 	}
+	const bool written = out.Write(file.contents.data(), file.contents.size()) && out.Sync();
 	out.Close();
+	return written;
+}
+
+void IniWriterLoop()
+{
+	IniWriterState &state = *IniWriter;
+	std::unique_lock<SdlMutex> lock(state.mutex);
+	while (true) {
+		while (!state.stop && !state.pending)
+			state.wakeUp.wait(state.mutex);
+		// The last changes are written right away when shutting down.
+		if (!state.pending)
+			return;
+
+		const IniFileContents file = std::move(*state.pending);
+		state.pending = std::nullopt;
+		lock.unlock();
+		const bool written = WriteIniFile(file);
+		lock.lock();
+		state.failed = !written;
+
+		const auto writtenAt = static_cast<uint32_t>(SDL_GetTicks());
+		while (!state.stop) {
+			const uint32_t elapsed = static_cast<uint32_t>(SDL_GetTicks()) - writtenAt;
+			if (elapsed >= IniWriteIntervalMs)
+				break;
+			state.wakeUp.waitFor(state.mutex, IniWriteIntervalMs - elapsed);
+		}
+	}
+}
+
+/**
+ * @brief Hands the changed ini to the writer thread, which writes it at most once every few seconds.
+ */
+void SaveIni()
+{
+	if (!ini.has_value()) return;
+#ifdef __DJGPP__
+	if (!ini->changed()) return;
+	// No threads, write right away.
+	if (WriteIniFile({ paths::ConfigPath(), GetIniPath(), ini->serialize() }))
+		ini->markAsUnchanged();
+#else
+	bool retry = false;
+	if (IniWriter) {
+		const std::lock_guard<SdlMutex> lock(IniWriter->mutex);
+		retry = std::exchange(IniWriter->failed, false);
+	}
+	if (!ini->changed() && !retry) return;
+	IniFileContents file { paths::ConfigPath(), GetIniPath(), ini->serialize() };
+	ini->markAsUnchanged();
+	if (!IniWriter)
+		IniWriter.emplace();
+	{
+		const std::lock_guard<SdlMutex> lock(IniWriter->mutex);
+		IniWriter->pending = std::move(file);
+	}
+	IniWriter->wakeUp.signal();
+
+	if (!IniWriterThread.joinable())
+		IniWriterThread = SdlThread { IniWriterLoop };
+#endif
 }
 
 #if SDL_VERSION_ATLEAST(2, 0, 0)
@@ -278,6 +363,22 @@ void SaveOptions()
 	SaveIni();
 }
 
+void FlushOptions()
+{
+	if (!IniWriter)
+		return;
+
+	if (IniWriterThread.joinable()) {
+		{
+			const std::lock_guard<SdlMutex> lock(IniWriter->mutex);
+			IniWriter->stop = true;
+		}
+		IniWriter->wakeUp.signal();
+		IniWriterThread.join();
+	}
+	IniWriter = std::nullopt;
+}
+
 std::string_view OptionEntryBase::GetName() const
 {
 	return _(name);
@@ -516,6 +617,10 @@ AudioOptions::AudioOptions()
     , walkingSound("Walking Sound", OptionEntryFlags::None, N_("Walking Sound"), N_("Player emits sound when walking."), true)
     , autoEquipSound("Auto Equip Sound", OptionEntryFlags::None, N_("Auto Equip Sound"), N_("Automatically equipping items on pickup emits the equipment sound."), false)
     , itemPickupSound("Item Pickup Sound", OptionEntryFlags::None, N_("Item Pickup Sound"), N_("Picking up items emits the items pickup sound."), false)
+    , audioCueVoices("Audio Cue Voices", OptionEntryFlags::None, N_("Audio Cue Voices"), N_("Number of navigation audio cues that can play at the same time."), 3, { 1, 2, 3, 4, 6, 8, 12, 16 })
+    , binauralAudioCues("Binaural Audio Cues", OptionEntryFlags::None, N_("Binaural Audio Cues"), N_("Navigation audio cues reach each ear with a different delay and tone, which makes them easier to locate with headphones."), false)
+    , speechClips("Speech Clips", OptionEntryFlags::CantChangeInGame, N_("Speech Clips"), N_("Plays short announcements from recorded clips, which start sooner than the screen reader. Record them with tools/prerender_speech.py."), false)
+    , showAudioStats("Show Audio Statistics", OptionEntryFlags::None, N_("Show Audio Statistics"), N_("Displays the time spent on decoding, resampling and mixing and the buffer underruns, to help pick a buffer size."), false)
     , sampleRate("Sample Rate", OptionEntryFlags::CantChangeInGame, N_("Sample Rate"), N_("Output sample rate (Hz)."), DEFAULT_AUDIO_SAMPLE_RATE, { 22050, 44100, 48000 })
     , channels("Channels", OptionEntryFlags::CantChangeInGame, N_("Channels"), N_("Number of output channels."), DEFAULT_AUDIO_CHANNELS, { 1, 2 })
     , bufferSize("Buffer Size", OptionEntryFlags::CantChangeInGame, N_("Buffer Size"), N_("Buffer size (number of frames per channel)."), DEFAULT_AUDIO_BUFFER_SIZE, { 1024, 2048, 5120 })
@@ -532,6 +637,10 @@ std::vector<OptionEntryBase *> AudioOptions::GetEntries()
 		&walkingSound,
 		&autoEquipSound,
 		&itemPickupSound,
+		&audioCueVoices,
+		&binauralAudioCues,
+		&speechClips,
+		&showAudioStats,
 		&sampleRate,
 		&channels,
 		&bufferSize,
@@ -797,6 +906,8 @@ GraphicsOptions::GraphicsOptions()
     , hardwareCursorMaxSize("Hardware Cursor Maximum Size", OptionEntryFlags::CantChangeInGame | OptionEntryFlags::RecreateUI | (HardwareCursorSupported() ? OptionEntryFlags::None : OptionEntryFlags::Invisible), N_("Hardware Cursor Maximum Size"), N_("Maximum width / height for the hardware cursor. Larger cursors fall back to software."), 128, { 0, 64, 128, 256, 512 })
 #endif
     , showFPS("Show FPS", OptionEntryFlags::None, N_("Show FPS"), N_("Displays the FPS in the upper left corner of the screen."), false)
+    , frameCaptureSeconds("Frame Capture", OptionEntryFlags::None, N_("Frame Capture"), N_("Seconds of frames kept in memory. The Frame capture key, or a frame that comes a quarter second late, writes them with their timings to a folder."), 0, { 0, 5, 10, 30 })
+    , audioFirst("Audio-First Mode", OptionEntryFlags::None, N_("Audio-First Mode"), N_("Skips drawing the dungeon and updates the screen only a few times per second to save power. Game logic, sound and speech keep running at full speed."), false)
 {
 }
 std::vector<OptionEntryBase *> GraphicsOptions::GetEntries()
@@ -819,6 +930,8 @@ std::vector<OptionEntryBase *> GraphicsOptions::GetEntries()
 		&brightness,
 		&zoom,
 		&showFPS,
+		&frameCaptureSeconds,
+		&audioFirst,
 		&perPixelLighting,
 		&colorCycling,
 		&alternateNestArt,
@@ -872,6 +985,8 @@ GameplayOptions::GameplayOptions()
     , numRejuPotionPickup("Rejuvenation Potion Pickup", OptionEntryFlags::None, N_("Rejuvenation Potion Pickup"), N_("Number of Rejuvenation potions to pick up automatically."), 0, { 0, 1, 2, 4, 8, 16 })
     , numFullRejuPotionPickup("Full Rejuvenation Potion Pickup", OptionEntryFlags::None, N_("Full Rejuvenation Potion Pickup"), N_("Number of Full Rejuvenation potions to pick up automatically."), 0, { 0, 1, 2, 4, 8, 16 })
     , skipLoadingScreenThresholdMs("Skip loading screen threshold, ms", OptionEntryFlags::Invisible, "", "", 0)
+    , groupMonsterAi("Group Monster AI", OptionEntryFlags::Invisible, "", "", false)
+    , sharedMonsterPaths("Shared Monster Paths", OptionEntryFlags::Invisible, "", "", false)
 {
 }
 
@@ -917,6 +1032,8 @@ std::vector<OptionEntryBase *> GameplayOptions::GetEntries()
 		&grabInput,
 		&pauseOnFocusLoss,
 		&skipLoadingScreenThresholdMs,
+		&groupMonsterAi,
+		&sharedMonsterPaths,
 	};
 }
 
@@ -932,12 +1049,14 @@ std::vector<OptionEntryBase *> ControllerOptions::GetEntries()
 NetworkOptions::NetworkOptions()
     : OptionCategoryBase("Network", N_("Network"), N_("Network Settings"))
     , port("Port", OptionEntryFlags::Invisible, "Port", "What network port to use.", 6112)
+    , relayThread("Relay Thread", OptionEntryFlags::CantChangeInGame, N_("Relay Thread"), N_("When hosting a TCP game, forward the other players' packets on a separate thread so they don't wait on the host's frames."), true)
 {
 }
 std::vector<OptionEntryBase *> NetworkOptions::GetEntries()
 {
 	return {
 		&port,
+		&relayThread,
 	};
 }
 
@@ -1276,7 +1395,7 @@ bool KeymapperOptions::Action::SetValue(int value)
 
 	// Remove old key
 	if (boundKey != SDLK_UNKNOWN) {
-		GetOptions().Keymapper.keyIDToAction.erase(boundKey);
+		GetOptions().Keymapper.SetKeyAction(boundKey, nullptr);
 		boundKey = SDLK_UNKNOWN;
 	}
 
@@ -1289,7 +1408,7 @@ bool KeymapperOptions::Action::SetValue(int value)
 			it->second.get().boundKey = SDLK_UNKNOWN;
 		}
 
-		GetOptions().Keymapper.keyIDToAction.insert_or_assign(value, *this);
+		GetOptions().Keymapper.SetKeyAction(value, this);
 		boundKey = value;
 	}
 
@@ -1306,8 +1425,40 @@ void KeymapperOptions::CommitActions()
 	actions.reverse();
 }
 
+std::optional<size_t> KeymapperOptions::DenseKeyIndex(uint32_t key)
+{
+	// Same bit as SDLK_SCANCODE_MASK, which marks the keys without a character.
+	constexpr uint32_t ScancodeMask = 1U << 30;
+	if (key < DenseKeyRange)
+		return key;
+	if ((key & KeymapperMouseButtonMask) != 0) {
+		const uint32_t button = key & ~KeymapperMouseButtonMask;
+		if (button < 16)
+			return 2 * DenseKeyRange + button;
+		if (key >= MouseScrollUpButton && key <= MouseScrollRightButton)
+			return 2 * DenseKeyRange + 16 + (key - MouseScrollUpButton);
+		return std::nullopt;
+	}
+	if ((key & ScancodeMask) != 0 && (key & ~ScancodeMask) < DenseKeyRange)
+		return DenseKeyRange + (key & ~ScancodeMask);
+	return std::nullopt;
+}
+
+void KeymapperOptions::SetKeyAction(uint32_t key, Action *action)
+{
+	if (action != nullptr)
+		keyIDToAction.insert_or_assign(key, *action);
+	else
+		keyIDToAction.erase(key);
+	if (const std::optional<size_t> index = DenseKeyIndex(key))
+		denseKeyToAction[*index] = action;
+}
+
 const KeymapperOptions::Action *KeymapperOptions::findAction(uint32_t key) const
 {
+	// Called on every key event, most keys don't need a hash lookup.
+	if (const std::optional<size_t> index = DenseKeyIndex(key))
+		return denseKeyToAction[*index];
 	auto it = keyIDToAction.find(key);
 	if (it == keyIDToAction.end()) return nullptr;
 	return &it->second.get();
@@ -497,6 +497,14 @@ struct AudioOptions : OptionCategoryBase {
 	OptionEntryBoolean autoEquipSound;
 	/** @brief Picking up items emits the items pickup sound. */
 	OptionEntryBoolean itemPickupSound;
+	/** @brief Number of navigation audio cues that can play at the same time. */
+	OptionEntryInt<std::uint8_t> audioCueVoices;
+	/** @brief Render navigation audio cues binaurally for headphones instead of panning them. */
+	OptionEntryBoolean binauralAudioCues;
+	/** @brief Play short announcements from clips recorded ahead by tools/prerender_speech.py instead of the speech engine. */
+	OptionEntryBoolean speechClips;
+	/** @brief Show what the audio pipeline costs below the FPS counter and log it as JSON once per second. */
+	OptionEntryBoolean showAudioStats;
 
 	/** @brief Output sample rate (Hz). */
 	OptionEntryInt<std::uint32_t> sampleRate;
@@ -553,6 +561,10 @@ struct GraphicsOptions : OptionCategoryBase {
 #endif
 	/** @brief Show FPS, even without the -f command line flag. */
 	OptionEntryBoolean showFPS;
+	/** @brief Seconds of presented frames kept in memory for a frame capture, 0 to keep none. */
+	OptionEntryInt<int> frameCaptureSeconds;
+	/** @brief Don't draw the dungeon and present only a few frames per second, to save power when nobody looks at the screen. */
+	OptionEntryBoolean audioFirst;
 };
 
 struct GameplayOptions : OptionCategoryBase {
@@ -642,6 +654,19 @@ struct GameplayOptions : OptionCategoryBase {
 	 * Advanced option, not displayed in the UI.
 	 */
 	OptionEntryInt<int> skipLoadingScreenThresholdMs;
+	/**
+	 * @brief Update the monsters grouped by AI instead of in the order they were activated.
+	 *
+	 * Advanced option, not displayed in the UI. Only used in single player games outside of demos.
+	 */
+	OptionEntryBoolean groupMonsterAi;
+	/**
+	 * @brief Let the monsters chasing the same target on the same tick read their steps from one shared path field.
+	 *
+	 * Advanced option, not displayed in the UI. Only used in single player games outside of demos,
+	 * the routes differ from the ones FindPath picks.
+	 */
+	OptionEntryBoolean sharedMonsterPaths;
 };
 
 struct ControllerOptions : OptionCategoryBase {
@@ -670,6 +695,8 @@ struct NetworkOptions : OptionCategoryBase {
 	char szPreviousHost[129];
 	/** @brief What network port to use. */
 	OptionEntryInt<uint16_t> port;
+	/** @brief Forward the other players' packets on a thread of its own when hosting a TCP game. */
+	OptionEntryBoolean relayThread;
 };
 
 struct ChatOptions : OptionCategoryBase {
@@ -753,8 +780,19 @@ struct KeymapperOptions : OptionCategoryBase {
 	uint32_t KeyForAction(std::string_view actionName) const;
 
 private:
+	/** Keys below this value, scancode keys below it and mouse buttons are looked up in denseKeyToAction. */
+	static constexpr uint32_t DenseKeyRange = 512;
+	static constexpr size_t DenseKeyCount = 2 * DenseKeyRange + 16 + 4;
+
+	[[nodiscard]] static std::optional<size_t> DenseKeyIndex(uint32_t key);
+
+	/** @brief Binds or unbinds a key in both keyIDToAction and denseKeyToAction. */
+	void SetKeyAction(uint32_t key, Action *action);
+
 	std::forward_list<Action> actions;
 	ankerl::unordered_dense::segmented_map<uint32_t, std::reference_wrapper<Action>> keyIDToAction;
+	/** The same bindings as keyIDToAction, for the keys a key event can be looked up by index. */
+	std::array<Action *, DenseKeyCount> denseKeyToAction {};
 	ankerl::unordered_dense::segmented_map<uint32_t, std::string> keyIDToKeyName;
 	ankerl::unordered_dense::segmented_map<std::string, uint32_t, StringViewHash, StringViewEquals> keyNameToKeyID;
 };
@@ -902,9 +940,16 @@ bool HardwareCursorSupported();
 
 /**
  * @brief Save game configurations to ini file
+ *
+ * The file is written on a background thread, at most once every few seconds.
  */
 void SaveOptions();
 
+/**
+ * @brief Writes the options saved last if they are still waiting, and stops the writer thread.
+ */
+void FlushOptions();
+
 /**
  * @brief Load game configurations from ini file
  */
@@ -14,10 +14,12 @@
 #include "engine/render/clx_render.hpp"
 #include "engine/render/text_render.hpp"
 #include "panels/ui_panels.hpp"
+#include "inv.h"
 #include "msg.h"
 #include "player.h"
 #include "tables/playerdat.hpp"
 #include "utils/algorithm/container.hpp"
+#include "utils/announcement.hpp"
 #include "utils/display.h"
 #include "utils/enum_traits.h"
 #include "utils/format_int.hpp"
@@ -369,10 +371,78 @@ constexpr int PanelFieldInnerHeight = PanelFieldHeight - PanelFieldPaddingTop -
 	}
 }
 
+/** @brief Whether a field changes without the player's stats being recalculated, so it is never snapshotted. */
+[[nodiscard]] bool IsLiveCharacterScreenField(CharacterScreenField field)
+{
+	switch (field) {
+	case CharacterScreenField::Experience:
+	case CharacterScreenField::NextLevel:
+	case CharacterScreenField::PointsToDistribute:
+	case CharacterScreenField::Gold:
+	case CharacterScreenField::Life:
+	case CharacterScreenField::Mana:
+		return true;
+	default:
+		return false;
+	}
+}
+
+/**
+ * Texts of the fields that only change when CalcPlrItemVals() runs, so stepping through the sheet
+ * and comparing before and after equipping an item don't rebuild them every time.
+ * Life and mana keep only their maximum, for the comparison.
+ */
+struct CharacterStatsSnapshot {
+	const Player *player = nullptr;
+	uint32_t languageGeneration = 0;
+	bool stale = true;
+	std::array<std::string, CharacterScreenFieldOrder.size()> texts;
+};
+
+CharacterStatsSnapshot StatsSnapshot;
+
+[[nodiscard]] std::string GetSnapshotFieldText(CharacterScreenField field)
+{
+	switch (field) {
+	case CharacterScreenField::Life:
+		return StrCat(LanguageTranslate(panelEntries[21].label), ": ", GetEntryValue(panelEntries[21]));
+	case CharacterScreenField::Mana:
+		return StrCat(LanguageTranslate(panelEntries[23].label), ": ", GetEntryValue(panelEntries[23]));
+	default:
+		return IsLiveCharacterScreenField(field) ? std::string {} : GetCharacterScreenFieldText(field);
+	}
+}
+
+[[nodiscard]] bool IsStatsSnapshotCurrent()
+{
+	return !StatsSnapshot.stale && StatsSnapshot.player == InspectPlayer
+	    && StatsSnapshot.languageGeneration == GetAnnouncementLanguageGeneration();
+}
+
+void TakeStatsSnapshot()
+{
+	StatsSnapshot.player = InspectPlayer;
+	StatsSnapshot.languageGeneration = GetAnnouncementLanguageGeneration();
+	StatsSnapshot.stale = false;
+	for (size_t i = 0; i < CharacterScreenFieldOrder.size(); i++)
+		StatsSnapshot.texts[i] = GetSnapshotFieldText(CharacterScreenFieldOrder[i]);
+}
+
 void SpeakCurrentCharacterScreenField()
 {
 	const CharacterScreenField field = CharacterScreenFieldOrder[SelectedCharacterScreenFieldIndex];
-	const std::string text = GetCharacterScreenFieldText(field);
+	if (IsLiveCharacterScreenField(field)) {
+		const std::string text = GetCharacterScreenFieldText(field);
+		if (!text.empty())
+			SpeakText(text, true);
+		return;
+	}
+
+	if (InspectPlayer == nullptr)
+		return;
+	if (!IsStatsSnapshotCurrent())
+		TakeStatsSnapshot();
+	const std::string &text = StatsSnapshot.texts[SelectedCharacterScreenFieldIndex];
 	if (!text.empty())
 		SpeakText(text, true);
 }
@@ -527,6 +597,42 @@ void InitCharacterScreenSpeech()
 	SpeakCurrentCharacterScreenField();
 }
 
+void MarkCharacterStatsChanged(const Player &player)
+{
+	if (&player == StatsSnapshot.player)
+		StatsSnapshot.stale = true;
+}
+
+void UpdateCharacterStatChangeAnnouncements()
+{
+	if (MyPlayer == nullptr || InspectPlayer != MyPlayer)
+		return;
+	if (IsStatsSnapshotCurrent())
+		return;
+
+	// Only compare against a snapshot of the same player in the same language, anything else would read out the whole sheet.
+	const bool comparable = StatsSnapshot.player == MyPlayer && StatsSnapshot.languageGeneration == GetAnnouncementLanguageGeneration();
+	static std::array<std::string, CharacterScreenFieldOrder.size()> previous;
+	previous.swap(StatsSnapshot.texts);
+	TakeStatsSnapshot();
+	// Only what changes while the inventory is open is read out, which is where items get equipped.
+	if (!comparable || !invflag)
+		return;
+
+	static std::string changes;
+	changes.clear();
+	for (size_t i = 0; i < previous.size(); i++) {
+		const std::string &text = StatsSnapshot.texts[i];
+		if (text == previous[i])
+			continue;
+		if (!changes.empty())
+			changes.append(", ");
+		changes.append(text);
+	}
+	if (!changes.empty())
+		SpeakText(changes, true, SpeechPriority::Queued);
+}
+
 void CharacterScreenMoveSelection(int delta)
 {
 	if (CharFlag == false)
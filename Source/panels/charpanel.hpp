@@ -9,10 +9,16 @@
 
 namespace devilution {
 
+struct Player;
+
 extern OptionalOwnedClxSpriteList pChrButtons;
 
 void DrawChr(const Surface &);
 void InitCharacterScreenSpeech();
+/** @brief Lets the character sheet know that CalcPlrItemVals() changed the player's stats. */
+void MarkCharacterStatsChanged(const Player &player);
+/** @brief Speaks the stats that changed since the last snapshot, if it changed while the inventory is open. */
+void UpdateCharacterStatChangeAnnouncements();
 void CharacterScreenMoveSelection(int delta);
 void CharacterScreenActivateSelection(bool addAllStatPoints);
 tl::expected<void, std::string> LoadCharPanel();
@@ -5,9 +5,17 @@
  */
 #include "pfile.h"
 
+#include <array>
+#include <atomic>
 #include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <span>
 #include <string>
 #include <string_view>
+#include <utility>
 
 #include <ankerl/unordered_dense.h>
 #include <expected.hpp>
@@ -22,6 +30,8 @@
 #include "codec.h"
 #include "engine/load_file.hpp"
 #include "engine/render/primitive_render.hpp"
+#include "engine/render/render_workers.hpp"
+#include "engine/tracing.hpp"
 #include "game_mode.hpp"
 #include "loadsave.h"
 #include "menu.h"
@@ -31,11 +41,17 @@
 #include "tables/playerdat.hpp"
 #include "utils/endian_read.hpp"
 #include "utils/endian_swap.hpp"
+#include "utils/endian_write.hpp"
 #include "utils/file_util.h"
+#include "utils/fnv1a.hpp"
 #include "utils/language.h"
+#include "utils/log.hpp"
 #include "utils/parse_int.hpp"
 #include "utils/paths.h"
 #include "utils/sdl_compat.h"
+#include "utils/sdl_cond.h"
+#include "utils/sdl_mutex.h"
+#include "utils/sdl_thread.h"
 #include "utils/stdcompat/filesystem.hpp"
 #include "utils/str_cat.hpp"
 #include "utils/str_split.hpp"
@@ -61,13 +77,16 @@ namespace {
 /** List of character names for the character selection screen. */
 char hero_names[MAX_CHARACTERS][PlayerNameLength];
 
+std::string_view GetSaveModePrefix()
+{
+	return gbIsSpawn
+	    ? (gbIsMultiplayer ? "share_" : "spawn_")
+	    : (gbIsMultiplayer ? "multi_" : "single_");
+}
+
 std::string GetSavePath(uint32_t saveNum, std::string_view savePrefix = {})
 {
-	return StrCat(paths::PrefPath(), savePrefix,
-	    gbIsSpawn
-	        ? (gbIsMultiplayer ? "share_" : "spawn_")
-	        : (gbIsMultiplayer ? "multi_" : "single_"),
-	    saveNum,
+	return StrCat(paths::PrefPath(), savePrefix, GetSaveModePrefix(), saveNum,
 #ifdef UNPACKED_SAVES
 	    gbIsHellfire ? "_hsv" DIRECTORY_SEPARATOR_STR : "_sv" DIRECTORY_SEPARATOR_STR
 #else
@@ -114,7 +133,7 @@ bool GetTempSaveNames(uint8_t dwIndex, char *szTemp)
 	return GetSaveNames(dwIndex, "temp", szTemp);
 }
 
-void RenameTempToPerm(SaveWriter &saveWriter)
+void RenameTempToPerm(SaveWriter &saveWriter, SaveFileHashes *hashes = nullptr)
 {
 	char szTemp[MaxMpqPathSize];
 	char szPerm[MaxMpqPathSize];
@@ -128,11 +147,160 @@ void RenameTempToPerm(SaveWriter &saveWriter)
 			if (saveWriter.HasFile(szPerm))
 				saveWriter.RemoveHashEntry(szPerm);
 			saveWriter.RenameFile(szTemp, szPerm);
+			if (hashes != nullptr) {
+				const auto it = hashes->find(szTemp);
+				if (it != hashes->end()) {
+					(*hashes)[szPerm] = it->second;
+					hashes->erase(szTemp);
+				} else {
+					hashes->erase(szPerm);
+				}
+			}
 		}
 	}
 	assert(!GetPermSaveNames(dwIndex, szPerm));
 }
 
+struct QueuedSave {
+	std::string path;
+	const char *password;
+	SaveBatch batch;
+};
+
+struct SaveQueueState {
+	SdlMutex mutex;
+	SdlCond wakeUp;
+	SdlCond idle;
+
+	std::deque<QueuedSave> saves;
+	bool writing = false;
+	bool stop = false;
+};
+
+std::optional<SaveQueueState> SaveQueue;
+SdlThread SaveThread;
+
+/**
+ * What the save thread last wrote to each archive, by path. Only used by the save thread, and
+ * cleared when the archives are written directly, once the save thread is done.
+ */
+ankerl::unordered_dense::map<std::string, SaveFileHashes> WrittenFileHashes;
+
+#ifndef UNPACKED_SAVES
+std::string GetTempArchivePath(const std::string &path)
+{
+	return StrCat(path, ".tmp");
+}
+
+/** @brief Finishes a save that was interrupted between removing the old archive and renaming the new one. */
+void RecoverInterruptedSave(const std::string &path)
+{
+	const std::string tempPath = GetTempArchivePath(path);
+	if (!FileExists(path) && FileExists(tempPath))
+		RenameFile(tempPath.c_str(), path.c_str());
+}
+#endif
+
+void WriteQueuedSave(QueuedSave &save)
+{
+	DVL_TRACE_ZONE("WriteQueuedSave");
+	// Files that didn't change since they were last written, like the levels that weren't
+	// visited again, aren't written again.
+	SaveFileHashes &hashes = WrittenFileHashes[save.path];
+	save.batch.DropUnchangedFiles(hashes);
+	if (save.batch.empty())
+		return;
+
+#ifdef UNPACKED_SAVES
+	SaveWriter saveWriter(std::string(save.path));
+	save.batch.Write(saveWriter, save.password, &hashes);
+#else
+	// The files are written to a copy of the archive, which replaces it once it is complete,
+	// so that quitting or crashing midway leaves the previous save intact.
+	RecoverInterruptedSave(save.path);
+	const std::string tempPath = GetTempArchivePath(save.path);
+	if (FileExists(save.path))
+		CopyFileOverwrite(save.path.c_str(), tempPath.c_str());
+	else
+		RemoveFile(tempPath.c_str());
+	bool written;
+	{
+		SaveWriter saveWriter(tempPath);
+		written = save.batch.Write(saveWriter, save.password, &hashes);
+	}
+	if (!written) {
+		// Keep the previous save, which the hashes no longer describe.
+		LogError("Failed to write the save {}, keeping the previous one", save.path);
+		RemoveFile(tempPath.c_str());
+		hashes.clear();
+		return;
+	}
+	RemoveFile(save.path.c_str());
+	RenameFile(tempPath.c_str(), save.path.c_str());
+#endif
+}
+
+void SaveThreadLoop()
+{
+	SaveQueueState &state = *SaveQueue;
+	std::unique_lock<SdlMutex> lock(state.mutex);
+	while (true) {
+		while (!state.stop && state.saves.empty())
+			state.wakeUp.wait(state.mutex);
+		if (state.saves.empty())
+			return;
+
+		QueuedSave save = std::move(state.saves.front());
+		state.saves.pop_front();
+		state.writing = true;
+
+		lock.unlock();
+		WriteQueuedSave(save);
+		lock.lock();
+
+		state.writing = false;
+		if (state.saves.empty())
+			state.idle.broadcast();
+	}
+}
+
+/**
+ * @brief Hands the files to the save thread, which encodes them and writes them to the archive at `path`.
+ *
+ * The password is taken now, as it depends on the game mode.
+ */
+void QueueSave(std::string path, SaveBatch &&batch)
+{
+	QueuedSave save { std::move(path), pfile_get_password(), std::move(batch) };
+#ifdef __DJGPP__
+	// No threads, write right away.
+	WriteQueuedSave(save);
+#else
+	if (!SaveQueue)
+		SaveQueue.emplace();
+	{
+		const std::lock_guard<SdlMutex> lock(SaveQueue->mutex);
+		SaveQueue->saves.push_back(std::move(save));
+	}
+	SaveQueue->wakeUp.signal();
+
+	if (!SaveThread.joinable())
+		SaveThread = SdlThread { SaveThreadLoop };
+#endif
+}
+
+/** @brief Waits until the save thread has written everything, before the archives are read or written directly. */
+void WaitForQueuedSaves()
+{
+	DVL_TRACE_ZONE("WaitForQueuedSaves");
+	if (!SaveQueue)
+		return;
+
+	const std::lock_guard<SdlMutex> lock(SaveQueue->mutex);
+	while (!SaveQueue->saves.empty() || SaveQueue->writing)
+		SaveQueue->idle.wait(SaveQueue->mutex);
+}
+
 bool ReadHero(SaveReader &archive, PlayerPack *pPack)
 {
 	size_t read;
@@ -150,29 +318,33 @@ bool ReadHero(SaveReader &archive, PlayerPack *pPack)
 	return ret;
 }
 
-void EncodeHero(SaveWriter &saveWriter, const PlayerPack *pack)
+void EncodeHero(SaveBatch &saveBatch, const PlayerPack *pack)
 {
 	const size_t packedLen = codec_get_encoded_len(sizeof(*pack));
-	const std::unique_ptr<std::byte[]> packed { new std::byte[packedLen] };
+	std::unique_ptr<std::byte[]> packed { new std::byte[packedLen] };
 
 	memcpy(packed.get(), pack, sizeof(*pack));
-	codec_encode(packed.get(), sizeof(*pack), packedLen, pfile_get_password());
-	saveWriter.WriteFile("hero", packed.get(), packedLen);
+	saveBatch.AddFile("hero", std::move(packed), sizeof(*pack));
 }
 
 SaveWriter GetSaveWriter(uint32_t saveNum)
 {
+	WaitForQueuedSaves();
+	WrittenFileHashes.clear();
 	return SaveWriter(GetSavePath(saveNum));
 }
 
 SaveWriter GetStashWriter()
 {
+	WaitForQueuedSaves();
+	WrittenFileHashes.clear();
 	return SaveWriter(GetStashSavePath());
 }
 
 #ifndef DISABLE_DEMOMODE
 void CopySaveFile(uint32_t saveNum, std::string targetPath)
 {
+	WaitForQueuedSaves();
 	const std::string savePath = GetSavePath(saveNum);
 #if defined(UNPACKED_SAVES)
 #ifdef DVL_NO_FILESYSTEM
@@ -226,32 +398,222 @@ bool GetFileName(uint8_t lvl, char *dst)
 	return false;
 }
 
-bool ArchiveContainsGame(SaveReader &hsArchive)
+/** @brief The magic number of the saved game, without validating it. Safe from any thread. */
+std::optional<uint32_t> ReadGameHeader(SaveReader &hsArchive)
 {
 	if (gbIsMultiplayer)
-		return false;
+		return std::nullopt;
 
-	auto gameData = ReadArchive(hsArchive, "game");
-	if (gameData == nullptr)
-		return false;
+	size_t size;
+	auto gameData = ReadArchive(hsArchive, "game", &size);
+	if (gameData == nullptr || size < sizeof(uint32_t))
+		return std::nullopt;
 
-	const uint32_t hdr = LoadLE32(gameData.get());
+	return LoadLE32(gameData.get());
+}
 
-	return IsHeaderValid(hdr);
+bool ArchiveContainsGame(SaveReader &hsArchive)
+{
+	const std::optional<uint32_t> hdr = ReadGameHeader(hsArchive);
+	return hdr && IsHeaderValid(*hdr);
 }
 
 std::optional<SaveReader> CreateSaveReader(std::string &&path)
 {
+	WaitForQueuedSaves();
 #ifdef UNPACKED_SAVES
 	if (!FileExists(path))
 		return std::nullopt;
 	return SaveReader(std::move(path));
 #else
+	RecoverInterruptedSave(path);
 	std::int32_t error;
 	return MpqArchive::Open(path.c_str(), error);
 #endif
 }
 
+/** What the hero selection screen shows of a hero, kept so the hero needn't be unpacked to list it. */
+struct HeroSummary {
+	/** Tells whether the save still has the hero the summary was made from, see GetHeroSummaryKey(). */
+	uint64_t key;
+	char heroName[PlayerNameLength];
+	_uiheroinfo info;
+};
+
+/** Magic, version and count, then the summaries, all little-endian. */
+constexpr std::array<char, 4> HeroIndexMagic { 'D', 'X', 'H', 'I' };
+constexpr uint32_t HeroIndexVersion = 0;
+constexpr size_t HeroIndexHeaderSize = 4 + 4 + 4;
+constexpr size_t HeroSummarySize = 1 + 8 + PlayerNameLength + sizeof(_uiheroinfo::name) + 3 + 4 * 2 + 1;
+
+/** @brief The hero index is stored next to the saves it summarizes, one per game mode. */
+std::string GetHeroIndexPath()
+{
+	return StrCat(paths::PrefPath(), GetSaveModePrefix(), "heroes", gbIsHellfire ? ".hidx" : ".idx");
+}
+
+struct HeroIndexFileCloser {
+	void operator()(FILE *file) const
+	{
+		std::fclose(file);
+	}
+};
+
+using HeroIndexFile = std::unique_ptr<FILE, HeroIndexFileCloser>;
+
+/** @brief Reads the summaries by save number, empty if there is no valid index. */
+std::array<std::optional<HeroSummary>, MAX_CHARACTERS> LoadHeroIndex()
+{
+	std::array<std::optional<HeroSummary>, MAX_CHARACTERS> summaries;
+	const std::string path = GetHeroIndexPath();
+	const HeroIndexFile file { OpenFile(path.c_str(), "rb") };
+	if (file == nullptr)
+		return summaries;
+
+	std::array<uint8_t, HeroIndexHeaderSize> header;
+	if (std::fread(header.data(), header.size(), 1, file.get()) != 1
+	    || std::memcmp(header.data(), HeroIndexMagic.data(), HeroIndexMagic.size()) != 0
+	    || LoadLE32(&header[4]) != HeroIndexVersion)
+		return summaries;
+
+	const uint32_t count = LoadLE32(&header[8]);
+	for (uint32_t i = 0; i < count; i++) {
+		std::array<uint8_t, HeroSummarySize> entry;
+		if (std::fread(entry.data(), entry.size(), 1, file.get()) != 1)
+			return {};
+		const uint8_t saveNumber = entry[0];
+		if (saveNumber >= MAX_CHARACTERS)
+			return {};
+
+		HeroSummary summary {};
+		const uint8_t *src = &entry[1];
+		summary.key = static_cast<uint64_t>(LoadLE32(src)) | (static_cast<uint64_t>(LoadLE32(src + 4)) << 32);
+		src += 8;
+		std::memcpy(summary.heroName, src, PlayerNameLength);
+		summary.heroName[PlayerNameLength - 1] = '\0';
+		src += PlayerNameLength;
+		std::memcpy(summary.info.name, src, sizeof(summary.info.name));
+		summary.info.name[sizeof(summary.info.name) - 1] = '\0';
+		src += sizeof(summary.info.name);
+		summary.info.saveNumber = saveNumber;
+		summary.info.level = *src++;
+		summary.info.heroclass = static_cast<HeroClass>(*src++);
+		summary.info.herorank = *src++;
+		for (uint16_t *stat : { &summary.info.strength, &summary.info.magic, &summary.info.dexterity, &summary.info.vitality }) {
+			*stat = LoadLE16(src);
+			src += 2;
+		}
+		summary.info.hassaved = *src != 0;
+		summary.info.spawned = gbIsSpawn;
+		summaries[saveNumber] = summary;
+	}
+	return summaries;
+}
+
+/** @brief Replaces the index with the given summaries, failing quietly. */
+void StoreHeroIndex(const std::array<std::optional<HeroSummary>, MAX_CHARACTERS> &summaries)
+{
+	std::vector<uint8_t> data(HeroIndexHeaderSize);
+	std::memcpy(data.data(), HeroIndexMagic.data(), HeroIndexMagic.size());
+	WriteLE32(&data[4], HeroIndexVersion);
+	uint32_t count = 0;
+	for (const std::optional<HeroSummary> &summary : summaries) {
+		if (!summary)
+			continue;
+		count++;
+		const size_t offset = data.size();
+		data.resize(offset + HeroSummarySize);
+		uint8_t *dst = &data[offset];
+		*dst++ = static_cast<uint8_t>(summary->info.saveNumber);
+		WriteLE32(dst, static_cast<uint32_t>(summary->key));
+		WriteLE32(dst + 4, static_cast<uint32_t>(summary->key >> 32));
+		dst += 8;
+		std::memcpy(dst, summary->heroName, PlayerNameLength);
+		dst += PlayerNameLength;
+		std::memcpy(dst, summary->info.name, sizeof(summary->info.name));
+		dst += sizeof(summary->info.name);
+		*dst++ = summary->info.level;
+		*dst++ = static_cast<uint8_t>(summary->info.heroclass);
+		*dst++ = summary->info.herorank;
+		for (const uint16_t stat : { summary->info.strength, summary->info.magic, summary->info.dexterity, summary->info.vitality }) {
+			WriteLE16(dst, stat);
+			dst += 2;
+		}
+		*dst = summary->info.hassaved ? 1 : 0;
+	}
+	WriteLE32(&data[8], count);
+
+	// Written under a temporary name first, so a crash never leaves a truncated index behind.
+	const std::string path = GetHeroIndexPath();
+	const std::string tempPath = StrCat(path, ".tmp");
+	{
+		const HeroIndexFile file { OpenFile(tempPath.c_str(), "wb") };
+		if (file == nullptr || std::fwrite(data.data(), data.size(), 1, file.get()) != 1) {
+			LogVerbose("Failed to write the hero index: {}", tempPath);
+			return;
+		}
+	}
+	if (FileExists(path.c_str()))
+		RemoveFile(path.c_str());
+	RenameFile(tempPath.c_str(), path.c_str());
+}
+
+/**
+ * @brief Identifies everything a hero's summary is made from: the hero, its items, and the saved game.
+ * @return 0 if the save can't be told apart from other versions of itself, so it is never summarized
+ */
+uint64_t GetHeroSummaryKey(uint32_t saveNum, SaveReader &archive, const PlayerPack &pack)
+{
+	uint64_t key = Fnv1a(HeroIndexVersion, Fnv1aOffsetBasis);
+	key = Fnv1a(std::as_bytes(std::span { &pack, 1 }), key);
+	size_t itemsSize;
+	if (const std::unique_ptr<std::byte[]> items = ReadArchive(archive, "heroitems", &itemsSize); items != nullptr)
+		key = Fnv1a(std::span<const std::byte> { items.get(), itemsSize }, key);
+#ifdef UNPACKED_SAVES
+	uintmax_t gameSize = 0;
+	if (archive.HasFile("game") && !GetFileSize((archive.dir() + "game").c_str(), &gameSize))
+		return 0;
+	key = Fnv1a(static_cast<uint64_t>(gameSize), key);
+	(void)saveNum;
+#else
+	// The block table has the size of the saved game, which tells a Diablo from a Hellfire one.
+	if (archive.Fingerprint() == 0)
+		return 0;
+	key = Fnv1a(archive.Fingerprint(), key);
+	uintmax_t fileSize;
+	if (!GetFileSize(GetSavePath(saveNum).c_str(), &fileSize))
+		return 0;
+	key = Fnv1a(static_cast<uint64_t>(fileSize), key);
+#endif
+	return key != 0 ? key : 1;
+}
+
+/** A hero read from its save without touching any global state, so heroes can be read in parallel. */
+struct ScannedHero {
+	PlayerPack pack;
+	uint64_t key;
+	/** Set if the index has a summary with the same key. */
+	std::optional<HeroSummary> summary;
+	/** The saved game's magic number, only read if there is no summary. */
+	std::optional<uint32_t> gameHeader;
+};
+
+std::optional<ScannedHero> ScanHero(uint32_t saveNum, const std::optional<HeroSummary> &indexed)
+{
+	std::optional<SaveReader> archive = OpenSaveArchive(saveNum);
+	if (!archive)
+		return std::nullopt;
+	ScannedHero hero;
+	if (!ReadHero(*archive, &hero.pack))
+		return std::nullopt;
+	hero.key = GetHeroSummaryKey(saveNum, *archive, hero.pack);
+	if (hero.key != 0 && indexed && indexed->key == hero.key)
+		hero.summary = indexed;
+	else
+		hero.gameHeader = ReadGameHeader(*archive);
+	return hero;
+}
+
 #ifndef DISABLE_DEMOMODE
 struct CompareInfo {
 	std::unique_ptr<std::byte[]> &data;
@@ -284,23 +646,33 @@ inline bool string_ends_with(std::string_view value, std::string_view suffix)
 	return std::equal(suffix.rbegin(), suffix.rend(), value.rbegin());
 }
 
-void CreateDetailDiffs(std::string_view prefix, std::string_view memoryMapFile, CompareInfo &compareInfoReference, CompareInfo &compareInfoActual, ankerl::unordered_dense::segmented_map<std::string, size_t> &foundDiffs)
+/** Memory map files by name. A segmented map, so the contents stay put while nested maps are added. */
+using MemoryMapCache = ankerl::unordered_dense::segmented_map<std::string, std::string>;
+
+/** @brief The contents of a memory map file, only read the first time a structure is compared. */
+std::string_view GetMemoryMap(std::string_view memoryMapFile, MemoryMapCache &memoryMaps)
 {
+	std::string name { memoryMapFile };
+	if (const auto it = memoryMaps.find(name); it != memoryMaps.end())
+		return it->second;
+
 	// Note: Detail diffs are currently only supported in unit tests
 	const std::string memoryMapFileAssetName = StrCat(paths::BasePath(), "/test/fixtures/memory_map/", memoryMapFile, ".txt");
 
 	SDL_IOStream *handle = SDL_IOFromFile(memoryMapFileAssetName.c_str(), "r");
-	if (handle == nullptr) {
+	if (handle == nullptr)
 		app_fatal(StrCat("MemoryMapFile ", memoryMapFile, " is missing"));
-		return;
-	}
 
-	const size_t readBytes = static_cast<size_t>(SDL_GetIOSize(handle));
-	const std::unique_ptr<std::byte[]> memoryMapFileData { new std::byte[readBytes] };
-	SDL_ReadIO(handle, memoryMapFileData.get(), readBytes);
+	std::string contents(static_cast<size_t>(SDL_GetIOSize(handle)), '\0');
+	SDL_ReadIO(handle, contents.data(), contents.size());
 	SDL_CloseIO(handle);
 
-	const std::string_view buffer(reinterpret_cast<const char *>(memoryMapFileData.get()), readBytes);
+	return memoryMaps.insert_or_assign(std::move(name), std::move(contents)).first->second;
+}
+
+void CreateDetailDiffs(std::string_view prefix, std::string_view memoryMapFile, CompareInfo &compareInfoReference, CompareInfo &compareInfoActual, ankerl::unordered_dense::segmented_map<std::string, size_t> &foundDiffs, MemoryMapCache &memoryMaps)
+{
+	const std::string_view buffer = GetMemoryMap(memoryMapFile, memoryMaps);
 
 	ankerl::unordered_dense::segmented_map<std::string, CompareCounter> counter;
 
@@ -439,7 +811,7 @@ void CreateDetailDiffs(std::string_view prefix, std::string_view memoryMapFile,
 			for (int i = 0; i < count.max(); i++) {
 				count.checkIfDataExists(i, compareInfoReference, compareInfoActual);
 				const std::string subPrefix = StrCat(prefix, ".", comment);
-				CreateDetailDiffs(subPrefix, subMemoryMapFile, compareInfoReference, compareInfoActual, foundDiffs);
+				CreateDetailDiffs(subPrefix, subMemoryMapFile, compareInfoReference, compareInfoActual, foundDiffs, memoryMaps);
 			}
 		}
 
@@ -454,6 +826,43 @@ struct CompareTargets {
 	bool isTownLevel;
 };
 
+/**
+ * @brief Compares one file of two saves.
+ * @return Why the files differ, nullopt if they are the same
+ */
+std::optional<std::string> CompareSaveFile(SaveReader &actualArchive, SaveReader &referenceArchive, const CompareTargets &compareTarget, bool logDetails, MemoryMapCache &memoryMaps)
+{
+	size_t fileSizeActual = 0;
+	auto fileDataActual = ReadArchive(actualArchive, compareTarget.fileName.c_str(), &fileSizeActual);
+	size_t fileSizeReference = 0;
+	auto fileDataReference = ReadArchive(referenceArchive, compareTarget.fileName.c_str(), &fileSizeReference);
+	if (fileDataActual.get() == nullptr && fileDataReference.get() == nullptr)
+		return std::nullopt;
+	// Most files match, and comparing the bytes is far cheaper than walking their memory map.
+	if (fileSizeActual == fileSizeReference && memcmp(fileDataReference.get(), fileDataActual.get(), fileSizeActual) == 0)
+		return std::nullopt;
+
+	std::string message;
+	if (fileSizeActual != fileSizeReference)
+		StrAppend(message, "file \"", compareTarget.fileName, "\" is different size. Expected: ", fileSizeReference, " Actual: ", fileSizeActual);
+	else
+		StrAppend(message, "file \"", compareTarget.fileName, "\" has different content.");
+	if (!logDetails)
+		return message;
+	ankerl::unordered_dense::segmented_map<std::string, size_t> foundDiffs;
+	CompareInfo compareInfoReference = { fileDataReference, 0, fileSizeReference, compareTarget.isTownLevel, fileSizeReference != 0 };
+	CompareInfo compareInfoActual = { fileDataActual, 0, fileSizeActual, compareTarget.isTownLevel, fileSizeActual != 0 };
+	CreateDetailDiffs(compareTarget.fileName, compareTarget.memoryMapFileName, compareInfoReference, compareInfoActual, foundDiffs, memoryMaps);
+	if (compareInfoReference.currentPosition != fileSizeReference)
+		app_fatal(StrCat("Comparison failed. Uncompared bytes in reference. File: ", compareTarget.fileName));
+	if (compareInfoActual.currentPosition != fileSizeActual)
+		app_fatal(StrCat("Comparison failed. Uncompared bytes in actual. File: ", compareTarget.fileName));
+	for (const auto &[location, count] : foundDiffs) {
+		StrAppend(message, "\nDiff found in ", location, " count: ", count);
+	}
+	return message;
+}
+
 HeroCompareResult CompareSaves(const std::string &actualSavePath, const std::string &referenceSavePath, bool logDetails)
 {
 	std::vector<CompareTargets> possibleFileToCheck;
@@ -465,60 +874,47 @@ HeroCompareResult CompareSaves(const std::string &actualSavePath, const std::str
 		possibleFileToCheck.push_back({ std::string(szPerm), "level", i == 0 });
 	}
 
-	SaveReader actualArchive = *CreateSaveReader(std::string(actualSavePath));
-	SaveReader referenceArchive = *CreateSaveReader(std::string(referenceSavePath));
+	// Each thread opens the saves itself, as an archive can't be read from two threads at once,
+	// then takes the next file to compare until there are none left.
+	std::vector<std::optional<std::string>> differences(possibleFileToCheck.size());
+	std::atomic<size_t> nextFile = 0;
+	const int threads = std::min(GetRenderThreadCount(), static_cast<int>(possibleFileToCheck.size()));
+	RunRenderBands(threads, [&](int) {
+		SaveReader actualArchive = *CreateSaveReader(std::string(actualSavePath));
+		SaveReader referenceArchive = *CreateSaveReader(std::string(referenceSavePath));
+		MemoryMapCache memoryMaps;
+		for (size_t i = nextFile++; i < possibleFileToCheck.size(); i = nextFile++)
+			differences[i] = CompareSaveFile(actualArchive, referenceArchive, possibleFileToCheck[i], logDetails, memoryMaps);
+	});
 
 	bool compareResult = true;
 	std::string message;
-	for (const auto &compareTarget : possibleFileToCheck) {
-		size_t fileSizeActual = 0;
-		auto fileDataActual = ReadArchive(actualArchive, compareTarget.fileName.c_str(), &fileSizeActual);
-		size_t fileSizeReference = 0;
-		auto fileDataReference = ReadArchive(referenceArchive, compareTarget.fileName.c_str(), &fileSizeReference);
-		if (fileDataActual.get() == nullptr && fileDataReference.get() == nullptr) {
-			continue;
-		}
-		if (fileSizeActual == fileSizeReference && memcmp(fileDataReference.get(), fileDataActual.get(), fileSizeActual) == 0)
+	for (const std::optional<std::string> &difference : differences) {
+		if (!difference)
 			continue;
 		compareResult = false;
 		if (!message.empty())
 			message.append("\n");
-		if (fileSizeActual != fileSizeReference)
-			StrAppend(message, "file \"", compareTarget.fileName, "\" is different size. Expected: ", fileSizeReference, " Actual: ", fileSizeActual);
-		else
-			StrAppend(message, "file \"", compareTarget.fileName, "\" has different content.");
-		if (!logDetails)
-			continue;
-		ankerl::unordered_dense::segmented_map<std::string, size_t> foundDiffs;
-		CompareInfo compareInfoReference = { fileDataReference, 0, fileSizeReference, compareTarget.isTownLevel, fileSizeReference != 0 };
-		CompareInfo compareInfoActual = { fileDataActual, 0, fileSizeActual, compareTarget.isTownLevel, fileSizeActual != 0 };
-		CreateDetailDiffs(compareTarget.fileName, compareTarget.memoryMapFileName, compareInfoReference, compareInfoActual, foundDiffs);
-		if (compareInfoReference.currentPosition != fileSizeReference)
-			app_fatal(StrCat("Comparison failed. Uncompared bytes in reference. File: ", compareTarget.fileName));
-		if (compareInfoActual.currentPosition != fileSizeActual)
-			app_fatal(StrCat("Comparison failed. Uncompared bytes in actual. File: ", compareTarget.fileName));
-		for (const auto &[location, count] : foundDiffs) {
-			StrAppend(message, "\nDiff found in ", location, " count: ", count);
-		}
+		message.append(*difference);
 	}
 	return { compareResult ? HeroCompareResult::Same : HeroCompareResult::Difference, message };
 }
 #endif // !DISABLE_DEMOMODE
 
-void pfile_write_hero(SaveWriter &saveWriter, bool writeGameData)
+void pfile_write_hero(SaveBatch &saveBatch, bool writeGameData)
 {
 	if (writeGameData) {
-		SaveGameData(saveWriter);
-		RenameTempToPerm(saveWriter);
+		SaveGameData(saveBatch);
+		saveBatch.RenameTempToPerm();
 	}
 	PlayerPack pkplr;
 	Player &myPlayer = *MyPlayer;
 
 	PackPlayer(pkplr, myPlayer);
-	EncodeHero(saveWriter, &pkplr);
+	EncodeHero(saveBatch, &pkplr);
 	if (!gbVanilla) {
-		SaveHotkeys(saveWriter, myPlayer);
-		SaveHeroItems(saveWriter, myPlayer);
+		SaveHotkeys(saveBatch, myPlayer);
+		SaveHeroItems(saveBatch, myPlayer);
 	}
 }
 
@@ -587,6 +983,56 @@ void SaveWriter::RemoveHashEntries(bool (*fnGetName)(uint8_t, char *))
 }
 #endif
 
+void SaveBatch::AddFile(std::string_view name, std::unique_ptr<std::byte[]> data, size_t size)
+{
+	files_.push_back(File { std::string(name), std::move(data), size });
+}
+
+uint64_t SaveBatch::File::Hash()
+{
+	if (!hash)
+		hash = Fnv1a({ data.get(), size });
+	return *hash;
+}
+
+void SaveBatch::DropUnchangedFiles(const SaveFileHashes &hashes)
+{
+	std::erase_if(files_, [&hashes](File &file) {
+		const auto it = hashes.find(file.name);
+		return it != hashes.end() && it->second == file.Hash();
+	});
+}
+
+bool SaveBatch::Write(SaveWriter &saveWriter, const char *password, SaveFileHashes *hashes)
+{
+	bool allWritten = true;
+	saveWriter.BeginFiles();
+	for (File &file : files_) {
+		// Hashed before encoding, which happens in place.
+		const uint64_t hash = hashes != nullptr ? file.Hash() : 0;
+		const size_t encodedLen = codec_get_encoded_len(file.size);
+		codec_encode(file.data.get(), file.size, encodedLen, password);
+		const bool written = saveWriter.WriteFile(file.name.c_str(), file.data.get(), encodedLen);
+		allWritten = allWritten && written;
+		if (hashes == nullptr)
+			continue;
+		if (written)
+			(*hashes)[file.name] = hash;
+		else
+			hashes->erase(file.name);
+	}
+	if (renameTempToPerm_)
+		::devilution::RenameTempToPerm(saveWriter, hashes);
+	const bool committed = saveWriter.CommitFiles();
+	if (!committed && hashes != nullptr) {
+		// Not knowing which files made it, write all of them next time.
+		hashes->clear();
+	}
+	files_.clear();
+	renameTempToPerm_ = false;
+	return allWritten && committed;
+}
+
 std::optional<SaveReader> OpenSaveArchive(uint32_t saveNum)
 {
 	return CreateSaveReader(GetSavePath(saveNum));
@@ -625,8 +1071,10 @@ const char *pfile_get_password()
 
 void pfile_write_hero(bool writeGameData)
 {
-	SaveWriter saveWriter = GetSaveWriter(gSaveNumber);
-	pfile_write_hero(saveWriter, writeGameData);
+	DVL_TRACE_ZONE("pfile_write_hero");
+	SaveBatch saveBatch;
+	pfile_write_hero(saveBatch, writeGameData);
+	QueueSave(GetSavePath(gSaveNumber), std::move(saveBatch));
 }
 
 #ifndef DISABLE_DEMOMODE
@@ -635,7 +1083,9 @@ void pfile_write_hero_demo(int demo)
 	const std::string savePath = GetSavePath(gSaveNumber, StrCat("demo_", demo, "_reference_"));
 	CopySaveFile(gSaveNumber, savePath);
 	auto saveWriter = SaveWriter(savePath.c_str());
-	pfile_write_hero(saveWriter, true);
+	SaveBatch saveBatch;
+	pfile_write_hero(saveBatch, true);
+	saveBatch.Write(saveWriter, pfile_get_password());
 }
 
 HeroCompareResult pfile_compare_hero_demo(int demo, bool logDetails)
@@ -649,7 +1099,9 @@ HeroCompareResult pfile_compare_hero_demo(int demo, bool logDetails)
 	{
 		CopySaveFile(gSaveNumber, actualSavePath);
 		SaveWriter saveWriter(actualSavePath.c_str());
-		pfile_write_hero(saveWriter, true);
+		SaveBatch saveBatch;
+		pfile_write_hero(saveBatch, true);
+		saveBatch.Write(saveWriter, pfile_get_password());
 	}
 
 	return CompareSaves(actualSavePath, referenceSavePath, logDetails);
@@ -661,9 +1113,9 @@ void sfile_write_stash()
 	if (!Stash.dirty)
 		return;
 
-	SaveWriter stashWriter = GetStashWriter();
-
-	SaveStash(stashWriter);
+	SaveBatch stashBatch;
+	SaveStash(stashBatch);
+	QueueSave(GetStashSavePath(), std::move(stashBatch));
 
 	Stash.dirty = false;
 }
@@ -672,31 +1124,55 @@ bool pfile_ui_set_hero_infos(bool (*uiAddHeroInfo)(_uiheroinfo *))
 {
 	memset(hero_names, 0, sizeof(hero_names));
 
+	WaitForQueuedSaves();
+	const std::array<std::optional<HeroSummary>, MAX_CHARACTERS> indexed = LoadHeroIndex();
+
+	// Opening the archives and decoding the heroes is most of the work, and touches no globals.
+	std::array<std::optional<ScannedHero>, MAX_CHARACTERS> heroes;
+	RunRenderBands(MAX_CHARACTERS, [&](int i) {
+		heroes[i] = ScanHero(static_cast<uint32_t>(i), indexed[i]);
+	});
+
+	std::array<std::optional<HeroSummary>, MAX_CHARACTERS> summaries;
+	bool indexChanged = false;
 	for (uint32_t i = 0; i < MAX_CHARACTERS; i++) {
-		std::optional<SaveReader> archive = OpenSaveArchive(i);
-		if (archive) {
-			PlayerPack pkplr;
-			if (ReadHero(*archive, &pkplr)) {
-				_uiheroinfo uihero;
-				uihero.saveNumber = i;
-				strcpy(hero_names[i], pkplr.pName);
-				const bool hasSaveGame = ArchiveContainsGame(*archive);
-				if (hasSaveGame)
-					pkplr.bIsHellfire = gbIsHellfireSaveGame ? 1 : 0;
-
-				Player &player = Players[0];
-
-				UnPackPlayer(pkplr, player);
-				LoadHeroItems(player);
-				RemoveAllInvalidItems(player);
-				CalcPlrInv(player, false);
-
-				Game2UiPlayer(player, &uihero, hasSaveGame);
-				uiAddHeroInfo(&uihero);
-			}
+		std::optional<ScannedHero> &hero = heroes[i];
+		if (!hero) {
+			indexChanged = indexChanged || indexed[i].has_value();
+			continue;
 		}
+		PlayerPack &pkplr = hero->pack;
+		if (!hero->summary) {
+			// Only heroes that changed since the index was written are unpacked.
+			HeroSummary summary { .key = hero->key };
+			summary.info.saveNumber = i;
+			CopyUtf8(summary.heroName, pkplr.pName, sizeof(summary.heroName));
+			const bool hasSaveGame = hero->gameHeader && IsHeaderValid(*hero->gameHeader);
+			if (hasSaveGame)
+				pkplr.bIsHellfire = gbIsHellfireSaveGame ? 1 : 0;
+
+			Player &player = Players[0];
+
+			UnPackPlayer(pkplr, player);
+			LoadHeroItems(player);
+			RemoveAllInvalidItems(player);
+			CalcPlrInv(player, false);
+
+			Game2UiPlayer(player, &summary.info, hasSaveGame);
+			hero->summary = summary;
+			indexChanged = true;
+		}
+
+		strcpy(hero_names[i], hero->summary->heroName);
+		_uiheroinfo uihero = hero->summary->info;
+		uiAddHeroInfo(&uihero);
+		if (hero->key != 0)
+			summaries[i] = hero->summary;
 	}
 
+	if (indexChanged)
+		StoreHeroIndex(summaries);
+
 	return true;
 }
 
@@ -738,12 +1214,14 @@ bool pfile_ui_save_create(_uiheroinfo *heroinfo)
 	CreatePlayer(player, heroinfo->heroclass);
 	CopyUtf8(player._pName, heroinfo->name, PlayerNameLength);
 	PackPlayer(pkplr, player);
-	EncodeHero(saveWriter, &pkplr);
+	SaveBatch saveBatch;
+	EncodeHero(saveBatch, &pkplr);
 	Game2UiPlayer(player, heroinfo, false);
 	if (!gbVanilla) {
-		SaveHotkeys(saveWriter, player);
-		SaveHeroItems(saveWriter, player);
+		SaveHotkeys(saveBatch, player);
+		SaveHeroItems(saveBatch, player);
 	}
+	saveBatch.Write(saveWriter, pfile_get_password());
 
 	return true;
 }
@@ -753,6 +1231,8 @@ bool pfile_delete_save(_uiheroinfo *heroInfo)
 	const uint32_t saveNum = heroInfo->saveNumber;
 	if (saveNum < MAX_CHARACTERS) {
 		hero_names[saveNum][0] = '\0';
+		WaitForQueuedSaves();
+		WrittenFileHashes.clear();
 		RemoveFile(GetSavePath(saveNum).c_str());
 	}
 	return true;
@@ -781,8 +1261,9 @@ void pfile_read_player_from_save(uint32_t saveNum, Player &player)
 
 void pfile_save_level()
 {
-	SaveWriter saveWriter = GetSaveWriter(gSaveNumber);
-	SaveLevel(saveWriter);
+	SaveBatch saveBatch;
+	SaveLevel(saveBatch);
+	QueueSave(GetSavePath(gSaveNumber), std::move(saveBatch));
 }
 
 tl::expected<void, std::string> pfile_convert_levels()
@@ -816,4 +1297,20 @@ void pfile_update(bool forceSave)
 	sfile_write_stash();
 }
 
+void pfile_finish_writes()
+{
+	if (!SaveQueue)
+		return;
+
+	if (SaveThread.joinable()) {
+		{
+			const std::lock_guard<SdlMutex> lock(SaveQueue->mutex);
+			SaveQueue->stop = true;
+		}
+		SaveQueue->wakeUp.signal();
+		SaveThread.join();
+	}
+	SaveQueue = std::nullopt;
+}
+
 } // namespace devilution
@@ -5,9 +5,15 @@
  */
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
+#include <memory>
+#include <optional>
 #include <string>
+#include <string_view>
+#include <vector>
 
+#include <ankerl/unordered_dense.h>
 #include <expected.hpp>
 
 #include "DiabloUI/diabloui.h"
@@ -74,6 +80,16 @@ struct SaveWriter {
 
 	void RemoveHashEntries(bool (*fnGetName)(uint8_t, char *));
 
+	// Each file is written on its own, so there is nothing to batch.
+	void BeginFiles()
+	{
+	}
+
+	bool CommitFiles()
+	{
+		return true;
+	}
+
 private:
 	std::string dir_;
 };
@@ -83,6 +99,53 @@ using SaveReader = MpqArchive;
 using SaveWriter = MpqWriter;
 #endif
 
+/** @brief Hashes of the plain contents of the files in a save archive, as they were last written. */
+using SaveFileHashes = ankerl::unordered_dense::map<std::string, uint64_t>;
+
+/**
+ * @brief The files of a save, serialized on the game thread to be encoded and written later.
+ */
+class SaveBatch {
+public:
+	/** @brief Adds a file, `data` holds `size` plain bytes and has room for codec_get_encoded_len(size). */
+	void AddFile(std::string_view name, std::unique_ptr<std::byte[]> data, size_t size);
+
+	/** @brief Renames the temporary levels to permanent ones once the files are written. */
+	void RenameTempToPerm()
+	{
+		renameTempToPerm_ = true;
+	}
+
+	/** @brief Leaves out the files that are the same as when they were last written. */
+	void DropUnchangedFiles(const SaveFileHashes &hashes);
+
+	/** @brief Whether writing the batch would change the archive. */
+	[[nodiscard]] bool empty() const
+	{
+		return files_.empty() && !renameTempToPerm_;
+	}
+
+	/**
+	 * @brief Encodes the files with `password` and writes them.
+	 * @param hashes If set, updated with the files written and renamed
+	 * @return false if any of the files or the archive changes couldn't be written
+	 */
+	bool Write(SaveWriter &saveWriter, const char *password, SaveFileHashes *hashes = nullptr);
+
+private:
+	struct File {
+		std::string name;
+		std::unique_ptr<std::byte[]> data;
+		size_t size;
+		std::optional<uint64_t> hash;
+
+		uint64_t Hash();
+	};
+
+	std::vector<File> files_;
+	bool renameTempToPerm_ = false;
+};
+
 /**
  * @brief Comparison result of pfile_compare_hero_demo
  */
@@ -100,6 +163,7 @@ std::optional<SaveReader> OpenSaveArchive(uint32_t saveNum);
 std::optional<SaveReader> OpenStashArchive();
 const char *pfile_get_password();
 std::unique_ptr<std::byte[]> ReadArchive(SaveReader &archive, const char *pszName, size_t *pdwLen = nullptr);
+/** @brief Saves the hero, and the game if `writeGameData`, on the save thread. */
 void pfile_write_hero(bool writeGameData = false);
 
 #ifndef DISABLE_DEMOMODE
@@ -130,4 +194,7 @@ void pfile_remove_temp_files();
 std::unique_ptr<std::byte[]> pfile_read(const char *pszName, size_t *pdwLen);
 void pfile_update(bool forceSave);
 
+/** @brief Waits for the saves written in the background and stops the save thread. */
+void pfile_finish_writes();
+
 } // namespace devilution
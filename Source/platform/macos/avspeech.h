@@ -0,0 +1,19 @@
+#pragma once
+
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Returns a new AVSpeechSynthesizer, or NULL if it isn't available. */
+extern void *AVSpeechCreate();
+extern void AVSpeechDestroy(void *speech);
+extern void AVSpeechSpeak(void *speech, const char *text, bool interrupt);
+extern void AVSpeechStop(void *speech);
+/** Seconds from the last AVSpeechSpeak() until its utterance started, negative if it didn't yet. */
+extern double AVSpeechOutputLatency(void *speech);
+
+#ifdef __cplusplus
+}
+#endif
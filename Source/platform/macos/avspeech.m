@@ -0,0 +1,72 @@
+#import <AVFoundation/AVFoundation.h>
+
+#include "avspeech.h"
+
+@interface DevilutionXSpeech : NSObject <AVSpeechSynthesizerDelegate>
+@property (nonatomic, retain) AVSpeechSynthesizer *synthesizer;
+@property (atomic) CFAbsoluteTime lastSent;
+@property (atomic) double latency;
+@end
+
+@implementation DevilutionXSpeech
+
+- (void)speechSynthesizer:(AVSpeechSynthesizer *)synthesizer didStartSpeechUtterance:(AVSpeechUtterance *)utterance
+{
+	self.latency = CFAbsoluteTimeGetCurrent() - self.lastSent;
+}
+
+@end
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void *AVSpeechCreate()
+{
+	if (@available(macOS 10.14, *)) {
+		DevilutionXSpeech *speech = [[DevilutionXSpeech alloc] init];
+		speech.synthesizer = [[[AVSpeechSynthesizer alloc] init] autorelease];
+		speech.synthesizer.delegate = speech;
+		speech.latency = -1;
+		return speech;
+	}
+	return NULL;
+}
+
+void AVSpeechDestroy(void *speech)
+{
+	DevilutionXSpeech *instance = (DevilutionXSpeech *)speech;
+	[instance.synthesizer stopSpeakingAtBoundary:AVSpeechBoundaryImmediate];
+	instance.synthesizer.delegate = nil;
+	instance.synthesizer = nil;
+	[instance release];
+}
+
+void AVSpeechSpeak(void *speech, const char *text, bool interrupt)
+{
+	@autoreleasepool {
+		DevilutionXSpeech *instance = (DevilutionXSpeech *)speech;
+		if (interrupt)
+			[instance.synthesizer stopSpeakingAtBoundary:AVSpeechBoundaryImmediate];
+		NSString *string = [NSString stringWithUTF8String:text];
+		if (string == nil)
+			return;
+		instance.latency = -1;
+		instance.lastSent = CFAbsoluteTimeGetCurrent();
+		[instance.synthesizer speakUtterance:[AVSpeechUtterance speechUtteranceWithString:string]];
+	}
+}
+
+void AVSpeechStop(void *speech)
+{
+	[((DevilutionXSpeech *)speech).synthesizer stopSpeakingAtBoundary:AVSpeechBoundaryImmediate];
+}
+
+double AVSpeechOutputLatency(void *speech)
+{
+	return ((DevilutionXSpeech *)speech).latency;
+}
+
+#ifdef __cplusplus
+}
+#endif
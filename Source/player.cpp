@@ -68,6 +68,7 @@ Player *MyPlayer;
 std::vector<Player> Players;
 Player *InspectPlayer;
 bool MyPlayerIsDead;
+uint32_t MyPlayerEquipmentDurabilityGeneration;
 
 namespace {
 
@@ -452,7 +453,8 @@ bool WeaponDecay(Player &player, int ii)
 			CalcPlrInv(player, true);
 			return true;
 		}
-		CalcPlrInv(player, true);
+		// Only the damage bonus changed, which no item requirement or graphic depends on.
+		CalcPlrItemVals(player, false);
 	}
 	return false;
 }
@@ -471,6 +473,7 @@ bool DamageWeapon(Player &player, unsigned damageFrequency)
 	if (!FlipCoin(damageFrequency)) {
 		return false;
 	}
+	MyPlayerEquipmentDurabilityGeneration++;
 
 	if (!player.InvBody[INVLOC_HAND_LEFT].isEmpty() && player.InvBody[INVLOC_HAND_LEFT]._iClass == ICLASS_WEAPON) {
 		if (player.InvBody[INVLOC_HAND_LEFT]._iDurability == DUR_INDESTRUCTIBLE) {
@@ -923,6 +926,7 @@ void DamageParryItem(Player &player)
 	if (&player != MyPlayer) {
 		return;
 	}
+	MyPlayerEquipmentDurabilityGeneration++;
 
 	if (player.InvBody[INVLOC_HAND_LEFT]._itype == ItemType::Shield || player.InvBody[INVLOC_HAND_LEFT]._itype == ItemType::Staff) {
 		if (player.InvBody[INVLOC_HAND_LEFT]._iDurability == DUR_INDESTRUCTIBLE) {
@@ -991,6 +995,7 @@ void DamageArmor(Player &player)
 	}
 
 	pi->_iDurability--;
+	MyPlayerEquipmentDurabilityGeneration++;
 	if (pi->_iDurability != 0) {
 		return;
 	}
@@ -1936,7 +1941,7 @@ void Player::UpdatePreviewCelSprite(_cmd_id cmdId, Point point, uint16_t wParam1
 
 	if (minimalWalkDistance >= 0 && position.future != point) {
 		int8_t testWalkPath[MaxPathLengthPlayer];
-		const int steps = FindPath(CanStep, [this](Point tile) { return PosOkPlayer(*this, tile); }, position.future, point, testWalkPath, MaxPathLengthPlayer);
+		const int steps = FindPath([](Point from, Point to) { return CanStep(from, to); }, [this](Point tile) { return PosOkPlayer(*this, tile); }, position.future, point, testWalkPath, MaxPathLengthPlayer);
 		if (steps == 0) {
 			// Can't walk to desired location => stand still
 			return;
@@ -2017,6 +2022,7 @@ void Player::occupyTile(Point tilePosition, bool isMoving) const
 	int16_t id = this->getId();
 	id += 1;
 	dPlayer[tilePosition.x][tilePosition.y] = isMoving ? -id : id;
+	MarkMissileTarget(tilePosition);
 }
 
 bool Player::isLevelOwnedByLocalClient() const
@@ -3122,7 +3128,7 @@ void MakePlrPath(Player &player, Point targetPosition, bool endspace)
 		return;
 	}
 
-	int path = FindPath(CanStep, [&player](Point position) { return PosOkPlayer(player, position); }, player.position.future, targetPosition, player.walkpath, MaxPathLengthPlayer);
+	int path = FindPath([](Point from, Point to) { return CanStep(from, to); }, [&player](Point position) { return PosOkPlayer(player, position); }, player.position.future, targetPosition, player.walkpath, MaxPathLengthPlayer);
 	if (path == 0) {
 		return;
 	}
@@ -923,6 +923,8 @@ inline bool IsInspectingPlayer()
 	return MyPlayer != InspectPlayer;
 }
 extern bool MyPlayerIsDead;
+/** @brief Incremented whenever the durability of MyPlayer's equipment may have changed (wear, repairs, equipment changes...). */
+extern uint32_t MyPlayerEquipmentDurabilityGeneration;
 
 Player *PlayerAtPosition(Point position, bool ignoreMovingPlayers = false);
 
@@ -3,7 +3,11 @@
  *
  * Implementation of the in-game chat log.
  */
+#include <algorithm>
+#include <array>
+#include <cstdint>
 #include <ctime>
+#include <optional>
 #include <sstream>
 #include <string>
 #include <string_view>
@@ -24,6 +28,7 @@
 #include "minitext.h"
 #include "stores.h"
 #include "utils/language.h"
+#include "utils/screen_reader.hpp"
 #include "utils/str_cat.hpp"
 
 namespace devilution {
@@ -40,11 +45,32 @@ struct MultiColoredText {
 	std::vector<ColoredText> colors;
 };
 
+/** Lines kept in the log, the oldest ones are dropped first. */
+constexpr size_t MaxChatLogLines = 1024;
+
+/**
+ * @brief A message of the log, for reading it out without going through its wrapped lines.
+ *
+ * Every message has at least one line, so the messages whose lines are still kept fit in the same capacity.
+ */
+struct ChatLogMessage {
+	std::string spokenText;
+	/** Number of the message's first line, see ChatLogLinesAdded. */
+	size_t firstLine;
+};
+
 bool UnreadFlag = false;
 size_t SkipLines;
 unsigned int MessageCounter = 0;
 
-std::vector<MultiColoredText> ChatLogLines;
+/** Wrapped lines, a ring buffer that the next line is written to at `ChatLogLinesAdded % MaxChatLogLines`. */
+std::array<MultiColoredText, MaxChatLogLines> ChatLogLines;
+/** How many lines were ever added, the newest is `ChatLogLinesAdded - 1`. */
+size_t ChatLogLinesAdded = 0;
+/** Indexed by the message number modulo the capacity. */
+std::array<ChatLogMessage, MaxChatLogLines> ChatLogMessages;
+/** The message that was read out last, if the log was browsed by message. */
+std::optional<unsigned> SelectedMessage;
 
 constexpr int PaddingTop = 32;
 constexpr int PaddingLeft = 32;
@@ -87,6 +113,70 @@ int NumVisibleLines()
 	return (ContentsTextHeight() - 1) / LineHeight() + 1; // Ceil
 }
 
+size_t NumChatLogLines()
+{
+	return std::min(ChatLogLinesAdded, MaxChatLogLines);
+}
+
+size_t MaxSkipLines()
+{
+	const size_t numVisibleLines = NumVisibleLines();
+	return NumChatLogLines() > numVisibleLines ? NumChatLogLines() - numVisibleLines : 0;
+}
+
+void AddChatLogLine(MultiColoredText &&text)
+{
+	ChatLogLines[ChatLogLinesAdded % MaxChatLogLines] = std::move(text);
+	ChatLogLinesAdded++;
+}
+
+/** @brief The `i`-th line from the top of the log, the newest line is on top. */
+const MultiColoredText &ChatLogLineFromTop(size_t i)
+{
+	return ChatLogLines[(ChatLogLinesAdded - 1 - i) % MaxChatLogLines];
+}
+
+/** @brief Whether the first line of the message is still kept. */
+bool IsMessageInLog(unsigned message)
+{
+	if (message == 0 || message > MessageCounter || MessageCounter - message >= MaxChatLogLines)
+		return false;
+	return ChatLogMessages[message % MaxChatLogLines].firstLine + NumChatLogLines() >= ChatLogLinesAdded;
+}
+
+/** @brief The message whose first line is at the top of the view, or the one closest below. */
+std::optional<unsigned> MessageAtTopOfView()
+{
+	for (unsigned message = MessageCounter; IsMessageInLog(message); message--) {
+		const size_t lineFromTop = ChatLogLinesAdded - 1 - ChatLogMessages[message % MaxChatLogLines].firstLine;
+		if (lineFromTop >= SkipLines)
+			return message;
+	}
+	return std::nullopt;
+}
+
+void SelectMessage(unsigned message)
+{
+	SelectedMessage = message;
+	const ChatLogMessage &entry = ChatLogMessages[message % MaxChatLogLines];
+	SkipLines = std::min(ChatLogLinesAdded - 1 - entry.firstLine, MaxSkipLines());
+	SpeakText(entry.spokenText, /*force=*/true);
+}
+
+/** @brief Reads out the message `step` messages newer (or older, when negative) than the selected one. */
+void MoveMessageSelection(int step)
+{
+	std::optional<unsigned> message = SelectedMessage;
+	if (!message || !IsMessageInLog(*message)) {
+		message = MessageAtTopOfView();
+		if (!message)
+			return;
+	} else if (IsMessageInLog(*message + step)) {
+		*message += step;
+	}
+	SelectMessage(*message);
+}
+
 } // namespace
 
 bool ChatLogFlag = false;
@@ -110,6 +200,7 @@ void ToggleChatLog()
 		CancelCurrentDiabloMsg();
 		gamemenu_off();
 		SkipLines = 0;
+		SelectedMessage = std::nullopt;
 		ChatLogFlag = true;
 		doom_close();
 	}
@@ -123,9 +214,11 @@ void AddMessageToChatLog(std::string_view message, Player *player, UiFlags flags
 	std::string timestamp = localtimeResult != nullptr
 	    ? StrCat("[#", MessageCounter, "] ", LeftPad(localtimeResult->tm_hour, 2, '0'), ":", LeftPad(localtimeResult->tm_min, 2, '0'), ":", LeftPad(localtimeResult->tm_sec, 2, '0'))
 	    : StrCat("[#", MessageCounter, "] ");
-	const size_t oldSize = ChatLogLines.size();
+	const size_t oldSize = ChatLogLinesAdded;
+	ChatLogMessage &logMessage = ChatLogMessages[MessageCounter % MaxChatLogLines];
 	if (player == nullptr) {
-		ChatLogLines.emplace_back(MultiColoredText { "{0} {1}", { { timestamp, UiFlags::ColorRed }, { std::string(message), flags } } });
+		logMessage.spokenText = std::string(message);
+		AddChatLogLine(MultiColoredText { "{0} {1}", { { timestamp, UiFlags::ColorRed }, { std::string(message), flags } } });
 	} else {
 		std::string playerInfo = fmt::format(fmt::runtime(_("{:s} (lvl {:d}): ")), player->_pName, player->getCharacterLevel());
 		UiFlags nameColor = player == MyPlayer ? UiFlags::ColorWhitegold : UiFlags::ColorBlue;
@@ -138,16 +231,19 @@ void AddMessageToChatLog(std::string_view message, Player *player, UiFlags flags
 			lines.push_back(s);
 		}
 		for (int i = static_cast<int>(lines.size()) - 1; i >= 1; i--) {
-			ChatLogLines.emplace_back(MultiColoredText { lines[i], {} });
+			AddChatLogLine(MultiColoredText { lines[i], {} });
 		}
 		lines[0].erase(0, prefix.length());
-		ChatLogLines.emplace_back(MultiColoredText { "{0} - {1}{2}", { { timestamp, UiFlags::ColorRed }, { playerInfo, nameColor }, { lines[0], UiFlags::ColorWhite } } });
+		logMessage.spokenText = StrCat(playerInfo, message);
+		AddChatLogLine(MultiColoredText { "{0} - {1}{2}", { { timestamp, UiFlags::ColorRed }, { playerInfo, nameColor }, { lines[0], UiFlags::ColorWhite } } });
 	}
+	// The first line is added last, so that it is drawn above the rest of the message.
+	logMessage.firstLine = ChatLogLinesAdded - 1;
 
-	const size_t diff = ChatLogLines.size() - oldSize;
+	const size_t diff = ChatLogLinesAdded - oldSize;
 	// only autoscroll when on top of the log
 	if (SkipLines != 0) {
-		SkipLines += diff;
+		SkipLines = std::min(SkipLines + diff, MaxSkipLines());
 		UnreadFlag = true;
 	}
 }
@@ -186,9 +282,9 @@ void DrawChatLog(const Surface &out)
 	const int numLines = NumVisibleLines();
 	const int contentY = titleBottom + DividerLineMarginY() + ContentPaddingY();
 	for (int i = 0; i < numLines; i++) {
-		if (i + SkipLines >= ChatLogLines.size())
+		if (i + SkipLines >= NumChatLogLines())
 			break;
-		const MultiColoredText &text = ChatLogLines[ChatLogLines.size() - (i + SkipLines + 1)];
+		const MultiColoredText &text = ChatLogLineFromTop(i + SkipLines);
 		const std::string_view line = text.text;
 
 		std::vector<DrawStringFormatArg> args;
@@ -212,7 +308,7 @@ void ChatLogScrollUp()
 
 void ChatLogScrollDown()
 {
-	if (SkipLines + NumVisibleLines() < ChatLogLines.size())
+	if (SkipLines + NumVisibleLines() < NumChatLogLines())
 		SkipLines++;
 }
 
@@ -223,7 +319,17 @@ void ChatLogScrollTop()
 
 void ChatLogScrollBottom()
 {
-	SkipLines = ChatLogLines.size() - NumVisibleLines();
+	SkipLines = MaxSkipLines();
+}
+
+void ChatLogPreviousMessage()
+{
+	MoveMessageSelection(-1);
+}
+
+void ChatLogNextMessage()
+{
+	MoveMessageSelection(+1);
 }
 
 } // namespace devilution
@@ -20,5 +20,9 @@ void ChatLogScrollUp();
 void ChatLogScrollDown();
 void ChatLogScrollTop();
 void ChatLogScrollBottom();
+/** @brief Scrolls to the message before the one read out last, or the one at the top, and reads it out. */
+void ChatLogPreviousMessage();
+/** @brief Scrolls to the message after the one read out last, or the one at the top, and reads it out. */
+void ChatLogNextMessage();
 
 } // namespace devilution
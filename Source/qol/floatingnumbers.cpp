@@ -1,10 +1,11 @@
 #include "floatingnumbers.h"
 
+#include <algorithm>
+#include <array>
+#include <cstddef>
 #include <cstdint>
 #include <ctime>
-#include <deque>
-#include <fmt/format.h>
-#include <string>
+#include <string_view>
 
 #ifdef USE_SDL3
 #include <SDL3/SDL_timer.h>
@@ -14,49 +15,71 @@
 
 #include "engine/render/text_render.hpp"
 #include "options.h"
-#include "utils/str_cat.hpp"
+#include "utils/static_vector.hpp"
+#include "utils/utf8.hpp"
 
 namespace devilution {
 
 namespace {
 
+/** Longer texts are cut off, damage numbers take only a few characters. */
+constexpr size_t MaxFloatingTextLength = 31;
+/** When this many numbers are shown the oldest one makes room for a new one. */
+constexpr size_t MaxFloatingNumbers = 256;
+constexpr uint32_t FloatingNumberDuration = 2500;
+
+GameFontTables GetGameFontSize(UiFlags flags)
+{
+	if (HasAnyOf(flags, UiFlags::FontSize30))
+		return GameFont30;
+	if (HasAnyOf(flags, UiFlags::FontSize24))
+		return GameFont24;
+	return GameFont12;
+}
+
 struct FloatingNumber {
 	Point startPos;
 	Displacement startOffset;
 	Displacement endOffset;
-	std::string text;
+	std::array<char, MaxFloatingTextLength> text;
+	uint8_t textLength;
+	/** Width of the text in pixels, measured once when the text is set. */
+	int lineWidth;
 	uint32_t time;
 	uint32_t lastMerge;
 	UiFlags style;
 	int id;
 	bool reverseDirection;
-};
-
-std::deque<FloatingNumber> FloatingQueue;
 
-void ClearExpiredNumbers()
-{
-	while (!FloatingQueue.empty()) {
-		const FloatingNumber &num = FloatingQueue.front();
-		if (num.time > SDL_GetTicks())
-			break;
+	[[nodiscard]] std::string_view Text() const
+	{
+		return { text.data(), textLength };
+	}
 
-		FloatingQueue.pop_front();
+	void SetText(std::string_view newText, UiFlags newStyle)
+	{
+		newText = TruncateUtf8(newText, text.size());
+		std::copy(newText.begin(), newText.end(), text.begin());
+		textLength = static_cast<uint8_t>(newText.size());
+		style = newStyle;
+		lineWidth = GetLineWidth(Text(), GetGameFontSize(style));
 	}
-}
+};
 
-GameFontTables GetGameFontSize(UiFlags flags)
+// Ordered by the time the numbers expire, as they all last as long.
+StaticVector<FloatingNumber, MaxFloatingNumbers> FloatingQueue;
+
+void ClearExpiredNumbers()
 {
-	if (HasAnyOf(flags, UiFlags::FontSize30))
-		return GameFont30;
-	if (HasAnyOf(flags, UiFlags::FontSize24))
-		return GameFont24;
-	return GameFont12;
+	const uint32_t now = SDL_GetTicks();
+	const FloatingNumber *firstLeft = std::find_if(FloatingQueue.begin(), FloatingQueue.end(),
+	    [now](const FloatingNumber &num) { return num.time > now; });
+	FloatingQueue.erase(FloatingQueue.begin(), firstLeft);
 }
 
 } // namespace
 
-void AddFloatingNumber(Point pos, Displacement offset, std::string text, UiFlags style, int id, bool reverseDirection)
+void AddFloatingNumber(Point pos, Displacement offset, std::string_view text, UiFlags style, int id, bool reverseDirection)
 {
 	Displacement endOffset;
 	if (!reverseDirection)
@@ -64,26 +87,31 @@ void AddFloatingNumber(Point pos, Displacement offset, std::string text, UiFlags
 	else
 		endOffset = { 0, 140 };
 
+	const uint32_t now = SDL_GetTicks();
 	for (auto &num : FloatingQueue) {
-		if (id != 0 && num.id == id && (SDL_GetTicks() - static_cast<int>(num.lastMerge)) <= 100) {
-			num.text = text;
-			num.lastMerge = SDL_GetTicks();
-			num.style = style;
+		if (id != 0 && num.id == id && now - num.lastMerge <= 100) {
+			num.SetText(text, style);
+			num.lastMerge = now;
 			num.startPos = pos;
 			return;
 		}
 	}
-	FloatingNumber num {
-		pos, offset, endOffset, text,
-		static_cast<uint32_t>(SDL_GetTicks() + 2500),
-		static_cast<uint32_t>(SDL_GetTicks()),
-		style | UiFlags::Outlined, id, reverseDirection
-	};
-	FloatingQueue.push_back(num);
+	if (FloatingQueue.size() == MaxFloatingNumbers)
+		FloatingQueue.erase(FloatingQueue.begin());
+	FloatingNumber &num = FloatingQueue.emplace_back();
+	num.startPos = pos;
+	num.startOffset = offset;
+	num.endOffset = endOffset;
+	num.SetText(text, style | UiFlags::Outlined);
+	num.time = now + FloatingNumberDuration;
+	num.lastMerge = now;
+	num.id = id;
+	num.reverseDirection = reverseDirection;
 }
 
 void DrawFloatingNumbers(const Surface &out, Point viewPosition, Displacement offset)
 {
+	const uint32_t now = SDL_GetTicks();
 	for (auto &floatingNum : FloatingQueue) {
 		Displacement worldOffset = viewPosition - floatingNum.startPos;
 		worldOffset = worldOffset.worldToScreen() + offset + Displacement { TILE_WIDTH / 2, -TILE_HEIGHT / 2 } + floatingNum.startOffset;
@@ -94,13 +122,12 @@ void DrawFloatingNumbers(const Surface &out, Point viewPosition, Displacement of
 
 		Point screenPosition { worldOffset.deltaX, worldOffset.deltaY };
 
-		const int lineWidth = GetLineWidth(floatingNum.text, GetGameFontSize(floatingNum.style));
-		screenPosition.x -= lineWidth / 2;
-		const uint32_t timeLeft = floatingNum.time - SDL_GetTicks();
-		const float mul = 1 - (timeLeft / 2500.0f);
+		screenPosition.x -= floatingNum.lineWidth / 2;
+		const uint32_t timeLeft = floatingNum.time - now;
+		const float mul = 1 - (timeLeft / static_cast<float>(FloatingNumberDuration));
 		screenPosition += floatingNum.endOffset * mul;
 
-		DrawString(out, floatingNum.text, Rectangle { screenPosition, { lineWidth, 0 } },
+		DrawString(out, floatingNum.Text(), Rectangle { screenPosition, { floatingNum.lineWidth, 0 } },
 		    { .flags = floatingNum.style });
 	}
 
@@ -5,7 +5,7 @@
  */
 #pragma once
 
-#include <string>
+#include <string_view>
 
 #include "DiabloUI/ui_flags.hpp"
 #include "engine/displacement.hpp"
@@ -14,7 +14,7 @@
 
 namespace devilution {
 
-void AddFloatingNumber(Point pos, Displacement offset, std::string text, UiFlags style, int id = 0, bool reverseDirection = false);
+void AddFloatingNumber(Point pos, Displacement offset, std::string_view text, UiFlags style, int id = 0, bool reverseDirection = false);
 void DrawFloatingNumbers(const Surface &out, Point viewPosition, Displacement offset);
 void ClearFloatingNumbers();
 
@@ -35,6 +35,18 @@ struct ItemLabel {
 
 std::vector<ItemLabel> labelQueue;
 
+/** Where a label was queued, before it was moved out of the way of the others. */
+struct QueuedLabelPlacement {
+	int id, width;
+	Point pos;
+
+	bool operator==(const QueuedLabelPlacement &) const = default;
+};
+
+// The labels only need to be moved apart again when items appear or disappear, or the view moves.
+std::vector<QueuedLabelPlacement> lastQueuedPlacements;
+std::vector<Point> lastResolvedPositions;
+
 bool highlightKeyPressed = false;
 bool isLabelHighlighted = false;
 std::array<std::optional<int>, ITEMTYPES> labelCenterOffsets;
@@ -75,6 +87,76 @@ private:
 	std::vector<int> data_;
 };
 
+[[nodiscard]] bool IsSameLayoutAsLastFrame()
+{
+	if (lastQueuedPlacements.size() != labelQueue.size())
+		return false;
+	for (size_t i = 0; i < labelQueue.size(); ++i) {
+		const ItemLabel &label = labelQueue[i];
+		if (lastQueuedPlacements[i] != QueuedLabelPlacement { label.id, label.width, label.pos })
+			return false;
+	}
+	return true;
+}
+
+/**
+ * @brief Moves every label sideways until it no longer overlaps the labels queued before it.
+ *
+ * Only labels in the same rows can overlap, so the others are found through a list sorted by y
+ * instead of checking every pair.
+ */
+void ResolveLabelOverlaps()
+{
+	const int labelHeight = LabelHeight();
+	const int rowDistance = labelHeight + BorderY;
+
+	std::vector<unsigned> byY(labelQueue.size());
+	for (unsigned i = 0; i < byY.size(); ++i)
+		byY[i] = i;
+	c_sort(byY, [](unsigned a, unsigned b) { return labelQueue[a].pos.y < labelQueue[b].pos.y; });
+
+	UsedX usedX;
+	std::vector<unsigned> neighbors;
+	for (unsigned i = 0; i < labelQueue.size(); ++i) {
+		ItemLabel &a = labelQueue[i];
+
+		// Labels before this one that are close enough vertically, in queue order.
+		neighbors.clear();
+		auto it = std::upper_bound(byY.begin(), byY.end(), a.pos.y - rowDistance,
+		    [](int y, unsigned index) { return y < labelQueue[index].pos.y; });
+		for (; it != byY.end() && labelQueue[*it].pos.y < a.pos.y + rowDistance; ++it) {
+			if (*it < i)
+				neighbors.push_back(*it);
+		}
+		c_sort(neighbors);
+
+		usedX.clear();
+		bool canShow;
+		do {
+			canShow = true;
+			for (const unsigned j : neighbors) {
+				const ItemLabel &b = labelQueue[j];
+				const int widthA = a.width + BorderX + MarginX * 2;
+				const int widthB = b.width + BorderX + MarginX * 2;
+				int newpos = b.pos.x;
+				if (b.pos.x >= a.pos.x && b.pos.x - a.pos.x < widthA) {
+					newpos -= widthA;
+					if (usedX.contains(newpos))
+						newpos = b.pos.x + widthB;
+				} else if (b.pos.x < a.pos.x && a.pos.x - b.pos.x < widthB) {
+					newpos += widthB;
+					if (usedX.contains(newpos))
+						newpos = b.pos.x - widthA;
+				} else
+					continue;
+				canShow = false;
+				a.pos.x = newpos;
+				usedX.insert(newpos);
+			}
+		} while (!canShow);
+	}
+}
+
 } // namespace
 
 void ToggleItemLabelHighlight()
@@ -151,39 +233,20 @@ void DrawItemNameLabels(const Surface &out)
 	isLabelHighlighted = false;
 	if (labelQueue.empty())
 		return;
-	UsedX usedX;
 	const int labelHeight = LabelHeight();
 	const int labelMarginTop = TextMarginTop();
 
-	for (unsigned i = 0; i < labelQueue.size(); ++i) {
-		usedX.clear();
-
-		bool canShow;
-		do {
-			canShow = true;
-			for (unsigned j = 0; j < i; ++j) {
-				ItemLabel &a = labelQueue[i];
-				const ItemLabel &b = labelQueue[j];
-				if (std::abs(b.pos.y - a.pos.y) < labelHeight + BorderY) {
-					const int widthA = a.width + BorderX + MarginX * 2;
-					const int widthB = b.width + BorderX + MarginX * 2;
-					int newpos = b.pos.x;
-					if (b.pos.x >= a.pos.x && b.pos.x - a.pos.x < widthA) {
-						newpos -= widthA;
-						if (usedX.contains(newpos))
-							newpos = b.pos.x + widthB;
-					} else if (b.pos.x < a.pos.x && a.pos.x - b.pos.x < widthB) {
-						newpos += widthB;
-						if (usedX.contains(newpos))
-							newpos = b.pos.x - widthA;
-					} else
-						continue;
-					canShow = false;
-					a.pos.x = newpos;
-					usedX.insert(newpos);
-				}
-			}
-		} while (!canShow);
+	if (IsSameLayoutAsLastFrame()) {
+		for (size_t i = 0; i < labelQueue.size(); ++i)
+			labelQueue[i].pos = lastResolvedPositions[i];
+	} else {
+		lastQueuedPlacements.clear();
+		for (const ItemLabel &label : labelQueue)
+			lastQueuedPlacements.push_back({ label.id, label.width, label.pos });
+		ResolveLabelOverlaps();
+		lastResolvedPositions.clear();
+		for (const ItemLabel &label : labelQueue)
+			lastResolvedPositions.push_back(label.pos);
 	}
 
 	for (const ItemLabel &label : labelQueue) {
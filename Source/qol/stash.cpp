@@ -1,6 +1,7 @@
 #include "qol/stash.h"
 
 #include <algorithm>
+#include <array>
 #include <cstdint>
 #include <utility>
 
@@ -77,6 +78,19 @@ void AddItemToStashGrid(unsigned page, Point position, uint16_t stashListIndex,
 	}
 }
 
+/**
+ * @brief The occupied cells of a stash page, bit x of each row being set when that column is taken.
+ */
+std::array<uint16_t, StashGridSize.height> GetStashOccupancy(const StashStruct::StashGrid &grid)
+{
+	std::array<uint16_t, StashGridSize.height> rows {};
+	for (const Point point : StashGridRange) {
+		if (grid[point.x][point.y] != 0)
+			rows[point.y] |= 1 << point.x;
+	}
+	return rows;
+}
+
 std::optional<Point> FindTargetSlotUnderItemCursor(Point cursorPosition, Size itemSize)
 {
 	for (auto point : StashGridRange) {
@@ -702,6 +716,7 @@ bool AutoPlaceItemInStash(Player &player, const Item &item, bool persistItem)
 	}
 
 	const Size itemSize = GetInventorySize(item);
+	const uint16_t itemRow = static_cast<uint16_t>((1 << itemSize.width) - 1);
 
 	// Try to add the item to the current active page and if it's not possible move forward
 	for (unsigned pageCounter = 0; pageCounter < CountStashPages; pageCounter++) {
@@ -709,13 +724,13 @@ bool AutoPlaceItemInStash(Player &player, const Item &item, bool persistItem)
 		// Wrap around if needed
 		if (pageIndex >= CountStashPages)
 			pageIndex -= CountStashPages;
+		const std::array<uint16_t, StashGridSize.height> occupied = GetStashOccupancy(Stash.stashGrids[pageIndex]);
 		// Search all possible position in stash grid
 		for (auto stashPosition : PointsInRectangle(Rectangle { { 0, 0 }, Size { 10 - (itemSize.width - 1), 10 - (itemSize.height - 1) } })) {
 			// Check that all needed slots are free
 			bool isSpaceFree = true;
-			for (auto itemPoint : PointsInRectangle(Rectangle { stashPosition, itemSize })) {
-				const uint16_t iv = Stash.stashGrids[pageIndex][itemPoint.x][itemPoint.y];
-				if (iv != 0) {
+			for (int y = stashPosition.y; y < stashPosition.y + itemSize.height; y++) {
+				if ((occupied[y] & (itemRow << stashPosition.x)) != 0) {
 					isSpaceFree = false;
 					break;
 				}
@@ -13,20 +13,41 @@ namespace {
 /**
  * Diablo-"SHA1" circular left shift, portable version.
  */
-uint32_t SHA1CircularShift(uint32_t word, size_t bits)
+template <unsigned Bits>
+uint32_t SHA1CircularShift(uint32_t word)
 {
 	// The SHA-like algorithm as originally implemented treated word as a signed value and used arithmetic right shifts
 	//  (sign-extending). This results in the high 32-`bits` bits being set to 1.
-	if ((word & (1 << 31)) != 0)
-		return (0xFFFFFFFF << bits) | (word >> (32 - bits));
-	return (word << bits) | (word >> (32 - bits));
+	// Right shifts of negative values are arithmetic since C++20, which does the same without a branch.
+	return (word << Bits) | static_cast<uint32_t>(static_cast<int32_t>(word) >> (32 - Bits));
 }
 
-void SHA1ProcessMessageBlock(SHA1Context *context)
+/**
+ * @brief 20 rounds with the round function `f`, five at a time so that the variables don't have
+ * to be moved around between rounds.
+ */
+template <typename RoundFunction>
+void SHA1Rounds(const uint32_t *w, uint32_t &a, uint32_t &b, uint32_t &c, uint32_t &d, uint32_t &e, uint32_t k, RoundFunction f)
+{
+	for (int i = 0; i < 20; i += 5) {
+		e += SHA1CircularShift<5>(a) + f(b, c, d) + w[i] + k;
+		b = SHA1CircularShift<30>(b);
+		d += SHA1CircularShift<5>(e) + f(a, b, c) + w[i + 1] + k;
+		a = SHA1CircularShift<30>(a);
+		c += SHA1CircularShift<5>(d) + f(e, a, b) + w[i + 2] + k;
+		e = SHA1CircularShift<30>(e);
+		b += SHA1CircularShift<5>(c) + f(d, e, a) + w[i + 3] + k;
+		d = SHA1CircularShift<30>(d);
+		a += SHA1CircularShift<5>(b) + f(c, d, e) + w[i + 4] + k;
+		c = SHA1CircularShift<30>(c);
+	}
+}
+
+void SHA1ProcessMessageBlock(SHA1Context *context, const uint32_t data[BlockSize])
 {
 	std::uint32_t w[80];
 
-	memcpy(w, context->buffer, BlockSize * sizeof(uint32_t));
+	memcpy(w, data, BlockSize * sizeof(uint32_t));
 	for (int i = 16; i < 80; i++) {
 		w[i] = w[i - 16] ^ w[i - 14] ^ w[i - 8] ^ w[i - 3];
 	}
@@ -37,41 +58,10 @@ void SHA1ProcessMessageBlock(SHA1Context *context)
 	std::uint32_t d = context->state[3];
 	std::uint32_t e = context->state[4];
 
-	for (int i = 0; i < 20; i++) {
-		const std::uint32_t temp = SHA1CircularShift(a, 5) + ((b & c) | ((~b) & d)) + e + w[i] + 0x5A827999;
-		e = d;
-		d = c;
-		c = SHA1CircularShift(b, 30);
-		b = a;
-		a = temp;
-	}
-
-	for (int i = 20; i < 40; i++) {
-		const std::uint32_t temp = SHA1CircularShift(a, 5) + (b ^ c ^ d) + e + w[i] + 0x6ED9EBA1;
-		e = d;
-		d = c;
-		c = SHA1CircularShift(b, 30);
-		b = a;
-		a = temp;
-	}
-
-	for (int i = 40; i < 60; i++) {
-		const std::uint32_t temp = SHA1CircularShift(a, 5) + ((b & c) | (b & d) | (c & d)) + e + w[i] + 0x8F1BBCDC;
-		e = d;
-		d = c;
-		c = SHA1CircularShift(b, 30);
-		b = a;
-		a = temp;
-	}
-
-	for (int i = 60; i < 80; i++) {
-		const std::uint32_t temp = SHA1CircularShift(a, 5) + (b ^ c ^ d) + e + w[i] + 0xCA62C1D6;
-		e = d;
-		d = c;
-		c = SHA1CircularShift(b, 30);
-		b = a;
-		a = temp;
-	}
+	SHA1Rounds(&w[0], a, b, c, d, e, 0x5A827999, [](uint32_t x, uint32_t y, uint32_t z) { return z ^ (x & (y ^ z)); });
+	SHA1Rounds(&w[20], a, b, c, d, e, 0x6ED9EBA1, [](uint32_t x, uint32_t y, uint32_t z) { return x ^ y ^ z; });
+	SHA1Rounds(&w[40], a, b, c, d, e, 0x8F1BBCDC, [](uint32_t x, uint32_t y, uint32_t z) { return (x & y) | (z & (x | y)); });
+	SHA1Rounds(&w[60], a, b, c, d, e, 0xCA62C1D6, [](uint32_t x, uint32_t y, uint32_t z) { return x ^ y ^ z; });
 
 	context->state[0] += a;
 	context->state[1] += b;
@@ -89,8 +79,7 @@ void SHA1Result(SHA1Context &context, uint32_t messageDigest[SHA1HashSize])
 
 void SHA1Calculate(SHA1Context &context, const uint32_t data[BlockSize])
 {
-	memcpy(&context.buffer[0], data, BlockSize * sizeof(uint32_t));
-	SHA1ProcessMessageBlock(&context);
+	SHA1ProcessMessageBlock(&context, data);
 }
 
 } // namespace devilution
@@ -6,6 +6,7 @@
 #include "stores.h"
 
 #include <algorithm>
+#include <array>
 #include <cstdint>
 #include <string_view>
 
@@ -29,6 +30,7 @@
 #include "qol/stash.h"
 #include "tables/townerdat.hpp"
 #include "towners.h"
+#include "utils/announcement.hpp"
 #include "utils/format_int.hpp"
 #include "utils/language.h"
 #include "utils/screen_reader.hpp"
@@ -86,6 +88,8 @@ struct STextStruct {
 	uint8_t _syoff;
 	int cursId;
 	bool cursIndent;
+	/** What to speak when the line is selected, nullptr to build it from the line and the details below. */
+	const std::string *speech;
 
 	[[nodiscard]] bool isDivider() const
 	{
@@ -129,6 +133,35 @@ TalkID OldActiveStore;
 /** Temporary item used to hold the item being traded */
 Item TempItem;
 
+/** What an item's store text depends on, so it is only built again when one of these changes. */
+struct StoreItemTextKey {
+	const Item *item;
+	uint32_t seed;
+	uint16_t createInfo;
+	_item_indexes idx;
+	bool identified;
+	int durability;
+	int charges;
+	int value;
+	uint32_t languageGeneration;
+
+	bool operator==(const StoreItemTextKey &) const = default;
+};
+
+/** The text of an item in a scrolling store list. */
+struct StoreItemText {
+	StoreItemTextKey key {};
+	std::string name;
+	/** The lines PrintStoreItem() adds below the name. */
+	std::array<std::string, 2> details;
+	size_t detailCount = 0;
+	/** Name, price and details, the way SpeakCurrentStoreSelection() reads them. */
+	std::string speech;
+};
+
+/** Indexed like the list being shown, only one store list is shown at a time. */
+std::array<StoreItemText, std::size(PlayerItems)> StoreItemTexts;
+
 TalkID LastSpokenStore = TalkID::None;
 int LastSpokenTextLine = -1;
 int LastSpokenScrollPos = -1;
@@ -173,23 +206,27 @@ void SpeakCurrentStoreSelection()
 	if (!TextLine[CurrentTextLine].isSelectable() && CurrentTextLine != BackButtonLine())
 		return;
 
-	std::string speech = TextLine[CurrentTextLine].text;
+	// Reused so lines without precomputed speech don't allocate every frame.
+	static std::string BuiltSpeech;
+	const std::string *speech = TextLine[CurrentTextLine].speech;
+	if (speech == nullptr) {
+		BuiltSpeech = TextLine[CurrentTextLine].text;
 
-	const int price = TextLine[CurrentTextLine]._sval;
-	if (price > 0) {
-		speech = fmt::format("{:s} - {:s}", speech, FormatInteger(price));
-	}
+		const int price = TextLine[CurrentTextLine]._sval;
+		if (price > 0)
+			StrAppend(BuiltSpeech, " - ", FormatInteger(price));
 
-	// Add details below the selected store item (if any).
-	int addedDetailLines = 0;
-	for (int i = CurrentTextLine + 1; i < NumStoreLines && addedDetailLines < 3; ++i) {
-		if (TextLine[i].isSelectable() || TextLine[i].isDivider())
-			break;
-		if (!TextLine[i].hasText())
-			continue;
-		speech.append(". ");
-		speech.append(TextLine[i].text);
-		addedDetailLines++;
+		// Add details below the selected store item (if any).
+		int addedDetailLines = 0;
+		for (int i = CurrentTextLine + 1; i < NumStoreLines && addedDetailLines < 3; ++i) {
+			if (TextLine[i].isSelectable() || TextLine[i].isDivider())
+				break;
+			if (!TextLine[i].hasText())
+				continue;
+			StrAppend(BuiltSpeech, ". ", TextLine[i].text);
+			addedDetailLines++;
+		}
+		speech = &BuiltSpeech;
 	}
 
 	const bool selectionChanged = ActiveStore != LastSpokenStore
@@ -197,7 +234,7 @@ void SpeakCurrentStoreSelection()
 	    || HasScrollbar != LastSpokenHadScrollbar
 	    || (HasScrollbar && ScrollPos != LastSpokenScrollPos);
 
-	SpeakText(speech, selectionChanged);
+	SpeakText(*speech, selectionChanged);
 
 	LastSpokenStore = ActiveStore;
 	LastSpokenTextLine = CurrentTextLine;
@@ -293,6 +330,7 @@ void AddSLine(size_t y)
 	TextLine[y].type = STextStruct::Divider;
 	TextLine[y].cursId = -1;
 	TextLine[y].cursIndent = false;
+	TextLine[y].speech = nullptr;
 }
 
 void AddSTextVal(size_t y, int val)
@@ -310,6 +348,7 @@ void AddSText(uint8_t x, size_t y, std::string_view text, UiFlags flags, bool se
 	TextLine[y].type = sel ? STextStruct::Selectable : STextStruct::Label;
 	TextLine[y].cursId = cursId;
 	TextLine[y].cursIndent = cursIndent;
+	TextLine[y].speech = nullptr;
 }
 
 void AddOptionsBackButton()
@@ -332,9 +371,15 @@ void AddItemListBackButton(bool selectable = false)
 	}
 }
 
-void PrintStoreItem(const Item &item, int l, UiFlags flags, bool cursIndent = false)
+/**
+ * @brief Formats the lines shown below an item's name in a store.
+ * @return The number of lines, the last one is always there even if it is empty
+ */
+size_t FormatStoreItemDetails(const Item &item, std::array<std::string, 2> &lines)
 {
-	std::string productLine;
+	size_t count = 0;
+	std::string &productLine = lines[0];
+	productLine.clear();
 
 	if (item._iIdentified) {
 		if (item._iMagical != ITEM_QUALITY_UNIQUE) {
@@ -353,21 +398,20 @@ void PrintStoreItem(const Item &item, int l, UiFlags flags, bool cursIndent = fa
 			productLine.append(_(",  "));
 		productLine.append(fmt::format(fmt::runtime(_("Charges: {:d}/{:d}")), item._iCharges, item._iMaxCharges));
 	}
-	if (!productLine.empty()) {
-		AddSText(40, l, productLine, flags, false, -1, cursIndent);
-		l++;
-		productLine.clear();
-	}
+	if (!productLine.empty())
+		count++;
 
+	std::string &statsLine = lines[count];
+	statsLine.clear();
 	if (item._itype != ItemType::Misc) {
 		if (item._iClass == ICLASS_WEAPON)
-			productLine = fmt::format(fmt::runtime(_("Damage: {:d}-{:d}  ")), item._iMinDam, item._iMaxDam);
+			statsLine = fmt::format(fmt::runtime(_("Damage: {:d}-{:d}  ")), item._iMinDam, item._iMaxDam);
 		else if (item._iClass == ICLASS_ARMOR)
-			productLine = fmt::format(fmt::runtime(_("Armor: {:d}  ")), item._iAC);
+			statsLine = fmt::format(fmt::runtime(_("Armor: {:d}  ")), item._iAC);
 		if (item._iMaxDur != DUR_INDESTRUCTIBLE && item._iMaxDur != 0)
-			productLine += fmt::format(fmt::runtime(_("Dur: {:d}/{:d}")), item._iDurability, item._iMaxDur);
+			statsLine += fmt::format(fmt::runtime(_("Dur: {:d}/{:d}")), item._iDurability, item._iMaxDur);
 		else
-			productLine.append(_("Indestructible"));
+			statsLine.append(_("Indestructible"));
 	}
 
 	int8_t str = item._iMinStr;
@@ -375,17 +419,57 @@ void PrintStoreItem(const Item &item, int l, UiFlags flags, bool cursIndent = fa
 	int8_t dex = item._iMinDex;
 
 	if (str != 0 || mag != 0 || dex != 0) {
-		if (!productLine.empty())
-			productLine.append(_(",  "));
-		productLine.append(_("Required:"));
+		if (!statsLine.empty())
+			statsLine.append(_(",  "));
+		statsLine.append(_("Required:"));
 		if (str != 0)
-			productLine.append(fmt::format(fmt::runtime(_(" {:d} Str")), str));
+			statsLine.append(fmt::format(fmt::runtime(_(" {:d} Str")), str));
 		if (mag != 0)
-			productLine.append(fmt::format(fmt::runtime(_(" {:d} Mag")), mag));
+			statsLine.append(fmt::format(fmt::runtime(_(" {:d} Mag")), mag));
 		if (dex != 0)
-			productLine.append(fmt::format(fmt::runtime(_(" {:d} Dex")), dex));
+			statsLine.append(fmt::format(fmt::runtime(_(" {:d} Dex")), dex));
+	}
+	return count + 1;
+}
+
+void PrintStoreItem(const Item &item, int l, UiFlags flags, bool cursIndent = false)
+{
+	std::array<std::string, 2> lines;
+	const size_t count = FormatStoreItemDetails(item, lines);
+	for (size_t i = 0; i < count; i++)
+		AddSText(40, l++, lines[i], flags, false, -1, cursIndent);
+}
+
+/** @brief The text of an item in a store list, built again only if the item changed since it was last shown. */
+const StoreItemText &GetStoreItemText(const Item &item, size_t index)
+{
+	const int value = item._iIdentified ? item._iIvalue : item._ivalue;
+	const StoreItemTextKey key {
+		.item = &item,
+		.seed = item._iSeed,
+		.createInfo = item._iCreateInfo,
+		.idx = item.IDidx,
+		.identified = item._iIdentified,
+		.durability = item._iDurability,
+		.charges = item._iCharges,
+		.value = value,
+		.languageGeneration = GetAnnouncementLanguageGeneration(),
+	};
+	StoreItemText &text = StoreItemTexts[index];
+	if (text.key == key)
+		return text;
+
+	text.key = key;
+	text.name = item.getName().str();
+	text.detailCount = FormatStoreItemDetails(item, text.details);
+	text.speech = text.name;
+	if (value > 0)
+		StrAppend(text.speech, " - ", FormatInteger(value));
+	for (size_t i = 0; i < text.detailCount; i++) {
+		if (!text.details[i].empty())
+			StrAppend(text.speech, ". ", text.details[i]);
 	}
-	AddSText(40, l++, productLine, flags, false, -1, cursIndent);
+	return text;
 }
 
 bool StoreAutoPlace(Item &item, bool persistItem)
@@ -414,10 +498,13 @@ void ScrollVendorStore(std::span<Item> itemData, int storeLimit, int idx, int se
 
 	for (int l = 5; l < 20 && idx < storeLimit; l += 4) {
 		const Item &item = itemData[idx];
+		const StoreItemText &text = GetStoreItemText(item, static_cast<size_t>(idx));
 		const UiFlags itemColor = item.getTextColorWithStatCheck();
-		AddSText(20, l, item.getName(), itemColor, true, item._iCurs, true);
-		AddSTextVal(l, item._iIdentified ? item._iIvalue : item._ivalue);
-		PrintStoreItem(item, l + 1, itemColor, true);
+		AddSText(20, l, text.name, itemColor, true, item._iCurs, true);
+		AddSTextVal(l, text.key.value);
+		TextLine[l].speech = &text.speech;
+		for (size_t i = 0; i < text.detailCount; i++)
+			AddSText(40, l + 1 + static_cast<int>(i), text.details[i], itemColor, false, -1, true);
 		NextScrollPos = l;
 		idx++;
 	}
@@ -1502,6 +1589,7 @@ void SmithRepairItem(int price)
 			myPlayer.InvBody[INVLOC_HAND_LEFT]._iDurability = myPlayer.InvBody[INVLOC_HAND_LEFT]._iMaxDur;
 		if (i == -4)
 			myPlayer.InvBody[INVLOC_HAND_RIGHT]._iDurability = myPlayer.InvBody[INVLOC_HAND_RIGHT]._iMaxDur;
+		MyPlayerEquipmentDurabilityGeneration++;
 		TakePlrsMoney(price);
 		return;
 	}
@@ -2230,11 +2318,12 @@ void ClearSText(int s, int e)
 	for (int i = s; i < e; i++) {
 		TextLine[i]._sx = 0;
 		TextLine[i]._syoff = 0;
+		// Keeps the capacity, scrolling stores clear and refill their lines every frame.
 		TextLine[i].text.clear();
-		TextLine[i].text.shrink_to_fit();
 		TextLine[i].flags = UiFlags::None;
 		TextLine[i].type = STextStruct::Label;
 		TextLine[i]._sval = 0;
+		TextLine[i].speech = nullptr;
 	}
 }
 
@@ -14,6 +14,7 @@
 
 #include "dvlnet/abstract_net.h"
 #include "engine/demomode.h"
+#include "engine/tracing.hpp"
 #include "headless_mode.hpp"
 #include "menu.h"
 #include "multi.h"
@@ -237,6 +238,7 @@ bool SNetSetBasePlayer(int /*unused*/)
 
 void DvlNet_ProcessNetworkPackets()
 {
+	DVL_TRACE_ZONE("ProcessNetworkPackets");
 	return dvlnet_inst->process_network_packets();
 }
 
@@ -1,8 +1,12 @@
 #include "storm/storm_svid.h"
 
+#include <algorithm>
+#include <array>
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
+#include <memory>
+#include <mutex>
 #include <optional>
 
 #ifdef USE_SDL3
@@ -34,6 +38,9 @@
 #include "utils/display.h"
 #include "utils/log.hpp"
 #include "utils/sdl_compat.h"
+#include "utils/sdl_cond.h"
+#include "utils/sdl_mutex.h"
+#include "utils/sdl_thread.h"
 #include "utils/sdl_wrap.h"
 
 namespace devilution {
@@ -48,7 +55,8 @@ std::optional<Aulib::Stream> SVidAudioStream;
 PushAulibDecoder *SVidAudioDecoder;
 #endif
 std::uint8_t SVidAudioDepth;
-std::unique_ptr<int16_t[]> SVidAudioBuffer;
+// The size of the audio buffer of each frame in bytes, 0 if the audio is not played.
+std::uint32_t SVidAudioBufferSize;
 #endif
 
 // Smacker's atomic time unit is a one hundred thousand's of a second (i.e. 0.01 millisecond, or 10 microseconds).
@@ -69,9 +77,48 @@ uint64_t GetTicksSmk()
 uint32_t SVidWidth, SVidHeight;
 bool SVidLoop;
 SmackerHandle SVidHandle;
-std::unique_ptr<uint8_t[]> SVidFrameBuffer;
 SDLPaletteUniquePtr SVidPalette;
-SDLSurfaceUniquePtr SVidSurface;
+
+/** A decoded frame, with the palette and audio that came with it. */
+struct SVidFrame {
+	std::unique_ptr<uint8_t[]> pixels;
+	// A surface over `pixels`, for when SDL has to blit the frame.
+	SDLSurfaceUniquePtr surface;
+	std::array<uint8_t, 256 * 3> palette;
+	bool paletteChanged;
+#ifndef NOSOUND
+	std::unique_ptr<int16_t[]> audio;
+	std::uint32_t audioBytes;
+#endif
+	// False if the video ended instead.
+	bool decoded;
+};
+
+// The frame being shown is `SVidFrames[SVidShownFrame]`, the next one is decoded into the other.
+std::array<SVidFrame, 2> SVidFrames;
+size_t SVidShownFrame;
+
+// The frame in the output format, at the video's size, that is scaled to the output surface.
+SDLSurfaceUniquePtr SVidScaledFrame;
+
+// The palette mapped to the pixel format of `SVidColorsTarget`, mapped again when either changes.
+std::array<uint32_t, 256> SVidTargetColors;
+const SDL_Surface *SVidColorsTarget;
+
+#ifndef __DJGPP__
+struct SVidDecoderState {
+	SdlMutex mutex;
+	SdlCond wakeUp;
+	SdlCond decoded;
+
+	// Whether the decoder thread is decoding the next frame.
+	bool decoding = false;
+	bool stop = false;
+};
+
+std::optional<SVidDecoderState> SVidDecoder;
+SdlThread SVidDecodeThread;
+#endif
 
 // The end of the current frame (time in SMK time units from the start of the program).
 uint64_t SVidFrameEnd;
@@ -161,29 +208,159 @@ bool ShouldPushAudioData()
 }
 #endif
 
-bool SVidLoadNextFrame()
+void SVidDecodeFrame(SVidFrame &frame)
 {
 	if (Smacker_GetCurrentFrameNum(SVidHandle) >= Smacker_GetNumFrames(SVidHandle)) {
 		if (!SVidLoop) {
-			return false;
+			frame.decoded = false;
+			return;
 		}
 
 		Smacker_Rewind(SVidHandle);
 	}
 
+	Smacker_GetNextFrame(SVidHandle);
+	Smacker_GetFrame(SVidHandle, frame.pixels.get());
+	frame.paletteChanged = Smacker_DidPaletteChange(SVidHandle);
+	if (frame.paletteChanged)
+		Smacker_GetPalette(SVidHandle, frame.palette.data());
+#ifndef NOSOUND
+	if (frame.audio != nullptr)
+		frame.audioBytes = Smacker_GetAudioData(SVidHandle, 0, frame.audio.get());
+#endif
+	frame.decoded = true;
+}
+
+#ifndef __DJGPP__
+void SVidDecodeLoop()
+{
+	SVidDecoderState &state = *SVidDecoder;
+	std::unique_lock<SdlMutex> lock(state.mutex);
+	while (true) {
+		while (!state.stop && !state.decoding)
+			state.wakeUp.wait(state.mutex);
+		if (state.stop)
+			return;
+
+		SVidFrame &frame = SVidFrames[1 - SVidShownFrame];
+		lock.unlock();
+		SVidDecodeFrame(frame);
+		lock.lock();
+
+		state.decoding = false;
+		state.decoded.signal();
+	}
+}
+#endif
+
+// Starts decoding the frame after the one being shown, so that it is ready by the time it is due.
+void SVidDecodeAhead()
+{
+#ifdef __DJGPP__
+	// No threads, decode right away.
+	SVidDecodeFrame(SVidFrames[1 - SVidShownFrame]);
+#else
+	{
+		const std::lock_guard<SdlMutex> lock(SVidDecoder->mutex);
+		SVidDecoder->decoding = true;
+	}
+	SVidDecoder->wakeUp.signal();
+#endif
+}
+
+bool SVidLoadNextFrame()
+{
+#ifndef __DJGPP__
+	{
+		const std::lock_guard<SdlMutex> lock(SVidDecoder->mutex);
+		while (SVidDecoder->decoding)
+			SVidDecoder->decoded.wait(SVidDecoder->mutex);
+	}
+#endif
+	if (!SVidFrames[1 - SVidShownFrame].decoded) {
+		return false;
+	}
+
+	SVidShownFrame = 1 - SVidShownFrame;
 	SVidFrameEnd += SVidFrameLength;
+	SVidDecodeAhead();
 
-	Smacker_GetNextFrame(SVidHandle);
-	Smacker_GetFrame(SVidHandle, SVidFrameBuffer.get());
+	return true;
+}
 
+int BytesPerPixel(const SDL_Surface *surface)
+{
+#ifdef USE_SDL3
+	return SDL_BYTESPERPIXEL(surface->format);
+#else
+	return surface->format->BytesPerPixel;
+#endif
+}
+
+void MapTargetColors(SDL_Surface *target)
+{
+	const SDL_Color *colors = SVidPalette->colors;
+#ifdef USE_SDL3
+	const SDL_PixelFormatDetails *format = SDL_GetPixelFormatDetails(target->format);
+	const SDL_Palette *palette = SDL_GetSurfacePalette(target);
+#endif
+	for (size_t i = 0; i < SVidTargetColors.size(); ++i) {
+#ifdef USE_SDL3
+		SVidTargetColors[i] = SDL_MapRGB(format, palette, colors[i].r, colors[i].g, colors[i].b);
+#else
+		SVidTargetColors[i] = SDL_MapRGB(target->format, colors[i].r, colors[i].g, colors[i].b);
+#endif
+	}
+	SVidColorsTarget = target;
+}
+
+template <typename Pixel>
+void ExpandRows(const uint8_t *src, uint8_t *dst, int dstPitch, int width, int height)
+{
+	for (int y = 0; y < height; ++y, src += SVidWidth, dst += dstPitch) {
+		auto *out = reinterpret_cast<Pixel *>(dst);
+		for (int x = 0; x < width; ++x)
+			out[x] = static_cast<Pixel>(SVidTargetColors[src[x]]);
+	}
+}
+
+/**
+ * @brief Writes the frame to `target` at (x, y) through a palette mapped to the target's format, clipped to the target.
+ *
+ * Faster than an SDL blit from the 8-bit surface, which goes through a generic conversion.
+ * @return false if the target format is not 16 or 32 bits per pixel, the frame must be blitted by SDL then
+ */
+bool ExpandFrame(const SVidFrame &frame, SDL_Surface *target, int x, int y)
+{
+	const int bytesPerPixel = BytesPerPixel(target);
+	if (bytesPerPixel != 2 && bytesPerPixel != 4)
+		return false;
+	if (target != SVidColorsTarget)
+		MapTargetColors(target);
+
+	const int left = std::max(x, 0);
+	const int top = std::max(y, 0);
+	const int right = std::min(x + static_cast<int>(SVidWidth), target->w);
+	const int bottom = std::min(y + static_cast<int>(SVidHeight), target->h);
+	if (left >= right || top >= bottom)
+		return true;
+
+	if (SDL_MUSTLOCK(target))
+		SDL_LockSurface(target);
+	const uint8_t *src = frame.pixels.get() + static_cast<size_t>(top - y) * SVidWidth + (left - x);
+	uint8_t *dst = static_cast<uint8_t *>(target->pixels) + static_cast<ptrdiff_t>(top) * target->pitch + static_cast<ptrdiff_t>(left) * bytesPerPixel;
+	if (bytesPerPixel == 4)
+		ExpandRows<uint32_t>(src, dst, target->pitch, right - left, bottom - top);
+	else
+		ExpandRows<uint16_t>(src, dst, target->pitch, right - left, bottom - top);
+	if (SDL_MUSTLOCK(target))
+		SDL_UnlockSurface(target);
 	return true;
 }
 
-void UpdatePalette()
+void UpdatePalette(const std::array<uint8_t, 256 * 3> &paletteData)
 {
 	constexpr size_t NumColors = 256;
-	uint8_t paletteData[NumColors * 3];
-	Smacker_GetPalette(SVidHandle, paletteData);
 
 	SDL_Color *colors = SVidPalette->colors;
 	for (unsigned i = 0; i < NumColors; ++i) {
@@ -200,12 +377,16 @@ void UpdatePalette()
 	// When the video surface is 8bit, we need to set the output palette.
 	SDL_SetColors(SDL_GetVideoSurface(), colors, 0, NumColors);
 #endif
-	if (SDL_SetPalette(SVidSurface.get(), SDL_LOGPAL, colors, 0, NumColors) <= 0) {
-		ErrSdl();
+	for (SVidFrame &frame : SVidFrames) {
+		if (SDL_SetPalette(frame.surface.get(), SDL_LOGPAL, colors, 0, NumColors) <= 0) {
+			ErrSdl();
+		}
 	}
 #else
-	if (!SDLC_SetSurfacePalette(SVidSurface.get(), SVidPalette.get())) {
-		ErrSdl();
+	for (SVidFrame &frame : SVidFrames) {
+		if (!SDLC_SetSurfacePalette(frame.surface.get(), SVidPalette.get())) {
+			ErrSdl();
+		}
 	}
 
 	const SDL_Surface *surface = GetOutputSurface();
@@ -215,19 +396,21 @@ void UpdatePalette()
 		}
 	}
 #endif
+	SVidColorsTarget = nullptr;
 }
 
 bool BlitFrame()
 {
+	const SVidFrame &frame = SVidFrames[SVidShownFrame];
 #ifndef USE_SDL1
 	if (renderer != nullptr) {
-		if (
+		if (!ExpandFrame(frame, GetOutputSurface(), 0, 0) && (
 #ifdef USE_SDL3
-		    !SDL_BlitSurface(SVidSurface.get(), nullptr, GetOutputSurface(), nullptr)
+		    !SDL_BlitSurface(frame.surface.get(), nullptr, GetOutputSurface(), nullptr)
 #else
-		    SDL_BlitSurface(SVidSurface.get(), nullptr, GetOutputSurface(), nullptr) <= -1
+		    SDL_BlitSurface(frame.surface.get(), nullptr, GetOutputSurface(), nullptr) <= -1
 #endif
-		) {
+		        )) {
 			Log("{}", SDL_GetError());
 			return false;
 		}
@@ -264,28 +447,39 @@ bool BlitFrame()
 		if (isIndexedOutputFormat
 		    || outputSurface->w == static_cast<int>(SVidWidth)
 		    || outputSurface->h == static_cast<int>(SVidHeight)) {
-			if (
+			if (!ExpandFrame(frame, outputSurface, outputRect.x, outputRect.y) && (
 #ifdef USE_SDL3
-			    SDL_BlitSurface(SVidSurface.get(), nullptr, outputSurface, &outputRect)
+			    !SDL_BlitSurface(frame.surface.get(), nullptr, outputSurface, &outputRect)
 #else
-			    SDL_BlitSurface(SVidSurface.get(), nullptr, outputSurface, &outputRect) <= -1
+			    SDL_BlitSurface(frame.surface.get(), nullptr, outputSurface, &outputRect) <= -1
 #endif
-			) {
+			        )) {
 				ErrSdl();
 			}
 		} else {
 			// The source surface is always 8-bit, and the output surface is never 8-bit in this branch.
 			// We must convert to the output format before calling SDL_BlitScaled.
+			// The converted surface is kept for the whole video and each frame is expanded into it.
+			if (SVidScaledFrame == nullptr) {
 #ifdef USE_SDL1
-			SDLSurfaceUniquePtr converted = SDLWrap::ConvertSurface(SVidSurface.get(), ghMainWnd->format, 0);
+				SVidScaledFrame = SDLWrap::ConvertSurface(frame.surface.get(), ghMainWnd->format, 0);
 #else
-			SDLSurfaceUniquePtr converted = SDLWrap::ConvertSurfaceFormat(SVidSurface.get(), wndFormat, 0);
+				SVidScaledFrame = SDLWrap::ConvertSurfaceFormat(frame.surface.get(), wndFormat, 0);
 #endif
+			} else if (!ExpandFrame(frame, SVidScaledFrame.get(), 0, 0) && (
+#ifdef USE_SDL3
+			               !SDL_BlitSurface(frame.surface.get(), nullptr, SVidScaledFrame.get(), nullptr)
+#else
+			               SDL_BlitSurface(frame.surface.get(), nullptr, SVidScaledFrame.get(), nullptr) <= -1
+#endif
+			                   )) {
+				ErrSdl();
+			}
 			if (
 #ifdef USE_SDL3
-			    SDL_BlitSurfaceScaled(converted.get(), nullptr, outputSurface, &outputRect, SDL_SCALEMODE_LINEAR)
+			    !SDL_BlitSurfaceScaled(SVidScaledFrame.get(), nullptr, outputSurface, &outputRect, SDL_SCALEMODE_LINEAR)
 #else
-			    SDL_BlitScaled(converted.get(), nullptr, outputSurface, &outputRect) <= -1
+			    SDL_BlitScaled(SVidScaledFrame.get(), nullptr, outputSurface, &outputRect) <= -1
 #endif
 			) {
 				Log("{}", SDL_GetError());
@@ -294,6 +488,7 @@ bool BlitFrame()
 		}
 	}
 
+	InvalidateOutputSurface();
 	RenderPresent();
 	return true;
 }
@@ -345,7 +540,8 @@ bool SVidPlayBegin(const char *filename, int flags)
 	// 0x800000 // Edge detection
 	// 0x200800 // Clear FB
 
-	auto *videoStream = OpenAssetAsSdlRwOps(filename);
+	// Frames are decoded on the decoder thread.
+	auto *videoStream = OpenAssetAsSdlRwOps(filename, /*threadsafe=*/true);
 	SVidHandle = Smacker_Open(videoStream);
 	if (!SVidHandle.isValid) {
 		return false;
@@ -353,6 +549,7 @@ bool SVidPlayBegin(const char *filename, int flags)
 
 #ifndef NOSOUND
 	const bool enableAudio = (flags & 0x1000000) == 0;
+	SVidAudioBufferSize = 0;
 
 	auto audioInfo = Smacker_GetAudioTrackDetails(SVidHandle, 0);
 	LogVerbose(LogCategory::Audio, "SVid audio depth={} channels={} rate={}", audioInfo.bitsPerSample, audioInfo.nChannels, audioInfo.sampleRate);
@@ -361,7 +558,7 @@ bool SVidPlayBegin(const char *filename, int flags)
 		sound_stop(); // Stop in-progress music and sound effects
 
 		SVidAudioDepth = audioInfo.bitsPerSample;
-		SVidAudioBuffer = std::unique_ptr<int16_t[]> { new int16_t[audioInfo.idealBufferSize / 2] };
+		SVidAudioBufferSize = audioInfo.idealBufferSize;
 
 #ifndef USE_SDL3
 		auto decoder = std::make_unique<PushAulibDecoder>(audioInfo.nChannels, audioInfo.sampleRate);
@@ -427,26 +624,39 @@ bool SVidPlayBegin(const char *filename, int flags)
 	// Set the background to black.
 	SDL_FillSurfaceRect(GetOutputSurface(), nullptr, 0x000000);
 
-	// The buffer for the frame. It is not the same as the SDL surface because the SDL surface also has pitch padding.
-	SVidFrameBuffer = std::unique_ptr<uint8_t[]> { new uint8_t[static_cast<size_t>(SVidWidth * SVidHeight)] };
+	for (SVidFrame &frame : SVidFrames) {
+		// The buffer for the frame. It is not the same as the SDL surface because the SDL surface also has pitch padding.
+		frame.pixels = std::unique_ptr<uint8_t[]> { new uint8_t[static_cast<size_t>(SVidWidth * SVidHeight)] };
+
+		// Create the surface from the frame buffer data.
+		frame.surface = SDLWrap::CreateRGBSurfaceWithFormatFrom(
+		    reinterpret_cast<void *>(frame.pixels.get()),
+		    static_cast<int>(SVidWidth),
+		    static_cast<int>(SVidHeight),
+		    8,
+		    static_cast<int>(SVidWidth),
+		    SDL_PIXELFORMAT_INDEX8);
+#ifndef NOSOUND
+		if (SVidAudioBufferSize != 0)
+			frame.audio = std::unique_ptr<int16_t[]> { new int16_t[SVidAudioBufferSize / 2] };
+#endif
+	}
 
 	// Decode first frame.
-	Smacker_GetNextFrame(SVidHandle);
-	Smacker_GetFrame(SVidHandle, SVidFrameBuffer.get());
-
-	// Create the surface from the frame buffer data.
 	// It will be rendered in `SVidPlayContinue`, called immediately after this function.
-	// Subsequents frames will also be copied to this surface.
-	SVidSurface = SDLWrap::CreateRGBSurfaceWithFormatFrom(
-	    reinterpret_cast<void *>(SVidFrameBuffer.get()),
-	    static_cast<int>(SVidWidth),
-	    static_cast<int>(SVidHeight),
-	    8,
-	    static_cast<int>(SVidWidth),
-	    SDL_PIXELFORMAT_INDEX8);
+	SVidShownFrame = 0;
+	SVidDecodeFrame(SVidFrames[0]);
+	Smacker_GetPalette(SVidHandle, SVidFrames[0].palette.data());
 
 	SVidPalette = SDLWrap::AllocPalette();
-	UpdatePalette();
+	UpdatePalette(SVidFrames[0].palette);
+
+	// Subsequent frames are decoded on the decoder thread, each while the one before is shown.
+#ifndef __DJGPP__
+	SVidDecoder.emplace();
+	SVidDecodeThread = SdlThread { SVidDecodeLoop };
+#endif
+	SVidDecodeAhead();
 
 	SVidFrameEnd = GetTicksSmk() + SVidFrameLength;
 
@@ -455,8 +665,9 @@ bool SVidPlayBegin(const char *filename, int flags)
 
 bool SVidPlayContinue()
 {
-	if (Smacker_DidPaletteChange(SVidHandle)) {
-		UpdatePalette();
+	const SVidFrame &frame = SVidFrames[SVidShownFrame];
+	if (frame.paletteChanged) {
+		UpdatePalette(frame.palette);
 	}
 
 	if (GetTicksSmk() >= SVidFrameEnd) {
@@ -468,8 +679,8 @@ bool SVidPlayContinue()
 
 #ifndef NOSOUND
 	if (ShouldPushAudioData()) {
-		std::int16_t *buf = SVidAudioBuffer.get();
-		const auto len = Smacker_GetAudioData(SVidHandle, 0, buf);
+		const std::int16_t *buf = frame.audio.get();
+		const auto len = frame.audioBytes;
 #ifdef USE_SDL3
 		if (!SDL_PutAudioStreamData(SVidAudioStream, buf, static_cast<int>(len))) {
 			LogError(LogCategory::Audio, "SDL_PutAudioStreamData (from SVidPlayContinue): {}", SDL_GetError());
@@ -513,16 +724,29 @@ void SVidPlayEnd()
 		SVidAudioStream = std::nullopt;
 		SVidAudioDecoder = nullptr;
 #endif
-		SVidAudioBuffer = nullptr;
 	}
+	SVidAudioBufferSize = 0;
+#endif
+
+#ifndef __DJGPP__
+	if (SVidDecodeThread.joinable()) {
+		{
+			const std::lock_guard<SdlMutex> lock(SVidDecoder->mutex);
+			SVidDecoder->stop = true;
+		}
+		SVidDecoder->wakeUp.signal();
+		SVidDecodeThread.join();
+	}
+	SVidDecoder = std::nullopt;
 #endif
 
 	if (SVidHandle.isValid)
 		Smacker_Close(SVidHandle);
 
 	SVidPalette = nullptr;
-	SVidSurface = nullptr;
-	SVidFrameBuffer = nullptr;
+	SVidFrames = {};
+	SVidScaledFrame = nullptr;
+	SVidColorsTarget = nullptr;
 
 #ifndef USE_SDL1
 	if (renderer != nullptr) {
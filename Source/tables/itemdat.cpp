@@ -41,6 +41,8 @@ std::vector<PLStruct> ItemPrefixes;
 /** Contains the data related to each item suffix. */
 std::vector<PLStruct> ItemSuffixes;
 
+uint32_t ItemDataGeneration;
+
 tl::expected<_item_indexes, std::string> ParseItemId(std::string_view value)
 {
 	const std::optional<_item_indexes> enumValueOpt = magic_enum::enum_cast<_item_indexes>(value);
@@ -663,6 +665,7 @@ void LoadUniqueItemDatFromFile(DataFile &dataFile, std::string_view filename, in
 		++currentMappingId;
 	}
 	UniqueItems.shrink_to_fit();
+	ItemDataGeneration++;
 }
 
 namespace {
@@ -711,6 +714,7 @@ void LoadItemData()
 	LoadUniqueItemDat();
 	LoadItemAffixesDat("txtdata\\items\\item_prefixes.tsv", ItemPrefixes);
 	LoadItemAffixesDat("txtdata\\items\\item_suffixes.tsv", ItemSuffixes);
+	ItemDataGeneration++;
 }
 
 std::string_view ItemTypeToString(ItemType itemType)
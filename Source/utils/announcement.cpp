@@ -0,0 +1,57 @@
+/**
+ * @file announcement.cpp
+ *
+ * Implementation of the translated formats of announcements that are spoken often.
+ */
+#include "utils/announcement.hpp"
+
+#include <array>
+#include <cstddef>
+#include <optional>
+
+#include "utils/language.h"
+
+namespace devilution {
+
+namespace {
+
+constexpr size_t AnnouncementCount = static_cast<size_t>(Announcement::COUNT);
+
+constexpr std::array<const char *, AnnouncementCount> AnnouncementKeys = {
+	N_("{:s} health: {:d}%"),
+	N_("Low durability: {:s}"),
+};
+
+std::array<std::optional<std::string_view>, AnnouncementCount> AnnouncementFormats;
+
+fmt::memory_buffer AnnouncementBuffer;
+
+uint32_t LanguageGeneration;
+
+} // namespace
+
+std::string_view GetAnnouncementFormat(Announcement announcement)
+{
+	std::optional<std::string_view> &format = AnnouncementFormats[static_cast<size_t>(announcement)];
+	if (!format)
+		format = LanguageTranslate(AnnouncementKeys[static_cast<size_t>(announcement)]);
+	return *format;
+}
+
+void ClearAnnouncementFormats()
+{
+	AnnouncementFormats.fill(std::nullopt);
+	LanguageGeneration++;
+}
+
+uint32_t GetAnnouncementLanguageGeneration()
+{
+	return LanguageGeneration;
+}
+
+fmt::memory_buffer &GetAnnouncementBuffer()
+{
+	return AnnouncementBuffer;
+}
+
+} // namespace devilution
@@ -0,0 +1,49 @@
+/**
+ * @file announcement.hpp
+ *
+ * Interface of the translated formats of announcements that are spoken often.
+ */
+#pragma once
+
+#include <cstdint>
+#include <iterator>
+#include <string_view>
+
+#include <fmt/format.h>
+
+namespace devilution {
+
+enum class Announcement : uint8_t {
+	/** Boss name and health percentage. */
+	BossHealth,
+	/** Comma separated list of items. */
+	LowDurability,
+	COUNT,
+};
+
+/** @brief The translated format, looked up once per language. */
+[[nodiscard]] std::string_view GetAnnouncementFormat(Announcement announcement);
+
+/** @brief Forgets the translated formats, call after the language is reloaded. */
+void ClearAnnouncementFormats();
+
+/** @brief Changes with every ClearAnnouncementFormats(), for caches of other translated text. */
+[[nodiscard]] uint32_t GetAnnouncementLanguageGeneration();
+
+/** @brief The buffer FormatAnnouncement() writes to, only for the game thread. */
+[[nodiscard]] fmt::memory_buffer &GetAnnouncementBuffer();
+
+/**
+ * @brief Formats an announcement without allocating once the buffer has grown.
+ * @return The text, valid until the next call.
+ */
+template <typename... Args>
+std::string_view FormatAnnouncement(Announcement announcement, const Args &...args)
+{
+	fmt::memory_buffer &buffer = GetAnnouncementBuffer();
+	buffer.clear();
+	fmt::format_to(std::back_inserter(buffer), fmt::runtime(GetAnnouncementFormat(announcement)), args...);
+	return { buffer.data(), buffer.size() };
+}
+
+} // namespace devilution
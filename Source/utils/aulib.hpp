@@ -5,6 +5,7 @@
 
 #include <Aulib/Stream.h>
 
+#include "engine/audio_stats.hpp"
 #include "engine/sound_defs.hpp" // for DVL_AULIB_SUPPORTS_SDL_RESAMPLER
 
 #ifdef DEVILUTIONX_RESAMPLER_SPEEX
@@ -19,17 +20,38 @@
 
 namespace devilution {
 
-inline std::unique_ptr<Aulib::Resampler> CreateAulibResampler(int sourceRate)
+/** Adds the time spent in the resampler to the audio statistics. */
+template <class Base>
+class MeasuredResampler final : public Base {
+public:
+	using Base::Base;
+
+protected:
+	void doResampling(float dst[], const float src[], int &dstLen, int &srcLen) override
+	{
+		const ScopedAudioStatsTimer timer(AudioStatsTimer::Resample);
+		Base::doResampling(dst, src, dstLen, srcLen);
+	}
+};
+
+/**
+ * @param measured Whether the resampler runs in the audio callback and counts towards the audio statistics
+ */
+inline std::unique_ptr<Aulib::Resampler> CreateAulibResampler(int sourceRate, bool measured = false)
 {
 	if (Aulib::sampleRate() == sourceRate)
 		return nullptr;
 	switch (*GetOptions().Audio.resampler) {
 #ifdef DEVILUTIONX_RESAMPLER_SPEEX
 	case Resampler::Speex:
+		if (measured)
+			return std::make_unique<MeasuredResampler<Aulib::ResamplerSpeex>>(*GetOptions().Audio.resamplingQuality);
 		return std::make_unique<Aulib::ResamplerSpeex>(*GetOptions().Audio.resamplingQuality);
 #endif
 #ifdef DVL_AULIB_SUPPORTS_SDL_RESAMPLER
 	case Resampler::SDL:
+		if (measured)
+			return std::make_unique<MeasuredResampler<Aulib::ResamplerSdl>>();
 		return std::make_unique<Aulib::ResamplerSdl>();
 #endif
 	}
@@ -41,6 +41,31 @@ public:
 		return data_.count();
 	}
 
+	Bitset2d &flip()
+	{
+		data_.flip();
+		return *this;
+	}
+
+	Bitset2d &operator&=(const Bitset2d &other)
+	{
+		data_ &= other.data_;
+		return *this;
+	}
+
+	Bitset2d &operator|=(const Bitset2d &other)
+	{
+		data_ |= other.data_;
+		return *this;
+	}
+
+	Bitset2d operator~() const
+	{
+		Bitset2d result = *this;
+		result.flip();
+		return result;
+	}
+
 private:
 	static size_t index(size_t x, size_t y)
 	{
@@ -12,6 +12,9 @@
 
 namespace devilution {
 
+/** Bump when the output of Cl2ToClx() changes, so that sprites converted before aren't loaded from the cache. */
+constexpr uint32_t Cl2ToClxVersion = 1;
+
 /**
  * @brief Converts CL2 to CLX in-place.
  *
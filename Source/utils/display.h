@@ -7,6 +7,7 @@
 #include <SDL3/SDL_rect.h>
 #include <SDL3/SDL_render.h>
 #include <SDL3/SDL_surface.h>
+#include <SDL3/SDL_version.h>
 #include <SDL3/SDL_video.h>
 #else
 #include <SDL.h>
@@ -32,6 +33,11 @@ extern SDL_Renderer *renderer;
 extern SDLTextureUniquePtr texture;
 #endif
 
+#if defined(USE_SDL3) && SDL_VERSION_ATLEAST(3, 4, 0)
+// The renderer can apply a palette to an 8-bit texture itself.
+#define DEVILUTIONX_PALETTED_TEXTURE
+#endif
+
 extern SDLPaletteUniquePtr Palette;
 extern SDL_Surface *PalSurface;
 extern DVL_API_FOR_TEST Size forceResolution;
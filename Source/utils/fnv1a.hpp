@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace devilution {
+
+constexpr uint64_t Fnv1aOffsetBasis = 0xcbf29ce484222325;
+
+/** @brief 64-bit FNV-1a hash, for telling contents apart, not for security. */
+constexpr uint64_t Fnv1a(std::span<const std::byte> bytes, uint64_t hash = Fnv1aOffsetBasis)
+{
+	for (const std::byte b : bytes) {
+		hash ^= static_cast<uint8_t>(b);
+		hash *= 0x100000001b3;
+	}
+	return hash;
+}
+
+/** @brief Adds the 8 bytes of `value` to `hash`, from the least significant one. */
+constexpr uint64_t Fnv1a(uint64_t value, uint64_t hash)
+{
+	for (int i = 0; i < 8; ++i) {
+		hash ^= (value >> (i * 8)) & 0xFF;
+		hash *= 0x100000001b3;
+	}
+	return hash;
+}
+
+} // namespace devilution
@@ -0,0 +1,41 @@
+/**
+ * @file headless_speech.cpp
+ *
+ * Implementation of the record of what would have been spoken in HeadlessMode.
+ */
+#include "utils/headless_speech.hpp"
+
+namespace devilution {
+
+namespace {
+
+uint32_t GameTick;
+std::vector<HeadlessSpeech> Recorded;
+
+} // namespace
+
+void RecordHeadlessSpeech(std::string_view text, bool force, SpeechPriority priority, SpeechChannel channel)
+{
+	// Same as SpeakText(), so the tests see the announcements a player would hear.
+	if (!force && !Recorded.empty() && Recorded.back().text == text)
+		return;
+	Recorded.push_back(HeadlessSpeech { .gameTick = GameTick, .text = std::string(text), .priority = priority, .channel = channel });
+}
+
+void CountHeadlessSpeechGameTick()
+{
+	GameTick++;
+}
+
+const std::vector<HeadlessSpeech> &GetHeadlessSpeech()
+{
+	return Recorded;
+}
+
+void ClearHeadlessSpeech()
+{
+	GameTick = 0;
+	Recorded.clear();
+}
+
+} // namespace devilution
@@ -0,0 +1,34 @@
+/**
+ * @file headless_speech.hpp
+ *
+ * Interface of the record of what would have been spoken in HeadlessMode.
+ */
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "utils/screen_reader.hpp"
+
+namespace devilution {
+
+/** A SpeakText() call in HeadlessMode that wasn't skipped for repeating the previous text. */
+struct HeadlessSpeech {
+	/** Game ticks processed before the call. */
+	uint32_t gameTick;
+	std::string text;
+	SpeechPriority priority;
+	SpeechChannel channel;
+};
+
+/** @brief Counts a game tick for the following recordings. */
+void CountHeadlessSpeechGameTick();
+
+/** @brief What was announced since the last ClearHeadlessSpeech(), in order. */
+[[nodiscard]] const std::vector<HeadlessSpeech> &GetHeadlessSpeech();
+
+/** @brief Forgets the recorded announcements and starts counting game ticks from 0. */
+void ClearHeadlessSpeech();
+
+} // namespace devilution
@@ -1,7 +1,10 @@
 #include "utils/language.h"
 
+#include <array>
 #include <cstdint>
+#include <cstring>
 #include <memory>
+#include <optional>
 #include <string_view>
 #include <vector>
 
@@ -16,7 +19,6 @@
 #endif
 #endif
 
-#include <ankerl/unordered_dense.h>
 #include <function_ref.hpp>
 
 #include "engine/assets.hpp"
@@ -26,6 +28,7 @@
 #include "utils/file_util.h"
 #include "utils/log.hpp"
 #include "utils/paths.h"
+#include "utils/perfect_hash.hpp"
 #include "utils/string_view_hash.hpp"
 
 #define MO_MAGIC 0x950412de
@@ -41,25 +44,45 @@ using namespace devilution;
 // and what translators use to test their work.
 constexpr std::array<const char *, 2> Extensions { ".mo", ".gmo" };
 
+/**
+ * The whole .mo file when it was read at once. Its strings are NUL-terminated, so they are used in
+ * place instead of being copied into translationKeys and translationValues.
+ */
+std::unique_ptr<std::byte[]> translationFile;
 std::unique_ptr<char[]> translationKeys;
 std::unique_ptr<char[]> translationValues;
+/** translationFile or translationValues, whichever has the translations. */
+const char *translationValuesBase;
+/** The size of translationFile, or of translationKeys and translationValues together. */
+size_t translationDataSize;
 
-using TranslationRef = uint32_t;
-
-std::vector<ankerl::unordered_dense::map<const char *, TranslationRef, StringViewHash, StringViewEquals>> translation = { {}, {} };
+/** A translation in translationValuesBase. */
+struct TranslationRef {
+	uint32_t offset;
+	uint32_t size;
+};
 
-constexpr uint32_t TranslationRefOffsetBits = 19;
-constexpr uint32_t TranslationRefSizeBits = 32 - TranslationRefOffsetBits; // 13
-constexpr uint32_t TranslationRefSizeMask = (1 << TranslationRefSizeBits) - 1;
+/** The slot of every msgid in translationSlotKeys and translation. */
+PerfectHash translationSlots;
+/** The msgid in each slot, pointing into translationFile or translationKeys, whichever has the msgids. */
+std::vector<std::string_view> translationSlotKeys;
+/** The translation in each slot for every plural form, an empty one if it has none. */
+std::vector<std::vector<TranslationRef>> translation = { {}, {} };
 
-TranslationRef EncodeTranslationRef(uint32_t offset, uint32_t size)
+std::string_view GetTranslation(TranslationRef ref)
 {
-	return (offset << TranslationRefSizeBits) | size;
+	return { translationValuesBase + ref.offset, ref.size };
 }
 
-std::string_view GetTranslation(TranslationRef ref)
+/** @brief The translation of `key` in the given plural form, empty if there is none. */
+std::string_view FindTranslation(std::string_view key, size_t form = 0)
 {
-	return { &translationValues[ref >> TranslationRefSizeBits], ref & TranslationRefSizeMask };
+	if (translationSlots.empty())
+		return {};
+	const size_t slot = translationSlots.Slot(StringViewHash {}(key));
+	if (translationSlotKeys[slot] != key)
+		return {};
+	return GetTranslation(translation[form][slot]);
 }
 
 } // namespace
@@ -275,6 +298,14 @@ bool CopyData(void *dst, const std::byte *data, size_t dataSize, size_t offset,
 	return true;
 }
 
+/** @brief The string of an entry where it is in the file, if it is in bounds and NUL-terminated. */
+std::optional<std::string_view> EntryInFile(const std::byte *data, size_t dataSize, const MoEntry &e)
+{
+	if (e.offset >= dataSize || e.length >= dataSize - e.offset || data[e.offset + e.length] != std::byte { 0 })
+		return std::nullopt;
+	return std::string_view { reinterpret_cast<const char *>(data) + e.offset, e.length };
+}
+
 bool ReadEntry(const std::byte *data, size_t dataSize, const MoEntry &e, char *result)
 {
 	if (!CopyData(result, data, dataSize, e.offset, e.length))
@@ -289,17 +320,20 @@ std::string_view LanguageParticularTranslate(std::string_view context, std::stri
 {
 	constexpr const char Glue = '\004';
 
-	std::string key = std::string(context);
-	key.reserve(key.size() + 1 + message.size());
-	key += Glue;
-	key.append(message);
-
-	auto it = translation[0].find(key.c_str());
-	if (it == translation[0].end()) {
-		return message;
+	// The key is put together on the stack, unless it is unusually long.
+	std::array<char, 256> buffer;
+	std::string longKey;
+	const size_t keySize = context.size() + 1 + message.size();
+	char *key = buffer.data();
+	if (keySize > buffer.size()) {
+		longKey.resize(keySize);
+		key = longKey.data();
 	}
-
-	const std::string_view translated = GetTranslation(it->second);
+	std::memcpy(key, context.data(), context.size());
+	key[context.size()] = Glue;
+	std::memcpy(key + context.size() + 1, message.data(), message.size());
+
+	const std::string_view translated = FindTranslation({ key, keySize });
 	// Treat empty translations as missing (prevents invisible UI entries / silent screen reader output).
 	return translated.empty() ? message : translated;
 }
@@ -308,14 +342,7 @@ std::string_view LanguagePluralTranslate(const char *singular, std::string_view
 {
 	const int n = GetLocalPluralId(count);
 
-	auto it = translation[n].find(singular);
-	if (it == translation[n].end()) {
-		if (count != 1)
-			return plural;
-		return singular;
-	}
-
-	const std::string_view translated = GetTranslation(it->second);
+	const std::string_view translated = FindTranslation(singular, static_cast<size_t>(n));
 	if (!translated.empty())
 		return translated;
 	// Treat empty translations as missing.
@@ -326,12 +353,7 @@ std::string_view LanguagePluralTranslate(const char *singular, std::string_view
 
 std::string_view LanguageTranslate(const char *key)
 {
-	auto it = translation[0].find(key);
-	if (it == translation[0].end()) {
-		return key;
-	}
-
-	const std::string_view translated = GetTranslation(it->second);
+	const std::string_view translated = FindTranslation(key);
 	// Treat empty translations as missing.
 	return translated.empty() ? std::string_view(key) : translated;
 }
@@ -359,8 +381,13 @@ std::string_view GetLanguageCode()
 void LanguageInitialize()
 {
 	translation = { {}, {} };
+	translationSlots = {};
+	translationSlotKeys.clear();
+	translationFile = nullptr;
 	translationKeys = nullptr;
 	translationValues = nullptr;
+	translationValuesBase = nullptr;
+	translationDataSize = 0;
 
 	const std::string lang(GetLanguageCode());
 
@@ -476,38 +503,68 @@ void LanguageInitialize()
 		ParseMetadata(&headerValue[0]);
 	}
 
-	translation.resize(PluralForms);
-	for (unsigned i = 0; i < PluralForms; i++)
-		translation[i] = {};
+	// Read strings described by entries.
+	// Plural keys also have a plural form but it does not participate in lookup.
+	// Plural values are \0-terminated, the value includes the terminator of the last form.
+	struct Entry {
+		std::string_view key;
+		std::string_view value;
+	};
+	std::vector<Entry> entries;
+	entries.reserve(head.nbMappings - 1);
+	if (readWholeFile) {
+		for (uint32_t i = 1; i < head.nbMappings; i++) {
+			const std::optional<std::string_view> key = EntryInFile(data.get(), fileSize, src[i]);
+			const std::optional<std::string_view> value = EntryInFile(data.get(), fileSize, dst[i]);
+			if (key && value)
+				entries.push_back({ std::string_view { key->data() }, { value->data(), value->size() + 1 } });
+		}
+		translationFile = std::move(data);
+		translationValuesBase = reinterpret_cast<const char *>(translationFile.get());
+		translationDataSize = fileSize;
+	} else {
+		size_t keysSize = 0;
+		size_t valuesSize = 0;
+		for (uint32_t i = 1; i < head.nbMappings; i++) {
+			keysSize += src[i].length + 1;
+			valuesSize += dst[i].length + 1;
+		}
+		translationKeys = std::unique_ptr<char[]> { new char[keysSize] };
+		translationValues = std::unique_ptr<char[]> { new char[valuesSize] };
 
-	// Read strings described by entries
-	size_t keysSize = 0;
-	size_t valuesSize = 0;
-	for (uint32_t i = 1; i < head.nbMappings; i++) {
-		keysSize += src[i].length + 1;
-		valuesSize += dst[i].length + 1;
-	}
-	translationKeys = std::unique_ptr<char[]> { new char[keysSize] };
-	translationValues = std::unique_ptr<char[]> { new char[valuesSize] };
+		char *keyPtr = &translationKeys[0];
+		char *valuePtr = &translationValues[0];
+		for (uint32_t i = 1; i < head.nbMappings; i++) {
+			if (ReadEntry(handle, src[i], keyPtr) && ReadEntry(handle, dst[i], valuePtr)) {
+				entries.push_back({ std::string_view { keyPtr }, std::string_view { valuePtr, dst[i].length + 1 } });
 
-	char *keyPtr = &translationKeys[0];
-	char *valuePtr = &translationValues[0];
-	translation[0].reserve(head.nbMappings - 1);
-	for (uint32_t i = 1; i < head.nbMappings; i++) {
-		if (readWholeFile
-		        ? ReadEntry(data.get(), fileSize, src[i], keyPtr) && ReadEntry(data.get(), fileSize, dst[i], valuePtr)
-		        : ReadEntry(handle, src[i], keyPtr) && ReadEntry(handle, dst[i], valuePtr)) {
-			// Plural keys also have a plural form but it does not participate in lookup.
-			// Plural values are \0-terminated.
-			std::string_view value { valuePtr, dst[i].length + 1 };
-			for (size_t j = 0; j < PluralForms && !value.empty(); j++) {
-				const size_t formValueEnd = value.find('\0');
-				translation[j].emplace(keyPtr, EncodeTranslationRef(static_cast<uint32_t>(value.data() - &translationValues[0]), static_cast<uint32_t>(formValueEnd)));
-				value.remove_prefix(formValueEnd + 1);
+				keyPtr += src[i].length + 1;
+				valuePtr += dst[i].length + 1;
 			}
+		}
+		translationValuesBase = &translationValues[0];
+		translationDataSize = keysSize + valuesSize;
+	}
+
+	std::vector<uint64_t> hashes;
+	hashes.reserve(entries.size());
+	for (const Entry &entry : entries)
+		hashes.push_back(StringViewHash {}(entry.key));
+	if (!translationSlots.Build(hashes)) {
+		LogError("Two msgids in {} have the same hash, the translations are not used", translationsPath);
+		return;
+	}
 
-			keyPtr += src[i].length + 1;
-			valuePtr += dst[i].length + 1;
+	translationSlotKeys.assign(translationSlots.size(), {});
+	translation.assign(PluralForms, std::vector<TranslationRef>(translationSlots.size(), TranslationRef {}));
+	for (size_t i = 0; i < entries.size(); i++) {
+		const size_t slot = translationSlots.Slot(hashes[i]);
+		translationSlotKeys[slot] = entries[i].key;
+		std::string_view value = entries[i].value;
+		for (size_t j = 0; j < PluralForms && !value.empty(); j++) {
+			const size_t formValueEnd = value.find('\0');
+			translation[j][slot] = { static_cast<uint32_t>(value.data() - translationValuesBase), static_cast<uint32_t>(formValueEnd) };
+			value.remove_prefix(formValueEnd + 1);
 		}
 	}
 
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <string>
 #include <string_view>
 
@@ -16,6 +17,9 @@ std::string_view GetLanguageCode();
 bool HasTranslation(const std::string &locale);
 void LanguageInitialize();
 
+/** @brief Bytes held by the translations of the current language and their lookup tables. */
+size_t LanguageMemoryUsage();
+
 /**
  * @brief Returns the translation for the given key.
  *
@@ -1,7 +1,26 @@
 #include "utils/logged_fstream.hpp"
 
+#if defined(_WIN32)
+#include <io.h>
+#elif defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#endif
+
 namespace devilution {
 
+bool LoggedFStream::Sync()
+{
+	if (!CheckError(std::fflush(s_) == 0, "fflush()"))
+		return false;
+#if defined(_WIN32)
+	return CheckError(_commit(_fileno(s_)) == 0, "_commit()");
+#elif defined(__unix__) || defined(__APPLE__)
+	return CheckError(fsync(fileno(s_)) == 0, "fsync()");
+#else
+	return true;
+#endif
+}
+
 const char *LoggedFStream::DirToString(int dir)
 {
 	switch (dir) {
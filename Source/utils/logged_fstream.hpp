@@ -57,6 +57,9 @@ public:
 		    "fread(out, {})", size);
 	}
 
+	// Writes out the buffered data and, where the platform allows, waits until it is on storage.
+	bool Sync();
+
 private:
 	static const char *DirToString(int dir);
 
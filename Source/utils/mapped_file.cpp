@@ -0,0 +1,96 @@
+/**
+ * @file mapped_file.cpp
+ *
+ * Implementation of read-only memory mappings of whole files.
+ */
+#include "utils/mapped_file.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+
+#if defined(_WIN32) && !defined(DEVILUTIONX_WINDOWS_NO_WCHAR)
+// Suppress definitions of `min` and `max` macros by <windows.h>:
+#define NOMINMAX 1
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+
+#include "utils/file_util.h"
+
+#define DVL_HAS_WINDOWS_MAPPING
+#elif (defined(__unix__) || defined(__APPLE__)) && !defined(__SWITCH__) && !defined(__vita__) && !defined(__3DS__) && !defined(__DJGPP__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define DVL_HAS_POSIX_MAPPING
+#endif
+
+namespace devilution {
+
+#if defined(DVL_HAS_WINDOWS_MAPPING)
+std::unique_ptr<MappedFile> MappedFile::Open(const char *path)
+{
+	const auto pathUtf16 = ToWideChar(path);
+	if (pathUtf16 == nullptr)
+		return nullptr;
+	const HANDLE file = ::CreateFileW(pathUtf16.get(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+		return nullptr;
+	LARGE_INTEGER size;
+	if (!::GetFileSizeEx(file, &size) || size.QuadPart <= 0 || static_cast<uint64_t>(size.QuadPart) > std::numeric_limits<size_t>::max()) {
+		::CloseHandle(file);
+		return nullptr;
+	}
+	const HANDLE mapping = ::CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	// The view keeps the file and the mapping alive on its own.
+	::CloseHandle(file);
+	if (mapping == nullptr)
+		return nullptr;
+	const void *view = ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	::CloseHandle(mapping);
+	if (view == nullptr)
+		return nullptr;
+	return std::unique_ptr<MappedFile>(new MappedFile(static_cast<const std::byte *>(view), static_cast<size_t>(size.QuadPart)));
+}
+
+MappedFile::~MappedFile()
+{
+	::UnmapViewOfFile(data_);
+}
+#elif defined(DVL_HAS_POSIX_MAPPING)
+std::unique_ptr<MappedFile> MappedFile::Open(const char *path)
+{
+	const int fd = ::open(path, O_RDONLY);
+	if (fd == -1)
+		return nullptr;
+	struct stat info;
+	if (::fstat(fd, &info) != 0 || info.st_size <= 0 || static_cast<uintmax_t>(info.st_size) > std::numeric_limits<size_t>::max()) {
+		::close(fd);
+		return nullptr;
+	}
+	const auto size = static_cast<size_t>(info.st_size);
+	void *data = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+	// The mapping keeps the file alive on its own.
+	::close(fd);
+	if (data == MAP_FAILED)
+		return nullptr;
+	return std::unique_ptr<MappedFile>(new MappedFile(static_cast<const std::byte *>(data), size));
+}
+
+MappedFile::~MappedFile()
+{
+	::munmap(const_cast<std::byte *>(data_), size_);
+}
+#else
+std::unique_ptr<MappedFile> MappedFile::Open(const char * /*path*/)
+{
+	return nullptr;
+}
+
+MappedFile::~MappedFile() = default;
+#endif
+
+} // namespace devilution
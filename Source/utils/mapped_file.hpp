@@ -0,0 +1,41 @@
+/**
+ * @file mapped_file.hpp
+ *
+ * Interface of read-only memory mappings of whole files.
+ */
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <span>
+
+namespace devilution {
+
+/** @brief A file mapped read-only into memory, for reading large archives without copying them. */
+class MappedFile {
+public:
+	/** @brief Maps the file, null if it can't be opened or the platform has no memory mapped files. */
+	static std::unique_ptr<MappedFile> Open(const char *path);
+
+	~MappedFile();
+
+	MappedFile(const MappedFile &) = delete;
+	MappedFile &operator=(const MappedFile &) = delete;
+
+	[[nodiscard]] std::span<const std::byte> data() const
+	{
+		return { data_, size_ };
+	}
+
+private:
+	MappedFile(const std::byte *data, size_t size)
+	    : data_(data)
+	    , size_(size)
+	{
+	}
+
+	const std::byte *data_;
+	size_t size_;
+};
+
+} // namespace devilution
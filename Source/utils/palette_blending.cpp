@@ -1,7 +1,10 @@
 #include "utils/palette_blending.hpp"
 
+#include <algorithm>
 #include <array>
 #include <cstdint>
+#include <cstring>
+#include <span>
 
 #ifdef USE_SDL3
 #include <SDL3/SDL_pixels.h>
@@ -25,6 +28,7 @@ uint16_t paletteTransparencyLookupBlack16[65536];
 namespace {
 
 PaletteKdTree CurrentPaletteKdTree;
+PaletteColorLookup CurrentPaletteColorLookup { CurrentPaletteKdTree };
 
 using RGB = std::array<uint8_t, 3>;
 
@@ -44,11 +48,28 @@ void SetPaletteTransparencyLookupBlack16(unsigned i, unsigned j)
 }
 #endif
 
+/** @brief Moves `count` consecutive items of `size` bytes by one, wrapping the one that falls off. */
+void RotateByOne(uint8_t *first, size_t count, size_t size, bool reverse)
+{
+	uint8_t wrapped[256];
+	const size_t moved = (count - 1) * size;
+	if (reverse) {
+		std::memcpy(wrapped, first + moved, size);
+		std::memmove(first + size, first, moved);
+		std::memcpy(first, wrapped, size);
+	} else {
+		std::memcpy(wrapped, first, size);
+		std::memmove(first, first + size, moved);
+		std::memcpy(first + moved, wrapped, size);
+	}
+}
+
 } // namespace
 
 void GenerateBlendedLookupTable(const SDL_Color *palette, int skipFrom, int skipTo)
 {
 	CurrentPaletteKdTree = PaletteKdTree { palette, skipFrom, skipTo };
+	CurrentPaletteColorLookup.clear();
 	for (unsigned i = 0; i < 256; i++) {
 		paletteTransparencyLookup[i][i] = i;
 		unsigned j = 0;
@@ -88,6 +109,34 @@ void UpdateBlendedLookupTableSingleColor(const SDL_Color *palette, unsigned i)
 #endif
 }
 
+uint8_t FindNearestPaletteColor(const std::array<uint8_t, 3> &rgb)
+{
+	return CurrentPaletteColorLookup.findNearestNeighbor(rgb);
+}
+
+void CycleBlendedLookupTable(std::span<const PaletteCycle> cycles)
+{
+	if (cycles.empty())
+		return;
+
+	for (auto &row : paletteTransparencyLookup) {
+		for (const PaletteCycle &cycle : cycles)
+			RotateByOne(&row[cycle.from], cycle.to - cycle.from + 1, 1, cycle.reverse);
+	}
+	for (const PaletteCycle &cycle : cycles)
+		RotateByOne(&paletteTransparencyLookup[cycle.from][0], cycle.to - cycle.from + 1, sizeof(paletteTransparencyLookup[0]), cycle.reverse);
+
+#if DEVILUTIONX_PALETTE_TRANSPARENCY_BLACK_16_LUT
+	unsigned from = cycles.front().from;
+	unsigned to = cycles.front().to;
+	for (const PaletteCycle &cycle : cycles) {
+		from = std::min(from, cycle.from);
+		to = std::max(to, cycle.to);
+	}
+	UpdateTransparencyLookupBlack16(from, to);
+#endif
+}
+
 #if DEVILUTIONX_PALETTE_TRANSPARENCY_BLACK_16_LUT
 void UpdateTransparencyLookupBlack16(unsigned from, unsigned to)
 {
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <array>
 #include <cstdint>
+#include <span>
 
 #ifdef USE_SDL3
 #include <SDL3/SDL_pixels.h>
@@ -33,6 +35,31 @@ void GenerateBlendedLookupTable(const SDL_Color *palette, int skipFrom = -1, int
  */
 void UpdateBlendedLookupTableSingleColor(const SDL_Color *palette, unsigned i);
 
+/**
+ * @brief Finds the palette color nearest to `rgb` rounded to 5 bits per channel, for quantizing truecolor art.
+ *
+ * Uses the palette of the last GenerateBlendedLookupTable() call and skips the same colors.
+ * Each rounded color is only searched for once per palette.
+ */
+uint8_t FindNearestPaletteColor(const std::array<uint8_t, 3> &rgb);
+
+/** @brief A range of palette colors that all move by one index when the palette cycles. */
+struct PaletteCycle {
+	unsigned from;
+	/** Last color of the range. */
+	unsigned to;
+	/** Move the colors to the next index, with the last one wrapping to `from`. */
+	bool reverse;
+};
+
+/**
+ * @brief Moves the transparency lookups of cycled colors along with the colors.
+ *
+ * All cycles are done in one pass over the table, and only the lookups of the cycled colors are updated.
+ * The lookup results aren't changed, so the cycled colors must have been skipped in GenerateBlendedLookupTable().
+ */
+void CycleBlendedLookupTable(std::span<const PaletteCycle> cycles);
+
 #if DEVILUTIONX_PALETTE_TRANSPARENCY_BLACK_16_LUT
 /**
  * A lookup table from black for a pair of colors in `logical_palette`.
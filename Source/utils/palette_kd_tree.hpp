@@ -1,6 +1,7 @@
 #pragma once
 
 #include <array>
+#include <bitset>
 #include <cstddef>
 #include <cstdint>
 #include <limits>
@@ -170,4 +171,56 @@ private:
 	std::array<std::pair<RGB, uint8_t>, 256> values_;
 };
 
+/**
+ * @brief A 32x32x32 table of the nearest palette colors, so that quantizing a truecolor pixel is a lookup.
+ *
+ * Colors are rounded to 5 bits per channel, which is close enough for converting art but not for
+ * blending. Each cell is looked up in the tree the first time it is needed.
+ */
+class PaletteColorLookup {
+private:
+	using RGB = std::array<uint8_t, 3>;
+	static constexpr unsigned Bits = 5;
+	static constexpr unsigned Shift = 8 - Bits;
+	static constexpr size_t NumCells = 1U << (3 * Bits);
+
+public:
+	PaletteColorLookup() = default;
+
+	/** @brief Looks up the colors in `tree`, which must outlive the table. */
+	explicit PaletteColorLookup(const PaletteKdTree &tree)
+	    : tree_(&tree)
+	{
+	}
+
+	[[nodiscard]] uint8_t findNearestNeighbor(const RGB &rgb)
+	{
+		const size_t cell = (static_cast<size_t>(rgb[0] >> Shift) << (2 * Bits))
+		    | (static_cast<size_t>(rgb[1] >> Shift) << Bits)
+		    | (rgb[2] >> Shift);
+		if (!filled_[cell]) {
+			// The center of the cell.
+			constexpr uint8_t Half = 1U << (Shift - 1);
+			cells_[cell] = tree_->findNearestNeighbor({
+			    static_cast<uint8_t>((rgb[0] & ~((1U << Shift) - 1)) | Half),
+			    static_cast<uint8_t>((rgb[1] & ~((1U << Shift) - 1)) | Half),
+			    static_cast<uint8_t>((rgb[2] & ~((1U << Shift) - 1)) | Half),
+			});
+			filled_[cell] = true;
+		}
+		return cells_[cell];
+	}
+
+	/** @brief Forgets the cells looked up so far, call when the tree changed. */
+	void clear()
+	{
+		filled_.reset();
+	}
+
+private:
+	const PaletteKdTree *tree_ = nullptr;
+	std::array<uint8_t, NumCells> cells_;
+	std::bitset<NumCells> filled_;
+};
+
 } // namespace devilution
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <span>
+#include <vector>
+
+namespace devilution {
+
+/**
+ * @brief Maps a fixed set of distinct 64-bit hashes to slots without collisions, by hash and displace.
+ *
+ * Every hash picks a bucket, and every bucket has a seed that was searched for when building so
+ * that its hashes land in slots no other hash has. A lookup is one seed read and one mix, with no
+ * probing. Hashes outside the set map to arbitrary slots, so the caller has to check the key stored
+ * in the slot.
+ */
+class PerfectHash {
+public:
+	/**
+	 * @brief Builds the slots for `hashes`, slot count is a little over the number of hashes.
+	 * @return false if two of the hashes are equal, leaving the table empty
+	 */
+	bool Build(std::span<const uint64_t> hashes)
+	{
+		seeds_.clear();
+		slots_ = 0;
+		if (hashes.empty())
+			return true;
+
+		std::vector<uint64_t> sorted(hashes.begin(), hashes.end());
+		std::sort(sorted.begin(), sorted.end());
+		if (std::adjacent_find(sorted.begin(), sorted.end()) != sorted.end())
+			return false;
+
+		// About four hashes per bucket and one slot in nine left free keep the seed search short.
+		const size_t slots = hashes.size() + hashes.size() / 8 + 1;
+		std::vector<uint32_t> seeds(hashes.size() / 4 + 1);
+		std::vector<std::vector<uint64_t>> buckets(seeds.size());
+		for (const uint64_t hash : hashes)
+			buckets[(hash >> 32) % buckets.size()].push_back(hash);
+
+		// The fullest buckets are placed first, while most slots are still free.
+		std::vector<size_t> order(buckets.size());
+		std::iota(order.begin(), order.end(), 0);
+		std::sort(order.begin(), order.end(), [&buckets](size_t a, size_t b) { return buckets[a].size() > buckets[b].size(); });
+
+		std::vector<bool> taken(slots);
+		std::vector<size_t> placed;
+		for (const size_t bucket : order) {
+			if (buckets[bucket].empty())
+				break;
+			for (uint32_t seed = 0;; seed++) {
+				placed.clear();
+				for (const uint64_t hash : buckets[bucket]) {
+					const size_t slot = SlotFor(hash, seed, slots);
+					if (taken[slot])
+						break;
+					taken[slot] = true;
+					placed.push_back(slot);
+				}
+				if (placed.size() == buckets[bucket].size()) {
+					seeds[bucket] = seed;
+					break;
+				}
+				for (const size_t slot : placed)
+					taken[slot] = false;
+			}
+		}
+
+		seeds_ = std::move(seeds);
+		slots_ = slots;
+		return true;
+	}
+
+	/** @brief Number of slots, 0 if the table is empty. */
+	[[nodiscard]] size_t size() const
+	{
+		return slots_;
+	}
+
+	[[nodiscard]] bool empty() const
+	{
+		return slots_ == 0;
+	}
+
+	/** @brief The slot of `hash`, the table must not be empty. */
+	[[nodiscard]] size_t Slot(uint64_t hash) const
+	{
+		return SlotFor(hash, seeds_[(hash >> 32) % seeds_.size()], slots_);
+	}
+
+private:
+	[[nodiscard]] static size_t SlotFor(uint64_t hash, uint32_t seed, size_t slots)
+	{
+		// The MurmurHash3 finalizer, so that every seed scatters the bucket's hashes anew.
+		uint64_t x = hash ^ (seed * 0x9e3779b97f4a7c15);
+		x ^= x >> 33;
+		x *= 0xff51afd7ed558ccd;
+		x ^= x >> 33;
+		x *= 0xc4ceb9fe1a85ec53;
+		x ^= x >> 33;
+		return static_cast<size_t>(x % slots);
+	}
+
+	std::vector<uint32_t> seeds_;
+	size_t slots_ = 0;
+};
+
+} // namespace devilution
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstdint>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define DEVILUTIONX_PIXEL_DOUBLING_SSE2
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define DEVILUTIONX_PIXEL_DOUBLING_NEON
+#endif
+
+namespace devilution {
+
+/**
+ * @brief Writes every pixel of `src[0, count)` twice to `dst[0, 2 * count)`.
+ *
+ * The pixels are processed from right to left, so `dst` may point into the same row as `src`
+ * as long as it does not start before it. That is how the viewport is zoomed in place.
+ *
+ * SSE2 and NEON are part of every x86-64 and AArch64 CPU, so the vector path is picked when compiling.
+ */
+inline void DoublePixels(const uint8_t *src, uint8_t *dst, int count)
+{
+	int i = count;
+#if defined(DEVILUTIONX_PIXEL_DOUBLING_SSE2)
+	while (i >= 16) {
+		i -= 16;
+		const __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(dst + 2 * i + 16), _mm_unpackhi_epi8(pixels, pixels));
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(dst + 2 * i), _mm_unpacklo_epi8(pixels, pixels));
+	}
+#elif defined(DEVILUTIONX_PIXEL_DOUBLING_NEON)
+	while (i >= 16) {
+		i -= 16;
+		const uint8x16_t pixels = vld1q_u8(src + i);
+		vst2q_u8(dst + 2 * i, uint8x16x2_t { { pixels, pixels } });
+	}
+#endif
+	while (i > 0) {
+		--i;
+		const uint8_t pixel = src[i];
+		dst[2 * i] = pixel;
+		dst[2 * i + 1] = pixel;
+	}
+}
+
+} // namespace devilution
@@ -5,8 +5,11 @@
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
+#include <limits>
 #include <optional>
 #include <span>
+#include <string_view>
+#include <vector>
 
 #ifdef USE_SDL3
 #include <SDL3/SDL_timer.h>
@@ -14,25 +17,95 @@
 #include <SDL.h>
 #endif
 
+#include "accessibility_queries.hpp"
 #include "controls/plrctrls.h"
-#include "engine/path.h"
+#include "engine/navigation_field.hpp"
 #include "engine/sound.h"
 #include "engine/sound_pool.hpp"
 #include "inv.h"
 #include "items.h"
 #include "levels/gendung.h"
 #include "levels/tile_properties.hpp"
+#include "lighting.h"
 #include "monster.h"
 #include "objects.h"
 #include "player.h"
 #include "levels/trigs.h"
+#include "lua/lua_global.hpp"
 #include "utils/is_of.hpp"
 #include "utils/screen_reader.hpp"
 
 namespace devilution {
 
+namespace {
+
+struct CustomProximityCue {
+	uint32_t id;
+	Point position;
+	SoundPool::SoundId sound;
+	uint8_t level;
+	bool isSetLevel;
+	_setlevels setLevel;
+};
+
+/** The cues added by mods, in the order they were added. */
+std::vector<CustomProximityCue> CustomProximityCues;
+uint32_t NextCustomProximityCueId = 1;
+
+[[nodiscard]] bool IsOnCurrentLevel(const CustomProximityCue &cue)
+{
+	return cue.level == currlevel && cue.isSetLevel == setlevel && (!setlevel || cue.setLevel == setlvlnum);
+}
+
+[[nodiscard]] CustomProximityCue *FindCustomProximityCue(uint32_t id)
+{
+	const auto it = std::find_if(CustomProximityCues.begin(), CustomProximityCues.end(), [id](const CustomProximityCue &cue) { return cue.id == id; });
+	return it != CustomProximityCues.end() ? &*it : nullptr;
+}
+
+} // namespace
+
+uint32_t AddCustomProximityCue(Point position, SoundPool::SoundId sound)
+{
+	// Cues of levels the player left are only dropped once room is needed, they play again on return.
+	if (CustomProximityCues.size() >= MaxCustomProximityCues)
+		std::erase_if(CustomProximityCues, [](const CustomProximityCue &cue) { return !IsOnCurrentLevel(cue); });
+	if (CustomProximityCues.size() >= MaxCustomProximityCues || sound >= SoundPool::SoundId::COUNT)
+		return 0;
+
+	const uint32_t id = NextCustomProximityCueId;
+	// The id has to fit in the 24 bits MakeEmitterId keeps.
+	NextCustomProximityCueId = NextCustomProximityCueId % 0x00FFFFFF + 1;
+	CustomProximityCues.push_back(CustomProximityCue { id, position, sound, currlevel, setlevel, setlvlnum });
+	return id;
+}
+
+bool MoveCustomProximityCue(uint32_t id, Point position)
+{
+	CustomProximityCue *cue = FindCustomProximityCue(id);
+	if (cue == nullptr)
+		return false;
+	cue->position = position;
+	return true;
+}
+
+void RemoveCustomProximityCue(uint32_t id)
+{
+	std::erase_if(CustomProximityCues, [id](const CustomProximityCue &cue) { return cue.id == id; });
+}
+
+void ClearCustomProximityCues()
+{
+	CustomProximityCues.clear();
+}
+
 #ifdef NOSOUND
 
+bool accessibility_queries::HasInteractTargetInRange([[maybe_unused]] const Player &player, [[maybe_unused]] Point playerPosition)
+{
+	return false;
+}
+
 void UpdateProximityAudioCues()
 {
 }
@@ -43,7 +116,10 @@ namespace {
 
 constexpr int MaxCueDistanceTiles = 12;
 constexpr int InteractDistanceTiles = 1;
-constexpr size_t MaxEmitters = 3;
+constexpr size_t MaxEmitters = SoundPool::MaxVoices;
+// Emitters behind a wall are played quieter and lose their voice to ones in sight.
+constexpr int OccludedAttenuation = -1200;
+constexpr int OccludedDistancePenalty = 4;
 
 constexpr uint32_t MinIntervalMs = 250;
 constexpr uint32_t MaxIntervalMs = 1000;
@@ -69,6 +145,7 @@ enum class EmitterType : uint8_t {
 	Object = 2,
 	Monster = 3,
 	Trigger = 4,
+	Custom = 5,
 };
 
 [[nodiscard]] constexpr uint32_t MakeEmitterId(EmitterType type, uint32_t id)
@@ -128,26 +205,74 @@ enum class EmitterType : uint8_t {
 	return d;
 }
 
-[[nodiscard]] bool IsReachableWithinSteps(const Player &player, Point start, Point destination, size_t maxSteps)
-{
-	if (maxSteps == 0)
-		return start == destination;
+/**
+ * Which tiles around the player can be walked to (or, for solid targets such as chests, stepped
+ * against) within InteractDistanceTiles steps. Matches what FindPath would allow, but costs a single
+ * small breadth-first search instead of one search per tile.
+ */
+class InteractReachMask {
+public:
+	InteractReachMask(const Player &player, Point playerPosition)
+	    : origin_(playerPosition - Displacement { InteractDistanceTiles, InteractDistanceTiles })
+	{
+		std::array<uint8_t, AreaSize * AreaSize> steps;
+		steps.fill(std::numeric_limits<uint8_t>::max());
+		std::array<Point, AreaSize * AreaSize> queue;
+		size_t queueSize = 0;
+
+		steps[IndexOf(playerPosition)] = 0;
+		reachable_[IndexOf(playerPosition)] = true;
+		queue[queueSize++] = playerPosition;
+		for (size_t head = 0; head < queueSize; head++) {
+			const Point current = queue[head];
+			const uint8_t nextSteps = steps[IndexOf(current)] + 1;
+			if (nextSteps > InteractDistanceTiles)
+				continue;
+			for (const Direction direction : { Direction::South, Direction::SouthWest, Direction::West, Direction::NorthWest, Direction::North, Direction::NorthEast, Direction::East, Direction::SouthEast }) {
+				const Point next = current + direction;
+				if (!IsInArea(next) || steps[IndexOf(next)] <= nextSteps)
+					continue;
+				if (!PosOkPlayer(player, next)) {
+					// Like FindPath, a blocked tile can still be the destination, it just can't be walked through.
+					reachable_[IndexOf(next)] = true;
+					continue;
+				}
+				if (!CanStep(current, next))
+					continue;
+				steps[IndexOf(next)] = nextSteps;
+				reachable_[IndexOf(next)] = true;
+				queue[queueSize++] = next;
+			}
+		}
+	}
 
-	if (start == destination)
-		return true;
+	[[nodiscard]] bool IsReachable(Point position) const
+	{
+		return IsInArea(position) && reachable_[IndexOf(position)];
+	}
 
-	if (start.WalkingDistance(destination) > static_cast<int>(maxSteps))
-		return false;
+private:
+	static constexpr int AreaSize = 2 * InteractDistanceTiles + 1;
 
-	std::array<int8_t, InteractDistanceTiles> path;
-	path.fill(WALK_NONE);
+	[[nodiscard]] bool IsInArea(Point position) const
+	{
+		const Displacement offset = position - origin_;
+		return offset.deltaX >= 0 && offset.deltaX < AreaSize && offset.deltaY >= 0 && offset.deltaY < AreaSize;
+	}
 
-	const int steps = FindPath(CanStep, [&player](Point position) { return PosOkPlayer(player, position); }, start, destination, path.data(), path.size());
-	return steps != 0 && steps <= static_cast<int>(maxSteps);
-}
+	[[nodiscard]] size_t IndexOf(Point position) const
+	{
+		const Displacement offset = position - origin_;
+		return static_cast<size_t>(offset.deltaX + offset.deltaY * AreaSize);
+	}
+
+	Point origin_;
+	std::array<bool, AreaSize * AreaSize> reachable_ {};
+};
 
 std::optional<InteractTarget> FindInteractTargetInRange(const Player &player, Point playerPosition)
 {
+	const InteractReachMask reach { player, playerPosition };
 	int rotations = 5;
 	std::optional<InteractTarget> best;
 
@@ -168,7 +293,7 @@ std::optional<InteractTarget> FindInteractTargetInRange(const Player &player, Po
 			const int newRotations = GetRotaryDistanceForInteractTarget(player, targetPosition);
 			if (rotations < newRotations)
 				continue;
-			if (targetPosition != playerPosition && !IsReachableWithinSteps(player, playerPosition, targetPosition, InteractDistanceTiles))
+			if (!reach.IsReachable(targetPosition))
 				continue;
 
 			rotations = newRotations;
@@ -200,7 +325,7 @@ std::optional<InteractTarget> FindInteractTargetInRange(const Player &player, Po
 			const int newRotations = GetRotaryDistanceForInteractTarget(player, targetPosition);
 			if (rotations < newRotations)
 				continue;
-			if (targetPosition != playerPosition && !IsReachableWithinSteps(player, playerPosition, targetPosition, InteractDistanceTiles))
+			if (!reach.IsReachable(targetPosition))
 				continue;
 
 			const int objectId = static_cast<int>(object - Objects);
@@ -237,12 +362,12 @@ std::optional<InteractTarget> FindInteractTargetInRange(const Player &player, Po
 			const Item &item = Items[target->id];
 			const StringOrView name = item.getName();
 			if (!name.empty())
-				SpeakText(name.str(), /*force=*/true);
+				SpeakText(name.str(), /*force=*/true, SpeechPriority::Interrupt, SpeechChannel::Navigation);
 		} else {
 			const Object &object = Objects[target->id];
 			const StringOrView name = object.name();
 			if (!name.empty())
-				SpeakText(name.str(), /*force=*/true);
+				SpeakText(name.str(), /*force=*/true, SpeechPriority::Interrupt, SpeechChannel::Navigation);
 		}
 	}
 
@@ -253,48 +378,153 @@ std::optional<InteractTarget> FindInteractTargetInRange(const Player &player, Po
 	return true;
 }
 
+constexpr std::array<std::string_view, 6> WeaponCuePaths = { "audio\\weapon.ogg", "..\\audio\\weapon.ogg", "audio\\weapon.wav", "..\\audio\\weapon.wav", "audio\\weapon.mp3", "..\\audio\\weapon.mp3" };
+constexpr std::array<std::string_view, 6> ArmorCuePaths = { "audio\\armor.ogg", "..\\audio\\armor.ogg", "audio\\armor.wav", "..\\audio\\armor.wav", "audio\\armor.mp3", "..\\audio\\armor.mp3" };
+constexpr std::array<std::string_view, 6> GoldCuePaths = { "audio\\coin.ogg", "..\\audio\\coin.ogg", "audio\\coin.wav", "..\\audio\\coin.wav", "audio\\coin.mp3", "..\\audio\\coin.mp3" };
+constexpr std::array<std::string_view, 8> PotionCuePaths = { "audio\\potion.ogg", "..\\audio\\potion.ogg", "audio\\potion.wav", "..\\audio\\potion.wav", "audio\\Potion.wav", "..\\audio\\Potion.wav", "audio\\potion.mp3", "..\\audio\\potion.mp3" };
+constexpr std::array<std::string_view, 8> ScrollCuePaths = { "audio\\scroll.ogg", "..\\audio\\scroll.ogg", "audio\\scroll.wav", "..\\audio\\scroll.wav", "audio\\Scroll.wav", "..\\audio\\Scroll.wav", "audio\\scroll.mp3", "..\\audio\\scroll.mp3" };
+constexpr std::array<std::string_view, 6> ChestCuePaths = { "audio\\chest.ogg", "..\\audio\\chest.ogg", "audio\\chest.wav", "..\\audio\\chest.wav", "audio\\chest.mp3", "..\\audio\\chest.mp3" };
+constexpr std::array<std::string_view, 8> DoorCuePaths = { "audio\\door.ogg", "..\\audio\\door.ogg", "audio\\door.wav", "..\\audio\\door.wav", "audio\\Door.wav", "..\\audio\\Door.wav", "audio\\door.mp3", "..\\audio\\door.mp3" };
+constexpr std::array<std::string_view, 8> StairsCuePaths = { "audio\\stairs.ogg", "..\\audio\\stairs.ogg", "audio\\stairs.wav", "..\\audio\\stairs.wav", "audio\\Stairs.wav", "..\\audio\\Stairs.wav", "audio\\stairs.mp3", "..\\audio\\stairs.mp3" };
+constexpr std::array<std::string_view, 6> MonsterCuePaths = { "audio\\monster.ogg", "..\\audio\\monster.ogg", "audio\\monster.wav", "..\\audio\\monster.wav", "audio\\monster.mp3", "..\\audio\\monster.mp3" };
+constexpr std::array<std::string_view, 12> InteractCuePaths = {
+	"audio\\interactispossible.ogg",
+	"audio\\interactionispossible.ogg",
+	"..\\audio\\interactispossible.ogg",
+	"..\\audio\\interactionispossible.ogg",
+	"audio\\interactispossible.wav",
+	"audio\\interactionispossible.wav",
+	"..\\audio\\interactispossible.wav",
+	"..\\audio\\interactionispossible.wav",
+	"audio\\interactispossible.mp3",
+	"audio\\interactionispossible.mp3",
+	"..\\audio\\interactispossible.mp3",
+	"..\\audio\\interactionispossible.mp3",
+};
+
+struct NavigationCue {
+	SoundPool::SoundId sound;
+	std::span<const std::string_view> candidatePaths;
+};
+
+/** Where each navigation cue may be found, in the order the files are tried. */
+constexpr std::array<NavigationCue, static_cast<size_t>(SoundPool::SoundId::COUNT)> NavigationCues = {
+	NavigationCue { SoundPool::SoundId::WeaponItem, WeaponCuePaths },
+	NavigationCue { SoundPool::SoundId::ArmorItem, ArmorCuePaths },
+	NavigationCue { SoundPool::SoundId::GoldItem, GoldCuePaths },
+	NavigationCue { SoundPool::SoundId::PotionItem, PotionCuePaths },
+	NavigationCue { SoundPool::SoundId::ScrollItem, ScrollCuePaths },
+	NavigationCue { SoundPool::SoundId::Chest, ChestCuePaths },
+	NavigationCue { SoundPool::SoundId::Door, DoorCuePaths },
+	NavigationCue { SoundPool::SoundId::Stairs, StairsCuePaths },
+	NavigationCue { SoundPool::SoundId::Monster, MonsterCuePaths },
+	NavigationCue { SoundPool::SoundId::Interact, InteractCuePaths },
+};
+
+/**
+ * @brief Resolves the cues that haven't been looked up since the pool was last cleared.
+ *
+ * Each cue is probed once, after that this only checks a flag per cue.
+ */
 void EnsureNavigationSoundsLoaded(SoundPool &pool)
 {
-	(void)pool.EnsureLoaded(SoundPool::SoundId::WeaponItem, { "audio\\weapon.ogg", "..\\audio\\weapon.ogg", "audio\\weapon.wav", "..\\audio\\weapon.wav", "audio\\weapon.mp3", "..\\audio\\weapon.mp3" });
-	(void)pool.EnsureLoaded(SoundPool::SoundId::ArmorItem, { "audio\\armor.ogg", "..\\audio\\armor.ogg", "audio\\armor.wav", "..\\audio\\armor.wav", "audio\\armor.mp3", "..\\audio\\armor.mp3" });
-	(void)pool.EnsureLoaded(SoundPool::SoundId::GoldItem, { "audio\\coin.ogg", "..\\audio\\coin.ogg", "audio\\coin.wav", "..\\audio\\coin.wav", "audio\\coin.mp3", "..\\audio\\coin.mp3" });
-	(void)pool.EnsureLoaded(SoundPool::SoundId::PotionItem, { "audio\\potion.ogg", "..\\audio\\potion.ogg", "audio\\potion.wav", "..\\audio\\potion.wav", "audio\\Potion.wav", "..\\audio\\Potion.wav", "audio\\potion.mp3", "..\\audio\\potion.mp3" });
-	(void)pool.EnsureLoaded(SoundPool::SoundId::ScrollItem, { "audio\\scroll.ogg", "..\\audio\\scroll.ogg", "audio\\scroll.wav", "..\\audio\\scroll.wav", "audio\\Scroll.wav", "..\\audio\\Scroll.wav", "audio\\scroll.mp3", "..\\audio\\scroll.mp3" });
-
-	(void)pool.EnsureLoaded(SoundPool::SoundId::Chest, { "audio\\chest.ogg", "..\\audio\\chest.ogg", "audio\\chest.wav", "..\\audio\\chest.wav", "audio\\chest.mp3", "..\\audio\\chest.mp3" });
-	(void)pool.EnsureLoaded(SoundPool::SoundId::Door, { "audio\\door.ogg", "..\\audio\\door.ogg", "audio\\door.wav", "..\\audio\\door.wav", "audio\\Door.wav", "..\\audio\\Door.wav", "audio\\door.mp3", "..\\audio\\door.mp3" });
-	(void)pool.EnsureLoaded(SoundPool::SoundId::Stairs, { "audio\\stairs.ogg", "..\\audio\\stairs.ogg", "audio\\stairs.wav", "..\\audio\\stairs.wav", "audio\\Stairs.wav", "..\\audio\\Stairs.wav", "audio\\stairs.mp3", "..\\audio\\stairs.mp3" });
-
-	(void)pool.EnsureLoaded(SoundPool::SoundId::Monster, { "audio\\monster.ogg", "..\\audio\\monster.ogg", "audio\\monster.wav", "..\\audio\\monster.wav", "audio\\monster.mp3", "..\\audio\\monster.mp3" });
-
-	(void)pool.EnsureLoaded(SoundPool::SoundId::Interact, {
-	                                            "audio\\interactispossible.ogg",
-	                                            "audio\\interactionispossible.ogg",
-	                                            "..\\audio\\interactispossible.ogg",
-	                                            "..\\audio\\interactionispossible.ogg",
-	                                            "audio\\interactispossible.wav",
-	                                            "audio\\interactionispossible.wav",
-	                                            "..\\audio\\interactispossible.wav",
-	                                            "..\\audio\\interactionispossible.wav",
-	                                            "audio\\interactispossible.mp3",
-	                                            "audio\\interactionispossible.mp3",
-	                                            "..\\audio\\interactispossible.mp3",
-	                                            "..\\audio\\interactionispossible.mp3",
-	                                        });
+	for (const NavigationCue &cue : NavigationCues) {
+		if (!pool.IsResolved(cue.sound))
+			(void)pool.EnsureLoaded(cue.sound, cue.candidatePaths);
+	}
+}
+
+// Mods may override the cue files, look them up again once the archives changed.
+void NavigationCuesModChanged()
+{
+	SoundPool::Get().Clear();
+	ClearCustomProximityCues();
+}
+
+const auto NavigationCuesModChangedHandler = (AddModsChangedHandler(NavigationCuesModChanged), true);
+
+constexpr std::array<Displacement, NavigationField::MaxDirections> CueFieldDirections = {
+	Displacement { 0, -1 },
+	Displacement { 0, 1 },
+	Displacement { 1, 0 },
+	Displacement { -1, 0 },
+	Displacement { -1, -1 },
+	Displacement { 1, -1 },
+	Displacement { 1, 1 },
+	Displacement { -1, 1 },
+};
+
+struct CueDistanceFieldKey {
+	Point root;
+	uint8_t level;
+	bool isSetLevel;
+	_setlevels setLevel;
+	uint32_t objectGeneration;
+
+	bool operator==(const CueDistanceFieldKey &other) const = default;
+};
+
+/**
+ * Walking distances from the player, so a cue's tempo follows the walk rather than the straight
+ * line. Monsters and players are ignored so that the field only has to be rebuilt when the player
+ * reaches another tile or the map changes.
+ */
+std::optional<NavigationField> CueDistanceField;
+std::optional<CueDistanceFieldKey> CueDistanceFieldBuiltFor;
+
+const NavigationField &GetCueDistanceField(Point playerPosition)
+{
+	const CueDistanceFieldKey key { playerPosition, currlevel, setlevel, setlvlnum, ObjectWalkabilityGeneration };
+	if (!CueDistanceField)
+		CueDistanceField.emplace();
+	if (CueDistanceFieldBuiltFor != key) {
+		CueDistanceField->Build(
+		    playerPosition, CueFieldDirections, [](Point position) { return IsTileWalkable(position, /*ignoreDoors=*/true); }, CanStep);
+		CueDistanceFieldBuiltFor = key;
+	}
+	return *CueDistanceField;
+}
+
+/**
+ * @brief The number of steps to walk to `position`, or next to it for solid targets such as chests.
+ *
+ * Falls back to the straight line distance if the tile can't be walked to at all.
+ */
+[[nodiscard]] int GetCueWalkingDistance(const NavigationField &field, Point playerPosition, Point position)
+{
+	NavigationField::DistanceType distance = field.Distance(position);
+	if (distance == NavigationField::Unreachable) {
+		for (const Displacement step : CueFieldDirections) {
+			const NavigationField::DistanceType neighbourDistance = field.Distance(position + step);
+			if (neighbourDistance != NavigationField::Unreachable)
+				distance = std::min<NavigationField::DistanceType>(distance, neighbourDistance + 1);
+		}
+	}
+	if (distance == NavigationField::Unreachable)
+		return playerPosition.ApproxDistance(position);
+	return distance;
 }
 
 struct CandidateEmitter {
 	uint32_t emitterId;
 	SoundPool::SoundId sound;
 	Point position;
+	bool occluded;
 	int distance;
 	uint32_t intervalMs;
 };
 
+[[nodiscard]] int GetCandidatePriority(const CandidateEmitter &candidate)
+{
+	return candidate.occluded ? candidate.distance + OccludedDistancePenalty : candidate.distance;
+}
+
 [[nodiscard]] bool IsBetterCandidate(const CandidateEmitter &a, const CandidateEmitter &b)
 {
-	if (a.distance != b.distance)
-		return a.distance < b.distance;
+	const int priorityA = GetCandidatePriority(a);
+	const int priorityB = GetCandidatePriority(b);
+	if (priorityA != priorityB)
+		return priorityA < priorityB;
 	return a.emitterId < b.emitterId;
 }
 
@@ -331,12 +561,13 @@ void UpdateProximityAudioCues()
 	const uint32_t now = SDL_GetTicks();
 	const Point playerPosition { MyPlayer->position.future };
 
-	// Interact cue is a one-shot that should be clearly audible and not counted in the 3-emitter limit.
+	// Interact cue is a one-shot that should be clearly audible and not counted in the voice limit.
 	if (UpdateInteractCue(playerPosition, now))
 		return;
 
 	std::array<std::optional<CandidateEmitter>, MaxEmitters> best;
 	best.fill(std::nullopt);
+	const NavigationField &cueField = GetCueDistanceField(playerPosition);
 
 	for (uint8_t i = 0; i < ActiveItemCount; i++) {
 		const int itemId = ActiveItems[i];
@@ -372,13 +603,15 @@ void UpdateProximityAudioCues()
 		const int distance = playerPosition.ApproxDistance(item.position);
 		if (distance > MaxCueDistanceTiles)
 			continue;
+		const int walkingDistance = GetCueWalkingDistance(cueField, playerPosition, item.position);
 
 		ConsiderCandidate(best, CandidateEmitter {
 		                        .emitterId = MakeEmitterId(EmitterType::Item, static_cast<uint32_t>(itemId)),
 		                        .sound = soundId,
 		                        .position = item.position,
-		                        .distance = distance,
-		                        .intervalMs = IntervalMsForDistance(distance, MaxCueDistanceTiles, MinIntervalMs, MaxIntervalMs),
+		                        .occluded = IsOccludedFromMyPlayer(item.position),
+		                        .distance = walkingDistance,
+		                        .intervalMs = IntervalMsForDistance(walkingDistance, MaxCueDistanceTiles, MinIntervalMs, MaxIntervalMs),
 		                    });
 	}
 
@@ -405,13 +638,15 @@ void UpdateProximityAudioCues()
 			const int distance = playerPosition.ApproxDistance(object.position);
 			if (distance > MaxCueDistanceTiles)
 				continue;
+			const int walkingDistance = GetCueWalkingDistance(cueField, playerPosition, object.position);
 
 			ConsiderCandidate(best, CandidateEmitter {
 			                        .emitterId = MakeEmitterId(EmitterType::Object, static_cast<uint32_t>(objectId)),
 			                        .sound = soundId,
 			                        .position = object.position,
-			                        .distance = distance,
-			                        .intervalMs = IntervalMsForDistance(distance, MaxCueDistanceTiles, MinIntervalMs, MaxIntervalMs),
+			                        .occluded = IsOccludedFromMyPlayer(object.position),
+			                        .distance = walkingDistance,
+			                        .intervalMs = IntervalMsForDistance(walkingDistance, MaxCueDistanceTiles, MinIntervalMs, MaxIntervalMs),
 			                    });
 		}
 
@@ -426,47 +661,64 @@ void UpdateProximityAudioCues()
 			const int distance = playerPosition.ApproxDistance(triggerPosition);
 			if (distance > MaxCueDistanceTiles)
 				continue;
+			const int walkingDistance = GetCueWalkingDistance(cueField, playerPosition, triggerPosition);
 
 			ConsiderCandidate(best, CandidateEmitter {
 			                        .emitterId = MakeEmitterId(EmitterType::Trigger, static_cast<uint32_t>(i)),
 			                        .sound = SoundPool::SoundId::Stairs,
 			                        .position = triggerPosition,
-			                        .distance = distance,
-			                        .intervalMs = IntervalMsForDistance(distance, MaxCueDistanceTiles, MinIntervalMs, MaxIntervalMs),
+			                        .occluded = IsOccludedFromMyPlayer(triggerPosition),
+			                        .distance = walkingDistance,
+			                        .intervalMs = IntervalMsForDistance(walkingDistance, MaxCueDistanceTiles, MinIntervalMs, MaxIntervalMs),
 			                    });
 		}
 
-		for (size_t i = 0; i < ActiveMonsterCount; i++) {
-			const int monsterId = static_cast<int>(ActiveMonsters[i]);
-			const Monster &monster = Monsters[monsterId];
-
-			if (monster.isInvalid)
-				continue;
-			if ((monster.flags & MFLAG_HIDDEN) != 0)
-				continue;
-			if (monster.hitPoints <= 0)
+		const ActiveMonsterHotState &hot = ActiveMonsterHot;
+		for (size_t i = 0; i < hot.count; i++) {
+			if (!hot.isPresent(i))
 				continue;
+			const int monsterId = hot.id[i];
 
 			if (!pool.IsLoaded(SoundPool::SoundId::Monster))
 				continue;
 
 			// Use the future position for distance/tempo so cues react immediately when a monster starts moving.
-			const Point monsterSoundPosition { monster.position.tile };
-			const Point monsterDistancePosition { monster.position.future };
+			const Point monsterSoundPosition { hot.tile[i] };
+			const Point monsterDistancePosition { hot.future[i] };
 			const int distance = playerPosition.ApproxDistance(monsterDistancePosition);
 			if (distance > MaxCueDistanceTiles)
 				continue;
+			const int walkingDistance = GetCueWalkingDistance(cueField, playerPosition, monsterDistancePosition);
 
 			ConsiderCandidate(best, CandidateEmitter {
 			                        .emitterId = MakeEmitterId(EmitterType::Monster, static_cast<uint32_t>(monsterId)),
 			                        .sound = SoundPool::SoundId::Monster,
 			                        .position = monsterSoundPosition,
-			                        .distance = distance,
-			                        .intervalMs = IntervalMsForDistance(distance, MaxCueDistanceTiles, MinMonsterIntervalMs, MaxMonsterIntervalMs),
+			                        .occluded = IsOccludedFromMyPlayer(monsterSoundPosition),
+			                        .distance = walkingDistance,
+			                        .intervalMs = IntervalMsForDistance(walkingDistance, MaxCueDistanceTiles, MinMonsterIntervalMs, MaxMonsterIntervalMs),
 			                    });
 		}
 	}
 
+	for (const CustomProximityCue &cue : CustomProximityCues) {
+		if (!IsOnCurrentLevel(cue) || !pool.IsLoaded(cue.sound))
+			continue;
+		const int distance = playerPosition.ApproxDistance(cue.position);
+		if (distance > MaxCueDistanceTiles)
+			continue;
+		const int walkingDistance = GetCueWalkingDistance(cueField, playerPosition, cue.position);
+
+		ConsiderCandidate(best, CandidateEmitter {
+		                        .emitterId = MakeEmitterId(EmitterType::Custom, cue.id),
+		                        .sound = cue.sound,
+		                        .position = cue.position,
+		                        .occluded = IsOccludedFromMyPlayer(cue.position),
+		                        .distance = walkingDistance,
+		                        .intervalMs = IntervalMsForDistance(walkingDistance, MaxCueDistanceTiles, MinIntervalMs, MaxIntervalMs),
+		                    });
+	}
+
 	std::array<SoundPool::EmitterRequest, MaxEmitters> requests;
 	size_t requestCount = 0;
 	for (const auto &entry : best) {
@@ -477,12 +729,19 @@ void UpdateProximityAudioCues()
 			.sound = entry->sound,
 			.position = entry->position,
 			.intervalMs = entry->intervalMs,
+			.priority = GetCandidatePriority(*entry),
+			.attenuation = entry->occluded ? OccludedAttenuation : 0,
 		};
 	}
 
 	pool.UpdateEmitters(std::span<const SoundPool::EmitterRequest>(requests.data(), requestCount), now);
 }
 
+bool accessibility_queries::HasInteractTargetInRange(const Player &player, Point playerPosition)
+{
+	return FindInteractTargetInRange(player, playerPosition).has_value();
+}
+
 #endif // NOSOUND
 
 } // namespace devilution
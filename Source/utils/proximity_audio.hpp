@@ -1,8 +1,29 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+
+#include "engine/point.hpp"
+#include "engine/sound_pool.hpp"
+
 namespace devilution {
 
 void UpdateProximityAudioCues();
 
-} // namespace devilution
+/** Most cues mods can add at once, so a script can't flood the voice assignment. */
+constexpr size_t MaxCustomProximityCues = 64;
 
+/**
+ * @brief Adds a repeating cue at a tile of the current level, e.g. for a mod's own points of interest.
+ *
+ * It competes for a voice with the built-in cues and is dropped when the player leaves the level or
+ * the mods are reloaded.
+ * @return The cue's id, 0 if there are MaxCustomProximityCues already
+ */
+uint32_t AddCustomProximityCue(Point position, SoundPool::SoundId sound);
+/** @brief Moves a cue added with AddCustomProximityCue(), false if it's gone. */
+bool MoveCustomProximityCue(uint32_t id, Point position);
+void RemoveCustomProximityCue(uint32_t id);
+void ClearCustomProximityCues();
+
+} // namespace devilution
@@ -1,55 +1,291 @@
 #include "utils/screen_reader.hpp"
 
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
 #include <string_view>
+#include <utility>
 
-#ifdef _WIN32
-#include "utils/file_util.h"
-#include <Tolk.h>
-#else
-#include <speech-dispatcher/libspeechd.h>
-#endif
+#include "engine/tracing.hpp"
+#include "utils/log.hpp"
+#include "utils/sdl_cond.h"
+#include "utils/sdl_mutex.h"
+#include "utils/sdl_thread.h"
 
 namespace devilution {
 
-#ifndef _WIN32
-SPDConnection *Speechd;
-#endif
+namespace {
+
+constexpr size_t SpeechChannelCount = static_cast<size_t>(SpeechChannel::COUNT);
+
+/** Most messages that can wait to be spoken per channel, the oldest one is dropped to make room. */
+constexpr size_t MaxQueuedSpeech = 4;
+
+/**
+ * Shortest time between two messages of a channel. Bursts of announcements in a fight get
+ * thinned out to the latest ones instead of keeping the screen reader busy.
+ */
+constexpr std::array<std::chrono::milliseconds, SpeechChannelCount> SpeechChannelIntervals = {
+	std::chrono::milliseconds { 0 },   // UI
+	std::chrono::milliseconds { 100 }, // Navigation
+	std::chrono::milliseconds { 100 }, // Combat
+	std::chrono::milliseconds { 0 },   // Chat
+};
+
+/** How many of the latest messages the trace keeps. */
+constexpr size_t SpeechTraceSize = 64;
+
+struct PendingSpeech {
+	std::string text;
+	bool interrupt;
+	/** The message's entry in the trace, 0 if it isn't traced. */
+	uint32_t traceId;
+};
+
+struct SpeechChannelQueue {
+	std::deque<PendingSpeech> pending;
+	std::chrono::steady_clock::time_point nextAllowed;
+};
+
+struct SpeechState {
+	SdlMutex mutex;
+	SdlCond wakeUp;
+	std::array<SpeechChannelQueue, SpeechChannelCount> channels;
+	bool stop = false;
+	SpeechLatency latency;
+
+	bool traceEnabled = false;
+	uint32_t nextTraceId = 1;
+	/** Indexed by trace id, so the oldest entry gets overwritten. */
+	std::array<SpeechTraceEntry, SpeechTraceSize> trace;
+	std::array<uint32_t, SpeechTraceSize> traceIds {};
+	/** The message that was handed to the backend last. */
+	uint32_t lastSpokenTraceId = 0;
+};
+
+std::optional<SpeechState> State;
+SdlThread SpeechThread;
+
+/** Only used by the speech thread while it runs. */
+std::unique_ptr<SpeechBackend> Backend;
+
+/** @brief The entry of a traced message that is still in the trace, the state's mutex has to be held. */
+SpeechTraceEntry *FindTraceEntry(SpeechState &state, uint32_t traceId)
+{
+	if (traceId == 0)
+		return nullptr;
+	const size_t index = traceId % SpeechTraceSize;
+	if (state.traceIds[index] != traceId)
+		return nullptr;
+	return &state.trace[index];
+}
+
+/** Owns the speech backend, so a slow one only ever holds up this thread. */
+void SpeechLoop()
+{
+	SpeechState &state = *State;
+	const bool opened = Backend->Open();
+	const std::string backendName = Backend->Name();
+	if (opened)
+		LogVerbose("Speaking through {}", backendName);
+	else
+		LogWarn("Speech backend {} is not available", backendName);
+
+	std::unique_lock<SdlMutex> lock(state.mutex);
+	state.latency.backend = backendName;
+	while (!state.stop) {
+		// Channels are served in order, so UI messages go first.
+		const auto now = std::chrono::steady_clock::now();
+		std::optional<std::chrono::steady_clock::time_point> nextDue;
+		SpeechChannelQueue *ready = nullptr;
+		size_t readyIndex = 0;
+		for (size_t i = 0; i < SpeechChannelCount; i++) {
+			SpeechChannelQueue &channel = state.channels[i];
+			if (channel.pending.empty())
+				continue;
+			if (channel.nextAllowed <= now) {
+				ready = &channel;
+				readyIndex = i;
+				break;
+			}
+			if (!nextDue || channel.nextAllowed < *nextDue)
+				nextDue = channel.nextAllowed;
+		}
+
+		if (ready == nullptr) {
+			if (nextDue) {
+				const auto wait = std::chrono::ceil<std::chrono::milliseconds>(*nextDue - now);
+				state.wakeUp.waitFor(state.mutex, static_cast<uint32_t>(wait.count()));
+			} else {
+				state.wakeUp.wait(state.mutex);
+			}
+			continue;
+		}
+
+		const PendingSpeech speech = std::move(ready->pending.front());
+		ready->pending.pop_front();
+		ready->nextAllowed = now + SpeechChannelIntervals[readyIndex];
+
+		lock.unlock();
+		// Asked before speaking, so it is about the previous message.
+		const std::optional<std::chrono::microseconds> previousOutput = Backend->OutputLatency();
+		const auto handedOff = std::chrono::steady_clock::now();
+		if (opened)
+			Backend->Speak(speech.text, speech.interrupt);
+		const auto returned = std::chrono::steady_clock::now();
+		lock.lock();
+		state.latency.blocking = std::chrono::duration_cast<std::chrono::microseconds>(returned - handedOff);
+		state.latency.previousOutput = previousOutput;
+		if (SpeechTraceEntry *previous = FindTraceEntry(state, state.lastSpokenTraceId); previous != nullptr)
+			previous->outputLatency = previousOutput;
+		if (SpeechTraceEntry *entry = FindTraceEntry(state, speech.traceId); entry != nullptr) {
+			entry->handedOff = handedOff;
+			entry->returned = returned;
+		}
+		state.lastSpokenTraceId = speech.traceId;
+	}
+	lock.unlock();
+
+	Backend->Close();
+}
+
+} // namespace
 
 void InitializeScreenReader()
 {
-#ifdef _WIN32
-	Tolk_Load();
-#else
-	Speechd = spd_open("DevilutionX", "DevilutionX", NULL, SPD_MODE_SINGLE);
-#endif
+	InitializeScreenReader(CreatePlatformSpeechBackend());
+}
+
+void InitializeScreenReader(std::unique_ptr<SpeechBackend> backend)
+{
+	Backend = std::move(backend);
+	State.emplace();
+	SpeechThread = SdlThread { SpeechLoop };
 }
 
 void ShutDownScreenReader()
 {
-#ifdef _WIN32
-	Tolk_Unload();
-#else
-	spd_close(Speechd);
-#endif
+	if (!State)
+		return;
+
+	{
+		const std::lock_guard<SdlMutex> lock(State->mutex);
+		State->stop = true;
+	}
+	State->wakeUp.signal();
+	SpeechThread.join();
+	State = std::nullopt;
+	Backend = nullptr;
+}
+
+SpeechLatency GetSpeechLatency()
+{
+	if (!State)
+		return {};
+	const std::lock_guard<SdlMutex> lock(State->mutex);
+	return State->latency;
 }
 
-void SpeakText(std::string_view text, bool force)
+void SetSpeechTraceEnabled(bool enabled)
 {
+	if (!State)
+		return;
+	const std::lock_guard<SdlMutex> lock(State->mutex);
+	State->traceEnabled = enabled;
+	if (!enabled)
+		State->traceIds.fill(0);
+}
+
+bool IsSpeechTraceEnabled()
+{
+	if (!State)
+		return false;
+	const std::lock_guard<SdlMutex> lock(State->mutex);
+	return State->traceEnabled;
+}
+
+std::vector<SpeechTraceEntry> GetSpeechTrace()
+{
+	std::vector<SpeechTraceEntry> trace;
+	if (!State)
+		return trace;
+	const std::lock_guard<SdlMutex> lock(State->mutex);
+	const uint32_t end = State->nextTraceId;
+	const uint32_t begin = end > SpeechTraceSize ? end - static_cast<uint32_t>(SpeechTraceSize) : 1;
+	for (uint32_t traceId = begin; traceId < end; traceId++) {
+		if (const SpeechTraceEntry *entry = FindTraceEntry(*State, traceId); entry != nullptr)
+			trace.push_back(*entry);
+	}
+	return trace;
+}
+
+size_t GetQueuedSpeechCount(SpeechChannel channel)
+{
+	if (!State)
+		return 0;
+	const std::lock_guard<SdlMutex> lock(State->mutex);
+	return State->channels[static_cast<size_t>(channel)].pending.size();
+}
+
+void SpeakText(std::string_view text, bool force, SpeechPriority priority, SpeechChannel channel)
+{
+	DVL_TRACE_ZONE("SpeakText");
 	static std::string SpokenText;
 
+	if (HeadlessMode) {
+		RecordHeadlessSpeech(text, force, priority, channel);
+		return;
+	}
+
 	if (!force && SpokenText == text)
 		return;
 
 	SpokenText = text;
 
-#ifdef _WIN32
-	const auto textUtf16 = ToWideChar(SpokenText);
-	if (textUtf16 != nullptr)
-		Tolk_Output(textUtf16.get(), true);
-#else
-	spd_say(Speechd, SPD_TEXT, SpokenText.c_str());
-#endif
+	if (!State)
+		return;
+
+	{
+		const std::lock_guard<SdlMutex> lock(State->mutex);
+		std::deque<PendingSpeech> &pending = State->channels[static_cast<size_t>(channel)].pending;
+		const bool interrupt = priority == SpeechPriority::Interrupt;
+		if (interrupt) {
+			// Nothing that was waiting in the channel would be heard before this cuts it off.
+			pending.clear();
+		} else {
+			for (auto it = pending.begin(); it != pending.end(); ++it) {
+				if (it->text == text) {
+					pending.erase(it);
+					break;
+				}
+			}
+			if (pending.size() >= MaxQueuedSpeech)
+				pending.pop_front();
+		}
+		uint32_t traceId = 0;
+		if (State->traceEnabled) {
+			traceId = State->nextTraceId++;
+			if (State->nextTraceId == 0)
+				State->nextTraceId = 1;
+			const size_t index = traceId % SpeechTraceSize;
+			State->traceIds[index] = traceId;
+			SpeechTraceEntry &entry = State->trace[index];
+			entry.text = SpokenText;
+			entry.channel = channel;
+			entry.interrupt = interrupt;
+			entry.enqueued = std::chrono::steady_clock::now();
+			entry.handedOff = std::nullopt;
+			entry.returned = std::nullopt;
+			entry.outputLatency = std::nullopt;
+		}
+		pending.push_back(PendingSpeech { .text = SpokenText, .interrupt = interrupt, .traceId = traceId });
+	}
+	State->wakeUp.signal();
 }
 
 } // namespace devilution
@@ -1,13 +1,90 @@
 #pragma once
 
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
 #include <string_view>
+#include <vector>
+
+#include "headless_mode.hpp"
+#include "utils/speech_backend.hpp"
 
 namespace devilution {
 
+enum class SpeechPriority : uint8_t {
+	/** Spoken after whatever is being said and waiting already. */
+	Queued,
+	/** Cuts off whatever is being said and drops the waiting messages it supersedes. */
+	Interrupt,
+};
+
+/** Each channel is queued and rate limited on its own, so a busy fight can't hold up the UI. */
+enum class SpeechChannel : uint8_t {
+	UI,
+	Navigation,
+	Combat,
+	Chat,
+	COUNT,
+};
+
+struct SpeechLatency {
+	/** What the text is spoken with. */
+	std::string backend;
+	/** How long the backend kept the speech thread busy with the last message. */
+	std::chrono::microseconds blocking {};
+	/**
+	 * From handing the message before the last one to the backend until it was heard, if the backend can tell.
+	 * The last message may not have started yet when it is handed off.
+	 */
+	std::optional<std::chrono::microseconds> previousOutput;
+};
+
+/** A message on its way from the announcer to the speech engine. */
+struct SpeechTraceEntry {
+	std::string text;
+	SpeechChannel channel;
+	bool interrupt;
+	/** When SpeakText() was called, which is when the announcer noticed the event. */
+	std::chrono::steady_clock::time_point enqueued;
+	/** When the speech thread handed the message to the backend, nothing if it was dropped or is still waiting. */
+	std::optional<std::chrono::steady_clock::time_point> handedOff;
+	/** When the backend returned from speaking it. */
+	std::optional<std::chrono::steady_clock::time_point> returned;
+	/** Until the backend started speaking it, known once the next message is handed off. */
+	std::optional<std::chrono::microseconds> outputLatency;
+};
+
+/** @brief Keeps a SpeakText() call made in HeadlessMode for the tests, see utils/headless_speech.hpp. */
+void RecordHeadlessSpeech(std::string_view text, bool force, SpeechPriority priority, SpeechChannel channel);
+
 #ifdef SCREEN_READER_INTEGRATION
+/** @brief Starts the speech thread with the platform's speech backend. */
 void InitializeScreenReader();
+/** @brief Starts the speech thread with the given backend, e.g. a RecordingSpeechBackend for benchmarks. */
+void InitializeScreenReader(std::unique_ptr<SpeechBackend> backend);
 void ShutDownScreenReader();
-void SpeakText(std::string_view text, bool force = false);
+
+/** @brief The latency of the most recently spoken message. */
+[[nodiscard]] SpeechLatency GetSpeechLatency();
+
+/** @brief Starts or stops keeping the timestamps of the latest messages, stopping forgets them. */
+void SetSpeechTraceEnabled(bool enabled);
+[[nodiscard]] bool IsSpeechTraceEnabled();
+
+/** @brief The traced messages, oldest first. */
+[[nodiscard]] std::vector<SpeechTraceEntry> GetSpeechTrace();
+
+/** @brief How many messages of a channel are waiting for the speech thread. */
+[[nodiscard]] size_t GetQueuedSpeechCount(SpeechChannel channel);
+
+/**
+ * @brief Hands the text to the speech thread, never waits for the screen reader.
+ * @param force Speak the text even if it is the same as the previous one
+ */
+void SpeakText(std::string_view text, bool force = false, SpeechPriority priority = SpeechPriority::Interrupt, SpeechChannel channel = SpeechChannel::UI);
 #else
 constexpr void InitializeScreenReader()
 {
@@ -17,8 +94,34 @@ constexpr void ShutDownScreenReader()
 {
 }
 
-constexpr void SpeakText(std::string_view text, bool force = false)
+inline SpeechLatency GetSpeechLatency()
+{
+	return {};
+}
+
+constexpr void SetSpeechTraceEnabled(bool enabled)
+{
+}
+
+constexpr bool IsSpeechTraceEnabled()
+{
+	return false;
+}
+
+inline std::vector<SpeechTraceEntry> GetSpeechTrace()
+{
+	return {};
+}
+
+constexpr size_t GetQueuedSpeechCount(SpeechChannel channel)
+{
+	return 0;
+}
+
+inline void SpeakText(std::string_view text, bool force = false, SpeechPriority priority = SpeechPriority::Interrupt, SpeechChannel channel = SpeechChannel::UI)
 {
+	if (HeadlessMode)
+		RecordHeadlessSpeech(text, force, priority, channel);
 }
 #endif
 
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <cstdint>
+
+#ifdef USE_SDL3
+#include <SDL3/SDL_mutex.h>
+#else
+#include <SDL_mutex.h>
+#endif
+
+#include "appfat.h"
+#include "utils/sdl_mutex.h"
+
+namespace devilution {
+
+/*
+ * RAII wrapper for SDL_cond, to be used together with SdlMutex.
+ */
+#ifdef __DJGPP__
+class SdlCond final {
+public:
+	SdlCond() noexcept { }
+	~SdlCond() noexcept { }
+
+	SdlCond(const SdlCond &) = delete;
+	SdlCond(SdlCond &&) = delete;
+	SdlCond &operator=(const SdlCond &) = delete;
+	SdlCond &operator=(SdlCond &&) = delete;
+
+	void wait(SdlMutex &) noexcept { }
+	void waitFor(SdlMutex &, uint32_t) noexcept { }
+	void signal() noexcept { }
+	void broadcast() noexcept { }
+};
+#else
+class SdlCond final {
+public:
+	SdlCond()
+#ifdef USE_SDL3
+	    : cond_(SDL_CreateCondition())
+#else
+	    : cond_(SDL_CreateCond())
+#endif
+	{
+		if (cond_ == nullptr)
+			ErrSdl();
+	}
+
+	~SdlCond()
+	{
+#ifdef USE_SDL3
+		SDL_DestroyCondition(cond_);
+#else
+		SDL_DestroyCond(cond_);
+#endif
+	}
+
+	SdlCond(const SdlCond &) = delete;
+	SdlCond(SdlCond &&) = delete;
+	SdlCond &operator=(const SdlCond &) = delete;
+	SdlCond &operator=(SdlCond &&) = delete;
+
+	/** @brief Atomically unlocks `mutex` (which must be locked) and waits until signalled. */
+	void wait(SdlMutex &mutex) noexcept
+	{
+#ifdef USE_SDL3
+		SDL_WaitCondition(cond_, mutex.get());
+#else
+		if (SDL_CondWait(cond_, mutex.get()) == -1) ErrSdl();
+#endif
+	}
+
+	/** @brief Same as wait(), but gives up after `ms` milliseconds. */
+	void waitFor(SdlMutex &mutex, uint32_t ms) noexcept
+	{
+#ifdef USE_SDL3
+		SDL_WaitConditionTimeout(cond_, mutex.get(), static_cast<Sint32>(ms));
+#else
+		if (SDL_CondWaitTimeout(cond_, mutex.get(), ms) == -1) ErrSdl();
+#endif
+	}
+
+	void signal() noexcept
+	{
+#ifdef USE_SDL3
+		SDL_SignalCondition(cond_);
+#else
+		if (SDL_CondSignal(cond_) == -1) ErrSdl();
+#endif
+	}
+
+	/** @brief Wakes up every thread waiting on this condition. */
+	void broadcast() noexcept
+	{
+#ifdef USE_SDL3
+		SDL_BroadcastCondition(cond_);
+#else
+		if (SDL_CondBroadcast(cond_) == -1) ErrSdl();
+#endif
+	}
+
+private:
+#ifdef USE_SDL3
+	SDL_Condition *cond_;
+#else
+	SDL_cond *cond_;
+#endif
+};
+#endif
+
+} // namespace devilution
@@ -0,0 +1,214 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace devilution {
+
+/**
+ * @brief A growable pool whose elements never move, iterated in insertion order.
+ *
+ * Elements live in fixed-size chunks and freed slots are reused, so adding an element is O(1)
+ * and never invalidates pointers to the others. Iteration walks a dense list of live slots instead
+ * of chasing list nodes, and elements added while iterating are visited by the same loop, like
+ * with a std::list.
+ *
+ * @tparam T element type, value-initialized whenever a slot is (re)used.
+ * @tparam ChunkSize elements per allocation.
+ */
+template <class T, size_t ChunkSize = 64>
+class SlotPool {
+	template <bool IsConst>
+	class Iterator;
+
+public:
+	using value_type = T;
+	using size_type = size_t;
+	using iterator = Iterator<false>;
+	using const_iterator = Iterator<true>;
+
+	/** @brief Refers to an element, or to nothing once that element has been removed. */
+	struct Handle {
+		uint32_t index = std::numeric_limits<uint32_t>::max();
+		uint32_t generation = 0;
+
+		bool operator==(const Handle &) const = default;
+	};
+
+	SlotPool() = default;
+
+	SlotPool(const SlotPool &) = delete;
+	SlotPool &operator=(const SlotPool &) = delete;
+
+	[[nodiscard]] iterator begin() { return { this, 0 }; }
+	[[nodiscard]] iterator end() { return { this, EndPosition }; }
+	[[nodiscard]] const_iterator begin() const { return { this, 0 }; }
+	[[nodiscard]] const_iterator end() const { return { this, EndPosition }; }
+	[[nodiscard]] const_iterator cbegin() const { return begin(); }
+	[[nodiscard]] const_iterator cend() const { return end(); }
+
+	[[nodiscard]] size_t size() const { return live_.size(); }
+	[[nodiscard]] bool empty() const { return live_.empty(); }
+	[[nodiscard]] size_t max_size() const { return std::numeric_limits<uint32_t>::max(); } // NOLINT(readability-identifier-naming)
+
+	[[nodiscard]] T &front() { return at(live_.front()); }
+	[[nodiscard]] const T &front() const { return at(live_.front()); }
+	[[nodiscard]] T &back() { return at(live_.back()); }
+	[[nodiscard]] const T &back() const { return at(live_.back()); }
+
+	/** @brief Adds a value-initialized element after all the others. */
+	T &emplace_back() // NOLINT(readability-identifier-naming)
+	{
+		uint32_t index;
+		if (free_.empty()) {
+			index = static_cast<uint32_t>(chunks_.size() * ChunkSize);
+			for (size_t i = ChunkSize; i-- > 1;)
+				free_.push_back(index + static_cast<uint32_t>(i));
+			chunks_.push_back(std::make_unique<Chunk>());
+		} else {
+			index = free_.back();
+			free_.pop_back();
+			at(index) = T {};
+		}
+		live_.push_back(index);
+		return at(index);
+	}
+
+	void push_back(const T &value) // NOLINT(readability-identifier-naming)
+	{
+		emplace_back() = value;
+	}
+
+	/**
+	 * @brief Removes all elements matching the predicate, keeping the order of the others.
+	 *
+	 * Only the slot numbers are compacted, the remaining elements stay where they are.
+	 */
+	template <typename Predicate>
+	size_t remove_if(Predicate &&predicate) // NOLINT(readability-identifier-naming)
+	{
+		const size_t freeBefore = free_.size();
+		size_t kept = 0;
+		for (const uint32_t index : live_) {
+			if (predicate(at(index))) {
+				generation(index)++;
+				free_.push_back(index);
+			} else {
+				live_[kept++] = index;
+			}
+		}
+		live_.resize(kept);
+		// Hand out the lowest of the freed slots first, so iteration keeps walking forward in memory.
+		std::reverse(free_.begin() + static_cast<std::ptrdiff_t>(freeBefore), free_.end());
+		return free_.size() - freeBefore;
+	}
+
+	/** @brief Removes all elements but keeps the memory for the next ones. */
+	void clear()
+	{
+		for (const uint32_t index : live_)
+			generation(index)++;
+		live_.clear();
+		free_.clear();
+		for (size_t index = chunks_.size() * ChunkSize; index-- > 0;)
+			free_.push_back(static_cast<uint32_t>(index));
+	}
+
+	/** @brief The element a handle refers to, nullptr if it was removed since. */
+	[[nodiscard]] T *get(Handle handle)
+	{
+		if (handle.index >= chunks_.size() * ChunkSize || generation(handle.index) != handle.generation)
+			return nullptr;
+		return &at(handle.index);
+	}
+
+	[[nodiscard]] const T *get(Handle handle) const
+	{
+		return const_cast<SlotPool *>(this)->get(handle);
+	}
+
+private:
+	static constexpr size_t EndPosition = std::numeric_limits<size_t>::max();
+
+	struct Chunk {
+		std::array<T, ChunkSize> elements {};
+		/** Bumped each time an element is removed, so stale handles can be told apart. */
+		std::array<uint32_t, ChunkSize> generations {};
+	};
+
+	[[nodiscard]] T &at(uint32_t index) { return chunks_[index / ChunkSize]->elements[index % ChunkSize]; }
+	[[nodiscard]] const T &at(uint32_t index) const { return chunks_[index / ChunkSize]->elements[index % ChunkSize]; }
+	[[nodiscard]] uint32_t &generation(uint32_t index) { return chunks_[index / ChunkSize]->generations[index % ChunkSize]; }
+
+	template <bool IsConst>
+	class Iterator {
+		using Pool = std::conditional_t<IsConst, const SlotPool, SlotPool>;
+
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = T;
+		using difference_type = std::ptrdiff_t;
+		using pointer = std::conditional_t<IsConst, const T *, T *>;
+		using reference = std::conditional_t<IsConst, const T &, T &>;
+
+		Iterator() = default;
+		Iterator(Pool *pool, size_t position)
+		    : pool_(pool)
+		    , position_(position)
+		{
+		}
+
+		[[nodiscard]] reference operator*() const { return pool_->at(pool_->live_[position_]); }
+		[[nodiscard]] pointer operator->() const { return &**this; }
+
+		Iterator &operator++()
+		{
+			position_++;
+			return *this;
+		}
+
+		Iterator operator++(int)
+		{
+			Iterator copy = *this;
+			++*this;
+			return copy;
+		}
+
+		/** @brief A handle to the current element, which stays valid across later additions and removals. */
+		[[nodiscard]] Handle handle() const
+		{
+			const uint32_t index = pool_->live_[position_];
+			return { index, pool_->chunks_[index / ChunkSize]->generations[index % ChunkSize] };
+		}
+
+		// end() is a sentinel rather than a position, so elements added during the loop are visited too.
+		[[nodiscard]] bool operator==(const Iterator &other) const
+		{
+			return resolved() == other.resolved();
+		}
+
+	private:
+		[[nodiscard]] size_t resolved() const
+		{
+			return position_ >= pool_->live_.size() ? EndPosition : position_;
+		}
+
+		Pool *pool_ = nullptr;
+		size_t position_ = 0;
+	};
+
+	std::vector<std::unique_ptr<Chunk>> chunks_;
+	/** Slots not in use, the next one to hand out at the back. */
+	std::vector<uint32_t> free_;
+	/** Slots in use, in insertion order. */
+	std::vector<uint32_t> live_;
+};
+
+} // namespace devilution
@@ -1,9 +1,15 @@
 #include "utils/soundsample.h"
 
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <chrono>
 #include <cmath>
 #include <cstdint>
+#include <mutex>
+#include <optional>
 #include <utility>
+#include <vector>
 
 #ifdef USE_SDL3
 #include <SDL3/SDL_error.h>
@@ -12,6 +18,7 @@
 #include <Aulib/Decoder.h>
 #include <Aulib/DecoderDrmp3.h>
 #include <Aulib/DecoderDrwav.h>
+#include <Aulib/Resampler.h>
 #include <Aulib/Stream.h>
 
 #include <SDL.h>
@@ -24,9 +31,12 @@
 #endif
 
 #include "engine/assets.hpp"
+#include "engine/audio_stats.hpp"
 #include "options.h"
 #include "utils/log.hpp"
 #include "utils/math.h"
+#include "utils/sdl_mutex.h"
+#include "utils/sdl_thread.h"
 #include "utils/stubs.h"
 
 namespace devilution {
@@ -57,16 +67,6 @@ constexpr float MillibelMax = 0.F;
 constexpr float StereoSeparation = 6000.F;
 
 #ifndef USE_SDL3
-float PanLogToLinear(int logPan)
-{
-	if (logPan == 0)
-		return 0;
-
-	auto factor = std::pow(LogBase, static_cast<float>(-std::abs(logPan)) / StereoSeparation);
-
-	return copysign(1.F - factor, static_cast<float>(logPan));
-}
-
 std::unique_ptr<Aulib::Decoder> CreateDecoder(bool isMp3)
 {
 	if (isMp3)
@@ -144,6 +144,7 @@ public:
 protected:
 	auto doDecoding(float buf[], int len, bool &callAgain) -> int override
 	{
+		const ScopedAudioStatsTimer timer(AudioStatsTimer::Decode);
 		return inner_ != nullptr ? inner_->decode(buf, len, callAgain) : 0;
 	}
 
@@ -152,43 +153,419 @@ private:
 	float playbackRate_;
 };
 
-std::unique_ptr<Aulib::Stream> CreateStream(SDL_IOStream *handle, bool isMp3, float playbackRate)
-{
-	std::unique_ptr<Aulib::Decoder> decoder;
-	if (isMp3) {
-		decoder = std::make_unique<Aulib::DecoderDrmp3>();
-	} else {
-		const auto rwPos = SDL_RWtell(handle);
-		decoder = Aulib::Decoder::decoderFor(handle);
-		SDL_RWseek(handle, rwPos, RW_SEEK_SET);
-		if (decoder == nullptr)
-			decoder = std::make_unique<Aulib::DecoderDrwav>();
+/** Plays a decoded PcmBuffer, reading straight from the shared samples. */
+class PcmBufferDecoder final : public Aulib::Decoder {
+public:
+	explicit PcmBufferDecoder(std::shared_ptr<const PcmBuffer> pcm)
+	    : pcm_(std::move(pcm))
+	{
+	}
+
+	auto open([[maybe_unused]] SDL_IOStream *rwops) -> bool override
+	{
+		setIsOpen(true);
+		return true;
+	}
+
+	auto getChannels() const -> int override
+	{
+		return pcm_->channels;
+	}
+
+	auto getRate() const -> int override
+	{
+		return pcm_->rate;
 	}
 
-	if (playbackRate != 1.0F)
-		decoder = std::make_unique<PlaybackRateDecoder>(std::move(decoder), playbackRate);
+	auto rewind() -> bool override
+	{
+		position_ = 0;
+		return true;
+	}
+
+	auto duration() const -> std::chrono::microseconds override
+	{
+		const auto frames = static_cast<int64_t>(pcm_->samples.size() / pcm_->channels);
+		return std::chrono::microseconds { frames * 1000000 / pcm_->rate };
+	}
+
+	auto seekToTime(std::chrono::microseconds pos) -> bool override
+	{
+		const auto frame = static_cast<size_t>(pos.count() * pcm_->rate / 1000000);
+		position_ = std::min(frame * pcm_->channels, pcm_->samples.size());
+		return true;
+	}
+
+protected:
+	auto doDecoding(float buf[], int len, bool &callAgain) -> int override
+	{
+		const ScopedAudioStatsTimer timer(AudioStatsTimer::Decode);
+		callAgain = false;
+		const size_t count = std::min(static_cast<size_t>(len), pcm_->samples.size() - position_);
+		std::copy_n(pcm_->samples.data() + position_, count, buf);
+		position_ += count;
+		return static_cast<int>(count);
+	}
+
+private:
+	std::shared_ptr<const PcmBuffer> pcm_;
+	size_t position_ = 0;
+};
+
+#ifndef __DJGPP__
+class PrefetchingDecoder;
+
+/** The thread that decodes the streamed sounds ahead of the audio callback. */
+struct StreamDecodingState {
+	SdlMutex mutex;
+	std::vector<PrefetchingDecoder *> decoders;
+	bool stop = false;
+};
+
+std::optional<StreamDecodingState> StreamDecoding;
+SdlThread StreamDecodeThread;
+
+/** How often the decoding thread checks whether a ring has room for more samples. */
+constexpr uint32_t StreamDecodeIntervalMs = 10;
+
+/**
+ * @brief Decodes a stream ahead on the decoding thread, so the audio callback only copies samples.
+ *
+ * The samples go through a ring with a single producer and a single consumer. When the file ends,
+ * the ring remembers where and the thread carries on from the start, so a looping sound doesn't run
+ * dry while it is rewound. Reading the file and decoding it happen under the state's mutex, and so
+ * do the rare rewinds and seeks that don't come at the end of the file.
+ */
+class PrefetchingDecoder final : public Aulib::Decoder {
+public:
+	/** Samples decoded at a time, small enough that a rewind never waits long for the mutex. */
+	static constexpr size_t ChunkSamples = 4096;
+	/** Ends of the file that can be in the ring at once, for short sounds that loop. */
+	static constexpr size_t MaxEnds = 8;
+
+	explicit PrefetchingDecoder(std::unique_ptr<Aulib::Decoder> inner)
+	    : inner_(std::move(inner))
+	{
+	}
+
+	~PrefetchingDecoder() override
+	{
+		if (!registered_)
+			return;
+		const std::lock_guard<SdlMutex> lock(StreamDecoding->mutex);
+		std::vector<PrefetchingDecoder *> &decoders = StreamDecoding->decoders;
+		decoders.erase(std::remove(decoders.begin(), decoders.end(), this), decoders.end());
+	}
+
+	auto open(SDL_RWops *rwops) -> bool override
+	{
+		if (isOpen())
+			return true;
+		if (!inner_->open(rwops) || inner_->getChannels() <= 0 || inner_->getRate() <= 0)
+			return false;
+		channels_ = inner_->getChannels();
+		rate_ = inner_->getRate();
+		duration_ = inner_->duration();
+
+		// Half a second of samples, enough to ride out the game thread loading a level.
+		size_t capacity = ChunkSamples * 2;
+		while (capacity < static_cast<size_t>(rate_ * channels_ / 2))
+			capacity *= 2;
+		ring_.resize(capacity);
+		scratch_.resize(ChunkSamples);
+		// The first samples are decoded right away, so playing doesn't start with a gap.
+		FillChunk();
+
+		if (!StreamDecoding)
+			StreamDecoding.emplace();
+		{
+			const std::lock_guard<SdlMutex> lock(StreamDecoding->mutex);
+			StreamDecoding->decoders.push_back(this);
+			StreamDecoding->stop = false;
+		}
+		registered_ = true;
+		if (!StreamDecodeThread.joinable())
+			StreamDecodeThread = SdlThread { DecodeLoop };
+		setIsOpen(true);
+		return true;
+	}
+
+	auto getChannels() const -> int override
+	{
+		return channels_;
+	}
+
+	auto getRate() const -> int override
+	{
+		return rate_;
+	}
+
+	auto rewind() -> bool override
+	{
+		// A loop at the end of the file carries on with what was decoded after it.
+		const size_t endsRead = endsRead_.load(std::memory_order_relaxed);
+		if (endsWritten_.load(std::memory_order_acquire) != endsRead && readPos_.load(std::memory_order_relaxed) == ends_[endsRead % MaxEnds].load(std::memory_order_relaxed)) {
+			endsRead_.store(endsRead + 1, std::memory_order_release);
+			return true;
+		}
+		const std::lock_guard<SdlMutex> lock(StreamDecoding->mutex);
+		if (!inner_->rewind())
+			return false;
+		Flush();
+		return true;
+	}
+
+	auto duration() const -> std::chrono::microseconds override
+	{
+		return duration_;
+	}
+
+	auto seekToTime(std::chrono::microseconds pos) -> bool override
+	{
+		const std::lock_guard<SdlMutex> lock(StreamDecoding->mutex);
+		if (!inner_->seekToTime(pos))
+			return false;
+		Flush();
+		return true;
+	}
+
+	/**
+	 * @brief Decodes a chunk if the ring has room for it, `StreamDecoding->mutex` must be locked.
+	 * @return Whether anything was decoded
+	 */
+	bool FillChunk()
+	{
+		if (pendingEnd_) {
+			if (!HasRoomForEnd())
+				return false;
+			MarkEnd();
+			return true;
+		}
+
+		const size_t write = writePos_.load(std::memory_order_relaxed);
+		if (ring_.size() - (write - readPos_.load(std::memory_order_acquire)) < ChunkSamples)
+			return false;
+
+		bool callAgain = false;
+		const int count = inner_->decode(scratch_.data(), static_cast<int>(ChunkSamples), callAgain);
+		if (count <= 0) {
+			if (callAgain)
+				return true;
+			if (!HasRoomForEnd()) {
+				pendingEnd_ = true;
+				return false;
+			}
+			MarkEnd();
+			return true;
+		}
+
+		const size_t mask = ring_.size() - 1;
+		for (int i = 0; i < count; i++)
+			ring_[(write + i) & mask] = scratch_[i];
+		writePos_.store(write + count, std::memory_order_release);
+		return true;
+	}
+
+protected:
+	auto doDecoding(float buf[], int len, bool &callAgain) -> int override
+	{
+		callAgain = false;
+		const size_t read = readPos_.load(std::memory_order_relaxed);
+		// The write position is loaded first, so it can't include samples after an end that isn't seen yet.
+		size_t available = writePos_.load(std::memory_order_acquire) - read;
+		const size_t endsRead = endsRead_.load(std::memory_order_relaxed);
+		const bool ended = endsWritten_.load(std::memory_order_acquire) != endsRead;
+		if (ended)
+			available = std::min(available, ends_[endsRead % MaxEnds].load(std::memory_order_relaxed) - read);
+
+		const size_t count = std::min(available, static_cast<size_t>(len));
+		const size_t mask = ring_.size() - 1;
+		for (size_t i = 0; i < count; i++)
+			buf[i] = ring_[(read + i) & mask];
+		readPos_.store(read + count, std::memory_order_release);
+
+		if (count == static_cast<size_t>(len) || ended)
+			return static_cast<int>(count);
+		// The thread fell behind. Play silence rather than stopping the stream.
+		std::fill(buf + count, buf + len, 0.F);
+		return len;
+	}
+
+private:
+	static void DecodeLoop()
+	{
+		StreamDecodingState &state = *StreamDecoding;
+		std::unique_lock<SdlMutex> lock(state.mutex);
+		while (!state.stop) {
+			bool decoded = false;
+			for (PrefetchingDecoder *decoder : state.decoders)
+				decoded = decoder->FillChunk() || decoded;
+			lock.unlock();
+			if (!decoded)
+				SDL_Delay(StreamDecodeIntervalMs);
+			lock.lock();
+		}
+	}
+
+	[[nodiscard]] bool HasRoomForEnd() const
+	{
+		return endsWritten_.load(std::memory_order_relaxed) - endsRead_.load(std::memory_order_acquire) < MaxEnds;
+	}
+
+	/** @brief Remembers where the file ended and starts decoding it again, `StreamDecoding->mutex` must be locked. */
+	void MarkEnd()
+	{
+		pendingEnd_ = false;
+		const size_t endsWritten = endsWritten_.load(std::memory_order_relaxed);
+		ends_[endsWritten % MaxEnds].store(writePos_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+		endsWritten_.store(endsWritten + 1, std::memory_order_release);
+		inner_->rewind();
+	}
+
+	/** @brief Drops the decoded samples after the inner decoder moved, `StreamDecoding->mutex` must be locked. */
+	void Flush()
+	{
+		readPos_.store(0, std::memory_order_relaxed);
+		writePos_.store(0, std::memory_order_relaxed);
+		endsRead_.store(0, std::memory_order_relaxed);
+		endsWritten_.store(0, std::memory_order_relaxed);
+		pendingEnd_ = false;
+		FillChunk();
+	}
+
+	std::unique_ptr<Aulib::Decoder> inner_;
+	int channels_ = 0;
+	int rate_ = 0;
+	std::chrono::microseconds duration_ {};
+
+	/** Decoded samples, a power of two of them. The positions only grow, and wrap around the ring. */
+	std::vector<float> ring_;
+	std::atomic<size_t> readPos_ = 0;
+	std::atomic<size_t> writePos_ = 0;
+	/** Where the file ended in the ring, the ones the stream hasn't rewound at yet. */
+	std::array<std::atomic<size_t>, MaxEnds> ends_ {};
+	std::atomic<size_t> endsRead_ = 0;
+	std::atomic<size_t> endsWritten_ = 0;
+	/** The file ended while there was no room to remember another end. Only used with the mutex locked. */
+	bool pendingEnd_ = false;
+	std::vector<float> scratch_;
+	bool registered_ = false;
+};
+#endif
+
+std::unique_ptr<Aulib::Decoder> CreateDecoderFor(SDL_IOStream *handle, bool isMp3)
+{
+	if (isMp3)
+		return std::make_unique<Aulib::DecoderDrmp3>();
+
+	const auto rwPos = SDL_RWtell(handle);
+	std::unique_ptr<Aulib::Decoder> decoder = Aulib::Decoder::decoderFor(handle);
+	SDL_RWseek(handle, rwPos, RW_SEEK_SET);
+	if (decoder == nullptr)
+		decoder = std::make_unique<Aulib::DecoderDrwav>();
+	return decoder;
+}
+
+/**
+ * @param prefetch Whether to decode on the stream decoding thread, for sounds streamed from a file
+ */
+std::unique_ptr<Aulib::Stream> CreateStream(SDL_IOStream *handle, bool isMp3, float playbackRate, bool prefetch = false)
+{
+	std::unique_ptr<Aulib::Decoder> decoder = CreateDecoderFor(handle, isMp3);
+
+	// Also wraps decoders that play at the normal rate, to measure them for the audio statistics.
+	decoder = std::make_unique<PlaybackRateDecoder>(std::move(decoder), playbackRate);
+#ifndef __DJGPP__
+	if (prefetch)
+		decoder = std::make_unique<PrefetchingDecoder>(std::move(decoder));
+#endif
 
 	if (!decoder->open(handle)) // open for `getRate`
 		return nullptr;
-	auto resampler = CreateAulibResampler(decoder->getRate());
+	auto resampler = CreateAulibResampler(decoder->getRate(), /*measured=*/true);
 	return std::make_unique<Aulib::Stream>(handle, std::move(decoder), std::move(resampler), /*closeRw=*/true);
 }
+#endif
+
+} // namespace
+
+#ifndef USE_SDL3
+void StopStreamDecoding()
+{
+#ifndef __DJGPP__
+	if (!StreamDecodeThread.joinable())
+		return;
+	{
+		const std::lock_guard<SdlMutex> lock(StreamDecoding->mutex);
+		StreamDecoding->stop = true;
+	}
+	StreamDecodeThread.join();
+#endif
+}
+
+float PanLogToLinear(int logPan)
+{
+	if (logPan == 0)
+		return 0;
+
+	auto factor = std::pow(LogBase, static_cast<float>(-std::abs(logPan)) / StereoSeparation);
+
+	return copysign(1.F - factor, static_cast<float>(logPan));
+}
 
-/**
- * @brief Converts log volume passed in into linear volume.
- * @param logVolume Logarithmic volume in the range [logMin..logMax]
- * @param logMin Volume range minimum (usually ATTENUATION_MIN for game sounds and VOLUME_MIN for volume sliders)
- * @param logMax Volume range maximum (usually 0)
- * @return Linear volume in the range [0..1]
- */
 float VolumeLogToLinear(int logVolume, int logMin, int logMax)
 {
 	const auto logScaled = math::Remap(static_cast<float>(logMin), static_cast<float>(logMax), MillibelMin, MillibelMax, static_cast<float>(logVolume));
 	return std::pow(LogBase, logScaled / VolumeScale); // linVolume
 }
-#endif
-
-} // namespace
+#endif
+
+std::shared_ptr<const PcmBuffer> DecodeToPcm(const std::uint8_t *fileData, std::size_t dwBytes, bool isMp3)
+{
+#ifdef USE_SDL3
+	return nullptr;
+#else
+	SDL_IOStream *handle = SDL_IOFromConstMem(fileData, static_cast<int>(dwBytes));
+	if (handle == nullptr)
+		return nullptr;
+
+	std::shared_ptr<Aulib::Decoder> decoder = CreateDecoderFor(handle, isMp3);
+	if (!decoder->open(handle) || decoder->getChannels() <= 0 || decoder->getRate() <= 0) {
+		SDL_RWclose(handle);
+		return nullptr;
+	}
+
+	auto pcm = std::make_shared<PcmBuffer>();
+	pcm->channels = decoder->getChannels();
+	pcm->rate = decoder->getRate();
+
+	constexpr int ChunkFrames = 1024;
+	std::unique_ptr<Aulib::Resampler> resampler = CreateAulibResampler(pcm->rate);
+	if (resampler != nullptr) {
+		pcm->rate = Aulib::sampleRate();
+		resampler->setDecoder(decoder);
+		resampler->setSpec(pcm->rate, pcm->channels, ChunkFrames);
+	}
+
+	std::vector<float> chunk(static_cast<size_t>(ChunkFrames * pcm->channels));
+	while (true) {
+		bool callAgain = false;
+		const int count = resampler != nullptr
+		    ? resampler->resample(chunk.data(), static_cast<int>(chunk.size()))
+		    : decoder->decode(chunk.data(), static_cast<int>(chunk.size()), callAgain);
+		if (count > 0)
+			pcm->samples.insert(pcm->samples.end(), chunk.begin(), chunk.begin() + count);
+		else if (!callAgain)
+			break;
+	}
+	SDL_RWclose(handle);
+
+	if (pcm->samples.empty())
+		return nullptr;
+	pcm->samples.shrink_to_fit();
+	return pcm;
+#endif
+}
 
 ///// SoundSample /////
 
@@ -232,6 +609,8 @@ void SoundSample::Release()
 #endif
 	file_data_ = nullptr;
 	file_data_size_ = 0;
+	pcm_ = nullptr;
+	duplicate_pcm_ = nullptr;
 }
 
 /**
@@ -271,9 +650,11 @@ int SoundSample::SetChunkStream(std::string filePath, bool isMp3, bool logErrors
 		return -1;
 	}
 	file_path_ = std::move(filePath);
+	pcm_ = nullptr;
+	duplicate_pcm_ = nullptr;
 	isMp3_ = isMp3;
 	playbackRate_ = playbackRate;
-	stream_ = CreateStream(handle, isMp3, playbackRate_);
+	stream_ = CreateStream(handle, isMp3, playbackRate_, /*prefetch=*/true);
 	if (!stream_) {
 		SDL_RWclose(handle);
 		if (logErrors)
@@ -299,6 +680,8 @@ int SoundSample::SetChunk(ArraySharedPtr<std::uint8_t> fileData, std::size_t dwB
 	playbackRate_ = playbackRate;
 	file_data_ = std::move(fileData);
 	file_data_size_ = dwBytes;
+	pcm_ = nullptr;
+	duplicate_pcm_ = nullptr;
 	SDL_IOStream *buf = SDL_IOFromConstMem(file_data_.get(), static_cast<int>(dwBytes));
 	if (buf == nullptr) {
 		return -1;
@@ -321,6 +704,34 @@ int SoundSample::SetChunk(ArraySharedPtr<std::uint8_t> fileData, std::size_t dwB
 #endif
 }
 
+int SoundSample::SetPcm(std::shared_ptr<const PcmBuffer> pcm)
+{
+#ifdef USE_SDL3
+	return 0;
+#else
+	file_data_ = nullptr;
+	file_data_size_ = 0;
+	pcm_ = std::move(pcm);
+	duplicate_pcm_ = nullptr;
+	stream_ = std::make_unique<Aulib::Stream>(/*rwops=*/nullptr, std::make_unique<PcmBufferDecoder>(pcm_), CreateAulibResampler(pcm_->rate, /*measured=*/true), /*closeRw=*/false);
+	if (!stream_->open()) {
+		stream_ = nullptr;
+		pcm_ = nullptr;
+		LogError(LogCategory::Audio, "Aulib::Stream::open (from SoundSample::SetPcm): {}", SDL_GetError());
+		return -1;
+	}
+
+	return 0;
+#endif
+}
+
+void SoundSample::DecodeForDuplicates()
+{
+	if (file_data_ == nullptr || duplicate_pcm_ != nullptr || playbackRate_ != 1.0F)
+		return;
+	duplicate_pcm_ = DecodeToPcm(file_data_.get(), file_data_size_, isMp3_);
+}
+
 void SoundSample::SetVolume(int logVolume, int logMin, int logMax)
 {
 #ifndef USE_SDL3
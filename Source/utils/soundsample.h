@@ -5,6 +5,7 @@
 #include <functional>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "engine/sound_defs.hpp"
 #include "utils/stdcompat/shared_ptr_array.hpp"
@@ -19,6 +20,36 @@ class Stream;
 
 namespace devilution {
 
+/** Interleaved float samples of a whole sound, decoded once and shared by every sample that plays them. */
+struct PcmBuffer {
+	std::vector<float> samples;
+	int channels;
+	int rate;
+};
+
+/**
+ * @brief Decodes WAV, FLAC, Ogg/Vorbis or MP3 data to PCM at the mixer's sample rate.
+ * @return The decoded sound, or nullptr if the data can't be decoded
+ */
+std::shared_ptr<const PcmBuffer> DecodeToPcm(const std::uint8_t *fileData, std::size_t dwBytes, bool isMp3);
+
+#ifndef USE_SDL3
+/**
+ * @brief Converts log volume passed in into linear volume.
+ * @param logVolume Logarithmic volume in the range [logMin..logMax]
+ * @param logMin Volume range minimum (usually ATTENUATION_MIN for game sounds and VOLUME_MIN for volume sliders)
+ * @param logMax Volume range maximum (usually 0)
+ * @return Linear volume in the range [0..1]
+ */
+float VolumeLogToLinear(int logVolume, int logMin, int logMax);
+
+/** @brief Converts a logarithmic stereo position (PAN_MIN..PAN_MAX) into Aulib's linear one (-1..1). */
+float PanLogToLinear(int logPan);
+
+/** @brief Stops the thread that decodes streamed sounds ahead, it starts again with the next stream. */
+void StopStreamDecoding();
+#endif
+
 class SoundSample final {
 public:
 	SoundSample();
@@ -55,15 +86,32 @@ public:
 	 */
 	int SetChunk(ArraySharedPtr<std::uint8_t> fileData, std::size_t dwBytes, bool isMp3, float playbackRate = 1.0F);
 
+	/**
+	 * @brief Plays already decoded PCM, the buffer is shared rather than copied.
+	 * @return 0 on success, -1 otherwise
+	 */
+	int SetPcm(std::shared_ptr<const PcmBuffer> pcm);
+
 	[[nodiscard]] bool IsStreaming() const
 	{
-		return file_data_ == nullptr;
+		return file_data_ == nullptr && pcm_ == nullptr;
 	}
 
+	/**
+	 * @brief Decodes the sample's data once, so that its duplicates share the PCM instead of each decoding the data again.
+	 *
+	 * Does nothing for streamed samples, ones that already play PCM and ones played at a different rate.
+	 */
+	void DecodeForDuplicates();
+
 	int DuplicateFrom(const SoundSample &other)
 	{
 		if (other.IsStreaming())
 			return SetChunkStream(other.file_path_, other.isMp3_, /*logErrors=*/true, other.playbackRate_);
+		if (other.pcm_ != nullptr)
+			return SetPcm(other.pcm_);
+		if (other.duplicate_pcm_ != nullptr)
+			return SetPcm(other.duplicate_pcm_);
 		return SetChunk(other.file_data_, other.file_data_size_, other.isMp3_, other.playbackRate_);
 	}
 
@@ -102,6 +150,9 @@ private:
 	// Non-streaming audio fields:
 	ArraySharedPtr<std::uint8_t> file_data_;
 	std::size_t file_data_size_;
+	std::shared_ptr<const PcmBuffer> pcm_;
+	/** The file data decoded by DecodeForDuplicates(), shared by the duplicates. */
+	std::shared_ptr<const PcmBuffer> duplicate_pcm_;
 
 	// Set for streaming audio to allow for duplicating it:
 	std::string file_path_;
@@ -0,0 +1,72 @@
+/**
+ * @file speech_backend.cpp
+ *
+ * Implementation of the speech backends that don't need a speech engine.
+ */
+#include "utils/speech_backend.hpp"
+
+namespace devilution {
+
+namespace {
+
+class NullSpeechBackend final : public SpeechBackend {
+public:
+	bool Open() override
+	{
+		return true;
+	}
+
+	void Close() override
+	{
+	}
+
+	void Speak(std::string_view text, bool interrupt) override
+	{
+	}
+
+	[[nodiscard]] std::string Name() const override
+	{
+		return "None";
+	}
+};
+
+} // namespace
+
+std::unique_ptr<SpeechBackend> CreateNullSpeechBackend()
+{
+	return std::make_unique<NullSpeechBackend>();
+}
+
+RecordingSpeechBackend::RecordingSpeechBackend(std::vector<RecordedSpeech> &out, std::chrono::microseconds latency)
+    : out_(out)
+    , latency_(latency)
+{
+}
+
+bool RecordingSpeechBackend::Open()
+{
+	return true;
+}
+
+void RecordingSpeechBackend::Close()
+{
+}
+
+void RecordingSpeechBackend::Speak(std::string_view text, bool interrupt)
+{
+	out_.push_back(RecordedSpeech { .text = std::string(text), .interrupt = interrupt });
+}
+
+std::string RecordingSpeechBackend::Name() const
+{
+	return "Recording";
+}
+
+std::optional<std::chrono::microseconds> RecordingSpeechBackend::OutputLatency() const
+{
+	if (out_.empty())
+		return std::nullopt;
+	return latency_;
+}
+
+} // namespace devilution
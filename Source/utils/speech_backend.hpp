@@ -0,0 +1,82 @@
+/**
+ * @file speech_backend.hpp
+ *
+ * Interface of the speech engines the screen reader support speaks through.
+ */
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace devilution {
+
+/** @brief Turns text into speech. Only used from the speech thread. */
+class SpeechBackend {
+public:
+	virtual ~SpeechBackend() = default;
+
+	/** @brief Connects to the speech engine, false if there is nothing to speak with. */
+	virtual bool Open() = 0;
+	virtual void Close() = 0;
+
+	/** @brief Speaks the text, first cutting off whatever is being said if `interrupt` is set. */
+	virtual void Speak(std::string_view text, bool interrupt) = 0;
+
+	/** @brief Cuts off whatever is being said, e.g. when a recorded clip is played instead. */
+	virtual void Silence()
+	{
+	}
+
+	/** @brief What the text is spoken with, for the log. */
+	[[nodiscard]] virtual std::string Name() const = 0;
+
+	/**
+	 * @brief Time from the last Speak() until that message started being heard.
+	 *
+	 * Nothing if it hasn't started yet, or the backend isn't told when speech starts.
+	 */
+	[[nodiscard]] virtual std::optional<std::chrono::microseconds> OutputLatency() const
+	{
+		return std::nullopt;
+	}
+};
+
+/** @brief Tolk on Windows, AVSpeechSynthesizer on macOS and speech-dispatcher elsewhere. */
+std::unique_ptr<SpeechBackend> CreatePlatformSpeechBackend();
+
+/** @brief A backend that drops everything. */
+std::unique_ptr<SpeechBackend> CreateNullSpeechBackend();
+
+struct RecordedSpeech {
+	std::string text;
+	bool interrupt;
+
+	bool operator==(const RecordedSpeech &) const = default;
+};
+
+/**
+ * @brief Keeps what would have been spoken, to test and benchmark announcements without a speech engine.
+ *
+ * The messages are appended to `out`, which is only safe to read once the speech thread is shut down.
+ */
+class RecordingSpeechBackend final : public SpeechBackend {
+public:
+	/** @param latency Reported as the output latency once something was spoken. */
+	explicit RecordingSpeechBackend(std::vector<RecordedSpeech> &out, std::chrono::microseconds latency = {});
+
+	bool Open() override;
+	void Close() override;
+	void Speak(std::string_view text, bool interrupt) override;
+	[[nodiscard]] std::string Name() const override;
+	[[nodiscard]] std::optional<std::chrono::microseconds> OutputLatency() const override;
+
+private:
+	std::vector<RecordedSpeech> &out_;
+	std::chrono::microseconds latency_;
+};
+
+} // namespace devilution
@@ -0,0 +1,72 @@
+/**
+ * @file speech_backend_avspeech.cpp
+ *
+ * Speech through the macOS speech synthesizer.
+ */
+#include <cstdint>
+#include <string>
+
+#include "platform/macos/avspeech.h"
+#include "utils/speech_backend.hpp"
+
+namespace devilution {
+
+namespace {
+
+class AVSpeechBackend final : public SpeechBackend {
+public:
+	bool Open() override
+	{
+		speech_ = AVSpeechCreate();
+		return speech_ != nullptr;
+	}
+
+	void Close() override
+	{
+		if (speech_ != nullptr)
+			AVSpeechDestroy(speech_);
+		speech_ = nullptr;
+	}
+
+	void Speak(std::string_view text, bool interrupt) override
+	{
+		if (speech_ == nullptr)
+			return;
+		text_.assign(text);
+		AVSpeechSpeak(speech_, text_.c_str(), interrupt);
+	}
+
+	void Silence() override
+	{
+		if (speech_ != nullptr)
+			AVSpeechStop(speech_);
+	}
+
+	[[nodiscard]] std::string Name() const override
+	{
+		return "AVSpeechSynthesizer";
+	}
+
+	[[nodiscard]] std::optional<std::chrono::microseconds> OutputLatency() const override
+	{
+		if (speech_ == nullptr)
+			return std::nullopt;
+		const double seconds = AVSpeechOutputLatency(speech_);
+		if (seconds < 0)
+			return std::nullopt;
+		return std::chrono::microseconds { static_cast<int64_t>(seconds * 1000000) };
+	}
+
+private:
+	void *speech_ = nullptr;
+	std::string text_;
+};
+
+} // namespace
+
+std::unique_ptr<SpeechBackend> CreatePlatformSpeechBackend()
+{
+	return std::make_unique<AVSpeechBackend>();
+}
+
+} // namespace devilution
@@ -0,0 +1,97 @@
+/**
+ * @file speech_backend_speechd.cpp
+ *
+ * Speech through speech-dispatcher.
+ */
+#include <atomic>
+#include <cstddef>
+#include <string>
+
+#include <speech-dispatcher/libspeechd.h>
+
+#include "utils/speech_backend.hpp"
+
+namespace devilution {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// speech-dispatcher calls back without any user data, so there can only be one connection.
+std::atomic<Clock::rep> BegunTicks { 0 };
+std::atomic<int> BegunMessageId { -1 };
+
+/** Called from speech-dispatcher's own thread when a message starts being spoken. */
+void OnSpeechBegin(size_t messageId, [[maybe_unused]] size_t clientId, [[maybe_unused]] SPDNotificationType state)
+{
+	BegunTicks.store(Clock::now().time_since_epoch().count(), std::memory_order_relaxed);
+	BegunMessageId.store(static_cast<int>(messageId), std::memory_order_release);
+}
+
+class SpeechdSpeechBackend final : public SpeechBackend {
+public:
+	bool Open() override
+	{
+		// Threaded mode delivers the notifications, and spd_say() returns as soon as the message is queued.
+		connection_ = spd_open("DevilutionX", "DevilutionX", nullptr, SPD_MODE_THREADED);
+		if (connection_ == nullptr)
+			return false;
+		connection_->callback_begin = OnSpeechBegin;
+		spd_set_notification_on(connection_, SPD_BEGIN);
+		return true;
+	}
+
+	void Close() override
+	{
+		if (connection_ != nullptr)
+			spd_close(connection_);
+		connection_ = nullptr;
+	}
+
+	void Speak(std::string_view text, bool /*interrupt*/) override
+	{
+		if (connection_ == nullptr)
+			return;
+		// speech-dispatcher has always queued the messages after the one being spoken, interrupting
+		// messages included, so they aren't cancelled here either.
+		text_.assign(text);
+		const Clock::time_point sent = Clock::now();
+		const int messageId = spd_say(connection_, SPD_TEXT, text_.c_str());
+		lastMessageId_ = messageId;
+		lastSent_ = sent;
+	}
+
+	void Silence() override
+	{
+		if (connection_ != nullptr)
+			spd_cancel(connection_);
+	}
+
+	[[nodiscard]] std::string Name() const override
+	{
+		return "speech-dispatcher";
+	}
+
+	[[nodiscard]] std::optional<std::chrono::microseconds> OutputLatency() const override
+	{
+		if (lastMessageId_ < 0 || BegunMessageId.load(std::memory_order_acquire) != lastMessageId_)
+			return std::nullopt;
+		const Clock::time_point begun { Clock::duration { BegunTicks.load(std::memory_order_relaxed) } };
+		return std::chrono::duration_cast<std::chrono::microseconds>(begun - lastSent_);
+	}
+
+private:
+	SPDConnection *connection_ = nullptr;
+	std::string text_;
+	int lastMessageId_ = -1;
+	Clock::time_point lastSent_;
+};
+
+} // namespace
+
+std::unique_ptr<SpeechBackend> CreatePlatformSpeechBackend()
+{
+	return std::make_unique<SpeechdSpeechBackend>();
+}
+
+} // namespace devilution
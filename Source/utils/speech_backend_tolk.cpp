@@ -0,0 +1,70 @@
+/**
+ * @file speech_backend_tolk.cpp
+ *
+ * Speech through Tolk, which talks to NVDA, JAWS and the other screen readers directly.
+ */
+#include <string>
+
+#include <Tolk.h>
+
+#include "utils/speech_backend.hpp"
+#include "utils/utf8.hpp"
+
+namespace devilution {
+
+namespace {
+
+class TolkSpeechBackend final : public SpeechBackend {
+public:
+	bool Open() override
+	{
+		Tolk_Load();
+		// Without a screen reader running, speak through SAPI instead of not at all.
+		Tolk_TrySAPI(true);
+		return Tolk_IsLoaded();
+	}
+
+	void Close() override
+	{
+		Tolk_Unload();
+	}
+
+	void Speak(std::string_view text, bool interrupt) override
+	{
+		static_assert(sizeof(wchar_t) == sizeof(char16_t));
+		// Reused for every message, so speaking doesn't allocate once it has grown to fit the longest one.
+		textUtf16_.clear();
+		AppendUtf16(text, textUtf16_);
+		Tolk_Output(reinterpret_cast<const wchar_t *>(textUtf16_.c_str()), interrupt);
+	}
+
+	void Silence() override
+	{
+		Tolk_Silence();
+	}
+
+	[[nodiscard]] std::string Name() const override
+	{
+		const wchar_t *screenReader = Tolk_DetectScreenReader();
+		if (screenReader == nullptr)
+			return "Tolk";
+		// The screen reader names Tolk knows are all ASCII.
+		std::string name = "Tolk (";
+		for (; *screenReader != L'\0'; ++screenReader)
+			name += *screenReader < 0x80 ? static_cast<char>(*screenReader) : '?';
+		name += ')';
+		return name;
+	}
+
+private:
+	std::u16string textUtf16_;
+};
+
+} // namespace
+
+std::unique_ptr<SpeechBackend> CreatePlatformSpeechBackend()
+{
+	return std::make_unique<TolkSpeechBackend>();
+}
+
+} // namespace devilution
@@ -0,0 +1,269 @@
+/**
+ * @file speech_clips.cpp
+ *
+ * Implementation of the recorded clips that short announcements are played from.
+ */
+#include "utils/speech_clips.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include <ankerl/unordered_dense.h>
+
+#include "engine/assets.hpp"
+#include "engine/cue_voice.hpp"
+#include "engine/sound.h"
+#include "engine/sound_defs.hpp"
+#include "utils/file_util.h"
+#include "utils/log.hpp"
+#include "utils/parse_int.hpp"
+#include "utils/paths.h"
+#include "utils/soundsample.h"
+#include "utils/str_cat.hpp"
+#include "utils/str_split.hpp"
+#include "utils/string_view_hash.hpp"
+
+namespace devilution {
+
+namespace {
+
+/** Most announcements `vocabulary.txt` lists, the most frequent ones first. */
+constexpr size_t MaxVocabularySize = 256;
+
+/** Clips play from the middle, at full volume like the speech engine. */
+constexpr CuePlacement ClipPlacement { .logVolume = VOLUME_MAX, .logPan = 0, .binaural = false, .lateral = 0, .rear = 0 };
+
+struct SpeechClip {
+	std::string file;
+	std::shared_ptr<const PcmBuffer> pcm;
+	/** Set once decoding was tried, so a broken file is only read once. */
+	bool resolved = false;
+};
+
+[[nodiscard]] std::optional<std::string> ReadTextFile(const std::string &path)
+{
+	FILE *file = OpenFile(path.c_str(), "rb");
+	if (file == nullptr)
+		return std::nullopt;
+	std::string text;
+	char buffer[4096];
+	size_t read;
+	while ((read = std::fread(buffer, 1, sizeof(buffer), file)) > 0)
+		text.append(buffer, read);
+	std::fclose(file);
+	return text;
+}
+
+/** @brief Calls `visit` with the two tab separated fields of each line. */
+template <typename Visit>
+void ForEachTabSeparatedLine(std::string_view text, Visit &&visit)
+{
+	for (std::string_view line : SplitByChar(text, '\n')) {
+		if (!line.empty() && line.back() == '\r')
+			line.remove_suffix(1);
+		const size_t tab = line.find('\t');
+		if (tab == std::string_view::npos || tab == 0 || tab + 1 == line.size())
+			continue;
+		visit(line.substr(0, tab), line.substr(tab + 1));
+	}
+}
+
+[[nodiscard]] bool IsMp3File(std::string_view file)
+{
+	return file.size() >= 4 && (file.ends_with(".mp3") || file.ends_with(".MP3"));
+}
+
+class SpeechClipBackend final : public SpeechBackend {
+public:
+	SpeechClipBackend(std::unique_ptr<SpeechBackend> fallback, std::string directory)
+	    : fallback_(std::move(fallback))
+	    , directory_(std::move(directory))
+	{
+	}
+
+	bool Open() override
+	{
+		LoadClips();
+		LoadVocabulary();
+		fallbackOpen_ = fallback_->Open();
+		return fallbackOpen_ || !clips_.empty();
+	}
+
+	void Close() override
+	{
+		voice_.Close();
+		if (fallbackOpen_)
+			fallback_->Close();
+		fallbackOpen_ = false;
+		WriteVocabulary();
+	}
+
+	void Speak(std::string_view text, bool interrupt) override
+	{
+		if (PlayClip(text)) {
+			// The clip is heard right away, so whatever the speech engine is saying would only talk over it.
+			if (interrupt && fallbackOpen_)
+				fallback_->Silence();
+			return;
+		}
+		if (interrupt)
+			voice_.Stop();
+		CountMissing(text);
+		if (fallbackOpen_)
+			fallback_->Speak(text, interrupt);
+	}
+
+	void Silence() override
+	{
+		voice_.Stop();
+		if (fallbackOpen_)
+			fallback_->Silence();
+	}
+
+	[[nodiscard]] std::string Name() const override
+	{
+		return StrCat(fallback_->Name(), " with ", clips_.size(), " speech clips");
+	}
+
+	[[nodiscard]] std::optional<std::chrono::microseconds> OutputLatency() const override
+	{
+		if (lastWasClip_)
+			return std::nullopt;
+		return fallback_->OutputLatency();
+	}
+
+private:
+	void LoadClips()
+	{
+		const std::optional<std::string> index = ReadTextFile(StrCat(directory_, "clips.tsv"));
+		if (!index.has_value()) {
+			LogVerbose("No speech clips in {}", directory_);
+			return;
+		}
+		ForEachTabSeparatedLine(*index, [&](std::string_view file, std::string_view text) {
+			clips_.emplace(std::string(text), SpeechClip { .file = StrCat(directory_, file) });
+		});
+		LogVerbose("Loaded {} speech clips from {}", clips_.size(), directory_);
+	}
+
+	void LoadVocabulary()
+	{
+		const std::optional<std::string> vocabulary = ReadTextFile(StrCat(directory_, "vocabulary.txt"));
+		if (!vocabulary.has_value())
+			return;
+		ForEachTabSeparatedLine(*vocabulary, [&](std::string_view count, std::string_view text) {
+			const ParseIntResult<uint32_t> parsed = ParseInt<uint32_t>(count);
+			if (parsed.has_value())
+				missing_[std::string(text)] += *parsed;
+		});
+	}
+
+	void WriteVocabulary()
+	{
+		if (missing_.empty())
+			return;
+		std::vector<std::pair<std::string_view, uint32_t>> entries;
+		entries.reserve(missing_.size());
+		for (const auto &[text, count] : missing_) {
+			if (!clips_.contains(text))
+				entries.emplace_back(text, count);
+		}
+		std::sort(entries.begin(), entries.end(), [](const auto &a, const auto &b) {
+			return a.second != b.second ? a.second > b.second : a.first < b.first;
+		});
+		if (entries.size() > MaxVocabularySize)
+			entries.resize(MaxVocabularySize);
+
+		RecursivelyCreateDir(directory_.c_str());
+		const std::string path = StrCat(directory_, "vocabulary.txt");
+		FILE *file = OpenFile(path.c_str(), "wb");
+		if (file == nullptr) {
+			LogError("Failed to write {}", path);
+			return;
+		}
+		for (const auto &[text, count] : entries) {
+			const std::string line = StrCat(count, "\t", text, "\n");
+			std::fwrite(line.data(), 1, line.size(), file);
+		}
+		std::fclose(file);
+	}
+
+	void CountMissing(std::string_view text)
+	{
+		if (text.empty() || text.size() > MaxSpeechClipTextLength || text.find_first_of("\t\r\n") != std::string_view::npos)
+			return;
+		if (const auto it = missing_.find(text); it != missing_.end())
+			it->second++;
+		else
+			missing_.emplace(std::string(text), 1);
+	}
+
+	/** @brief Plays the clip of the text, false if it has none or the audio device isn't up yet. */
+	bool PlayClip(std::string_view text)
+	{
+		lastWasClip_ = false;
+		if (!gbSndInited)
+			return false;
+		const auto it = clips_.find(text);
+		if (it == clips_.end())
+			return false;
+		SpeechClip &clip = it->second;
+		if (!clip.resolved) {
+			clip.resolved = true;
+			clip.pcm = Decode(clip.file);
+			if (clip.pcm == nullptr)
+				LogWarn("Failed to decode speech clip {}", clip.file);
+		}
+		if (clip.pcm == nullptr)
+			return false;
+		if (!voice_.IsOpen() && !voice_.Open())
+			return false;
+		voice_.Play(*clip.pcm, /*intervalMs=*/0, ClipPlacement);
+		lastWasClip_ = true;
+		return true;
+	}
+
+	[[nodiscard]] static std::shared_ptr<const PcmBuffer> Decode(const std::string &path)
+	{
+		AssetRef ref = FindAsset(path);
+		if (!ref.ok())
+			return nullptr;
+		const size_t size = ref.size();
+		AssetHandle handle = OpenAsset(std::move(ref), /*threadsafe=*/true);
+		if (size == 0 || !handle.ok())
+			return nullptr;
+		std::unique_ptr<std::uint8_t[]> fileData { new std::uint8_t[size] };
+		if (!handle.read(fileData.get(), size))
+			return nullptr;
+		return DecodeToPcm(fileData.get(), size, IsMp3File(path));
+	}
+
+	std::unique_ptr<SpeechBackend> fallback_;
+	bool fallbackOpen_ = false;
+	std::string directory_;
+	ankerl::unordered_dense::map<std::string, SpeechClip, StringViewHash, StringViewEquals> clips_;
+	/** How often each short announcement without a clip was spoken, this run and the ones before. */
+	ankerl::unordered_dense::map<std::string, uint32_t, StringViewHash, StringViewEquals> missing_;
+	/** Declared after the clips, so it stops playing before their samples are freed. */
+	CueVoice voice_;
+	bool lastWasClip_ = false;
+};
+
+} // namespace
+
+std::unique_ptr<SpeechBackend> CreateSpeechClipBackend(std::unique_ptr<SpeechBackend> fallback, std::string directory)
+{
+	return std::make_unique<SpeechClipBackend>(std::move(fallback), std::move(directory));
+}
+
+std::string GetSpeechClipDirectory(std::string_view languageCode)
+{
+	return StrCat(paths::PrefPath(), "speech" DIRECTORY_SEPARATOR_STR, languageCode, DIRECTORY_SEPARATOR_STR);
+}
+
+} // namespace devilution
@@ -0,0 +1,35 @@
+/**
+ * @file speech_clips.hpp
+ *
+ * Interface of the recorded clips that short announcements are played from instead of the speech engine.
+ */
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include "utils/speech_backend.hpp"
+
+namespace devilution {
+
+/** Announcements up to this many bytes are worth a clip, longer ones are always spoken. */
+constexpr size_t MaxSpeechClipTextLength = 48;
+
+/**
+ * @brief Plays the announcements that have a recorded clip, and speaks the others through `fallback`.
+ *
+ * The clips are listed in `clips.tsv` in `directory`, a WAV or MP3 file name and the exact text
+ * per line, as written by tools/prerender_speech.py. Clips play on their own cue voice, which
+ * starts within an audio buffer instead of waiting for the speech engine.
+ *
+ * Short announcements without a clip are counted, and on Close() the most frequent ones are
+ * written to `vocabulary.txt` in the same directory, for the tool to render next.
+ */
+std::unique_ptr<SpeechBackend> CreateSpeechClipBackend(std::unique_ptr<SpeechBackend> fallback, std::string directory);
+
+/** @brief Where the clips of a language are kept, in the pref path. */
+[[nodiscard]] std::string GetSpeechClipDirectory(std::string_view languageCode);
+
+} // namespace devilution
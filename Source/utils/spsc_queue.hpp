@@ -0,0 +1,57 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+namespace devilution {
+
+/**
+ * @brief A fixed-capacity queue for one producer thread and one consumer thread.
+ *
+ * Neither side ever blocks or takes a lock, which makes it safe to consume from the audio callback.
+ *
+ * @tparam T element type, copied in and out of the queue.
+ * @tparam N capacity.
+ */
+template <class T, size_t N>
+class SpscQueue {
+public:
+	/** @brief Adds an element, only call from the producer thread. @return False if the queue is full. */
+	bool Push(const T &value)
+	{
+		const size_t tail = tail_.load(std::memory_order_relaxed);
+		const size_t next = (tail + 1) % Slots;
+		if (next == head_.load(std::memory_order_acquire))
+			return false;
+		elements_[tail] = value;
+		tail_.store(next, std::memory_order_release);
+		return true;
+	}
+
+	/** @brief Removes the oldest element, only call from the consumer thread. @return False if the queue is empty. */
+	bool Pop(T &value)
+	{
+		const size_t head = head_.load(std::memory_order_relaxed);
+		if (head == tail_.load(std::memory_order_acquire))
+			return false;
+		value = elements_[head];
+		head_.store((head + 1) % Slots, std::memory_order_release);
+		return true;
+	}
+
+	[[nodiscard]] bool empty() const
+	{
+		return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+	}
+
+private:
+	// One slot always stays empty to tell a full queue from an empty one.
+	static constexpr size_t Slots = N + 1;
+
+	std::array<T, Slots> elements_ {};
+	std::atomic<size_t> head_ { 0 };
+	std::atomic<size_t> tail_ { 0 };
+};
+
+} // namespace devilution
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+namespace devilution {
+
+/**
+ * @brief Counts durations in buckets that grow with the duration, so percentiles are cheap to find.
+ *
+ * Each power of two is split into 8 buckets, so a percentile is at most 12.5% above the real one.
+ */
+class TimeHistogram {
+public:
+	void Add(uint32_t microseconds)
+	{
+		buckets_[BucketIndex(microseconds)]++;
+		count_++;
+		max_ = std::max(max_, microseconds);
+	}
+
+	void Clear()
+	{
+		buckets_ = {};
+		count_ = 0;
+		max_ = 0;
+	}
+
+	[[nodiscard]] uint32_t count() const { return count_; }
+	[[nodiscard]] uint32_t max() const { return max_; }
+
+	/**
+	 * @brief The time that the given share of the samples took at most, rounded up to its bucket.
+	 * @param fraction Between 0 and 1, e.g. 0.99 for p99
+	 */
+	[[nodiscard]] uint32_t Percentile(double fraction) const
+	{
+		if (count_ == 0)
+			return 0;
+		const auto rank = std::max<uint32_t>(static_cast<uint32_t>(std::ceil(fraction * count_)), 1);
+		uint32_t seen = 0;
+		for (size_t i = 0; i < buckets_.size(); i++) {
+			seen += buckets_[i];
+			if (seen >= rank)
+				return std::min(BucketUpperBound(i), max_);
+		}
+		return max_;
+	}
+
+private:
+	static constexpr unsigned SubBucketBits = 3;
+	static constexpr uint32_t SubBuckets = 1U << SubBucketBits;
+	static constexpr size_t BucketCount = (32 - SubBucketBits + 1) * SubBuckets;
+
+	[[nodiscard]] static size_t BucketIndex(uint32_t microseconds)
+	{
+		if (microseconds < SubBuckets)
+			return microseconds;
+		const unsigned exponent = std::bit_width(microseconds) - 1;
+		const uint32_t subBucket = (microseconds >> (exponent - SubBucketBits)) & (SubBuckets - 1);
+		return (exponent - SubBucketBits + 1) * SubBuckets + subBucket;
+	}
+
+	[[nodiscard]] static uint32_t BucketUpperBound(size_t index)
+	{
+		if (index < SubBuckets)
+			return static_cast<uint32_t>(index);
+		const auto exponent = static_cast<unsigned>(index / SubBuckets + SubBucketBits - 1);
+		const uint64_t lower = static_cast<uint64_t>(SubBuckets + index % SubBuckets) << (exponent - SubBucketBits);
+		return static_cast<uint32_t>(lower + (uint64_t { 1 } << (exponent - SubBucketBits)) - 1);
+	}
+
+	std::array<uint32_t, BucketCount> buckets_ {};
+	uint32_t count_ = 0;
+	uint32_t max_ = 0;
+};
+
+} // namespace devilution
@@ -1,15 +1,51 @@
 #include "utils/utf8.hpp"
 
+#include <algorithm>
+#include <bit>
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
 #include <string_view>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define DEVILUTIONX_UTF8_SSE2
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define DEVILUTIONX_UTF8_NEON
+#endif
+
 #include <SheenBidi/SheenBidi.h>
 
 namespace devilution {
 
-char32_t DecodeFirstUtf8CodePoint(std::string_view input, std::size_t *len)
+namespace {
+
+/**
+ * @brief Appends UTF8-encoded input to `out`, copying runs of ASCII and passing the other code points to `appendCodePoint`.
+ */
+template <typename String, typename AppendCodePoint>
+void AppendDecodedUtf8(std::string_view input, String &out, AppendCodePoint &&appendCodePoint)
+{
+	// Every code unit of the output needs at least one byte of input.
+	out.reserve(out.size() + input.size());
+	while (!input.empty()) {
+		const std::size_t ascii = CountAsciiPrefix(input);
+		out.append(input.begin(), input.begin() + static_cast<std::ptrdiff_t>(ascii));
+		input.remove_prefix(ascii);
+		if (input.empty())
+			break;
+
+		std::size_t len;
+		const char32_t codepoint = DecodeFirstMultiByteUtf8CodePoint(input, &len);
+		input.remove_prefix(std::max<std::size_t>(len, 1));
+		appendCodePoint(codepoint);
+	}
+}
+
+} // namespace
+
+char32_t DecodeFirstMultiByteUtf8CodePoint(std::string_view input, std::size_t *len)
 {
 	SBUInteger index = 0;
 	const SBCodepoint result = SBCodepointDecodeNextFromUTF8(
@@ -18,6 +54,47 @@ char32_t DecodeFirstUtf8CodePoint(std::string_view input, std::size_t *len)
 	return result;
 }
 
+std::size_t CountAsciiPrefix(std::string_view input)
+{
+	const char *begin = input.data();
+	const char *end = begin + input.size();
+	const char *it = begin;
+
+#if defined(DEVILUTIONX_UTF8_SSE2)
+	while (end - it >= 16) {
+		const __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i *>(it));
+		// The high bit of every byte that isn't ASCII.
+		const auto mask = static_cast<uint32_t>(_mm_movemask_epi8(chars));
+		if (mask != 0)
+			return static_cast<std::size_t>(it - begin) + std::countr_zero(mask);
+		it += 16;
+	}
+#elif defined(DEVILUTIONX_UTF8_NEON)
+	const uint8x16_t firstNonAscii = vdupq_n_u8(0x80);
+	while (end - it >= 16) {
+		const uint8x16_t chars = vld1q_u8(reinterpret_cast<const uint8_t *>(it));
+		// Narrows every match to four bits, as NEON has no movemask.
+		const uint8x16_t matches = vcgeq_u8(chars, firstNonAscii);
+		const uint64_t mask = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(matches), 4)), 0);
+		if (mask != 0)
+			return static_cast<std::size_t>(it - begin) + std::countr_zero(mask) / 4;
+		it += 16;
+	}
+#endif
+
+	constexpr uint64_t HighBits = 0x8080808080808080;
+	while (end - it >= 8) {
+		uint64_t word;
+		std::memcpy(&word, it, sizeof(word));
+		if ((word & HighBits) != 0)
+			break;
+		it += 8;
+	}
+	while (it != end && static_cast<unsigned char>(*it) < 0x80)
+		++it;
+	return static_cast<std::size_t>(it - begin);
+}
+
 std::string_view TruncateUtf8(std::string_view str, std::size_t len)
 {
 	if (str.size() > len) {
@@ -66,4 +143,22 @@ void AppendUtf8(char32_t codepoint, std::string &out)
 	}
 }
 
+void AppendUtf16(std::string_view input, std::u16string &out)
+{
+	AppendDecodedUtf8(input, out, [&](char32_t codepoint) {
+		if (codepoint <= 0xFFFF) {
+			out += static_cast<char16_t>(codepoint);
+		} else {
+			const char32_t offset = codepoint - 0x10000;
+			out += static_cast<char16_t>(0xD800 | (offset >> 10));
+			out += static_cast<char16_t>(0xDC00 | (offset & 0x3FF));
+		}
+	});
+}
+
+void AppendUtf32(std::string_view input, std::u32string &out)
+{
+	AppendDecodedUtf8(input, out, [&](char32_t codepoint) { out += codepoint; });
+}
+
 } // namespace devilution
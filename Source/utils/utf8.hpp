@@ -8,13 +8,35 @@ namespace devilution {
 
 constexpr char32_t Utf8DecodeError = 0xFFFD;
 
+/**
+ * Decodes the first code point from UTF8-encoded input with the full decoder.
+ *
+ * Use `DecodeFirstUtf8CodePoint`, which only calls this when the input doesn't start with ASCII.
+ */
+char32_t DecodeFirstMultiByteUtf8CodePoint(std::string_view input, std::size_t *len);
+
 /**
  * Decodes the first code point from UTF8-encoded input.
  *
  * Sets `len` to the length of the code point in bytes.
  * Returns `Utf8DecodeError` on error.
  */
-char32_t DecodeFirstUtf8CodePoint(std::string_view input, std::size_t *len);
+inline char32_t DecodeFirstUtf8CodePoint(std::string_view input, std::size_t *len)
+{
+	// Nearly all game text is ASCII, which needs no decoding.
+	if (!input.empty() && static_cast<unsigned char>(input[0]) < 0x80) {
+		*len = 1;
+		return static_cast<char32_t>(input[0]);
+	}
+	return DecodeFirstMultiByteUtf8CodePoint(input, len);
+}
+
+/**
+ * @brief Returns the number of bytes before the first one that isn't ASCII.
+ *
+ * Looks at 16 bytes at a time with SSE2 or NEON and eight at a time otherwise.
+ */
+std::size_t CountAsciiPrefix(std::string_view input);
 
 /**
  * Decodes and removes the first code point from UTF8-encoded input.
@@ -92,6 +114,20 @@ void CopyUtf8(char *dest, std::string_view source, std::size_t bytes);
 
 void AppendUtf8(char32_t codepoint, std::string &out);
 
+/**
+ * @brief Appends UTF8-encoded input to `out` as UTF-16.
+ *
+ * Invalid sequences are replaced with `Utf8DecodeError`. Runs of ASCII are copied without decoding.
+ */
+void AppendUtf16(std::string_view input, std::u16string &out);
+
+/**
+ * @brief Appends the code points of UTF8-encoded input to `out`.
+ *
+ * Invalid sequences are replaced with `Utf8DecodeError`. Runs of ASCII are copied without decoding.
+ */
+void AppendUtf32(std::string_view input, std::u32string &out);
+
 /** @brief Truncates `str` to at most `len` at a code point boundary. */
 std::string_view TruncateUtf8(std::string_view str, std::size_t len);
 
@@ -1,5 +1,6 @@
 local function CreateEvent()
   local functions = {}
+  local batchedFunctions = {}
   return {
     ---Adds an event handler.
     ---
@@ -37,6 +38,41 @@ local function CreateEvent()
       end
     end,
     __sig_trigger = "(...)",
+
+    ---Adds a handler that is called once per game tick with all the events of that tick.
+    ---
+    ---Only the player and monster events are batched. The handler gets a view of the events,
+    ---`#batch` of them, with `batch:subject(i)`, `batch:arg1(i)` and `batch:arg2(i)` holding the
+    ---arguments `trigger` gets. The view is only valid during the call.
+    ---@param func function
+    addBatched = function(func)
+      table.insert(batchedFunctions, func)
+    end,
+    __sig_addBatched = "(func: function)",
+
+    ---Removes the batched event handler.
+    ---@param func function
+    removeBatched = function(func)
+      for i, f in ipairs(batchedFunctions) do
+        if f == func then
+          table.remove(batchedFunctions, i)
+          break
+        end
+      end
+    end,
+    __sig_removeBatched = "(func: function)",
+
+    ---Triggers the batched handlers, with the events of a tick.
+    ---@param batch userdata
+    triggerBatch = function(batch)
+      for _, func in ipairs(batchedFunctions) do
+        func(batch)
+      end
+    end,
+
+    -- Read by the engine, which skips triggering events nothing was added to.
+    __handlers = functions,
+    __batchedHandlers = batchedFunctions,
   }
 end
 
@@ -0,0 +1,194 @@
+/**
+ * @file accessibility_benchmark.cpp
+ *
+ * Benchmarks of the accessibility lookups that run every tick or key press, on generated dungeons.
+ */
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <optional>
+
+#include <benchmark/benchmark.h>
+
+#include "accessibility_queries.hpp"
+#include "engine/assets.hpp"
+#include "engine/load_file.hpp"
+#include "engine/points_in_rectangle_range.hpp"
+#include "items.h"
+#include "levels/gendung.h"
+#include "levels/tile_properties.hpp"
+#include "multi.h"
+#include "player.h"
+#include "quests.h"
+#include "utils/log.hpp"
+#include "utils/paths.h"
+
+namespace devilution {
+namespace {
+
+/** Dungeons from test/fixtures/diablo, one per level type. */
+struct BenchmarkLevel {
+	uint8_t level;
+	uint32_t seed;
+	const char *til;
+};
+
+constexpr std::array<BenchmarkLevel, 4> Levels { {
+	{ 1, 2588, "levels\\l1data\\l1.til" },
+	{ 5, 1677631846, "levels\\l2data\\l2.til" },
+	{ 10, 879635115, "levels\\l3data\\l3.til" },
+	{ 13, 428074402, "levels\\l4data\\l4.til" },
+} };
+
+/** How far around the start the level counts as explored, like after walking in from the stairs. */
+constexpr int ExploredRadius = 8;
+/** Ground items scattered over the level, about what a cleared level leaves behind. */
+constexpr int ScatteredItems = 60;
+/** The radius of the tracker hotkeys. */
+constexpr int TrackerDistance = 12;
+
+std::optional<size_t> LoadedLevel;
+
+void InitOnce()
+{
+	[[maybe_unused]] static const bool GlobalInitDone = []() {
+		// The set pieces come from the fixtures, the same as in the drlg tests.
+		paths::SetPrefPath(paths::BasePath() + "test/fixtures/");
+		LoadCoreArchives();
+		LoadGameArchives();
+		if (!HaveMainData()) {
+			LogError("This benchmark needs spawn.mpq or diabdat.mpq");
+			exit(1);
+		}
+		LoadModArchives({});
+
+		Players.resize(1);
+		MyPlayer = &Players[0];
+		sgGameInitInfo.fullQuests = 1;
+		LoadQuestData();
+		InitQuests();
+		return true;
+	}();
+}
+
+void ScatterItems()
+{
+	ActiveItemCount = 0;
+	int placed = 0;
+	for (const Point position : PointsInRectangle(Rectangle { { 0, 0 }, Size { MAXDUNX, MAXDUNY } })) {
+		dItem[position.x][position.y] = 0;
+		// Every 53rd walkable tile spreads the items over the whole level.
+		if (placed == ScatteredItems || !IsTileWalkable(position) || (position.x * MAXDUNY + position.y) % 53 != 0)
+			continue;
+		Item &item = Items[placed];
+		item = {};
+		item._itype = ItemType::Misc;
+		item._iClass = ICLASS_MISC;
+		item.position = position;
+		dItem[position.x][position.y] = static_cast<int8_t>(placed + 1);
+		ActiveItems[ActiveItemCount++] = static_cast<uint8_t>(placed);
+		placed++;
+	}
+}
+
+/** @brief Generates the level and puts the player on its entrance. */
+Point LoadLevel(size_t index)
+{
+	InitOnce();
+	const BenchmarkLevel &level = Levels[index];
+	if (LoadedLevel != index) {
+		LevelSeeds[level.level] = std::nullopt;
+		currlevel = level.level;
+		leveltype = GetLevelType(level.level);
+		if (!LoadLevelSOLData().has_value()) {
+			LogError("Failed to load the tile properties of level {}", level.level);
+			exit(1);
+		}
+		pMegaTiles = LoadFileInMem<MegaTile>(level.til);
+		CreateDungeon(level.seed, ENTRY_MAIN);
+		ScatterItems();
+		LoadedLevel = index;
+	}
+
+	Player &player = *MyPlayer;
+	player.setLevel(level.level);
+	player.position.tile = ViewPosition;
+	player.position.future = ViewPosition;
+	for (const Point position : PointsInRectangle(Rectangle { { 0, 0 }, Size { MAXDUNX, MAXDUNY } })) {
+		if (ViewPosition.ApproxDistance(position) <= ExploredRadius)
+			dFlags[position.x][position.y] |= DungeonFlag::Explored;
+		else
+			dFlags[position.x][position.y] &= ~DungeonFlag::Explored;
+	}
+	return ViewPosition;
+}
+
+/** @brief A reachable tile about `distance` tiles from the start, so paths of several lengths can be compared. */
+std::optional<Point> FindDestination(Point start, int distance)
+{
+	std::optional<Point> best;
+	int bestError = 0;
+	for (const Point position : PointsInRectangle(Rectangle { start, distance })) {
+		if (!InDungeonBounds(position) || !IsTileWalkable(position))
+			continue;
+		const int error = std::abs(start.ApproxDistance(position) - distance);
+		if (best && error >= bestError)
+			continue;
+		if (!accessibility_queries::FindKeyboardWalkPathForSpeech(*MyPlayer, start, position))
+			continue;
+		best = position;
+		bestError = error;
+		if (error == 0)
+			break;
+	}
+	return best;
+}
+
+void BM_FindKeyboardWalkPathForSpeech(benchmark::State &state)
+{
+	const Point start = LoadLevel(static_cast<size_t>(state.range(0)));
+	const std::optional<Point> destination = FindDestination(start, static_cast<int>(state.range(1)));
+	if (!destination) {
+		state.SkipWithError("No reachable destination at that distance");
+		return;
+	}
+	for (auto _ : state) {
+		std::optional<WalkPath> path = accessibility_queries::FindKeyboardWalkPathForSpeech(*MyPlayer, start, *destination);
+		benchmark::DoNotOptimize(path);
+	}
+}
+BENCHMARK(BM_FindKeyboardWalkPathForSpeech)->ArgsProduct({ { 0, 1, 2, 3 }, { 5, 10, 20, 40 } });
+
+void BM_FindNearestUnexploredTile(benchmark::State &state)
+{
+	const Point start = LoadLevel(static_cast<size_t>(state.range(0)));
+	for (auto _ : state) {
+		std::optional<Point> target = accessibility_queries::FindNearestUnexploredTile(*MyPlayer, start);
+		benchmark::DoNotOptimize(target);
+	}
+}
+BENCHMARK(BM_FindNearestUnexploredTile)->DenseRange(0, 3);
+
+void BM_CollectNearbyTrackerCandidates(benchmark::State &state)
+{
+	const Point start = LoadLevel(static_cast<size_t>(state.range(0)));
+	for (auto _ : state) {
+		size_t candidates = accessibility_queries::CollectNearbyTrackerCandidates(start, TrackerDistance);
+		benchmark::DoNotOptimize(candidates);
+	}
+}
+BENCHMARK(BM_CollectNearbyTrackerCandidates)->DenseRange(0, 3);
+
+void BM_FindInteractTargetInRange(benchmark::State &state)
+{
+	const Point start = LoadLevel(static_cast<size_t>(state.range(0)));
+	for (auto _ : state) {
+		bool found = accessibility_queries::HasInteractTargetInRange(*MyPlayer, start);
+		benchmark::DoNotOptimize(found);
+	}
+}
+BENCHMARK(BM_FindInteractTargetInRange)->DenseRange(0, 3);
+
+} // namespace
+} // namespace devilution
@@ -0,0 +1,68 @@
+#include "engine/assets.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include <expected.hpp>
+#include <gtest/gtest.h>
+
+#ifndef UNPACKED_MPQS
+#include "mpq/mpq_reader.hpp"
+#include "mpq/mpq_writer.hpp"
+#endif
+#include "utils/file_util.h"
+
+namespace devilution {
+namespace {
+
+#ifndef UNPACKED_MPQS
+constexpr int TestMpqPriority = 12345;
+
+void WriteTestFile(MpqWriter &writer, std::string_view name, std::string_view contents)
+{
+	ASSERT_TRUE(writer.WriteFile(name, reinterpret_cast<const std::byte *>(contents.data()), contents.size()));
+}
+
+std::string ReadTestFile(std::string_view name)
+{
+	tl::expected<AssetData, std::string> asset = LoadAsset(name);
+	if (!asset.has_value())
+		return {};
+	return std::string(static_cast<std::string_view>(*asset));
+}
+
+TEST(AssetsTest, FindsFilesAfterUnusedBlockTableEntries)
+{
+	const std::string path = "Test_AssetsTest_SparseBlockTable.mpq";
+	RemoveFile(path.c_str());
+	{
+		MpqWriter writer(path);
+		WriteTestFile(writer, "assets_test\\first.txt", "one");
+		WriteTestFile(writer, "assets_test\\second.txt", "two");
+		WriteTestFile(writer, "assets_test\\third.txt", "three");
+		// Leaves an unused block table entry between the ones of the first and the third file,
+		// which libmpq leaves out of its file numbers.
+		writer.RemoveHashEntry("assets_test\\second.txt");
+	}
+
+	int32_t error = 0;
+	std::optional<MpqArchive> archive = MpqArchive::Open(path.c_str(), error);
+	ASSERT_TRUE(archive.has_value()) << MpqArchive::ErrorMessage(error);
+	MpqArchives.emplace(TestMpqPriority, *std::move(archive));
+	RebuildMpqFileIndex();
+
+	EXPECT_EQ(ReadTestFile("assets_test\\first.txt"), "one");
+	EXPECT_EQ(ReadTestFile("assets_test\\third.txt"), "three");
+	EXPECT_FALSE(FindAsset("assets_test\\second.txt").ok());
+
+	MpqArchives.erase(TestMpqPriority);
+	RebuildMpqFileIndex();
+	RemoveFile(path.c_str());
+}
+#endif
+
+} // namespace
+} // namespace devilution
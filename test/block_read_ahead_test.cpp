@@ -0,0 +1,100 @@
+#include "mpq/block_read_ahead.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include <gtest/gtest.h>
+
+namespace devilution {
+namespace {
+
+constexpr uint32_t NumBlocks = 64;
+constexpr size_t BlockSize = 4;
+constexpr size_t LastBlockSize = 2;
+constexpr int32_t ReadError = 7;
+
+/** Fills every byte of a block with its number. */
+int32_t FillBlock(uint32_t block, uint8_t *out, size_t size)
+{
+	std::memset(out, static_cast<int>(block), size);
+	return 0;
+}
+
+/** @brief Reads `block` and checks that it holds its number. */
+void ExpectBlock(BlockReadAhead &readAhead, uint32_t block)
+{
+	uint8_t out[BlockSize] = {};
+	ASSERT_EQ(readAhead.ReadBlock(block, out, block + 1 == NumBlocks ? LastBlockSize : BlockSize), 0) << "block " << block;
+	EXPECT_EQ(out[0], static_cast<uint8_t>(block));
+}
+
+int32_t ReadBlockError(BlockReadAhead &readAhead, uint32_t block)
+{
+	uint8_t out[BlockSize];
+	return readAhead.ReadBlock(block, out, BlockSize);
+}
+
+TEST(BlockReadAheadTest, ReadsBlocksInOrder)
+{
+	BlockReadAhead readAhead(FillBlock, NumBlocks, BlockSize, LastBlockSize);
+	for (uint32_t block = 0; block < NumBlocks; ++block)
+		ExpectBlock(readAhead, block);
+}
+
+TEST(BlockReadAheadTest, ReturnsTheErrorForTheFailedBlockAndTheOnesAfterIt)
+{
+	BlockReadAhead readAhead(
+	    [](uint32_t block, uint8_t *out, size_t size) { return block == 3 ? ReadError : FillBlock(block, out, size); },
+	    NumBlocks, BlockSize, LastBlockSize);
+	ExpectBlock(readAhead, 0);
+	ExpectBlock(readAhead, 1);
+	ExpectBlock(readAhead, 2);
+	EXPECT_EQ(ReadBlockError(readAhead, 3), ReadError);
+	// Never decompressed, as the background thread stopped at block 3.
+	EXPECT_EQ(ReadBlockError(readAhead, 4), ReadError);
+	EXPECT_EQ(ReadBlockError(readAhead, 10), ReadError);
+}
+
+TEST(BlockReadAheadTest, ReturnsTheErrorWhenSkippingPastTheFailedBlock)
+{
+	BlockReadAhead readAhead(
+	    [](uint32_t block, uint8_t *out, size_t size) { return block == 2 ? ReadError : FillBlock(block, out, size); },
+	    NumBlocks, BlockSize, LastBlockSize);
+	ExpectBlock(readAhead, 0);
+	// Within the window, so it waits for the background thread, which stops at block 2.
+	EXPECT_EQ(ReadBlockError(readAhead, 5), ReadError);
+}
+
+TEST(BlockReadAheadTest, SeeksOutsideTheWindow)
+{
+	BlockReadAhead readAhead(FillBlock, NumBlocks, BlockSize, LastBlockSize);
+	ExpectBlock(readAhead, 0);
+	ExpectBlock(readAhead, 40);
+	ExpectBlock(readAhead, 41);
+	ExpectBlock(readAhead, 2);
+	ExpectBlock(readAhead, 3);
+	ExpectBlock(readAhead, NumBlocks - 1);
+}
+
+TEST(BlockReadAheadTest, SeekingAfterAnErrorStartsOver)
+{
+	static std::atomic<bool> failed;
+	failed = false;
+	BlockReadAhead readAhead(
+	    [](uint32_t block, uint8_t *out, size_t size) {
+		    if (block == 3 && !failed.exchange(true))
+			    return ReadError;
+		    return FillBlock(block, out, size);
+	    },
+	    NumBlocks, BlockSize, LastBlockSize);
+	ExpectBlock(readAhead, 0);
+	EXPECT_EQ(ReadBlockError(readAhead, 3), ReadError);
+	ExpectBlock(readAhead, 30);
+	ExpectBlock(readAhead, 3);
+	ExpectBlock(readAhead, 4);
+}
+
+} // namespace
+} // namespace devilution
@@ -56,8 +56,33 @@ void BM_RenderLargeClx(benchmark::State &state)
 	state.SetItemsProcessed(state.iterations());
 }
 
+void BM_RenderClxOutline(benchmark::State &state)
+{
+	const SDLSurfaceUniquePtr sdl_surface = SDLWrap::CreateRGBSurfaceWithFormat(
+	    /*flags=*/0, /*width=*/640, /*height=*/480, /*depth=*/8, SDL_PIXELFORMAT_INDEX8);
+	if (sdl_surface == nullptr) {
+		LogError("Failed to create SDL Surface: {}", SDL_GetError());
+		exit(1);
+	}
+	const Surface out = Surface(sdl_surface.get());
+	const OwnedClxSpriteList sprites = LoadClx("data\\resistance.clx");
+
+	// Outlines all the sprites every frame, as when several objects are highlighted at once.
+	const size_t numSprites = sprites.numSprites();
+	for (auto _ : state) {
+		for (size_t i = 0; i < numSprites; ++i) {
+			ClxDrawOutline(out, 149, Point { static_cast<int>(i * 100), static_cast<int>(i * 60) + 60 }, sprites[i]);
+		}
+		uint8_t color = out[Point { 120, 120 }];
+		benchmark::DoNotOptimize(color);
+	}
+	state.SetItemsProcessed(state.iterations() * numSprites);
+	ClearClxDrawCache();
+}
+
 BENCHMARK(BM_RenderSmallClx);
 BENCHMARK(BM_RenderLargeClx);
+BENCHMARK(BM_RenderClxOutline);
 
 } // namespace
 } // namespace devilution
@@ -0,0 +1,42 @@
+#include "codec.h"
+
+#include <cstddef>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+namespace devilution {
+namespace {
+
+constexpr char Password[] = "xrgyrkj1";
+
+// About the size of a dungeon level in a save.
+constexpr size_t LevelSize = 256 * 1024;
+
+void BM_Encode(benchmark::State &state)
+{
+	std::vector<std::byte> data(codec_get_encoded_len(LevelSize));
+	for (auto _ : state) {
+		codec_encode(data.data(), LevelSize, data.size(), Password);
+		benchmark::DoNotOptimize(data.data());
+	}
+	state.SetBytesProcessed(state.iterations() * LevelSize);
+}
+
+void BM_Decode(benchmark::State &state)
+{
+	std::vector<std::byte> encoded(codec_get_encoded_len(LevelSize));
+	codec_encode(encoded.data(), LevelSize, encoded.size(), Password);
+	std::vector<std::byte> data(encoded.size());
+	for (auto _ : state) {
+		data = encoded;
+		benchmark::DoNotOptimize(codec_decode(data.data(), data.size(), Password));
+	}
+	state.SetBytesProcessed(state.iterations() * LevelSize);
+}
+
+BENCHMARK(BM_Encode);
+BENCHMARK(BM_Decode);
+
+} // namespace
+} // namespace devilution
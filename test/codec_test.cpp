@@ -1,9 +1,30 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
 #include <gtest/gtest.h>
 
 #include "codec.h"
+#include "utils/fnv1a.hpp"
 
 using namespace devilution;
 
+namespace {
+
+constexpr char Password[] = "xrgyrkj1";
+
+std::vector<std::byte> MakeTestData(size_t size)
+{
+	std::vector<std::byte> data(codec_get_encoded_len(size));
+	for (size_t i = 0; i < size; ++i)
+		data[i] = static_cast<std::byte>(i * 7 + 3);
+	return data;
+}
+
+} // namespace
+
 TEST(Codec, codec_get_encoded_len)
 {
 	EXPECT_EQ(codec_get_encoded_len(50), 72);
@@ -13,3 +34,38 @@ TEST(Codec, codec_get_encoded_len_eq)
 {
 	EXPECT_EQ(codec_get_encoded_len(128), 136);
 }
+
+// The encoded bytes have to stay the same for saves to stay compatible.
+TEST(Codec, codec_encode_is_stable)
+{
+	const std::pair<size_t, uint64_t> expected[] = {
+		{ 0, 0xacb22139f9bd966d },
+		{ 1, 0x0b22bf9c8c61b97a },
+		{ 63, 0x314447673136f578 },
+		{ 64, 0x07dfe6843ce8a369 },
+		{ 1000, 0xaec2af2bffbb8979 },
+	};
+	for (const auto &[size, hash] : expected) {
+		std::vector<std::byte> data = MakeTestData(size);
+		codec_encode(data.data(), size, data.size(), Password);
+		EXPECT_EQ(Fnv1a(data), hash) << "size " << size;
+	}
+}
+
+TEST(Codec, codec_decode_restores_data)
+{
+	for (const size_t size : { 1, 63, 64, 65, 1000 }) {
+		const std::vector<std::byte> original = MakeTestData(size);
+		std::vector<std::byte> data = original;
+		codec_encode(data.data(), size, data.size(), Password);
+		ASSERT_EQ(codec_decode(data.data(), data.size(), Password), size);
+		EXPECT_TRUE(std::equal(data.begin(), data.begin() + size, original.begin())) << "size " << size;
+	}
+}
+
+TEST(Codec, codec_decode_rejects_wrong_password)
+{
+	std::vector<std::byte> data = MakeTestData(100);
+	codec_encode(data.data(), 100, data.size(), Password);
+	EXPECT_EQ(codec_decode(data.data(), data.size(), "szqnlsk1"), 0);
+}
@@ -19,7 +19,21 @@ void BM_Crawl(benchmark::State &state)
 	}
 }
 
+void BM_DoCrawl(benchmark::State &state)
+{
+	const int radius = static_cast<int>(state.range(0));
+	for (auto _ : state) {
+		int sum;
+		DoCrawl(0, radius, [&sum](Displacement d) {
+			sum += d.deltaX + d.deltaY;
+			return true;
+		});
+		benchmark::DoNotOptimize(sum);
+	}
+}
+
 BENCHMARK(BM_Crawl)->RangeMultiplier(4)->Range(1, 20);
+BENCHMARK(BM_DoCrawl)->RangeMultiplier(4)->Range(1, 20);
 
 } // namespace
 } // namespace devilution
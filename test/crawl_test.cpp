@@ -1,4 +1,6 @@
 #include <cmath>
+#include <span>
+#include <vector>
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
@@ -58,5 +60,26 @@ TEST(CrawlTest, VisitationOrderTest)
 	        Displacement(2, 1), Displacement(-2, -1), Displacement(2, -1)));
 }
 
+TEST(CrawlTest, TableMatchesGeneratedRings)
+{
+	for (unsigned r = 0; r <= MaxCrawlTableRadius + 1; r++) {
+		std::vector<Displacement> generated;
+		CrawlRing(static_cast<int>(r), [&](Displacement displacement) {
+			generated.push_back(displacement);
+			return true;
+		});
+		std::vector<Displacement> crawled;
+		Crawl(r, [&](Displacement displacement) {
+			crawled.push_back(displacement);
+			return false;
+		});
+		EXPECT_EQ(crawled, generated) << "radius " << r;
+		if (r <= MaxCrawlTableRadius) {
+			const std::span<const Displacement> ring = CrawlTableRing(r);
+			EXPECT_EQ(std::vector<Displacement>(ring.begin(), ring.end()), generated) << "radius " << r;
+		}
+	}
+}
+
 } // namespace
 } // namespace devilution
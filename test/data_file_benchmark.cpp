@@ -0,0 +1,74 @@
+#include "data/parser.hpp"
+
+#include <cstddef>
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+namespace devilution {
+namespace {
+
+// About the size of a table in a mod that adds a lot of items or monsters.
+constexpr int Records = 5000;
+constexpr int Fields = 24;
+
+std::string MakeTable()
+{
+	std::string table;
+	for (int record = 0; record < Records; record++) {
+		for (int field = 0; field < Fields; field++) {
+			if (field != 0)
+				table += '\t';
+			// A mix of short numbers, empty fields and longer names, like the real tables.
+			switch (field % 4) {
+			case 0:
+				table += std::to_string(record * field);
+				break;
+			case 1:
+				break;
+			case 2:
+				table += "SomeLongerEnumValue,AnotherOne";
+				break;
+			default:
+				table += "x";
+				break;
+			}
+		}
+		table += "\r\n";
+	}
+	return table;
+}
+
+void BM_GetNextField(benchmark::State &state)
+{
+	const std::string table = MakeTable();
+	const char *end = table.data() + table.size();
+	for (auto _ : state) {
+		GetFieldResult result { table.data() };
+		do {
+			result = GetNextField(result.next, end);
+			benchmark::DoNotOptimize(result.value);
+		} while (!result.endOfFile());
+	}
+	state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(table.size()));
+}
+
+void BM_DiscardRemainingFields(benchmark::State &state)
+{
+	const std::string table = MakeTable();
+	const char *end = table.data() + table.size();
+	for (auto _ : state) {
+		GetFieldResult result { table.data() };
+		do {
+			result = DiscardRemainingFields(result.next, end);
+		} while (!result.endOfFile());
+		benchmark::DoNotOptimize(result.next);
+	}
+	state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(table.size()));
+}
+
+BENCHMARK(BM_GetNextField);
+BENCHMARK(BM_DiscardRemainingFields);
+
+} // namespace
+} // namespace devilution
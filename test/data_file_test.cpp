@@ -529,4 +529,29 @@ TEST(DataFileTest, SkipRowIterator)
 	EXPECT_EQ(row, expectedFields.size()) << "Parsing returned fewer records than expected";
 }
 
+TEST(DataFileTest, FindSeparatorsInLongFields)
+{
+	// Long enough that separators land in and between the blocks the scanner checks at once, with control and UTF-8 characters that aren't separators.
+	const std::string_view data = "first field\x0b\x01\tsecond \xc3\xa9 field, longer than sixteen\r\nx\t\t0123456789abcdef\n";
+	const char *end = data.data() + data.size();
+
+	GetFieldResult result = GetNextField(data.data(), end);
+	EXPECT_EQ(result.value, "first field\x0b\x01");
+	EXPECT_EQ(result.status, GetFieldResult::Status::EndOfField);
+	result = GetNextField(result.next, end);
+	EXPECT_EQ(result.value, "second \xc3\xa9 field, longer than sixteen");
+	EXPECT_EQ(result.status, GetFieldResult::Status::EndOfRecord);
+	result = GetNextField(result.next, end);
+	EXPECT_EQ(result.value, "x");
+	result = GetNextField(result.next, end);
+	EXPECT_EQ(result.value, "");
+	result = GetNextField(result.next, end);
+	EXPECT_EQ(result.value, "0123456789abcdef");
+	EXPECT_EQ(result.status, GetFieldResult::Status::EndOfFile);
+
+	result = DiscardRemainingFields(data.data(), end);
+	EXPECT_EQ(result.next, data.data() + data.find("\r\n") + 2);
+	EXPECT_EQ(result.status, GetFieldResult::Status::EndOfRecord);
+}
+
 } // namespace devilution
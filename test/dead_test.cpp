@@ -1,3 +1,5 @@
+#include <cstring>
+
 #include <gtest/gtest.h>
 
 #include "dead.h"
@@ -17,3 +19,30 @@ TEST(Corpses, AddCorpse_OOB)
 	AddCorpse({ 21, 48 }, MaxCorpses + 1, Direction::West);
 	EXPECT_EQ(dCorpse[21][48], 0 + (static_cast<int>(Direction::West) << 5));
 }
+
+TEST(Corpses, CorpseEntries)
+{
+	memset(dCorpse, 0, sizeof(dCorpse));
+	dCorpse[10][20] = 3;
+	SyncCorpseEntries();
+	ASSERT_EQ(GetCorpseEntries().size(), 1U);
+	const int loadedId = GetCorpseEntries()[0].id;
+	EXPECT_EQ(GetCorpseEntries()[0].position, Point(10, 20));
+
+	AddCorpse({ 21, 48 }, 8, Direction::West);
+	AddCorpse({ 21, 48 }, 9, Direction::East);
+	ASSERT_EQ(GetCorpseEntries().size(), 2U);
+	const int addedId = GetCorpseEntries()[1].id;
+	EXPECT_NE(addedId, loadedId);
+
+	RemoveCorpse({ 10, 20 });
+	EXPECT_EQ(dCorpse[10][20], 0);
+	EXPECT_EQ(FindCorpseEntry(loadedId), nullptr);
+	ASSERT_NE(FindCorpseEntry(addedId), nullptr);
+	EXPECT_EQ(FindCorpseEntry(addedId)->position, Point(21, 48));
+
+	// A new corpse on a tile that was emptied gets a new id.
+	AddCorpse({ 10, 20 }, 3, Direction::South);
+	ASSERT_EQ(GetCorpseEntries().size(), 2U);
+	EXPECT_NE(GetCorpseEntries()[1].id, loadedId);
+}
@@ -0,0 +1,80 @@
+#include "engine/frame_pacer.hpp"
+
+#include <chrono>
+
+#include <gtest/gtest.h>
+
+namespace devilution {
+namespace {
+
+using namespace std::chrono_literals;
+
+void AddFrame(FramePacer &pacer, FramePacer::Clock::duration cost)
+{
+	const FramePacer::Clock::time_point start {};
+	pacer.BeginFrame(start);
+	pacer.EndFrame(start + cost);
+}
+
+TEST(FramePacerTest, DrawsUntilFramesAreTimed)
+{
+	FramePacer pacer;
+	EXPECT_EQ(pacer.PredictedFrameCost(), FramePacer::Clock::duration {});
+	EXPECT_TRUE(pacer.ShouldDraw(0ms));
+	EXPECT_FALSE(pacer.ShouldDraw(-1ms));
+}
+
+TEST(FramePacerTest, IgnoresPresentsWithoutFrame)
+{
+	FramePacer pacer;
+	pacer.EndFrame(FramePacer::Clock::time_point {} + 100ms);
+	EXPECT_EQ(pacer.PredictedFrameCost(), FramePacer::Clock::duration {});
+}
+
+TEST(FramePacerTest, FollowsSlowFramesFasterThanQuickOnes)
+{
+	FramePacer pacer;
+	AddFrame(pacer, 40ms);
+	EXPECT_EQ(pacer.PredictedFrameCost(), 20ms);
+	AddFrame(pacer, 40ms);
+	EXPECT_EQ(pacer.PredictedFrameCost(), 30ms);
+	AddFrame(pacer, 14ms);
+	EXPECT_EQ(pacer.PredictedFrameCost(), 28ms);
+}
+
+TEST(FramePacerTest, SkipsFramesThatDelayTheNextTick)
+{
+	FramePacer pacer;
+	for (int i = 0; i < 8; i++)
+		AddFrame(pacer, 30ms);
+	EXPECT_TRUE(pacer.ShouldDraw(40ms));
+	EXPECT_FALSE(pacer.ShouldDraw(20ms));
+}
+
+TEST(FramePacerTest, DrawsAfterTooManySkippedFrames)
+{
+	FramePacer pacer;
+	for (int i = 0; i < FramePacer::MaxSkippedFrames; i++)
+		EXPECT_FALSE(pacer.ShouldDraw(-1ms));
+	EXPECT_TRUE(pacer.ShouldDraw(-1ms));
+	EXPECT_FALSE(pacer.ShouldDraw(-1ms));
+}
+
+TEST(FramePacerTest, ResetForgetsFrames)
+{
+	FramePacer pacer;
+	AddFrame(pacer, 40ms);
+	pacer.Reset();
+	EXPECT_EQ(pacer.PredictedFrameCost(), FramePacer::Clock::duration {});
+}
+
+TEST(FramePacerTest, NextFrameDeadlineKeepsCadence)
+{
+	const FramePacer::Clock::time_point deadline = FramePacer::Clock::time_point {} + 1s;
+	EXPECT_EQ(NextFrameDeadline(deadline, deadline - 5ms, 16ms), deadline + 16ms);
+	EXPECT_EQ(NextFrameDeadline(deadline, deadline + 5ms, 16ms), deadline + 16ms);
+	EXPECT_EQ(NextFrameDeadline(deadline, deadline + 40ms, 16ms), deadline + 56ms);
+}
+
+} // namespace
+} // namespace devilution
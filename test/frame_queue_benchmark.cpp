@@ -0,0 +1,51 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "dvlnet/frame_queue.h"
+
+namespace devilution {
+namespace net {
+namespace {
+
+/** @brief A receive buffer holding back-to-back frames of the given payload size, like a busy TCP stream. */
+buffer_t MakeStream(size_t payloadSize, size_t frames)
+{
+	buffer_t stream;
+	for (size_t i = 0; i < frames; i++) {
+		buffer_t frame = *frame_queue::MakeFrame(buffer_t(payloadSize, static_cast<unsigned char>(i)));
+		stream.insert(stream.end(), frame.begin(), frame.end());
+	}
+	return stream;
+}
+
+/** @brief Feeds the stream in socket-sized reads that split frames at arbitrary points, then drains every frame. */
+void BM_ReadFrames(benchmark::State &state)
+{
+	const buffer_t stream = MakeStream(static_cast<size_t>(state.range(0)), 64);
+	constexpr size_t ReadSize = 1400;
+	frame_queue queue;
+	size_t frames = 0;
+	for (auto _ : state) {
+		for (size_t pos = 0; pos < stream.size(); pos += ReadSize) {
+			const size_t len = std::min(ReadSize, stream.size() - pos);
+			queue.Write({ stream.data() + pos, len });
+			while (*queue.PacketReady()) {
+				tl::expected<buffer_t, PacketError> packet = queue.ReadPacket();
+				benchmark::DoNotOptimize(packet);
+				frames++;
+			}
+		}
+	}
+	state.SetItemsProcessed(static_cast<int64_t>(frames));
+	state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * stream.size()));
+}
+
+BENCHMARK(BM_ReadFrames)->Arg(16)->Arg(256)->Arg(4096);
+
+} // namespace
+} // namespace net
+} // namespace devilution
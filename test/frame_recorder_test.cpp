@@ -0,0 +1,143 @@
+#include "engine/frame_recorder.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace devilution {
+namespace {
+
+struct Frame {
+	std::vector<uint8_t> pixels;
+	uint8_t paletteRed;
+	uint64_t timestamp;
+};
+
+RecordedFrame MakeFrame(const std::vector<uint8_t> &pixels, uint16_t width, uint16_t height, uint64_t timestamp)
+{
+	RecordedFrame frame {
+		.width = width,
+		.height = height,
+		.pitch = width,
+		.pixels = pixels.data(),
+		.frameMicroseconds = 16667,
+		.timestampMicroseconds = timestamp,
+	};
+	frame.palette[0] = static_cast<uint8_t>(timestamp);
+	return frame;
+}
+
+std::vector<Frame> Decode(const FrameRecorder &recorder)
+{
+	std::vector<Frame> frames;
+	recorder.ForEach([&](const RecordedFrame &frame) {
+		frames.push_back(Frame {
+		    .pixels = { frame.pixels, frame.pixels + static_cast<size_t>(frame.width) * frame.height },
+		    .paletteRed = frame.palette[0],
+		    .timestamp = frame.timestampMicroseconds,
+		});
+	});
+	return frames;
+}
+
+TEST(FrameRecorderTest, DecodesWhatWasAdded)
+{
+	FrameRecorder recorder(1 << 20);
+	std::vector<std::vector<uint8_t>> added;
+	std::vector<uint8_t> pixels(32 * 8, 0);
+	for (uint64_t i = 0; i < 150; i++) {
+		// Change a few scattered pixels and a whole row now and then.
+		pixels[(i * 37) % pixels.size()] = static_cast<uint8_t>(i);
+		pixels[(i * 11 + 5) % pixels.size()] = static_cast<uint8_t>(i * 3);
+		if (i % 20 == 0)
+			std::fill_n(pixels.begin() + static_cast<std::ptrdiff_t>((i / 20) * 32), 32, static_cast<uint8_t>(i + 1));
+		added.push_back(pixels);
+		recorder.Add(MakeFrame(pixels, 32, 8, i));
+	}
+
+	const std::vector<Frame> frames = Decode(recorder);
+	ASSERT_EQ(frames.size(), added.size());
+	EXPECT_EQ(recorder.frameCount(), added.size());
+	for (size_t i = 0; i < frames.size(); i++) {
+		EXPECT_EQ(frames[i].pixels, added[i]) << "frame " << i;
+		EXPECT_EQ(frames[i].paletteRed, static_cast<uint8_t>(i));
+		EXPECT_EQ(frames[i].timestamp, i);
+	}
+}
+
+TEST(FrameRecorderTest, SkipsRowPadding)
+{
+	FrameRecorder recorder(1 << 20);
+	const std::vector<uint8_t> padded { 1, 2, 9, 3, 4, 9 };
+	RecordedFrame frame = MakeFrame(padded, 2, 2, 0);
+	frame.pitch = 3;
+	recorder.Add(frame);
+
+	const std::vector<Frame> frames = Decode(recorder);
+	ASSERT_EQ(frames.size(), 1);
+	EXPECT_EQ(frames[0].pixels, (std::vector<uint8_t> { 1, 2, 3, 4 }));
+}
+
+TEST(FrameRecorderTest, StartsOverWhenTheSizeChanges)
+{
+	FrameRecorder recorder(1 << 20);
+	const std::vector<uint8_t> small(4, 7);
+	const std::vector<uint8_t> large(9, 7);
+	recorder.Add(MakeFrame(small, 2, 2, 0));
+	recorder.Add(MakeFrame(large, 3, 3, 1));
+	recorder.Add(MakeFrame(large, 3, 3, 2));
+
+	const std::vector<Frame> frames = Decode(recorder);
+	ASSERT_EQ(frames.size(), 3);
+	EXPECT_EQ(frames[0].pixels, small);
+	EXPECT_EQ(frames[1].pixels, large);
+	EXPECT_EQ(frames[2].pixels, large);
+}
+
+TEST(FrameRecorderTest, StoresUnchangedFramesInAFewBytes)
+{
+	FrameRecorder recorder(1 << 20);
+	const std::vector<uint8_t> pixels(640 * 480, 42);
+	recorder.Add(MakeFrame(pixels, 640, 480, 0));
+	const size_t firstFrameBytes = recorder.bytes();
+	recorder.Add(MakeFrame(pixels, 640, 480, 1));
+	EXPECT_LT(recorder.bytes() - firstFrameBytes, firstFrameBytes);
+	EXPECT_LT(firstFrameBytes, pixels.size() + 1024);
+}
+
+TEST(FrameRecorderTest, DropsOldSegments)
+{
+	FrameRecorder recorder(1 << 20);
+	const std::vector<uint8_t> pixels(16, 1);
+	for (uint64_t i = 0; i < 3 * FrameRecorder::SegmentFrames; i++)
+		recorder.Add(MakeFrame(pixels, 4, 4, i));
+
+	recorder.DropBefore(FrameRecorder::SegmentFrames + 1);
+	const std::vector<Frame> frames = Decode(recorder);
+	ASSERT_EQ(frames.size(), 2 * FrameRecorder::SegmentFrames);
+	EXPECT_EQ(frames.front().timestamp, FrameRecorder::SegmentFrames);
+	EXPECT_EQ(frames.front().pixels, pixels);
+}
+
+TEST(FrameRecorderTest, StaysWithinTheBudget)
+{
+	FrameRecorder recorder(64 * 1024);
+	std::vector<uint8_t> pixels(64 * 64);
+	for (uint64_t i = 0; i < 10 * FrameRecorder::SegmentFrames; i++) {
+		for (size_t j = 0; j < pixels.size(); j++)
+			pixels[j] = static_cast<uint8_t>(i + j * 7);
+		recorder.Add(MakeFrame(pixels, 64, 64, i));
+	}
+
+	const std::vector<Frame> frames = Decode(recorder);
+	ASSERT_FALSE(frames.empty());
+	EXPECT_LT(frames.size(), 10 * FrameRecorder::SegmentFrames);
+	EXPECT_EQ(frames.back().pixels, pixels);
+	EXPECT_EQ(frames.back().timestamp, 10 * FrameRecorder::SegmentFrames - 1);
+}
+
+} // namespace
+} // namespace devilution
@@ -0,0 +1,65 @@
+#include "engine/level_arena.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+
+#include <gtest/gtest.h>
+
+namespace devilution {
+namespace {
+
+TEST(LevelArenaTest, AllocationsDoNotOverlap)
+{
+	LevelArena arena(64);
+	const std::span<uint8_t> a = arena.AllocateArray<uint8_t>(10);
+	const std::span<uint32_t> b = arena.AllocateArray<uint32_t>(5);
+	EXPECT_EQ(reinterpret_cast<uintptr_t>(b.data()) % alignof(uint32_t), 0U);
+	EXPECT_TRUE(reinterpret_cast<const uint8_t *>(b.data()) >= a.data() + a.size()
+	    || reinterpret_cast<const uint8_t *>(b.data() + b.size()) <= a.data());
+	EXPECT_EQ(arena.bytesUsed(), 10U + 5 * sizeof(uint32_t));
+	EXPECT_EQ(arena.bytesReserved(), 64U);
+}
+
+TEST(LevelArenaTest, StartsANewChunkWhenFull)
+{
+	LevelArena arena(64);
+	(void)arena.Allocate(40, 1);
+	(void)arena.Allocate(40, 1);
+	EXPECT_EQ(arena.bytesReserved(), 128U);
+}
+
+TEST(LevelArenaTest, OversizedAllocationKeepsTheCurrentChunk)
+{
+	LevelArena arena(64);
+	auto *first = static_cast<uint8_t *>(arena.Allocate(8, 1));
+	(void)arena.Allocate(1000, 1);
+	auto *second = static_cast<uint8_t *>(arena.Allocate(8, 1));
+	EXPECT_EQ(second, first + 8);
+	EXPECT_EQ(arena.bytesReserved(), 64U + 1000);
+}
+
+TEST(LevelArenaTest, CopyKeepsTheData)
+{
+	LevelArena arena(64);
+	constexpr std::array<uint8_t, 4> Data { 1, 2, 3, 4 };
+	const std::span<uint8_t> copy = arena.Copy(Data);
+	ASSERT_EQ(copy.size(), Data.size());
+	EXPECT_TRUE(std::equal(copy.begin(), copy.end(), Data.begin()));
+}
+
+TEST(LevelArenaTest, ReleaseKeepsOneRegularChunk)
+{
+	LevelArena arena(64);
+	(void)arena.Allocate(1000, 1);
+	(void)arena.Allocate(40, 1);
+	(void)arena.Allocate(40, 1);
+	arena.Release();
+	EXPECT_EQ(arena.bytesUsed(), 0U);
+	EXPECT_EQ(arena.bytesReserved(), 64U);
+	(void)arena.Allocate(8, 1);
+	EXPECT_EQ(arena.bytesReserved(), 64U);
+}
+
+} // namespace
+} // namespace devilution
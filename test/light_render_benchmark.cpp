@@ -6,7 +6,9 @@
 
 #include "engine/lighting_defs.hpp"
 #include "engine/render/light_render.hpp"
+#include "engine/render/render_workers.hpp"
 #include "engine/surface.hpp"
+#include "levels/dun_tile.hpp"
 #include "levels/gendung_defs.hpp"
 #include "utils/log.hpp"
 #include "utils/paths.h"
@@ -29,8 +31,11 @@ void BM_BuildLightmap(benchmark::State &state)
 		std::fclose(lightFile);
 	}
 
+	const int width = static_cast<int>(state.range(0));
+	const int height = static_cast<int>(state.range(1));
+	const int bands = static_cast<int>(state.range(2));
 	const SDLSurfaceUniquePtr sdl_surface = SDLWrap::CreateRGBSurfaceWithFormat(
-	    /*flags=*/0, /*width=*/640, /*height=*/480, /*depth=*/8, SDL_PIXELFORMAT_INDEX8);
+	    /*flags=*/0, width, height, /*depth=*/8, SDL_PIXELFORMAT_INDEX8);
 	if (sdl_surface == nullptr) {
 		std::fprintf(stderr, "Failed to create SDL Surface: %s\n", SDL_GetError());
 		exit(1);
@@ -39,10 +44,11 @@ void BM_BuildLightmap(benchmark::State &state)
 
 	const Point tilePosition { 48, 44 };
 	const Point targetBufferPosition { 0, -17 };
-	const int viewportWidth = 640;
-	const int viewportHeight = 352;
-	const int rows = 25;
-	const int columns = 10;
+	// The main panel covers the bottom of the screen at 640x480.
+	const int viewportWidth = width;
+	const int viewportHeight = width <= 640 ? height - 128 : height;
+	const int rows = viewportHeight / (TILE_HEIGHT / 2) + 3;
+	const int columns = viewportWidth / TILE_WIDTH;
 	const uint8_t *outBuffer = out.at(0, 0);
 	const uint16_t outPitch = out.pitch();
 
@@ -51,16 +57,24 @@ void BM_BuildLightmap(benchmark::State &state)
 		    tilePosition, targetBufferPosition,
 		    viewportWidth, viewportHeight, rows, columns,
 		    outBuffer, outPitch, lightTables, lightTables[0].data(), lightTables.back().data(),
-		    dLight, /*microTileLen=*/10);
+		    dLight, /*microTileLen=*/10, bands);
 
 		uint8_t lightLevel = *lightmap.getLightingAt(outBuffer + outPitch * 120 + 120);
 		benchmark::DoNotOptimize(lightLevel);
 	}
 	state.SetBytesProcessed(state.iterations() * viewportWidth * viewportHeight);
 	state.SetItemsProcessed(state.iterations() * rows * columns);
+	ShutdownRenderWorkers();
 }
 
-BENCHMARK(BM_BuildLightmap);
+BENCHMARK(BM_BuildLightmap)
+    ->ArgNames({ "width", "height", "bands" })
+    ->Args({ 640, 480, 1 })
+    ->Args({ 640, 480, 4 })
+    ->Args({ 1920, 1080, 1 })
+    ->Args({ 1920, 1080, 4 })
+    ->Args({ 3840, 2160, 1 })
+    ->Args({ 3840, 2160, 4 });
 
 } // namespace
 } // namespace devilution
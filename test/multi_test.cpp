@@ -0,0 +1,33 @@
+#include <gtest/gtest.h>
+
+#include "msg.h"
+#include "multi.h"
+#include "player.h"
+
+namespace devilution {
+namespace {
+
+TEST(MultiTest, SinglePlayerCommandsAreParsedAfterTheSender)
+{
+	gbIsMultiplayer = false;
+	Players.resize(1);
+	MyPlayerId = 0;
+	MyPlayer = &Players[0];
+	MyPlayer->wReflections = 0;
+
+	NetSendCmdParam1(true, CMD_SETREFLECT, 5);
+	// Whatever the sender changes after sending the command still comes first.
+	EXPECT_EQ(MyPlayer->wReflections, 0);
+	MyPlayer->wReflections = 1;
+
+	ProcessLocalCommands();
+	EXPECT_EQ(MyPlayer->wReflections, 5);
+
+	// Parsed only once.
+	MyPlayer->wReflections = 2;
+	ProcessLocalCommands();
+	EXPECT_EQ(MyPlayer->wReflections, 2);
+}
+
+} // namespace
+} // namespace devilution
@@ -0,0 +1,215 @@
+#include "engine/navigation_field.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+namespace devilution {
+namespace {
+
+using ::testing::ElementsAre;
+
+constexpr std::array<Displacement, 4> AxisDirections = {
+	Displacement { 0, -1 },
+	Displacement { 0, 1 },
+	Displacement { 1, 0 },
+	Displacement { -1, 0 },
+};
+
+constexpr std::array<Displacement, 8> AllDirections = {
+	Displacement { 0, -1 },
+	Displacement { 0, 1 },
+	Displacement { 1, 0 },
+	Displacement { -1, 0 },
+	Displacement { -1, -1 },
+	Displacement { 1, -1 },
+	Displacement { 1, 1 },
+	Displacement { -1, 1 },
+};
+
+bool AlwaysOk(Point)
+{
+	return true;
+}
+
+bool AlwaysCanStep(Point, Point)
+{
+	return true;
+}
+
+std::vector<int8_t> PathTo(const NavigationField &field, Point destination, bool allowBlockedDestination = false)
+{
+	std::array<int8_t, 256> steps;
+	const std::optional<size_t> length = field.PathTo(destination, steps.data(), steps.size(), allowBlockedDestination);
+	if (!length)
+		return { -1 };
+	return { steps.begin(), steps.begin() + *length };
+}
+
+TEST(NavigationFieldTest, DistancesInOpenSpace)
+{
+	NavigationField field;
+	field.Build({ 20, 20 }, AxisDirections, AlwaysOk, AlwaysCanStep);
+
+	EXPECT_EQ(field.Distance({ 20, 20 }), 0);
+	EXPECT_EQ(field.Distance({ 23, 20 }), 3);
+	EXPECT_EQ(field.Distance({ 22, 18 }), 4);
+	EXPECT_EQ(field.ReachedPosition(0), Point(20, 20));
+	EXPECT_EQ(field.ReachedCount(), static_cast<size_t>(MAXDUNX * MAXDUNY));
+
+	field.Build({ 20, 20 }, AllDirections, AlwaysOk, AlwaysCanStep);
+	EXPECT_EQ(field.Distance({ 22, 18 }), 2);
+}
+
+TEST(NavigationFieldTest, MaxDistanceBoundsTheFlood)
+{
+	NavigationField field;
+	field.Build({ 20, 20 }, AllDirections, AlwaysOk, AlwaysCanStep, /*maxDistance=*/3);
+
+	EXPECT_EQ(field.Distance({ 23, 17 }), 3);
+	EXPECT_FALSE(field.IsReached({ 24, 20 }));
+	EXPECT_EQ(field.ReachedCount(), 7U * 7U);
+	EXPECT_THAT(PathTo(field, { 24, 20 }), ElementsAre(-1));
+}
+
+TEST(NavigationFieldTest, PathToSelfIsEmpty)
+{
+	NavigationField field;
+	field.Build({ 20, 20 }, AxisDirections, AlwaysOk, AlwaysCanStep);
+	EXPECT_THAT(PathTo(field, { 20, 20 }), ElementsAre());
+}
+
+TEST(NavigationFieldTest, PathPrefersStraightRuns)
+{
+	NavigationField field;
+	field.Build({ 20, 20 }, AxisDirections, AlwaysOk, AlwaysCanStep);
+
+	// Two steps east and two steps south, with a single turn.
+	EXPECT_THAT(PathTo(field, { 22, 22 }), ElementsAre(2, 2, 1, 1));
+}
+
+TEST(NavigationFieldTest, PathAroundWall)
+{
+	// A wall along x == 22 for y in [15, 25], the path has to go around it.
+	const auto posOk = [](Point position) { return position.x != 22 || position.y < 15 || position.y > 25; };
+
+	NavigationField field;
+	field.Build({ 20, 20 }, AxisDirections, posOk, AlwaysCanStep);
+
+	EXPECT_FALSE(field.IsReached({ 22, 20 }));
+	EXPECT_EQ(field.Distance({ 24, 20 }), 16);
+
+	const std::vector<int8_t> path = PathTo(field, { 24, 20 });
+	ASSERT_EQ(path.size(), 16U);
+	Point position { 20, 20 };
+	for (const int8_t step : path) {
+		position += AxisDirections[step];
+		EXPECT_TRUE(posOk(position)) << "Path goes through the wall at " << position;
+	}
+	EXPECT_EQ(position, Point(24, 20));
+}
+
+TEST(NavigationFieldTest, PassableGridMatchesPredicate)
+{
+	const auto posOk = [](Point position) { return position.x != 22 || position.y < 15 || position.y > 25; };
+
+	Bitset2d<MAXDUNX, MAXDUNY> wall;
+	for (int y = 15; y <= 25; y++)
+		wall.set(22, y);
+	const Bitset2d<MAXDUNX, MAXDUNY> passable = ~wall;
+
+	NavigationField byPredicate;
+	byPredicate.Build({ 20, 20 }, AllDirections, posOk, AlwaysCanStep);
+	NavigationField byGrid;
+	byGrid.Build({ 20, 20 }, AllDirections, passable, AlwaysCanStep);
+
+	EXPECT_EQ(byGrid.ReachedCount(), byPredicate.ReachedCount());
+	EXPECT_EQ(byGrid.Distance({ 24, 20 }), byPredicate.Distance({ 24, 20 }));
+	EXPECT_EQ(PathTo(byGrid, { 24, 20 }), PathTo(byPredicate, { 24, 20 }));
+	EXPECT_EQ(PathTo(byGrid, { 22, 20 }, /*allowBlockedDestination=*/true), PathTo(byPredicate, { 22, 20 }, /*allowBlockedDestination=*/true));
+}
+
+TEST(NavigationFieldTest, UnreachableDestination)
+{
+	// An enclosed 3x3 room around the root.
+	const auto posOk = [](Point position) { return position.x >= 19 && position.x <= 21 && position.y >= 19 && position.y <= 21; };
+
+	NavigationField field;
+	field.Build({ 20, 20 }, AllDirections, posOk, AlwaysCanStep);
+
+	EXPECT_EQ(field.ReachedCount(), 9U);
+	EXPECT_THAT(PathTo(field, { 30, 30 }), ElementsAre(-1));
+}
+
+TEST(NavigationFieldTest, BlockedDestination)
+{
+	const auto posOk = [](Point position) { return position != Point(23, 20); };
+
+	NavigationField field;
+	field.Build({ 20, 20 }, AxisDirections, posOk, AlwaysCanStep);
+
+	EXPECT_THAT(PathTo(field, { 23, 20 }), ElementsAre(-1));
+	EXPECT_THAT(PathTo(field, { 23, 20 }, /*allowBlockedDestination=*/true), ElementsAre(2, 2, 2));
+}
+
+TEST(NavigationFieldTest, PenalizedTilesAreAvoided)
+{
+	// A wall east of the root with a door in it, and a way around it six steps longer.
+	Bitset2d<MAXDUNX, MAXDUNY> wall;
+	for (int y = 18; y <= 30; ++y)
+		wall.set(21, y);
+	Bitset2d<MAXDUNX, MAXDUNY> door;
+	door.set(21, 20);
+	wall.reset(21, 20);
+	const Bitset2d<MAXDUNX, MAXDUNY> passable = ~wall;
+
+	NavigationField field;
+	field.Build({ 20, 20 }, AxisDirections, passable, door, /*penalty=*/10, AlwaysCanStep);
+	// Distances still count steps.
+	EXPECT_EQ(field.Distance({ 22, 20 }), 8);
+	EXPECT_THAT(PathTo(field, { 22, 20 }), ElementsAre(0, 0, 0, 2, 2, 1, 1, 1));
+	EXPECT_EQ(field.Distance({ 21, 20 }), 1);
+
+	// Through the door if going around costs more than the penalty.
+	field.Build({ 20, 20 }, AxisDirections, passable, door, /*penalty=*/3, AlwaysCanStep);
+	EXPECT_THAT(PathTo(field, { 22, 20 }), ElementsAre(2, 2));
+}
+
+TEST(NavigationFieldTest, CanStepIsRespected)
+{
+	// Forbid stepping directly east from the root.
+	const auto canStep = [](Point from, Point to) { return !(from == Point(20, 20) && to == Point(21, 20)); };
+
+	NavigationField field;
+	field.Build({ 20, 20 }, AxisDirections, AlwaysOk, canStep);
+
+	EXPECT_EQ(field.Distance({ 21, 20 }), 3);
+}
+
+TEST(NavigationFieldTest, PathMustFitIntoBuffer)
+{
+	NavigationField field;
+	field.Build({ 20, 20 }, AxisDirections, AlwaysOk, AlwaysCanStep);
+
+	std::array<int8_t, 4> steps;
+	EXPECT_FALSE(field.PathTo({ 25, 20 }, steps.data(), steps.size()));
+	EXPECT_EQ(field.PathTo({ 24, 20 }, steps.data(), steps.size()), 4U);
+}
+
+TEST(NavigationFieldTest, Invalidate)
+{
+	NavigationField field;
+	EXPECT_FALSE(field.IsValid());
+	field.Build({ 20, 20 }, AxisDirections, AlwaysOk, AlwaysCanStep);
+	EXPECT_TRUE(field.IsValid());
+	field.Invalidate();
+	EXPECT_FALSE(field.IsValid());
+	EXPECT_FALSE(field.IsReached({ 20, 20 }));
+}
+
+} // namespace
+} // namespace devilution
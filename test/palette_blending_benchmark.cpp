@@ -41,6 +41,21 @@ void BM_GenerateBlendedLookupTable(benchmark::State &state)
 	}
 }
 
+void BM_CycleBlendedLookupTable(benchmark::State &state)
+{
+	std::array<SDL_Color, 256> palette;
+	GeneratePalette(palette.data());
+	GenerateBlendedLookupTable(palette.data(), /*skipFrom=*/1, /*skipTo=*/31);
+
+	// The crypt's lava and glow, cycled together every other frame.
+	const std::array<PaletteCycle, 2> cycles { { { 1, 15, true }, { 16, 31, true } } };
+	for (auto _ : state) {
+		CycleBlendedLookupTable(cycles);
+		int result = paletteTransparencyLookup[17][98];
+		benchmark::DoNotOptimize(result);
+	}
+}
+
 void BM_BuildTree(benchmark::State &state)
 {
 	std::array<SDL_Color, 256> palette;
@@ -71,9 +86,47 @@ void BM_FindNearestNeighbor(benchmark::State &state)
 	state.SetItemsProcessed(state.iterations() * 256 * 256 * 256);
 }
 
+// Quantizing a 256x256 truecolor image, the way mod art is converted at load time.
+void BM_QuantizeWithTree(benchmark::State &state)
+{
+	std::array<SDL_Color, 256> palette;
+	GeneratePalette(palette.data());
+	const PaletteKdTree tree(palette.data(), -1, -1);
+
+	for (auto _ : state) {
+		for (int y = 0; y < 256; ++y) {
+			for (int x = 0; x < 256; ++x) {
+				uint8_t result = tree.findNearestNeighbor({ static_cast<uint8_t>(x), static_cast<uint8_t>(y), static_cast<uint8_t>(x ^ y) });
+				benchmark::DoNotOptimize(result);
+			}
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * 256 * 256);
+}
+
+void BM_QuantizeWithLookup(benchmark::State &state)
+{
+	std::array<SDL_Color, 256> palette;
+	GeneratePalette(palette.data());
+	GenerateBlendedLookupTable(palette.data());
+
+	for (auto _ : state) {
+		for (int y = 0; y < 256; ++y) {
+			for (int x = 0; x < 256; ++x) {
+				uint8_t result = FindNearestPaletteColor({ static_cast<uint8_t>(x), static_cast<uint8_t>(y), static_cast<uint8_t>(x ^ y) });
+				benchmark::DoNotOptimize(result);
+			}
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * 256 * 256);
+}
+
 BENCHMARK(BM_GenerateBlendedLookupTable);
+BENCHMARK(BM_CycleBlendedLookupTable);
 BENCHMARK(BM_BuildTree);
 BENCHMARK(BM_FindNearestNeighbor);
+BENCHMARK(BM_QuantizeWithTree);
+BENCHMARK(BM_QuantizeWithLookup);
 
 } // namespace
 } // namespace devilution
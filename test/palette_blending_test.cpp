@@ -2,6 +2,7 @@
 
 #include <algorithm>
 #include <array>
+#include <cstring>
 #include <iostream>
 
 #ifdef USE_SDL3
@@ -85,5 +86,68 @@ TEST(GenerateBlendedLookupTableTest, BasicTest)
 #endif
 }
 
+TEST(FindNearestPaletteColorTest, UsesTheLatestPalette)
+{
+	std::array<SDL_Color, 256> palette;
+	GeneratePalette(palette.data());
+	GenerateBlendedLookupTable(palette.data());
+
+	// Within a rounding step of palette[150].
+	EXPECT_THAT(palette[150], ColorIs(44, 44, 44));
+	EXPECT_EQ(FindNearestPaletteColor({ 44, 44, 44 }), 150);
+	EXPECT_EQ(FindNearestPaletteColor({ 45, 46, 42 }), 150);
+
+	palette[151] = palette[150];
+	palette[150] = SDL_Color { 255, 255, 255, 255 };
+	GenerateBlendedLookupTable(palette.data());
+	EXPECT_EQ(FindNearestPaletteColor({ 44, 44, 44 }), 151);
+}
+
+TEST(CycleBlendedLookupTableTest, MovesLookupsWithTheColors)
+{
+	std::array<SDL_Color, 256> palette;
+	GeneratePalette(palette.data());
+	GenerateBlendedLookupTable(palette.data(), /*skipFrom=*/1, /*skipTo=*/31);
+
+	static uint8_t before[256][256];
+	std::memcpy(before, paletteTransparencyLookup, sizeof(before));
+
+	// Crypt lava and glow: both ranges move to the next index.
+	const std::array<PaletteCycle, 2> cycles { { { 1, 15, true }, { 16, 31, true } } };
+	CycleBlendedLookupTable(cycles);
+
+	const auto previous = [](unsigned i) -> unsigned {
+		if (i == 1) return 15;
+		if (i == 16) return 31;
+		if (i >= 2 && i <= 31) return i - 1;
+		return i;
+	};
+	for (unsigned i = 0; i < 256; i++) {
+		for (unsigned j = 0; j < 256; j++) {
+			ASSERT_EQ(paletteTransparencyLookup[i][j], before[previous(i)][previous(j)]) << i << ", " << j;
+		}
+	}
+
+#if DEVILUTIONX_PALETTE_TRANSPARENCY_BLACK_16_LUT
+	EXPECT_EQ(paletteTransparencyLookupBlack16[16 | (100 << 8)], paletteTransparencyLookup[0][16] | (paletteTransparencyLookup[0][100] << 8));
+#endif
+}
+
+TEST(CycleBlendedLookupTableTest, ForwardCycleWrapsToTheEnd)
+{
+	std::array<SDL_Color, 256> palette;
+	GeneratePalette(palette.data());
+	GenerateBlendedLookupTable(palette.data(), /*skipFrom=*/1, /*skipTo=*/31);
+	const uint8_t firstWithBlack = paletteTransparencyLookup[1][0];
+	const uint8_t secondWithBlack = paletteTransparencyLookup[2][0];
+
+	const std::array<PaletteCycle, 1> cycles { { { 1, 31, false } } };
+	CycleBlendedLookupTable(cycles);
+
+	EXPECT_EQ(paletteTransparencyLookup[31][0], firstWithBlack);
+	EXPECT_EQ(paletteTransparencyLookup[0][31], firstWithBlack);
+	EXPECT_EQ(paletteTransparencyLookup[1][0], secondWithBlack);
+}
+
 } // namespace
 } // namespace devilution
@@ -47,6 +47,20 @@ void BenchmarkMap(const Map &map, benchmark::State &state)
 	}
 }
 
+/** @brief Same as BenchmarkMap but through the function_ref overload, to compare it with the inlined predicates. */
+void BenchmarkMapFunctionRef(const Map &map, benchmark::State &state)
+{
+	const auto [start, dest] = FindStartDest(map);
+	const auto canStep = [](Point, Point) { return true; };
+	const auto posOk = [&map](Point p) { return map[p] != '#'; };
+	constexpr size_t MaxPathLength = 25;
+	for (auto _ : state) {
+		int8_t path[MaxPathLength];
+		int result = FindPath(tl::function_ref<bool(Point, Point)>(canStep), tl::function_ref<bool(Point)>(posOk), start, dest, path, MaxPathLength);
+		benchmark::DoNotOptimize(result);
+	}
+}
+
 void BM_SinglePath(benchmark::State &state)
 {
 	BenchmarkMap(
@@ -116,48 +130,54 @@ void BM_NoPath(benchmark::State &state)
 	    state);
 }
 
+const Map NoPathBigMap {
+	Size { 30, 30 },
+	"##############################"
+	"#............................#"
+	"#............................#"
+	"#............................#"
+	"#............................#"
+	"#............................#"
+	"#............................#"
+	"#............................#"
+	"#............................#"
+	"#............................#"
+	"#............................#"
+	"#............................#"
+	"#............................#"
+	"#............................#"
+	"#............................#"
+	"#............................#"
+	"#............................#"
+	"#............................#"
+	"#............................#"
+	"#............................#"
+	"#............................#"
+	"#............................#"
+	"#............................#"
+	"#............................#"
+	"#............................#"
+	"#............................#"
+	"#.....S......................#"
+	"##############################"
+	"#.....E......................#"
+	"##############################" };
+
 void BM_NoPathBig(benchmark::State &state)
 {
-	BenchmarkMap(
-	    Map {
-	        Size { 30, 30 },
-	        "##############################"
-	        "#............................#"
-	        "#............................#"
-	        "#............................#"
-	        "#............................#"
-	        "#............................#"
-	        "#............................#"
-	        "#............................#"
-	        "#............................#"
-	        "#............................#"
-	        "#............................#"
-	        "#............................#"
-	        "#............................#"
-	        "#............................#"
-	        "#............................#"
-	        "#............................#"
-	        "#............................#"
-	        "#............................#"
-	        "#............................#"
-	        "#............................#"
-	        "#............................#"
-	        "#............................#"
-	        "#............................#"
-	        "#............................#"
-	        "#............................#"
-	        "#............................#"
-	        "#.....S......................#"
-	        "##############################"
-	        "#.....E......................#"
-	        "##############################" },
-	    state);
+	BenchmarkMap(NoPathBigMap, state);
+}
+
+void BM_NoPathBigFunctionRef(benchmark::State &state)
+{
+	BenchmarkMapFunctionRef(NoPathBigMap, state);
 }
 
 BENCHMARK(BM_SinglePath);
 BENCHMARK(BM_Bridges);
 BENCHMARK(BM_NoPath);
 BENCHMARK(BM_NoPathBig);
+BENCHMARK(BM_NoPathBigFunctionRef);
 
 } // namespace
 } // namespace devilution
@@ -162,6 +162,20 @@ TEST(PathTest, LongPaths)
 	CheckPath(startingPosition, startingPosition + Displacement { 25, 25 }, {});
 }
 
+TEST(PathTest, CountsQueries)
+{
+	ResetPathQueryStats();
+	CheckPath({ 8, 8 }, { 10, 12 }, { "↘", "↘", "↓", "↓" });
+	CheckPath({ 56, 56 }, { 0, 0 }, {});
+	const PathQueryStats stats = GetPathQueryStats();
+	EXPECT_EQ(stats.queries, 2);
+	EXPECT_EQ(stats.failed, 1);
+	EXPECT_GE(stats.nodesExpanded, 4);
+
+	ResetPathQueryStats();
+	EXPECT_EQ(GetPathQueryStats().queries, 0);
+}
+
 TEST(PathTest, FindClosest)
 {
 	{
@@ -0,0 +1,62 @@
+#include "utils/perfect_hash.hpp"
+
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace devilution {
+namespace {
+
+std::vector<uint64_t> MakeHashes(size_t count)
+{
+	std::vector<uint64_t> hashes;
+	uint64_t state = 0x2545f4914f6cdd1d;
+	for (size_t i = 0; i < count; i++) {
+		// xorshift64, distinct for every step.
+		state ^= state << 13;
+		state ^= state >> 7;
+		state ^= state << 17;
+		hashes.push_back(state);
+	}
+	return hashes;
+}
+
+TEST(PerfectHashTest, EmptySet)
+{
+	PerfectHash hash;
+	EXPECT_TRUE(hash.Build({}));
+	EXPECT_TRUE(hash.empty());
+	EXPECT_EQ(hash.size(), 0);
+}
+
+TEST(PerfectHashTest, EveryHashGetsItsOwnSlot)
+{
+	for (const size_t count : { 1, 2, 7, 100, 5000 }) {
+		const std::vector<uint64_t> hashes = MakeHashes(count);
+		PerfectHash hash;
+		ASSERT_TRUE(hash.Build(hashes));
+		ASSERT_GE(hash.size(), count);
+		EXPECT_LE(hash.size(), count + count / 8 + 1);
+
+		std::vector<bool> taken(hash.size());
+		for (const uint64_t value : hashes) {
+			const size_t slot = hash.Slot(value);
+			ASSERT_LT(slot, hash.size());
+			EXPECT_FALSE(taken[slot]) << "Two hashes share slot " << slot << " of " << count;
+			taken[slot] = true;
+		}
+	}
+}
+
+TEST(PerfectHashTest, RejectsEqualHashes)
+{
+	std::vector<uint64_t> hashes = MakeHashes(10);
+	hashes.push_back(hashes[3]);
+	PerfectHash hash;
+	EXPECT_FALSE(hash.Build(hashes));
+	EXPECT_TRUE(hash.empty());
+}
+
+} // namespace
+} // namespace devilution
@@ -0,0 +1,51 @@
+#include "utils/pixel_doubling.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace devilution {
+namespace {
+
+std::vector<uint8_t> Expected(const std::vector<uint8_t> &src)
+{
+	std::vector<uint8_t> result;
+	for (const uint8_t pixel : src) {
+		result.push_back(pixel);
+		result.push_back(pixel);
+	}
+	return result;
+}
+
+TEST(PixelDoublingTest, DoublesEveryPixel)
+{
+	for (int count : { 0, 1, 15, 16, 17, 33, 320 }) {
+		std::vector<uint8_t> src(count);
+		for (int i = 0; i < count; i++)
+			src[i] = static_cast<uint8_t>(i * 7 + 3);
+		std::vector<uint8_t> dst(2 * count);
+		DoublePixels(src.data(), dst.data(), count);
+		EXPECT_EQ(dst, Expected(src)) << "count " << count;
+	}
+}
+
+TEST(PixelDoublingTest, DoublesInPlace)
+{
+	for (int offset : { 0, 1, 5, 16 }) {
+		constexpr int Count = 100;
+		std::vector<uint8_t> row(offset + 2 * Count);
+		std::vector<uint8_t> src(Count);
+		for (int i = 0; i < Count; i++) {
+			src[i] = static_cast<uint8_t>(i * 13 + 1);
+			row[i] = src[i];
+		}
+		DoublePixels(row.data(), row.data() + offset, Count);
+		const std::vector<uint8_t> doubled(row.begin() + offset, row.end());
+		EXPECT_EQ(doubled, Expected(src)) << "offset " << offset;
+	}
+}
+
+} // namespace
+} // namespace devilution
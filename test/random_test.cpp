@@ -1,3 +1,5 @@
+#include <vector>
+
 #include <gtest/gtest.h>
 
 #include "engine/random.hpp"
@@ -309,4 +311,71 @@ TEST(RandomTest, NegativeReturnValues)
 		EXPECT_EQ(GenerateRnd(i), 0) << "Expect powers of 2 such as " << i << " to cleanly divide the int_min RNG value ";
 	}
 }
+
+TEST(RandomTest, JumpMatchesSequentialRounds)
+{
+	for (const uint32_t seed : { 0U, 1U, 1457187811U, 0xFFFFFFFFU }) {
+		SetRndSeed(seed);
+		for (uint64_t count = 0; count < 200; count++) {
+			ASSERT_EQ(JumpLCGState(seed, count), GetLCGEngineState()) << "Wrong state after " << count << " rounds from " << seed;
+			GenerateRandomNumber();
+		}
+	}
+}
+
+TEST(RandomTest, DiscardMatchesSequentialRounds)
+{
+	for (const unsigned count : { 0U, 1U, 2U, 10U, 9997U }) {
+		SetRndSeed(1457187811);
+		for (unsigned i = 0; i < count; i++)
+			GenerateRandomNumber();
+		const uint32_t expected = GenerateRandomNumber();
+
+		SetRndSeed(1457187811);
+		DiscardRandomValues(count);
+		ASSERT_EQ(GenerateRandomNumber(), expected) << "Wrong value after discarding " << count;
+
+		DiabloGenerator sequential(1457187811);
+		for (unsigned i = 0; i < count; i++)
+			sequential.advanceRndSeed();
+		DiabloGenerator jumped(1457187811);
+		jumped.discardRandomValues(count);
+		ASSERT_EQ(jumped.advanceRndSeed(), sequential.advanceRndSeed()) << "Wrong generator value after discarding " << count;
+	}
+}
+
+TEST(RandomTest, BatchMatchesSequentialCalls)
+{
+	for (const size_t size : { 0U, 1U, 3U, 4U, 5U, 16U, 37U }) {
+		SetRndSeed(1457187811);
+		std::vector<uint32_t> expected(size);
+		for (uint32_t &value : expected)
+			value = GenerateRandomNumber();
+		const uint32_t expectedNext = GenerateRandomNumber();
+
+		SetRndSeed(1457187811);
+		std::vector<uint32_t> values(size);
+		GenerateRandomNumbers(values);
+		ASSERT_EQ(values, expected) << "Wrong values for a batch of " << size;
+		ASSERT_EQ(GenerateRandomNumber(), expectedNext) << "Wrong engine state after a batch of " << size;
+	}
+}
+
+TEST(RandomTest, SumMatchesSequentialCalls)
+{
+	for (const int32_t limit : { -1, 0, 1, 6, 20, 0x7FFF, 0x8000, 100000 }) {
+		for (const int32_t count : { 0, 1, 2, 15, 16, 17, 50 }) {
+			SetRndSeed(1457187811);
+			int32_t expected = 0;
+			for (int32_t i = 0; i < count; i++)
+				expected += GenerateRnd(limit);
+			const uint32_t expectedNext = GenerateRandomNumber();
+
+			SetRndSeed(1457187811);
+			ASSERT_EQ(GenerateRndSum(limit, count), expected) << "Wrong sum of " << count << " values below " << limit;
+			ASSERT_EQ(GenerateRandomNumber(), expectedNext) << "Wrong engine state after " << count << " values below " << limit;
+		}
+	}
+}
+
 } // namespace devilution
@@ -0,0 +1,70 @@
+#include "engine/render/screen_hit_list.hpp"
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace devilution {
+namespace {
+
+bool AcceptAll(uint32_t)
+{
+	return true;
+}
+
+TEST(ScreenHitListTest, EmptyListFindsNothing)
+{
+	const ScreenHitList list;
+	EXPECT_EQ(list.FindAt({ 10, 10 }, AcceptAll), std::nullopt);
+}
+
+TEST(ScreenHitListTest, FindsLastDrawnSpriteFirst)
+{
+	ScreenHitList list;
+	list.Add({ { 0, 0 }, { 100, 100 } }, 1);
+	list.Add({ { 50, 50 }, { 100, 100 } }, 2);
+
+	EXPECT_EQ(list.FindAt({ 10, 10 }, AcceptAll), 1U);
+	EXPECT_EQ(list.FindAt({ 60, 60 }, AcceptAll), 2U);
+	EXPECT_EQ(list.FindAt({ 140, 140 }, AcceptAll), 2U);
+	EXPECT_EQ(list.FindAt({ 160, 60 }, AcceptAll), std::nullopt);
+}
+
+TEST(ScreenHitListTest, FallsThroughRejectedSprites)
+{
+	ScreenHitList list;
+	list.Add({ { 0, 0 }, { 100, 100 } }, 1);
+	list.Add({ { 0, 0 }, { 100, 100 } }, 2);
+	list.Add({ { 0, 0 }, { 100, 100 } }, 3);
+
+	std::vector<uint32_t> asked;
+	const std::optional<uint32_t> hit = list.FindAt({ 20, 20 }, [&](uint32_t id) {
+		asked.push_back(id);
+		return id == 2;
+	});
+	EXPECT_EQ(hit, 2U);
+	EXPECT_EQ(asked, (std::vector<uint32_t> { 3, 2 }));
+}
+
+TEST(ScreenHitListTest, HandlesSpritesCrossingTheScreenEdge)
+{
+	ScreenHitList list;
+	list.Add({ { -30, 0 }, { 40, 10 } }, 1);
+	list.Add({ { -50, 20 }, { 40, 10 } }, 2);
+
+	EXPECT_EQ(list.FindAt({ 5, 5 }, AcceptAll), 1U);
+	EXPECT_EQ(list.FindAt({ 5, 25 }, AcceptAll), std::nullopt);
+	EXPECT_EQ(list.FindAt({ -5, 5 }, AcceptAll), std::nullopt);
+}
+
+TEST(ScreenHitListTest, ClearForgetsEverything)
+{
+	ScreenHitList list;
+	list.Add({ { 0, 0 }, { 300, 10 } }, 1);
+	list.Clear();
+	EXPECT_EQ(list.size(), 0U);
+	EXPECT_EQ(list.FindAt({ 200, 5 }, AcceptAll), std::nullopt);
+}
+
+} // namespace
+} // namespace devilution
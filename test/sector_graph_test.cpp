@@ -0,0 +1,102 @@
+#include "engine/sector_graph.hpp"
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace devilution {
+namespace {
+
+using Grid = Bitset2d<MAXDUNX, MAXDUNY>;
+
+void FillRect(Grid &grid, Point topLeft, Point bottomRight)
+{
+	for (int y = topLeft.y; y <= bottomRight.y; y++) {
+		for (int x = topLeft.x; x <= bottomRight.x; x++) {
+			grid.set(x, y);
+		}
+	}
+}
+
+int SingleRegion(Point)
+{
+	return 0;
+}
+
+TEST(SectorGraphTest, RegionsSplitSectors)
+{
+	Grid passable;
+	FillRect(passable, { 10, 10 }, { 29, 14 });
+	SectorGraph graph;
+	graph.Build(passable, [](Point position) { return position.x < 20 ? 1 : 2; });
+
+	EXPECT_EQ(graph.SectorCount(), 2U);
+	EXPECT_EQ(graph.SectorAt({ 10, 10 }), graph.SectorAt({ 19, 14 }));
+	EXPECT_NE(graph.SectorAt({ 19, 12 }), graph.SectorAt({ 20, 12 }));
+	EXPECT_EQ(graph.SectorAt({ 9, 10 }), SectorGraph::NoSector);
+}
+
+TEST(SectorGraphTest, DisconnectedAreasAreSeparateSectors)
+{
+	Grid passable;
+	FillRect(passable, { 10, 10 }, { 14, 14 });
+	FillRect(passable, { 20, 10 }, { 24, 14 });
+	SectorGraph graph;
+	graph.Build(passable, SingleRegion);
+
+	EXPECT_EQ(graph.SectorCount(), 2U);
+	EXPECT_FALSE(graph.PlanRoute({ 12, 12 }, { 22, 12 }));
+}
+
+TEST(SectorGraphTest, RouteFollowsRooms)
+{
+	// Three rooms in a row joined by one tile wide doorways, plus a dead end room above the first.
+	Grid passable;
+	FillRect(passable, { 10, 10 }, { 14, 14 });
+	FillRect(passable, { 15, 12 }, { 15, 12 });
+	FillRect(passable, { 16, 10 }, { 20, 14 });
+	FillRect(passable, { 21, 11 }, { 21, 11 });
+	FillRect(passable, { 22, 10 }, { 26, 14 });
+	FillRect(passable, { 12, 5 }, { 12, 9 });
+	const auto regionOf = [](Point position) {
+		if (position.y < 10)
+			return 4;
+		if (position.x <= 15)
+			return 1;
+		if (position.x <= 21)
+			return 2;
+		return 3;
+	};
+	SectorGraph graph;
+	graph.Build(passable, regionOf);
+	ASSERT_EQ(graph.SectorCount(), 4U);
+
+	const std::optional<std::vector<SectorGraph::Portal>> route = graph.PlanRoute({ 11, 11 }, { 25, 13 });
+	ASSERT_TRUE(route);
+	ASSERT_EQ(route->size(), 2U);
+	EXPECT_EQ((*route)[0].from, Point(15, 12));
+	EXPECT_EQ((*route)[0].to, Point(16, 12));
+	EXPECT_EQ((*route)[1].from, Point(21, 11));
+	EXPECT_EQ((*route)[1].to, Point(22, 11));
+
+	const std::optional<std::vector<SectorGraph::Portal>> sameSector = graph.PlanRoute({ 11, 11 }, { 14, 14 });
+	ASSERT_TRUE(sameSector);
+	EXPECT_TRUE(sameSector->empty());
+}
+
+TEST(SectorGraphTest, SectorTiles)
+{
+	Grid passable;
+	FillRect(passable, { 10, 10 }, { 19, 10 });
+	SectorGraph graph;
+	graph.Build(passable, [](Point position) { return position.x < 15 ? 1 : 2; });
+
+	Grid tiles;
+	graph.AddSectorTiles(graph.SectorAt({ 10, 10 }), tiles);
+	EXPECT_EQ(tiles.count(), 5U);
+	EXPECT_TRUE(tiles.test(14, 10));
+	EXPECT_FALSE(tiles.test(15, 10));
+}
+
+} // namespace
+} // namespace devilution
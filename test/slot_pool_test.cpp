@@ -0,0 +1,97 @@
+#include "utils/slot_pool.hpp"
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace devilution {
+namespace {
+
+std::vector<int> Contents(const SlotPool<int, 4> &pool)
+{
+	return { pool.begin(), pool.end() };
+}
+
+TEST(SlotPoolTest, KeepsInsertionOrder)
+{
+	SlotPool<int, 4> pool;
+	EXPECT_TRUE(pool.empty());
+	for (int i = 0; i < 10; i++)
+		pool.emplace_back() = i;
+	EXPECT_EQ(pool.size(), 10);
+	EXPECT_EQ(pool.front(), 0);
+	EXPECT_EQ(pool.back(), 9);
+	EXPECT_EQ(Contents(pool), (std::vector<int> { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 }));
+}
+
+TEST(SlotPoolTest, RemoveIfKeepsOrderAndElementAddresses)
+{
+	SlotPool<int, 4> pool;
+	std::vector<int *> addresses;
+	for (int i = 0; i < 10; i++)
+		addresses.push_back(&pool.emplace_back());
+	for (int i = 0; i < 10; i++)
+		*addresses[i] = i;
+
+	EXPECT_EQ(pool.remove_if([](int value) { return value % 3 == 0; }), 4);
+	EXPECT_EQ(Contents(pool), (std::vector<int> { 1, 2, 4, 5, 7, 8 }));
+	EXPECT_EQ(&pool.front(), addresses[1]);
+	EXPECT_EQ(&pool.back(), addresses[8]);
+}
+
+TEST(SlotPoolTest, ReusesFreedSlotsLowestFirst)
+{
+	SlotPool<int, 4> pool;
+	std::vector<int *> addresses;
+	for (int i = 0; i < 4; i++) {
+		addresses.push_back(&pool.emplace_back());
+		*addresses.back() = i;
+	}
+	pool.remove_if([](int value) { return value == 1 || value == 2; });
+
+	int &reused = pool.emplace_back();
+	EXPECT_EQ(&reused, addresses[1]);
+	EXPECT_EQ(reused, 0) << "A reused slot is value-initialized";
+	reused = 4;
+	EXPECT_EQ(&pool.emplace_back(), addresses[2]);
+	EXPECT_EQ(Contents(pool), (std::vector<int> { 0, 3, 4, 0 }));
+}
+
+TEST(SlotPoolTest, VisitsElementsAddedWhileIterating)
+{
+	SlotPool<int, 4> pool;
+	pool.emplace_back() = 3;
+	std::vector<int> visited;
+	for (int &value : pool) {
+		visited.push_back(value);
+		if (value > 0)
+			pool.emplace_back() = value - 1;
+	}
+	EXPECT_EQ(visited, (std::vector<int> { 3, 2, 1, 0 }));
+}
+
+TEST(SlotPoolTest, HandlesExpireWithTheirElement)
+{
+	SlotPool<int, 4> pool;
+	pool.emplace_back() = 1;
+	pool.emplace_back() = 2;
+	const SlotPool<int, 4>::Handle first = pool.begin().handle();
+	const SlotPool<int, 4>::Handle second = std::next(pool.begin()).handle();
+	ASSERT_NE(pool.get(first), nullptr);
+	EXPECT_EQ(*pool.get(first), 1);
+
+	pool.remove_if([](int value) { return value == 1; });
+	EXPECT_EQ(pool.get(first), nullptr);
+	pool.emplace_back() = 3;
+	EXPECT_EQ(pool.get(first), nullptr) << "The slot was reused by another element";
+	ASSERT_NE(pool.get(second), nullptr);
+	EXPECT_EQ(*pool.get(second), 2);
+
+	pool.clear();
+	EXPECT_TRUE(pool.empty());
+	EXPECT_EQ(pool.get(second), nullptr);
+	EXPECT_EQ(pool.get({}), nullptr);
+}
+
+} // namespace
+} // namespace devilution
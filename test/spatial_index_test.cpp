@@ -0,0 +1,167 @@
+#include "engine/spatial_index.hpp"
+
+#include <algorithm>
+#include <span>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace devilution {
+namespace {
+
+bool AcceptAll(int)
+{
+	return true;
+}
+
+std::vector<SpatialIndex::Match> CollectInRadius(const SpatialIndex &index, Point center, int radius)
+{
+	std::vector<SpatialIndex::Match> result;
+	index.ForEachInRadius(center, radius, [&](const SpatialIndex::Match &match) { result.push_back(match); });
+	std::sort(result.begin(), result.end(), [](const SpatialIndex::Match &a, const SpatialIndex::Match &b) { return a.id < b.id; });
+	return result;
+}
+
+TEST(SpatialIndexTest, RadiusQuery)
+{
+	const std::vector<SpatialIndex::Entry> entries = {
+		{ 1, { 10, 10 } },
+		{ 2, { 14, 10 } },
+		{ 3, { 30, 30 } },
+		{ 4, { 10, 16 } },
+	};
+	SpatialIndex index;
+	index.Build(entries);
+
+	const std::vector<SpatialIndex::Match> matches = CollectInRadius(index, { 10, 10 }, 5);
+	ASSERT_EQ(matches.size(), 2U);
+	EXPECT_EQ(matches[0].id, 1);
+	EXPECT_EQ(matches[0].distance, 0);
+	EXPECT_EQ(matches[1].id, 2);
+	EXPECT_EQ(matches[1].distance, 4);
+
+	EXPECT_EQ(CollectInRadius(index, { 10, 10 }, 6).size(), 3U);
+}
+
+TEST(SpatialIndexTest, MultiTileEntitiesAreReportedOnce)
+{
+	const std::vector<SpatialIndex::Entry> entries = {
+		{ 7, { 20, 20 } },
+		{ 7, { 19, 20 } },
+		{ 7, { 19, 19 } },
+	};
+	SpatialIndex index;
+	index.Build(entries);
+
+	const std::vector<SpatialIndex::Match> matches = CollectInRadius(index, { 15, 20 }, 10);
+	ASSERT_EQ(matches.size(), 1U);
+	EXPECT_EQ(matches[0].distance, 4);
+
+	const std::optional<SpatialIndex::Match> nearest = index.FindNearest({ 15, 20 }, AcceptAll);
+	ASSERT_TRUE(nearest);
+	EXPECT_EQ(nearest->id, 7);
+	EXPECT_EQ(nearest->distance, 4);
+}
+
+TEST(SpatialIndexTest, NearestMatchesBruteForce)
+{
+	std::vector<SpatialIndex::Entry> entries;
+	for (int i = 0; i < 200; i++) {
+		entries.push_back({ i, { (i * 37) % MAXDUNX, (i * 53 + 11) % MAXDUNY } });
+	}
+	SpatialIndex index;
+	index.Build(entries);
+
+	const auto acceptOdd = [](int id) { return id % 2 == 1; };
+	for (const Point center : { Point { 0, 0 }, Point { 56, 56 }, Point { 111, 3 }, Point { 12, 100 } }) {
+		std::vector<SpatialIndex::Match> expected;
+		for (const SpatialIndex::Entry &entry : entries) {
+			if (acceptOdd(entry.id))
+				expected.push_back({ entry.id, center.WalkingDistance(entry.position) });
+		}
+		std::sort(expected.begin(), expected.end(), [](const SpatialIndex::Match &a, const SpatialIndex::Match &b) {
+			if (a.distance != b.distance)
+				return a.distance < b.distance;
+			return a.id < b.id;
+		});
+		expected.resize(5);
+
+		const std::vector<SpatialIndex::Match> actual = index.FindNearest(center, 5, acceptOdd);
+		ASSERT_EQ(actual.size(), expected.size());
+		for (size_t i = 0; i < actual.size(); i++) {
+			EXPECT_EQ(actual[i].id, expected[i].id) << "at " << center;
+			EXPECT_EQ(actual[i].distance, expected[i].distance) << "at " << center;
+		}
+	}
+}
+
+TEST(SpatialIndexTest, NothingAccepted)
+{
+	const std::vector<SpatialIndex::Entry> entries = { { 1, { 5, 5 } } };
+	SpatialIndex index;
+	index.Build(entries);
+
+	EXPECT_FALSE(index.FindNearest({ 5, 5 }, [](int) { return false; }));
+
+	index.Clear();
+	EXPECT_EQ(index.size(), 0U);
+	EXPECT_FALSE(index.FindNearest({ 5, 5 }, AcceptAll));
+}
+
+std::vector<int> ToVector(std::span<const int> ids)
+{
+	return { ids.begin(), ids.end() };
+}
+
+TEST(SpatialIndexTest, RadiusWatchReportsEnterAndLeave)
+{
+	std::vector<SpatialIndex::Entry> entries = {
+		{ 1, { 10, 10 } },
+		{ 2, { 12, 10 } },
+		{ 3, { 20, 20 } },
+	};
+	SpatialIndex index;
+	index.Build(entries);
+
+	RadiusWatch watch(2);
+	EXPECT_TRUE(watch.Update(index, { 10, 10 }));
+	EXPECT_EQ(ToVector(watch.entered()), (std::vector<int> { 1, 2 }));
+	EXPECT_TRUE(watch.left().empty());
+
+	// Nothing moved, nothing to report.
+	EXPECT_FALSE(watch.Update(index, { 10, 10 }));
+	EXPECT_TRUE(watch.entered().empty());
+	EXPECT_EQ(ToVector(watch.inRange()), (std::vector<int> { 1, 2 }));
+
+	EXPECT_TRUE(watch.Update(index, { 8, 10 }));
+	EXPECT_TRUE(watch.entered().empty());
+	EXPECT_EQ(ToVector(watch.left()), (std::vector<int> { 2 }));
+
+	entries[2].position = { 9, 11 };
+	index.Build(entries);
+	EXPECT_TRUE(watch.Update(index, { 8, 10 }));
+	EXPECT_EQ(ToVector(watch.entered()), (std::vector<int> { 3 }));
+	EXPECT_EQ(ToVector(watch.inRange()), (std::vector<int> { 1, 3 }));
+
+	index.Clear();
+	EXPECT_TRUE(watch.Update(index, { 8, 10 }));
+	EXPECT_EQ(ToVector(watch.left()), (std::vector<int> { 1, 3 }));
+	EXPECT_TRUE(watch.inRange().empty());
+}
+
+TEST(SpatialIndexTest, RadiusWatchResetReportsEverythingAgain)
+{
+	const std::vector<SpatialIndex::Entry> entries = { { 4, { 5, 5 } } };
+	SpatialIndex index;
+	index.Build(entries);
+
+	RadiusWatch watch(1);
+	EXPECT_TRUE(watch.Update(index, { 5, 6 }));
+	watch.Reset();
+	EXPECT_TRUE(watch.inRange().empty());
+	EXPECT_TRUE(watch.Update(index, { 5, 6 }));
+	EXPECT_EQ(ToVector(watch.entered()), (std::vector<int> { 4 }));
+}
+
+} // namespace
+} // namespace devilution
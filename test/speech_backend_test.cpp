@@ -0,0 +1,43 @@
+#include "utils/speech_backend.hpp"
+
+#include <gtest/gtest.h>
+
+namespace devilution {
+namespace {
+
+TEST(SpeechBackendTest, RecordsSpokenText)
+{
+	std::vector<RecordedSpeech> recorded;
+	RecordingSpeechBackend backend(recorded);
+	ASSERT_TRUE(backend.Open());
+	backend.Speak("Short Sword", /*interrupt=*/true);
+	backend.Speak("Skeleton health: 50%", /*interrupt=*/false);
+	backend.Close();
+
+	const std::vector<RecordedSpeech> expected {
+		{ "Short Sword", true },
+		{ "Skeleton health: 50%", false },
+	};
+	EXPECT_EQ(recorded, expected);
+}
+
+TEST(SpeechBackendTest, ReportsLatencyOnceSomethingWasSpoken)
+{
+	std::vector<RecordedSpeech> recorded;
+	RecordingSpeechBackend backend(recorded, std::chrono::microseconds { 1500 });
+	EXPECT_EQ(backend.OutputLatency(), std::nullopt);
+	backend.Speak("Stairs down", /*interrupt=*/true);
+	EXPECT_EQ(backend.OutputLatency(), std::chrono::microseconds { 1500 });
+}
+
+TEST(SpeechBackendTest, NullBackendHasNoLatency)
+{
+	const std::unique_ptr<SpeechBackend> backend = CreateNullSpeechBackend();
+	ASSERT_TRUE(backend->Open());
+	backend->Speak("Gold", /*interrupt=*/true);
+	EXPECT_EQ(backend->OutputLatency(), std::nullopt);
+	backend->Close();
+}
+
+} // namespace
+} // namespace devilution
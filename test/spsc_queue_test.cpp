@@ -0,0 +1,67 @@
+#include "utils/spsc_queue.hpp"
+
+#include <thread>
+
+#include <gtest/gtest.h>
+
+namespace devilution {
+namespace {
+
+TEST(SpscQueueTest, FirstInFirstOut)
+{
+	SpscQueue<int, 4> queue;
+	EXPECT_TRUE(queue.empty());
+	EXPECT_TRUE(queue.Push(1));
+	EXPECT_TRUE(queue.Push(2));
+	EXPECT_FALSE(queue.empty());
+
+	int value = 0;
+	ASSERT_TRUE(queue.Pop(value));
+	EXPECT_EQ(value, 1);
+	ASSERT_TRUE(queue.Pop(value));
+	EXPECT_EQ(value, 2);
+	EXPECT_FALSE(queue.Pop(value));
+}
+
+TEST(SpscQueueTest, FullQueueRejectsPush)
+{
+	SpscQueue<int, 2> queue;
+	EXPECT_TRUE(queue.Push(1));
+	EXPECT_TRUE(queue.Push(2));
+	EXPECT_FALSE(queue.Push(3));
+
+	int value = 0;
+	ASSERT_TRUE(queue.Pop(value));
+	EXPECT_TRUE(queue.Push(3));
+	ASSERT_TRUE(queue.Pop(value));
+	EXPECT_EQ(value, 2);
+	ASSERT_TRUE(queue.Pop(value));
+	EXPECT_EQ(value, 3);
+}
+
+TEST(SpscQueueTest, KeepsOrderAcrossThreads)
+{
+	constexpr int Count = 100000;
+	SpscQueue<int, 16> queue;
+	std::thread producer([&queue]() {
+		for (int i = 0; i < Count; i++) {
+			while (!queue.Push(i))
+				std::this_thread::yield();
+		}
+	});
+
+	int expected = 0;
+	while (expected < Count) {
+		int value;
+		if (!queue.Pop(value)) {
+			std::this_thread::yield();
+			continue;
+		}
+		ASSERT_EQ(value, expected);
+		expected++;
+	}
+	producer.join();
+}
+
+} // namespace
+} // namespace devilution
@@ -0,0 +1,41 @@
+#include "engine/startup_timing.hpp"
+
+#include <array>
+
+#include <gtest/gtest.h>
+
+namespace devilution {
+namespace {
+
+TEST(StartupTimingTest, IndentsNestedPhases)
+{
+	const std::array<StartupPhase, 3> phases { {
+	    { "LoadCoreArchives", 0, 0, 12000 },
+	    { "DiabloInit", 0, 12000, 30500 },
+	    { "snd_init", 1, 20000, 1250 },
+	} };
+	EXPECT_EQ(FormatStartupReport(phases, 50000),
+	    "startup: LoadCoreArchives 12.000 ms\n"
+	    "startup: DiabloInit 30.500 ms\n"
+	    "startup:   snd_init 1.250 ms\n"
+	    "startup: other 7.500 ms\n"
+	    "startup: total 50.000 ms");
+}
+
+TEST(StartupTimingTest, LeavesOutOtherWhenAllTimeIsInPhases)
+{
+	const std::array<StartupPhase, 1> phases { {
+	    { "LoadGameArchives", 0, 0, 2000 },
+	} };
+	EXPECT_EQ(FormatStartupReport(phases, 2000),
+	    "startup: LoadGameArchives 2.000 ms\n"
+	    "startup: total 2.000 ms");
+}
+
+TEST(StartupTimingTest, ReportsTotalWithoutPhases)
+{
+	EXPECT_EQ(FormatStartupReport({}, 1500), "startup: other 1.500 ms\nstartup: total 1.500 ms");
+}
+
+} // namespace
+} // namespace devilution
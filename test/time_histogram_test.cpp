@@ -0,0 +1,71 @@
+#include "utils/time_histogram.hpp"
+
+#include <gtest/gtest.h>
+
+namespace devilution {
+namespace {
+
+TEST(TimeHistogramTest, EmptyHasNoPercentiles)
+{
+	const TimeHistogram histogram;
+	EXPECT_EQ(histogram.count(), 0);
+	EXPECT_EQ(histogram.Percentile(0.5), 0);
+	EXPECT_EQ(histogram.Percentile(0.99), 0);
+}
+
+TEST(TimeHistogramTest, SmallTimesAreExact)
+{
+	TimeHistogram histogram;
+	for (uint32_t i = 1; i <= 4; i++)
+		histogram.Add(i);
+	EXPECT_EQ(histogram.Percentile(0.5), 2);
+	EXPECT_EQ(histogram.Percentile(0.75), 3);
+	EXPECT_EQ(histogram.Percentile(1), 4);
+	EXPECT_EQ(histogram.max(), 4);
+}
+
+TEST(TimeHistogramTest, PercentilesAreCloseAbove)
+{
+	TimeHistogram histogram;
+	for (uint32_t i = 1; i <= 1000; i++)
+		histogram.Add(i * 100);
+	EXPECT_EQ(histogram.count(), 1000);
+
+	for (const double fraction : { 0.5, 0.95, 0.99 }) {
+		const auto exact = static_cast<uint32_t>(fraction * 1000) * 100;
+		const uint32_t percentile = histogram.Percentile(fraction);
+		EXPECT_GE(percentile, exact) << fraction;
+		EXPECT_LE(percentile, exact + exact / 8) << fraction;
+	}
+}
+
+TEST(TimeHistogramTest, SpikesShowInTheTail)
+{
+	TimeHistogram histogram;
+	for (int i = 0; i < 98; i++)
+		histogram.Add(16000);
+	histogram.Add(120000);
+	histogram.Add(250000);
+	EXPECT_LT(histogram.Percentile(0.95), 20000);
+	EXPECT_GE(histogram.Percentile(0.99), 120000);
+	EXPECT_EQ(histogram.Percentile(1), 250000);
+}
+
+TEST(TimeHistogramTest, LargestTimesFit)
+{
+	TimeHistogram histogram;
+	histogram.Add(UINT32_MAX);
+	EXPECT_EQ(histogram.Percentile(0.5), UINT32_MAX);
+}
+
+TEST(TimeHistogramTest, ClearStartsOver)
+{
+	TimeHistogram histogram;
+	histogram.Add(500);
+	histogram.Clear();
+	EXPECT_EQ(histogram.count(), 0);
+	EXPECT_EQ(histogram.max(), 0);
+}
+
+} // namespace
+} // namespace devilution
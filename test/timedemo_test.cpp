@@ -19,17 +19,33 @@
 #include "tables/monstdat.h"
 #include "tables/playerdat.hpp"
 #include "utils/display.h"
+#include "utils/headless_speech.hpp"
 #include "utils/paths.h"
 
 using namespace devilution;
 
 namespace {
 
+/** More than this in one tick means an announcer repeats itself instead of waiting for a change. */
+constexpr size_t MaxAnnouncementsPerTick = 4;
+
 bool Dummy_GetHeroInfo(_uiheroinfo *pInfo)
 {
 	return true;
 }
 
+void ExpectSparseAnnouncements()
+{
+	uint32_t tick = 0;
+	size_t announcementsInTick = 0;
+	for (const HeadlessSpeech &speech : GetHeadlessSpeech()) {
+		ASSERT_GE(speech.gameTick, tick) << "Announcements are recorded in order";
+		announcementsInTick = speech.gameTick == tick ? announcementsInTick + 1 : 1;
+		tick = speech.gameTick;
+		EXPECT_LE(announcementsInTick, MaxAnnouncementsPerTick) << "Too many announcements in tick " << tick << ", the last one: " << speech.text;
+	}
+}
+
 void RunTimedemo(std::string timedemoFolderName)
 {
 	if (
@@ -89,10 +105,12 @@ void RunTimedemo(std::string timedemoFolderName)
 
 	AdjustToScreenGeometry(forceResolution);
 
+	ClearHeadlessSpeech();
 	StartGame(false, true);
 
 	const HeroCompareResult result = pfile_compare_hero_demo(demoNumber, true);
 	ASSERT_EQ(result.status, HeroCompareResult::Same) << result.message;
+	ExpectSparseAnnouncements();
 	ASSERT_FALSE(gbRunGame);
 	gbRunGame = false;
 	init_cleanup();
@@ -0,0 +1,63 @@
+#include "engine/tour_planner.hpp"
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "engine/point.hpp"
+
+namespace devilution {
+namespace {
+
+/** Walking distances between the start (node 0) and the given stops. */
+struct Positions {
+	Point start;
+	std::vector<Point> stops;
+
+	[[nodiscard]] Point Node(size_t node) const
+	{
+		return node == 0 ? start : stops[node - 1];
+	}
+
+	int operator()(size_t from, size_t to) const
+	{
+		return Node(from).WalkingDistance(Node(to));
+	}
+};
+
+TEST(TourPlannerTest, NoStops)
+{
+	const Positions positions { { 0, 0 }, {} };
+	EXPECT_TRUE(PlanTour(0, positions).empty());
+}
+
+TEST(TourPlannerTest, VisitsStopsAlongALine)
+{
+	const Positions positions { { 0, 0 }, { { 30, 0 }, { 10, 0 }, { 20, 0 } } };
+	const std::vector<size_t> order = PlanTour(positions.stops.size(), positions);
+	EXPECT_EQ(order, (std::vector<size_t> { 1, 2, 0 }));
+	EXPECT_EQ(TourLength(order, positions), 30);
+}
+
+TEST(TourPlannerTest, ImprovesOnTheNearestStopFirst)
+{
+	// Going to the nearest stop first means walking back past the start for the far one.
+	const Positions positions { { 10, 0 }, { { 12, 0 }, { 7, 0 }, { 30, 0 } } };
+	const std::vector<size_t> order = PlanTour(positions.stops.size(), positions);
+	EXPECT_EQ(order, (std::vector<size_t> { 1, 0, 2 }));
+	EXPECT_EQ(TourLength(order, positions), 26);
+}
+
+TEST(TourPlannerTest, UnreachableStopsComeLast)
+{
+	constexpr int Unreachable = 100000;
+	const Positions positions { { 0, 0 }, { { 1, 0 }, { 2, 0 }, { 3, 0 } } };
+	const auto distance = [&](size_t from, size_t to) {
+		return from == 2 || to == 2 ? Unreachable : positions(from, to);
+	};
+	const std::vector<size_t> order = PlanTour(positions.stops.size(), distance);
+	EXPECT_EQ(order, (std::vector<size_t> { 0, 2, 1 }));
+}
+
+} // namespace
+} // namespace devilution
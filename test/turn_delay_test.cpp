@@ -0,0 +1,82 @@
+#include "engine/turn_delay.hpp"
+
+#include <gtest/gtest.h>
+
+namespace devilution {
+namespace {
+
+constexpr uint32_t TurnMs = 100;
+
+TEST(TurnDelayTest, StartsWithInitialTurns)
+{
+	TurnDelayController controller;
+	controller.Reset(1, 8, 2);
+	EXPECT_EQ(controller.TurnsInTransit(), 2);
+	controller.Reset(3, 8, 2);
+	EXPECT_EQ(controller.TurnsInTransit(), 3);
+}
+
+TEST(TurnDelayTest, LowersSlowlyOnQuietLinks)
+{
+	TurnDelayController controller;
+	controller.Reset(1, 8, 2);
+	for (uint32_t i = 0; i + 1 < TurnDelayController::SamplesBeforeLowering; i++)
+		controller.AddRoundTrip(2, TurnMs);
+	EXPECT_EQ(controller.TurnsInTransit(), 2);
+	controller.AddRoundTrip(2, TurnMs);
+	EXPECT_EQ(controller.TurnsInTransit(), 1);
+}
+
+TEST(TurnDelayTest, RaisesAtOnceOnSlowLinks)
+{
+	TurnDelayController controller;
+	controller.Reset(1, 8, 2);
+	controller.AddRoundTrip(400, TurnMs);
+	// 200 ms one way plus 2 * 200 ms deviation for the first sample, plus half a turn.
+	EXPECT_EQ(controller.TurnsInTransit(), 7);
+}
+
+TEST(TurnDelayTest, KeepsTurnsWithinLimits)
+{
+	TurnDelayController controller;
+	controller.Reset(1, 4, 2);
+	controller.AddRoundTrip(5000, TurnMs);
+	EXPECT_EQ(controller.TurnsInTransit(), 4);
+	for (int i = 0; i < 100; i++)
+		controller.AddRoundTrip(0, TurnMs);
+	EXPECT_EQ(controller.TurnsInTransit(), 1);
+}
+
+TEST(TurnDelayTest, CountsEachStallOnce)
+{
+	TurnDelayController controller;
+	controller.Reset(1, 8, 2);
+	controller.AddTick(false);
+	controller.AddTick(false);
+	EXPECT_EQ(controller.TurnsInTransit(), 3);
+	controller.AddTick(true);
+	controller.AddTick(false);
+	EXPECT_EQ(controller.TurnsInTransit(), 4);
+}
+
+TEST(TurnDelayTest, StallsDelayLowering)
+{
+	TurnDelayController controller;
+	controller.Reset(1, 8, 3);
+	controller.AddRoundTrip(2, TurnMs);
+	controller.AddRoundTrip(2, TurnMs);
+	controller.AddTick(false);
+	controller.AddTick(true);
+	EXPECT_EQ(controller.TurnsInTransit(), 4);
+	for (uint32_t i = 0; i + 1 < TurnDelayController::SamplesBeforeLoweringAfterStall; i++)
+		controller.AddRoundTrip(2, TurnMs);
+	EXPECT_EQ(controller.TurnsInTransit(), 4);
+	controller.AddRoundTrip(2, TurnMs);
+	EXPECT_EQ(controller.TurnsInTransit(), 3);
+	for (uint32_t i = 0; i < TurnDelayController::SamplesBeforeLowering; i++)
+		controller.AddRoundTrip(2, TurnMs);
+	EXPECT_EQ(controller.TurnsInTransit(), 2);
+}
+
+} // namespace
+} // namespace devilution
@@ -121,5 +121,65 @@ TEST(Utf8CodeUnits, BasicLatin)
 	EXPECT_FALSE(IsBasicLatin('\xFF')) << "Multibyte Utf8 code units are not Basic Latin symbols";
 }
 
+TEST(AppendUtf16Test, Ascii)
+{
+	std::u16string out = u"> ";
+	AppendUtf16("Short Sword", out);
+	EXPECT_EQ(out, u"> Short Sword");
+}
+
+TEST(AppendUtf16Test, MixedWidthCodePoints)
+{
+	std::u16string out;
+	AppendUtf16("ж a € 💡", out);
+	EXPECT_EQ(out, u"ж a € 💡");
+}
+
+TEST(AppendUtf16Test, InvalidSequence)
+{
+	std::u16string out;
+	AppendUtf16("a\xFF" "b", out);
+	EXPECT_EQ(out, u"a\uFFFDb");
+}
+
+TEST(CountAsciiPrefixTest, AllAscii)
+{
+	EXPECT_EQ(CountAsciiPrefix(""), 0);
+	EXPECT_EQ(CountAsciiPrefix("Short Sword"), 11);
+	EXPECT_EQ(CountAsciiPrefix("The Butcher has been slain, return to town"), 42);
+}
+
+TEST(CountAsciiPrefixTest, StopsAtEveryPosition)
+{
+	// Covers the vector, word and byte loops.
+	for (std::size_t pos = 0; pos < 40; pos++) {
+		std::string text(pos, 'a');
+		text += "ж";
+		text.append(40, 'b');
+		EXPECT_EQ(CountAsciiPrefix(text), pos);
+	}
+}
+
+TEST(AppendUtf32Test, Ascii)
+{
+	std::u32string out = U"> ";
+	AppendUtf32("Short Sword", out);
+	EXPECT_EQ(out, U"> Short Sword");
+}
+
+TEST(AppendUtf32Test, MixedWidthCodePoints)
+{
+	std::u32string out;
+	AppendUtf32("ж a € 💡, and a longer run of ASCII after them", out);
+	EXPECT_EQ(out, U"ж a € 💡, and a longer run of ASCII after them");
+}
+
+TEST(AppendUtf32Test, InvalidSequence)
+{
+	std::u32string out;
+	AppendUtf32("a\xFF" "b", out);
+	EXPECT_EQ(out, U"a\uFFFDb");
+}
+
 } // namespace
 } // namespace devilution
@@ -0,0 +1,47 @@
+#include "engine/walk_path.hpp"
+
+#include <array>
+
+#include <gtest/gtest.h>
+
+namespace devilution {
+namespace {
+
+TEST(WalkPathRunsTest, MergesConsecutiveSteps)
+{
+	constexpr std::array<int8_t, 6> Path = { 1, 1, 1, 3, 3, 1 };
+	const WalkPathRuns runs { Path };
+
+	ASSERT_EQ(runs.size(), 3U);
+	EXPECT_EQ(runs[0].direction, 1);
+	EXPECT_EQ(runs[0].steps, 3);
+	EXPECT_EQ(runs[1].direction, 3);
+	EXPECT_EQ(runs[1].steps, 2);
+	EXPECT_EQ(runs[2].direction, 1);
+	EXPECT_EQ(runs[2].steps, 1);
+}
+
+TEST(WalkPathRunsTest, EmptyPath)
+{
+	const WalkPathRuns runs { std::span<const int8_t> {} };
+	EXPECT_TRUE(runs.empty());
+}
+
+TEST(WalkPathRunsTest, LongestPath)
+{
+	WalkPath path;
+	for (size_t i = 0; i < MaxWalkPathLength; i++)
+		path.push_back(static_cast<int8_t>(i % 2 == 0 ? 2 : 4));
+
+	const WalkPathRuns alternating { path };
+	EXPECT_EQ(alternating.size(), MaxWalkPathLength);
+
+	WalkPathRuns straight;
+	for (size_t i = 0; i < MaxWalkPathLength; i++)
+		straight.Append(5);
+	ASSERT_EQ(straight.size(), 1U);
+	EXPECT_EQ(straight[0].steps, MaxWalkPathLength);
+}
+
+} // namespace
+} // namespace devilution
@@ -400,6 +400,7 @@ TEST(Writehero, pfile_write_hero)
 	UnPackPlayer(pks, *MyPlayer);
 	AssertPlayer(Players[0]);
 	pfile_write_hero();
+	pfile_finish_writes();
 
 	uintmax_t fileSize;
 	ASSERT_TRUE(GetFileSize(savePath.c_str(), &fileSize));
@@ -7,15 +7,17 @@ import statistics
 import subprocess
 from typing import NamedTuple
 
-_TIME_AND_FPS_REGEX = re.compile(rb'\d+ frames, (\d+(?:\.\d+)?) seconds: (\d+(?:\.\d+)?) fps')
+_TIME_AND_FPS_REGEX = re.compile(rb'\d+ (?:frames|ticks), (\d+(?:\.\d+)?) seconds: (\d+(?:\.\d+)?) (?:fps|ticks/s)')
 
 class RunMetrics(NamedTuple):
 	time: float
 	fps: float
 
-def measure(binary: str) -> RunMetrics:
-	result: subprocess.CompletedProcess = subprocess.run(
-		[binary, '--diablo', '--spawn', '--lang', 'en', '--demo', '0', '--timedemo'], capture_output=True)
+def measure(binary: str, no_render: bool) -> RunMetrics:
+	command = [binary, '--diablo', '--spawn', '--lang', 'en', '--demo', '0', '--timedemo']
+	if no_render:
+		command.append('--no-render')
+	result: subprocess.CompletedProcess = subprocess.run(command, capture_output=True)
 	match = _TIME_AND_FPS_REGEX.search(result.stderr)
 	if not match:
 		raise Exception(f"Failed to parse output in:\n{result.stderr}")
@@ -26,13 +28,14 @@ def main():
 	parser = argparse.ArgumentParser()
 	parser.add_argument('--binary', help='Path to the devilutionx binary', required=True)
 	parser.add_argument('-n', '--num-runs', type=int, default=16, metavar='N')
+	parser.add_argument('--no-render', action='store_true', help='Only measure the game logic, FPS are then game ticks per second')
 	args = parser.parse_args()
 
 	num_runs = args.num_runs
 	metrics = []
 	for i in range(1, num_runs + 1):
 		print(f"Run {i:>2} of {num_runs}: ", end='', file=sys.stderr, flush=True)
-		run_metrics = measure(args.binary)
+		run_metrics = measure(args.binary, args.no_render)
 		print(f"\t{run_metrics.time:>5.2f} seconds\t{run_metrics.fps:>5.1f} FPS", file=sys.stderr, flush=True)
 		metrics.append(run_metrics)
 
@@ -0,0 +1,155 @@
+#!/usr/bin/env python
+
+"""Records the short announcements the game speaks most often, for the "Speech Clips" audio option.
+
+The clips are written to a language's speech clip directory, `speech/<lang>/` in the game's pref
+path, and listed in its `clips.tsv`. Besides the built-in vocabulary the game adds the short
+announcements it spoke without a clip to `vocabulary.txt` in the same directory when it exits,
+so running the tool again after playing a while covers what is actually heard.
+
+speech-dispatcher can't write to a file, so on Linux the clips are recorded with espeak-ng, its
+default synthesizer. Windows uses SAPI through PowerShell and macOS uses `say`.
+"""
+
+import argparse
+import hashlib
+import os
+import pathlib
+import platform
+import subprocess
+import sys
+import tempfile
+
+# Spoken with the same voice for every language, e.g. the health announcement.
+_PERCENTAGES = [f"{percent}%" for percent in range(101)]
+
+# The untranslated texts, only used for English.
+_ENGLISH_VOCABULARY = [
+    "Warrior",
+    "Rogue",
+    "Sorcerer",
+    "Monk",
+    "Bard",
+    "Barbarian",
+    "north",
+    "south",
+    "east",
+    "west",
+    "northwest",
+    "northeast",
+    "southeast",
+    "southwest",
+]
+
+_SAPI_SCRIPT = r"""
+param([string]$List, [string]$Voice)
+Add-Type -AssemblyName System.Speech
+$synth = New-Object System.Speech.Synthesis.SpeechSynthesizer
+if ($Voice) { $synth.SelectVoice($Voice) }
+foreach ($line in [System.IO.File]::ReadAllLines($List, [System.Text.Encoding]::UTF8)) {
+    $file, $text = $line.Split("`t", 2)
+    $synth.SetOutputToWaveFile($file)
+    $synth.Speak($text)
+}
+$synth.SetOutputToNull()
+$synth.Dispose()
+"""
+
+
+def clip_file_name(text: str) -> str:
+    return hashlib.sha1(text.encode()).hexdigest()[:16] + ".wav"
+
+
+def read_tab_separated(path: pathlib.Path) -> list[tuple[str, str]]:
+    if not path.is_file():
+        return []
+    rows = []
+    for line in path.read_text(encoding="utf-8").splitlines():
+        first, tab, second = line.partition("\t")
+        if tab and first and second:
+            rows.append((first, second))
+    return rows
+
+
+def record_espeak(clips: list[tuple[pathlib.Path, str]], voice: str):
+    for path, text in clips:
+        subprocess.run(["espeak-ng", "-v", voice, "-w", str(path), text], check=True)
+
+
+def record_say(clips: list[tuple[pathlib.Path, str]], voice: str | None):
+    for path, text in clips:
+        command = ["say", "-o", str(path), "--file-format=WAVE", "--data-format=LEI16@22050"]
+        if voice:
+            command += ["-v", voice]
+        subprocess.run(command + ["--", text], check=True)
+
+
+def record_sapi(clips: list[tuple[pathlib.Path, str]], voice: str | None):
+    # One PowerShell for all the clips, starting it takes longer than recording one.
+    with tempfile.TemporaryDirectory() as temp_dir:
+        script = os.path.join(temp_dir, "record.ps1")
+        with open(script, "w", encoding="utf-8") as f:
+            f.write(_SAPI_SCRIPT)
+        clip_list = os.path.join(temp_dir, "clips.tsv")
+        with open(clip_list, "w", encoding="utf-8") as f:
+            for path, text in clips:
+                f.write(f"{path}\t{text}\n")
+        command = ["powershell", "-NoProfile", "-ExecutionPolicy", "Bypass", "-File", script, "-List", clip_list]
+        if voice:
+            command += ["-Voice", voice]
+        subprocess.run(command, check=True)
+
+
+def main():
+    default_engine = {"Windows": "sapi", "Darwin": "say"}.get(platform.system(), "espeak-ng")
+    parser = argparse.ArgumentParser(description="Records speech clips for the game's frequent announcements")
+    parser.add_argument("--dir", required=True, help="the language's speech clip directory, e.g. ~/.local/share/diasurgical/devilution/speech/en")
+    parser.add_argument("--lang", default="en", help="language code of the texts, also the espeak-ng voice by default (default: %(default)s)")
+    parser.add_argument("--voice", help="voice to record with, the same one the screen reader uses sounds most natural")
+    parser.add_argument("--engine", choices=["espeak-ng", "sapi", "say"], default=default_engine, help="speech engine (default: %(default)s)")
+    parser.add_argument("--vocabulary", action="append", default=[], metavar="FILE", help="more texts to record, one per line")
+    parser.add_argument("--force", action="store_true", help="record the clips that exist already again")
+    args = parser.parse_args()
+
+    clip_dir = pathlib.Path(args.dir).expanduser()
+    clip_dir.mkdir(parents=True, exist_ok=True)
+    index_path = clip_dir / "clips.tsv"
+
+    texts = list(_PERCENTAGES)
+    if args.lang == "en":
+        texts += _ENGLISH_VOCABULARY
+    texts += [text for _, text in read_tab_separated(clip_dir / "vocabulary.txt")]
+    for vocabulary in args.vocabulary:
+        texts += [line.strip() for line in pathlib.Path(vocabulary).read_text(encoding="utf-8").splitlines() if line.strip()]
+
+    index = {text: file for file, text in read_tab_separated(index_path)}
+    to_record = []
+    for text in dict.fromkeys(texts):
+        if "\t" in text:
+            continue
+        file = clip_file_name(text)
+        if not args.force and index.get(text) == file and (clip_dir / file).is_file():
+            continue
+        index[text] = file
+        to_record.append((clip_dir / file, text))
+
+    print(f"Recording {len(to_record)} clips with {args.engine} in {clip_dir}", file=sys.stderr)
+    try:
+        if args.engine == "espeak-ng":
+            record_espeak(to_record, args.voice or args.lang)
+        elif args.engine == "say":
+            record_say(to_record, args.voice)
+        else:
+            record_sapi(to_record, args.voice)
+    except (OSError, subprocess.CalledProcessError) as e:
+        print("Error:", e, file=sys.stderr)
+        return 1
+
+    with open(index_path, "w", encoding="utf-8", newline="\n") as f:
+        for text, file in sorted(index.items(), key=lambda item: item[0]):
+            if (clip_dir / file).is_file():
+                f.write(f"{file}\t{text}\n")
+    return 0
+
+
+sys.exit(main())
@@ -0,0 +1,187 @@
+#!/usr/bin/env python
+
+"""Runs the benchmarks and the headless timedemo, and compares them against a stored baseline.
+
+Every result is a time in nanoseconds, lower is better: the median real time of a Google Benchmark
+run, the mean time of a game tick for the timedemo, or the median time of each startup phase up
+to the main menu. Only the hot paths fail the run when they
+get slower than the tolerance, the other results are reported as warnings.
+"""
+
+import argparse
+import fnmatch
+import json
+import os
+import pathlib
+import re
+import shutil
+import statistics
+import subprocess
+import sys
+import tempfile
+
+# CTest reports the test as skipped instead of failed, see SKIP_RETURN_CODE in CMake/Tests.cmake.
+_SKIP_RETURN_CODE = 77
+
+_DEFAULT_HOT_PATHS = [
+    "dun_render_benchmark/*",  # RenderTileFrame
+    "path_benchmark/*",  # FindPath
+    "clx_render_benchmark/*",  # ClxDraw
+    "light_render_benchmark/*",  # BuildLightmap
+    "timedemo/*",
+]
+
+_TIMEDEMO_FIXTURE = "test/fixtures/timedemo/WarriorLevel1to2"
+_TIMEDEMO_REGEX = re.compile(rb"(\d+) ticks, (\d+(?:\.\d+)?) seconds: (\d+(?:\.\d+)?) ticks/s")
+_STARTUP_REGEX = re.compile(rb"startup: +(\S+) (\d+(?:\.\d+)?) ms")
+_STARTUP_TIMEOUT_SECONDS = 120
+
+_TIME_UNIT_NANOSECONDS = {"ns": 1, "us": 1e3, "ms": 1e6, "s": 1e9}
+
+
+def run_benchmark(build_dir: str, target: str, repetitions: int) -> dict[str, float]:
+    binary = os.path.join(build_dir, target)
+    if not os.path.isfile(binary):
+        print(f"Warning: {binary} not found, skipping it", file=sys.stderr)
+        return {}
+    print("+", binary, file=sys.stderr, flush=True)
+    result = subprocess.run(
+        [
+            binary,
+            "--benchmark_format=json",
+            f"--benchmark_repetitions={repetitions}",
+            "--benchmark_report_aggregates_only=true",
+        ],
+        capture_output=True,
+        check=True,
+    )
+    times = {}
+    for benchmark in json.loads(result.stdout)["benchmarks"]:
+        if benchmark.get("run_type") == "aggregate" and benchmark.get("aggregate_name") != "median":
+            continue
+        name = benchmark.get("run_name", benchmark["name"])
+        times[f"{target}/{name}"] = benchmark["real_time"] * _TIME_UNIT_NANOSECONDS[benchmark["time_unit"]]
+    return times
+
+
+def run_timedemo(binary: str, runs: int) -> dict[str, float]:
+    if not os.path.isfile(binary):
+        print(f"Warning: {binary} not found, skipping the timedemo", file=sys.stderr)
+        return {}
+    tick_times = []
+    for _ in range(runs):
+        # The demo writes its reference save next to the demo file, so play a copy.
+        with tempfile.TemporaryDirectory() as save_dir:
+            shutil.copytree(_TIMEDEMO_FIXTURE, save_dir, dirs_exist_ok=True)
+            command = [binary, "--diablo", "--spawn", "--lang", "en", "--save-dir", save_dir, "--config-dir", save_dir]
+            command += ["--demo", "0", "--timedemo", "--no-render"]
+            print("+", *command, file=sys.stderr, flush=True)
+            result = subprocess.run(command, capture_output=True)
+        match = _TIMEDEMO_REGEX.search(result.stderr)
+        if not match:
+            # Without spawn.mpq or diabdat.mpq there is nothing to replay.
+            print("Warning: the timedemo did not finish, skipping it:", result.stderr.decode(errors="replace"), file=sys.stderr)
+            return {}
+        tick_times.append(1e9 / float(match.group(3)))
+    return {"timedemo/WarriorLevel1to2": statistics.median(tick_times)}
+
+
+def run_startup_benchmark(binary: str, runs: int) -> dict[str, float]:
+    if not os.path.isfile(binary):
+        print(f"Warning: {binary} not found, skipping the startup benchmark", file=sys.stderr)
+        return {}
+    phase_times: dict[str, list[float]] = {}
+    for _ in range(runs):
+        with tempfile.TemporaryDirectory() as save_dir:
+            command = [binary, "--diablo", "--lang", "en", "--save-dir", save_dir, "--config-dir", save_dir, "--startup-benchmark"]
+            print("+", *command, file=sys.stderr, flush=True)
+            try:
+                # Without a display the game may sit on an error dialog instead of exiting.
+                result = subprocess.run(command, capture_output=True, timeout=_STARTUP_TIMEOUT_SECONDS)
+            except subprocess.TimeoutExpired:
+                print("Warning: the startup benchmark timed out, skipping it", file=sys.stderr)
+                return {}
+        phases = _STARTUP_REGEX.findall(result.stderr)
+        if not phases:
+            print("Warning: the startup benchmark did not reach the main menu, skipping it:", result.stderr.decode(errors="replace"), file=sys.stderr)
+            return {}
+        for name, milliseconds in phases:
+            phase_times.setdefault(f"startup/{name.decode()}", []).append(float(milliseconds) * 1e6)
+    return {name: statistics.median(times) for name, times in phase_times.items()}
+
+
+def compare(results: dict[str, float], baseline: dict[str, float], hot_paths: list[str], tolerance: float) -> bool:
+    passed = True
+    for name, time in sorted(results.items()):
+        if name not in baseline:
+            print(f"{name:<60} {time:>14.1f} ns   (new)")
+            continue
+        change = (time - baseline[name]) / baseline[name] * 100
+        status = "ok"
+        if change > tolerance:
+            if any(fnmatch.fnmatch(name, pattern) for pattern in hot_paths):
+                status = "REGRESSION"
+                passed = False
+            else:
+                status = "slower"
+        print(f"{name:<60} {time:>14.1f} ns {change:>+8.1f}%   {status}")
+    for name in sorted(baseline.keys() - results.keys()):
+        print(f"{name:<60} {'':>14}      missing")
+    return passed
+
+
+def main():
+    os.chdir(pathlib.Path(__file__).resolve().parent.parent)
+    parser = argparse.ArgumentParser(description="Runs the benchmarks and the headless timedemo, and compares them against a baseline")
+    parser.add_argument("-B", "--build", required=True, help="build directory with the benchmark binaries")
+    parser.add_argument(
+        "--binary", help="devilutionx binary for the headless timedemo and the startup benchmark, which need spawn.mpq or diabdat.mpq"
+    )
+    parser.add_argument("--benchmarks", nargs="*", default=[], metavar="TARGET", help="benchmark targets to run")
+    parser.add_argument("--baseline", required=True, help="JSON file with the results to compare against")
+    parser.add_argument("--update-baseline", action="store_true", help="store the results as the new baseline instead of comparing")
+    parser.add_argument("--output", help="write the results to this JSON file")
+    parser.add_argument("--tolerance", type=float, default=10, help="percentage by which a hot path may get slower (default: %(default)s)")
+    parser.add_argument(
+        "--hot-path",
+        action="append",
+        metavar="PATTERN",
+        help="benchmark name pattern that fails the run when it regresses, e.g. 'path_benchmark/BM_SinglePath' (default: the rendering, path finding and lighting benchmarks, and the timedemo)",
+    )
+    parser.add_argument("-n", "--repetitions", type=int, default=5, metavar="N", help="repetitions of each benchmark and timedemo runs")
+    args = parser.parse_args()
+
+    results = {}
+    try:
+        for target in args.benchmarks:
+            results.update(run_benchmark(args.build, target, args.repetitions))
+        if args.binary:
+            results.update(run_timedemo(args.binary, args.repetitions))
+            results.update(run_startup_benchmark(args.binary, args.repetitions))
+    except subprocess.CalledProcessError as e:
+        print("Error:", e.cmd[0], "failed", file=sys.stderr)
+        return e.returncode
+
+    if args.output:
+        with open(args.output, "w") as f:
+            json.dump({"results": results}, f, indent=2, sort_keys=True)
+
+    if args.update_baseline:
+        with open(args.baseline, "w") as f:
+            json.dump({"results": results}, f, indent=2, sort_keys=True)
+        print(f"Stored {len(results)} results in {args.baseline}", file=sys.stderr)
+        return 0
+
+    if not os.path.isfile(args.baseline):
+        print(f"No baseline at {args.baseline}, create it with --update-baseline", file=sys.stderr)
+        return _SKIP_RETURN_CODE
+    with open(args.baseline) as f:
+        baseline = json.load(f)["results"]
+
+    if not compare(results, baseline, args.hot_path or _DEFAULT_HOT_PATHS, args.tolerance):
+        print(f"Error: hot paths got more than {args.tolerance}% slower than the baseline", file=sys.stderr)
+        return 1
+    return 0
+
+
+sys.exit(main())